@@ -0,0 +1,40 @@
+/**
+ * @file BookTicketBenchmark.cpp
+ * @brief Đo toàn bộ luồng TicketService::bookTicket trên kết nối dựng sẵn
+ */
+
+#include "support/Fixtures.h"
+#include "services/TicketService.h"
+#include <benchmark/benchmark.h>
+
+static void BM_BookTicket(benchmark::State& state) {
+    auto connection = std::make_shared<ScriptedConnection>();
+    connection->script(Tables::Passenger::FIND_BY_PASSPORT_QUERY, BenchFixtures::passengerTable());
+    connection->script(Tables::Flight::FIND_BY_NUMBER_QUERY, BenchFixtures::flightTable(1));
+    connection->script(Tables::Ticket::COUNT_BY_FLIGHT_ID_QUERY, BenchFixtures::countTable(0));
+
+    auto passengerRepository = std::make_shared<PassengerRepository>(connection, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(connection, nullptr);
+    auto aircraftRepository = std::make_shared<AircraftRepository>(connection, nullptr);
+    auto ticketRepository = std::make_shared<TicketRepository>(connection, passengerRepository, flightRepository, nullptr);
+    TicketService service(ticketRepository, passengerRepository, flightRepository, aircraftRepository, nullptr);
+
+    auto passport = PassportNumber::create(BenchFixtures::PASSPORT).value();
+    auto flightNumber = FlightNumber::create("VN100").value();
+    auto price = Price::create("100000 VND").value();
+
+    size_t roundTripsBefore = connection->getRoundTrips();
+    for (auto _ : state) {
+        auto result = service.bookTicket(passport, flightNumber, "E01", price);
+        if (!result) {
+            state.SkipWithError(result.error().message.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    if (state.iterations() > 0) {
+        state.counters["round_trips"] =
+            static_cast<double>(connection->getRoundTrips() - roundTripsBefore) / state.iterations();
+    }
+}
+BENCHMARK(BM_BookTicket)->Unit(benchmark::kMicrosecond);
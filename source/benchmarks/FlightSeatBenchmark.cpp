@@ -0,0 +1,43 @@
+/**
+ * @file FlightSeatBenchmark.cpp
+ * @brief Đo các thao tác trên bản đồ ghế của Flight
+ */
+
+#include "support/Fixtures.h"
+#include <benchmark/benchmark.h>
+
+static void BM_FlightCreate(benchmark::State& state) {
+    auto aircraft = BenchFixtures::makeAircraft();
+    auto number = FlightNumber::create("VN123").value();
+    auto route = Route::create("Ho Chi Minh City(SGN)-Ha Noi(HAN)").value();
+    auto schedule = Schedule::create("2024-03-15 10:00|2024-03-15 12:00").value();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Flight::create(number, route, schedule, aircraft));
+    }
+}
+BENCHMARK(BM_FlightCreate);
+
+static void BM_FlightIsSeatAvailable(benchmark::State& state) {
+    auto flight = BenchFixtures::makeFlight();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flight.isSeatAvailable("E101"));
+    }
+}
+BENCHMARK(BM_FlightIsSeatAvailable);
+
+static void BM_FlightReserveRelease(benchmark::State& state) {
+    auto flight = BenchFixtures::makeFlight();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flight.reserveSeat("B12"));
+        benchmark::DoNotOptimize(flight.releaseSeat("B12"));
+    }
+}
+BENCHMARK(BM_FlightReserveRelease);
+
+static void BM_FlightClone(benchmark::State& state) {
+    auto flight = BenchFixtures::makeFlight();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flight.clone());
+    }
+}
+BENCHMARK(BM_FlightClone);
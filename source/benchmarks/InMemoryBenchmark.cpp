@@ -0,0 +1,108 @@
+/**
+ * @file InMemoryBenchmark.cpp
+ * @brief Đo repository và service trên InMemoryConnection với dữ liệu thật và chỉ mục
+ *
+ * Khác với ScriptedConnection, mọi câu SQL ở đây thực sự được phân tích và thực thi,
+ * nên kết quả phản ánh cả chi phí tra cứu theo kích thước dữ liệu.
+ */
+
+#include "support/Fixtures.h"
+#include "database/InMemoryConnection.h"
+#include "services/TicketService.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+    struct InMemoryStack {
+        std::shared_ptr<InMemoryConnection> connection = std::make_shared<InMemoryConnection>();
+        std::shared_ptr<PassengerRepository> passengerRepository = std::make_shared<PassengerRepository>(connection, nullptr);
+        std::shared_ptr<FlightRepository> flightRepository = std::make_shared<FlightRepository>(connection, nullptr);
+        std::shared_ptr<AircraftRepository> aircraftRepository = std::make_shared<AircraftRepository>(connection, nullptr);
+        std::shared_ptr<TicketRepository> ticketRepository =
+            std::make_shared<TicketRepository>(connection, passengerRepository, flightRepository, nullptr);
+
+        /**
+         * @brief Nạp một tàu bay, flightCount chuyến bay VN100... và hành khách BenchFixtures::PASSPORT
+         */
+        bool seed(size_t flightCount) {
+            auto aircraft = aircraftRepository->create(*BenchFixtures::makeAircraft());
+            if (!aircraft) return false;
+            auto aircraftPtr = std::make_shared<Aircraft>(aircraft.value());
+
+            for (size_t i = 0; i < flightCount; ++i) {
+                auto flight = Flight::create(FlightNumber::create("VN" + std::to_string(100 + i)).value(),
+                                             Route::create("Ho Chi Minh City(SGN)-Ha Noi(HAN)").value(),
+                                             Schedule::create("2024-03-15 10:00|2024-03-15 12:00").value(),
+                                             aircraftPtr);
+                if (!flight || !flightRepository->create(flight.value())) return false;
+            }
+
+            auto passenger = Passenger::create("Nguyen Van A", "a@example.com|+84123456789|1 Le Loi", BenchFixtures::PASSPORT);
+            return passenger && passengerRepository->create(passenger.value());
+        }
+    };
+}
+
+static void BM_InMemoryFindFlightByNumber(benchmark::State& state) {
+    InMemoryStack stack;
+    if (!stack.seed(static_cast<size_t>(state.range(0)))) {
+        state.SkipWithError("Failed to seed in-memory database");
+        return;
+    }
+    auto flightNumber = FlightNumber::create("VN" + std::to_string(100 + state.range(0) / 2)).value();
+
+    for (auto _ : state) {
+        auto result = stack.flightRepository->findByFlightNumber(flightNumber);
+        if (!result) {
+            state.SkipWithError(result.error().message.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_InMemoryFindFlightByNumber)->Arg(10)->Arg(100)->Arg(800)->Unit(benchmark::kMicrosecond);
+
+static void BM_InMemoryFindAllFlights(benchmark::State& state) {
+    InMemoryStack stack;
+    if (!stack.seed(static_cast<size_t>(state.range(0)))) {
+        state.SkipWithError("Failed to seed in-memory database");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto result = stack.flightRepository->findAll();
+        if (!result) {
+            state.SkipWithError(result.error().message.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InMemoryFindAllFlights)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+static void BM_InMemoryBookTicket(benchmark::State& state) {
+    InMemoryStack stack;
+    if (!stack.seed(static_cast<size_t>(state.range(0)))) {
+        state.SkipWithError("Failed to seed in-memory database");
+        return;
+    }
+    TicketService service(stack.ticketRepository, stack.passengerRepository, stack.flightRepository,
+                          stack.aircraftRepository, nullptr);
+
+    auto passport = PassportNumber::create(BenchFixtures::PASSPORT).value();
+    auto flightNumber = FlightNumber::create("VN100").value();
+    auto price = Price::create("100000 VND").value();
+
+    for (auto _ : state) {
+        auto result = service.bookTicket(passport, flightNumber, "E01", price);
+        if (!result) {
+            state.SkipWithError(result.error().message.c_str());
+            break;
+        }
+        // Xóa vé ngoài vùng đo để mọi lần lặp chạy trên cùng một trạng thái dữ liệu
+        state.PauseTiming();
+        stack.ticketRepository->deleteById(result.value().getId());
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_InMemoryBookTicket)->Arg(10)->Arg(800)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,89 @@
+/**
+ * @file PrefixIndexBenchmark.cpp
+ * @brief Đo tìm theo tiền tố của PrefixIndex trên 5 triệu hành khách
+ */
+
+#include "utils/PrefixIndex.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int PASSENGER_COUNT = 5000000;
+    constexpr size_t SUGGESTION_LIMIT = 100;
+
+    /// Tên ba từ như dữ liệu thật: họ và tên đệm lặp nhiều, tên riêng gần như duy nhất
+    std::string passengerName(int id) {
+        static const char* family[] = {"Nguyễn", "Trần", "Lê", "Phạm", "Hoàng", "Huỳnh", "Phan", "Vũ", "Võ", "Đặng",
+                                       "Bùi", "Đỗ", "Hồ", "Ngô", "Dương", "Lý"};
+        static const char* middle[] = {"Văn", "Thị", "Hữu", "Minh", "Ngọc", "Đức", "Thanh", "Quốc"};
+        return std::string(family[id % 16]) + " " + middle[(id / 16) % 8] + " Khach" + std::to_string(id);
+    }
+
+    std::string passportNumber(int id) {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "VN:%09d", id);
+        return buffer;
+    }
+
+    const PrefixIndex& names() {
+        static const PrefixIndex index = [] {
+            PrefixIndex built(true);
+            for (int id = 1; id <= PASSENGER_COUNT; ++id) built.append(id, passengerName(id));
+            built.seal();
+            return built;
+        }();
+        return index;
+    }
+
+    const PrefixIndex& passports() {
+        static const PrefixIndex index = [] {
+            PrefixIndex built;
+            for (int id = 1; id <= PASSENGER_COUNT; ++id) built.append(id, passportNumber(id));
+            built.seal();
+            return built;
+        }();
+        return index;
+    }
+
+    void runLookups(benchmark::State& state, const PrefixIndex& index, const std::vector<std::string>& prefixes) {
+        std::vector<int> ids;
+        ids.reserve(SUGGESTION_LIMIT);
+        size_t next = 0;
+        for (auto _ : state) {
+            ids.clear();
+            index.find(prefixes[next++ % prefixes.size()], SUGGESTION_LIMIT, ids);
+            benchmark::DoNotOptimize(ids.data());
+        }
+        state.counters["keys"] = static_cast<double>(index.keyCount());
+    }
+}
+
+static void BM_PrefixIndexNameLookup(benchmark::State& state) {
+    // Tiền tố ngắn khớp hàng trăm nghìn khóa; tiền tố dài khớp đúng một hành khách
+    runLookups(state, names(), {"ng", "nguyen v", "tran thi", "khach12", "khach4999", "duc khach3"});
+}
+BENCHMARK(BM_PrefixIndexNameLookup)->Unit(benchmark::kMicrosecond);
+
+static void BM_PrefixIndexPassportLookup(benchmark::State& state) {
+    runLookups(state, passports(), {"vn:0", "vn:00123", "vn:004999999", "vn:9"});
+}
+BENCHMARK(BM_PrefixIndexPassportLookup)->Unit(benchmark::kMicrosecond);
+
+static void BM_PrefixIndexSetDuringLookups(benchmark::State& state) {
+    PrefixIndex index(true);
+    for (int id = 1; id <= 100000; ++id) index.append(id, passengerName(id));
+    index.seal();
+
+    std::vector<int> ids;
+    int id = 1;
+    for (auto _ : state) {
+        index.set(id, passengerName(id + 100000));
+        ids.clear();
+        index.find("nguyen van", SUGGESTION_LIMIT, ids);
+        benchmark::DoNotOptimize(ids.data());
+        id = id % 100000 + 1;
+    }
+}
+BENCHMARK(BM_PrefixIndexSetDuringLookups)->Unit(benchmark::kMicrosecond);
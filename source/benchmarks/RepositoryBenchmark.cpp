@@ -0,0 +1,62 @@
+/**
+ * @file RepositoryBenchmark.cpp
+ * @brief Đo chi phí ánh xạ của FlightRepository::findAll và của repository mock
+ */
+
+#include "support/Fixtures.h"
+#include "repositories/MySQLRepository/FlightRepository.h"
+#include "repositories/MockRepository/FlightMockRepository.h"
+#include <benchmark/benchmark.h>
+
+static void BM_FlightRepositoryFindAll(benchmark::State& state) {
+    auto connection = std::make_shared<ScriptedConnection>();
+    connection->script(Tables::Flight::FIND_ALL_QUERY, BenchFixtures::flightTable(state.range(0)));
+    FlightRepository repository(connection, nullptr);
+
+    for (auto _ : state) {
+        auto result = repository.findAll();
+        if (!result) {
+            state.SkipWithError(result.error().message.c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlightRepositoryFindAll)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_FlightRepositoryFindAllSummaries(benchmark::State& state) {
+    auto connection = std::make_shared<ScriptedConnection>();
+    connection->script(Tables::Flight::FIND_ALL_SUMMARY_QUERY, BenchFixtures::flightSummaryTable(state.range(0)));
+    connection->script(Tables::Flight::COUNT_QUERY, BenchFixtures::countTable(static_cast<int>(state.range(0))));
+    FlightRepository repository(connection, nullptr);
+    std::vector<FlightSummaryRow> rows;
+
+    // Kiểm tra một lần ngoài vòng đo để chắc chắn đang đo đường giải mã chứ không phải lỗi sớm
+    auto warmup = repository.findAllSummaries(rows);
+    if (!warmup || warmup.value() != static_cast<size_t>(state.range(0))) {
+        state.SkipWithError(warmup ? "Unexpected flight summary count" : warmup.error().message.c_str());
+        return;
+    }
+
+    for (auto _ : state) {
+        auto result = repository.findAllSummaries(rows);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlightRepositoryFindAllSummaries)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_FlightMockRepositoryFindAll(benchmark::State& state) {
+    FlightMockRepository repository;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        repository.create(BenchFixtures::makeFlight("VN" + std::to_string(100 + i % 900)));
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(repository.findAll());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlightMockRepositoryFindAll)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMicrosecond);
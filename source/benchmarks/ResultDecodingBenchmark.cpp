@@ -0,0 +1,41 @@
+/**
+ * @file ResultDecodingBenchmark.cpp
+ * @brief Đo chi phí duyệt và giải mã tập kết quả theo tên cột và theo chỉ số cột
+ */
+
+#include "support/Fixtures.h"
+#include <benchmark/benchmark.h>
+
+static void BM_DecodeFlightRowsByName(benchmark::State& state) {
+    using namespace Tables::Flight;
+    auto table = std::make_shared<const ScriptedTable>(BenchFixtures::flightTable(state.range(0)));
+    for (auto _ : state) {
+        ScriptedResult result(table);
+        while (result.next().value()) {
+            benchmark::DoNotOptimize(result.getInt(ColumnName[ID]));
+            benchmark::DoNotOptimize(result.getString(ColumnName[FLIGHT_NUMBER]));
+            benchmark::DoNotOptimize(result.getDateTime(ColumnName[DEPARTURE_TIME]));
+            benchmark::DoNotOptimize(result.getString(ColumnName[STATUS]));
+            benchmark::DoNotOptimize(result.getInt("economy_seats"));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeFlightRowsByName)->RangeMultiplier(10)->Range(10, 10000);
+
+static void BM_DecodeFlightRowsByIndex(benchmark::State& state) {
+    using namespace Tables::Flight;
+    auto table = std::make_shared<const ScriptedTable>(BenchFixtures::flightTable(state.range(0)));
+    for (auto _ : state) {
+        ScriptedResult result(table);
+        while (result.next().value()) {
+            benchmark::DoNotOptimize(result.getInt(ID));
+            benchmark::DoNotOptimize(result.getString(FLIGHT_NUMBER));
+            benchmark::DoNotOptimize(result.getDateTime(DEPARTURE_TIME));
+            benchmark::DoNotOptimize(result.getString(STATUS));
+            benchmark::DoNotOptimize(result.getInt(VERSION + 3));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeFlightRowsByIndex)->RangeMultiplier(10)->Range(10, 10000);
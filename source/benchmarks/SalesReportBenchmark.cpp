@@ -0,0 +1,113 @@
+/**
+ * @file SalesReportBenchmark.cpp
+ * @brief Đo lập báo cáo doanh thu trên 50 triệu vé dạng cột và cập nhật ảnh chụp theo từng vé
+ */
+
+#include "reporting/SalesReport.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+    constexpr size_t FLIGHT_COUNT = 200000;
+    constexpr size_t TICKET_COUNT = 50000000;
+
+    /// Cột dựng thẳng, không qua repository: chỉ đo phần gộp
+    const Reporting::ReportColumns& columns() {
+        static const Reporting::ReportColumns built = [] {
+            Reporting::ReportColumns columns;
+            const char* codes[] = {"HAN", "SGN", "DAD", "PQC", "HPH", "CXR", "VCA", "HUI"};
+            for (size_t row = 0; row < FLIGHT_COUNT; ++row) {
+                FlightSummaryRow flight;
+                flight.id = static_cast<int>(row + 1);
+                flight.flightNumber = "VN" + std::to_string(row + 1);
+                flight.departureCode = codes[row % 8];
+                flight.arrivalCode = codes[(row / 8 + row + 1) % 8];
+                flight.departureTime.tm_year = 2025 - 1900;
+                flight.departureTime.tm_mon = static_cast<int>(row % 12);
+                flight.departureTime.tm_mday = static_cast<int>(1 + row % 28);
+                flight.status = row % 97 == 0 ? FlightStatus::CANCELLED : FlightStatus::SCHEDULED;
+                flight.economySeats = 180;
+                flight.businessSeats = 24;
+                flight.firstSeats = row % 3 == 0 ? 8 : 0;
+                columns.upsertFlight(flight);
+            }
+
+            auto& tickets = columns.tickets;
+            const uint16_t vnd = static_cast<uint16_t>(tickets.currencies.encode("VND"));
+            const uint16_t usd = static_cast<uint16_t>(tickets.currencies.encode("USD"));
+            tickets.id.reserve(TICKET_COUNT);
+            tickets.passengerId.reserve(TICKET_COUNT);
+            tickets.flightRow.reserve(TICKET_COUNT);
+            tickets.seatClass.reserve(TICKET_COUNT);
+            tickets.status.reserve(TICKET_COUNT);
+            tickets.currency.reserve(TICKET_COUNT);
+            tickets.price.reserve(TICKET_COUNT);
+            uint64_t state = 42;
+            for (size_t i = 0; i < TICKET_COUNT; ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                uint32_t random = static_cast<uint32_t>(state >> 33);
+                tickets.id.push_back(static_cast<int>(i + 1));
+                tickets.passengerId.push_back(static_cast<int>(random % 5000000 + 1));
+                tickets.flightRow.push_back(random % FLIGHT_COUNT);
+                tickets.seatClass.push_back(random % 10 == 0 ? 1 : random % 50 == 1 ? 2 : 0);
+                tickets.status.push_back(static_cast<uint8_t>(random % 7));
+                tickets.currency.push_back(random % 20 == 0 ? usd : vnd);
+                tickets.price.push_back(100000 + random % 500000);
+            }
+            return columns;
+        }();
+        return built;
+    }
+}
+
+static void BM_SalesReportMonth(benchmark::State& state) {
+    const auto& data = columns();
+    Reporting::ReportOptions options;
+    options.fromDay = Reporting::civilDay(2025, 5, 1);
+    options.toDay = Reporting::civilDay(2025, 5, 31);
+    options.threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        auto report = Reporting::buildSalesReport(data, options);
+        benchmark::DoNotOptimize(report.total.ticketsSold);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.tickets.size()));
+}
+BENCHMARK(BM_SalesReportMonth)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SalesReportAllTime(benchmark::State& state) {
+    const auto& data = columns();
+    Reporting::ReportOptions options;
+    options.threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        auto report = Reporting::buildSalesReport(data, options);
+        benchmark::DoNotOptimize(report.total.ticketsSold);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.tickets.size()));
+}
+BENCHMARK(BM_SalesReportAllTime)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_ColumnsUpsertTicket(benchmark::State& state) {
+    // Áp dụng một thay đổi từ Changes::Feed: ghi đè tại chỗ, không dựng lại cột
+    Reporting::ReportColumns columns;
+    FlightSummaryRow flight;
+    flight.id = 1;
+    flight.departureCode = "HAN";
+    flight.arrivalCode = "SGN";
+    columns.upsertFlight(flight);
+    TicketFactRow ticket;
+    ticket.flightId = 1;
+    ticket.seatClass = 'E';
+    ticket.currency = "VND";
+    for (int id = 1; id <= 1000000; ++id) {
+        ticket.id = id;
+        columns.upsertTicket(ticket);
+    }
+
+    int id = 1;
+    for (auto _ : state) {
+        ticket.id = id;
+        ticket.status = static_cast<TicketStatus>(id % 7);
+        benchmark::DoNotOptimize(columns.upsertTicket(ticket));
+        id = id % 1000000 + 1;
+    }
+}
+BENCHMARK(BM_ColumnsUpsertTicket);
@@ -0,0 +1,79 @@
+/**
+ * @file ValueObjectBenchmark.cpp
+ * @brief Đo chi phí tạo và validate các value object
+ */
+
+#include "core/value_objects/flight_number/FlightNumber.h"
+#include "core/value_objects/passport_number/PassportNumber.h"
+#include "core/value_objects/price/Price.h"
+#include "core/value_objects/contact_info/ContactInfo.h"
+#include "core/value_objects/ticket_number/TicketNumber.h"
+#include "core/value_objects/seat_class_map/SeatClassMap.h"
+#include "core/value_objects/seat_number/SeatNumber.h"
+#include "core/value_objects/route/Route.h"
+#include "core/value_objects/schedule/Schedule.h"
+#include <benchmark/benchmark.h>
+
+static void BM_FlightNumberCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FlightNumber::create("VN123"));
+    }
+}
+BENCHMARK(BM_FlightNumberCreate);
+
+static void BM_PassportNumberCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PassportNumber::create("VN:1232323"));
+    }
+}
+BENCHMARK(BM_PassportNumberCreate);
+
+static void BM_PriceCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Price::create("100000 VND"));
+    }
+}
+BENCHMARK(BM_PriceCreate);
+
+static void BM_ContactInfoCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ContactInfo::create("a@example.com|+84123456789|1 Le Loi"));
+    }
+}
+BENCHMARK(BM_ContactInfoCreate);
+
+static void BM_TicketNumberCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TicketNumber::create("VN123-20250601-0001"));
+    }
+}
+BENCHMARK(BM_TicketNumberCreate);
+
+static void BM_SeatClassMapCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SeatClassMap::create("E:180,B:24,F:8"));
+    }
+}
+BENCHMARK(BM_SeatClassMapCreate);
+
+static void BM_SeatNumberCreate(benchmark::State& state) {
+    auto layout = SeatClassMap::create("E:180,B:24,F:8").value();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SeatNumber::create("E101", layout));
+    }
+}
+BENCHMARK(BM_SeatNumberCreate);
+
+static void BM_RouteCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Route::create("Ho Chi Minh City(SGN)-Ha Noi(HAN)"));
+    }
+}
+BENCHMARK(BM_RouteCreate);
+
+static void BM_ScheduleCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Schedule::create("2024-03-15 10:00|2024-03-15 12:00"));
+    }
+}
+BENCHMARK(BM_ScheduleCreate);
@@ -0,0 +1,108 @@
+/**
+ * @file Fixtures.h
+ * @brief Dữ liệu mẫu dùng chung cho các benchmark
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Các hàm trong file này dựng value object, entity và bảng kết quả dựng sẵn có cùng
+ * hình dạng với dữ liệu repository đọc từ MySQL, để benchmark đo đúng đường đi thật.
+ */
+
+#ifndef BENCHMARK_FIXTURES_H
+#define BENCHMARK_FIXTURES_H
+
+#include "ScriptedConnection.h"
+#include "core/entities/Aircraft.h"
+#include "core/entities/Flight.h"
+#include "core/value_objects/route/Route.h"
+#include "core/value_objects/schedule/Schedule.h"
+#include "utils/TableConstants.h"
+#include <memory>
+#include <string>
+
+namespace BenchFixtures {
+    constexpr const char* SEAT_LAYOUT = "E:180,B:24,F:8";
+    /// Giờ khởi hành đã qua để qua được quy tắc canBookFlight hiện tại
+    constexpr const char* DEPARTURE = "2024-03-15 10:00:00";
+    constexpr const char* ARRIVAL = "2024-03-15 12:00:00";
+    constexpr const char* PASSPORT = "VN:1232323";
+
+    inline std::shared_ptr<Aircraft> makeAircraft() {
+        auto aircraft = Aircraft::create(AircraftSerial::create("VN001").value(), "Airbus A321",
+                                         SeatClassMap::create(SEAT_LAYOUT).value()).value();
+        aircraft.setId(1);
+        return std::make_shared<Aircraft>(aircraft);
+    }
+
+    inline Flight makeFlight(const std::string& flightNumber = "VN123") {
+        auto flight = Flight::create(FlightNumber::create(flightNumber).value(),
+                                     Route::create("Ho Chi Minh City(SGN)-Ha Noi(HAN)").value(),
+                                     Schedule::create("2024-03-15 10:00|2024-03-15 12:00").value(),
+                                     makeAircraft()).value();
+        flight.setId(1);
+        return flight;
+    }
+
+    /**
+     * @brief Bảng kết quả có cột giống Tables::Flight::getOrderedSelectClause()
+     * @param rowCount Số chuyến bay
+     */
+    inline ScriptedTable flightTable(size_t rowCount) {
+        using namespace Tables::Flight;
+        ScriptedTable table;
+        table.columns = {ColumnName[ID], ColumnName[FLIGHT_NUMBER], ColumnName[DEPARTURE_CODE],
+                         ColumnName[DEPARTURE_NAME], ColumnName[ARRIVAL_CODE], ColumnName[ARRIVAL_NAME],
+                         ColumnName[AIRCRAFT_ID], ColumnName[DEPARTURE_TIME], ColumnName[ARRIVAL_TIME],
+                         ColumnName[STATUS], ColumnName[VERSION],
+                         "serial_number", "model", "economy_seats", "business_seats", "first_seats"};
+        table.rows.reserve(rowCount);
+        for (size_t i = 0; i < rowCount; ++i) {
+            table.rows.push_back({std::to_string(i + 1), "VN" + std::to_string(100 + i % 900), "SGN",
+                                  "Ho Chi Minh City", "HAN", "Ha Noi", "1", DEPARTURE, ARRIVAL,
+                                  "SCHEDULED", "0", "VN001", "Airbus A321", "180", "24", "8"});
+        }
+        return table;
+    }
+
+    /**
+     * @brief Bảng kết quả có cột giống Tables::Flight::FIND_ALL_SUMMARY_QUERY
+     * @param rowCount Số chuyến bay
+     */
+    inline ScriptedTable flightSummaryTable(size_t rowCount) {
+        using namespace Tables::Flight;
+        ScriptedTable table;
+        table.columns = {ColumnName[ID], ColumnName[FLIGHT_NUMBER], ColumnName[DEPARTURE_CODE],
+                         ColumnName[DEPARTURE_NAME], ColumnName[ARRIVAL_CODE], ColumnName[ARRIVAL_NAME],
+                         ColumnName[DEPARTURE_TIME], ColumnName[ARRIVAL_TIME], ColumnName[STATUS],
+                         "serial_number", "economy_seats", "business_seats", "first_seats"};
+        table.rows.reserve(rowCount);
+        for (size_t i = 0; i < rowCount; ++i) {
+            table.rows.push_back({std::to_string(i + 1), "VN" + std::to_string(100 + i % 900), "SGN",
+                                  "Ho Chi Minh City", "HAN", "Ha Noi", DEPARTURE, ARRIVAL,
+                                  "SCHEDULED", "VN001", "180", "24", "8"});
+        }
+        return table;
+    }
+
+    /**
+     * @brief Bảng kết quả có cột giống SELECT * FROM passenger
+     */
+    inline ScriptedTable passengerTable() {
+        using namespace Tables::Passenger;
+        ScriptedTable table;
+        table.columns = {ColumnName[ID], ColumnName[PASSPORT_NUMBER], ColumnName[NAME], ColumnName[EMAIL],
+                         ColumnName[PHONE], ColumnName[ADDRESS], ColumnName[VERSION]};
+        table.rows.push_back({"1", PASSPORT, "Nguyen Van A", "a@example.com", "+84123456789", "1 Le Loi", "0"});
+        return table;
+    }
+
+    /**
+     * @brief Bảng một ô cho các truy vấn COUNT(*)
+     */
+    inline ScriptedTable countTable(int count) {
+        return ScriptedTable{{"COUNT(*)"}, {{std::to_string(count)}}};
+    }
+}
+
+#endif // BENCHMARK_FIXTURES_H
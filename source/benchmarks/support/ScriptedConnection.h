@@ -0,0 +1,209 @@
+/**
+ * @file ScriptedConnection.h
+ * @brief IDatabaseConnection chạy trong tiến trình, trả về tập kết quả dựng sẵn cho benchmark
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Benchmark cần chạy repository và service thật nhưng không được phụ thuộc MySQL server.
+ * ScriptedConnection ánh xạ đúng chuỗi SQL (lấy từ Tables::*) sang một bảng kết quả dựng sẵn;
+ * câu lệnh không trả dữ liệu luôn thành công với một hàng bị ảnh hưởng. Nhờ vậy thời gian đo
+ * được chỉ gồm chi phí của mã ánh xạ và nghiệp vụ, không có độ trễ mạng.
+ */
+
+#ifndef SCRIPTED_CONNECTION_H
+#define SCRIPTED_CONNECTION_H
+
+#include "database/InterfaceDatabaseConnection.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Bảng kết quả dựng sẵn: tên cột và các hàng giá trị dạng chuỗi
+ */
+struct ScriptedTable {
+    std::vector<std::string> columns;
+    std::vector<std::vector<std::string>> rows;
+};
+
+/**
+ * @brief Con trỏ duyệt trên một ScriptedTable
+ */
+class ScriptedResult : public IDatabaseResult {
+private:
+    std::shared_ptr<const ScriptedTable> _table;
+    size_t _cursor = 0;
+    bool _started = false;
+
+    Result<std::string> cell(const int& columnIndex) const {
+        if (!_started || _cursor >= _table->rows.size()) {
+            return Failure<std::string>(CoreError("No current row available"));
+        }
+        const auto& row = _table->rows[_cursor];
+        if (columnIndex < 0 || columnIndex >= static_cast<int>(row.size())) {
+            return Failure<std::string>(CoreError("Column index out of range"));
+        }
+        return Success(row[columnIndex]);
+    }
+
+    int indexOf(const std::string& columnName) const {
+        auto it = std::find(_table->columns.begin(), _table->columns.end(), columnName);
+        return it == _table->columns.end() ? -1 : static_cast<int>(std::distance(_table->columns.begin(), it));
+    }
+
+public:
+    explicit ScriptedResult(std::shared_ptr<const ScriptedTable> table) : _table(std::move(table)) {}
+
+    Result<bool> next() override {
+        if (_started) {
+            ++_cursor;
+        }
+        _started = true;
+        return Success(_cursor < _table->rows.size());
+    }
+
+    Result<std::string> getString(const int& columnIndex) override {
+        return cell(columnIndex);
+    }
+
+    Result<int> getInt(const int& columnIndex) override {
+        auto value = cell(columnIndex);
+        if (!value) return Failure<int>(value.error());
+        return Success(std::stoi(value.value()));
+    }
+
+    Result<double> getDouble(const int& columnIndex) override {
+        auto value = cell(columnIndex);
+        if (!value) return Failure<double>(value.error());
+        return Success(std::stod(value.value()));
+    }
+
+    Result<std::tm> getDateTime(const int& columnIndex) override {
+        auto value = cell(columnIndex);
+        if (!value) return Failure<std::tm>(value.error());
+        std::tm tm{};
+        std::istringstream ss(value.value());
+        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        if (ss.fail()) return Failure<std::tm>(CoreError("Invalid datetime: " + value.value()));
+        return Success(tm);
+    }
+
+    Result<std::string> getString(const std::string& columnName) override {
+        return getString(indexOf(columnName));
+    }
+
+    Result<int> getInt(const std::string& columnName) override {
+        return getInt(indexOf(columnName));
+    }
+
+    Result<double> getDouble(const std::string& columnName) override {
+        return getDouble(indexOf(columnName));
+    }
+
+    Result<std::tm> getDateTime(const std::string& columnName) override {
+        return getDateTime(indexOf(columnName));
+    }
+};
+
+/**
+ * @brief Kết nối giả trả về bảng dựng sẵn theo chuỗi SQL
+ *
+ * Câu SELECT không được đăng ký trả về bảng rỗng. Tham số bind bị bỏ qua; benchmark
+ * đăng ký dữ liệu đúng với đường đi đang đo.
+ */
+class ScriptedConnection : public IDatabaseConnection {
+private:
+    std::unordered_map<std::string, std::shared_ptr<const ScriptedTable>> _scripts;
+    std::map<int, std::string> _statements;
+    std::shared_ptr<const ScriptedTable> _empty = std::make_shared<ScriptedTable>();
+    int _nextStatementId = 1;
+    int _lastInsertId = 0;
+    size_t _roundTrips = 0;
+
+    Result<std::unique_ptr<IDatabaseResult>> run(const std::string& query) {
+        ++_roundTrips;
+        auto it = _scripts.find(query);
+        const auto& table = it == _scripts.end() ? _empty : it->second;
+        return Success<std::unique_ptr<IDatabaseResult>>(std::make_unique<ScriptedResult>(table));
+    }
+
+public:
+    /**
+     * @brief Đăng ký bảng kết quả cho một câu SQL
+     * @param query Chuỗi SQL đúng như repository chuẩn bị
+     * @param table Bảng kết quả trả về cho mọi lần thực thi
+     */
+    void script(const std::string& query, ScriptedTable table) {
+        _scripts[query] = std::make_shared<const ScriptedTable>(std::move(table));
+    }
+
+    /**
+     * @brief Số lượt thực thi đã phục vụ (tương đương số round trip tới server)
+     */
+    size_t getRoundTrips() const { return _roundTrips; }
+
+    Result<bool> connect(const std::string&, const std::string&, const std::string&,
+                         const std::string&, const int&) override {
+        return Success(true);
+    }
+    VoidResult disconnect() override { return Success(); }
+
+    Result<bool> execute(const std::string&) override {
+        ++_roundTrips;
+        return Success(true);
+    }
+    Result<std::unique_ptr<IDatabaseResult>> executeQuery(const std::string& query) override {
+        return run(query);
+    }
+
+    Result<int> prepareStatement(const std::string& query) override {
+        int id = _nextStatementId++;
+        _statements.emplace(id, query);
+        return Success(id);
+    }
+    VoidResult setString(const int&, const int&, const std::string&) override { return Success(); }
+    VoidResult setInt(const int&, const int&, const int&) override { return Success(); }
+    VoidResult setDouble(const int&, const int&, const double&) override { return Success(); }
+    VoidResult setDateTime(const int&, const int&, const std::tm&) override { return Success(); }
+
+    Result<bool> executeStatement(const int& statementId) override {
+        if (_statements.find(statementId) == _statements.end()) {
+            return Failure<bool>(CoreError("Invalid statement ID"));
+        }
+        ++_roundTrips;
+        ++_lastInsertId;
+        return Success(true);
+    }
+    Result<int> executeUpdate(const int& statementId) override {
+        auto executed = executeStatement(statementId);
+        if (!executed) return Failure<int>(executed.error());
+        return Success(1);
+    }
+    Result<std::unique_ptr<IDatabaseResult>> executeQueryStatement(const int& statementId) override {
+        auto it = _statements.find(statementId);
+        if (it == _statements.end()) {
+            return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("Invalid statement ID"));
+        }
+        return run(it->second);
+    }
+    VoidResult freeStatement(const int& statementId) override {
+        _statements.erase(statementId);
+        return Success();
+    }
+
+    Result<int> getLastInsertId() override { return Success(_lastInsertId); }
+    Result<bool> isConnected() const override { return Success(true); }
+    Result<std::string> getLastError() const override { return Success(std::string()); }
+
+    Result<bool> beginTransaction() override { return Success(true); }
+    Result<bool> commitTransaction() override { return Success(true); }
+    Result<bool> rollbackTransaction() override { return Success(true); }
+};
+
+#endif // SCRIPTED_CONNECTION_H
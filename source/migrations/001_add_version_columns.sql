@@ -0,0 +1,29 @@
+-- Thêm cột version cho các CSDL tạo từ schema.sql trước khi có optimistic concurrency.
+-- Chạy được nhiều lần: cột đã tồn tại thì bỏ qua.
+-- mysql -u <user> -p airlines_db < migrations/001_add_version_columns.sql
+USE airlines_db;
+
+DROP PROCEDURE IF EXISTS add_version_column;
+
+DELIMITER //
+CREATE PROCEDURE add_version_column(IN table_name_in VARCHAR(64))
+BEGIN
+    IF NOT EXISTS (
+        SELECT 1 FROM information_schema.COLUMNS
+        WHERE TABLE_SCHEMA = DATABASE()
+          AND TABLE_NAME = table_name_in
+          AND COLUMN_NAME = 'version'
+    ) THEN
+        SET @ddl = CONCAT('ALTER TABLE `', table_name_in, '` ADD COLUMN version INT NOT NULL DEFAULT 0');
+        PREPARE stmt FROM @ddl;
+        EXECUTE stmt;
+        DEALLOCATE PREPARE stmt;
+    END IF;
+END //
+DELIMITER ;
+
+CALL add_version_column('flight');
+CALL add_version_column('passenger');
+CALL add_version_column('ticket');
+
+DROP PROCEDURE add_version_column;
@@ -34,6 +34,10 @@ CREATE TABLE aircraft_seat_layout (
     UNIQUE KEY unique_aircraft_seat_class (aircraft_id, seat_class_code)
 );
 
+-- Cột version trên flight, passenger, ticket phục vụ optimistic concurrency:
+-- mọi UPDATE tăng version và chỉ áp dụng khi version khớp với giá trị đã đọc.
+-- CSDL tạo trước khi có cột này cần chạy migrations/001_add_version_columns.sql.
+
 -- Flight table (merged with route)
 CREATE TABLE flight (
     id INT AUTO_INCREMENT PRIMARY KEY,
@@ -46,6 +50,7 @@ CREATE TABLE flight (
     departure_time DATETIME NOT NULL,
     arrival_time DATETIME NOT NULL,
     status ENUM('SCHEDULED', 'DELAYED', 'BOARDING', 'DEPARTED', 'IN_FLIGHT', 'LANDED', 'CANCELLED') DEFAULT 'SCHEDULED',
+    version INT NOT NULL DEFAULT 0,
     FOREIGN KEY (aircraft_id) REFERENCES aircraft(id),
     CHECK (arrival_time > departure_time),
     CHECK (departure_code != arrival_code)
@@ -58,7 +63,8 @@ CREATE TABLE passenger (
     name VARCHAR(100) NOT NULL,
     email VARCHAR(254) NOT NULL,
     phone VARCHAR(15) NOT NULL,
-    address VARCHAR(100)
+    address VARCHAR(100),
+    version INT NOT NULL DEFAULT 0
 );
 
 -- Ticket table
@@ -71,6 +77,7 @@ CREATE TABLE ticket (
     price DECIMAL(10,2) NOT NULL CHECK (price >= 0),
     currency VARCHAR(3) NOT NULL,
     status ENUM('PENDING', 'CONFIRMED', 'CHECKED_IN', 'BOARDED', 'COMPLETED', 'CANCELLED', 'REFUNDED') DEFAULT 'PENDING',
+    version INT NOT NULL DEFAULT 0,
     FOREIGN KEY (flight_id) REFERENCES flight(id),
     FOREIGN KEY (passenger_id) REFERENCES passenger(id),
     UNIQUE KEY unique_flight_seat (flight_id, seat_number)
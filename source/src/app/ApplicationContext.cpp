@@ -0,0 +1,16 @@
+#include "ApplicationContext.h"
+
+ApplicationContext::ApplicationContext(std::shared_ptr<IDatabaseConnection> connection, std::shared_ptr<Logger> logger)
+    : _connection(std::move(connection)), _logger(std::move(logger)) {
+    // Create repositories
+    _aircraftRepository = std::make_shared<AircraftRepository>(_connection, _logger);
+    _flightRepository = std::make_shared<FlightRepository>(_connection, _logger);
+    _passengerRepository = std::make_shared<PassengerRepository>(_connection, _logger);
+    _ticketRepository = std::make_shared<TicketRepository>(_connection, _passengerRepository, _flightRepository, _logger);
+
+    // Create services with their repositories
+    _aircraftService = std::make_shared<AircraftService>(_aircraftRepository, _flightRepository, _ticketRepository, _logger);
+    _flightService = std::make_shared<FlightService>(_flightRepository, _aircraftRepository, _ticketRepository, _logger);
+    _passengerService = std::make_shared<PassengerService>(_passengerRepository, _ticketRepository, _flightRepository, _logger);
+    _ticketService = std::make_shared<TicketService>(_ticketRepository, _passengerRepository, _flightRepository, _aircraftRepository, _logger);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file ApplicationContext.h
+ * @brief Composition root dùng chung cho giao diện wxWidgets và airlines_cli
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Trước đây toàn bộ repository và service được dựng trong AirlinesApp::OnInit nên chỉ
+ * tiến trình GUI mới dùng được. ApplicationContext gom phần nối dây đó vào một chỗ không phụ
+ * thuộc wxWidgets: nhận một kết nối cơ sở dữ liệu bất kỳ (MySQLXConnection khi chạy thật,
+ * InMemoryConnection trong test) và dựng bốn repository cùng bốn service theo đúng thứ tự phụ
+ * thuộc. Việc mở kết nối MySQL được tách sang DatabaseSettings để test không phải link
+ * MySQL Connector/C++.
+ */
+
+#ifndef APPLICATION_CONTEXT_H
+#define APPLICATION_CONTEXT_H
+
+#include "../database/InterfaceDatabaseConnection.h"
+#include "../repositories/MySQLRepository/AircraftRepository.h"
+#include "../repositories/MySQLRepository/FlightRepository.h"
+#include "../repositories/MySQLRepository/PassengerRepository.h"
+#include "../repositories/MySQLRepository/TicketRepository.h"
+#include "../services/AircraftService.h"
+#include "../services/FlightService.h"
+#include "../services/PassengerService.h"
+#include "../services/TicketService.h"
+#include "../utils/Logger.h"
+#include <memory>
+
+class ApplicationContext {
+private:
+    std::shared_ptr<IDatabaseConnection> _connection;
+    std::shared_ptr<Logger> _logger;
+
+    std::shared_ptr<AircraftRepository> _aircraftRepository;
+    std::shared_ptr<FlightRepository> _flightRepository;
+    std::shared_ptr<PassengerRepository> _passengerRepository;
+    std::shared_ptr<TicketRepository> _ticketRepository;
+
+    std::shared_ptr<AircraftService> _aircraftService;
+    std::shared_ptr<FlightService> _flightService;
+    std::shared_ptr<PassengerService> _passengerService;
+    std::shared_ptr<TicketService> _ticketService;
+
+public:
+    /**
+     * @brief Dựng repository và service trên một kết nối đã mở
+     * @param connection Kết nối cơ sở dữ liệu, không được null
+     * @param logger Logger truyền cho mọi tầng; nullptr để tắt log (ví dụ khi đo tải)
+     */
+    ApplicationContext(std::shared_ptr<IDatabaseConnection> connection, std::shared_ptr<Logger> logger);
+
+    const std::shared_ptr<IDatabaseConnection>& connection() const { return _connection; }
+    const std::shared_ptr<Logger>& logger() const { return _logger; }
+
+    const std::shared_ptr<AircraftRepository>& aircraftRepository() const { return _aircraftRepository; }
+    const std::shared_ptr<FlightRepository>& flightRepository() const { return _flightRepository; }
+    const std::shared_ptr<PassengerRepository>& passengerRepository() const { return _passengerRepository; }
+    const std::shared_ptr<TicketRepository>& ticketRepository() const { return _ticketRepository; }
+
+    const std::shared_ptr<AircraftService>& aircraftService() const { return _aircraftService; }
+    const std::shared_ptr<FlightService>& flightService() const { return _flightService; }
+    const std::shared_ptr<PassengerService>& passengerService() const { return _passengerService; }
+    const std::shared_ptr<TicketService>& ticketService() const { return _ticketService; }
+};
+
+#endif // APPLICATION_CONTEXT_H
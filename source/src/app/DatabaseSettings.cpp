@@ -0,0 +1,57 @@
+#include "DatabaseSettings.h"
+#include "../database/MySQLXConnection.h"
+#include <cstdlib>
+
+namespace {
+    void readEnvironment(const char* name, std::string& target) {
+        if (const char* value = std::getenv(name)) target = value;
+    }
+}
+
+DatabaseSettings DatabaseSettings::fromEnvironment() {
+    DatabaseSettings settings;
+    readEnvironment("AIRLINES_DB_HOST", settings.host);
+    readEnvironment("AIRLINES_DB_USER", settings.user);
+    readEnvironment("AIRLINES_DB_PASSWORD", settings.password);
+    readEnvironment("AIRLINES_DB_NAME", settings.database);
+    if (const char* port = std::getenv("AIRLINES_DB_PORT")) {
+        settings.port = std::atoi(port);
+    }
+    if (const char* threshold = std::getenv("AIRLINES_SLOW_QUERY_MS")) {
+        settings.slowQueryMillis = std::atoi(threshold);
+    }
+    readEnvironment("AIRLINES_SLOW_QUERY_LOG", settings.slowQueryLogPath);
+    return settings;
+}
+
+void configureQueryStats(const DatabaseSettings& settings) {
+    if (settings.slowQueryMillis <= 0) return;
+    settings.queryStats->setSlowQueryLog(std::chrono::milliseconds(settings.slowQueryMillis),
+                                         std::make_shared<FileLogHandler>(settings.slowQueryLogPath));
+}
+
+Result<std::shared_ptr<IDatabaseConnection>> connectDatabase(const DatabaseSettings& settings) {
+    auto connection = MySQLXConnection::getInstance();
+    connection->setQueryStats(settings.queryStats);
+    auto result = connection->connect(settings.host, settings.user, settings.password, settings.database, settings.port);
+    if (!result) {
+        return Failure<std::shared_ptr<IDatabaseConnection>>(
+            CoreError("Failed to connect to the database: " + result.error().message, "DB_CONNECTION_FAILED"));
+    }
+    return Success(std::shared_ptr<IDatabaseConnection>(connection));
+}
+
+Result<std::shared_ptr<IDatabaseConnection>> connectDatabaseSession(const DatabaseSettings& settings) {
+    auto connection = MySQLXConnection::createSession();
+    connection->setQueryStats(settings.queryStats);
+    auto result = connection->connect(settings.host, settings.user, settings.password, settings.database, settings.port);
+    if (!result) {
+        return Failure<std::shared_ptr<IDatabaseConnection>>(
+            CoreError("Failed to connect to the database: " + result.error().message, "DB_CONNECTION_FAILED"));
+    }
+    return Success(std::shared_ptr<IDatabaseConnection>(connection));
+}
+
+Result<std::shared_ptr<ConnectionPool>> connectDatabasePool(const DatabaseSettings& settings, size_t size) {
+    return ConnectionPool::create([settings]() { return connectDatabaseSession(settings); }, size);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file DatabaseSettings.h
+ * @brief Thông số kết nối MySQL dùng chung cho GUI và airlines_cli
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Giá trị mặc định giữ nguyên thông số từng được viết cứng trong main.cpp. Biến môi trường
+ * AIRLINES_DB_HOST, AIRLINES_DB_USER, AIRLINES_DB_PASSWORD, AIRLINES_DB_NAME và
+ * AIRLINES_DB_PORT ghi đè từng giá trị, để các job chạy theo lịch trên server không phải
+ * truyền mật khẩu qua dòng lệnh.
+ *
+ * Mọi kết nối mở từ cùng một bộ thông số ghi số đo vào chung queryStats. Đặt
+ * AIRLINES_SLOW_QUERY_MS (ngưỡng, mili giây) để ghi truy vấn chậm ra AIRLINES_SLOW_QUERY_LOG
+ * (mặc định slow_query.log).
+ */
+
+#ifndef DATABASE_SETTINGS_H
+#define DATABASE_SETTINGS_H
+
+#include "../core/exceptions/Result.h"
+#include "../database/ConnectionPool.h"
+#include "../database/QueryStats.h"
+#include <memory>
+#include <string>
+
+struct DatabaseSettings {
+    std::string host = "localhost";
+    std::string user = "cuong116";
+    std::string password = "1162005";
+    std::string database = "airlines_db";
+    int port = 33060;
+    int slowQueryMillis = 0;                         ///< 0: tắt nhật ký truy vấn chậm
+    std::string slowQueryLogPath = "slow_query.log";
+    std::shared_ptr<QueryStats> queryStats = std::make_shared<QueryStats>(); ///< Dùng chung giữa các bản sao
+
+    /**
+     * @brief Giá trị mặc định, ghi đè bởi các biến môi trường AIRLINES_DB_*
+     */
+    static DatabaseSettings fromEnvironment();
+};
+
+/**
+ * @brief Bật nhật ký truy vấn chậm của settings.queryStats theo slowQueryMillis và slowQueryLogPath
+ *
+ * Gọi một lần sau khi đã ghi đè thông số từ dòng lệnh; không làm gì khi slowQueryMillis bằng 0.
+ */
+void configureQueryStats(const DatabaseSettings& settings);
+
+/**
+ * @brief Mở kết nối MySQLXConnection (singleton) theo thông số cho trước
+ * @return Kết nối đã mở, hoặc lỗi DB_CONNECTION_FAILED kèm thông báo của driver
+ */
+Result<std::shared_ptr<IDatabaseConnection>> connectDatabase(const DatabaseSettings& settings);
+
+/**
+ * @brief Mở một session MySQL độc lập với singleton (MySQLXConnection::createSession)
+ * @return Kết nối đã mở, hoặc lỗi DB_CONNECTION_FAILED kèm thông báo của driver
+ */
+Result<std::shared_ptr<IDatabaseConnection>> connectDatabaseSession(const DatabaseSettings& settings);
+
+/**
+ * @brief Mở size session MySQL độc lập (MySQLXConnection::createSession) trong một ConnectionPool
+ * @return Pool đã mở đủ kết nối, hoặc lỗi DB_CONNECTION_FAILED
+ */
+Result<std::shared_ptr<ConnectionPool>> connectDatabasePool(const DatabaseSettings& settings, size_t size);
+
+#endif // DATABASE_SETTINGS_H
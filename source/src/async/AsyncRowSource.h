@@ -0,0 +1,345 @@
+/**
+ * @file AsyncRowSource.h
+ * @brief Nguồn hàng cho danh sách ảo, đếm và nạp trang trên worker, giao kết quả về luồng giao diện
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * PagedRowCache nạp trang ngay trên luồng gọi, nên một trang chậm làm đơ luồng giao diện trong
+ * lúc vẽ. AsyncRowSource giữ cùng bộ đệm trang nhưng không bao giờ chờ:
+ *
+ * - refresh() chạy truy vấn đếm trên worker; khi có số hàng, danh sách hiện đủ số hàng ngay và
+ *   các trang được điền dần khi chúng về (kết quả từng phần)
+ * - row(index) trả về hàng nếu trang đã có, nếu không trả nullptr và xếp trang đó vào hàng chờ
+ * - Tối đa maxInFlight trang được nạp cùng lúc; trang chờ mới nhất (vùng người dùng vừa cuộn tới)
+ *   được nạp trước, trang chờ cũ hơn maxPages bị bỏ
+ * - cancel() hủy lượt đang chạy và ngừng nạp đến lần refresh() sau; kết quả về muộn của lượt đã
+ *   hủy bị bỏ qua
+ *
+ * Thay đổi từ Changes::Feed được áp dụng tại chỗ qua apply(): sửa một hàng đang có trong bộ đệm
+ * chỉ nạp lại đúng hàng đó (trang một hàng tại vị trí của nó); thêm hoặc xóa chỉ dời số hàng và
+ * bỏ các trang bị dịch chuyển. Trang đang nạp dở khi có thay đổi được nạp lại vì kết quả của nó
+ * có thể đã cũ. Lượt đếm đang chạy có thể đã bỏ lỡ thay đổi nên thêm hoặc xóa lúc đó đếm lại.
+ *
+ * Kết quả từ worker chỉ được áp dụng qua Dispatcher (trong giao diện là CallAfter), nên mọi trạng
+ * thái của lớp chỉ được đọc và ghi trên một luồng. Hàm chạy trên worker không chạm vào đối tượng.
+ *
+ * @note Đối tượng phải bị hủy trên luồng của Dispatcher; hủy đối tượng cũng hủy lượt đang chạy.
+ */
+
+#ifndef ASYNC_ASYNC_ROW_SOURCE_H
+#define ASYNC_ASYNC_ROW_SOURCE_H
+
+#include "CallContext.h"
+#include "Future.h"
+#include "../utils/ChangeFeed.h"
+#include "../utils/PagedRowCache.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace Async {
+
+template <typename Row>
+class AsyncRowSource {
+public:
+    using CountLoader = std::function<Future<size_t>(const CallContext& context)>;
+    using PageLoader = std::function<Future<std::vector<Row>>(const CallContext& context, size_t offset, size_t limit)>;
+    /// Chuyển một hàm về luồng sở hữu đối tượng (luồng giao diện)
+    using Dispatcher = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief Các hàm được gọi trên luồng của Dispatcher khi trạng thái thay đổi
+     */
+    struct Listener {
+        std::function<void(size_t count)> countReady;               ///< Có tổng số hàng
+        std::function<void(size_t first, size_t last)> rowsReady;   ///< Các hàng [first, last] vừa có
+        std::function<void(const CoreError& error)> failed;         ///< Lượt nạp lỗi, ngừng nạp đến refresh()
+        std::function<void(bool loading)> loadingChanged;           ///< Bắt đầu hoặc hết việc đang chạy
+        std::function<void(size_t count, size_t first)> countChanged;   ///< Thêm hoặc xóa: còn count hàng, từ first trở đi đã dịch
+    };
+
+private:
+    CountLoader _countLoader;
+    PageLoader _pageLoader;
+    Dispatcher _dispatch;
+    Listener _listener;
+    PagedRowCache<Row> _cache;
+    size_t _maxInFlight;
+    std::chrono::milliseconds _timeout;
+
+    CancellationSource _cancellation;
+    bool _countPending = false;
+    bool _counted = false;                ///< Đã có số hàng của lượt hiện tại
+    bool _wasLoading = false;
+    bool _stopped = false;                ///< Người dùng đã hủy, không nạp thêm đến refresh()
+    std::set<size_t> _inFlight;
+    std::deque<size_t> _waiting;          ///< Trang chờ nạp, mới nhất ở đầu
+    std::unordered_map<int, size_t> _rowReloads;   ///< Hàng đang được nạp lại theo id, kèm vị trí
+    std::optional<CoreError> _error;
+
+    CallContext context() const { return CallContext::create(_timeout, _cancellation.token()); }
+
+    /// Gắn fn vào future: kết quả được chuyển về luồng giao diện và bỏ qua nếu lượt đã bị hủy
+    template <typename T, typename F>
+    void deliver(Future<T> future, F fn) {
+        auto token = _cancellation.token();
+        future.onReady([dispatch = _dispatch, token, fn = std::move(fn)](Result<T> result) mutable {
+            dispatch([token, fn, result = std::move(result)]() mutable {
+                if (!token.isCancelled()) fn(std::move(result));
+            });
+        });
+    }
+
+    /// Bỏ lượt hiện tại: kết quả đang về của nó sẽ bị bỏ qua
+    void abort() {
+        _cancellation.cancel();
+        _cancellation = CancellationSource();
+        _countPending = false;
+        _inFlight.clear();
+        _rowReloads.clear();
+        _waiting.clear();
+        notifyLoading();
+    }
+
+    void notifyLoading() {
+        bool loading = this->loading();
+        if (loading == _wasLoading) return;
+        _wasLoading = loading;
+        if (_listener.loadingChanged) _listener.loadingChanged(loading);
+    }
+
+    void fail(const CoreError& error) {
+        _error = error;
+        _waiting.clear();
+        if (_listener.failed) _listener.failed(error);
+    }
+
+    /// Đưa trang lên đầu hàng chờ nếu nó chưa có và chưa đang nạp
+    void enqueue(size_t pageIndex) {
+        if (_error || _stopped || _cache.hasPage(pageIndex) || _inFlight.count(pageIndex)) return;
+        auto waiting = std::find(_waiting.begin(), _waiting.end(), pageIndex);
+        if (waiting != _waiting.end()) _waiting.erase(waiting);
+        _waiting.push_front(pageIndex);
+        // Trang chờ quá cũ không còn nằm trong vùng hiển thị
+        size_t capacity = _cache.maxPages();
+        if (_waiting.size() > capacity) _waiting.resize(capacity);
+    }
+
+    void startLoads() {
+        while (!_error && _inFlight.size() < _maxInFlight && !_waiting.empty()) {
+            size_t pageIndex = _waiting.front();
+            _waiting.pop_front();
+            if (_cache.hasPage(pageIndex)) continue;
+            _inFlight.insert(pageIndex);
+            size_t offset = pageIndex * _cache.pageSize();
+            deliver(_pageLoader(context(), offset, _cache.pageSize()),
+                    [this, pageIndex](Result<std::vector<Row>> rows) { pageLoaded(pageIndex, std::move(rows)); });
+        }
+        notifyLoading();
+    }
+
+    void pageLoaded(size_t pageIndex, Result<std::vector<Row>> rows) {
+        _inFlight.erase(pageIndex);
+        if (!rows) {
+            fail(rows.error());
+            notifyLoading();
+            return;
+        }
+        size_t first = pageIndex * _cache.pageSize();
+        size_t count = rows.value().size();
+        _cache.insertPage(pageIndex, std::move(rows.value()));
+        if (count > 0 && _listener.rowsReady) _listener.rowsReady(first, first + count - 1);
+        startLoads();
+    }
+
+    /// Nạp lại một hàng tại vị trí hiện tại của nó (trang một hàng)
+    void reloadRow(int id, size_t index) {
+        _rowReloads[id] = index;
+        deliver(_pageLoader(context(), index, 1),
+                [this, id, index](Result<std::vector<Row>> rows) { rowReloaded(id, index, std::move(rows)); });
+        notifyLoading();
+    }
+
+    void rowReloaded(int id, size_t index, Result<std::vector<Row>> rows) {
+        auto pending = _rowReloads.find(id);
+        if (pending == _rowReloads.end() || pending->second != index) return;
+        _rowReloads.erase(pending);
+        bool replaced = rows && rows.value().size() == 1 && rows.value().front().id == id &&
+                        _cache.replaceRow(index, std::move(rows.value().front()));
+        if (!replaced) {
+            // Hàng đã dời chỗ hoặc lỗi: nạp lại cả trang khi nó được vẽ
+            _cache.dropPage(index / _cache.pageSize());
+        }
+        if (_listener.rowsReady) _listener.rowsReady(index, index);
+        notifyLoading();
+    }
+
+    /// Bỏ kết quả đang về (có thể đã cũ) và nạp lại các trang và hàng đó
+    void restartLoads() {
+        if (_inFlight.empty() && _rowReloads.empty()) return;
+        _cancellation.cancel();
+        _cancellation = CancellationSource();
+        for (size_t pageIndex : _inFlight) _waiting.push_front(pageIndex);
+        _inFlight.clear();
+        auto reloads = std::move(_rowReloads);
+        _rowReloads.clear();
+        for (const auto& [id, index] : reloads) {
+            if (auto current = _cache.indexOf(id)) reloadRow(id, *current);
+        }
+        startLoads();
+    }
+
+    /// Thêm hoặc xóa chỉ áp dụng được lên số hàng đã có; lượt đếm đang chạy có thể đã bỏ lỡ nó
+    bool acceptsStructuralChange() {
+        if (_countPending) {
+            refresh();
+            return false;
+        }
+        return _counted && !_error;
+    }
+
+public:
+    /**
+     * @param countLoader Đếm tổng số hàng (thường chạy trên AsyncServices)
+     * @param pageLoader Nạp limit hàng từ offset
+     * @param dispatch Chuyển kết quả về luồng giao diện
+     * @param pageSize Số hàng mỗi trang
+     * @param maxPages Số trang tối đa giữ trong bộ đệm
+     * @param maxInFlight Số trang tối đa được nạp cùng lúc
+     * @param timeout Deadline của mỗi lời gọi
+     */
+    AsyncRowSource(CountLoader countLoader, PageLoader pageLoader, Dispatcher dispatch,
+                   size_t pageSize = 200, size_t maxPages = 8, size_t maxInFlight = 2,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds(30000))
+        : _countLoader(std::move(countLoader)), _pageLoader(std::move(pageLoader)), _dispatch(std::move(dispatch)),
+          _cache(nullptr, pageSize, maxPages), _maxInFlight(std::max<size_t>(maxInFlight, 1)), _timeout(timeout) {}
+
+    ~AsyncRowSource() { _cancellation.cancel(); }
+
+    AsyncRowSource(const AsyncRowSource&) = delete;
+    AsyncRowSource& operator=(const AsyncRowSource&) = delete;
+
+    void setListener(Listener listener) { _listener = std::move(listener); }
+
+    /**
+     * @brief Hủy lượt trước rồi đếm lại trên worker; danh sách cũ giữ nguyên đến khi có số hàng
+     */
+    void refresh() {
+        abort();
+        _stopped = false;
+        _counted = false;
+        _error.reset();
+        _countPending = true;
+        deliver(_countLoader(context()), [this](Result<size_t> count) {
+            _countPending = false;
+            if (!count) {
+                fail(count.error());
+                notifyLoading();
+                return;
+            }
+            _cache.reset(count.value());
+            _counted = true;
+            if (_listener.countReady) _listener.countReady(count.value());
+            notifyLoading();
+        });
+        notifyLoading();
+    }
+
+    /**
+     * @brief Hủy lượt đếm và mọi trang đang nạp hoặc đang chờ, không nạp thêm đến refresh();
+     *        các trang đã có được giữ lại
+     */
+    void cancel() {
+        abort();
+        _stopped = true;
+    }
+
+    /**
+     * @brief Hàng thứ index nếu đã có; nếu chưa thì xếp trang chứa nó vào hàng chờ và trả nullptr
+     */
+    const Row* row(size_t index) {
+        if (index >= _cache.size()) return nullptr;
+        const Row* cached = _cache.cached(index);
+        if (!cached) {
+            enqueue(index / _cache.pageSize());
+            startLoads();
+        }
+        return cached;
+    }
+
+    /**
+     * @brief Xếp các trang phủ [first, last] vào hàng chờ (gợi ý từ wxEVT_LIST_CACHE_HINT)
+     */
+    void prefetch(size_t first, size_t last) {
+        if (_cache.size() == 0 || first >= _cache.size()) return;
+        last = std::min(last, _cache.size() - 1);
+        size_t firstPage = first / _cache.pageSize();
+        size_t lastPage = std::min(last / _cache.pageSize(), firstPage + _cache.maxPages() - 1);
+        // Xếp ngược để trang đầu vùng hiển thị đứng đầu hàng chờ
+        for (size_t index = lastPage + 1; index-- > firstPage;) enqueue(index);
+        startLoads();
+    }
+
+    /**
+     * @brief Hàng có id vừa được sửa: nạp lại riêng hàng đó nếu nó đang trong bộ đệm
+     */
+    void rowUpdated(int id) {
+        if (!_counted || _error) return;
+        if (auto index = _cache.indexOf(id)) {
+            reloadRow(id, *index);
+        } else {
+            // Hàng có thể nằm trong một trang đang nạp dở với dữ liệu cũ
+            restartLoads();
+        }
+    }
+
+    /**
+     * @brief Hàng có id vừa được thêm: tăng số hàng, chỉ bỏ trang cuối nếu đang giữ
+     */
+    void rowCreated(int id) {
+        if (!acceptsStructuralChange()) return;
+        size_t first = _cache.insertById(id);
+        restartLoads();
+        if (_listener.countChanged) _listener.countChanged(_cache.size(), first);
+    }
+
+    /**
+     * @brief Hàng có id vừa bị xóa: giảm số hàng, bỏ các trang từ vị trí của nó trở đi
+     */
+    void rowDeleted(int id) {
+        if (!acceptsStructuralChange()) return;
+        _rowReloads.erase(id);
+        size_t first = _cache.removeById(id);
+        restartLoads();
+        if (_listener.countChanged) _listener.countChanged(_cache.size(), first);
+        notifyLoading();
+    }
+
+    /**
+     * @brief Áp dụng một thay đổi từ Changes::Feed (đã được chuyển về luồng của Dispatcher)
+     */
+    void apply(Changes::Kind kind, int id) {
+        switch (kind) {
+            case Changes::Kind::CREATED: rowCreated(id); break;
+            case Changes::Kind::UPDATED: rowUpdated(id); break;
+            case Changes::Kind::DELETED: rowDeleted(id); break;
+        }
+    }
+
+    size_t size() const { return _cache.size(); }
+    bool loading() const { return _countPending || !_inFlight.empty() || !_rowReloads.empty(); }
+    bool stopped() const { return _stopped; }
+    size_t pagesInFlight() const { return _inFlight.size(); }
+    size_t cachedPages() const { return _cache.cachedPages(); }
+    const std::optional<CoreError>& lastError() const { return _error; }
+};
+
+} // namespace Async
+
+#endif // ASYNC_ASYNC_ROW_SOURCE_H
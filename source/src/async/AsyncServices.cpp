@@ -0,0 +1,92 @@
+#include "AsyncServices.h"
+#include "../services/RequestContext.h"
+
+namespace Async {
+
+AsyncServices::AsyncServices(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Logger> logger, size_t threads,
+                             std::chrono::milliseconds leaseTimeout)
+    : _pool(std::move(pool)),
+      _logger(std::move(logger)),
+      _leaseTimeout(leaseTimeout),
+      _executor(std::make_unique<Executor>(threads)) {}
+
+AsyncServices::~AsyncServices() {
+    // Dừng executor trước khi các thành viên khác bị hủy
+    _executor.reset();
+}
+
+Future<std::vector<FlightSummaryRow>> AsyncServices::getFlightSummaries(const CallContext& context) {
+    return run(context, [](const ApplicationContext& services) -> Result<std::vector<FlightSummaryRow>> {
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = services.flightService()->getFlightSummaries(rows);
+        if (!loaded) return Failure<std::vector<FlightSummaryRow>>(loaded.error());
+        return Success(std::move(rows));
+    });
+}
+
+Future<std::vector<FlightSummaryRow>> AsyncServices::getFlightSummariesWithOccupancy(const CallContext& context) {
+    return run(context, [](const ApplicationContext& services) -> Result<std::vector<FlightSummaryRow>> {
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = services.flightService()->getFlightSummariesWithOccupancy(rows);
+        if (!loaded) return Failure<std::vector<FlightSummaryRow>>(loaded.error());
+        return Success(std::move(rows));
+    });
+}
+
+Future<std::vector<TicketListRow>> AsyncServices::getTicketListRows(const CallContext& context) {
+    return run(context, [](const ApplicationContext& services) -> Result<std::vector<TicketListRow>> {
+        std::vector<TicketListRow> rows;
+        auto loaded = services.ticketService()->getTicketListRows(rows);
+        if (!loaded) return Failure<std::vector<TicketListRow>>(loaded.error());
+        return Success(std::move(rows));
+    });
+}
+
+Future<std::vector<PassengerListRow>> AsyncServices::getPassengerListRows(const CallContext& context) {
+    return run(context, [](const ApplicationContext& services) -> Result<std::vector<PassengerListRow>> {
+        std::vector<PassengerListRow> rows;
+        auto loaded = services.passengerService()->getPassengerListRows(rows);
+        if (!loaded) return Failure<std::vector<PassengerListRow>>(loaded.error());
+        return Success(std::move(rows));
+    });
+}
+
+Future<Flight> AsyncServices::getFlight(const CallContext& context, const FlightNumber& flightNumber) {
+    return run(context, [flightNumber](const ApplicationContext& services) {
+        return services.flightService()->getFlight(flightNumber);
+    });
+}
+
+Future<Passenger> AsyncServices::getPassenger(const CallContext& context, const PassportNumber& passport) {
+    return run(context, [passport](const ApplicationContext& services) {
+        return services.passengerService()->getPassenger(passport);
+    });
+}
+
+Future<std::vector<Ticket>> AsyncServices::searchTicketsByPassenger(const CallContext& context, const PassportNumber& passport) {
+    return run(context, [passport](const ApplicationContext& services) {
+        return services.ticketService()->searchByPassenger(passport);
+    });
+}
+
+Future<Ticket> AsyncServices::bookTicket(const CallContext& context, const PassportNumber& passport,
+                                         const FlightNumber& flightNumber, const std::string& seatClass, const Price& price) {
+    auto lookups = whenAll(getPassenger(context, passport), getFlight(context, flightNumber));
+    return lookups.then(*_executor, context, [this, context, passport, flightNumber, seatClass, price](std::pair<Passenger, Flight> found) {
+        auto book = [&](const ApplicationContext& services) {
+            RequestContext request(services.passengerRepository(), services.flightRepository(), services.ticketRepository());
+            request.preload(found.first);
+            request.preload(found.second);
+            return services.ticketService()->bookTicket(request, passport, flightNumber, seatClass, price);
+        };
+        return invoke(context, book);
+    });
+}
+
+Future<bool> AsyncServices::cancelTicket(const CallContext& context, const TicketNumber& ticketNumber, const std::string& reason) {
+    return run(context, [ticketNumber, reason](const ApplicationContext& services) {
+        return services.ticketService()->cancelTicket(ticketNumber, reason);
+    });
+}
+
+} // namespace Async
@@ -0,0 +1,136 @@
+/**
+ * @file AsyncServices.h
+ * @brief Facade bất đồng bộ trên bốn service, chạy trên Executor và ConnectionPool
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mọi lời gọi service vốn chạy đồng bộ trên luồng gọi; trong giao diện đó là luồng sự kiện
+ * wxWidgets nên cửa sổ bị đơ trong lúc làm mới danh sách. AsyncServices đẩy lời gọi sang
+ * Executor và trả về Future<T>.
+ *
+ * Mỗi tác vụ mượn một kết nối trong ConnectionPool trong suốt thời gian chạy và dựng
+ * ApplicationContext trên kết nối đó (giống airlines_server), nên transaction của hai tác vụ
+ * không bao giờ đan xen trên cùng một session. Thời gian chờ mượn kết nối bị giới hạn bởi
+ * deadline của CallContext; hết hạn trong lúc chờ trả về DEADLINE_EXCEEDED.
+ *
+ * Hàm tiện ích nào chưa có thì dùng run() với lambda nhận const ApplicationContext&.
+ */
+
+#ifndef ASYNC_ASYNC_SERVICES_H
+#define ASYNC_ASYNC_SERVICES_H
+
+#include "CallContext.h"
+#include "Executor.h"
+#include "Future.h"
+#include "../app/ApplicationContext.h"
+#include "../database/ConnectionPool.h"
+#include "../repositories/ReadModels.h"
+#include "../utils/Logger.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Async {
+
+class AsyncServices {
+private:
+    std::shared_ptr<ConnectionPool> _pool;
+    std::shared_ptr<Logger> _logger;
+    std::chrono::milliseconds _leaseTimeout;
+    std::unique_ptr<Executor> _executor;     ///< Khai báo cuối để bị hủy trước: tác vụ còn lại chạy xong khi pool vẫn sống
+
+    /// Mượn kết nối (chờ tối đa phần deadline còn lại) rồi chạy fn trên ApplicationContext của kết nối đó
+    template <typename F>
+    auto invoke(const CallContext& context, F& fn) -> std::invoke_result_t<F&, const ApplicationContext&> {
+        using T = typename std::invoke_result_t<F&, const ApplicationContext&>::value_type;
+        auto wait = context.remaining(_leaseTimeout);
+        auto lease = _pool->acquire(wait);
+        if (auto checked = context.check(); !checked) return Failure<T>(checked.error());
+        if (!lease) {
+            // Hết thời gian chờ do deadline của lời gọi chứ không phải do pool cạn lâu bất thường
+            if (lease.error().code == "POOL_TIMEOUT" && wait < _leaseTimeout) {
+                return Failure<T>(CoreError("Deadline exceeded while waiting for a database connection", "DEADLINE_EXCEEDED"));
+            }
+            return Failure<T>(lease.error());
+        }
+        ApplicationContext services(lease.value().connection(), _logger);
+        return fn(services);
+    }
+
+public:
+    /**
+     * @param pool Nguồn kết nối; kích thước pool là số lời gọi chạm cơ sở dữ liệu cùng lúc
+     * @param logger Logger truyền cho service; nullptr để tắt log
+     * @param threads Số worker của Executor; 0 nghĩa là theo số lõi
+     * @param leaseTimeout Thời gian chờ kết nối tối đa khi CallContext không có deadline
+     */
+    AsyncServices(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Logger> logger, size_t threads = 0,
+                  std::chrono::milliseconds leaseTimeout = std::chrono::milliseconds(5000));
+    ~AsyncServices();
+
+    AsyncServices(const AsyncServices&) = delete;
+    AsyncServices& operator=(const AsyncServices&) = delete;
+
+    Executor& executor() { return *_executor; }
+
+    /**
+     * @brief Chạy fn(const ApplicationContext&) -> Result<T> trên một kết nối mượn từ pool
+     * @note AsyncServices phải sống lâu hơn mọi Future nó trả về
+     */
+    template <typename F>
+    auto run(CallContext context, F fn) -> Future<typename std::invoke_result_t<F&, const ApplicationContext&>::value_type> {
+        return spawn(*_executor, context, [this, context, fn]() mutable { return invoke(context, fn); });
+    }
+
+    // === Danh sách cho giao diện ===
+    Future<std::vector<FlightSummaryRow>> getFlightSummaries(const CallContext& context);
+    /// Tóm tắt chuyến bay kèm số ghế đã đặt theo hạng (truy vấn gộp trên bảng vé)
+    Future<std::vector<FlightSummaryRow>> getFlightSummariesWithOccupancy(const CallContext& context);
+    Future<std::vector<TicketListRow>> getTicketListRows(const CallContext& context);
+    Future<std::vector<PassengerListRow>> getPassengerListRows(const CallContext& context);
+
+    // === Tra cứu ===
+    Future<Flight> getFlight(const CallContext& context, const FlightNumber& flightNumber);
+    Future<Passenger> getPassenger(const CallContext& context, const PassportNumber& passport);
+    Future<std::vector<Ticket>> searchTicketsByPassenger(const CallContext& context, const PassportNumber& passport);
+
+    // === Thao tác ghi ===
+
+    /**
+     * @brief Đặt vé: đọc hành khách và chuyến bay song song, rồi đặt vé với hai kết quả đó đã
+     *        được nạp sẵn vào RequestContext nên bước ghi không đọc lại
+     * @return Lỗi đầu tiên trong hai tra cứu, hoặc kết quả của TicketService::bookTicket
+     */
+    Future<Ticket> bookTicket(const CallContext& context, const PassportNumber& passport,
+                              const FlightNumber& flightNumber, const std::string& seatClass, const Price& price);
+
+    Future<bool> cancelTicket(const CallContext& context, const TicketNumber& ticketNumber, const std::string& reason);
+};
+
+/**
+ * @brief Gọi fn(S&) -> Result<T> trên một service: qua AsyncServices nếu có, nếu không thì chạy
+ *        ngay trên service đồng bộ và trả về Future đã có kết quả
+ *
+ * Giao diện dùng hàm này để cùng một đoạn mã chạy được cả khi pool kết nối phụ không mở được.
+ *
+ * @param async Facade bất đồng bộ, có thể null
+ * @param local Service đồng bộ dùng khi async là null
+ * @param select Accessor của ApplicationContext trả về service cùng loại trên kết nối mượn
+ */
+template <typename S, typename F>
+auto callService(AsyncServices* async, const std::shared_ptr<S>& local,
+                 const std::shared_ptr<S>& (ApplicationContext::*select)() const,
+                 const CallContext& context, F fn) -> Future<typename std::invoke_result_t<F&, S&>::value_type> {
+    using T = typename std::invoke_result_t<F&, S&>::value_type;
+    if (async) {
+        return async->run(context, [select, fn](const ApplicationContext& services) mutable { return fn(*(services.*select)()); });
+    }
+    if (auto checked = context.check(); !checked) return makeReadyFuture(Result<T>(Failure<T>(checked.error())));
+    return makeReadyFuture(fn(*local));
+}
+
+} // namespace Async
+
+#endif // ASYNC_ASYNC_SERVICES_H
@@ -0,0 +1,100 @@
+/**
+ * @file CallContext.h
+ * @brief Hủy thao tác và hạn chót (deadline) truyền dọc theo một chuỗi lời gọi bất đồng bộ
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Một lời gọi từ giao diện có thể tách thành nhiều tác vụ con (ví dụ đặt vé đọc hành khách và
+ * chuyến bay song song rồi mới ghi vé). CallContext đi cùng mọi tác vụ con: cùng một
+ * CancellationToken và một deadline tuyệt đối. Tác vụ con chỉ có thể rút ngắn deadline
+ * (withTimeout) chứ không kéo dài được deadline của lời gọi cha.
+ *
+ * Việc hủy mang tính hợp tác: tác vụ kiểm tra check() trước khi bắt đầu và giữa các bước,
+ * truy vấn đang chạy dưới cơ sở dữ liệu không bị ngắt giữa chừng.
+ */
+
+#ifndef ASYNC_CALL_CONTEXT_H
+#define ASYNC_CALL_CONTEXT_H
+
+#include "../core/exceptions/Result.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace Async {
+
+class CancellationToken {
+private:
+    std::shared_ptr<const std::atomic<bool>> _flag;
+
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> flag) : _flag(std::move(flag)) {}
+
+    /// Token mặc định không bao giờ bị hủy
+    bool isCancelled() const { return _flag && _flag->load(std::memory_order_acquire); }
+};
+
+class CancellationSource {
+private:
+    std::shared_ptr<std::atomic<bool>> _flag = std::make_shared<std::atomic<bool>>(false);
+
+public:
+    void cancel() { _flag->store(true, std::memory_order_release); }
+    bool isCancelled() const { return _flag->load(std::memory_order_acquire); }
+    CancellationToken token() const { return CancellationToken(_flag); }
+};
+
+struct CallContext {
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken cancellation;
+    Clock::time_point deadline = Clock::time_point::max();    ///< max() nghĩa là không giới hạn
+
+    static CallContext create(std::chrono::milliseconds timeout, CancellationToken token = {}) {
+        CallContext context;
+        context.cancellation = std::move(token);
+        context.deadline = deadlineAfter(timeout);
+        return context;
+    }
+
+    /// now + timeout, bão hòa ở time_point::max() (không giới hạn) thay vì tràn số
+    static Clock::time_point deadlineAfter(std::chrono::milliseconds timeout) {
+        auto now = Clock::now();
+        auto room = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::time_point::max() - now);
+        if (timeout >= room) return Clock::time_point::max();
+        return now + timeout;
+    }
+
+    /// Ngữ cảnh con dùng chung token, deadline là giá trị sớm hơn giữa cha và now + timeout
+    CallContext withTimeout(std::chrono::milliseconds timeout) const {
+        CallContext child = *this;
+        child.deadline = std::min(deadline, deadlineAfter(timeout));
+        return child;
+    }
+
+    bool hasDeadline() const { return deadline != Clock::time_point::max(); }
+    bool expired() const { return hasDeadline() && Clock::now() >= deadline; }
+
+    /// Thời gian còn lại, không âm; fallback khi không có deadline
+    std::chrono::milliseconds remaining(std::chrono::milliseconds fallback) const {
+        if (!hasDeadline()) return fallback;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+        return std::clamp(left, std::chrono::milliseconds(0), fallback);
+    }
+
+    /**
+     * @return Lỗi CANCELLED nếu đã bị hủy, DEADLINE_EXCEEDED nếu đã quá hạn
+     */
+    VoidResult check() const {
+        if (cancellation.isCancelled()) return Failure(CoreError("Operation cancelled", "CANCELLED"));
+        if (expired()) return Failure(CoreError("Deadline exceeded", "DEADLINE_EXCEEDED"));
+        return Success();
+    }
+};
+
+} // namespace Async
+
+#endif // ASYNC_CALL_CONTEXT_H
@@ -0,0 +1,144 @@
+#include "Executor.h"
+#include "../utils/Logger.h"
+#include "../utils/Metrics.h"
+#include "../utils/Tracing.h"
+#include <algorithm>
+#include <exception>
+
+namespace Async {
+
+namespace {
+    thread_local Executor* currentExecutor = nullptr;
+    thread_local size_t currentIndex = 0;
+
+    Metrics::Counter& tasksCounter() {
+        static Metrics::Counter& counter = Metrics::MetricsRegistry::getInstance()->counter(
+            "airlines_executor_tasks_total", "Tasks executed by the async service executor");
+        return counter;
+    }
+
+    Metrics::Counter& stealsCounter() {
+        static Metrics::Counter& counter = Metrics::MetricsRegistry::getInstance()->counter(
+            "airlines_executor_steals_total", "Tasks taken from another worker's queue");
+        return counter;
+    }
+
+    Metrics::Gauge& queuedGauge() {
+        static Metrics::Gauge& gauge = Metrics::MetricsRegistry::getInstance()->gauge(
+            "airlines_executor_queued_tasks", "Tasks waiting in executor queues");
+        return gauge;
+    }
+
+    void runTask(Executor::Task& task) {
+        tasksCounter().inc();
+        try {
+            task();
+        } catch (const std::exception& e) {
+            // Tác vụ dựng bởi spawn() tự đổi ngoại lệ thành lỗi; đây chỉ giữ cho worker sống
+            Logger::getInstance()->error(std::string("Unhandled exception in async task: ") + e.what());
+        } catch (...) {
+            Logger::getInstance()->error("Unhandled exception in async task");
+        }
+    }
+}
+
+Executor::Executor(size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    _queues.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) _queues.push_back(std::make_unique<WorkQueue>());
+    _threads.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) _threads.emplace_back([this, i] { workerLoop(i); });
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto& thread : _threads) thread.join();
+}
+
+Executor* Executor::current() {
+    return currentExecutor;
+}
+
+void Executor::submit(Task task) {
+    // Span đang mở của luồng gửi là cha của các span mà tác vụ mở trên worker
+    if (uint64_t parent = Tracing::currentSpan()) {
+        task = [parent, inner = std::move(task)] {
+            Tracing::ParentScope scope(parent);
+            inner();
+        };
+    }
+    size_t index = currentExecutor == this
+        ? currentIndex
+        : _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    // Đếm trước khi đẩy: worker khác có thể lấy trộm tác vụ ngay khi nó vào hàng đợi, và phép trừ
+    // của nó không được chạy trước phép cộng này
+    queuedGauge().inc();
+    {
+        // Tăng dưới _sleepMutex để worker đang kiểm tra điều kiện ngủ không bỏ lỡ tác vụ
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _queued.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+    _wakeUp.notify_one();
+}
+
+std::optional<Executor::Task> Executor::take(size_t index) {
+    if (_queued.load(std::memory_order_acquire) == 0) return std::nullopt;
+
+    {
+        auto& own = *_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            Task task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            _queued.fetch_sub(1, std::memory_order_acq_rel);
+            queuedGauge().dec();
+            return task;
+        }
+    }
+
+    for (size_t offset = 1; offset < _queues.size(); ++offset) {
+        auto& victim = *_queues[(index + offset) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            Task task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            _queued.fetch_sub(1, std::memory_order_acq_rel);
+            queuedGauge().dec();
+            stealsCounter().inc();
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+bool Executor::runPendingTask() {
+    size_t index = currentExecutor == this ? currentIndex : 0;
+    auto task = take(index);
+    if (!task) return false;
+    runTask(*task);
+    return true;
+}
+
+void Executor::workerLoop(size_t index) {
+    currentExecutor = this;
+    currentIndex = index;
+    while (true) {
+        if (auto task = take(index)) {
+            runTask(*task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wakeUp.wait(lock, [this] { return _queued.load(std::memory_order_acquire) > 0 || _stopping; });
+        if (_stopping && _queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+} // namespace Async
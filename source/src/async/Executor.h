@@ -0,0 +1,79 @@
+/**
+ * @file Executor.h
+ * @brief Thread pool kiểu work-stealing cho các tác vụ bất đồng bộ của service
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi worker có một hàng đợi riêng. Tác vụ được gửi từ chính một worker (continuation, tác vụ
+ * con) vào hàng đợi của worker đó và được lấy theo thứ tự LIFO để tận dụng cache; tác vụ gửi từ
+ * luồng ngoài (luồng giao diện) được rải vòng tròn qua các hàng đợi. Worker rảnh lấy trộm từ đầu
+ * hàng đợi của worker khác, nên một lượt làm mới danh sách dài không chặn các tra cứu nhỏ.
+ *
+ * Hủy Executor sẽ chạy nốt các tác vụ đã xếp hàng rồi mới dừng các luồng.
+ */
+
+#ifndef ASYNC_EXECUTOR_H
+#define ASYNC_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Async {
+
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::atomic<size_t> _queued{0};
+    std::atomic<size_t> _nextQueue{0};
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    bool _stopping = false;
+
+    std::optional<Task> take(size_t index);
+    void workerLoop(size_t index);
+
+public:
+    /**
+     * @param threads Số worker; 0 nghĩa là theo std::thread::hardware_concurrency()
+     */
+    explicit Executor(size_t threads = 0);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void submit(Task task);
+
+    /**
+     * @brief Chạy một tác vụ đang chờ trên luồng gọi, dùng khi worker phải chờ một Future
+     * @return false nếu không còn tác vụ nào để chạy
+     */
+    bool runPendingTask();
+
+    size_t threadCount() const { return _threads.size(); }
+
+    /// Executor sở hữu luồng hiện tại, nullptr nếu luồng không phải worker
+    static Executor* current();
+};
+
+} // namespace Async
+
+#endif // ASYNC_EXECUTOR_H
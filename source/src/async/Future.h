@@ -0,0 +1,254 @@
+/**
+ * @file Future.h
+ * @brief Future/Promise mang Result<T>, có continuation, dùng cho facade service bất đồng bộ
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * std::future không có continuation nên mọi bước kế tiếp phải chặn một luồng để chờ. Future ở đây
+ * mang thẳng Result<T> của service (lỗi nghiệp vụ, CANCELLED, DEADLINE_EXCEEDED đều là CoreError)
+ * và cho phép gắn một continuation chạy ngay khi có kết quả:
+ *
+ * - spawn(executor, context, fn): chạy fn() -> Result<T> trên executor
+ * - future.then(executor, context, fn): chạy fn(T) -> Result<U> khi future thành công
+ * - whenAll(a, b): chờ hai tra cứu độc lập, lỗi đầu tiên kết thúc ngay
+ *
+ * Mỗi Future chỉ có một người nhận: get() hoặc onReady() lấy kết quả ra và Future trở thành
+ * không hợp lệ, giống std::future.
+ */
+
+#ifndef ASYNC_FUTURE_H
+#define ASYNC_FUTURE_H
+
+#include "CallContext.h"
+#include "Executor.h"
+#include "../core/exceptions/Result.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Async {
+
+namespace detail {
+    template <typename T>
+    struct SharedState {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::optional<Result<T>> result;
+        std::function<void(Result<T>)> continuation;
+        bool completed = false;
+    };
+}
+
+template <typename T>
+class Future;
+
+template <typename T>
+class Promise {
+private:
+    std::shared_ptr<detail::SharedState<T>> _state = std::make_shared<detail::SharedState<T>>();
+
+public:
+    Future<T> future() const { return Future<T>(_state); }
+
+    /// Chỉ lần đặt đầu tiên có hiệu lực; các lần sau (ví dụ lỗi đến muộn trong whenAll) bị bỏ qua
+    void set(Result<T> result) const {
+        std::function<void(Result<T>)> continuation;
+        {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+            if (_state->completed) return;
+            _state->completed = true;
+            if (_state->continuation) {
+                continuation = std::move(_state->continuation);
+            } else {
+                _state->result = std::move(result);
+            }
+        }
+        if (continuation) {
+            continuation(std::move(result));
+        } else {
+            _state->ready.notify_all();
+        }
+    }
+};
+
+template <typename T>
+class Future {
+private:
+    std::shared_ptr<detail::SharedState<T>> _state;
+
+public:
+    using ValueType = T;
+
+    Future() = default;
+    explicit Future(std::shared_ptr<detail::SharedState<T>> state) : _state(std::move(state)) {}
+
+    bool valid() const { return _state != nullptr; }
+
+    bool isReady() const {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return _state->result.has_value();
+    }
+
+    /// @return true nếu kết quả có trong khoảng timeout
+    bool waitFor(std::chrono::milliseconds timeout) const {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        return _state->ready.wait_for(lock, timeout, [this] { return _state->result.has_value(); });
+    }
+
+    /**
+     * @brief Chờ và lấy kết quả; Future không còn hợp lệ sau lời gọi
+     *
+     * Nếu luồng gọi là worker của một Executor, nó chạy các tác vụ đang chờ trong lúc đợi để
+     * tác vụ cha chờ tác vụ con không làm cạn worker.
+     */
+    Result<T> get() {
+        auto state = std::move(_state);
+        Executor* executor = Executor::current();
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (!state->result) {
+            if (executor) {
+                lock.unlock();
+                bool ran = executor->runPendingTask();
+                lock.lock();
+                if (!ran && !state->result) state->ready.wait_for(lock, std::chrono::milliseconds(1));
+            } else {
+                state->ready.wait(lock);
+            }
+        }
+        return std::move(*state->result);
+    }
+
+    /**
+     * @brief Gắn hàm nhận kết quả; Future không còn hợp lệ sau lời gọi
+     *
+     * Chạy ngay trên luồng gọi nếu đã có kết quả, nếu không thì trên luồng hoàn tất Promise
+     * (thường là một worker). Giao diện phải tự chuyển về luồng UI trước khi chạm widget.
+     */
+    void onReady(std::function<void(Result<T>)> callback) {
+        auto state = std::move(_state);
+        std::unique_lock<std::mutex> lock(state->mutex);
+        if (state->result) {
+            Result<T> result = std::move(*state->result);
+            lock.unlock();
+            callback(std::move(result));
+        } else {
+            state->continuation = std::move(callback);
+        }
+    }
+
+    /**
+     * @brief Chạy fn(T) -> Result<U> trên executor khi Future thành công; lỗi được chuyển thẳng
+     */
+    template <typename F>
+    auto then(Executor& executor, CallContext context, F fn) -> Future<typename std::invoke_result_t<F, T>::value_type>;
+};
+
+template <typename T>
+Future<T> makeReadyFuture(Result<T> result) {
+    Promise<T> promise;
+    promise.set(std::move(result));
+    return promise.future();
+}
+
+namespace detail {
+    /// Chạy một bước trên worker: kiểm tra hủy/deadline rồi đổi ngoại lệ thành TASK_FAILED
+    template <typename T, typename F>
+    void runStep(const Promise<T>& promise, const CallContext& context, F& fn) {
+        if (auto checked = context.check(); !checked) {
+            promise.set(Failure<T>(checked.error()));
+            return;
+        }
+        try {
+            promise.set(fn());
+        } catch (const std::exception& e) {
+            promise.set(Failure<T>(CoreError(e.what(), "TASK_FAILED")));
+        }
+    }
+}
+
+/**
+ * @brief Chạy fn() -> Result<T> trên executor
+ * @return Future lỗi CANCELLED/DEADLINE_EXCEEDED nếu context đã hết hiệu lực khi tác vụ bắt đầu
+ */
+template <typename F>
+auto spawn(Executor& executor, CallContext context, F fn) -> Future<typename std::invoke_result_t<F>::value_type> {
+    using T = typename std::invoke_result_t<F>::value_type;
+    Promise<T> promise;
+    auto future = promise.future();
+    executor.submit([promise, context = std::move(context), fn = std::move(fn)]() mutable {
+        detail::runStep(promise, context, fn);
+    });
+    return future;
+}
+
+template <typename T>
+template <typename F>
+auto Future<T>::then(Executor& executor, CallContext context, F fn) -> Future<typename std::invoke_result_t<F, T>::value_type> {
+    using U = typename std::invoke_result_t<F, T>::value_type;
+    Promise<U> promise;
+    auto future = promise.future();
+    onReady([&executor, promise, context = std::move(context), fn = std::move(fn)](Result<T> result) mutable {
+        if (!result) {
+            promise.set(Failure<U>(result.error()));
+            return;
+        }
+        executor.submit([promise, context, fn, value = std::move(result.value())]() mutable {
+            auto step = [&] { return fn(std::move(value)); };
+            detail::runStep(promise, context, step);
+        });
+    });
+    return future;
+}
+
+/**
+ * @brief Kết hợp hai Future độc lập; lỗi của Future nào đến trước thì kết thúc ngay với lỗi đó
+ */
+template <typename A, typename B>
+Future<std::pair<A, B>> whenAll(Future<A> first, Future<B> second) {
+    struct Join {
+        std::mutex mutex;
+        std::optional<A> first;
+        std::optional<B> second;
+        Promise<std::pair<A, B>> promise;
+
+        void completeIfBoth(std::unique_lock<std::mutex>& lock) {
+            if (!first || !second) return;
+            std::pair<A, B> values(std::move(*first), std::move(*second));
+            lock.unlock();
+            promise.set(Success(std::move(values)));
+        }
+    };
+
+    auto join = std::make_shared<Join>();
+    auto future = join->promise.future();
+    first.onReady([join](Result<A> result) {
+        if (!result) {
+            join->promise.set(Failure<std::pair<A, B>>(result.error()));
+            return;
+        }
+        std::unique_lock<std::mutex> lock(join->mutex);
+        join->first = std::move(result.value());
+        join->completeIfBoth(lock);
+    });
+    second.onReady([join](Result<B> result) {
+        if (!result) {
+            join->promise.set(Failure<std::pair<A, B>>(result.error()));
+            return;
+        }
+        std::unique_lock<std::mutex> lock(join->mutex);
+        join->second = std::move(result.value());
+        join->completeIfBoth(lock);
+    });
+    return future;
+}
+
+} // namespace Async
+
+#endif // ASYNC_FUTURE_H
@@ -0,0 +1,363 @@
+#include "BatchJobs.h"
+#include "BulkImport.h"
+#include "../core/value_objects/route/RouteFormatter.h"
+#include "../core/value_objects/schedule/ScheduleFormatter.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <unordered_map>
+
+namespace Cli {
+
+namespace {
+    std::time_t toTime(std::tm value) {
+        value.tm_isdst = -1;
+        return std::mktime(&value);
+    }
+
+    void writeRow(std::ostream& out, std::initializer_list<std::string> fields) {
+        bool first = true;
+        for (const auto& field : fields) {
+            if (!first) out << ',';
+            out << csvField(field);
+            first = false;
+        }
+        out << '\n';
+    }
+
+    std::string formatAmount(double amount) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", amount);
+        return buffer;
+    }
+
+    /**
+     * @brief Dòng CSV đã tách, tra cột theo tên tiêu đề
+     */
+    class CsvRecord {
+    private:
+        const std::map<std::string, size_t>& _header;
+        const std::vector<std::string>& _fields;
+
+    public:
+        CsvRecord(const std::map<std::string, size_t>& header, const std::vector<std::string>& fields)
+            : _header(header), _fields(fields) {}
+
+        std::string operator[](const std::string& column) const {
+            auto it = _header.find(column);
+            if (it == _header.end() || it->second >= _fields.size()) return "";
+            return _fields[it->second];
+        }
+    };
+
+    using RowImporter = std::function<Result<bool>(const CsvRecord&)>;
+
+    Result<ImportReport> importRows(std::istream& in, const std::vector<std::string>& requiredColumns, const RowImporter& importRow) {
+        std::string line;
+        if (!std::getline(in, line)) {
+            return Failure<ImportReport>(CoreError("CSV input is empty", "INVALID_CSV_HEADER"));
+        }
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        auto headerFields = parseCsvLine(line);
+        if (!headerFields) {
+            return Failure<ImportReport>(CoreError(headerFields.error().message, "INVALID_CSV_HEADER"));
+        }
+        std::map<std::string, size_t> header;
+        for (size_t i = 0; i < headerFields.value().size(); ++i) header[headerFields.value()[i]] = i;
+        for (const auto& column : requiredColumns) {
+            if (!header.count(column)) {
+                return Failure<ImportReport>(CoreError("Missing CSV column: " + column, "INVALID_CSV_HEADER"));
+            }
+        }
+
+        ImportReport report;
+        size_t lineNumber = 1;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            auto fields = parseCsvLine(line);
+            if (!fields) {
+                report.errors.push_back({lineNumber, fields.error().code, fields.error().message});
+                continue;
+            }
+            auto result = importRow(CsvRecord(header, fields.value()));
+            if (result) {
+                ++report.imported;
+            } else {
+                report.errors.push_back({lineNumber, result.error().code, result.error().message});
+            }
+        }
+        return Success(std::move(report));
+    }
+
+    Result<size_t> exportAircraft(const ApplicationContext& context, std::ostream& out) {
+        auto aircraft = context.aircraftService()->getAllAircraft();
+        if (!aircraft) return Failure<size_t>(aircraft.error());
+
+        writeRow(out, {"serial", "model", "seat_layout"});
+        for (const auto& item : aircraft.value()) {
+            writeRow(out, {item.getSerial().toString(), item.getModel(), item.getSeatLayout().toString()});
+        }
+        return Success(aircraft.value().size());
+    }
+
+    Result<size_t> exportFlights(const ApplicationContext& context, std::ostream& out) {
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = context.flightService()->getFlightSummaries(rows);
+        if (!loaded) return Failure<size_t>(loaded.error());
+
+        writeRow(out, {"flight_number", "route", "schedule", "aircraft_serial", "status"});
+        for (const auto& row : rows) {
+            writeRow(out, {row.flightNumber,
+                           RouteFormatter::toString(row.departureName, row.departureCode, row.arrivalName, row.arrivalCode),
+                           ScheduleFormatter::toString(row.departureTime, row.arrivalTime),
+                           row.aircraftSerial, FlightStatusUtil::toString(row.status)});
+        }
+        return Success(rows.size());
+    }
+
+    Result<size_t> exportPassengers(const ApplicationContext& context, std::ostream& out) {
+        std::vector<PassengerListRow> rows;
+        auto loaded = context.passengerService()->getPassengerListRows(rows);
+        if (!loaded) return Failure<size_t>(loaded.error());
+
+        writeRow(out, {"passport", "name", "email", "phone", "address"});
+        for (const auto& row : rows) {
+            writeRow(out, {row.passportNumber, row.name, row.email, row.phone, row.address});
+        }
+        return Success(rows.size());
+    }
+
+    Result<size_t> exportTickets(const ApplicationContext& context, std::ostream& out) {
+        std::vector<TicketListRow> rows;
+        auto loaded = context.ticketService()->getTicketListRows(rows);
+        if (!loaded) return Failure<size_t>(loaded.error());
+
+        writeRow(out, {"ticket_number", "passport", "flight_number", "seat", "price", "currency", "status"});
+        for (const auto& row : rows) {
+            writeRow(out, {row.ticketNumber, row.passportNumber, row.flightNumber, row.seatNumber,
+                           formatAmount(row.price), row.currency, TicketStatusUtil::toString(row.status)});
+        }
+        return Success(rows.size());
+    }
+
+    Result<ImportReport> importAircraft(const ApplicationContext& context, std::istream& in) {
+        return importRows(in, {"serial", "model", "seat_layout"}, [&](const CsvRecord& record) -> Result<bool> {
+            auto aircraft = Aircraft::create(record["serial"], record["model"], record["seat_layout"]);
+            if (!aircraft) return Failure<bool>(aircraft.error());
+            auto created = context.aircraftService()->createAircraft(aircraft.value());
+            if (!created) return Failure<bool>(created.error());
+            return Success(true);
+        });
+    }
+
+    bool isFinished(FlightStatus status) {
+        return status == FlightStatus::LANDED || status == FlightStatus::CANCELLED;
+    }
+}
+
+std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) return value;
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+Result<std::vector<std::string>> parseCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(std::move(field));
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    if (quoted) {
+        return Failure<std::vector<std::string>>(CoreError("Unterminated quoted field", "INVALID_CSV"));
+    }
+    fields.push_back(std::move(field));
+    return Success(std::move(fields));
+}
+
+Result<size_t> exportTable(const ApplicationContext& context, const std::string& table, std::ostream& out) {
+    if (table == "aircraft") return exportAircraft(context, out);
+    if (table == "flights") return exportFlights(context, out);
+    if (table == "passengers") return exportPassengers(context, out);
+    if (table == "tickets") return exportTickets(context, out);
+    return Failure<size_t>(CoreError("Unknown table: " + table, "UNKNOWN_TABLE"));
+}
+
+Result<ImportReport> importTable(const ApplicationContext& context, const std::string& table, std::istream& in) {
+    if (table == "aircraft") return importAircraft(context, in);
+    if (table == "flights" || table == "passengers") {
+        std::string csv(std::istreambuf_iterator<char>(in), {});
+        return importCsv(context, table, csv);
+    }
+    return Failure<ImportReport>(CoreError("Cannot import table: " + table, "UNKNOWN_TABLE"));
+}
+
+Result<SweepReport> sweepStatuses(const ApplicationContext& context, std::time_t now, bool dryRun) {
+    std::vector<FlightSummaryRow> flights;
+    auto loadedFlights = context.flightService()->getFlightSummaries(flights);
+    if (!loadedFlights) return Failure<SweepReport>(loadedFlights.error());
+
+    SweepReport report;
+    // Trạng thái sau khi quét, dùng để quyết định trạng thái vé
+    std::unordered_map<int, FlightStatus> statusByFlight;
+    statusByFlight.reserve(flights.size());
+
+    for (const auto& flight : flights) {
+        FlightStatus next = flight.status;
+        if (!isFinished(flight.status)) {
+            if (toTime(flight.arrivalTime) <= now) {
+                next = FlightStatus::LANDED;
+            } else if (toTime(flight.departureTime) <= now && flight.status != FlightStatus::IN_FLIGHT) {
+                next = FlightStatus::IN_FLIGHT;
+            }
+        }
+
+        if (next != flight.status) {
+            bool applied = true;
+            if (!dryRun) {
+                auto number = FlightNumber::create(flight.flightNumber);
+                auto updated = number ? context.flightService()->updateFlightStatus(number.value(), next, flight.status)
+                                      : Failure<bool>(number.error());
+                if (!updated) {
+                    report.errors.push_back(flight.flightNumber + ": " + updated.error().message);
+                    applied = false;
+                } else if (!updated.value()) {
+                    // Trạng thái đã đổi sau khi đọc: không biết trạng thái mới nên bỏ qua cả vé của chuyến này
+                    ++report.skipped;
+                    continue;
+                }
+            }
+            if (applied) {
+                ++(next == FlightStatus::LANDED ? report.flightsLanded : report.flightsInFlight);
+            } else {
+                next = flight.status;
+            }
+        }
+        statusByFlight[flight.id] = next;
+    }
+
+    std::vector<TicketListRow> tickets;
+    auto loadedTickets = context.ticketService()->getTicketListRows(tickets);
+    if (!loadedTickets) return Failure<SweepReport>(loadedTickets.error());
+
+    for (const auto& ticket : tickets) {
+        auto flightStatus = statusByFlight.find(ticket.flightId);
+        if (flightStatus == statusByFlight.end()) continue;
+
+        TicketStatus next = ticket.status;
+        if (flightStatus->second == FlightStatus::LANDED &&
+            (ticket.status == TicketStatus::CHECKED_IN || ticket.status == TicketStatus::BOARDED)) {
+            next = TicketStatus::COMPLETED;
+        } else if ((flightStatus->second == FlightStatus::IN_FLIGHT || flightStatus->second == FlightStatus::LANDED) &&
+                   ticket.status == TicketStatus::PENDING) {
+            next = TicketStatus::CANCELLED;
+        }
+        if (next == ticket.status) continue;
+
+        if (!dryRun) {
+            auto number = TicketNumber::create(ticket.ticketNumber);
+            auto updated = number ? context.ticketService()->updateTicketStatus(number.value(), next, ticket.status)
+                                  : Failure<bool>(number.error());
+            if (!updated) {
+                report.errors.push_back(ticket.ticketNumber + ": " + updated.error().message);
+                continue;
+            }
+            if (!updated.value()) {
+                ++report.skipped;
+                continue;
+            }
+        }
+        ++(next == TicketStatus::COMPLETED ? report.ticketsCompleted : report.ticketsExpired);
+    }
+    return Success(std::move(report));
+}
+
+OperationsReport summarizeOperations(const Reporting::ReportColumns& columns) {
+    const auto& flights = columns.flights;
+    const auto& tickets = columns.tickets;
+
+    OperationsReport report;
+    std::vector<bool> activeFlights(flights.size(), false);
+    for (size_t row = 0; row < flights.size(); ++row) {
+        auto status = static_cast<FlightStatus>(flights.status[row]);
+        ++report.flightsByStatus[status];
+        activeFlights[row] = status != FlightStatus::CANCELLED;
+        if (!activeFlights[row]) continue;
+        for (const auto& seats : flights.seats) report.seats += static_cast<uint64_t>(std::max(0, seats[row]));
+    }
+
+    std::vector<int64_t> revenue(tickets.currencies.size(), 0);
+    for (size_t row = 0; row < tickets.size(); ++row) {
+        auto status = static_cast<TicketStatus>(tickets.status[row]);
+        ++report.ticketsByStatus[status];
+        if (status == TicketStatus::CANCELLED || status == TicketStatus::REFUNDED) continue;
+        revenue[tickets.currency[row]] += tickets.price[row];
+        uint32_t flight = tickets.flightRow[row];
+        if (flight != Reporting::NO_FLIGHT && activeFlights[flight]) ++report.bookedSeats;
+    }
+    for (size_t code = 0; code < revenue.size(); ++code) {
+        report.revenueByCurrency[tickets.currencies.decode(static_cast<uint32_t>(code))] = Reporting::fromScaledPrice(revenue[code]);
+    }
+    return report;
+}
+
+Result<size_t> refreshSnapshot(Reporting::Snapshot& snapshot, const ApplicationContext& context) {
+    return snapshot.refresh(*context.flightRepository(), *context.ticketRepository(), *context.passengerRepository());
+}
+
+Result<OperationsReport> buildOperationsReport(const ApplicationContext& context, Reporting::Snapshot& snapshot) {
+    auto refreshed = refreshSnapshot(snapshot, context);
+    if (!refreshed) return Failure<OperationsReport>(refreshed.error());
+    return Success(snapshot.read([](const Reporting::ReportColumns& columns) { return summarizeOperations(columns); }));
+}
+
+Result<OperationsReport> buildOperationsReport(const ApplicationContext& context) {
+    Reporting::Snapshot snapshot(nullptr);
+    return buildOperationsReport(context, snapshot);
+}
+
+void OperationsReport::print(std::ostream& out) const {
+    out << "Flights by status:\n";
+    for (const auto& [status, count] : flightsByStatus) {
+        out << "  " << FlightStatusUtil::toString(status) << ": " << count << "\n";
+    }
+    out << "Tickets by status:\n";
+    for (const auto& [status, count] : ticketsByStatus) {
+        out << "  " << TicketStatusUtil::toString(status) << ": " << count << "\n";
+    }
+    out << "Revenue (excluding cancelled and refunded tickets):\n";
+    for (const auto& [currency, amount] : revenueByCurrency) {
+        out << "  " << currency << ": " << formatAmount(amount) << "\n";
+    }
+    char line[128];
+    std::snprintf(line, sizeof(line), "Load factor: %.1f%% (%llu of %llu seats)\n", loadFactor() * 100.0,
+                  static_cast<unsigned long long>(bookedSeats), static_cast<unsigned long long>(seats));
+    out << line;
+}
+
+} // namespace Cli
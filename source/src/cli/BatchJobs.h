@@ -0,0 +1,133 @@
+/**
+ * @file BatchJobs.h
+ * @brief Các tác vụ hàng loạt của airlines_cli: xuất/nhập CSV, quét trạng thái định kỳ và báo cáo
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mọi tác vụ làm việc trên ApplicationContext nên chạy được với MySQL lẫn InMemoryConnection.
+ * Các bảng lớn (chuyến bay, hành khách, vé) được đọc qua read model phẳng thay vì dựng entity.
+ *
+ * Định dạng CSV: dòng đầu là tên cột, các cột khớp theo tên nên thứ tự tùy ý. Giá trị dùng
+ * đúng định dạng chuỗi của value object (tuyến "Tên(MÃ)-Tên(MÃ)", lịch trình
+ * "YYYY-MM-DD HH:mm|YYYY-MM-DD HH:mm", sơ đồ ghế "ECONOMY:150,BUSINESS:20"...), nên tệp do
+ * export tạo ra nhập lại được bằng import.
+ *
+ * Cột của từng bảng:
+ * - aircraft:   serial, model, seat_layout
+ * - passengers: passport, name, email, phone, address
+ * - flights:    flight_number, route, schedule, aircraft_serial, status
+ * - tickets:    ticket_number, passport, flight_number, seat, price, currency, status (chỉ xuất)
+ */
+
+#ifndef CLI_BATCH_JOBS_H
+#define CLI_BATCH_JOBS_H
+
+#include "../app/ApplicationContext.h"
+#include "../reporting/ReportColumns.h"
+#include "../reporting/Snapshot.h"
+#include <ctime>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Cli {
+
+/// Bao giá trị trong dấu nháy kép khi chứa dấu phẩy, nháy kép hoặc xuống dòng
+std::string csvField(const std::string& value);
+
+/**
+ * @brief Tách một dòng CSV (RFC 4180, không hỗ trợ xuống dòng trong trường)
+ * @return Lỗi INVALID_CSV nếu dấu nháy không đóng
+ */
+Result<std::vector<std::string>> parseCsvLine(const std::string& line);
+
+/**
+ * @brief Ghi toàn bộ một bảng ra CSV
+ * @param table "aircraft", "flights", "passengers" hoặc "tickets"
+ * @return Số hàng đã ghi, hoặc lỗi UNKNOWN_TABLE / lỗi của tầng service
+ */
+Result<size_t> exportTable(const ApplicationContext& context, const std::string& table, std::ostream& out);
+
+struct RowError {
+    size_t line = 0;            ///< Số dòng trong tệp (dòng tiêu đề là 1)
+    std::string code;
+    std::string message;
+};
+
+struct ImportReport {
+    size_t imported = 0;
+    std::vector<RowError> errors;
+};
+
+/**
+ * @brief Nhập CSV từ luồng vào
+ *
+ * "aircraft" được nhập từng dòng qua AircraftService; "flights" và "passengers" được đọc hết
+ * vào bộ nhớ rồi đi qua importCsv (BulkImport.h) với tùy chọn mặc định.
+ *
+ * Dòng lỗi (sai định dạng, trùng khóa, máy bay không tồn tại...) được ghi vào
+ * ImportReport::errors và không chặn các dòng còn lại.
+ *
+ * @param table "aircraft", "flights" hoặc "passengers"
+ * @return Lỗi UNKNOWN_TABLE hoặc INVALID_CSV_HEADER nếu thiếu cột bắt buộc
+ */
+Result<ImportReport> importTable(const ApplicationContext& context, const std::string& table, std::istream& in);
+
+struct SweepReport {
+    size_t flightsInFlight = 0;     ///< Đã qua giờ khởi hành, chưa tới giờ đến
+    size_t flightsLanded = 0;       ///< Đã qua giờ đến
+    size_t ticketsCompleted = 0;    ///< Vé đã check-in/lên máy bay của chuyến đã hạ cánh
+    size_t ticketsExpired = 0;      ///< Vé PENDING của chuyến đã cất cánh, chuyển sang CANCELLED
+    size_t skipped = 0;             ///< Chuyến bay/vé đã bị phiên khác đổi trạng thái sau khi quét đọc, không ghi
+    std::vector<std::string> errors;
+};
+
+/**
+ * @brief Quét trạng thái hằng đêm: đẩy chuyến bay và vé theo thời gian thực
+ *
+ * Chuyến bay SCHEDULED/BOARDING/DELAYED/DEPARTED đã qua giờ khởi hành chuyển sang IN_FLIGHT,
+ * mọi chuyến chưa kết thúc đã qua giờ đến chuyển sang LANDED. Chuyến CANCELLED không bị đụng tới.
+ * Sau đó vé CHECKED_IN/BOARDED của chuyến đã hạ cánh chuyển sang COMPLETED, vé PENDING của chuyến
+ * đã cất cánh chuyển sang CANCELLED. Vé CONFIRMED (không đến) giữ nguyên để xử lý hoàn tiền.
+ *
+ * Mỗi lệnh ghi chỉ áp dụng khi trạng thái hiện tại vẫn là trạng thái mà lần quét đã đọc; nếu
+ * phiên khác đã đổi (ví dụ hủy chuyến trong lúc quét), hàng đó được đếm vào skipped và vé của
+ * chuyến bay đó không bị đụng tới.
+ *
+ * @param now Mốc thời gian so sánh (giờ địa phương, như thời gian lưu trong cơ sở dữ liệu)
+ * @param dryRun true thì chỉ đếm, không ghi
+ */
+Result<SweepReport> sweepStatuses(const ApplicationContext& context, std::time_t now, bool dryRun);
+
+struct OperationsReport {
+    std::map<FlightStatus, size_t> flightsByStatus;
+    std::map<TicketStatus, size_t> ticketsByStatus;
+    std::map<std::string, double> revenueByCurrency;   ///< Vé chưa hủy/hoàn tiền
+    uint64_t seats = 0;                                 ///< Tổng ghế của các chuyến chưa hủy
+    uint64_t bookedSeats = 0;                           ///< Vé chưa hủy/hoàn tiền trên các chuyến đó
+
+    double loadFactor() const { return seats > 0 ? static_cast<double>(bookedSeats) / seats : 0.0; }
+    void print(std::ostream& out) const;
+};
+
+/// Tổng hợp trạng thái toàn bảng từ các cột báo cáo đã nạp
+OperationsReport summarizeOperations(const Reporting::ReportColumns& columns);
+
+/// Nạp hoặc đồng bộ ảnh chụp qua các repository của context
+Result<size_t> refreshSnapshot(Reporting::Snapshot& snapshot, const ApplicationContext& context);
+
+/**
+ * @brief Đồng bộ ảnh chụp qua các repository của context rồi tổng hợp trên nó
+ * @return Lỗi truy vấn nếu không nạp được
+ */
+Result<OperationsReport> buildOperationsReport(const ApplicationContext& context, Reporting::Snapshot& snapshot);
+
+/// buildOperationsReport trên một ảnh chụp chỉ dùng cho lần gọi này
+Result<OperationsReport> buildOperationsReport(const ApplicationContext& context);
+
+} // namespace Cli
+
+#endif // CLI_BATCH_JOBS_H
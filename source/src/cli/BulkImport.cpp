@@ -0,0 +1,524 @@
+#include "BulkImport.h"
+#include "../utils/MappedFile.h"
+#include "../utils/Tracing.h"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Cli {
+
+namespace {
+    /// Dưới số bản ghi này mỗi luồng, chi phí tạo luồng lớn hơn phần kiểm tra
+    constexpr size_t MIN_RECORDS_PER_THREAD = 64;
+    /// Cỡ trang khi đọc chuyến bay đã có để đối chiếu
+    constexpr size_t EXISTING_PAGE_SIZE = 5000;
+
+    struct RawRecord {
+        size_t line = 0;
+        std::vector<std::string> fields;
+    };
+
+    /// Bản ghi đã qua kiểm tra, kèm số dòng để báo lỗi ở các giai đoạn sau
+    template <typename Row>
+    struct Staged {
+        size_t line;
+        Row row;
+    };
+
+    template <typename Row>
+    struct ValidatedBatch {
+        std::vector<Staged<Row>> rows;      ///< Theo thứ tự dòng
+        std::vector<RowError> errors;
+        bool finished = false;              ///< Đã hết dữ liệu
+    };
+
+    /// Vị trí các cột cần đọc trong tiêu đề; npos nếu cột tùy chọn không có
+    class CsvColumns {
+    private:
+        std::vector<size_t> _indexes;
+
+    public:
+        static constexpr size_t MISSING = static_cast<size_t>(-1);
+
+        /**
+         * @param required Cột bắt buộc, theo thứ tự truy cập
+         * @param optional Cột tùy chọn, nối sau các cột bắt buộc
+         * @return Lỗi INVALID_CSV_HEADER nếu dữ liệu rỗng hoặc thiếu cột bắt buộc
+         */
+        static Result<CsvColumns> read(CsvTokenizer& tokenizer, const std::vector<std::string>& required,
+                                       const std::vector<std::string>& optional) {
+            std::vector<std::string> fields;
+            size_t line = 0;
+            auto parsed = tokenizer.next(fields, line);
+            if (!parsed) return Failure<CsvColumns>(CoreError(parsed.error().message, "INVALID_CSV_HEADER"));
+            if (!parsed.value()) return Failure<CsvColumns>(CoreError("CSV input is empty", "INVALID_CSV_HEADER"));
+
+            std::unordered_map<std::string, size_t> header;
+            for (size_t i = 0; i < fields.size(); ++i) header[fields[i]] = i;
+
+            CsvColumns columns;
+            for (const auto& column : required) {
+                auto found = header.find(column);
+                if (found == header.end()) {
+                    return Failure<CsvColumns>(CoreError("Missing CSV column: " + column, "INVALID_CSV_HEADER"));
+                }
+                columns._indexes.push_back(found->second);
+            }
+            for (const auto& column : optional) {
+                auto found = header.find(column);
+                columns._indexes.push_back(found == header.end() ? MISSING : found->second);
+            }
+            return Success(std::move(columns));
+        }
+
+        /// Giá trị cột thứ column (theo thứ tự khi read), rỗng nếu bản ghi ngắn hơn tiêu đề
+        const std::string& get(const RawRecord& record, size_t column) const {
+            static const std::string empty;
+            size_t index = _indexes[column];
+            return index < record.fields.size() ? record.fields[index] : empty;
+        }
+    };
+
+    /// Chạy work(begin, end) trên items phần tử chia đều cho tối đa threads luồng
+    template <typename Work>
+    void runPartitioned(size_t threads, size_t items, const Work& work) {
+        size_t count = std::max<size_t>(1, std::min(threads, items / MIN_RECORDS_PER_THREAD));
+        if (count <= 1) {
+            work(0, items);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(count);
+        for (size_t t = 0; t < count; ++t) {
+            workers.emplace_back([&work, begin = items * t / count, end = items * (t + 1) / count] { work(begin, end); });
+        }
+        for (auto& worker : workers) worker.join();
+    }
+
+    /**
+     * @brief Giai đoạn 1 và 2: tách tối đa batchSize bản ghi rồi kiểm tra song song
+     * @param validate Hàm thuần Result<Row>(const RawRecord&), được gọi đồng thời trên nhiều luồng
+     */
+    template <typename Row, typename Validate>
+    ValidatedBatch<Row> readBatch(CsvTokenizer& tokenizer, size_t batchSize, size_t threads, const Validate& validate) {
+        ValidatedBatch<Row> batch;
+        std::vector<RawRecord> records;
+        records.reserve(batchSize);
+        while (records.size() < batchSize) {
+            RawRecord record;
+            auto parsed = tokenizer.next(record.fields, record.line);
+            if (!parsed) {
+                batch.errors.push_back({record.line, parsed.error().code, parsed.error().message});
+                continue;
+            }
+            if (!parsed.value()) {
+                batch.finished = true;
+                break;
+            }
+            records.push_back(std::move(record));
+        }
+
+        std::vector<std::optional<Result<Row>>> results(records.size());
+        runPartitioned(threads, records.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) results[i].emplace(validate(records[i]));
+        });
+
+        batch.rows.reserve(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            auto& result = *results[i];
+            if (result) {
+                batch.rows.push_back({records[i].line, std::move(result.value())});
+            } else {
+                batch.errors.push_back({records[i].line, result.error().code, result.error().message});
+            }
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Chạy cả đường nhập: lô kế tiếp được tách và kiểm tra trong lúc lô hiện tại được ghi
+     * @param commit Giai đoạn 3 và 4 trên luồng gọi: void(std::vector<Staged<Row>>&, ImportReport&)
+     */
+    template <typename Row, typename Validate, typename Commit>
+    ImportReport runPipeline(CsvTokenizer& tokenizer, const BulkImportOptions& options, const Validate& validate,
+                             const Commit& commit) {
+        const size_t batchSize = std::clamp<size_t>(options.batchSize, 1, BulkImportOptions::MAX_BATCH_SIZE);
+        const size_t threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        auto read = [&] { return readBatch<Row>(tokenizer, batchSize, threads, validate); };
+
+        ImportReport report;
+        auto next = std::async(std::launch::async, read);
+        while (true) {
+            ValidatedBatch<Row> batch = next.get();
+            if (!batch.finished) next = std::async(std::launch::async, read);
+
+            report.errors.insert(report.errors.end(), std::make_move_iterator(batch.errors.begin()),
+                                 std::make_move_iterator(batch.errors.end()));
+            commit(batch.rows, report);
+            if (batch.finished) break;
+        }
+        std::stable_sort(report.errors.begin(), report.errors.end(),
+                         [](const RowError& a, const RowError& b) { return a.line < b.line; });
+        return report;
+    }
+
+    /**
+     * @brief Giai đoạn 4: chèn cả lô; nếu lô thất bại thì chèn lại từng dòng để lỗi gắn đúng dòng
+     * @param insert Result<T>(const std::vector<Row>&) của repository
+     * @param rejected Gọi cho mỗi dòng không chèn được, để gỡ khỏi trạng thái đối chiếu
+     */
+    template <typename Row, typename Insert, typename Rejected>
+    void insertBatch(std::vector<Staged<Row>>& staged, ImportReport& report, const Insert& insert, const Rejected& rejected) {
+        if (staged.empty()) return;
+        std::vector<Row> rows;
+        rows.reserve(staged.size());
+        for (auto& item : staged) rows.push_back(std::move(item.row));
+
+        if (insert(rows)) {
+            report.imported += rows.size();
+            return;
+        }
+        for (size_t i = 0; i < rows.size(); ++i) {
+            std::vector<Row> single{std::move(rows[i])};
+            auto inserted = insert(single);
+            if (inserted) {
+                ++report.imported;
+            } else {
+                report.errors.push_back({staged[i].line, inserted.error().code, inserted.error().message});
+                rejected(single.front());
+            }
+        }
+    }
+
+    std::time_t toTime(std::tm value) {
+        value.tm_isdst = -1;
+        return std::mktime(&value);
+    }
+
+    // === Chuyến bay ===
+
+    struct FlightCandidate {
+        FlightInsertRow row;
+        std::time_t departs = 0;
+        std::time_t arrives = 0;
+    };
+
+    /**
+     * @brief Lịch bay đã có của từng máy bay, tìm chuyến bay chồng lịch
+     *
+     * Khoảng được sắp theo giờ đi. Mọi khoảng giao với [departs, arrives] đều có giờ đi trong
+     * [departs - dài nhất, arrives], nên chỉ cần quét đoạn đó.
+     */
+    class ScheduleIndex {
+    private:
+        struct Slot {
+            std::time_t arrives;
+            std::string flightNumber;
+        };
+        struct Aircraft {
+            std::multimap<std::time_t, Slot> slots;
+            std::time_t longest = 0;
+        };
+        std::unordered_map<std::string, Aircraft> _aircraft;
+
+    public:
+        void add(const std::string& serial, std::time_t departs, std::time_t arrives, const std::string& flightNumber) {
+            auto& aircraft = _aircraft[serial];
+            aircraft.slots.emplace(departs, Slot{arrives, flightNumber});
+            aircraft.longest = std::max(aircraft.longest, arrives - departs);
+        }
+
+        void remove(const std::string& serial, std::time_t departs, const std::string& flightNumber) {
+            auto aircraft = _aircraft.find(serial);
+            if (aircraft == _aircraft.end()) return;
+            auto [begin, end] = aircraft->second.slots.equal_range(departs);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second.flightNumber == flightNumber) {
+                    aircraft->second.slots.erase(it);
+                    return;
+                }
+            }
+        }
+
+        /// Số hiệu của một chuyến bay chồng lịch, hoặc nullptr
+        const std::string* findOverlap(const std::string& serial, std::time_t departs, std::time_t arrives) const {
+            auto aircraft = _aircraft.find(serial);
+            if (aircraft == _aircraft.end()) return nullptr;
+            const auto& slots = aircraft->second.slots;
+            auto end = slots.upper_bound(arrives);
+            for (auto it = slots.lower_bound(departs - aircraft->second.longest); it != end; ++it) {
+                if (it->second.arrives >= departs) return &it->second.flightNumber;
+            }
+            return nullptr;
+        }
+    };
+
+    Result<ImportReport> importFlights(const ApplicationContext& context, CsvTokenizer& tokenizer,
+                                       const BulkImportOptions& options) {
+        enum { NUMBER, ROUTE, SCHEDULE, SERIAL, STATUS };
+        auto columns = CsvColumns::read(tokenizer, {"flight_number", "route", "schedule", "aircraft_serial"}, {"status"});
+        if (!columns) return Failure<ImportReport>(columns.error());
+
+        // Bảng máy bay nhỏ: nạp một lần, các luồng kiểm tra chỉ đọc
+        auto fleet = context.aircraftService()->getAllAircraft();
+        if (!fleet) return Failure<ImportReport>(fleet.error());
+        std::unordered_map<std::string, std::shared_ptr<const Aircraft>> aircraftBySerial;
+        for (auto& aircraft : fleet.value()) {
+            std::string serial = aircraft.getSerial().toString();
+            aircraftBySerial.emplace(std::move(serial), std::make_shared<const Aircraft>(std::move(aircraft)));
+        }
+
+        // Số hiệu và lịch của chuyến bay đã có, đi qua bảng theo khóa
+        std::unordered_set<std::string> flightNumbers;
+        ScheduleIndex schedules;
+        std::vector<FlightSummaryRow> existing;
+        int afterId = 0;
+        do {
+            auto loaded = context.flightRepository()->findSummariesAfter(afterId, EXISTING_PAGE_SIZE, existing);
+            if (!loaded) return Failure<ImportReport>(loaded.error());
+            for (const auto& flight : existing) {
+                flightNumbers.insert(flight.flightNumber);
+                schedules.add(flight.aircraftSerial, toTime(flight.departureTime), toTime(flight.arrivalTime), flight.flightNumber);
+            }
+            if (!existing.empty()) afterId = existing.back().id;
+        } while (existing.size() == EXISTING_PAGE_SIZE);
+
+        const CsvColumns& csv = columns.value();
+        auto validate = [&](const RawRecord& record) -> Result<FlightCandidate> {
+            auto serial = AircraftSerial::create(csv.get(record, SERIAL));
+            if (!serial) return Failure<FlightCandidate>(serial.error());
+            auto aircraft = aircraftBySerial.find(serial.value().toString());
+            if (aircraft == aircraftBySerial.end()) {
+                return Failure<FlightCandidate>(CoreError("Aircraft not found with serial number: " + serial.value().toString(), "NOT_FOUND"));
+            }
+
+            FlightCandidate candidate;
+            if (const std::string& status = csv.get(record, STATUS); !status.empty()) {
+                try {
+                    candidate.row.status = FlightStatusUtil::fromString(status);
+                } catch (const std::invalid_argument&) {
+                    return Failure<FlightCandidate>(CoreError("Invalid flight status: " + status, "INVALID_FLIGHT_STATUS"));
+                }
+            }
+
+            auto number = FlightNumber::create(csv.get(record, NUMBER));
+            if (!number) {
+                return Failure<FlightCandidate>(CoreError("Invalid flight number: " + number.error().message, "INVALID_FLIGHT_NUMBER"));
+            }
+            auto route = Route::create(csv.get(record, ROUTE));
+            if (!route) {
+                return Failure<FlightCandidate>(CoreError("Invalid route: " + route.error().message, "INVALID_ROUTE"));
+            }
+            auto schedule = Schedule::create(csv.get(record, SCHEDULE));
+            if (!schedule) {
+                return Failure<FlightCandidate>(CoreError("Invalid schedule: " + schedule.error().message, "INVALID_SCHEDULE"));
+            }
+
+            candidate.row.flightNumber = number.value().toString();
+            candidate.row.departureCode = route.value().getOriginCode();
+            candidate.row.departureName = route.value().getOrigin();
+            candidate.row.arrivalCode = route.value().getDestinationCode();
+            candidate.row.arrivalName = route.value().getDestination();
+            candidate.row.departureTime = schedule.value().getDeparture();
+            candidate.row.arrivalTime = schedule.value().getArrival();
+            candidate.row.aircraft = aircraft->second;
+            candidate.departs = toTime(candidate.row.departureTime);
+            candidate.arrives = toTime(candidate.row.arrivalTime);
+            return Success(std::move(candidate));
+        };
+
+        auto commit = [&](std::vector<Staged<FlightCandidate>>& batch, ImportReport& report) {
+            std::vector<Staged<FlightInsertRow>> accepted;
+            accepted.reserve(batch.size());
+            for (auto& [line, candidate] : batch) {
+                const auto& row = candidate.row;
+                const std::string serial = row.aircraft->getSerial().toString();
+                if (flightNumbers.count(row.flightNumber)) {
+                    report.errors.push_back({line, "DUPLICATE_FLIGHT_NUMBER", "Flight with this number already exists"});
+                    continue;
+                }
+                if (const std::string* other = schedules.findOverlap(serial, candidate.departs, candidate.arrives)) {
+                    report.errors.push_back({line, "SCHEDULE_CONFLICT",
+                                             "Schedule overlaps flight " + *other + " on aircraft " + serial});
+                    continue;
+                }
+                flightNumbers.insert(row.flightNumber);
+                schedules.add(serial, candidate.departs, candidate.arrives, row.flightNumber);
+                accepted.push_back({line, std::move(candidate.row)});
+            }
+
+            insertBatch(accepted, report,
+                [&](const std::vector<FlightInsertRow>& rows) { return context.flightRepository()->createBatch(rows); },
+                [&](const FlightInsertRow& row) {
+                    flightNumbers.erase(row.flightNumber);
+                    schedules.remove(row.aircraft->getSerial().toString(), toTime(row.departureTime), row.flightNumber);
+                });
+        };
+
+        return Success(runPipeline<FlightCandidate>(tokenizer, options, validate, commit));
+    }
+
+    // === Hành khách ===
+
+    Result<ImportReport> importPassengers(const ApplicationContext& context, CsvTokenizer& tokenizer,
+                                          const BulkImportOptions& options) {
+        enum { PASSPORT, NAME, EMAIL, PHONE, ADDRESS };
+        auto columns = CsvColumns::read(tokenizer, {"passport", "name", "email", "phone", "address"}, {});
+        if (!columns) return Failure<ImportReport>(columns.error());
+
+        const CsvColumns& csv = columns.value();
+        auto validate = [&](const RawRecord& record) -> Result<Passenger> {
+            std::string contact = csv.get(record, EMAIL) + "|" + csv.get(record, PHONE) + "|" + csv.get(record, ADDRESS);
+            return Passenger::create(csv.get(record, NAME), contact, csv.get(record, PASSPORT));
+        };
+
+        // Hộ chiếu đã gặp trong tệp; hộ chiếu đã có trong cơ sở dữ liệu được hỏi theo từng lô
+        std::unordered_set<std::string> passports;
+        auto commit = [&](std::vector<Staged<Passenger>>& batch, ImportReport& report) {
+            std::vector<PassportNumber> lookup;
+            lookup.reserve(batch.size());
+            for (const auto& item : batch) lookup.push_back(item.row.getPassport());
+            std::unordered_set<std::string> existing;
+            auto found = context.passengerRepository()->findByPassportNumbers(lookup);
+            if (found) {
+                for (const auto& passenger : found.value()) existing.insert(passenger.getPassport().toString());
+            }
+
+            std::vector<Staged<Passenger>> accepted;
+            accepted.reserve(batch.size());
+            for (auto& item : batch) {
+                if (!found) {
+                    report.errors.push_back({item.line, found.error().code, found.error().message});
+                    continue;
+                }
+                std::string passport = item.row.getPassport().toString();
+                if (existing.count(passport) || !passports.insert(passport).second) {
+                    report.errors.push_back({item.line, "DUPLICATE_PASSPORT", "Passenger with this passport already exists"});
+                    continue;
+                }
+                accepted.push_back(std::move(item));
+            }
+
+            insertBatch(accepted, report,
+                [&](const std::vector<Passenger>& rows) { return context.passengerRepository()->createBatch(rows); },
+                [&](const Passenger& row) { passports.erase(row.getPassport().toString()); });
+        };
+
+        return Success(runPipeline<Passenger>(tokenizer, options, validate, commit));
+    }
+}
+
+CsvTokenizer::CsvTokenizer(std::string_view text) : _text(text) {
+    if (_text.starts_with("\xEF\xBB\xBF")) _position = 3;
+}
+
+Result<bool> CsvTokenizer::next(std::vector<std::string>& fields, size_t& line) {
+    const char* data = _text.data();
+    const size_t size = _text.size();
+
+    // Dòng trống
+    while (_position < size && (data[_position] == '\n' || data[_position] == '\r')) {
+        if (data[_position] == '\n') ++_line;
+        ++_position;
+    }
+    line = _line;
+    if (_position >= size) return Success(false);
+
+    size_t count = 0;
+    while (true) {
+        if (count == fields.size()) fields.emplace_back();
+        std::string& field = fields[count++];
+        field.clear();
+
+        // Một trường có thể xen kẽ đoạn thường và đoạn trong nháy, như parseCsvLine
+        while (true) {
+            if (_position < size && data[_position] == '"') {
+                ++_position;
+                while (true) {
+                    const void* found = std::memchr(data + _position, '"', size - _position);
+                    if (!found) {
+                        _line += static_cast<size_t>(std::count(data + _position, data + size, '\n'));
+                        _position = size;
+                        fields.resize(count);
+                        return Failure<bool>(CoreError("Unterminated quoted field", "INVALID_CSV"));
+                    }
+                    const char* quote = static_cast<const char*>(found);
+                    field.append(data + _position, quote);
+                    _line += static_cast<size_t>(std::count(data + _position, quote, '\n'));
+                    _position = static_cast<size_t>(quote - data) + 1;
+                    if (_position < size && data[_position] == '"') {
+                        field += '"';
+                        ++_position;
+                        continue;
+                    }
+                    break;
+                }
+            }
+
+            size_t start = _position;
+            while (_position < size) {
+                char c = data[_position];
+                if (c == ',' || c == '\n' || c == '\r' || c == '"') break;
+                ++_position;
+            }
+            field.append(data + start, _position - start);
+
+            // "\r" đứng riêng (không phải cuối dòng) là một phần của trường
+            if (_position < size && data[_position] == '\r' && _position + 1 < size && data[_position + 1] != '\n') {
+                field += '\r';
+                ++_position;
+                continue;
+            }
+            if (_position < size && data[_position] == '"') continue;
+            break;
+        }
+
+        if (_position < size && data[_position] == ',') {
+            ++_position;
+            continue;
+        }
+        if (_position < size && data[_position] == '\r') ++_position;
+        if (_position < size && data[_position] == '\n') {
+            ++_position;
+            ++_line;
+        }
+        break;
+    }
+    fields.resize(count);
+    return Success(true);
+}
+
+Result<ImportReport> importCsv(const ApplicationContext& context, const std::string& table, std::string_view csv,
+                               const BulkImportOptions& options) {
+    if (table == "aircraft") {
+        std::istringstream in{std::string(csv)};
+        return importTable(context, table, in);
+    }
+    if (table != "flights" && table != "passengers") {
+        return Failure<ImportReport>(CoreError("Cannot import table: " + table, "UNKNOWN_TABLE"));
+    }
+
+    Tracing::Span span(table == "flights" ? "import.flights" : "import.passengers", "cli");
+    CsvTokenizer tokenizer(csv);
+    return table == "flights" ? importFlights(context, tokenizer, options) : importPassengers(context, tokenizer, options);
+}
+
+Result<ImportReport> importFile(const ApplicationContext& context, const std::string& table, const std::string& path,
+                                const BulkImportOptions& options) {
+    if (table != "aircraft" && table != "flights" && table != "passengers") {
+        return Failure<ImportReport>(CoreError("Cannot import table: " + table, "UNKNOWN_TABLE"));
+    }
+    MappedFile file;
+    auto opened = file.open(path, "IMPORT_IO");
+    if (!opened) return Failure<ImportReport>(opened.error());
+    return importCsv(context, table, file.text(), options);
+}
+
+} // namespace Cli
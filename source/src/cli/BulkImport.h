@@ -0,0 +1,92 @@
+/**
+ * @file BulkImport.h
+ * @brief Nhập lịch bay và danh sách hành khách từ CSV theo lô
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Thay cho việc nhập từng chuyến bay/hành khách qua service (mỗi dòng vài truy vấn kiểm tra và
+ * một transaction), tệp được xử lý theo lô BulkImportOptions::batchSize bản ghi qua bốn giai đoạn:
+ *
+ * 1. CsvTokenizer tách bản ghi thẳng trên vùng nhớ của tệp (MappedFile), không chép qua luồng
+ *    vào/ra từng dòng.
+ * 2. Bản ghi của lô được kiểm tra song song bằng validator của các value object (FlightNumber,
+ *    Route, Schedule, PassportNumber, ContactInfo...). Đây là phần tốn CPU của việc nhập.
+ * 3. Trên luồng gọi, lô được đối chiếu với dữ liệu đã có và các dòng trước trong tệp: số hiệu
+ *    chuyến bay hoặc hộ chiếu trùng, lịch trình chồng lên chuyến bay khác của cùng máy bay (cùng
+ *    quy tắc với FlightService::validateScheduleForAircraft: hai khoảng [đi, đến] giao nhau kể cả
+ *    khi chỉ chạm nhau, không phân biệt trạng thái chuyến bay).
+ * 4. Các dòng hợp lệ được chèn bằng createBatch của repository trong một transaction. Nếu cả lô
+ *    thất bại (ví dụ phiên khác vừa chèn cùng hộ chiếu), lô được chèn lại từng dòng để lỗi gắn
+ *    đúng dòng.
+ *
+ * Trong lúc lô k được chèn, lô k+1 được tách và kiểm tra trên luồng khác, nên khi cơ sở dữ liệu
+ * chậm hơn phần phân tích, thời gian nhập chỉ còn là thời gian chèn. Lỗi của từng dòng được trả về
+ * trong ImportReport theo thứ tự dòng, như importTable.
+ */
+
+#ifndef CLI_BULK_IMPORT_H
+#define CLI_BULK_IMPORT_H
+
+#include "BatchJobs.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cli {
+
+/**
+ * @brief Tách bản ghi CSV (RFC 4180) trên một vùng nhớ liền
+ *
+ * Trường trong dấu nháy kép được chứa dấu phẩy và xuống dòng; dòng trống bị bỏ qua; chấp nhận
+ * cả "\n" lẫn "\r\n" và bỏ BOM UTF-8 ở đầu. Vùng nhớ phải sống lâu hơn tokenizer.
+ */
+class CsvTokenizer {
+private:
+    std::string_view _text;
+    size_t _position = 0;
+    size_t _line = 1;
+
+public:
+    explicit CsvTokenizer(std::string_view text);
+
+    /**
+     * @brief Tách bản ghi kế tiếp
+     * @param fields Nhận các trường; dung lượng của các chuỗi được giữ giữa các lần gọi
+     * @param line Nhận số dòng bắt đầu của bản ghi (dòng đầu là 1)
+     * @return false khi hết dữ liệu, hoặc lỗi INVALID_CSV nếu dấu nháy không đóng (phần còn lại
+     *         của dữ liệu bị bỏ)
+     */
+    Result<bool> next(std::vector<std::string>& fields, size_t& line);
+};
+
+struct BulkImportOptions {
+    static constexpr size_t DEFAULT_BATCH_SIZE = 1000;
+    /// Giữ số tham số của câu INSERT nhiều hàng dưới giới hạn 65535 của MySQL
+    static constexpr size_t MAX_BATCH_SIZE = 5000;
+
+    size_t batchSize = DEFAULT_BATCH_SIZE;  ///< Số bản ghi mỗi lô (mỗi transaction)
+    size_t threads = 0;                     ///< Số luồng kiểm tra; 0 là theo số lõi
+};
+
+/**
+ * @brief Nhập nội dung CSV đã nằm trong bộ nhớ
+ *
+ * "flights" và "passengers" đi qua đường nhập theo lô; "aircraft" (bảng nhỏ) vẫn được nhập từng
+ * dòng qua AircraftService như importTable. Cột và định dạng giá trị như importTable.
+ *
+ * @return Lỗi UNKNOWN_TABLE, INVALID_CSV_HEADER, hoặc lỗi khi nạp dữ liệu đối chiếu
+ */
+Result<ImportReport> importCsv(const ApplicationContext& context, const std::string& table, std::string_view csv,
+                               const BulkImportOptions& options = {});
+
+/**
+ * @brief Ánh xạ tệp vào bộ nhớ rồi nhập như importCsv
+ * @return Thêm lỗi IMPORT_IO nếu không mở được tệp
+ */
+Result<ImportReport> importFile(const ApplicationContext& context, const std::string& table, const std::string& path,
+                                const BulkImportOptions& options = {});
+
+} // namespace Cli
+
+#endif // CLI_BULK_IMPORT_H
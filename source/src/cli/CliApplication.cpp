@@ -0,0 +1,371 @@
+#include "CliApplication.h"
+#include "BatchJobs.h"
+#include "BulkImport.h"
+#include "../app/ApplicationContext.h"
+#include "../loadgen/DataGenerator.h"
+#include "../loadgen/LoadDriver.h"
+#include "../reporting/SalesReport.h"
+#include "../reporting/Snapshot.h"
+#include "../utils/Metrics.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace Cli {
+
+namespace {
+    constexpr int EXIT_OK = 0;
+    constexpr int EXIT_FAILED = 1;
+    constexpr int EXIT_USAGE = 2;
+
+    /// Số dòng lỗi in ra khi nhập; phần còn lại chỉ được đếm
+    constexpr size_t MAX_PRINTED_ROW_ERRORS = 50;
+
+    Result<std::shared_ptr<ApplicationContext>> openContext(const ConnectionFactory& connect, std::shared_ptr<Logger> logger) {
+        auto connection = connect();
+        if (!connection) return Failure<std::shared_ptr<ApplicationContext>>(connection.error());
+        return Success(std::make_shared<ApplicationContext>(connection.value(), std::move(logger)));
+    }
+
+    Result<LoadGen::GeneratorConfig> generatorConfig(const CommandLine& commandLine) {
+        LoadGen::GeneratorConfig config;
+        auto aircraft = commandLine.getUnsigned("aircraft", config.aircraftCount);
+        auto flights = commandLine.getUnsigned("flights", config.flightCount);
+        auto passengers = commandLine.getUnsigned("passengers", config.passengerCount);
+        auto tickets = commandLine.getUnsigned("tickets", config.ticketCount);
+        auto skew = commandLine.getDouble("skew", config.routeSkew);
+        auto seed = commandLine.getUnsigned("seed", config.seed);
+        auto days = commandLine.getUnsigned("days", config.days);
+        auto idOffset = commandLine.getUnsigned("id-offset", config.idOffset);
+        for (const auto* value : {&aircraft, &flights, &passengers, &tickets, &seed, &days, &idOffset}) {
+            if (!*value) return Failure<LoadGen::GeneratorConfig>(value->error());
+        }
+        if (!skew) return Failure<LoadGen::GeneratorConfig>(skew.error());
+
+        config.aircraftCount = aircraft.value();
+        config.flightCount = flights.value();
+        config.passengerCount = passengers.value();
+        config.ticketCount = tickets.value();
+        config.routeSkew = skew.value();
+        config.seed = seed.value();
+        config.startDate = commandLine.get("start-date", config.startDate);
+        config.days = static_cast<int>(days.value());
+        config.idOffset = static_cast<int64_t>(idOffset.value());
+        return Success(config);
+    }
+
+    Result<LoadGen::SyntheticDataset> planDataset(const CommandLine& commandLine, std::ostream& err) {
+        auto config = generatorConfig(commandLine);
+        if (!config) return Failure<LoadGen::SyntheticDataset>(config.error());
+        auto dataset = LoadGen::SyntheticDataset::create(config.value());
+        if (dataset) {
+            err << "Planned " << dataset.value().flights().size() << " flights on " << dataset.value().routes().size()
+                << " routes, " << dataset.value().plannedTickets() << " tickets\n";
+        }
+        return dataset;
+    }
+
+    int runExport(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+                  std::ostream& out, std::ostream& err) {
+        if (commandLine.arguments.size() != 1) return EXIT_USAGE;
+        auto context = openContext(connect, logger);
+        if (!context) {
+            err << context.error().message << "\n";
+            return EXIT_FAILED;
+        }
+
+        std::ofstream file;
+        std::ostream* target = &out;
+        if (auto path = commandLine.get("out", ""); !path.empty()) {
+            file.open(path, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) {
+                err << "Failed to open " << path << "\n";
+                return EXIT_FAILED;
+            }
+            target = &file;
+        }
+
+        auto written = exportTable(*context.value(), commandLine.arguments[0], *target);
+        if (!written) {
+            err << written.error().message << "\n";
+            return written.error().code == "UNKNOWN_TABLE" ? EXIT_USAGE : EXIT_FAILED;
+        }
+        target->flush();
+        err << "Exported " << written.value() << " " << commandLine.arguments[0] << "\n";
+        return EXIT_OK;
+    }
+
+    int runImport(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+                  std::ostream& out, std::ostream& err) {
+        if (commandLine.arguments.size() != 2) return EXIT_USAGE;
+        auto batchSize = commandLine.getUnsigned("batch", BulkImportOptions::DEFAULT_BATCH_SIZE);
+        auto threads = commandLine.getUnsigned("threads", 0);
+        if (!batchSize || !threads) {
+            err << (!batchSize ? batchSize.error() : threads.error()).message << "\n";
+            return EXIT_USAGE;
+        }
+        BulkImportOptions options;
+        options.batchSize = batchSize.value();
+        options.threads = threads.value();
+
+        auto context = openContext(connect, logger);
+        if (!context) {
+            err << context.error().message << "\n";
+            return EXIT_FAILED;
+        }
+
+        auto report = importFile(*context.value(), commandLine.arguments[0], commandLine.arguments[1], options);
+        if (!report) {
+            err << report.error().message << "\n";
+            return report.error().code == "UNKNOWN_TABLE" ? EXIT_USAGE : EXIT_FAILED;
+        }
+        const auto& errors = report.value().errors;
+        for (size_t i = 0; i < std::min(errors.size(), MAX_PRINTED_ROW_ERRORS); ++i) {
+            err << commandLine.arguments[1] << ":" << errors[i].line << ": " << errors[i].code << ": " << errors[i].message << "\n";
+        }
+        if (errors.size() > MAX_PRINTED_ROW_ERRORS) {
+            err << "... " << errors.size() - MAX_PRINTED_ROW_ERRORS << " more errors\n";
+        }
+        out << "imported=" << report.value().imported << " rejected=" << errors.size() << "\n";
+        return errors.empty() ? EXIT_OK : EXIT_FAILED;
+    }
+
+    int runSweep(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+                 std::ostream& out, std::ostream& err) {
+        std::time_t now = std::time(nullptr);
+        if (auto nowText = commandLine.get("now", ""); !nowText.empty()) {
+            std::tm parsed{};
+            std::istringstream stream(nowText);
+            stream >> std::get_time(&parsed, "%Y-%m-%d %H:%M");
+            if (stream.fail()) {
+                err << "Invalid value for --now, expected \"YYYY-MM-DD HH:mm\": " << nowText << "\n";
+                return EXIT_USAGE;
+            }
+            parsed.tm_isdst = -1;
+            now = std::mktime(&parsed);
+        }
+
+        auto context = openContext(connect, logger);
+        if (!context) {
+            err << context.error().message << "\n";
+            return EXIT_FAILED;
+        }
+        bool dryRun = commandLine.has("dry-run");
+        auto report = sweepStatuses(*context.value(), now, dryRun);
+        if (!report) {
+            err << report.error().message << "\n";
+            return EXIT_FAILED;
+        }
+        for (const auto& error : report.value().errors) err << error << "\n";
+        out << (dryRun ? "[dry run] " : "") << "flights_in_flight=" << report.value().flightsInFlight
+            << " flights_landed=" << report.value().flightsLanded
+            << " tickets_completed=" << report.value().ticketsCompleted
+            << " tickets_expired=" << report.value().ticketsExpired
+            << " skipped=" << report.value().skipped << "\n";
+        return report.value().errors.empty() ? EXIT_OK : EXIT_FAILED;
+    }
+
+    int runReport(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+                  std::ostream& out, std::ostream& err) {
+        Reporting::ReportOptions options;
+        for (const auto& [name, day] : {std::pair{"from", &options.fromDay}, std::pair{"to", &options.toDay}}) {
+            auto text = commandLine.get(name, "");
+            if (text.empty()) continue;
+            auto parsed = Reporting::parseDay(text);
+            if (!parsed) {
+                err << "Invalid value for --" << name << ": " << parsed.error().message << "\n";
+                return EXIT_USAGE;
+            }
+            *day = parsed.value();
+        }
+        auto threads = commandLine.getUnsigned("threads", 0);
+        auto top = commandLine.getUnsigned("top", 10);
+        if (!threads || !top) {
+            err << (!threads ? threads.error() : top.error()).message << "\n";
+            return EXIT_USAGE;
+        }
+        options.threads = threads.value();
+
+        auto context = openContext(connect, logger);
+        if (!context) {
+            err << context.error().message << "\n";
+            return EXIT_FAILED;
+        }
+        auto started = std::chrono::steady_clock::now();
+        // Tiến trình chỉ lập một báo cáo rồi thoát nên ảnh chụp không cần theo dõi Changes::Feed
+        Reporting::Snapshot snapshot(nullptr);
+        auto refreshed = refreshSnapshot(snapshot, *context.value());
+        if (!refreshed) {
+            err << refreshed.error().message << "\n";
+            return EXIT_FAILED;
+        }
+        auto loaded = std::chrono::steady_clock::now();
+        snapshot.read([&out](const Reporting::ReportColumns& columns) { summarizeOperations(columns).print(out); });
+        out << "\n";
+        snapshot.salesReport(options).print(out, top.value());
+
+        auto elapsed = [](auto from, auto to) { return std::chrono::duration<double>(to - from).count(); };
+        size_t tickets = snapshot.read([](const Reporting::ReportColumns& columns) { return columns.tickets.size(); });
+        err << "report: " << tickets << " tickets, load " << std::fixed << std::setprecision(2)
+            << elapsed(started, loaded) << "s, aggregate " << elapsed(loaded, std::chrono::steady_clock::now()) << "s\n";
+        return EXIT_OK;
+    }
+
+    int runGenerate(const CommandLine& commandLine, const ConnectionFactory& connect, std::ostream& out, std::ostream& err) {
+        auto dataset = planDataset(commandLine, err);
+        if (!dataset) {
+            err << dataset.error().message << "\n";
+            return EXIT_USAGE;
+        }
+        auto batchSize = commandLine.getUnsigned("batch", 1000);
+        if (!batchSize) {
+            err << batchSize.error().message << "\n";
+            return EXIT_USAGE;
+        }
+
+        LoadGen::DataGenerator generator(dataset.value(), batchSize.value());
+        generator.onProgress([&err](const std::string& table, size_t done, size_t total) {
+            err << "  " << table << ": " << done << " / " << total << "\n";
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        Result<LoadGen::GenerationSummary> summary = Failure<LoadGen::GenerationSummary>(CoreError("Not generated"));
+        if (auto path = commandLine.get("script", ""); !path.empty()) {
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) {
+                err << "Failed to open " << path << "\n";
+                return EXIT_FAILED;
+            }
+            LoadGen::SqlScriptSink sink(file);
+            summary = generator.generate(sink);
+        } else {
+            auto connection = connect();
+            if (!connection) {
+                err << connection.error().message << "\n";
+                return EXIT_FAILED;
+            }
+            LoadGen::ConnectionSink sink(connection.value());
+            summary = generator.generate(sink);
+        }
+        if (!summary) {
+            err << "Generation failed: " << summary.error().message << "\n";
+            return EXIT_FAILED;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const auto& rows = summary.value();
+        out << "aircraft=" << rows.aircraft << " seat_layouts=" << rows.seatLayouts
+            << " passengers=" << rows.passengers << " flights=" << rows.flights
+            << " tickets=" << rows.tickets << " seat_availability=" << rows.seatAvailability
+            << " in " << seconds << " s\n";
+        return EXIT_OK;
+    }
+
+    int runBench(const CommandLine& commandLine, const ConnectionFactory& connect, std::ostream& out, std::ostream& err) {
+        // bench phải dùng cùng tham số kích thước với lần generate để lấy mẫu đúng các khóa đã nạp
+        auto dataset = planDataset(commandLine, err);
+        if (!dataset) {
+            err << dataset.error().message << "\n";
+            return EXIT_USAGE;
+        }
+
+        LoadGen::LoadDriverConfig config;
+        auto threads = commandLine.getUnsigned("threads", config.threads);
+        auto duration = commandLine.getDouble("duration", 10.0);
+        auto operations = commandLine.getUnsigned("ops", 0);
+        if (!threads || !duration || !operations) {
+            err << (!threads ? threads.error() : !duration ? duration.error() : operations.error()).message << "\n";
+            return EXIT_USAGE;
+        }
+        config.threads = threads.value();
+        config.duration = std::chrono::milliseconds(static_cast<int64_t>(duration.value() * 1000));
+        config.operationsPerThread = operations.value();
+        if (auto mixText = commandLine.get("mix", ""); !mixText.empty()) {
+            auto mix = LoadGen::WorkloadMix::parse(mixText);
+            if (!mix) {
+                err << mix.error().message << "\n";
+                return EXIT_USAGE;
+            }
+            config.mix = mix.value();
+        }
+
+        // Mỗi luồng một session riêng: dùng chung một kết nối thì mọi luồng xếp hàng trên mutex của nó
+        // và transaction của luồng này xen vào luồng kia
+        std::vector<std::shared_ptr<IDatabaseConnection>> sessions;
+        sessions.reserve(config.threads);
+        for (size_t i = 0; i < config.threads; ++i) {
+            auto connection = connect();
+            if (!connection) {
+                err << connection.error().message << "\n";
+                return EXIT_FAILED;
+            }
+            sessions.push_back(std::move(connection.value()));
+        }
+
+        // Logger tắt để không đo thời gian ghi log; LoadDriver gọi factory tuần tự trước khi chạy
+        auto factory = [&sessions, next = size_t{0}]() mutable {
+            ApplicationContext context(sessions[next++ % sessions.size()], nullptr);
+            return LoadGen::DriverServices{context.ticketService(), context.flightService()};
+        };
+
+        auto report = LoadGen::LoadDriver(dataset.value(), factory, config).run();
+        if (!report) {
+            err << report.error().message << "\n";
+            return EXIT_FAILED;
+        }
+        report.value().print(out);
+
+        if (auto metricsPath = commandLine.get("metrics", ""); !metricsPath.empty()) {
+            auto written = Metrics::MetricsRegistry::getInstance()->writePrometheusFile(metricsPath);
+            if (!written) err << written.error().message << "\n";
+        }
+        return EXIT_OK;
+    }
+}
+
+void printUsage(std::ostream& out) {
+    out << "Usage:\n"
+        << "  airlines_cli export <aircraft|flights|passengers|tickets> [--out FILE]\n"
+        << "  airlines_cli import <aircraft|flights|passengers> FILE [--batch N] [--threads N]\n"
+        << "  airlines_cli sweep [--now \"YYYY-MM-DD HH:mm\"] [--dry-run]\n"
+        << "  airlines_cli report [--from YYYY-MM-DD] [--to YYYY-MM-DD] [--threads N] [--top N]\n"
+        << "  airlines_cli generate [--script FILE] [sizes]\n"
+        << "  airlines_cli bench [sizes] [workload]\n\n"
+        << "Connection: --host H --user U --password P --database D --port N\n"
+        << "            (defaults from AIRLINES_DB_HOST, AIRLINES_DB_USER, AIRLINES_DB_PASSWORD,\n"
+        << "             AIRLINES_DB_NAME, AIRLINES_DB_PORT)\n"
+        << "Sizes:      --aircraft N --flights N --passengers N --tickets N --skew S --seed N\n"
+        << "            --start-date YYYY-MM-DD --days N --id-offset N --batch N\n"
+        << "Workload:   --threads N --duration SECONDS --ops N-PER-THREAD\n"
+        << "            --mix book=30,cancel=10,search=50,checkin=10 --metrics FILE\n"
+        << "Logging:    --verbose --query-stats (print per-statement latency table to stderr on exit)\n"
+        << "            --slow-query-ms N --slow-query-log FILE\n"
+        << "            (defaults from AIRLINES_SLOW_QUERY_MS, AIRLINES_SLOW_QUERY_LOG)\n";
+}
+
+int run(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+        std::ostream& out, std::ostream& err) {
+    int status = EXIT_USAGE;
+    const auto& command = commandLine.command;
+    if (command == "export") {
+        status = runExport(commandLine, connect, logger, out, err);
+    } else if (command == "import") {
+        status = runImport(commandLine, connect, logger, out, err);
+    } else if (command == "sweep") {
+        status = runSweep(commandLine, connect, logger, out, err);
+    } else if (command == "report") {
+        status = runReport(commandLine, connect, logger, out, err);
+    } else if (command == "generate") {
+        status = runGenerate(commandLine, connect, out, err);
+    } else if (command == "bench") {
+        status = runBench(commandLine, connect, out, err);
+    } else {
+        err << "Unknown command: " << command << "\n";
+    }
+    if (status == EXIT_USAGE) printUsage(err);
+    return status;
+}
+
+} // namespace Cli
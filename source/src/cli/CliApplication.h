@@ -0,0 +1,49 @@
+/**
+ * @file CliApplication.h
+ * @brief Điều phối các lệnh của airlines_cli
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * airlines_cli không link wxWidgets nên chạy được trên server không có màn hình (cron,
+ * systemd timer, CI) và không tốn thời gian khởi động cũng như bộ nhớ của thư viện GUI.
+ * Các lệnh dùng chung composition root ApplicationContext với giao diện:
+ *
+ * - export <aircraft|flights|passengers|tickets> [--out FILE]
+ * - import <aircraft|flights|passengers> FILE
+ * - sweep [--now "YYYY-MM-DD HH:mm"] [--dry-run]
+ * - report
+ * - generate [--script FILE] [kích thước]   sinh dữ liệu tổng hợp (script SQL hoặc nạp trực tiếp)
+ * - bench [kích thước] [tải]                 phát tải hỗn hợp nhiều luồng, in bảng độ trễ
+ *
+ * Mã thoát: 0 thành công, 1 lỗi khi chạy (kể cả dòng nhập lỗi), 2 sai tham số.
+ */
+
+#ifndef CLI_APPLICATION_H
+#define CLI_APPLICATION_H
+
+#include "CommandLine.h"
+#include "../database/InterfaceDatabaseConnection.h"
+#include "../utils/Logger.h"
+#include <functional>
+#include <memory>
+#include <ostream>
+
+namespace Cli {
+
+/// Mở một kết nối riêng mỗi lần gọi; generate --script không gọi tới, bench gọi một lần cho mỗi luồng
+using ConnectionFactory = std::function<Result<std::shared_ptr<IDatabaseConnection>>()>;
+
+void printUsage(std::ostream& out);
+
+/**
+ * @brief Chạy một lệnh đã tách
+ * @param logger Logger cho ApplicationContext của các lệnh; bench luôn tắt log
+ * @return Mã thoát của tiến trình
+ */
+int run(const CommandLine& commandLine, const ConnectionFactory& connect, std::shared_ptr<Logger> logger,
+        std::ostream& out, std::ostream& err);
+
+} // namespace Cli
+
+#endif // CLI_APPLICATION_H
@@ -0,0 +1,80 @@
+#include "CommandLine.h"
+#include <stdexcept>
+
+namespace Cli {
+
+namespace {
+    bool isOption(const std::string& token) {
+        return token.size() > 2 && token.rfind("--", 0) == 0;
+    }
+
+    void parseFrom(int first, int argc, const char* const* argv, CommandLine& commandLine) {
+        for (int i = first; i < argc; ++i) {
+            std::string token = argv[i];
+            if (!isOption(token)) {
+                commandLine.arguments.push_back(token);
+                continue;
+            }
+            std::string name = token.substr(2);
+            if (i + 1 < argc && !isOption(argv[i + 1])) {
+                commandLine.options[name] = argv[++i];
+            } else {
+                commandLine.options[name] = "true";
+            }
+        }
+    }
+}
+
+Result<CommandLine> CommandLine::parse(int argc, const char* const* argv) {
+    if (argc < 2 || isOption(argv[1])) {
+        return Failure<CommandLine>(CoreError("Missing command", "INVALID_ARGUMENTS"));
+    }
+
+    CommandLine commandLine;
+    commandLine.command = argv[1];
+    parseFrom(2, argc, argv, commandLine);
+    return Success(commandLine);
+}
+
+Result<CommandLine> CommandLine::parseOptions(int argc, const char* const* argv) {
+    CommandLine commandLine;
+    parseFrom(1, argc, argv, commandLine);
+    if (!commandLine.arguments.empty()) {
+        return Failure<CommandLine>(CoreError("Unexpected argument: " + commandLine.arguments.front(), "INVALID_ARGUMENTS"));
+    }
+    return Success(commandLine);
+}
+
+std::string CommandLine::get(const std::string& name, const std::string& fallback) const {
+    auto it = options.find(name);
+    return it == options.end() ? fallback : it->second;
+}
+
+Result<uint64_t> CommandLine::getUnsigned(const std::string& name, uint64_t fallback) const {
+    auto it = options.find(name);
+    if (it == options.end()) return Success(fallback);
+    try {
+        size_t consumed = 0;
+        if (!it->second.empty() && it->second[0] == '-') throw std::invalid_argument("negative");
+        uint64_t value = std::stoull(it->second, &consumed);
+        if (consumed != it->second.size()) throw std::invalid_argument("trailing characters");
+        return Success(value);
+    } catch (const std::exception&) {
+        return Failure<uint64_t>(CoreError("Invalid value for --" + name + ": " + it->second, "INVALID_ARGUMENTS"));
+    }
+}
+
+Result<double> CommandLine::getDouble(const std::string& name, double fallback) const {
+    auto it = options.find(name);
+    if (it == options.end()) return Success(fallback);
+    try {
+        size_t consumed = 0;
+        double value = std::stod(it->second, &consumed);
+        if (consumed != it->second.size()) throw std::invalid_argument("trailing characters");
+        return Success(value);
+    } catch (const std::exception&) {
+        return Failure<double>(CoreError("Invalid value for --" + name + ": " + it->second, "INVALID_ARGUMENTS"));
+    }
+}
+
+} // namespace Cli
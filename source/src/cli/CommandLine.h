@@ -0,0 +1,52 @@
+/**
+ * @file CommandLine.h
+ * @brief Tách tham số dòng lệnh của airlines_cli thành lệnh, đối số vị trí và tùy chọn
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Dạng chung: airlines_cli <lệnh> [đối số...] [--tên giá-trị | --cờ]...
+ * Một tùy chọn không có giá trị đi sau (hết tham số hoặc tham số kế tiếp cũng bắt đầu bằng
+ * "--") được coi là cờ với giá trị "true".
+ */
+
+#ifndef CLI_COMMAND_LINE_H
+#define CLI_COMMAND_LINE_H
+
+#include "../core/exceptions/Result.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Cli {
+
+struct CommandLine {
+    std::string command;
+    std::vector<std::string> arguments;              ///< Đối số vị trí sau tên lệnh
+    std::map<std::string, std::string> options;      ///< Tên tùy chọn không kèm "--"
+
+    /**
+     * @return Lỗi INVALID_ARGUMENTS nếu thiếu tên lệnh
+     */
+    static Result<CommandLine> parse(int argc, const char* const* argv);
+
+    /**
+     * @brief Tách tham số của chương trình không có lệnh con (ví dụ airlines_server)
+     * @return Lỗi INVALID_ARGUMENTS nếu có đối số vị trí
+     */
+    static Result<CommandLine> parseOptions(int argc, const char* const* argv);
+
+    bool has(const std::string& name) const { return options.count(name) > 0; }
+    std::string get(const std::string& name, const std::string& fallback) const;
+
+    /**
+     * @brief Đọc tùy chọn dạng số nguyên không âm
+     * @return Lỗi INVALID_ARGUMENTS nếu giá trị không phải số
+     */
+    Result<uint64_t> getUnsigned(const std::string& name, uint64_t fallback) const;
+    Result<double> getDouble(const std::string& name, double fallback) const;
+};
+
+} // namespace Cli
+
+#endif // CLI_COMMAND_LINE_H
@@ -0,0 +1,68 @@
+#include "cli/CliApplication.h"
+#include "app/DatabaseSettings.h"
+#include "utils/Logger.h"
+#include "utils/Tracing.h"
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char **argv)
+{
+    auto commandLine = Cli::CommandLine::parse(argc, argv);
+    if (!commandLine)
+    {
+        Cli::printUsage(std::cerr);
+        return 2;
+    }
+
+    // Log thường ghi ra stdout nên mặc định chỉ giữ lỗi (ra stderr), tránh lẫn vào dữ liệu export
+    auto logger = Logger::getInstance();
+    logger->setMinLevel(commandLine.value().has("verbose") ? LogLevel::DEBUG : LogLevel::ERROR);
+
+    // AIRLINES_TRACE=<file>: ghi trace (Chrome trace-event JSON) của lần chạy khi kết thúc
+    const char *tracePath = std::getenv("AIRLINES_TRACE");
+    if (tracePath)
+    {
+        Tracing::Tracer::getInstance()->enable();
+    }
+
+    auto settings = DatabaseSettings::fromEnvironment();
+    const auto &options = commandLine.value();
+    settings.host = options.get("host", settings.host);
+    settings.user = options.get("user", settings.user);
+    settings.password = options.get("password", settings.password);
+    settings.database = options.get("database", settings.database);
+    auto port = options.getUnsigned("port", settings.port);
+    if (!port)
+    {
+        std::cerr << port.error().message << "\n";
+        return 2;
+    }
+    settings.port = static_cast<int>(port.value());
+    auto slowQueryMillis = options.getUnsigned("slow-query-ms", settings.slowQueryMillis);
+    if (!slowQueryMillis)
+    {
+        std::cerr << slowQueryMillis.error().message << "\n";
+        return 2;
+    }
+    settings.slowQueryMillis = static_cast<int>(slowQueryMillis.value());
+    settings.slowQueryLogPath = options.get("slow-query-log", settings.slowQueryLogPath);
+    configureQueryStats(settings);
+
+    int status = Cli::run(options, [&settings]() { return connectDatabaseSession(settings); }, logger, std::cout, std::cerr);
+
+    // --query-stats: bảng các câu lệnh tốn thời gian nhất của lần chạy, ra stderr để không lẫn vào dữ liệu export
+    if (options.has("query-stats"))
+    {
+        std::cerr << settings.queryStats->dump();
+    }
+
+    if (tracePath)
+    {
+        auto result = Tracing::Tracer::getInstance()->writeChromeTraceFile(tracePath);
+        if (!result)
+        {
+            logger->error(result.error().message);
+        }
+    }
+    return status;
+}
@@ -27,6 +27,15 @@ using AircraftModel = std::string; ///< Type alias cho chuỗi model máy bay
  * Bố cục chỗ ngồi định nghĩa các hạng ghế có sẵn và sức chứa của chúng.
  */
 class Aircraft : public IEntity {
+public:
+    /**
+     * @brief Các trường có thể thay đổi sau khi tạo, dùng cho theo dõi thay đổi
+     */
+    enum Field : unsigned int {
+        FIELD_MODEL       = 1u << 0,  ///< Cột model
+        FIELD_SEAT_LAYOUT = 1u << 1   ///< Các cột economy_seats, business_seats, first_seats
+    };
+
 protected:
     AircraftSerial _serial;    ///< Số serial máy bay duy nhất
     AircraftModel _model;      ///< Model/kiểu máy bay (ví dụ: "Boeing 737", "Airbus A320")
@@ -123,13 +132,19 @@ public:
      * @brief Cập nhật model máy bay
      * @param model Chuỗi model máy bay mới
      */
-    void setModel(const std::string& model) { _model = model; }
+    void setModel(const std::string& model) {
+        _model = model;
+        markDirty(FIELD_MODEL);
+    }
 
     /**
      * @brief Cập nhật cấu hình bố cục chỗ ngồi
      * @param seatLayout Cấu hình bố cục chỗ ngồi mới
      */
-    void setSeatLayout(const SeatClassMap& seatLayout) { _seatLayout = seatLayout; }
+    void setSeatLayout(const SeatClassMap& seatLayout) {
+        _seatLayout = seatLayout;
+        markDirty(FIELD_SEAT_LAYOUT);
+    }
 
     /**
      * @brief Lấy biểu diễn chuỗi của máy bay
@@ -161,6 +176,7 @@ public:
     std::unique_ptr<IEntity> clone() const override {
         auto clone = std::unique_ptr<Aircraft>(new Aircraft(_serial, _model, _seatLayout));
         clone->_id = _id;
+        clone->_version = _version;
         return clone;
     }
 
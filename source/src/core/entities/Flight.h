@@ -36,6 +36,17 @@
  */
 class Flight : public IEntity
 {
+public:
+    /**
+     * @brief Các trường có thể thay đổi sau khi tạo, dùng cho theo dõi thay đổi
+     */
+    enum Field : unsigned int
+    {
+        FIELD_STATUS = 1u << 0,   ///< Cột status
+        FIELD_SCHEDULE = 1u << 1, ///< Cột departure_time và arrival_time
+        FIELD_AIRCRAFT = 1u << 2  ///< Cột aircraft_id
+    };
+
 protected:
     FlightNumber _flightNumber;                             ///< Định danh chuyến bay duy nhất (ví dụ: "AA123")
     Route _route;                                           ///< Thông tin sân bay xuất phát và đích
@@ -167,6 +178,7 @@ public:
     void setStatus(FlightStatus status)
     {
         _status = status;
+        markDirty(FIELD_STATUS);
     }
 
     /**
@@ -230,6 +242,7 @@ public:
     void setSchedule(const Schedule &schedule)
     {
         _schedule = schedule;
+        markDirty(FIELD_SCHEDULE);
     }
 
     /**
@@ -239,6 +252,7 @@ public:
     void setAircraft(std::shared_ptr<Aircraft> aircraft)
     {
         _aircraft = aircraft;
+        markDirty(FIELD_AIRCRAFT);
     }
 
     /**
@@ -277,6 +291,7 @@ public:
     {
         auto clone = std::unique_ptr<Flight>(new Flight(_flightNumber, _route, _schedule, _aircraft));
         clone->_id = _id;
+        clone->_version = _version;
         clone->_status = _status;
         clone->_seatAvailability = _seatAvailability;
         return clone;
@@ -20,12 +20,27 @@
  * 
  * Tất cả các thực thể được mong đợi là các value object bất biến với phương thức factory
  * để tạo và hỗ trợ nhân bản để sao chép an toàn.
+ * 
+ * Các setter của lớp dẫn xuất đánh dấu trường đã thay đổi để repository chỉ ghi
+ * những cột thực sự thay đổi. Thực thể mới tạo được coi là thay đổi toàn bộ
+ * (ALL_FIELDS); repository gọi clearDirty() sau khi nạp hoặc ghi xuống cơ sở dữ liệu,
+ * từ đó chỉ các setter được gọi sau đó mới bị đánh dấu.
  */
 class IEntity {
 protected:
     int _id;  ///< Định danh duy nhất được tạo bởi cơ sở dữ liệu
+    unsigned int _dirtyFields;  ///< Bit mask các trường đã thay đổi kể từ lần đồng bộ gần nhất với cơ sở dữ liệu
+    int _version;  ///< Phiên bản bản ghi đọc từ cơ sở dữ liệu, dùng cho kiểm soát đồng thời lạc quan
+
+    /**
+     * @brief Đánh dấu một hoặc nhiều trường đã thay đổi
+     * @param fields Bit mask trường do lớp dẫn xuất định nghĩa (enum Field)
+     */
+    void markDirty(unsigned int fields) { _dirtyFields |= fields; }
 
 public:
+    static constexpr unsigned int ALL_FIELDS = ~0u; ///< Mọi trường (thực thể chưa đồng bộ với cơ sở dữ liệu)
+
     /**
      * @brief Destructor ảo để dọn dẹp đúng cách các lớp dẫn xuất
      */
@@ -68,12 +83,54 @@ public:
      */
     virtual void setId(int id) = 0;
 
+    /**
+     * @brief Lấy phiên bản bản ghi tại thời điểm nạp hoặc ghi gần nhất
+     * @return Giá trị cột version (0 với bản ghi mới hoặc bảng không có cột version)
+     */
+    int getVersion() const { return _version; }
+
+    /**
+     * @brief Đặt phiên bản bản ghi (repository gọi sau khi nạp hoặc cập nhật)
+     * @param version Giá trị cột version
+     */
+    void setVersion(int version) { _version = version; }
+
+    /**
+     * @brief Kiểm tra thực thể có trường nào đã thay đổi chưa được lưu
+     * @return true nếu có ít nhất một trường đã thay đổi
+     */
+    bool isDirty() const { return _dirtyFields != 0; }
+
+    /**
+     * @brief Kiểm tra một trường cụ thể đã thay đổi hay chưa
+     * @param field Bit của trường cần kiểm tra
+     * @return true nếu trường đã thay đổi
+     */
+    bool isFieldDirty(unsigned int field) const { return (_dirtyFields & field) != 0; }
+
+    /**
+     * @brief Lấy bit mask các trường đã thay đổi
+     * @return Bit mask trường, repository dùng để sinh câu lệnh UPDATE tối thiểu
+     */
+    unsigned int getDirtyFields() const { return _dirtyFields; }
+
+    /**
+     * @brief Kiểm tra có thể cập nhật từng phần hay không
+     * @return true nếu chỉ một số trường đã biết thay đổi (thực thể đã đồng bộ trước đó)
+     */
+    bool hasPartialChanges() const { return _dirtyFields != 0 && _dirtyFields != ALL_FIELDS; }
+
+    /**
+     * @brief Xóa trạng thái thay đổi (gọi sau khi nạp từ hoặc ghi xuống cơ sở dữ liệu)
+     */
+    void clearDirty() { _dirtyFields = 0; }
+
 protected:
     /**
-     * @brief Constructor được bảo vệ khởi tạo ID thành 0
+     * @brief Constructor được bảo vệ khởi tạo ID thành 0 và đánh dấu mọi trường thay đổi
      * Chỉ các lớp dẫn xuất mới có thể tạo instance
      */
-    IEntity() : _id(0) {}
+    IEntity() : _id(0), _dirtyFields(ALL_FIELDS), _version(0) {}
 };
 
 using EntityPtr = std::unique_ptr<IEntity>; ///< Type alias cho unique pointer thực thể
@@ -26,6 +26,14 @@ using Name = std::string; ///< Type alias cho chuỗi tên hành khách
  * Số hộ chiếu phục vụ như định danh nghiệp vụ duy nhất cho hành khách.
  */
 class Passenger : public IEntity {
+public:
+    /**
+     * @brief Các trường có thể thay đổi sau khi tạo, dùng cho theo dõi thay đổi
+     */
+    enum Field : unsigned int {
+        FIELD_NAME = 1u << 0  ///< Cột name
+    };
+
 protected:
     Name _name;                ///< Họ tên đầy đủ của hành khách
     ContactInfo _contactInfo;  ///< Thông tin liên lạc (email, điện thoại, v.v.)
@@ -112,6 +120,7 @@ public:
      */
     void setName(const std::string& name) {
         _name = name;
+        markDirty(FIELD_NAME);
     }
 
     /**
@@ -144,6 +153,7 @@ public:
     std::unique_ptr<IEntity> clone() const override {
         auto clone = std::unique_ptr<Passenger>(new Passenger(_name, _contactInfo, _passport));
         clone->_id = _id;
+        clone->_version = _version;
         return clone;
     }
 
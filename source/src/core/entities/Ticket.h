@@ -33,6 +33,15 @@
  * trạng thái chuyến bay và vé hiện tại.
  */
 class Ticket : public IEntity {
+public:
+    /**
+     * @brief Các trường có thể thay đổi sau khi tạo, dùng cho theo dõi thay đổi
+     */
+    enum Field : unsigned int {
+        FIELD_STATUS = 1u << 0,  ///< Cột status
+        FIELD_PRICE  = 1u << 1   ///< Cột price và currency
+    };
+
 protected:
     TicketNumber _ticketNumber;              ///< Định danh vé duy nhất
     std::shared_ptr<Passenger> _passenger;   ///< Hành khách sở hữu vé này
@@ -125,6 +134,7 @@ public:
      */
     void setStatus(TicketStatus status) {
         _status = status;
+        markDirty(FIELD_STATUS);
     }
 
     /**
@@ -208,6 +218,7 @@ public:
     std::unique_ptr<IEntity> clone() const override {
         auto clone = std::unique_ptr<Ticket>(new Ticket(_ticketNumber, _passenger, _flight, _seatNumber, _price));
         clone->_id = _id;
+        clone->_version = _version;
         clone->_status = _status;
         return clone;
     }
@@ -246,7 +257,10 @@ public:
      * @brief Cập nhật giá vé
      * @param price Thông tin giá mới
      */
-    void setPrice(const Price& price) { _price = price; }
+    void setPrice(const Price& price) {
+        _price = price;
+        markDirty(FIELD_PRICE);
+    }
 
     /**
      * @brief Kiểm tra xem vé có thể bị hủy không
@@ -0,0 +1,94 @@
+#include "ConnectionPool.h"
+#include "../utils/Metrics.h"
+
+namespace {
+    Metrics::Histogram& waitHistogram() {
+        static Metrics::Histogram& histogram = Metrics::MetricsRegistry::getInstance()->histogram(
+            "airlines_db_pool_wait_seconds", "Time spent waiting for a pooled database connection");
+        return histogram;
+    }
+
+    Metrics::Gauge& inUseGauge() {
+        static Metrics::Gauge& gauge = Metrics::MetricsRegistry::getInstance()->gauge(
+            "airlines_db_pool_in_use", "Pooled database connections currently leased");
+        return gauge;
+    }
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (_pool && _connection) _pool->release(std::move(_connection));
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (_pool && _connection) _pool->release(std::move(_connection));
+        _pool = std::move(other._pool);
+        _connection = std::move(other._connection);
+    }
+    return *this;
+}
+
+Result<std::shared_ptr<ConnectionPool>> ConnectionPool::create(ConnectionFactory factory, size_t size) {
+    if (size == 0) {
+        return Failure<std::shared_ptr<ConnectionPool>>(CoreError("Connection pool size must be positive", "INVALID_POOL_SIZE"));
+    }
+
+    auto pool = std::shared_ptr<ConnectionPool>(new ConnectionPool(std::move(factory), size));
+    for (size_t i = 0; i < size; ++i) {
+        auto connection = pool->_factory();
+        if (!connection) return Failure<std::shared_ptr<ConnectionPool>>(connection.error());
+        pool->_idle.push_back(std::move(connection.value()));
+        ++pool->_open;
+    }
+    return Success(pool);
+}
+
+Result<ConnectionPool::Lease> ConnectionPool::acquire(std::chrono::milliseconds timeout) {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_available.wait_for(lock, timeout, [this] { return !_idle.empty() || _open < _size; })) {
+        waitHistogram().observe(std::chrono::steady_clock::now() - start);
+        return Failure<Lease>(CoreError("Timed out waiting for a database connection", "POOL_TIMEOUT"));
+    }
+
+    std::shared_ptr<IDatabaseConnection> connection;
+    if (!_idle.empty()) {
+        connection = std::move(_idle.back());
+        _idle.pop_back();
+    } else {
+        // Chỗ trống do kết nối hỏng để lại: mở kết nối mới ngoài khóa để không chặn các lượt trả
+        ++_open;
+        lock.unlock();
+        auto opened = _factory();
+        if (!opened) {
+            lock.lock();
+            --_open;
+            _available.notify_one();
+            return Failure<Lease>(opened.error());
+        }
+        connection = std::move(opened.value());
+    }
+
+    waitHistogram().observe(std::chrono::steady_clock::now() - start);
+    inUseGauge().inc();
+    return Success(Lease(shared_from_this(), std::move(connection)));
+}
+
+void ConnectionPool::release(std::shared_ptr<IDatabaseConnection> connection) {
+    inUseGauge().dec();
+    auto connected = connection->isConnected();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (connected && connected.value()) {
+            _idle.push_back(std::move(connection));
+        } else {
+            --_open;
+        }
+    }
+    _available.notify_one();
+}
+
+size_t ConnectionPool::idle() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _idle.size();
+}
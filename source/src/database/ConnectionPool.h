@@ -0,0 +1,85 @@
+/**
+ * @file ConnectionPool.h
+ * @brief Tập kết nối cơ sở dữ liệu có giới hạn, cho mượn theo kiểu RAII
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * MySQLXConnection::getInstance() chỉ có một session và một mutex, nên mọi luồng trong cùng
+ * tiến trình xếp hàng trên session đó. ConnectionPool giữ tối đa size kết nối độc lập (mỗi
+ * kết nối một session, ví dụ từ MySQLXConnection::createSession()) và cho mượn từng kết nối
+ * qua Lease: một lượt mượn dùng kết nối riêng từ đầu đến cuối nên transaction của nó không bị
+ * xen với luồng khác.
+ *
+ * Kết nối được mở sẵn khi tạo pool. Khi trả về, kết nối báo isConnected() == false bị bỏ đi và
+ * lượt mượn sau sẽ mở kết nối mới bằng factory. Thời gian chờ mượn và số kết nối đang được mượn
+ * được ghi vào MetricsRegistry (airlines_db_pool_wait_seconds, airlines_db_pool_in_use).
+ */
+
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include "InterfaceDatabaseConnection.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
+public:
+    using ConnectionFactory = std::function<Result<std::shared_ptr<IDatabaseConnection>>()>;
+
+    /**
+     * @brief Kết nối đang được mượn; tự trả về pool khi hủy
+     */
+    class Lease {
+    private:
+        std::shared_ptr<ConnectionPool> _pool;
+        std::shared_ptr<IDatabaseConnection> _connection;
+
+    public:
+        Lease(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<IDatabaseConnection> connection)
+            : _pool(std::move(pool)), _connection(std::move(connection)) {}
+        ~Lease();
+
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        const std::shared_ptr<IDatabaseConnection>& connection() const { return _connection; }
+        IDatabaseConnection* operator->() const { return _connection.get(); }
+    };
+
+private:
+    ConnectionFactory _factory;
+    size_t _size;
+    size_t _open = 0;                                           ///< Số kết nối đang tồn tại (rảnh + đang mượn)
+    std::vector<std::shared_ptr<IDatabaseConnection>> _idle;
+    mutable std::mutex _mutex;
+    std::condition_variable _available;
+
+    ConnectionPool(ConnectionFactory factory, size_t size) : _factory(std::move(factory)), _size(size) {}
+
+    void release(std::shared_ptr<IDatabaseConnection> connection);
+
+public:
+    /**
+     * @brief Tạo pool và mở sẵn size kết nối
+     * @return Lỗi INVALID_POOL_SIZE nếu size bằng 0, hoặc lỗi của factory khi mở kết nối
+     */
+    static Result<std::shared_ptr<ConnectionPool>> create(ConnectionFactory factory, size_t size);
+
+    /**
+     * @brief Mượn một kết nối, chờ tối đa timeout nếu tất cả đang bận
+     * @return Lỗi POOL_TIMEOUT nếu hết thời gian chờ, hoặc lỗi của factory khi phải mở lại kết nối
+     */
+    Result<Lease> acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(5000));
+
+    size_t size() const { return _size; }
+    size_t idle() const;
+};
+
+#endif // CONNECTION_POOL_H
@@ -0,0 +1,356 @@
+#include "InMemoryConnection.h"
+#include "../utils/Tracing.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// === InMemoryResult ===
+
+InMemoryResult::InMemoryResult(std::shared_ptr<const std::vector<std::string>> columns,
+                               std::vector<std::vector<InMemory::Value>> rows)
+    : _columns(std::move(columns)), _rows(std::move(rows)) {}
+
+Result<bool> InMemoryResult::next() {
+    if (_started && _cursor < _rows.size()) {
+        ++_cursor;
+    }
+    _started = true;
+    return Success(_cursor < _rows.size());
+}
+
+Result<const InMemory::Value*> InMemoryResult::cell(const int& columnIndex) const {
+    if (!_started || _cursor >= _rows.size()) {
+        return Failure<const InMemory::Value*>(CoreError("No current row available"));
+    }
+    const auto& row = _rows[_cursor];
+    if (columnIndex < 0 || columnIndex >= static_cast<int>(row.size())) {
+        return Failure<const InMemory::Value*>(CoreError("Column index out of range"));
+    }
+    return Success(&row[columnIndex]);
+}
+
+int InMemoryResult::indexOf(const std::string& columnName) const {
+    if (!_columns) return -1;
+    auto it = std::find(_columns->begin(), _columns->end(), columnName);
+    return it == _columns->end() ? -1 : static_cast<int>(std::distance(_columns->begin(), it));
+}
+
+Result<std::string> InMemoryResult::getString(const int& columnIndex) {
+    auto value = cell(columnIndex);
+    if (!value) return Failure<std::string>(value.error());
+    return Success(InMemory::toString(*value.value()));
+}
+
+Result<int> InMemoryResult::getInt(const int& columnIndex) {
+    auto value = cell(columnIndex);
+    if (!value) return Failure<int>(value.error());
+    auto converted = InMemory::coerce(*value.value(), InMemory::ColumnType::INT);
+    auto number = std::get_if<int64_t>(&converted);
+    if (!number) return Failure<int>(CoreError("Error getting integer data: value is not an integer"));
+    return Success(static_cast<int>(*number));
+}
+
+Result<double> InMemoryResult::getDouble(const int& columnIndex) {
+    auto value = cell(columnIndex);
+    if (!value) return Failure<double>(value.error());
+    auto converted = InMemory::coerce(*value.value(), InMemory::ColumnType::DOUBLE);
+    auto number = std::get_if<double>(&converted);
+    if (!number) return Failure<double>(CoreError("Error getting double data: value is not a number"));
+    return Success(*number);
+}
+
+Result<std::tm> InMemoryResult::getDateTime(const int& columnIndex) {
+    auto value = cell(columnIndex);
+    if (!value) return Failure<std::tm>(value.error());
+
+    auto text = InMemory::toString(InMemory::coerce(*value.value(), InMemory::ColumnType::DATETIME));
+    std::tm tm{};
+    std::istringstream ss(text);
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) {
+        return Failure<std::tm>(CoreError("Error getting datetime data: invalid value '" + text + "'"));
+    }
+    // Chuẩn hóa giống MySQLXResult (tm_wday, tm_yday, tm_isdst)
+    if (std::mktime(&tm) == -1) {
+        return Failure<std::tm>(CoreError("Invalid datetime components"));
+    }
+    return Success(tm);
+}
+
+Result<std::string> InMemoryResult::getString(const std::string& columnName) {
+    int index = indexOf(columnName);
+    if (index < 0) return Failure<std::string>(CoreError("Column '" + columnName + "' not found"));
+    return getString(index);
+}
+
+Result<int> InMemoryResult::getInt(const std::string& columnName) {
+    int index = indexOf(columnName);
+    if (index < 0) return Failure<int>(CoreError("Column '" + columnName + "' not found"));
+    return getInt(index);
+}
+
+Result<double> InMemoryResult::getDouble(const std::string& columnName) {
+    int index = indexOf(columnName);
+    if (index < 0) return Failure<double>(CoreError("Column '" + columnName + "' not found"));
+    return getDouble(index);
+}
+
+Result<std::tm> InMemoryResult::getDateTime(const std::string& columnName) {
+    int index = indexOf(columnName);
+    if (index < 0) return Failure<std::tm>(CoreError("Column '" + columnName + "' not found"));
+    return getDateTime(index);
+}
+
+// === InMemoryConnection ===
+
+InMemoryConnection::InMemoryConnection(std::shared_ptr<InMemory::Database> database)
+    : _database(database ? std::move(database) : InMemory::Database::createAirlinesSchema()) {}
+
+InMemoryConnection::~InMemoryConnection() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_inTransaction) finishTransaction(true);
+}
+
+Result<std::shared_ptr<const InMemory::Statement>> InMemoryConnection::parseCached(const std::string& query) {
+    auto it = _parsed.find(query);
+    if (it != _parsed.end()) {
+        return Success(it->second);
+    }
+    auto parsed = InMemory::parse(query);
+    if (!parsed) {
+        _lastError = parsed.error().message;
+        return parsed;
+    }
+    _parsed.emplace(query, parsed.value());
+    return parsed;
+}
+
+Result<InMemory::ExecutionResult> InMemoryConnection::run(const InMemory::Statement& statement,
+                                                          const std::vector<InMemory::Value>& params) {
+    if (!_connected) {
+        _lastError = "Not connected to database";
+        return Failure<InMemory::ExecutionResult>(CoreError("Not connected to database"));
+    }
+    auto databaseLock = _database->lockFor(this);
+    if (!databaseLock) {
+        _lastError = databaseLock.error().message;
+        return Failure<InMemory::ExecutionResult>(databaseLock.error());
+    }
+    auto result = InMemory::execute(*_database, statement, params, _inTransaction ? &_undo : nullptr);
+    if (!result) {
+        _lastError = result.error().message;
+        return result;
+    }
+    if (result.value().lastInsertId > 0) {
+        _lastInsertId = static_cast<int>(result.value().lastInsertId);
+    }
+    return result;
+}
+
+VoidResult InMemoryConnection::finishTransaction(bool rollback) {
+    // Phiên này đang giữ transaction nên lock() không phải chờ ai
+    auto databaseLock = _database->lock();
+    VoidResult result = Success();
+    if (rollback) {
+        result = _undo.rollbackTo();
+    } else {
+        _undo.clear();
+    }
+    _inTransaction = false;
+    _database->endTransaction(this);
+    if (!result) _lastError = result.error().message;
+    return result;
+}
+
+Result<bool> InMemoryConnection::connect(const std::string&, const std::string&, const std::string&,
+                                         const std::string&, const int&) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connected = true;
+    return Success(true);
+}
+
+VoidResult InMemoryConnection::disconnect() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connected = false;
+    _statements.clear();
+    // Như MySQL: đóng kết nối khi transaction còn mở thì hủy transaction
+    if (_inTransaction) {
+        return finishTransaction(true);
+    }
+    return Success();
+}
+
+Result<bool> InMemoryConnection::execute(const std::string& query) {
+    Tracing::Span span("sql.execute", "sql");
+    if (span.isActive()) span.setArg("sql", query);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto statement = parseCached(query);
+    if (!statement) return Failure<bool>(statement.error());
+    auto result = run(*statement.value(), {});
+    if (!result) return Failure<bool>(result.error());
+    return Success(true);
+}
+
+Result<std::unique_ptr<IDatabaseResult>> InMemoryConnection::executeQuery(const std::string& query) {
+    Tracing::Span span("sql.query", "sql");
+    if (span.isActive()) span.setArg("sql", query);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto statement = parseCached(query);
+    if (!statement) return Failure<std::unique_ptr<IDatabaseResult>>(statement.error());
+    auto result = run(*statement.value(), {});
+    if (!result) return Failure<std::unique_ptr<IDatabaseResult>>(result.error());
+    return Success<std::unique_ptr<IDatabaseResult>>(
+        std::make_unique<InMemoryResult>(std::move(result.value().columns), std::move(result.value().rows)));
+}
+
+Result<int> InMemoryConnection::prepareStatement(const std::string& query) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto statement = parseCached(query);
+    if (!statement) return Failure<int>(statement.error());
+
+    int id = _nextStatementId++;
+    PreparedStatement prepared{statement.value(), {}, query};
+    prepared.params.resize(InMemory::parameterCount(*prepared.statement));
+    _statements.emplace(id, std::move(prepared));
+    return Success(id);
+}
+
+VoidResult InMemoryConnection::bind(const int& statementId, const int& paramIndex, InMemory::Value value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _statements.find(statementId);
+    if (it == _statements.end()) {
+        _lastError = "Invalid statement ID";
+        return Failure(CoreError("Invalid statement ID"));
+    }
+    auto& params = it->second.params;
+    if (paramIndex < 1 || paramIndex > static_cast<int>(params.size())) {
+        _lastError = "Parameter index out of range";
+        return Failure(CoreError("Parameter index out of range", "PARAM_FAILED"));
+    }
+    params[paramIndex - 1] = std::move(value);
+    return Success();
+}
+
+VoidResult InMemoryConnection::setString(const int& statementId, const int& paramIndex, const std::string& value) {
+    return bind(statementId, paramIndex, value);
+}
+
+VoidResult InMemoryConnection::setInt(const int& statementId, const int& paramIndex, const int& value) {
+    return bind(statementId, paramIndex, static_cast<int64_t>(value));
+}
+
+VoidResult InMemoryConnection::setDouble(const int& statementId, const int& paramIndex, const double& value) {
+    return bind(statementId, paramIndex, value);
+}
+
+VoidResult InMemoryConnection::setDateTime(const int& statementId, const int& paramIndex, const std::tm& value) {
+    std::ostringstream oss;
+    oss << std::put_time(&value, "%Y-%m-%d %H:%M:%S");
+    return bind(statementId, paramIndex, oss.str());
+}
+
+Result<bool> InMemoryConnection::executeStatement(const int& statementId) {
+    auto result = executeUpdate(statementId);
+    if (!result) return Failure<bool>(result.error());
+    return Success(true);
+}
+
+Result<int> InMemoryConnection::executeUpdate(const int& statementId) {
+    Tracing::Span span("sql.execute", "sql");
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _statements.find(statementId);
+    if (it == _statements.end()) {
+        _lastError = "Invalid statement ID";
+        return Failure<int>(CoreError("Invalid statement ID"));
+    }
+    if (span.isActive()) span.setArg("sql", it->second.query);
+    auto result = run(*it->second.statement, it->second.params);
+    if (!result) return Failure<int>(result.error());
+    return Success(static_cast<int>(result.value().affectedRows));
+}
+
+Result<std::unique_ptr<IDatabaseResult>> InMemoryConnection::executeQueryStatement(const int& statementId) {
+    Tracing::Span span("sql.query", "sql");
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _statements.find(statementId);
+    if (it == _statements.end()) {
+        _lastError = "Invalid statement ID";
+        return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("Invalid statement ID"));
+    }
+    if (span.isActive()) span.setArg("sql", it->second.query);
+    auto result = run(*it->second.statement, it->second.params);
+    if (!result) return Failure<std::unique_ptr<IDatabaseResult>>(result.error());
+    return Success<std::unique_ptr<IDatabaseResult>>(
+        std::make_unique<InMemoryResult>(std::move(result.value().columns), std::move(result.value().rows)));
+}
+
+VoidResult InMemoryConnection::freeStatement(const int& statementId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_statements.erase(statementId) == 0) {
+        _lastError = "Invalid statement ID";
+        return Failure(CoreError("Invalid statement ID"));
+    }
+    return Success();
+}
+
+Result<int> InMemoryConnection::getLastInsertId() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_lastInsertId == 0) {
+        return Failure<int>(CoreError("No last insert ID available"));
+    }
+    return Success(_lastInsertId);
+}
+
+Result<bool> InMemoryConnection::isConnected() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Success(_connected);
+}
+
+Result<std::string> InMemoryConnection::getLastError() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Success(_lastError);
+}
+
+Result<bool> InMemoryConnection::beginTransaction() {
+    Tracing::Span span("sql.begin", "sql");
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_connected) {
+        _lastError = "Not connected to database";
+        return Failure<bool>(CoreError("Not connected to database"));
+    }
+    if (_inTransaction) {
+        _lastError = "Transaction already active";
+        return Failure<bool>(CoreError("Transaction already active"));
+    }
+    auto databaseLock = _database->lockFor(this);
+    if (!databaseLock) {
+        _lastError = databaseLock.error().message;
+        return Failure<bool>(databaseLock.error());
+    }
+    _database->beginTransaction(this);
+    _inTransaction = true;
+    return Success(true);
+}
+
+Result<bool> InMemoryConnection::commitTransaction() {
+    Tracing::Span span("sql.commit", "sql");
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_inTransaction) {
+        _lastError = "No active transaction";
+        return Failure<bool>(CoreError("No active transaction"));
+    }
+    finishTransaction(false);
+    return Success(true);
+}
+
+Result<bool> InMemoryConnection::rollbackTransaction() {
+    Tracing::Span span("sql.rollback", "sql");
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_inTransaction) {
+        _lastError = "No active transaction";
+        return Failure<bool>(CoreError("No active transaction"));
+    }
+    auto rolledBack = finishTransaction(true);
+    if (!rolledBack) return Failure<bool>(rolledBack.error());
+    return Success(true);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file InMemoryConnection.h
+ * @brief Triển khai IDatabaseConnection chạy hoàn toàn trong tiến trình
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * InMemoryConnection thực thi đúng các câu SQL mà repository sinh ra trên InMemory::Database,
+ * không cần MySQL server. Dùng cho benchmark và kiểm thử tải: repository, service và mã ánh xạ
+ * chạy như thật, còn chi phí mạng và server được loại bỏ.
+ *
+ * Đặc điểm:
+ * - Câu SQL được phân tích một lần và lưu cache theo chuỗi; prepared statement chỉ giữ tham số
+ * - Tra cứu bằng chỉ mục băm/có thứ tự thay vì quét toàn bảng
+ * - Transaction dựa trên nhật ký hoàn tác và được tuần tự hóa: trong lúc một kết nối mở transaction,
+ *   câu lệnh của kết nối khác trên cùng Database chờ tới khi transaction kết thúc
+ * - Thread-safe: trạng thái kết nối có mutex riêng, mỗi câu lệnh giữ khóa của InMemory::Database
+ */
+
+#ifndef IN_MEMORY_CONNECTION_H
+#define IN_MEMORY_CONNECTION_H
+
+#include "InterfaceDatabaseConnection.h"
+#include "InMemoryEngine.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Tập kết quả của InMemoryConnection
+ *
+ * Giữ bản sao các hàng đã chiếu nên vẫn hợp lệ khi dữ liệu gốc thay đổi.
+ */
+class InMemoryResult : public IDatabaseResult {
+private:
+    std::shared_ptr<const std::vector<std::string>> _columns;
+    std::vector<std::vector<InMemory::Value>> _rows;
+    size_t _cursor = 0;
+    bool _started = false;
+
+    Result<const InMemory::Value*> cell(const int& columnIndex) const;
+    int indexOf(const std::string& columnName) const;
+
+public:
+    InMemoryResult(std::shared_ptr<const std::vector<std::string>> columns,
+                   std::vector<std::vector<InMemory::Value>> rows);
+
+    Result<bool> next() override;
+
+    Result<std::string> getString(const int& columnIndex) override;
+    Result<int> getInt(const int& columnIndex) override;
+    Result<double> getDouble(const int& columnIndex) override;
+    Result<std::tm> getDateTime(const int& columnIndex) override;
+
+    Result<std::string> getString(const std::string& columnName) override;
+    Result<int> getInt(const std::string& columnName) override;
+    Result<double> getDouble(const std::string& columnName) override;
+    Result<std::tm> getDateTime(const std::string& columnName) override;
+};
+
+/**
+ * @brief Kết nối tới cơ sở dữ liệu trong bộ nhớ
+ *
+ * Nhiều kết nối có thể dùng chung một InMemory::Database; từng câu lệnh được tuần tự hóa bằng
+ * khóa của Database. Mỗi Database chỉ có một transaction mở tại một thời điểm: kết nối khác chờ
+ * (tối đa Database::DEFAULT_LOCK_WAIT_TIMEOUT, lỗi LOCK_WAIT_TIMEOUT) nên không thấy thay đổi
+ * chưa commit và không ghi xen vào giữa transaction. Vì vậy không được chờ kết nối khác trên cùng
+ * Database khi đang giữ transaction mở, kể cả trong cùng một luồng.
+ */
+class InMemoryConnection : public IDatabaseConnection {
+private:
+    struct PreparedStatement {
+        std::shared_ptr<const InMemory::Statement> statement;
+        std::vector<InMemory::Value> params;  ///< Tham số theo chỉ số 0-based (API dùng 1-based)
+        std::string query;                    ///< Văn bản gốc, dùng cho span tracing
+    };
+
+    std::shared_ptr<InMemory::Database> _database;
+    InMemory::UndoLog _undo;                        ///< Thay đổi của transaction đang mở
+    bool _inTransaction = false;
+    std::unordered_map<std::string, std::shared_ptr<const InMemory::Statement>> _parsed;
+    std::unordered_map<int, PreparedStatement> _statements;
+    int _nextStatementId = 1;
+    int _lastInsertId = 0;
+    bool _connected = true;
+    std::string _lastError;
+    mutable std::mutex _mutex;
+
+    Result<std::shared_ptr<const InMemory::Statement>> parseCached(const std::string& query);
+    Result<InMemory::ExecutionResult> run(const InMemory::Statement& statement, const std::vector<InMemory::Value>& params);
+    VoidResult bind(const int& statementId, const int& paramIndex, InMemory::Value value);
+    VoidResult finishTransaction(bool rollback);    ///< Commit hoặc rollback rồi nhả transaction; gọi khi giữ _mutex
+
+public:
+    /**
+     * @brief Constructor
+     * @param database Cơ sở dữ liệu dùng chung; mặc định là lược đồ hãng bay rỗng
+     */
+    explicit InMemoryConnection(std::shared_ptr<InMemory::Database> database = InMemory::Database::createAirlinesSchema());
+
+    /**
+     * @brief Destructor, hủy transaction còn mở để kết nối khác không phải chờ
+     */
+    ~InMemoryConnection() override;
+
+    InMemoryConnection(const InMemoryConnection&) = delete;
+    InMemoryConnection& operator=(const InMemoryConnection&) = delete;
+
+    /**
+     * @brief Cơ sở dữ liệu bên dưới, dùng để nạp dữ liệu mẫu trực tiếp
+     */
+    std::shared_ptr<InMemory::Database> getDatabase() const { return _database; }
+
+    Result<bool> connect(const std::string& host, const std::string& user,
+                         const std::string& password, const std::string& database,
+                         const int& port = 33060) override;
+    VoidResult disconnect() override;
+
+    Result<bool> execute(const std::string& query) override;
+    Result<std::unique_ptr<IDatabaseResult>> executeQuery(const std::string& query) override;
+
+    Result<int> prepareStatement(const std::string& query) override;
+    VoidResult setString(const int& statementId, const int& paramIndex, const std::string& value) override;
+    VoidResult setInt(const int& statementId, const int& paramIndex, const int& value) override;
+    VoidResult setDouble(const int& statementId, const int& paramIndex, const double& value) override;
+    VoidResult setDateTime(const int& statementId, const int& paramIndex, const std::tm& value) override;
+    Result<bool> executeStatement(const int& statementId) override;
+    Result<int> executeUpdate(const int& statementId) override;
+    Result<std::unique_ptr<IDatabaseResult>> executeQueryStatement(const int& statementId) override;
+    VoidResult freeStatement(const int& statementId) override;
+
+    Result<int> getLastInsertId() override;
+    Result<bool> isConnected() const override;
+    Result<std::string> getLastError() const override;
+
+    Result<bool> beginTransaction() override;
+    Result<bool> commitTransaction() override;
+    Result<bool> rollbackTransaction() override;
+};
+
+#endif // IN_MEMORY_CONNECTION_H
@@ -0,0 +1,1646 @@
+#include "InMemoryEngine.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+namespace InMemory {
+
+// === Giá trị ===
+
+namespace {
+    bool isNull(const Value& value) {
+        return std::holds_alternative<std::monostate>(value);
+    }
+
+    bool parseInt(const std::string& text, int64_t& out) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        long long parsed = std::strtoll(text.c_str(), &end, 10);
+        if (*end != '\0') return false;
+        out = parsed;
+        return true;
+    }
+
+    bool parseDouble(const std::string& text, double& out) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        double parsed = std::strtod(text.c_str(), &end);
+        if (*end != '\0') return false;
+        out = parsed;
+        return true;
+    }
+
+    /// Lấy giá trị số nếu có thể (kể cả chuỗi chứa số)
+    bool asNumber(const Value& value, double& out) {
+        if (auto i = std::get_if<int64_t>(&value)) { out = static_cast<double>(*i); return true; }
+        if (auto d = std::get_if<double>(&value)) { out = *d; return true; }
+        if (auto s = std::get_if<std::string>(&value)) return parseDouble(*s, out);
+        return false;
+    }
+
+    bool isNumeric(const Value& value) {
+        return std::holds_alternative<int64_t>(value) || std::holds_alternative<double>(value);
+    }
+}
+
+Value coerce(const Value& value, ColumnType type) {
+    if (isNull(value)) return value;
+
+    switch (type) {
+        case ColumnType::INT:
+        case ColumnType::BOOL: {
+            if (std::holds_alternative<int64_t>(value)) return value;
+            if (auto d = std::get_if<double>(&value)) return static_cast<int64_t>(std::llround(*d));
+            const auto& text = std::get<std::string>(value);
+            int64_t i;
+            if (parseInt(text, i)) return i;
+            double d;
+            if (parseDouble(text, d)) return static_cast<int64_t>(std::llround(d));
+            return value;
+        }
+        case ColumnType::DOUBLE: {
+            if (std::holds_alternative<double>(value)) return value;
+            if (auto i = std::get_if<int64_t>(&value)) return static_cast<double>(*i);
+            double d;
+            if (parseDouble(std::get<std::string>(value), d)) return d;
+            return value;
+        }
+        case ColumnType::DATETIME: {
+            auto text = toString(value);
+            if (text.size() == 16) text += ":00"; // "YYYY-MM-DD HH:MM"
+            return text;
+        }
+        case ColumnType::TEXT:
+            return toString(value);
+    }
+    return value;
+}
+
+std::string toString(const Value& value) {
+    if (auto i = std::get_if<int64_t>(&value)) return std::to_string(*i);
+    if (auto d = std::get_if<double>(&value)) {
+        std::ostringstream ss;
+        ss << std::setprecision(15) << *d;
+        return ss.str();
+    }
+    if (auto s = std::get_if<std::string>(&value)) return *s;
+    return std::string();
+}
+
+std::optional<int> compare(const Value& lhs, const Value& rhs) {
+    if (isNull(lhs) || isNull(rhs)) return std::nullopt;
+
+    auto li = std::get_if<int64_t>(&lhs);
+    auto ri = std::get_if<int64_t>(&rhs);
+    if (li && ri) return (*li < *ri) ? -1 : (*li > *ri ? 1 : 0);
+
+    if (isNumeric(lhs) || isNumeric(rhs)) {
+        double l, r;
+        if (asNumber(lhs, l) && asNumber(rhs, r)) return (l < r) ? -1 : (l > r ? 1 : 0);
+    }
+
+    int result = toString(lhs).compare(toString(rhs));
+    return (result < 0) ? -1 : (result > 0 ? 1 : 0);
+}
+
+// === Bảng ===
+
+Table::Table(std::string name, std::vector<ColumnDef> columns, const std::vector<IndexDef>& indexes)
+    : _name(std::move(name)), _columns(std::move(columns)) {
+    if (_columns.empty() || _columns.front().name != "id") {
+        _columns.insert(_columns.begin(), ColumnDef{"id", ColumnType::INT});
+    }
+    for (size_t i = 0; i < _columns.size(); ++i) {
+        _columnIndex.emplace(_columns[i].name, static_cast<int>(i));
+    }
+
+    _hashIndexes.push_back(HashIndex{0, true, {}});
+    _orderedIndexes.push_back(OrderedIndex{0, {}});
+    for (const auto& index : indexes) {
+        int column = columnIndex(index.column);
+        if (column < 0) continue;
+        if (index.kind == IndexKind::HASH) {
+            _hashIndexes.push_back(HashIndex{column, index.unique, {}});
+        } else {
+            _orderedIndexes.push_back(OrderedIndex{column, {}});
+        }
+    }
+}
+
+int Table::columnIndex(const std::string& name) const {
+    auto it = _columnIndex.find(name);
+    return it == _columnIndex.end() ? -1 : it->second;
+}
+
+void Table::indexRow(size_t slot) {
+    const auto& values = _rows[slot];
+    for (auto& index : _hashIndexes) {
+        index.entries.emplace(values[index.column], slot);
+    }
+    for (auto& index : _orderedIndexes) {
+        index.entries.emplace(values[index.column], slot);
+    }
+}
+
+void Table::unindexRow(size_t slot) {
+    const auto& values = _rows[slot];
+    for (auto& index : _hashIndexes) {
+        auto [first, last] = index.entries.equal_range(values[index.column]);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == slot) {
+                index.entries.erase(it);
+                break;
+            }
+        }
+    }
+    for (auto& index : _orderedIndexes) {
+        auto [first, last] = index.entries.equal_range(values[index.column]);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == slot) {
+                index.entries.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+Result<bool> Table::checkUnique(const std::vector<Value>& row, const size_t* ignoreSlot) const {
+    for (const auto& index : _hashIndexes) {
+        if (!index.unique || isNull(row[index.column])) continue;
+        auto [first, last] = index.entries.equal_range(row[index.column]);
+        for (auto it = first; it != last; ++it) {
+            if (!ignoreSlot || it->second != *ignoreSlot) {
+                return Failure<bool>(CoreError("Duplicate entry '" + toString(row[index.column]) + "' for key '" +
+                                               _name + "." + _columns[index.column].name + "'", "DUPLICATE_ENTRY"));
+            }
+        }
+    }
+    return Success(true);
+}
+
+Result<size_t> Table::insert(std::vector<Value> row) {
+    row.resize(_columns.size());
+    if (isNull(row[0])) {
+        row[0] = _nextId;
+    }
+    auto uniqueResult = checkUnique(row, nullptr);
+    if (!uniqueResult) return Failure<size_t>(uniqueResult.error());
+
+    if (auto id = std::get_if<int64_t>(&row[0])) {
+        _nextId = std::max(_nextId, *id + 1);
+    }
+
+    size_t slot = _rows.size();
+    _rows.push_back(std::move(row));
+    _live.push_back(true);
+    ++_liveCount;
+    indexRow(slot);
+    return Success(slot);
+}
+
+Result<bool> Table::replace(size_t slot, std::vector<Value> row) {
+    if (_rows[slot] == row) return Success(false);
+
+    auto uniqueResult = checkUnique(row, &slot);
+    if (!uniqueResult) return uniqueResult;
+
+    unindexRow(slot);
+    _rows[slot] = std::move(row);
+    indexRow(slot);
+    return Success(true);
+}
+
+void Table::erase(size_t slot) {
+    if (!isLive(slot)) return;
+    unindexRow(slot);
+    _live[slot] = false;
+    --_liveCount;
+    _rows[slot].clear();
+    _rows[slot].shrink_to_fit();
+}
+
+Result<bool> Table::restore(size_t slot, std::vector<Value> row) {
+    auto uniqueResult = checkUnique(row, &slot);
+    if (!uniqueResult) return uniqueResult;
+
+    if (isLive(slot)) {
+        unindexRow(slot);
+    } else {
+        _live[slot] = true;
+        ++_liveCount;
+    }
+    _rows[slot] = std::move(row);
+    indexRow(slot);
+    return Success(true);
+}
+
+bool Table::lookup(int column, const Value& key, std::vector<size_t>& out) const {
+    for (const auto& index : _hashIndexes) {
+        if (index.column != column) continue;
+        auto [first, last] = index.entries.equal_range(coerce(key, _columns[column].type));
+        for (auto it = first; it != last; ++it) {
+            out.push_back(it->second);
+        }
+        return true;
+    }
+    return false;
+}
+
+const std::multimap<Value, size_t>* Table::orderedIndex(int column) const {
+    for (const auto& index : _orderedIndexes) {
+        if (index.column == column) return &index.entries;
+    }
+    return nullptr;
+}
+
+// === Nhật ký hoàn tác ===
+
+void UndoLog::recordInsert(Table& table, size_t slot) {
+    _entries.push_back(Entry{&table, slot, Change::INSERTED, {}});
+}
+
+void UndoLog::recordUpdate(Table& table, size_t slot, std::vector<Value> before) {
+    _entries.push_back(Entry{&table, slot, Change::UPDATED, std::move(before)});
+}
+
+void UndoLog::recordErase(Table& table, size_t slot, std::vector<Value> before) {
+    _entries.push_back(Entry{&table, slot, Change::ERASED, std::move(before)});
+}
+
+VoidResult UndoLog::rollbackTo(size_t mark) {
+    VoidResult result = Success();
+    while (_entries.size() > mark) {
+        auto& entry = _entries.back();
+        if (entry.change == Change::INSERTED) {
+            entry.table->erase(entry.slot);
+        } else {
+            auto restored = entry.table->restore(entry.slot, std::move(entry.before));
+            if (!restored && result) result = Failure(restored.error());
+        }
+        _entries.pop_back();
+    }
+    return result;
+}
+
+// === Cơ sở dữ liệu ===
+
+Result<std::unique_lock<std::mutex>> Database::lockFor(const void* session) const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    bool free = _transactionEnded.wait_for(lock, _lockWaitTimeout, [this, session] {
+        return _transactionOwner == nullptr || _transactionOwner == session;
+    });
+    if (!free) {
+        return Failure<std::unique_lock<std::mutex>>(
+            CoreError("Lock wait timeout exceeded; another connection holds an open transaction", "LOCK_WAIT_TIMEOUT"));
+    }
+    return Success(std::move(lock));
+}
+
+void Database::endTransaction(const void* session) {
+    if (_transactionOwner != session) return;
+    _transactionOwner = nullptr;
+    _transactionEnded.notify_all();
+}
+
+void Database::setLockWaitTimeout(std::chrono::milliseconds timeout) {
+    auto guard = lock();
+    _lockWaitTimeout = timeout;
+}
+
+Table& Database::createTable(const std::string& name, std::vector<ColumnDef> columns, const std::vector<IndexDef>& indexes) {
+    _tables.erase(name);
+    return _tables.emplace(name, Table(name, std::move(columns), indexes)).first->second;
+}
+
+Table* Database::findTable(const std::string& name) {
+    auto it = _tables.find(name);
+    return it == _tables.end() ? nullptr : &it->second;
+}
+
+const Table* Database::findTable(const std::string& name) const {
+    auto it = _tables.find(name);
+    return it == _tables.end() ? nullptr : &it->second;
+}
+
+std::shared_ptr<Database> Database::createAirlinesSchema() {
+    using T = ColumnType;
+    auto database = std::make_shared<Database>();
+
+    database->createTable("aircraft", {
+        {"serial_number", T::TEXT}, {"model", T::TEXT},
+        {"economy_seats", T::INT, int64_t{0}}, {"business_seats", T::INT, int64_t{0}}, {"first_seats", T::INT, int64_t{0}}
+    }, {{"serial_number", IndexKind::HASH, true}});
+
+    auto& seatClass = database->createTable("seat_class", {
+        {"code", T::TEXT}, {"name", T::TEXT}
+    }, {{"code", IndexKind::HASH, true}});
+    seatClass.insert({Value{}, std::string("E"), std::string("ECONOMY")});
+    seatClass.insert({Value{}, std::string("B"), std::string("BUSINESS")});
+    seatClass.insert({Value{}, std::string("F"), std::string("FIRST")});
+
+    database->createTable("aircraft_seat_layout", {
+        {"aircraft_id", T::INT}, {"seat_class_code", T::TEXT}, {"seat_count", T::INT}
+    }, {{"aircraft_id", IndexKind::HASH}});
+
+    database->createTable("flight", {
+        {"flight_number", T::TEXT}, {"departure_code", T::TEXT}, {"departure_name", T::TEXT},
+        {"arrival_code", T::TEXT}, {"arrival_name", T::TEXT}, {"aircraft_id", T::INT},
+        {"departure_time", T::DATETIME}, {"arrival_time", T::DATETIME},
+        {"status", T::TEXT, std::string("SCHEDULED")}, {"version", T::INT, int64_t{0}}
+    }, {
+        {"flight_number", IndexKind::HASH}, {"aircraft_id", IndexKind::HASH},
+        {"departure_time", IndexKind::ORDERED}
+    });
+
+    database->createTable("passenger", {
+        {"passport_number", T::TEXT}, {"name", T::TEXT}, {"email", T::TEXT},
+        {"phone", T::TEXT}, {"address", T::TEXT}, {"version", T::INT, int64_t{0}}
+    }, {{"passport_number", IndexKind::HASH, true}});
+
+    database->createTable("ticket", {
+        {"ticket_number", T::TEXT}, {"flight_id", T::INT}, {"passenger_id", T::INT},
+        {"seat_number", T::TEXT}, {"price", T::DOUBLE}, {"currency", T::TEXT},
+        {"status", T::TEXT, std::string("PENDING")}, {"version", T::INT, int64_t{0}}
+    }, {
+        {"ticket_number", IndexKind::HASH, true}, {"flight_id", IndexKind::HASH},
+        {"passenger_id", IndexKind::HASH}, {"price", IndexKind::ORDERED}
+    });
+
+    database->createTable("flight_seat_availability", {
+        {"flight_id", T::INT}, {"seat_number", T::TEXT}, {"is_available", T::BOOL, int64_t{1}}
+    }, {{"flight_id", IndexKind::HASH}});
+
+    return database;
+}
+
+// === Phân tích cú pháp ===
+
+namespace {
+    struct Token {
+        enum Type { IDENT, NUMBER, STRING, SYMBOL, PARAM, END } type;
+        std::string text;
+    };
+
+    std::string upper(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::toupper(c); });
+        return text;
+    }
+
+    Result<std::vector<Token>> tokenize(const std::string& sql) {
+        std::vector<Token> tokens;
+        size_t i = 0;
+        while (i < sql.size()) {
+            char c = sql[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++i;
+            } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '`') {
+                bool quoted = c == '`';
+                size_t start = quoted ? ++i : i;
+                while (i < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '_')) ++i;
+                tokens.push_back({Token::IDENT, sql.substr(start, i - start)});
+                if (quoted && i < sql.size() && sql[i] == '`') ++i;
+            } else if (std::isdigit(static_cast<unsigned char>(c))) {
+                size_t start = i;
+                while (i < sql.size() && (std::isdigit(static_cast<unsigned char>(sql[i])) || sql[i] == '.')) ++i;
+                tokens.push_back({Token::NUMBER, sql.substr(start, i - start)});
+            } else if (c == '\'') {
+                std::string text;
+                ++i;
+                while (i < sql.size()) {
+                    if (sql[i] == '\'' && i + 1 < sql.size() && sql[i + 1] == '\'') {
+                        text += '\'';
+                        i += 2;
+                    } else if (sql[i] == '\'') {
+                        break;
+                    } else {
+                        text += sql[i++];
+                    }
+                }
+                if (i >= sql.size()) return Failure<std::vector<Token>>(CoreError("Unterminated string literal", "UNSUPPORTED_SQL"));
+                ++i;
+                tokens.push_back({Token::STRING, text});
+            } else if (c == '?') {
+                tokens.push_back({Token::PARAM, "?"});
+                ++i;
+            } else if ((c == '<' || c == '>' || c == '!') && i + 1 < sql.size() && (sql[i + 1] == '=' || (c == '<' && sql[i + 1] == '>'))) {
+                tokens.push_back({Token::SYMBOL, sql.substr(i, 2)});
+                i += 2;
+            } else if (std::string("(),.*=<>+-;").find(c) != std::string::npos) {
+                tokens.push_back({Token::SYMBOL, std::string(1, c)});
+                ++i;
+            } else {
+                return Failure<std::vector<Token>>(CoreError(std::string("Unexpected character '") + c + "'", "UNSUPPORTED_SQL"));
+            }
+        }
+        tokens.push_back({Token::END, ""});
+        return Success(tokens);
+    }
+}
+
+struct ColumnRef {
+    std::string table;  ///< Alias hoặc tên bảng; rỗng nếu không chỉ định
+    std::string column;
+};
+
+struct Expr {
+    enum Kind { COLUMN, PARAM, LITERAL, ADD, SUB } kind = LITERAL;
+    ColumnRef column;
+    size_t param = 0;
+    Value literal;
+    std::shared_ptr<Expr> left;
+    std::shared_ptr<Expr> right;
+};
+
+struct SelectStmt;
+
+struct Predicate {
+    enum Op { EQ, NE, LT, LE, GT, GE, IN, NOT_IN } op = EQ;
+    Expr left;
+    Expr right;
+    std::vector<Expr> list;
+    std::shared_ptr<SelectStmt> subquery;
+};
+
+struct SelectItem {
+    enum Kind { STAR, TABLE_STAR, COLUMN, COUNT_STAR, COUNT_DISTINCT_COLUMN, MAX_COLUMN, SUM_COLUMN } kind = COLUMN;
+    ColumnRef column;  ///< Với TABLE_STAR, column.table là alias; với COUNT(DISTINCT)/MAX/SUM là cột được gộp
+    size_t prefix = 0; ///< LEFT(cột, n): chỉ lấy n ký tự đầu; 0 là lấy nguyên giá trị
+};
+
+struct JoinClause {
+    std::string table;
+    std::string alias;
+    ColumnRef left;
+    ColumnRef right;
+};
+
+struct OrderItem {
+    ColumnRef column;
+    bool ascending = true;
+};
+
+struct SelectStmt {
+    std::vector<SelectItem> items;
+    std::string table;
+    std::string alias;
+    std::vector<JoinClause> joins;
+    std::vector<Predicate> where;
+    std::vector<SelectItem> groupBy;  ///< Chỉ gồm COLUMN (có thể kèm prefix)
+    std::vector<OrderItem> orderBy;
+    std::optional<Expr> limit;
+    std::optional<Expr> offset;
+};
+
+struct InsertStmt {
+    std::string table;
+    std::vector<std::string> columns;
+    std::vector<std::vector<Expr>> rows;
+};
+
+struct UpdateStmt {
+    std::string table;
+    std::vector<std::pair<std::string, Expr>> assignments;
+    std::vector<Predicate> where;
+};
+
+struct DeleteStmt {
+    std::string table;
+    std::vector<Predicate> where;
+};
+
+struct Statement {
+    std::variant<SelectStmt, InsertStmt, UpdateStmt, DeleteStmt> body;
+    size_t parameterCount = 0;
+};
+
+namespace {
+    class Parser {
+    private:
+        std::vector<Token> _tokens;
+        size_t _pos = 0;
+        size_t _params = 0;
+
+        const Token& peek(size_t offset = 0) const {
+            return _tokens[std::min(_pos + offset, _tokens.size() - 1)];
+        }
+
+        bool isKeyword(const std::string& keyword, size_t offset = 0) const {
+            const auto& token = peek(offset);
+            return token.type == Token::IDENT && upper(token.text) == keyword;
+        }
+
+        bool isSymbol(const std::string& symbol, size_t offset = 0) const {
+            const auto& token = peek(offset);
+            return token.type == Token::SYMBOL && token.text == symbol;
+        }
+
+        bool acceptKeyword(const std::string& keyword) {
+            if (!isKeyword(keyword)) return false;
+            ++_pos;
+            return true;
+        }
+
+        bool acceptSymbol(const std::string& symbol) {
+            if (!isSymbol(symbol)) return false;
+            ++_pos;
+            return true;
+        }
+
+        CoreError error(const std::string& expected) const {
+            return CoreError("Expected " + expected + " near '" + peek().text + "'", "UNSUPPORTED_SQL");
+        }
+
+        Result<std::string> identifier() {
+            if (peek().type != Token::IDENT) return Failure<std::string>(error("identifier"));
+            return Success(_tokens[_pos++].text);
+        }
+
+        static bool isReserved(const std::string& word) {
+            static const std::unordered_set<std::string> reserved = {
+                "FROM", "JOIN", "INNER", "LEFT", "ON", "WHERE", "ORDER", "LIMIT", "OFFSET", "SET", "VALUES", "AND", "OR", "GROUP"
+            };
+            return reserved.count(upper(word)) > 0;
+        }
+
+        Result<std::string> optionalAlias() {
+            acceptKeyword("AS");
+            if (peek().type == Token::IDENT && !isReserved(peek().text)) return identifier();
+            return Success(std::string());
+        }
+
+        Result<ColumnRef> columnRef() {
+            auto first = identifier();
+            if (!first) return Failure<ColumnRef>(first.error());
+            if (acceptSymbol(".")) {
+                auto second = identifier();
+                if (!second) return Failure<ColumnRef>(second.error());
+                return Success(ColumnRef{first.value(), second.value()});
+            }
+            return Success(ColumnRef{"", first.value()});
+        }
+
+        /// Cột hoặc LEFT(cột, n), dùng trong danh sách SELECT và GROUP BY
+        Result<SelectItem> columnItem() {
+            SelectItem item;
+            item.kind = SelectItem::COLUMN;
+            bool prefixed = isKeyword("LEFT") && isSymbol("(", 1);
+            if (prefixed) _pos += 2;
+            auto ref = columnRef();
+            if (!ref) return Failure<SelectItem>(ref.error());
+            item.column = ref.value();
+            if (prefixed) {
+                if (!acceptSymbol(",") || peek().type != Token::NUMBER) return Failure<SelectItem>(error("LEFT(column, length)"));
+                item.prefix = static_cast<size_t>(std::strtoull(_tokens[_pos++].text.c_str(), nullptr, 10));
+                if (item.prefix == 0 || !acceptSymbol(")")) return Failure<SelectItem>(error("LEFT(column, length)"));
+            }
+            return Success(std::move(item));
+        }
+
+        Result<Expr> term() {
+            Expr expr;
+            const auto& token = peek();
+            if (token.type == Token::PARAM) {
+                ++_pos;
+                expr.kind = Expr::PARAM;
+                expr.param = _params++;
+            } else if (token.type == Token::NUMBER || (isSymbol("-") && peek(1).type == Token::NUMBER)) {
+                bool negative = acceptSymbol("-");
+                const auto& text = _tokens[_pos++].text;
+                expr.kind = Expr::LITERAL;
+                if (text.find('.') == std::string::npos) {
+                    int64_t value = std::strtoll(text.c_str(), nullptr, 10);
+                    expr.literal = negative ? -value : value;
+                } else {
+                    double value = std::strtod(text.c_str(), nullptr);
+                    expr.literal = negative ? -value : value;
+                }
+            } else if (token.type == Token::STRING) {
+                expr.kind = Expr::LITERAL;
+                expr.literal = _tokens[_pos++].text;
+            } else if (isKeyword("TRUE") || isKeyword("FALSE")) {
+                expr.kind = Expr::LITERAL;
+                expr.literal = int64_t{isKeyword("TRUE") ? 1 : 0};
+                ++_pos;
+            } else if (isKeyword("NULL")) {
+                expr.kind = Expr::LITERAL;
+                ++_pos;
+            } else if (token.type == Token::IDENT) {
+                auto ref = columnRef();
+                if (!ref) return Failure<Expr>(ref.error());
+                expr.kind = Expr::COLUMN;
+                expr.column = ref.value();
+            } else {
+                return Failure<Expr>(error("expression"));
+            }
+            return Success(expr);
+        }
+
+        Result<Expr> expression() {
+            auto left = term();
+            if (!left) return left;
+            while (isSymbol("+") || isSymbol("-")) {
+                Expr combined;
+                combined.kind = acceptSymbol("+") ? Expr::ADD : (acceptSymbol("-"), Expr::SUB);
+                auto right = term();
+                if (!right) return right;
+                combined.left = std::make_shared<Expr>(std::move(left.value()));
+                combined.right = std::make_shared<Expr>(std::move(right.value()));
+                left = Success(std::move(combined));
+            }
+            return left;
+        }
+
+        Result<Predicate> predicate() {
+            Predicate result;
+            auto left = expression();
+            if (!left) return Failure<Predicate>(left.error());
+            result.left = std::move(left.value());
+
+            bool negated = isKeyword("NOT") && isKeyword("IN", 1);
+            if (negated) ++_pos;
+            if (acceptKeyword("IN")) {
+                result.op = negated ? Predicate::NOT_IN : Predicate::IN;
+                if (!acceptSymbol("(")) return Failure<Predicate>(error("'('"));
+                if (isKeyword("SELECT")) {
+                    auto subquery = select();
+                    if (!subquery) return Failure<Predicate>(subquery.error());
+                    result.subquery = std::make_shared<SelectStmt>(std::move(subquery.value()));
+                } else {
+                    do {
+                        auto item = expression();
+                        if (!item) return Failure<Predicate>(item.error());
+                        result.list.push_back(std::move(item.value()));
+                    } while (acceptSymbol(","));
+                }
+                if (!acceptSymbol(")")) return Failure<Predicate>(error("')'"));
+                return Success(std::move(result));
+            }
+
+            static const std::vector<std::pair<std::string, Predicate::Op>> operators = {
+                {"=", Predicate::EQ}, {"!=", Predicate::NE}, {"<>", Predicate::NE},
+                {"<=", Predicate::LE}, {">=", Predicate::GE}, {"<", Predicate::LT}, {">", Predicate::GT}
+            };
+            bool matched = false;
+            for (const auto& [symbol, op] : operators) {
+                if (acceptSymbol(symbol)) {
+                    result.op = op;
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) return Failure<Predicate>(error("comparison operator"));
+
+            auto right = expression();
+            if (!right) return Failure<Predicate>(right.error());
+            result.right = std::move(right.value());
+            return Success(std::move(result));
+        }
+
+        Result<std::vector<Predicate>> whereClause() {
+            std::vector<Predicate> predicates;
+            if (!acceptKeyword("WHERE")) return Success(predicates);
+            do {
+                auto item = predicate();
+                if (!item) return Failure<std::vector<Predicate>>(item.error());
+                predicates.push_back(std::move(item.value()));
+            } while (acceptKeyword("AND"));
+            if (isKeyword("OR")) return Failure<std::vector<Predicate>>(CoreError("OR is not supported", "UNSUPPORTED_SQL"));
+            return Success(std::move(predicates));
+        }
+
+        Result<SelectStmt> select() {
+            SelectStmt stmt;
+            if (!acceptKeyword("SELECT")) return Failure<SelectStmt>(error("SELECT"));
+
+            do {
+                SelectItem item;
+                if (acceptSymbol("*")) {
+                    item.kind = SelectItem::STAR;
+                } else if (isKeyword("COUNT") && isSymbol("(", 1)) {
+                    _pos += 2;
+                    if (acceptKeyword("DISTINCT")) {
+                        auto ref = columnRef();
+                        if (!ref) return Failure<SelectStmt>(ref.error());
+                        if (!acceptSymbol(")")) return Failure<SelectStmt>(error("')' after COUNT(DISTINCT column"));
+                        item.kind = SelectItem::COUNT_DISTINCT_COLUMN;
+                        item.column = ref.value();
+                    } else {
+                        if (!acceptSymbol("*") || !acceptSymbol(")")) return Failure<SelectStmt>(error("COUNT(*)"));
+                        item.kind = SelectItem::COUNT_STAR;
+                    }
+                } else if ((isKeyword("MAX") || isKeyword("SUM")) && isSymbol("(", 1)) {
+                    item.kind = isKeyword("MAX") ? SelectItem::MAX_COLUMN : SelectItem::SUM_COLUMN;
+                    _pos += 2;
+                    auto ref = columnRef();
+                    if (!ref) return Failure<SelectStmt>(ref.error());
+                    if (!acceptSymbol(")")) return Failure<SelectStmt>(error("')' after aggregate column"));
+                    item.column = ref.value();
+                } else if (peek().type == Token::IDENT && isSymbol(".", 1) && isSymbol("*", 2)) {
+                    item.kind = SelectItem::TABLE_STAR;
+                    item.column.table = _tokens[_pos].text;
+                    _pos += 3;
+                } else {
+                    auto column = columnItem();
+                    if (!column) return Failure<SelectStmt>(column.error());
+                    item = std::move(column.value());
+                    auto alias = optionalAlias();
+                    if (!alias) return Failure<SelectStmt>(alias.error());
+                }
+                stmt.items.push_back(std::move(item));
+            } while (acceptSymbol(","));
+
+            if (!acceptKeyword("FROM")) return Failure<SelectStmt>(error("FROM"));
+            auto table = identifier();
+            if (!table) return Failure<SelectStmt>(table.error());
+            stmt.table = table.value();
+            auto alias = optionalAlias();
+            if (!alias) return Failure<SelectStmt>(alias.error());
+            stmt.alias = alias.value().empty() ? stmt.table : alias.value();
+
+            while (acceptKeyword("INNER") || isKeyword("JOIN")) {
+                if (!acceptKeyword("JOIN")) return Failure<SelectStmt>(error("JOIN"));
+                JoinClause join;
+                auto joinTable = identifier();
+                if (!joinTable) return Failure<SelectStmt>(joinTable.error());
+                join.table = joinTable.value();
+                auto joinAlias = optionalAlias();
+                if (!joinAlias) return Failure<SelectStmt>(joinAlias.error());
+                join.alias = joinAlias.value().empty() ? join.table : joinAlias.value();
+                if (!acceptKeyword("ON")) return Failure<SelectStmt>(error("ON"));
+                auto left = columnRef();
+                if (!left) return Failure<SelectStmt>(left.error());
+                if (!acceptSymbol("=")) return Failure<SelectStmt>(error("'=' in JOIN condition"));
+                auto right = columnRef();
+                if (!right) return Failure<SelectStmt>(right.error());
+                join.left = left.value();
+                join.right = right.value();
+                stmt.joins.push_back(std::move(join));
+            }
+
+            auto where = whereClause();
+            if (!where) return Failure<SelectStmt>(where.error());
+            stmt.where = std::move(where.value());
+
+            if (acceptKeyword("GROUP")) {
+                if (!acceptKeyword("BY")) return Failure<SelectStmt>(error("BY"));
+                do {
+                    auto column = columnItem();
+                    if (!column) return Failure<SelectStmt>(column.error());
+                    stmt.groupBy.push_back(std::move(column.value()));
+                } while (acceptSymbol(","));
+                if (isKeyword("ORDER")) {
+                    return Failure<SelectStmt>(CoreError("ORDER BY with GROUP BY is not supported", "UNSUPPORTED_SQL"));
+                }
+            }
+
+            if (acceptKeyword("ORDER")) {
+                if (!acceptKeyword("BY")) return Failure<SelectStmt>(error("BY"));
+                do {
+                    OrderItem item;
+                    auto ref = columnRef();
+                    if (!ref) return Failure<SelectStmt>(ref.error());
+                    item.column = ref.value();
+                    if (acceptKeyword("DESC")) item.ascending = false;
+                    else acceptKeyword("ASC");
+                    stmt.orderBy.push_back(std::move(item));
+                } while (acceptSymbol(","));
+            }
+
+            if (acceptKeyword("LIMIT")) {
+                auto limit = term();
+                if (!limit) return Failure<SelectStmt>(limit.error());
+                stmt.limit = std::move(limit.value());
+                if (acceptKeyword("OFFSET")) {
+                    auto offset = term();
+                    if (!offset) return Failure<SelectStmt>(offset.error());
+                    stmt.offset = std::move(offset.value());
+                }
+            }
+            return Success(std::move(stmt));
+        }
+
+        Result<InsertStmt> insert() {
+            InsertStmt stmt;
+            acceptKeyword("INSERT");
+            if (!acceptKeyword("INTO")) return Failure<InsertStmt>(error("INTO"));
+            auto table = identifier();
+            if (!table) return Failure<InsertStmt>(table.error());
+            stmt.table = table.value();
+
+            if (!acceptSymbol("(")) return Failure<InsertStmt>(error("column list"));
+            do {
+                auto column = identifier();
+                if (!column) return Failure<InsertStmt>(column.error());
+                stmt.columns.push_back(column.value());
+            } while (acceptSymbol(","));
+            if (!acceptSymbol(")")) return Failure<InsertStmt>(error("')'"));
+
+            if (!acceptKeyword("VALUES")) return Failure<InsertStmt>(error("VALUES"));
+            do {
+                if (!acceptSymbol("(")) return Failure<InsertStmt>(error("'('"));
+                std::vector<Expr> row;
+                do {
+                    auto value = expression();
+                    if (!value) return Failure<InsertStmt>(value.error());
+                    row.push_back(std::move(value.value()));
+                } while (acceptSymbol(","));
+                if (!acceptSymbol(")")) return Failure<InsertStmt>(error("')'"));
+                if (row.size() != stmt.columns.size()) {
+                    return Failure<InsertStmt>(CoreError("Column count doesn't match value count", "UNSUPPORTED_SQL"));
+                }
+                stmt.rows.push_back(std::move(row));
+            } while (acceptSymbol(","));
+            return Success(std::move(stmt));
+        }
+
+        Result<UpdateStmt> update() {
+            UpdateStmt stmt;
+            acceptKeyword("UPDATE");
+            auto table = identifier();
+            if (!table) return Failure<UpdateStmt>(table.error());
+            stmt.table = table.value();
+            if (!acceptKeyword("SET")) return Failure<UpdateStmt>(error("SET"));
+            do {
+                auto column = columnRef();
+                if (!column) return Failure<UpdateStmt>(column.error());
+                if (!acceptSymbol("=")) return Failure<UpdateStmt>(error("'='"));
+                auto value = expression();
+                if (!value) return Failure<UpdateStmt>(value.error());
+                stmt.assignments.emplace_back(column.value().column, std::move(value.value()));
+            } while (acceptSymbol(","));
+            auto where = whereClause();
+            if (!where) return Failure<UpdateStmt>(where.error());
+            stmt.where = std::move(where.value());
+            return Success(std::move(stmt));
+        }
+
+        Result<DeleteStmt> remove() {
+            DeleteStmt stmt;
+            acceptKeyword("DELETE");
+            if (!acceptKeyword("FROM")) return Failure<DeleteStmt>(error("FROM"));
+            auto table = identifier();
+            if (!table) return Failure<DeleteStmt>(table.error());
+            stmt.table = table.value();
+            auto where = whereClause();
+            if (!where) return Failure<DeleteStmt>(where.error());
+            stmt.where = std::move(where.value());
+            return Success(std::move(stmt));
+        }
+
+    public:
+        explicit Parser(std::vector<Token> tokens) : _tokens(std::move(tokens)) {}
+
+        Result<std::shared_ptr<const Statement>> parse() {
+            auto statement = std::make_shared<Statement>();
+            if (isKeyword("SELECT")) {
+                auto stmt = select();
+                if (!stmt) return Failure<std::shared_ptr<const Statement>>(stmt.error());
+                statement->body = std::move(stmt.value());
+            } else if (isKeyword("INSERT")) {
+                auto stmt = insert();
+                if (!stmt) return Failure<std::shared_ptr<const Statement>>(stmt.error());
+                statement->body = std::move(stmt.value());
+            } else if (isKeyword("UPDATE")) {
+                auto stmt = update();
+                if (!stmt) return Failure<std::shared_ptr<const Statement>>(stmt.error());
+                statement->body = std::move(stmt.value());
+            } else if (isKeyword("DELETE")) {
+                auto stmt = remove();
+                if (!stmt) return Failure<std::shared_ptr<const Statement>>(stmt.error());
+                statement->body = std::move(stmt.value());
+            } else {
+                return Failure<std::shared_ptr<const Statement>>(error("SELECT, INSERT, UPDATE or DELETE"));
+            }
+            acceptSymbol(";");
+            if (peek().type != Token::END) return Failure<std::shared_ptr<const Statement>>(error("end of statement"));
+            statement->parameterCount = _params;
+            return Success(std::shared_ptr<const Statement>(std::move(statement)));
+        }
+    };
+}
+
+Result<std::shared_ptr<const Statement>> parse(const std::string& sql) {
+    auto tokens = tokenize(sql);
+    if (!tokens) return Failure<std::shared_ptr<const Statement>>(tokens.error());
+    return Parser(std::move(tokens.value())).parse();
+}
+
+size_t parameterCount(const Statement& statement) {
+    return statement.parameterCount;
+}
+
+bool isQuery(const Statement& statement) {
+    return std::holds_alternative<SelectStmt>(statement.body);
+}
+
+// === Thực thi ===
+
+namespace {
+    struct Source {
+        const Table* table;
+        std::string alias;
+    };
+
+    struct BoundColumn {
+        size_t source;
+        int column;
+    };
+
+    /// Biểu thức đã gắn cột và thay tham số bằng giá trị
+    struct BoundExpr {
+        Expr::Kind kind = Expr::LITERAL;
+        BoundColumn column{0, 0};
+        Value constant;
+        std::shared_ptr<BoundExpr> left;
+        std::shared_ptr<BoundExpr> right;
+        size_t maxSource = 0;
+        bool isConstant = true;
+    };
+
+    struct BoundPredicate {
+        Predicate::Op op;
+        BoundExpr left;
+        BoundExpr right;
+        std::vector<Value> values;  ///< Danh sách IN đã tính
+        size_t maxSource = 0;
+    };
+
+    using Tuple = std::vector<size_t>;
+
+    Value evaluate(const BoundExpr& expr, const std::vector<Source>& sources, const Tuple& tuple) {
+        switch (expr.kind) {
+            case Expr::COLUMN:
+                return sources[expr.column.source].table->row(tuple[expr.column.source])[expr.column.column];
+            case Expr::ADD:
+            case Expr::SUB: {
+                Value lhs = evaluate(*expr.left, sources, tuple);
+                Value rhs = evaluate(*expr.right, sources, tuple);
+                if (isNull(lhs) || isNull(rhs)) return Value{};
+                auto li = std::get_if<int64_t>(&lhs);
+                auto ri = std::get_if<int64_t>(&rhs);
+                if (li && ri) return expr.kind == Expr::ADD ? *li + *ri : *li - *ri;
+                double l = 0, r = 0;
+                asNumber(lhs, l);
+                asNumber(rhs, r);
+                return expr.kind == Expr::ADD ? l + r : l - r;
+            }
+            default:
+                return expr.constant;
+        }
+    }
+
+    bool test(const BoundPredicate& predicate, const std::vector<Source>& sources, const Tuple& tuple) {
+        Value lhs = evaluate(predicate.left, sources, tuple);
+        if (predicate.op == Predicate::IN || predicate.op == Predicate::NOT_IN) {
+            // NULL không thuộc và cũng không nằm ngoài danh sách nào
+            if (isNull(lhs)) return false;
+            for (const auto& value : predicate.values) {
+                auto result = compare(lhs, value);
+                if (result && *result == 0) return predicate.op == Predicate::IN;
+            }
+            return predicate.op == Predicate::NOT_IN;
+        }
+        auto result = compare(lhs, evaluate(predicate.right, sources, tuple));
+        if (!result) return false;
+        switch (predicate.op) {
+            case Predicate::EQ: return *result == 0;
+            case Predicate::NE: return *result != 0;
+            case Predicate::LT: return *result < 0;
+            case Predicate::LE: return *result <= 0;
+            case Predicate::GT: return *result > 0;
+            case Predicate::GE: return *result >= 0;
+            default: return false;
+        }
+    }
+
+    Result<std::vector<std::vector<Value>>> runSelect(Database& database, const SelectStmt& stmt,
+                                                      const std::vector<Value>& params,
+                                                      std::vector<std::string>* columnNames);
+
+    class Binder {
+    private:
+        Database& _database;
+        const std::vector<Source>& _sources;
+        const std::vector<Value>& _params;
+
+    public:
+        Binder(Database& database, const std::vector<Source>& sources, const std::vector<Value>& params)
+            : _database(database), _sources(sources), _params(params) {}
+
+        Result<BoundColumn> resolve(const ColumnRef& ref) const {
+            for (size_t i = 0; i < _sources.size(); ++i) {
+                const auto& source = _sources[i];
+                if (!ref.table.empty() && ref.table != source.alias && ref.table != source.table->getName()) continue;
+                int column = source.table->columnIndex(ref.column);
+                if (column >= 0) return Success(BoundColumn{i, column});
+            }
+            std::string name = ref.table.empty() ? ref.column : ref.table + "." + ref.column;
+            return Failure<BoundColumn>(CoreError("Unknown column '" + name + "'", "UNKNOWN_COLUMN"));
+        }
+
+        Result<BoundExpr> bind(const Expr& expr) const {
+            BoundExpr bound;
+            bound.kind = expr.kind;
+            switch (expr.kind) {
+                case Expr::COLUMN: {
+                    auto column = resolve(expr.column);
+                    if (!column) return Failure<BoundExpr>(column.error());
+                    bound.column = column.value();
+                    bound.maxSource = column.value().source;
+                    bound.isConstant = false;
+                    break;
+                }
+                case Expr::PARAM:
+                    if (expr.param >= _params.size()) {
+                        return Failure<BoundExpr>(CoreError("Parameter " + std::to_string(expr.param + 1) + " is not bound", "PARAM_FAILED"));
+                    }
+                    bound.kind = Expr::LITERAL;
+                    bound.constant = _params[expr.param];
+                    break;
+                case Expr::LITERAL:
+                    bound.constant = expr.literal;
+                    break;
+                case Expr::ADD:
+                case Expr::SUB: {
+                    auto left = bind(*expr.left);
+                    if (!left) return left;
+                    auto right = bind(*expr.right);
+                    if (!right) return right;
+                    bound.maxSource = std::max(left.value().maxSource, right.value().maxSource);
+                    bound.isConstant = left.value().isConstant && right.value().isConstant;
+                    bound.left = std::make_shared<BoundExpr>(std::move(left.value()));
+                    bound.right = std::make_shared<BoundExpr>(std::move(right.value()));
+                    if (bound.isConstant) {
+                        bound.constant = evaluate(bound, _sources, Tuple{});
+                        bound.kind = Expr::LITERAL;
+                    }
+                    break;
+                }
+            }
+            return Success(std::move(bound));
+        }
+
+        Result<std::vector<BoundPredicate>> bind(const std::vector<Predicate>& predicates) const {
+            std::vector<BoundPredicate> bound;
+            bound.reserve(predicates.size());
+            for (const auto& predicate : predicates) {
+                BoundPredicate item;
+                item.op = predicate.op;
+                auto left = bind(predicate.left);
+                if (!left) return Failure<std::vector<BoundPredicate>>(left.error());
+                item.left = std::move(left.value());
+                item.maxSource = item.left.maxSource;
+
+                if (predicate.op == Predicate::IN || predicate.op == Predicate::NOT_IN) {
+                    if (predicate.subquery) {
+                        auto rows = runSelect(_database, *predicate.subquery, _params, nullptr);
+                        if (!rows) return Failure<std::vector<BoundPredicate>>(rows.error());
+                        for (auto& row : rows.value()) {
+                            if (!row.empty()) item.values.push_back(std::move(row.front()));
+                        }
+                    } else {
+                        for (const auto& expr : predicate.list) {
+                            auto value = bind(expr);
+                            if (!value) return Failure<std::vector<BoundPredicate>>(value.error());
+                            if (!value.value().isConstant) {
+                                return Failure<std::vector<BoundPredicate>>(CoreError("IN list must be constant", "UNSUPPORTED_SQL"));
+                            }
+                            item.values.push_back(value.value().constant);
+                        }
+                    }
+                } else {
+                    auto right = bind(predicate.right);
+                    if (!right) return Failure<std::vector<BoundPredicate>>(right.error());
+                    item.right = std::move(right.value());
+                    item.maxSource = std::max(item.maxSource, item.right.maxSource);
+                }
+                bound.push_back(std::move(item));
+            }
+            return Success(std::move(bound));
+        }
+    };
+
+    /**
+     * Chọn các slot ứng viên của bảng gốc: dùng chỉ mục băm cho =/IN, chỉ mục có thứ tự cho
+     * điều kiện khoảng, nếu không thì quét toàn bộ (theo chỉ mục có thứ tự của cột ORDER BY nếu có).
+     * @param ordered Được đặt true nếu kết quả đã theo đúng thứ tự của orderColumn
+     */
+    std::vector<size_t> candidateSlots(const Table& table, const std::vector<BoundPredicate>& predicates,
+                                       int orderColumn, bool orderAscending, bool& ordered) {
+        std::vector<size_t> slots;
+        ordered = false;
+
+        // Điều kiện bằng hoặc IN trên cột có chỉ mục băm
+        for (const auto& predicate : predicates) {
+            if (predicate.left.kind != Expr::COLUMN || predicate.left.column.source != 0) continue;
+            int column = predicate.left.column.column;
+            if (predicate.op == Predicate::EQ && predicate.right.isConstant) {
+                if (table.lookup(column, predicate.right.constant, slots)) {
+                    std::sort(slots.begin(), slots.end());
+                    return slots;
+                }
+            } else if (predicate.op == Predicate::IN) {
+                std::vector<size_t> found;
+                bool indexed = true;
+                for (const auto& value : predicate.values) {
+                    if (!table.lookup(column, value, found)) {
+                        indexed = false;
+                        break;
+                    }
+                }
+                if (indexed) {
+                    std::sort(found.begin(), found.end());
+                    found.erase(std::unique(found.begin(), found.end()), found.end());
+                    return found;
+                }
+            }
+        }
+
+        // Điều kiện khoảng trên cột có chỉ mục có thứ tự
+        for (const auto& predicate : predicates) {
+            if (predicate.left.kind != Expr::COLUMN || predicate.left.column.source != 0 || !predicate.right.isConstant) continue;
+            if (predicate.op != Predicate::LT && predicate.op != Predicate::LE &&
+                predicate.op != Predicate::GT && predicate.op != Predicate::GE) continue;
+            int column = predicate.left.column.column;
+            const auto* index = table.orderedIndex(column);
+            if (!index) continue;
+
+            Value key = coerce(predicate.right.constant, table.getColumns()[column].type);
+            auto first = index->begin();
+            auto last = index->end();
+            switch (predicate.op) {
+                case Predicate::LT: last = index->lower_bound(key); break;
+                case Predicate::LE: last = index->upper_bound(key); break;
+                case Predicate::GT: first = index->upper_bound(key); break;
+                default: first = index->lower_bound(key); break;
+            }
+            // NULL đứng đầu theo thứ tự variant và không bao giờ thỏa điều kiện so sánh
+            while (first != last && isNull(first->first)) ++first;
+            for (auto it = first; it != last; ++it) slots.push_back(it->second);
+            ordered = column == orderColumn && orderAscending;
+            return slots;
+        }
+
+        // Quét toàn bộ
+        if (orderColumn >= 0) {
+            if (const auto* index = table.orderedIndex(orderColumn)) {
+                slots.reserve(table.size());
+                if (orderAscending) {
+                    for (const auto& [key, slot] : *index) slots.push_back(slot);
+                } else {
+                    for (auto it = index->rbegin(); it != index->rend(); ++it) slots.push_back(it->second);
+                }
+                ordered = true;
+                return slots;
+            }
+        }
+        slots.reserve(table.size());
+        for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+            if (table.isLive(slot)) slots.push_back(slot);
+        }
+        ordered = orderColumn == 0 && orderAscending; // slot tăng dần theo id
+        return slots;
+    }
+
+    Result<std::vector<std::vector<Value>>> runSelect(Database& database, const SelectStmt& stmt,
+                                                      const std::vector<Value>& params,
+                                                      std::vector<std::string>* columnNames) {
+        using Rows = std::vector<std::vector<Value>>;
+
+        std::vector<Source> sources;
+        const Table* base = database.findTable(stmt.table);
+        if (!base) return Failure<Rows>(CoreError("Table '" + stmt.table + "' doesn't exist", "UNKNOWN_TABLE"));
+        sources.push_back({base, stmt.alias});
+        for (const auto& join : stmt.joins) {
+            const Table* table = database.findTable(join.table);
+            if (!table) return Failure<Rows>(CoreError("Table '" + join.table + "' doesn't exist", "UNKNOWN_TABLE"));
+            sources.push_back({table, join.alias});
+        }
+
+        Binder binder(database, sources, params);
+        auto predicates = binder.bind(stmt.where);
+        if (!predicates) return Failure<Rows>(predicates.error());
+
+        // Điều kiện JOIN: cột của bảng mới và cột của các bảng đã có
+        struct BoundJoin {
+            int column;
+            BoundColumn other;
+            std::unordered_multimap<Value, size_t> scratch;  ///< Dùng khi cột không có chỉ mục băm
+            bool indexed;
+        };
+        std::vector<BoundJoin> joins;
+        for (size_t j = 0; j < stmt.joins.size(); ++j) {
+            auto left = binder.resolve(stmt.joins[j].left);
+            auto right = binder.resolve(stmt.joins[j].right);
+            if (!left) return Failure<Rows>(left.error());
+            if (!right) return Failure<Rows>(right.error());
+            BoundColumn mine = left.value(), other = right.value();
+            if (mine.source != j + 1) std::swap(mine, other);
+            if (mine.source != j + 1 || other.source > j) {
+                return Failure<Rows>(CoreError("JOIN condition must reference the joined table", "UNSUPPORTED_SQL"));
+            }
+            BoundJoin bound{mine.column, other, {}, false};
+            std::vector<size_t> probe;
+            bound.indexed = sources[j + 1].table->lookup(mine.column, Value{}, probe);
+            if (!bound.indexed) {
+                const Table& table = *sources[j + 1].table;
+                for (size_t slot = 0; slot < table.slotCount(); ++slot) {
+                    if (table.isLive(slot)) bound.scratch.emplace(table.row(slot)[mine.column], slot);
+                }
+            }
+            joins.push_back(std::move(bound));
+        }
+
+        // Thứ tự sắp xếp
+        std::vector<std::pair<BoundColumn, bool>> orderKeys;
+        for (const auto& item : stmt.orderBy) {
+            auto column = binder.resolve(item.column);
+            if (!column) return Failure<Rows>(column.error());
+            orderKeys.emplace_back(column.value(), item.ascending);
+        }
+        int baseOrderColumn = (!orderKeys.empty() && orderKeys.front().first.source == 0) ? orderKeys.front().first.column : -1;
+        bool baseOrderAscending = orderKeys.empty() || orderKeys.front().second;
+
+        bool ordered = false;
+        auto baseSlots = candidateSlots(*base, predicates.value(), baseOrderColumn, baseOrderAscending, ordered);
+        ordered = ordered && orderKeys.size() == 1;
+
+        auto passes = [&](const Tuple& tuple, size_t level) {
+            for (const auto& predicate : predicates.value()) {
+                if (predicate.maxSource == level && !test(predicate, sources, tuple)) return false;
+            }
+            return true;
+        };
+
+        std::vector<Tuple> tuples;
+        tuples.reserve(baseSlots.size());
+        for (size_t slot : baseSlots) {
+            Tuple tuple(sources.size(), 0);
+            tuple[0] = slot;
+            if (passes(tuple, 0)) tuples.push_back(std::move(tuple));
+        }
+
+        for (size_t j = 0; j < joins.size(); ++j) {
+            const auto& join = joins[j];
+            const Table& table = *sources[j + 1].table;
+            std::vector<Tuple> next;
+            next.reserve(tuples.size());
+            std::vector<size_t> matches;
+            for (const auto& tuple : tuples) {
+                const Value& key = sources[join.other.source].table->row(tuple[join.other.source])[join.other.column];
+                if (isNull(key)) continue;
+                matches.clear();
+                if (join.indexed) {
+                    table.lookup(join.column, key, matches);
+                } else {
+                    auto [first, last] = join.scratch.equal_range(coerce(key, table.getColumns()[join.column].type));
+                    for (auto it = first; it != last; ++it) matches.push_back(it->second);
+                }
+                for (size_t slot : matches) {
+                    Tuple joined = tuple;
+                    joined[j + 1] = slot;
+                    if (passes(joined, j + 1)) next.push_back(std::move(joined));
+                }
+            }
+            tuples = std::move(next);
+        }
+
+        if (!orderKeys.empty() && !ordered) {
+            std::stable_sort(tuples.begin(), tuples.end(), [&](const Tuple& a, const Tuple& b) {
+                for (const auto& [column, ascending] : orderKeys) {
+                    const Value& lhs = sources[column.source].table->row(a[column.source])[column.column];
+                    const Value& rhs = sources[column.source].table->row(b[column.source])[column.column];
+                    int result;
+                    if (isNull(lhs) || isNull(rhs)) result = isNull(lhs) == isNull(rhs) ? 0 : (isNull(lhs) ? -1 : 1);
+                    else result = *compare(lhs, rhs);
+                    if (result != 0) return ascending ? result < 0 : result > 0;
+                }
+                return false;
+            });
+        }
+
+        auto boundCount = [&binder](const std::optional<Expr>& expr) -> Result<std::optional<size_t>> {
+            if (!expr) return Success(std::optional<size_t>());
+            auto bound = binder.bind(*expr);
+            if (!bound) return Failure<std::optional<size_t>>(bound.error());
+            auto count = coerce(bound.value().constant, ColumnType::INT);
+            if (auto n = std::get_if<int64_t>(&count); n && *n >= 0) return Success(std::optional<size_t>(static_cast<size_t>(*n)));
+            return Success(std::optional<size_t>());
+        };
+        auto limitResult = boundCount(stmt.limit);
+        if (!limitResult) return Failure<Rows>(limitResult.error());
+        auto offsetResult = boundCount(stmt.offset);
+        if (!offsetResult) return Failure<Rows>(offsetResult.error());
+        std::optional<size_t> limit = limitResult.value();
+        size_t offset = offsetResult.value().value_or(0);
+
+        bool grouped = !stmt.groupBy.empty();
+        if (!grouped) {
+            if (offset > 0) tuples.erase(tuples.begin(), tuples.begin() + static_cast<std::ptrdiff_t>(std::min(offset, tuples.size())));
+            if (limit && *limit < tuples.size()) tuples.resize(*limit);
+        }
+
+        // Chiếu cột
+        struct Projection {
+            enum Aggregate { NONE, COUNT, COUNT_DISTINCT, MAX, SUM };
+            BoundColumn column;
+            size_t prefix = 0;
+            Aggregate aggregate = NONE;  ///< COUNT(*) của nhóm, hoặc COUNT(DISTINCT)/MAX/SUM của cả kết quả
+        };
+        auto cell = [&sources](const Projection& projection, const Tuple& tuple) -> Value {
+            const Value& value = sources[projection.column.source].table->row(tuple[projection.column.source])[projection.column.column];
+            if (projection.prefix == 0 || isNull(value)) return value;
+            return toString(value).substr(0, projection.prefix);
+        };
+
+        std::vector<Projection> projections;
+        bool aggregated = false;
+        std::vector<std::string> names;
+        for (const auto& item : stmt.items) {
+            switch (item.kind) {
+                case SelectItem::COUNT_STAR:
+                    projections.push_back({BoundColumn{0, 0}, 0, Projection::COUNT});
+                    aggregated = true;
+                    names.push_back("COUNT(*)");
+                    break;
+                case SelectItem::COUNT_DISTINCT_COLUMN:
+                case SelectItem::MAX_COLUMN:
+                case SelectItem::SUM_COLUMN: {
+                    if (grouped) return Failure<Rows>(CoreError("COUNT(DISTINCT)/MAX/SUM with GROUP BY is not supported", "UNSUPPORTED_SQL"));
+                    auto column = binder.resolve(item.column);
+                    if (!column) return Failure<Rows>(column.error());
+                    auto aggregate = item.kind == SelectItem::COUNT_DISTINCT_COLUMN ? Projection::COUNT_DISTINCT
+                                   : item.kind == SelectItem::MAX_COLUMN ? Projection::MAX : Projection::SUM;
+                    projections.push_back({column.value(), 0, aggregate});
+                    aggregated = true;
+                    names.push_back((aggregate == Projection::COUNT_DISTINCT ? "COUNT(DISTINCT "
+                                     : aggregate == Projection::MAX ? "MAX(" : "SUM(") + item.column.column + ")");
+                    break;
+                }
+                case SelectItem::STAR:
+                case SelectItem::TABLE_STAR: {
+                    bool matched = false;
+                    for (size_t i = 0; i < sources.size(); ++i) {
+                        if (item.kind == SelectItem::TABLE_STAR &&
+                            item.column.table != sources[i].alias && item.column.table != sources[i].table->getName()) continue;
+                        matched = true;
+                        const auto& columns = sources[i].table->getColumns();
+                        for (size_t c = 0; c < columns.size(); ++c) {
+                            projections.push_back({BoundColumn{i, static_cast<int>(c)}});
+                            names.push_back(columns[c].name);
+                        }
+                    }
+                    if (!matched) return Failure<Rows>(CoreError("Unknown table '" + item.column.table + "'", "UNKNOWN_TABLE"));
+                    break;
+                }
+                case SelectItem::COLUMN: {
+                    auto column = binder.resolve(item.column);
+                    if (!column) return Failure<Rows>(column.error());
+                    projections.push_back({column.value(), item.prefix});
+                    names.push_back(item.prefix ? "LEFT(" + item.column.column + ", " + std::to_string(item.prefix) + ")"
+                                                : item.column.column);
+                    break;
+                }
+            }
+        }
+        if (columnNames) *columnNames = std::move(names);
+
+        Rows rows;
+        if (aggregated && !grouped) {
+            // Gộp cả kết quả thành một hàng; MAX/SUM của tập rỗng là NULL như MySQL,
+            // COUNT(DISTINCT) bỏ qua NULL, cột thường lấy từ hàng đầu tiên
+            std::vector<Value> row;
+            row.reserve(projections.size());
+            for (const auto& projection : projections) {
+                if (projection.aggregate == Projection::COUNT) {
+                    row.push_back(Value{static_cast<int64_t>(tuples.size())});
+                } else if (projection.aggregate == Projection::COUNT_DISTINCT) {
+                    std::unordered_set<Value> distinct;
+                    for (const auto& tuple : tuples) {
+                        Value value = cell(projection, tuple);
+                        if (!isNull(value)) distinct.insert(std::move(value));
+                    }
+                    row.push_back(Value{static_cast<int64_t>(distinct.size())});
+                } else if (projection.aggregate == Projection::MAX) {
+                    Value best;
+                    for (const auto& tuple : tuples) {
+                        Value value = cell(projection, tuple);
+                        if (!isNull(value) && (isNull(best) || *compare(value, best) > 0)) best = std::move(value);
+                    }
+                    row.push_back(std::move(best));
+                } else if (projection.aggregate == Projection::SUM) {
+                    int64_t integral = 0;
+                    double fractional = 0;
+                    bool any = false, isDouble = false;
+                    for (const auto& tuple : tuples) {
+                        Value value = cell(projection, tuple);
+                        if (auto n = std::get_if<int64_t>(&value)) integral += *n;
+                        else if (auto d = std::get_if<double>(&value)) { fractional += *d; isDouble = true; }
+                        else continue;
+                        any = true;
+                    }
+                    if (!any) row.push_back(Value{});
+                    else if (isDouble) row.push_back(Value{fractional + static_cast<double>(integral)});
+                    else row.push_back(Value{integral});
+                } else {
+                    row.push_back(tuples.empty() ? Value{} : cell(projection, tuples.front()));
+                }
+            }
+            rows.push_back(std::move(row));
+            return Success(std::move(rows));
+        }
+
+        if (grouped) {
+            // Nhóm theo khóa; cột không nằm trong GROUP BY lấy từ hàng đầu tiên của nhóm.
+            // Nhóm được trả về theo thứ tự khóa tăng dần.
+            std::vector<Projection> keys;
+            for (const auto& item : stmt.groupBy) {
+                auto column = binder.resolve(item.column);
+                if (!column) return Failure<Rows>(column.error());
+                keys.push_back({column.value(), item.prefix});
+            }
+            std::map<std::vector<Value>, std::pair<size_t, int64_t>> groups;  ///< khóa -> (tuple đầu tiên, số hàng)
+            std::vector<Value> key;
+            for (size_t t = 0; t < tuples.size(); ++t) {
+                key.clear();
+                for (const auto& projection : keys) key.push_back(cell(projection, tuples[t]));
+                auto [it, inserted] = groups.try_emplace(key, t, 0);
+                ++it->second.second;
+            }
+            rows.reserve(groups.size());
+            size_t skipped = 0;
+            for (const auto& [groupKey, group] : groups) {
+                if (skipped < offset) {
+                    ++skipped;
+                    continue;
+                }
+                if (limit && rows.size() >= *limit) break;
+                std::vector<Value> row;
+                row.reserve(projections.size());
+                for (const auto& projection : projections) {
+                    row.push_back(projection.aggregate == Projection::COUNT ? Value{group.second} : cell(projection, tuples[group.first]));
+                }
+                rows.push_back(std::move(row));
+            }
+            return Success(std::move(rows));
+        }
+
+        rows.reserve(tuples.size());
+        for (const auto& tuple : tuples) {
+            std::vector<Value> row;
+            row.reserve(projections.size());
+            for (const auto& projection : projections) row.push_back(cell(projection, tuple));
+            rows.push_back(std::move(row));
+        }
+        return Success(std::move(rows));
+    }
+
+    /// Các slot khớp WHERE của câu UPDATE/DELETE một bảng
+    Result<std::vector<size_t>> matchingSlots(Database& database, const Table& table,
+                                              const std::vector<Predicate>& where, const std::vector<Value>& params) {
+        std::vector<Source> sources{{&table, table.getName()}};
+        Binder binder(database, sources, params);
+        auto predicates = binder.bind(where);
+        if (!predicates) return Failure<std::vector<size_t>>(predicates.error());
+
+        bool ordered = false;
+        auto candidates = candidateSlots(table, predicates.value(), -1, true, ordered);
+        std::vector<size_t> slots;
+        Tuple tuple(1, 0);
+        for (size_t slot : candidates) {
+            tuple[0] = slot;
+            bool matched = true;
+            for (const auto& predicate : predicates.value()) {
+                if (!test(predicate, sources, tuple)) {
+                    matched = false;
+                    break;
+                }
+            }
+            if (matched) slots.push_back(slot);
+        }
+        return Success(std::move(slots));
+    }
+}
+
+Result<ExecutionResult> execute(Database& database, const Statement& statement, const std::vector<Value>& params,
+                                UndoLog* undo) {
+    ExecutionResult result;
+
+    if (auto select = std::get_if<SelectStmt>(&statement.body)) {
+        auto names = std::make_shared<std::vector<std::string>>();
+        auto rows = runSelect(database, *select, params, names.get());
+        if (!rows) return Failure<ExecutionResult>(rows.error());
+        result.columns = std::move(names);
+        result.rows = std::move(rows.value());
+        return Success(std::move(result));
+    }
+
+    // Ngoài transaction vẫn ghi nhật ký riêng cho câu lệnh để lỗi giữa chừng không để lại nửa thay đổi
+    UndoLog statementLog;
+    UndoLog& log = undo ? *undo : statementLog;
+    const size_t mark = log.size();
+
+    if (auto insert = std::get_if<InsertStmt>(&statement.body)) {
+        Table* table = database.findTable(insert->table);
+        if (!table) return Failure<ExecutionResult>(CoreError("Table '" + insert->table + "' doesn't exist", "UNKNOWN_TABLE"));
+
+        std::vector<int> columns;
+        for (const auto& name : insert->columns) {
+            int column = table->columnIndex(name);
+            if (column < 0) return Failure<ExecutionResult>(CoreError("Unknown column '" + name + "'", "UNKNOWN_COLUMN"));
+            columns.push_back(column);
+        }
+
+        std::vector<Source> sources{{table, table->getName()}};
+        Binder binder(database, sources, params);
+        size_t inserted = 0;
+        for (const auto& values : insert->rows) {
+            std::vector<Value> row;
+            row.reserve(table->getColumns().size());
+            for (const auto& column : table->getColumns()) row.push_back(column.defaultValue);
+            row[0] = Value{};
+
+            for (size_t i = 0; i < values.size(); ++i) {
+                auto value = binder.bind(values[i]);
+                if (!value || !value.value().isConstant) {
+                    log.rollbackTo(mark);
+                    return Failure<ExecutionResult>(value ? CoreError("INSERT values must be constant", "UNSUPPORTED_SQL") : value.error());
+                }
+                row[columns[i]] = coerce(value.value().constant, table->getColumns()[columns[i]].type);
+            }
+
+            bool generatedId = isNull(row[0]);
+            auto slot = table->insert(std::move(row));
+            if (!slot) {
+                log.rollbackTo(mark);
+                return Failure<ExecutionResult>(slot.error());
+            }
+            if (inserted == 0 && generatedId) {
+                result.lastInsertId = std::get<int64_t>(table->row(slot.value())[0]);
+            }
+            log.recordInsert(*table, slot.value());
+            ++inserted;
+        }
+        result.affectedRows = static_cast<int>(inserted);
+        return Success(std::move(result));
+    }
+
+    if (auto update = std::get_if<UpdateStmt>(&statement.body)) {
+        Table* table = database.findTable(update->table);
+        if (!table) return Failure<ExecutionResult>(CoreError("Table '" + update->table + "' doesn't exist", "UNKNOWN_TABLE"));
+
+        std::vector<Source> sources{{table, table->getName()}};
+        Binder binder(database, sources, params);
+        std::vector<std::pair<int, BoundExpr>> assignments;
+        for (const auto& [name, expr] : update->assignments) {
+            int column = table->columnIndex(name);
+            if (column < 0) return Failure<ExecutionResult>(CoreError("Unknown column '" + name + "'", "UNKNOWN_COLUMN"));
+            auto value = binder.bind(expr);
+            if (!value) return Failure<ExecutionResult>(value.error());
+            assignments.emplace_back(column, std::move(value.value()));
+        }
+
+        auto slots = matchingSlots(database, *table, update->where, params);
+        if (!slots) return Failure<ExecutionResult>(slots.error());
+
+        Tuple tuple(1, 0);
+        for (size_t slot : slots.value()) {
+            tuple[0] = slot;
+            auto before = table->row(slot);
+            auto row = before;
+            for (const auto& [column, expr] : assignments) {
+                row[column] = coerce(evaluate(expr, sources, tuple), table->getColumns()[column].type);
+            }
+            auto changed = table->replace(slot, std::move(row));
+            if (!changed) {
+                log.rollbackTo(mark);
+                return Failure<ExecutionResult>(changed.error());
+            }
+            if (changed.value()) {
+                log.recordUpdate(*table, slot, std::move(before));
+                ++result.affectedRows;
+            }
+        }
+        return Success(std::move(result));
+    }
+
+    const auto& remove = std::get<DeleteStmt>(statement.body);
+    Table* table = database.findTable(remove.table);
+    if (!table) return Failure<ExecutionResult>(CoreError("Table '" + remove.table + "' doesn't exist", "UNKNOWN_TABLE"));
+
+    auto slots = matchingSlots(database, *table, remove.where, params);
+    if (!slots) return Failure<ExecutionResult>(slots.error());
+    for (size_t slot : slots.value()) {
+        // DELETE không lỗi giữa chừng nên chỉ cần nhật ký khi đang trong transaction
+        if (undo) undo->recordErase(*table, slot, table->row(slot));
+        table->erase(slot);
+    }
+    result.affectedRows = static_cast<int>(slots.value().size());
+    return Success(std::move(result));
+}
+
+}
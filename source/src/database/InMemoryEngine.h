@@ -0,0 +1,334 @@
+/**
+ * @file InMemoryEngine.h
+ * @brief Bộ máy lưu trữ và thực thi SQL trong bộ nhớ cho InMemoryConnection
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Chỉ hỗ trợ tập con SQL mà các truy vấn trong Tables::* và repository đang dùng:
+ * - SELECT danh sách cột / LEFT(cột, n) / * / alias.* / COUNT(*) FROM bảng [alias] [JOIN bảng alias ON a.x = b.y]...
+ *   [WHERE điều kiện AND ...] [GROUP BY cột | LEFT(cột, n), ...] [ORDER BY cột [ASC|DESC], ...] [LIMIT n [OFFSET m]]
+ *   (GROUP BY trả nhóm theo thứ tự khóa và không đi cùng ORDER BY)
+ * - COUNT(DISTINCT cột), MAX(cột), SUM(cột) chỉ khi không có GROUP BY: cả kết quả gộp thành một hàng
+ * - Điều kiện: so sánh (=, !=, <>, <, <=, >, >=) giữa cột, tham số ?, hằng số;
+ *   cột [NOT] IN (danh sách) và cột [NOT] IN (SELECT ...) không tương quan
+ * - INSERT INTO bảng (cột, ...) VALUES (...), (...)
+ * - UPDATE bảng SET cột = biểu thức, ... [WHERE ...] với biểu thức dạng cột + 1
+ * - DELETE FROM bảng [WHERE ...]
+ *
+ * Mỗi bảng có khóa chính id tự tăng, chỉ mục băm (tra cứu bằng =, IN, JOIN) và chỉ mục có thứ tự
+ * (quét khoảng và ORDER BY). Câu lệnh được phân tích một lần và dùng lại cho mọi lần thực thi.
+ */
+
+#ifndef IN_MEMORY_ENGINE_H
+#define IN_MEMORY_ENGINE_H
+
+#include "../core/exceptions/Result.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace InMemory {
+    /// Giá trị một ô: NULL, số nguyên, số thực hoặc chuỗi (DATETIME lưu dạng "YYYY-MM-DD HH:MM:SS")
+    using Value = std::variant<std::monostate, int64_t, double, std::string>;
+
+    enum class ColumnType {
+        INT,
+        DOUBLE,
+        TEXT,
+        DATETIME,
+        BOOL
+    };
+
+    enum class IndexKind {
+        HASH,     ///< Tra cứu bằng nhau: =, IN, điều kiện JOIN
+        ORDERED   ///< Quét khoảng (<, <=, >, >=) và ORDER BY
+    };
+
+    struct ColumnDef {
+        std::string name;
+        ColumnType type;
+        Value defaultValue{};
+    };
+
+    struct IndexDef {
+        std::string column;
+        IndexKind kind;
+        bool unique = false;
+    };
+
+    /**
+     * @brief Chuyển giá trị về kiểu lưu trữ của cột
+     * @param value Giá trị đầu vào
+     * @param type Kiểu cột
+     * @return Giá trị đã chuẩn hóa; NULL giữ nguyên
+     */
+    Value coerce(const Value& value, ColumnType type);
+
+    /**
+     * @brief Biểu diễn chuỗi của một giá trị
+     */
+    std::string toString(const Value& value);
+
+    /**
+     * @brief So sánh theo ngữ nghĩa SQL: số so sánh theo số, còn lại so sánh chuỗi
+     * @return <0, 0, >0; hoặc nullopt nếu một bên là NULL
+     */
+    std::optional<int> compare(const Value& lhs, const Value& rhs);
+
+    /**
+     * @brief Một bảng trong bộ nhớ
+     *
+     * Hàng được lưu theo slot; slot của hàng đã xóa bị đánh dấu trống và không được tái sử dụng,
+     * nên chỉ số slot giữ ổn định cho các chỉ mục. Cột đầu tiên luôn là khóa chính "id" tự tăng.
+     */
+    class Table {
+    private:
+        struct HashIndex {
+            int column;
+            bool unique;
+            std::unordered_multimap<Value, size_t> entries;
+        };
+
+        struct OrderedIndex {
+            int column;
+            std::multimap<Value, size_t> entries;
+        };
+
+        std::string _name;
+        std::vector<ColumnDef> _columns;
+        std::unordered_map<std::string, int> _columnIndex;
+        std::vector<std::vector<Value>> _rows;
+        std::vector<bool> _live;
+        size_t _liveCount = 0;
+        int64_t _nextId = 1;
+        std::vector<HashIndex> _hashIndexes;
+        std::vector<OrderedIndex> _orderedIndexes;
+
+        void indexRow(size_t slot);
+        void unindexRow(size_t slot);
+        Result<bool> checkUnique(const std::vector<Value>& row, const size_t* ignoreSlot) const;
+
+    public:
+        /**
+         * @brief Tạo bảng; cột "id" kiểu INT được thêm vào đầu nếu chưa khai báo
+         * @param name Tên bảng
+         * @param columns Các cột
+         * @param indexes Chỉ mục phụ; khóa chính luôn có chỉ mục băm và chỉ mục có thứ tự
+         */
+        Table(std::string name, std::vector<ColumnDef> columns, const std::vector<IndexDef>& indexes = {});
+
+        const std::string& getName() const { return _name; }
+        const std::vector<ColumnDef>& getColumns() const { return _columns; }
+        size_t size() const { return _liveCount; }
+        size_t slotCount() const { return _rows.size(); }
+        bool isLive(size_t slot) const { return slot < _live.size() && _live[slot]; }
+        const std::vector<Value>& row(size_t slot) const { return _rows[slot]; }
+
+        /**
+         * @brief Chỉ số cột theo tên
+         * @return Chỉ số cột hoặc -1 nếu không có
+         */
+        int columnIndex(const std::string& name) const;
+
+        /**
+         * @brief Chèn một hàng; id trống sẽ được cấp tự động
+         * @param row Hàng đủ số cột, giá trị đã chuẩn hóa theo kiểu cột
+         * @return Slot của hàng mới hoặc lỗi trùng khóa duy nhất
+         */
+        Result<size_t> insert(std::vector<Value> row);
+
+        /**
+         * @brief Ghi đè một hàng đang tồn tại và cập nhật chỉ mục
+         * @param slot Slot của hàng
+         * @param row Giá trị mới
+         * @return true nếu có giá trị thay đổi, lỗi nếu vi phạm khóa duy nhất
+         */
+        Result<bool> replace(size_t slot, std::vector<Value> row);
+
+        /**
+         * @brief Xóa một hàng
+         */
+        void erase(size_t slot);
+
+        /**
+         * @brief Đặt lại nội dung một slot (kể cả slot đã xóa) khi hoàn tác
+         *
+         * Vẫn kiểm tra khóa duy nhất: giá trị cũ từng hợp lệ, nhưng hàng khác có thể đã lấy khóa đó.
+         * @param slot Slot cần khôi phục
+         * @param row Giá trị cũ của hàng
+         * @return true nếu đã khôi phục, lỗi DUPLICATE_ENTRY (slot giữ nguyên) nếu vi phạm khóa duy nhất
+         */
+        Result<bool> restore(size_t slot, std::vector<Value> row);
+
+        /**
+         * @brief Tra cứu bằng chỉ mục băm
+         * @param column Chỉ số cột
+         * @param key Giá trị cần tìm
+         * @param out Các slot tìm thấy được thêm vào đây
+         * @return false nếu cột không có chỉ mục băm
+         */
+        bool lookup(int column, const Value& key, std::vector<size_t>& out) const;
+
+        /**
+         * @brief Chỉ mục có thứ tự của cột, nếu có
+         */
+        const std::multimap<Value, size_t>* orderedIndex(int column) const;
+    };
+
+    /**
+     * @brief Nhật ký hoàn tác của một transaction hoặc một câu lệnh
+     *
+     * Ghi giá trị cũ của từng hàng bị chèn, sửa hoặc xóa, nên rollback chỉ chạm các hàng
+     * mà chính transaction đó đã ghi thay vì khôi phục cả cơ sở dữ liệu. Con trỏ bảng phải
+     * còn hợp lệ: không tạo lại bảng khi nhật ký chưa được xử lý.
+     */
+    class UndoLog {
+    private:
+        enum class Change {
+            INSERTED,
+            UPDATED,
+            ERASED
+        };
+
+        struct Entry {
+            Table* table;
+            size_t slot;
+            Change change;
+            std::vector<Value> before;  ///< Rỗng với INSERTED
+        };
+
+        std::vector<Entry> _entries;
+
+    public:
+        void recordInsert(Table& table, size_t slot);
+        void recordUpdate(Table& table, size_t slot, std::vector<Value> before);
+        void recordErase(Table& table, size_t slot, std::vector<Value> before);
+
+        size_t size() const { return _entries.size(); }
+        bool empty() const { return _entries.empty(); }
+        void clear() { _entries.clear(); }
+
+        /**
+         * @brief Hoàn tác theo thứ tự ngược các thay đổi ghi sau mốc cho trước rồi bỏ chúng khỏi nhật ký
+         * @param mark Kích thước nhật ký tại thời điểm cần quay về
+         * @return Lỗi của hàng đầu tiên không khôi phục được; các hàng còn lại vẫn được hoàn tác
+         */
+        VoidResult rollbackTo(size_t mark = 0);
+    };
+
+    /**
+     * @brief Tập các bảng, dùng chung được giữa nhiều kết nối
+     *
+     * Không sao chép được; người gọi giữ lock() hoặc lockFor() trong suốt mỗi lần đọc hoặc ghi.
+     *
+     * Transaction được tuần tự hóa: từ beginTransaction tới endTransaction chỉ phiên đang giữ
+     * transaction chạy được câu lệnh, các phiên khác chờ trong lockFor. Nhờ vậy không phiên nào
+     * thấy thay đổi chưa commit, và rollback khôi phục ảnh trước mà không đè lên lệnh ghi của
+     * phiên khác (tương đương SERIALIZABLE, với khóa cả cơ sở dữ liệu thay vì khóa hàng).
+     */
+    class Database {
+    private:
+        std::map<std::string, Table> _tables;
+        mutable std::mutex _mutex;
+        mutable std::condition_variable _transactionEnded;
+        const void* _transactionOwner = nullptr;    ///< Phiên đang mở transaction; chỉ đọc/ghi khi giữ _mutex
+        std::chrono::milliseconds _lockWaitTimeout{DEFAULT_LOCK_WAIT_TIMEOUT};
+
+    public:
+        /// Thời gian chờ transaction của phiên khác, như innodb_lock_wait_timeout mặc định của MySQL
+        static constexpr std::chrono::milliseconds DEFAULT_LOCK_WAIT_TIMEOUT{50000};
+
+        Database() = default;
+        Database(const Database&) = delete;
+        Database& operator=(const Database&) = delete;
+
+        /**
+         * @brief Khóa toàn cơ sở dữ liệu cho một thao tác, bỏ qua transaction đang mở
+         * @note Chỉ dùng để nạp dữ liệu trực tiếp; câu lệnh của kết nối đi qua lockFor
+         */
+        std::unique_lock<std::mutex> lock() const { return std::unique_lock<std::mutex>(_mutex); }
+
+        /**
+         * @brief Khóa toàn cơ sở dữ liệu cho một câu lệnh của session
+         *
+         * Chờ trong khi một session khác đang mở transaction.
+         * @param session Định danh phiên (địa chỉ kết nối)
+         * @return Khóa đang giữ, hoặc lỗi LOCK_WAIT_TIMEOUT nếu chờ quá thời gian chờ
+         */
+        Result<std::unique_lock<std::mutex>> lockFor(const void* session) const;
+
+        /// Ghi nhận session mở transaction; gọi khi đang giữ khóa lấy từ lockFor(session)
+        void beginTransaction(const void* session) { _transactionOwner = session; }
+
+        /// Kết thúc transaction của session và đánh thức các phiên đang chờ; gọi khi đang giữ khóa
+        void endTransaction(const void* session);
+
+        /// Đổi thời gian chờ của lockFor (test dùng giá trị nhỏ)
+        void setLockWaitTimeout(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Tạo bảng mới (thay thế nếu đã tồn tại)
+         */
+        Table& createTable(const std::string& name, std::vector<ColumnDef> columns, const std::vector<IndexDef>& indexes = {});
+
+        Table* findTable(const std::string& name);
+        const Table* findTable(const std::string& name) const;
+
+        /**
+         * @brief Tạo cơ sở dữ liệu rỗng có cùng lược đồ với schema.sql
+         *
+         * Gồm aircraft, seat_class (đã có E/B/F), aircraft_seat_layout, flight, passenger, ticket,
+         * flight_seat_availability cùng chỉ mục trên các cột mà repository dùng để tra cứu.
+         * Ràng buộc duy nhất nhiều cột (flight_id, seat_number) không được kiểm tra.
+         */
+        static std::shared_ptr<Database> createAirlinesSchema();
+    };
+
+    /// Câu lệnh đã phân tích; định nghĩa trong InMemoryEngine.cpp
+    struct Statement;
+
+    /**
+     * @brief Phân tích một câu SQL
+     * @return Câu lệnh đã phân tích hoặc lỗi UNSUPPORTED_SQL
+     */
+    Result<std::shared_ptr<const Statement>> parse(const std::string& sql);
+
+    /**
+     * @brief Số tham số ? trong câu lệnh
+     */
+    size_t parameterCount(const Statement& statement);
+
+    /**
+     * @brief Câu lệnh có trả về tập kết quả hay không
+     */
+    bool isQuery(const Statement& statement);
+
+    struct ExecutionResult {
+        std::shared_ptr<const std::vector<std::string>> columns;
+        std::vector<std::vector<Value>> rows;
+        int affectedRows = 0;
+        int64_t lastInsertId = 0;  ///< Id đầu tiên được cấp bởi INSERT, 0 nếu không có
+    };
+
+    /**
+     * @brief Thực thi câu lệnh trên cơ sở dữ liệu
+     * @param database Cơ sở dữ liệu đích
+     * @param statement Câu lệnh đã phân tích
+     * @param params Giá trị tham số theo thứ tự ?
+     * @param undo Nhật ký nhận các thay đổi của câu lệnh; nullptr khi không trong transaction.
+     *             Câu lệnh lỗi giữa chừng luôn được hoàn tác hết trước khi trả lỗi.
+     */
+    Result<ExecutionResult> execute(Database& database, const Statement& statement, const std::vector<Value>& params,
+                                    UndoLog* undo = nullptr);
+}
+
+#endif // IN_MEMORY_ENGINE_H
@@ -369,6 +369,22 @@ public:
     */
     virtual Result<bool> executeStatement(const int& statementId) = 0;
 
+    /**
+    * @brief Thực thi prepared statement và trả về số hàng bị ảnh hưởng.
+    * 
+    * @param statementId ID của statement cần thực thi
+    * 
+    * @return Result<int> 
+    *         - Success: Số hàng bị ảnh hưởng (0 nếu điều kiện WHERE không khớp hàng nào)
+    *         - Failure: Statement không tồn tại, thiếu parameter, hoặc SQL error
+    * 
+    * @note Số hàng được lấy cùng lúc với việc thực thi, nên không bị câu lệnh của luồng
+    *       khác dùng chung kết nối ghi đè
+    * @note Dùng cho UPDATE có điều kiện theo cột version: 0 hàng nghĩa là bản ghi
+    *       đã bị thay đổi bởi phiên khác hoặc không tồn tại
+    */
+    virtual Result<int> executeUpdate(const int& statementId) = 0;
+
     /**
     * @brief Thực thi prepared statement có trả về kết quả.
     * 
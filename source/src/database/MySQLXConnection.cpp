@@ -22,6 +22,7 @@
 
 #include "MySQLXConnection.h"
 #include "../utils/Logger.h"
+#include "../utils/Tracing.h"
 #include <sstream>
 #include <stdexcept>
 #include <iomanip>
@@ -56,6 +57,18 @@ MySQLXResult::MySQLXResult(mysqlx::RowResult rowResult)
     }
 }
 
+MySQLXResult::~MySQLXResult() {
+    finish();
+}
+
+void MySQLXResult::finish() {
+    if (_onFinished) {
+        auto callback = std::move(_onFinished);
+        _onFinished = nullptr;
+        callback(_rowsFetched);
+    }
+}
+
 Result<bool> MySQLXResult::next() {
     auto logger = Logger::getInstance();
     
@@ -63,12 +76,14 @@ Result<bool> MySQLXResult::next() {
         _currentRow = _rowResult.fetchOne();
         if (_currentRow) {
             _hasCurrentRow = true;
+            ++_rowsFetched;
             logger->debug("Retrieved row from result set");
             return Success(true);
         }
         
         _hasCurrentRow = false;
         logger->debug("No more rows in result set");
+        finish();
         return Success(false);
     }
     catch (const std::exception& e) {
@@ -333,7 +348,11 @@ std::shared_ptr<MySQLXConnection> MySQLXConnection::getInstance() {
     return _instance;
 }
 
-MySQLXConnection::MySQLXConnection() : _nextStatementId(1) {
+std::shared_ptr<MySQLXConnection> MySQLXConnection::createSession() {
+    return std::shared_ptr<MySQLXConnection>(new MySQLXConnection());
+}
+
+MySQLXConnection::MySQLXConnection() : _nextStatementId(1), _queryStats(std::make_shared<QueryStats>()) {
     auto logger = Logger::getInstance();
     logger->debug("MySQLXConnection instance created");
 }
@@ -401,9 +420,18 @@ VoidResult MySQLXConnection::disconnect() {
 Result<bool> MySQLXConnection::execute(const std::string& query) {
     auto logger = Logger::getInstance();
     logger->debug("Executing SQL: " + query);
+    Tracing::Span span("sql.execute", "sql");
+    if (span.isActive()) span.setArg("sql", query);
+    
+    // Số đo cho QueryStats
+    auto waitStart = std::chrono::steady_clock::now();
+    auto execStart = waitStart;
+    std::chrono::nanoseconds lockWait{0};
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
+        execStart = std::chrono::steady_clock::now();
+        lockWait = execStart - waitStart;
         
         if (!_session) {
             _lastError = "Not connected to database";
@@ -411,11 +439,13 @@ Result<bool> MySQLXConnection::execute(const std::string& query) {
             return Failure<bool>(CoreError("Not connected to database"));
         }
         
-        _session->sql(query).execute();
+        mysqlx::SqlResult result = _session->sql(query).execute();
+        _queryStats->record(query, std::chrono::steady_clock::now() - execStart, result.getAffectedItemsCount(), lockWait);
         logger->debug("SQL executed successfully");
         return Success(true);
     }
     catch (const mysqlx::Error& e) {
+        _queryStats->record(query, std::chrono::steady_clock::now() - execStart, 0, lockWait, false);
         _lastError = e.what();
         logger->error("MySQL error executing SQL: " + std::string(e.what()));
         return Failure<bool>(CoreError("MySQL error executing SQL: " + std::string(e.what())));
@@ -430,9 +460,18 @@ Result<bool> MySQLXConnection::execute(const std::string& query) {
 Result<std::unique_ptr<IDatabaseResult>> MySQLXConnection::executeQuery(const std::string& query) {
     auto logger = Logger::getInstance();
     logger->debug("Executing query: " + query);
+    Tracing::Span span("sql.query", "sql");
+    if (span.isActive()) span.setArg("sql", query);
+    
+    // Số đo cho QueryStats
+    auto waitStart = std::chrono::steady_clock::now();
+    auto execStart = waitStart;
+    std::chrono::nanoseconds lockWait{0};
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
+        execStart = std::chrono::steady_clock::now();
+        lockWait = execStart - waitStart;
         
         if (!_session) {
             _lastError = "Not connected to database";
@@ -441,17 +480,25 @@ Result<std::unique_ptr<IDatabaseResult>> MySQLXConnection::executeQuery(const st
         }
         
         mysqlx::SqlResult result = _session->sql(query).execute();
+        std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - execStart;
         logger->debug("Query executed successfully");
         
         // Check if this is a result-producing query
         if (result.hasData()) {
-            return Success(std::make_unique<MySQLXResult>(std::move(result)));
+            // Số hàng được đếm khi người gọi đọc, không gọi count() để khỏi nạp trước cả tập kết quả
+            auto rows = std::make_unique<MySQLXResult>(std::move(result));
+            rows->onFinished([stats = _queryStats, query, latency, lockWait](uint64_t rowCount) {
+                stats->record(query, latency, rowCount, lockWait);
+            });
+            return Success<std::unique_ptr<IDatabaseResult>>(std::move(rows));
         } else {
+            _queryStats->record(query, latency, 0, lockWait);
             logger->debug("Query did not return any data");
             return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("Query did not return any data"));
         }
     }
     catch (const mysqlx::Error& e) {
+        _queryStats->record(query, std::chrono::steady_clock::now() - execStart, 0, lockWait, false);
         _lastError = e.what();
         logger->error("MySQL error executing query: " + std::string(e.what()));
         return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("MySQL error executing query: " + std::string(e.what())));
@@ -667,54 +714,84 @@ Result<std::string> MySQLXConnection::buildPreparedStatement(const PreparedState
 }
 
 Result<bool> MySQLXConnection::executeStatement(const int& statementId) {
+    auto result = executeUpdate(statementId);
+    if (!result) return Failure<bool>(result.error());
+    return Success(true);
+}
+
+Result<int> MySQLXConnection::executeUpdate(const int& statementId) {
     auto logger = Logger::getInstance();
     logger->debug("Executing prepared statement with ID: " + std::to_string(statementId));
+    Tracing::Span span("sql.execute", "sql");
+    
+    std::string statsQuery;
+    // Số đo cho QueryStats
+    auto waitStart = std::chrono::steady_clock::now();
+    auto execStart = waitStart;
+    std::chrono::nanoseconds lockWait{0};
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
+        execStart = std::chrono::steady_clock::now();
+        lockWait = execStart - waitStart;
         
         auto it = _preparedStatements.find(statementId);
         if (it == _preparedStatements.end()) {
             _lastError = "Invalid statement ID";
             logger->error("Cannot execute statement: Invalid statement ID " + std::to_string(statementId));
-            return Failure<bool>(CoreError("Invalid statement ID"));
+            return Failure<int>(CoreError("Invalid statement ID"));
         }
         
         const PreparedStatementData& data = it->second;
+        statsQuery = data.query;
+        if (span.isActive()) span.setArg("sql", data.query);
         
         // Xây dựng câu lệnh SQL cuối cùng từ prepared statement
         auto finalQueryResult = buildPreparedStatement(data);
         if (!finalQueryResult) {
-            return Failure<bool>(finalQueryResult.error());
+            return Failure<int>(finalQueryResult.error());
         }
         
         std::string finalQuery = finalQueryResult.value();
         logger->debug("Executing prepared statement: " + finalQuery);
         
         // Thực thi câu lệnh SQL đã xây dựng trực tiếp
-        _session->sql(finalQuery).execute();
+        mysqlx::SqlResult result = _session->sql(finalQuery).execute();
+        // Đọc số hàng trong cùng lần giữ khóa: câu lệnh của luồng khác không chen vào được
+        int affectedRows = static_cast<int>(result.getAffectedItemsCount());
+        _queryStats->record(finalQuery, std::chrono::steady_clock::now() - execStart, affectedRows, lockWait);
         
         logger->debug("Statement executed successfully");
-        return Success(true);
+        return Success(affectedRows);
     }
     catch (const mysqlx::Error& e) {
+        _queryStats->record(statsQuery, std::chrono::steady_clock::now() - execStart, 0, lockWait, false);
         _lastError = e.what();
         logger->error("MySQL error executing statement: " + std::string(e.what()));
-        return Failure<bool>(CoreError("MySQL error executing statement: " + std::string(e.what())));
+        return Failure<int>(CoreError("MySQL error executing statement: " + std::string(e.what())));
     }
     catch (const std::exception& e) {
         _lastError = e.what();
         logger->error("Unexpected error executing statement: " + std::string(e.what()));
-        return Failure<bool>(CoreError("Unexpected error executing statement: " + std::string(e.what())));
+        return Failure<int>(CoreError("Unexpected error executing statement: " + std::string(e.what())));
     }
 }
 
 Result<std::unique_ptr<IDatabaseResult>> MySQLXConnection::executeQueryStatement(const int& statementId) {
     auto logger = Logger::getInstance();
     logger->debug("Executing query prepared statement with ID: " + std::to_string(statementId));
+    Tracing::Span span("sql.query", "sql");
+    
+    std::string statsQuery;
+    // Số đo cho QueryStats
+    auto waitStart = std::chrono::steady_clock::now();
+    auto execStart = waitStart;
+    std::chrono::nanoseconds lockWait{0};
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
+        execStart = std::chrono::steady_clock::now();
+        lockWait = execStart - waitStart;
         
         auto it = _preparedStatements.find(statementId);
         if (it == _preparedStatements.end()) {
@@ -723,6 +800,9 @@ Result<std::unique_ptr<IDatabaseResult>> MySQLXConnection::executeQueryStatement
             return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("Invalid statement ID"));
         }
         
+        statsQuery = it->second.query;
+        if (span.isActive()) span.setArg("sql", it->second.query);
+
         // Build the statement with parameters
         auto finalQueryResult = buildPreparedStatement(it->second);
         if (!finalQueryResult) {
@@ -734,17 +814,24 @@ Result<std::unique_ptr<IDatabaseResult>> MySQLXConnection::executeQueryStatement
         
         // Execute the statement as a query
         mysqlx::SqlResult result = _session->sql(finalQuery).execute();
+        std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - execStart;
         logger->debug("Query statement executed successfully");
         
         // Check if this is a result-producing query
         if (result.hasData()) {
-            return Success(std::make_unique<MySQLXResult>(std::move(result)));
+            auto rows = std::make_unique<MySQLXResult>(std::move(result));
+            rows->onFinished([stats = _queryStats, finalQuery, latency, lockWait](uint64_t rowCount) {
+                stats->record(finalQuery, latency, rowCount, lockWait);
+            });
+            return Success<std::unique_ptr<IDatabaseResult>>(std::move(rows));
         } else {
+            _queryStats->record(finalQuery, latency, 0, lockWait);
             logger->debug("Query did not return any data");
             return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("Query did not return any data"));
         }
     }
     catch (const mysqlx::Error& e) {
+        _queryStats->record(statsQuery, std::chrono::steady_clock::now() - execStart, 0, lockWait, false);
         _lastError = e.what();
         logger->error("MySQL error executing query statement: " + std::string(e.what()));
         return Failure<std::unique_ptr<IDatabaseResult>>(CoreError("MySQL error executing query statement: " + std::string(e.what())));
@@ -830,6 +917,7 @@ Result<std::string> MySQLXConnection::getLastError() const {
 Result<bool> MySQLXConnection::beginTransaction() {
     auto logger = Logger::getInstance();
     logger->debug("Beginning database transaction");
+    Tracing::Span span("sql.begin", "sql");
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -862,6 +950,7 @@ Result<bool> MySQLXConnection::beginTransaction() {
 Result<bool> MySQLXConnection::commitTransaction() {
     auto logger = Logger::getInstance();
     logger->debug("Committing database transaction");
+    Tracing::Span span("sql.commit", "sql");
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -894,6 +983,7 @@ Result<bool> MySQLXConnection::commitTransaction() {
 Result<bool> MySQLXConnection::rollbackTransaction() {
     auto logger = Logger::getInstance();
     logger->debug("Rolling back database transaction");
+    Tracing::Span span("sql.rollback", "sql");
     
     try {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -16,6 +16,7 @@
 #define MYSQLX_CONNECTION_H
 
 #include "InterfaceDatabaseConnection.h"
+#include "QueryStats.h"
 #include <mysqlx/xdevapi.h>
 #include <memory>
 #include <unordered_map>
@@ -25,6 +26,7 @@
 #include <chrono>
 #include <string>
 #include <ctime>
+#include <functional>
 
 /**
  * @class MySQLXResult
@@ -50,6 +52,13 @@ private:
     std::vector<std::string> _columnNames;   ///< Danh sách tên cột từ metadata
     bool _hasData;                           ///< Cờ đánh dấu có dữ liệu trong result set
     bool _hasCurrentRow = false;             ///< Cờ kiểm tra hàng hiện tại đã được nạp chưa
+    uint64_t _rowsFetched = 0;               ///< Số hàng next() đã đọc
+    std::function<void(uint64_t)> _onFinished; ///< Nhận _rowsFetched một lần khi hết hàng hoặc khi hủy
+
+    /**
+     * @brief Gọi _onFinished đúng một lần
+     */
+    void finish();
 
 public:
     /**
@@ -71,10 +80,21 @@ public:
      * @brief Destructor mặc định.
      * 
      * @details
-     * Tự động giải phóng tài nguyên của MySQL X DevAPI.
-     * Không cần xử lý đặc biệt do sử dụng RAII.
+     * Tự động giải phóng tài nguyên của MySQL X DevAPI. Nếu người gọi dừng trước khi
+     * duyệt hết, _onFinished nhận số hàng đã thực sự đọc.
+     */
+    ~MySQLXResult() override;
+
+    /**
+     * @brief Đăng ký hàm nhận số hàng đã đọc
+     *
+     * @param callback Gọi một lần khi next() trả về false hoặc khi result bị hủy
+     *
+     * @details
+     * Dùng cho QueryStats: đếm hàng theo nhịp người gọi đọc thay vì gọi count(),
+     * vốn buộc driver nạp toàn bộ tập kết quả vào bộ nhớ trước khi trả hàng đầu tiên.
      */
-    ~MySQLXResult() override = default;
+    void onFinished(std::function<void(uint64_t rowsFetched)> callback) { _onFinished = std::move(callback); }
 
     /**
      * @brief Di chuyển con trỏ đến hàng kết quả tiếp theo.
@@ -248,6 +268,7 @@ private:
     int _nextStatementId;   ///< Bộ đếm tạo ID duy nhất cho statement
     std::string _currentSchema; ///< Tên cơ sở dữ liệu đang sử dụng
     std::mutex _mutex; ///< Bảo vệ dữ liệu dùng chung trong môi trường đa luồng
+    std::shared_ptr<QueryStats> _queryStats; ///< Độ trễ, số hàng và thời gian chờ mutex theo từng câu lệnh
 
     /**
      * @brief Xây dựng chuỗi SQL từ dữ liệu statement và giá trị tham số.
@@ -312,6 +333,17 @@ public:
      */
     static std::shared_ptr<MySQLXConnection> getInstance();
 
+    /**
+     * @brief Tạo một kết nối độc lập với singleton, có session và mutex riêng.
+     *
+     * @return std::shared_ptr<MySQLXConnection> Kết nối chưa mở, cần gọi connect()
+     *
+     * @details
+     * Dùng cho ConnectionPool khi nhiều luồng cần session riêng để transaction không xen nhau.
+     * Giao diện và các tiện ích một phiên vẫn dùng getInstance().
+     */
+    static std::shared_ptr<MySQLXConnection> createSession();
+
     // Implementation của IDatabaseConnection interface
     Result<bool> connect(const std::string& host, const std::string& user,
                  const std::string& password, const std::string& database,
@@ -329,6 +361,7 @@ public:
     VoidResult setDateTime(const int& statementId, const int& paramIndex, const std::tm& value) override;
 
     Result<bool> executeStatement(const int& statementId) override;
+    Result<int> executeUpdate(const int& statementId) override;
     Result<std::unique_ptr<IDatabaseResult>> executeQueryStatement(const int& statementId) override;
     VoidResult freeStatement(const int& statementId) override;
 
@@ -339,6 +372,31 @@ public:
     Result<bool> beginTransaction() override;
     Result<bool> commitTransaction() override;
     Result<bool> rollbackTransaction() override;
+
+    /**
+     * @brief Thống kê các câu lệnh đã thực thi qua execute/executeQuery/executeStatement/executeQueryStatement
+     * @return Tham chiếu tới bộ thống kê; dump() để xem các câu lệnh tốn thời gian nhất
+     *
+     * @note Số hàng của câu SELECT được ghi khi người gọi duyệt hết hoặc hủy tập kết quả
+     */
+    QueryStats& getQueryStats() { return *_queryStats; }
+
+    /**
+     * @brief Ghi số đo vào bộ thống kê dùng chung, ví dụ cho mọi session của một ConnectionPool
+     * @param stats Bộ thống kê; nullptr được bỏ qua
+     */
+    void setQueryStats(std::shared_ptr<QueryStats> stats) {
+        if (stats) _queryStats = std::move(stats);
+    }
+
+    /**
+     * @brief Cấu hình nhật ký truy vấn chậm
+     * @param threshold Truy vấn có thời gian thực thi từ ngưỡng này trở lên được ghi; 0 để tắt
+     * @param sink Nơi ghi riêng, ví dụ std::make_shared<FileLogHandler>("slow_query.log")
+     */
+    void setSlowQueryLog(std::chrono::milliseconds threshold, std::shared_ptr<ILogHandler> sink) {
+        _queryStats->setSlowQueryLog(threshold, std::move(sink));
+    }
 };
 
 #endif // MYSQLX_CONNECTION_H
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "QueryStats.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+// === LatencyHistogram ===
+
+size_t LatencyHistogram::indexOf(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    int exponent = 63 - std::countl_zero(value);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    uint64_t mantissa = value >> (exponent - SUB_BUCKET_BITS);  // trong [32, 64)
+    return static_cast<size_t>(SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT + (mantissa - SUB_BUCKET_COUNT));
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    size_t offset = index - SUB_BUCKET_COUNT;
+    int exponent = static_cast<int>(offset / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS;
+    uint64_t mantissa = offset % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((mantissa + 1) << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    if (_counts.empty()) {
+        _counts.assign(BUCKET_COUNT, 0);
+    }
+    ++_counts[indexOf(value)];
+    ++_totalCount;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other._totalCount == 0) return;
+    if (_counts.empty()) {
+        _counts.assign(BUCKET_COUNT, 0);
+    }
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _totalCount += other._totalCount;
+    _sum += other._sum;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (_totalCount == 0) return 0;
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * _totalCount)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += _counts[i];
+        if (seen >= target) {
+            return std::min(highestEquivalentValue(i), _max);
+        }
+    }
+    return _max;
+}
+
+// === QueryStats ===
+
+std::string QueryStats::normalize(const std::string& sql) {
+    std::string out;
+    out.reserve(sql.size());
+
+    auto isIdentifierChar = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+
+    for (size_t i = 0; i < sql.size();) {
+        char c = sql[i];
+        if (c == '\'') {
+            // Chuỗi, kể cả nháy đơn được nhân đôi
+            ++i;
+            while (i < sql.size()) {
+                if (sql[i] == '\'' && i + 1 < sql.size() && sql[i + 1] == '\'') {
+                    i += 2;
+                } else if (sql[i] == '\'') {
+                    ++i;
+                    break;
+                } else {
+                    ++i;
+                }
+            }
+            out += '?';
+        } else if (std::isdigit(static_cast<unsigned char>(c)) && (out.empty() || !isIdentifierChar(out.back()))) {
+            while (i < sql.size() && (std::isdigit(static_cast<unsigned char>(sql[i])) || sql[i] == '.')) ++i;
+            out += '?';
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) ++i;
+            if (!out.empty()) out += ' ';
+        } else {
+            out += c;
+            ++i;
+        }
+    }
+    while (!out.empty() && (out.back() == ' ' || out.back() == ';')) out.pop_back();
+
+    // IN (?, ?, ?) -> IN (...)
+    std::string result;
+    result.reserve(out.size());
+    for (size_t i = 0; i < out.size();) {
+        bool isIn = i + 2 < out.size() &&
+                    std::toupper(static_cast<unsigned char>(out[i])) == 'I' &&
+                    std::toupper(static_cast<unsigned char>(out[i + 1])) == 'N' &&
+                    (i == 0 || !isIdentifierChar(out[i - 1])) && !isIdentifierChar(out[i + 2]);
+        if (isIn) {
+            size_t open = i + 2;
+            while (open < out.size() && out[open] == ' ') ++open;
+            if (open < out.size() && out[open] == '(') {
+                size_t close = open + 1;
+                bool onlyPlaceholders = true;
+                while (close < out.size() && out[close] != ')') {
+                    if (out[close] != '?' && out[close] != ',' && out[close] != ' ') onlyPlaceholders = false;
+                    ++close;
+                }
+                if (close < out.size() && onlyPlaceholders) {
+                    result.append(out, i, 2);
+                    result += " (...)";
+                    i = close + 1;
+                    continue;
+                }
+            }
+        }
+        result += out[i++];
+    }
+    return result;
+}
+
+void QueryStats::record(const std::string& sql, std::chrono::nanoseconds latency, uint64_t rows,
+                        std::chrono::nanoseconds lockWait, bool succeeded) {
+    auto key = normalize(sql);
+
+    std::shared_ptr<ILogHandler> sink;
+    bool slow = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _statements.find(key);
+        if (it == _statements.end()) {
+            it = _statements.emplace(key, StatementStats{}).first;
+            it->second.statement = key;
+        }
+        auto& stats = it->second;
+        stats.latencyNanos.record(static_cast<uint64_t>(std::max<int64_t>(0, latency.count())));
+        stats.rowCounts.record(rows);
+        stats.lockWaitNanos.record(static_cast<uint64_t>(std::max<int64_t>(0, lockWait.count())));
+        if (!succeeded) ++stats.errors;
+
+        slow = _slowQuerySink && _slowQueryThreshold.count() > 0 && latency >= _slowQueryThreshold;
+        if (slow) {
+            ++stats.slowQueries;
+            sink = _slowQuerySink;
+        }
+    }
+
+    // Ghi ra sink ngoài khóa để I/O không chặn các luồng khác
+    if (slow) {
+        std::time_t now = std::time(nullptr);
+        std::tm tm{};
+        #if defined(_WIN32) || defined(_WIN64)
+            localtime_s(&tm, &now);
+        #else
+            localtime_r(&now, &tm);
+        #endif
+        std::ostringstream timestamp;
+        timestamp << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+
+        std::ostringstream message;
+        message << std::fixed << std::setprecision(3)
+                << "Slow query " << latency.count() / 1e6 << " ms"
+                << " (lock wait " << lockWait.count() / 1e6 << " ms, rows " << rows
+                << (succeeded ? "" : ", failed") << "): " << key;
+        sink->write(LogLevel::WARNING, timestamp.str(), message.str());
+    }
+}
+
+void QueryStats::setSlowQueryLog(std::chrono::nanoseconds threshold, std::shared_ptr<ILogHandler> sink) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slowQueryThreshold = threshold;
+    _slowQuerySink = std::move(sink);
+}
+
+std::vector<StatementStats> QueryStats::topByTotalTime(size_t limit) const {
+    std::vector<StatementStats> statements;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        statements.reserve(_statements.size());
+        for (const auto& [key, stats] : _statements) {
+            statements.push_back(stats);
+        }
+    }
+    std::sort(statements.begin(), statements.end(), [](const StatementStats& a, const StatementStats& b) {
+        return a.latencyNanos.sum() > b.latencyNanos.sum();
+    });
+    if (statements.size() > limit) {
+        statements.resize(limit);
+    }
+    return statements;
+}
+
+std::string QueryStats::dump(size_t limit) const {
+    auto statements = topByTotalTime(limit);
+
+    std::ostringstream out;
+    out << std::left << std::setw(8) << "calls" << std::setw(12) << "total_ms" << std::setw(10) << "p50_us"
+        << std::setw(10) << "p99_us" << std::setw(10) << "max_us" << std::setw(10) << "rows_p50"
+        << std::setw(12) << "lock_p99_us" << std::setw(8) << "errors" << "statement\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& stats : statements) {
+        const auto& latency = stats.latencyNanos;
+        out << std::left << std::setw(8) << latency.count()
+            << std::setw(12) << latency.sum() / 1e6
+            << std::setw(10) << latency.valueAtPercentile(50) / 1e3
+            << std::setw(10) << latency.valueAtPercentile(99) / 1e3
+            << std::setw(10) << latency.max() / 1e3
+            << std::setw(10) << stats.rowCounts.valueAtPercentile(50)
+            << std::setw(12) << stats.lockWaitNanos.valueAtPercentile(99) / 1e3
+            << std::setw(8) << stats.errors
+            << stats.statement << "\n";
+    }
+    return out.str();
+}
+
+LatencyHistogram QueryStats::totalLockWait() const {
+    LatencyHistogram total;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& [key, stats] : _statements) {
+        total.merge(stats.lockWaitNanos);
+    }
+    return total;
+}
+
+void QueryStats::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _statements.clear();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file QueryStats.h
+ * @brief Thống kê độ trễ và số hàng theo từng câu lệnh SQL, kèm nhật ký truy vấn chậm
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * QueryStats gom số đo của mỗi lần thực thi theo văn bản câu lệnh đã chuẩn hóa (hằng số chuỗi
+ * và số được thay bằng ?, danh sách IN được rút gọn), để các lần gọi cùng một câu lệnh với
+ * tham số khác nhau rơi vào cùng một nhóm. Mỗi nhóm có ba histogram: thời gian thực thi,
+ * số hàng và thời gian chờ mutex của kết nối.
+ *
+ * Truy vấn vượt ngưỡng cấu hình được ghi ra một ILogHandler riêng (ví dụ FileLogHandler
+ * "slow_query.log") thay vì lẫn vào log chung. Nhật ký chỉ ghi câu đã chuẩn hóa, nên tham số
+ * (hộ chiếu, email, số điện thoại...) không bao giờ rơi vào tệp.
+ */
+
+#ifndef QUERY_STATS_H
+#define QUERY_STATS_H
+
+#include "../utils/Logger.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Histogram kiểu HDR: bucket theo lũy thừa 2, mỗi bucket chia 32 bucket con tuyến tính
+ *
+ * Sai số tương đối của mọi phân vị không quá 1/32 (~3%), bộ nhớ cố định bất kể số lần ghi.
+ * Giá trị nhỏ hơn 32 được đếm chính xác; giá trị quá 2^48 được gộp vào bucket cuối.
+ */
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 47;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    std::vector<uint64_t> _counts;  ///< Cấp phát ở lần ghi đầu tiên
+    uint64_t _totalCount = 0;
+    uint64_t _sum = 0;
+    uint64_t _min = UINT64_MAX;
+    uint64_t _max = 0;
+
+    static size_t indexOf(uint64_t value);
+    static uint64_t highestEquivalentValue(size_t index);
+
+public:
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return _totalCount; }
+    uint64_t sum() const { return _sum; }
+    uint64_t min() const { return _totalCount ? _min : 0; }
+    uint64_t max() const { return _max; }
+    double mean() const { return _totalCount ? static_cast<double>(_sum) / _totalCount : 0.0; }
+
+    /**
+     * @brief Giá trị tại phân vị
+     * @param percentile Phân vị trong khoảng [0, 100]
+     * @return Giá trị lớn nhất của bucket chứa phân vị (không vượt quá max())
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+};
+
+/**
+ * @brief Số đo tích lũy của một câu lệnh đã chuẩn hóa
+ */
+struct StatementStats {
+    std::string statement;          ///< Văn bản đã chuẩn hóa
+    LatencyHistogram latencyNanos;  ///< Thời gian thực thi (không gồm chờ mutex)
+    LatencyHistogram rowCounts;     ///< Số hàng trả về hoặc bị ảnh hưởng
+    LatencyHistogram lockWaitNanos; ///< Thời gian chờ mutex của kết nối
+    uint64_t errors = 0;
+    uint64_t slowQueries = 0;
+};
+
+class QueryStats {
+private:
+    std::map<std::string, StatementStats> _statements;
+    std::shared_ptr<ILogHandler> _slowQuerySink;
+    std::chrono::nanoseconds _slowQueryThreshold{0};
+    mutable std::mutex _mutex;
+
+public:
+    /**
+     * @brief Chuẩn hóa câu SQL để gom nhóm
+     *
+     * Thay chuỗi trong nháy đơn và số bằng ?, rút gọn IN (?, ?, ...) thành IN (...),
+     * gộp khoảng trắng liên tiếp.
+     */
+    static std::string normalize(const std::string& sql);
+
+    /**
+     * @brief Ghi nhận một lần thực thi
+     * @param sql Câu SQL (đã hoặc chưa chuẩn hóa); nhật ký truy vấn chậm chỉ ghi bản đã chuẩn hóa
+     * @param latency Thời gian thực thi
+     * @param rows Số hàng trả về hoặc bị ảnh hưởng
+     * @param lockWait Thời gian chờ mutex
+     * @param succeeded Câu lệnh có thành công không
+     */
+    void record(const std::string& sql, std::chrono::nanoseconds latency, uint64_t rows,
+                std::chrono::nanoseconds lockWait, bool succeeded = true);
+
+    /**
+     * @brief Cấu hình nhật ký truy vấn chậm
+     * @param threshold Ngưỡng thời gian; 0 để tắt
+     * @param sink Nơi ghi; nullptr để tắt
+     */
+    void setSlowQueryLog(std::chrono::nanoseconds threshold, std::shared_ptr<ILogHandler> sink);
+
+    /**
+     * @brief Các câu lệnh tốn nhiều tổng thời gian nhất
+     * @param limit Số câu lệnh tối đa
+     */
+    std::vector<StatementStats> topByTotalTime(size_t limit) const;
+
+    /**
+     * @brief Bảng văn bản các câu lệnh tốn thời gian nhất: số lần, tổng, p50/p99/max, số hàng, chờ khóa
+     */
+    std::string dump(size_t limit = 20) const;
+
+    /**
+     * @brief Gộp histogram chờ mutex của mọi câu lệnh
+     */
+    LatencyHistogram totalLockWait() const;
+
+    void reset();
+};
+
+#endif // QUERY_STATS_H
@@ -0,0 +1,743 @@
+#include "TraceConnection.h"
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+    constexpr char TRACE_MAGIC[4] = {'A', 'T', 'R', 'C'};
+    constexpr uint64_t TRACE_VERSION = 2;
+    /// Các bit cờ đã dùng của sự kiện (ok, có tập kết quả) và của ô (kiểu, theo tên, ok)
+    constexpr uint8_t EVENT_FLAG_MASK = 1 | 2;
+    constexpr uint8_t CELL_FLAG_MASK = 3 | 4 | 8;
+
+    uint64_t elapsedNanos(std::chrono::steady_clock::time_point start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::string formatDateTime(const std::tm& value) {
+        std::ostringstream oss;
+        oss << std::put_time(&value, "%Y-%m-%d %H:%M:%S");
+        return oss.str();
+    }
+
+    std::string formatDouble(double value) {
+        char buffer[32];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, end);
+    }
+
+    std::string cellKey(const TraceCell& cell) {
+        return cell.byName ? "'" + cell.name + "'" : std::to_string(cell.index);
+    }
+
+    // === Mã hóa nhị phân ===
+
+    class TraceWriter {
+    private:
+        std::string _buffer;
+
+    public:
+        void byte(uint8_t value) { _buffer.push_back(static_cast<char>(value)); }
+
+        void varint(uint64_t value) {
+            while (value >= 0x80) {
+                byte(static_cast<uint8_t>(value) | 0x80);
+                value >>= 7;
+            }
+            byte(static_cast<uint8_t>(value));
+        }
+
+        void zigzag(int64_t value) {
+            varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void string(const std::string& value) {
+            varint(value.size());
+            _buffer.append(value);
+        }
+
+        void raw(const char* data, size_t size) { _buffer.append(data, size); }
+
+        const std::string& data() const { return _buffer; }
+    };
+
+    class TraceReader {
+    private:
+        const std::string& _data;
+        size_t _pos = 0;
+        bool _failed = false;
+
+    public:
+        explicit TraceReader(const std::string& data) : _data(data) {}
+
+        bool failed() const { return _failed; }
+        bool atEnd() const { return _pos >= _data.size(); }
+
+        uint8_t byte() {
+            if (_pos >= _data.size()) {
+                _failed = true;
+                return 0;
+            }
+            return static_cast<uint8_t>(_data[_pos++]);
+        }
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64 && !_failed; shift += 7) {
+                uint8_t next = byte();
+                value |= static_cast<uint64_t>(next & 0x7F) << shift;
+                if ((next & 0x80) == 0) return value;
+            }
+            _failed = true;
+            return 0;
+        }
+
+        int64_t zigzag() {
+            uint64_t value = varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        std::string string() {
+            uint64_t size = varint();
+            if (_failed || size > _data.size() - _pos) {
+                _failed = true;
+                return std::string();
+            }
+            std::string value = _data.substr(_pos, size);
+            _pos += size;
+            return value;
+        }
+
+        bool expect(const char* data, size_t size) {
+            if (_data.compare(_pos, size, data, size) != 0) {
+                _failed = true;
+                return false;
+            }
+            _pos += size;
+            return true;
+        }
+    };
+
+    // === Tập kết quả ===
+
+    /**
+     * @brief Bọc tập kết quả thật, chuyển tiếp và ghi lại các ô được đọc
+     */
+    class RecordingResult : public IDatabaseResult {
+    private:
+        std::unique_ptr<IDatabaseResult> _inner;
+        std::shared_ptr<TraceResultSet> _resultSet;
+
+        template <typename T>
+        Result<T> capture(TraceCell cell, Result<T> result, std::chrono::steady_clock::time_point start,
+                          std::string (*format)(const T&)) {
+            _resultSet->fetchNanos += elapsedNanos(start);
+            if (_resultSet->rows.empty() || _resultSet->exhausted) return result;
+            cell.ok = result.has_value();
+            cell.value = result ? format(result.value()) : result.error().message;
+            _resultSet->rows.back().push_back(std::move(cell));
+            return result;
+        }
+
+        static TraceCell indexCell(TraceCell::Kind kind, int index) {
+            TraceCell cell;
+            cell.kind = kind;
+            cell.index = index;
+            return cell;
+        }
+
+        static TraceCell nameCell(TraceCell::Kind kind, const std::string& name) {
+            TraceCell cell;
+            cell.kind = kind;
+            cell.byName = true;
+            cell.name = name;
+            return cell;
+        }
+
+        static std::string formatString(const std::string& value) { return value; }
+        static std::string formatInt(const int& value) { return std::to_string(value); }
+        static std::string formatDoubleCell(const double& value) { return formatDouble(value); }
+        static std::string formatTm(const std::tm& value) { return formatDateTime(value); }
+
+    public:
+        RecordingResult(std::unique_ptr<IDatabaseResult> inner, std::shared_ptr<TraceResultSet> resultSet)
+            : _inner(std::move(inner)), _resultSet(std::move(resultSet)) {}
+
+        Result<bool> next() override {
+            auto start = std::chrono::steady_clock::now();
+            auto result = _inner->next();
+            _resultSet->fetchNanos += elapsedNanos(start);
+            if (!result || !result.value()) {
+                _resultSet->exhausted = true;
+            } else {
+                _resultSet->rows.emplace_back();
+            }
+            return result;
+        }
+
+        Result<std::string> getString(const int& columnIndex) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(indexCell(TraceCell::Kind::STRING, columnIndex), _inner->getString(columnIndex), start, &formatString);
+        }
+
+        Result<int> getInt(const int& columnIndex) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(indexCell(TraceCell::Kind::INT, columnIndex), _inner->getInt(columnIndex), start, &formatInt);
+        }
+
+        Result<double> getDouble(const int& columnIndex) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(indexCell(TraceCell::Kind::DOUBLE, columnIndex), _inner->getDouble(columnIndex), start, &formatDoubleCell);
+        }
+
+        Result<std::tm> getDateTime(const int& columnIndex) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(indexCell(TraceCell::Kind::DATETIME, columnIndex), _inner->getDateTime(columnIndex), start, &formatTm);
+        }
+
+        Result<std::string> getString(const std::string& columnName) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(nameCell(TraceCell::Kind::STRING, columnName), _inner->getString(columnName), start, &formatString);
+        }
+
+        Result<int> getInt(const std::string& columnName) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(nameCell(TraceCell::Kind::INT, columnName), _inner->getInt(columnName), start, &formatInt);
+        }
+
+        Result<double> getDouble(const std::string& columnName) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(nameCell(TraceCell::Kind::DOUBLE, columnName), _inner->getDouble(columnName), start, &formatDoubleCell);
+        }
+
+        Result<std::tm> getDateTime(const std::string& columnName) override {
+            auto start = std::chrono::steady_clock::now();
+            return capture(nameCell(TraceCell::Kind::DATETIME, columnName), _inner->getDateTime(columnName), start, &formatTm);
+        }
+    };
+
+    /**
+     * @brief Trả lại các ô đã ghi của một tập kết quả
+     */
+    class ReplayResult : public IDatabaseResult {
+    private:
+        std::shared_ptr<const TraceResultSet> _resultSet;
+        size_t _row = 0;
+        bool _started = false;
+
+        Result<std::string> find(TraceCell::Kind kind, bool byName, int index, const std::string& name) const {
+            if (!_started || _row >= _resultSet->rows.size()) {
+                return Failure<std::string>(CoreError("No current row available"));
+            }
+            for (const auto& cell : _resultSet->rows[_row]) {
+                if (cell.kind != kind || cell.byName != byName) continue;
+                if (byName ? cell.name != name : cell.index != index) continue;
+                if (!cell.ok) return Failure<std::string>(CoreError(cell.value));
+                return Success(cell.value);
+            }
+            TraceCell missing;
+            missing.byName = byName;
+            missing.index = index;
+            missing.name = name;
+            return Failure<std::string>(CoreError("Column " + cellKey(missing) + " was not read in the recorded session",
+                                                  "REPLAY_DIVERGED"));
+        }
+
+        static Result<int> toInt(Result<std::string> cell) {
+            if (!cell) return Failure<int>(cell.error());
+            int value = 0;
+            const auto& text = cell.value();
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            return Success(value);
+        }
+
+        static Result<double> toDouble(Result<std::string> cell) {
+            if (!cell) return Failure<double>(cell.error());
+            double value = 0;
+            const auto& text = cell.value();
+            std::from_chars(text.data(), text.data() + text.size(), value);
+            return Success(value);
+        }
+
+        static Result<std::tm> toDateTime(Result<std::string> cell) {
+            if (!cell) return Failure<std::tm>(cell.error());
+            std::tm value{};
+            std::istringstream ss(cell.value());
+            ss >> std::get_time(&value, "%Y-%m-%d %H:%M:%S");
+            if (ss.fail()) return Failure<std::tm>(CoreError("Invalid datetime in trace: " + cell.value(), "TRACE_FORMAT"));
+            std::mktime(&value);
+            return Success(value);
+        }
+
+    public:
+        explicit ReplayResult(std::shared_ptr<const TraceResultSet> resultSet) : _resultSet(std::move(resultSet)) {}
+
+        Result<bool> next() override {
+            if (_started && _row < _resultSet->rows.size()) {
+                ++_row;
+            }
+            _started = true;
+            return Success(_row < _resultSet->rows.size());
+        }
+
+        Result<std::string> getString(const int& columnIndex) override {
+            return find(TraceCell::Kind::STRING, false, columnIndex, "");
+        }
+        Result<int> getInt(const int& columnIndex) override {
+            return toInt(find(TraceCell::Kind::INT, false, columnIndex, ""));
+        }
+        Result<double> getDouble(const int& columnIndex) override {
+            return toDouble(find(TraceCell::Kind::DOUBLE, false, columnIndex, ""));
+        }
+        Result<std::tm> getDateTime(const int& columnIndex) override {
+            return toDateTime(find(TraceCell::Kind::DATETIME, false, columnIndex, ""));
+        }
+        Result<std::string> getString(const std::string& columnName) override {
+            return find(TraceCell::Kind::STRING, true, 0, columnName);
+        }
+        Result<int> getInt(const std::string& columnName) override {
+            return toInt(find(TraceCell::Kind::INT, true, 0, columnName));
+        }
+        Result<double> getDouble(const std::string& columnName) override {
+            return toDouble(find(TraceCell::Kind::DOUBLE, true, 0, columnName));
+        }
+        Result<std::tm> getDateTime(const std::string& columnName) override {
+            return toDateTime(find(TraceCell::Kind::DATETIME, true, 0, columnName));
+        }
+    };
+}
+
+// === Trace ===
+
+VoidResult Trace::save(const std::string& path) const {
+    TraceWriter writer;
+    writer.raw(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    writer.varint(TRACE_VERSION);
+    writer.varint(events.size());
+
+    for (const auto& event : events) {
+        writer.byte(static_cast<uint8_t>(event.op));
+        writer.byte(static_cast<uint8_t>((event.ok ? 1 : 0) | (event.resultSet ? 2 : 0)));
+        writer.zigzag(event.statementId);
+        writer.zigzag(event.paramIndex);
+        writer.string(event.text);
+        if (!event.ok) {
+            writer.string(event.errorMessage);
+            writer.string(event.errorCode);
+        }
+        writer.zigzag(event.value);
+        writer.varint(event.durationNanos);
+
+        if (event.resultSet) {
+            const auto& resultSet = *event.resultSet;
+            writer.varint(resultSet.rows.size());
+            for (const auto& row : resultSet.rows) {
+                writer.varint(row.size());
+                for (const auto& cell : row) {
+                    writer.byte(static_cast<uint8_t>(static_cast<uint8_t>(cell.kind) | (cell.byName ? 4 : 0) | (cell.ok ? 8 : 0)));
+                    if (cell.byName) writer.string(cell.name);
+                    else writer.zigzag(cell.index);
+                    writer.string(cell.value);
+                }
+            }
+            writer.byte(resultSet.exhausted ? 1 : 0);
+            writer.varint(resultSet.fetchNanos);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return Failure(CoreError("Cannot open trace file for writing: " + path, "TRACE_IO"));
+    }
+    file.write(writer.data().data(), static_cast<std::streamsize>(writer.data().size()));
+    if (!file) {
+        return Failure(CoreError("Failed to write trace file: " + path, "TRACE_IO"));
+    }
+    return Success();
+}
+
+Result<Trace> Trace::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return Failure<Trace>(CoreError("Cannot open trace file: " + path, "TRACE_IO"));
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    TraceReader reader(data);
+    if (!reader.expect(TRACE_MAGIC, sizeof(TRACE_MAGIC))) {
+        return Failure<Trace>(CoreError("Not a trace file: " + path, "TRACE_FORMAT"));
+    }
+    uint64_t version = reader.varint();
+    if (version != TRACE_VERSION) {
+        return Failure<Trace>(CoreError("Unsupported trace version " + std::to_string(version), "TRACE_FORMAT"));
+    }
+
+    Trace trace;
+    uint64_t eventCount = reader.varint();
+    for (uint64_t i = 0; i < eventCount && !reader.failed(); ++i) {
+        TraceEvent event;
+        // Kiểm tra trước khi ép kiểu: giá trị ngoài enum sẽ đưa các switch theo op vào hành vi không xác định
+        uint8_t op = reader.byte();
+        uint8_t flags = reader.byte();
+        if (op > static_cast<uint8_t>(TraceOp::MARK) || (flags & ~EVENT_FLAG_MASK) != 0) {
+            return Failure<Trace>(CoreError("Invalid trace event " + std::to_string(i) + " in " + path, "INVALID_TRACE"));
+        }
+        event.op = static_cast<TraceOp>(op);
+        event.ok = (flags & 1) != 0;
+        event.statementId = static_cast<int>(reader.zigzag());
+        event.paramIndex = static_cast<int>(reader.zigzag());
+        event.text = reader.string();
+        if (!event.ok) {
+            event.errorMessage = reader.string();
+            event.errorCode = reader.string();
+        }
+        event.value = reader.zigzag();
+        event.durationNanos = reader.varint();
+
+        if (flags & 2) {
+            auto resultSet = std::make_shared<TraceResultSet>();
+            uint64_t rowCount = reader.varint();
+            for (uint64_t r = 0; r < rowCount && !reader.failed(); ++r) {
+                std::vector<TraceCell> row;
+                uint64_t cellCount = reader.varint();
+                for (uint64_t c = 0; c < cellCount && !reader.failed(); ++c) {
+                    TraceCell cell;
+                    uint8_t cellFlags = reader.byte();
+                    if ((cellFlags & ~CELL_FLAG_MASK) != 0 ||
+                        (cellFlags & 3) > static_cast<uint8_t>(TraceCell::Kind::DATETIME)) {
+                        return Failure<Trace>(CoreError("Invalid result cell in trace event " + std::to_string(i) +
+                                                        " in " + path, "INVALID_TRACE"));
+                    }
+                    cell.kind = static_cast<TraceCell::Kind>(cellFlags & 3);
+                    cell.byName = (cellFlags & 4) != 0;
+                    cell.ok = (cellFlags & 8) != 0;
+                    if (cell.byName) cell.name = reader.string();
+                    else cell.index = static_cast<int>(reader.zigzag());
+                    cell.value = reader.string();
+                    row.push_back(std::move(cell));
+                }
+                resultSet->rows.push_back(std::move(row));
+            }
+            resultSet->exhausted = reader.byte() != 0;
+            resultSet->fetchNanos = reader.varint();
+            event.resultSet = std::move(resultSet);
+        }
+        trace.events.push_back(std::move(event));
+    }
+
+    if (reader.failed() || !reader.atEnd()) {
+        return Failure<Trace>(CoreError("Corrupted trace file: " + path, "TRACE_FORMAT"));
+    }
+    return Success(std::move(trace));
+}
+
+bool Trace::isRoundTrip(TraceOp op) {
+    switch (op) {
+        case TraceOp::CONNECT:
+        case TraceOp::EXECUTE:
+        case TraceOp::EXECUTE_QUERY:
+        case TraceOp::EXECUTE_STATEMENT:
+        case TraceOp::EXECUTE_UPDATE:
+        case TraceOp::EXECUTE_QUERY_STATEMENT:
+        case TraceOp::LAST_INSERT_ID:
+        case TraceOp::BEGIN_TRANSACTION:
+        case TraceOp::COMMIT_TRANSACTION:
+        case TraceOp::ROLLBACK_TRANSACTION:
+            return true;
+        default:
+            // prepare/bind được MySQLXConnection dựng phía client
+            return false;
+    }
+}
+
+std::vector<TraceActionStats> Trace::summarizeActions() const {
+    std::vector<TraceActionStats> actions;
+    TraceActionStats current;
+    bool hasCurrent = false;
+
+    for (const auto& event : events) {
+        if (event.op == TraceOp::MARK) {
+            if (hasCurrent) actions.push_back(current);
+            current = TraceActionStats{event.text};
+            hasCurrent = true;
+            continue;
+        }
+        hasCurrent = true;
+        if (isRoundTrip(event.op)) ++current.roundTrips;
+        current.serverNanos += event.durationNanos;
+        if (event.resultSet) {
+            current.rowsRead += event.resultSet->rows.size();
+            current.serverNanos += event.resultSet->fetchNanos;
+        }
+    }
+    if (hasCurrent) actions.push_back(current);
+    return actions;
+}
+
+// === TraceConnection ===
+
+TraceConnection::TraceConnection(std::shared_ptr<IDatabaseConnection> inner)
+    : _mode(Mode::RECORD), _inner(std::move(inner)) {}
+
+TraceConnection::TraceConnection(Trace trace)
+    : _mode(Mode::REPLAY), _trace(std::move(trace)) {}
+
+Trace TraceConnection::getTrace() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _trace;
+}
+
+VoidResult TraceConnection::saveTrace(const std::string& path) const {
+    return getTrace().save(path);
+}
+
+size_t TraceConnection::remainingEvents() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _mode == Mode::REPLAY ? _trace.events.size() - _cursor : 0;
+}
+
+void TraceConnection::mark(const std::string& label) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_mode == Mode::RECORD) {
+        TraceEvent event;
+        event.op = TraceOp::MARK;
+        event.text = label;
+        _trace.events.push_back(std::move(event));
+    } else if (_cursor < _trace.events.size() && _trace.events[_cursor].op == TraceOp::MARK) {
+        ++_cursor;
+    }
+}
+
+void TraceConnection::append(TraceEvent event) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _trace.events.push_back(std::move(event));
+}
+
+Result<const TraceEvent*> TraceConnection::nextReplayEvent(TraceOp op, const std::string* text, const int* statementId) {
+    // MARK chỉ là chú thích, không phải lời gọi của mã nghiệp vụ
+    while (_cursor < _trace.events.size() && _trace.events[_cursor].op == TraceOp::MARK) {
+        ++_cursor;
+    }
+    if (_cursor >= _trace.events.size()) {
+        _lastError = "Replay trace exhausted";
+        return Failure<const TraceEvent*>(CoreError("Replay trace exhausted", "REPLAY_DIVERGED"));
+    }
+
+    const TraceEvent& event = _trace.events[_cursor];
+    bool matches = event.op == op &&
+                   (!text || event.text == *text) &&
+                   (!statementId || event.statementId == *statementId);
+    if (!matches) {
+        _lastError = "Replay diverged at event " + std::to_string(_cursor);
+        return Failure<const TraceEvent*>(CoreError(_lastError + ": expected op " + std::to_string(static_cast<int>(event.op)) +
+                                                    " '" + event.text + "', got op " + std::to_string(static_cast<int>(op)),
+                                                    "REPLAY_DIVERGED"));
+    }
+    ++_cursor;
+    if (!event.ok) _lastError = event.errorMessage;
+    return Success(&event);
+}
+
+template <typename T>
+Result<T> TraceConnection::replayValue(TraceOp op, const std::string* text, const int* statementId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto event = nextReplayEvent(op, text, statementId);
+    if (!event) return Failure<T>(event.error());
+    if (!event.value()->ok) {
+        return Failure<T>(CoreError(event.value()->errorMessage, event.value()->errorCode));
+    }
+    if constexpr (std::is_void_v<T>) {
+        return Success();
+    } else {
+        return Success(static_cast<T>(event.value()->value));
+    }
+}
+
+template <typename T>
+Result<T> TraceConnection::recordValue(TraceOp op, const std::string& text, int statementId, int paramIndex,
+                                       Result<T> result, uint64_t nanos) {
+    TraceEvent event;
+    event.op = op;
+    event.text = text;
+    event.statementId = statementId;
+    event.paramIndex = paramIndex;
+    event.durationNanos = nanos;
+    event.ok = result.has_value();
+    if (!result) {
+        event.errorMessage = result.error().message;
+        event.errorCode = result.error().code;
+    } else if constexpr (!std::is_void_v<T>) {
+        event.value = static_cast<int64_t>(result.value());
+    }
+    append(std::move(event));
+    return result;
+}
+
+Result<std::unique_ptr<IDatabaseResult>> TraceConnection::replayQuery(TraceOp op, const std::string* text, const int* statementId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto event = nextReplayEvent(op, text, statementId);
+    if (!event) return Failure<std::unique_ptr<IDatabaseResult>>(event.error());
+    if (!event.value()->ok) {
+        return Failure<std::unique_ptr<IDatabaseResult>>(CoreError(event.value()->errorMessage, event.value()->errorCode));
+    }
+    auto resultSet = event.value()->resultSet ? event.value()->resultSet : std::make_shared<TraceResultSet>();
+    return Success<std::unique_ptr<IDatabaseResult>>(std::make_unique<ReplayResult>(std::move(resultSet)));
+}
+
+Result<std::unique_ptr<IDatabaseResult>> TraceConnection::recordQuery(TraceOp op, const std::string& text, int statementId,
+                                                                      Result<std::unique_ptr<IDatabaseResult>> result,
+                                                                      uint64_t nanos) {
+    TraceEvent event;
+    event.op = op;
+    event.text = text;
+    event.statementId = statementId;
+    event.durationNanos = nanos;
+    event.ok = result.has_value();
+    if (!result) {
+        event.errorMessage = result.error().message;
+        event.errorCode = result.error().code;
+        append(std::move(event));
+        return result;
+    }
+    event.resultSet = std::make_shared<TraceResultSet>();
+    auto recording = std::make_unique<RecordingResult>(std::move(result.value()), event.resultSet);
+    append(std::move(event));
+    return Success<std::unique_ptr<IDatabaseResult>>(std::move(recording));
+}
+
+Result<bool> TraceConnection::connect(const std::string& host, const std::string& user,
+                                      const std::string& password, const std::string& database,
+                                      const int& port) {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::CONNECT, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->connect(host, user, password, database, port);
+    // Không ghi mật khẩu vào trace
+    return recordValue(TraceOp::CONNECT, user + "@" + host + "/" + database, 0, 0, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::disconnect() {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::DISCONNECT, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->disconnect();
+    return recordValue(TraceOp::DISCONNECT, "", 0, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<bool> TraceConnection::execute(const std::string& query) {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::EXECUTE, &query, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->execute(query);
+    return recordValue(TraceOp::EXECUTE, query, 0, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<std::unique_ptr<IDatabaseResult>> TraceConnection::executeQuery(const std::string& query) {
+    if (_mode == Mode::REPLAY) return replayQuery(TraceOp::EXECUTE_QUERY, &query, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->executeQuery(query);
+    return recordQuery(TraceOp::EXECUTE_QUERY, query, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<int> TraceConnection::prepareStatement(const std::string& query) {
+    if (_mode == Mode::REPLAY) return replayValue<int>(TraceOp::PREPARE, &query, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->prepareStatement(query);
+    return recordValue(TraceOp::PREPARE, query, result ? result.value() : 0, 0, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::setString(const int& statementId, const int& paramIndex, const std::string& value) {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::SET_STRING, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->setString(statementId, paramIndex, value);
+    return recordValue(TraceOp::SET_STRING, value, statementId, paramIndex, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::setInt(const int& statementId, const int& paramIndex, const int& value) {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::SET_INT, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->setInt(statementId, paramIndex, value);
+    return recordValue(TraceOp::SET_INT, std::to_string(value), statementId, paramIndex, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::setDouble(const int& statementId, const int& paramIndex, const double& value) {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::SET_DOUBLE, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->setDouble(statementId, paramIndex, value);
+    return recordValue(TraceOp::SET_DOUBLE, formatDouble(value), statementId, paramIndex, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::setDateTime(const int& statementId, const int& paramIndex, const std::tm& value) {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::SET_DATETIME, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->setDateTime(statementId, paramIndex, value);
+    return recordValue(TraceOp::SET_DATETIME, formatDateTime(value), statementId, paramIndex, std::move(result), elapsedNanos(start));
+}
+
+Result<bool> TraceConnection::executeStatement(const int& statementId) {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::EXECUTE_STATEMENT, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->executeStatement(statementId);
+    return recordValue(TraceOp::EXECUTE_STATEMENT, "", statementId, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<int> TraceConnection::executeUpdate(const int& statementId) {
+    if (_mode == Mode::REPLAY) return replayValue<int>(TraceOp::EXECUTE_UPDATE, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->executeUpdate(statementId);
+    return recordValue(TraceOp::EXECUTE_UPDATE, "", statementId, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<std::unique_ptr<IDatabaseResult>> TraceConnection::executeQueryStatement(const int& statementId) {
+    if (_mode == Mode::REPLAY) return replayQuery(TraceOp::EXECUTE_QUERY_STATEMENT, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->executeQueryStatement(statementId);
+    return recordQuery(TraceOp::EXECUTE_QUERY_STATEMENT, "", statementId, std::move(result), elapsedNanos(start));
+}
+
+VoidResult TraceConnection::freeStatement(const int& statementId) {
+    if (_mode == Mode::REPLAY) return replayValue<void>(TraceOp::FREE_STATEMENT, nullptr, &statementId);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->freeStatement(statementId);
+    return recordValue(TraceOp::FREE_STATEMENT, "", statementId, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<int> TraceConnection::getLastInsertId() {
+    if (_mode == Mode::REPLAY) return replayValue<int>(TraceOp::LAST_INSERT_ID, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->getLastInsertId();
+    return recordValue(TraceOp::LAST_INSERT_ID, "", 0, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<bool> TraceConnection::isConnected() const {
+    if (_mode == Mode::REPLAY) return Success(true);
+    return _inner->isConnected();
+}
+
+Result<std::string> TraceConnection::getLastError() const {
+    if (_mode == Mode::RECORD) return _inner->getLastError();
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Success(_lastError);
+}
+
+Result<bool> TraceConnection::beginTransaction() {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::BEGIN_TRANSACTION, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->beginTransaction();
+    return recordValue(TraceOp::BEGIN_TRANSACTION, "", 0, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<bool> TraceConnection::commitTransaction() {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::COMMIT_TRANSACTION, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->commitTransaction();
+    return recordValue(TraceOp::COMMIT_TRANSACTION, "", 0, 0, std::move(result), elapsedNanos(start));
+}
+
+Result<bool> TraceConnection::rollbackTransaction() {
+    if (_mode == Mode::REPLAY) return replayValue<bool>(TraceOp::ROLLBACK_TRANSACTION, nullptr, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto result = _inner->rollbackTransaction();
+    return recordValue(TraceOp::ROLLBACK_TRANSACTION, "", 0, 0, std::move(result), elapsedNanos(start));
+}
@@ -0,0 +1,239 @@
+/**
+ * @file TraceConnection.h
+ * @brief Decorator IDatabaseConnection ghi lại và phát lại toàn bộ phiên làm việc với cơ sở dữ liệu
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * TraceConnection có hai chế độ:
+ * - Ghi (RECORD): bọc một kết nối thật, chuyển tiếp mọi lời gọi và ghi lại thao tác, tham số bind,
+ *   kết quả, các ô dữ liệu đã đọc và thời gian thực thi vào một Trace.
+ * - Phát lại (REPLAY): không cần kết nối thật, trả về đúng các kết quả đã ghi theo thứ tự.
+ *
+ * Trace lưu được ra file nhị phân gọn (số nguyên mã hóa varint) để tái hiện phiên làm việc
+ * ngoại tuyến, đếm số round trip cho từng thao tác người dùng (đánh dấu bằng mark()) và đo
+ * thời gian CPU của mã ánh xạ mà không cần server.
+ *
+ * Khi phát lại, mỗi lời gọi phải khớp thao tác kế tiếp trong trace (cùng loại, cùng câu SQL,
+ * cùng statement ID); giá trị tham số bind không được so khớp vì có thể chứa thời gian hiện tại.
+ * Sai khác trả về lỗi REPLAY_DIVERGED.
+ */
+
+#ifndef TRACE_CONNECTION_H
+#define TRACE_CONNECTION_H
+
+#include "InterfaceDatabaseConnection.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Loại thao tác được ghi trong trace
+ */
+enum class TraceOp : uint8_t {
+    CONNECT,
+    DISCONNECT,
+    EXECUTE,
+    EXECUTE_QUERY,
+    PREPARE,
+    SET_STRING,
+    SET_INT,
+    SET_DOUBLE,
+    SET_DATETIME,
+    EXECUTE_STATEMENT,
+    EXECUTE_QUERY_STATEMENT,
+    FREE_STATEMENT,
+    LAST_INSERT_ID,
+    EXECUTE_UPDATE,
+    BEGIN_TRANSACTION,
+    COMMIT_TRANSACTION,
+    ROLLBACK_TRANSACTION,
+    MARK  ///< Ranh giới thao tác người dùng, do mã gọi tự đánh dấu
+};
+
+/**
+ * @brief Một lần đọc ô dữ liệu từ IDatabaseResult
+ */
+struct TraceCell {
+    enum class Kind : uint8_t { STRING, INT, DOUBLE, DATETIME } kind = Kind::STRING;
+    bool byName = false;
+    int index = 0;            ///< Chỉ số cột khi byName = false
+    std::string name;         ///< Tên cột khi byName = true
+    bool ok = true;
+    std::string value;        ///< Giá trị dạng chuỗi, hoặc thông báo lỗi nếu ok = false
+};
+
+/**
+ * @brief Các ô đã đọc của một tập kết quả, theo từng hàng
+ */
+struct TraceResultSet {
+    std::vector<std::vector<TraceCell>> rows;
+    bool exhausted = false;   ///< next() đã trả về false trong phiên ghi
+    uint64_t fetchNanos = 0;  ///< Tổng thời gian next() và get*() của kết nối thật
+};
+
+/**
+ * @brief Một lời gọi IDatabaseConnection
+ */
+struct TraceEvent {
+    TraceOp op = TraceOp::MARK;
+    int statementId = 0;
+    int paramIndex = 0;
+    std::string text;          ///< Câu SQL, giá trị bind dạng chuỗi hoặc nhãn MARK
+    bool ok = true;
+    std::string errorMessage;
+    std::string errorCode;
+    int64_t value = 0;         ///< Giá trị trả về kiểu bool/int (statement ID, last insert ID, ...)
+    uint64_t durationNanos = 0;
+    std::shared_ptr<TraceResultSet> resultSet;
+};
+
+/**
+ * @brief Thống kê một thao tác người dùng (đoạn giữa hai MARK)
+ */
+struct TraceActionStats {
+    std::string label;          ///< Nhãn MARK mở đầu; rỗng với đoạn trước MARK đầu tiên
+    size_t roundTrips = 0;      ///< Số lời gọi phải tới server
+    size_t rowsRead = 0;
+    uint64_t serverNanos = 0;   ///< Tổng thời gian chờ kết nối thật
+};
+
+/**
+ * @brief Chuỗi các lời gọi đã ghi
+ */
+struct Trace {
+    std::vector<TraceEvent> events;
+
+    /**
+     * @brief Ghi trace ra file nhị phân
+     * @param path Đường dẫn file
+     */
+    VoidResult save(const std::string& path) const;
+
+    /**
+     * @brief Đọc trace từ file nhị phân
+     * @param path Đường dẫn file
+     * @return Trace hoặc lỗi TRACE_IO / TRACE_FORMAT
+     */
+    static Result<Trace> load(const std::string& path);
+
+    /**
+     * @brief Gom các lời gọi theo từng đoạn MARK
+     */
+    std::vector<TraceActionStats> summarizeActions() const;
+
+    /**
+     * @brief Lời gọi có phải là một round trip tới server hay không
+     */
+    static bool isRoundTrip(TraceOp op);
+};
+
+class TraceConnection : public IDatabaseConnection {
+public:
+    enum class Mode {
+        RECORD,
+        REPLAY
+    };
+
+private:
+    Mode _mode;
+    std::shared_ptr<IDatabaseConnection> _inner;  ///< Kết nối thật, chỉ có ở chế độ ghi
+    Trace _trace;
+    size_t _cursor = 0;                           ///< Vị trí phát lại
+    std::string _lastError;
+    mutable std::mutex _mutex;
+
+    /**
+     * @brief Lấy lời gọi kế tiếp khi phát lại và kiểm tra khớp; gọi khi đang giữ _mutex
+     * @param text Câu SQL cần khớp, nullptr nếu không so
+     * @param statementId Statement ID cần khớp, nullptr nếu không so
+     */
+    Result<const TraceEvent*> nextReplayEvent(TraceOp op, const std::string* text, const int* statementId);
+
+    void append(TraceEvent event);
+
+    /// Phát lại một lời gọi trả về bool/int/void
+    template <typename T>
+    Result<T> replayValue(TraceOp op, const std::string* text, const int* statementId);
+
+    /// Ghi lại một lời gọi đã chuyển tiếp tới kết nối thật
+    template <typename T>
+    Result<T> recordValue(TraceOp op, const std::string& text, int statementId, int paramIndex,
+                          Result<T> result, uint64_t nanos);
+
+    Result<std::unique_ptr<IDatabaseResult>> replayQuery(TraceOp op, const std::string* text, const int* statementId);
+    Result<std::unique_ptr<IDatabaseResult>> recordQuery(TraceOp op, const std::string& text, int statementId,
+                                                         Result<std::unique_ptr<IDatabaseResult>> result, uint64_t nanos);
+
+public:
+    /**
+     * @brief Tạo kết nối ở chế độ ghi
+     * @param inner Kết nối thật được bọc
+     */
+    explicit TraceConnection(std::shared_ptr<IDatabaseConnection> inner);
+
+    /**
+     * @brief Tạo kết nối ở chế độ phát lại
+     * @param trace Trace đã ghi
+     */
+    explicit TraceConnection(Trace trace);
+
+    TraceConnection(const TraceConnection&) = delete;
+    TraceConnection& operator=(const TraceConnection&) = delete;
+
+    Mode getMode() const { return _mode; }
+
+    /**
+     * @brief Bản sao trace hiện tại (đã ghi hoặc đang phát lại)
+     * @note Ô dữ liệu chỉ được ghi khi mã gọi đọc nó; gọi sau khi các tập kết quả đã dùng xong
+     */
+    Trace getTrace() const;
+
+    /**
+     * @brief Ghi trace hiện tại ra file
+     */
+    VoidResult saveTrace(const std::string& path) const;
+
+    /**
+     * @brief Đánh dấu bắt đầu một thao tác người dùng
+     * @param label Tên thao tác, ví dụ "bookTicket"
+     *
+     * Khi phát lại, MARK kế tiếp (nếu có) được bỏ qua để giữ đồng bộ vị trí.
+     */
+    void mark(const std::string& label);
+
+    /**
+     * @brief Số lời gọi chưa được phát lại
+     */
+    size_t remainingEvents() const;
+
+    Result<bool> connect(const std::string& host, const std::string& user,
+                         const std::string& password, const std::string& database,
+                         const int& port = 33060) override;
+    VoidResult disconnect() override;
+
+    Result<bool> execute(const std::string& query) override;
+    Result<std::unique_ptr<IDatabaseResult>> executeQuery(const std::string& query) override;
+
+    Result<int> prepareStatement(const std::string& query) override;
+    VoidResult setString(const int& statementId, const int& paramIndex, const std::string& value) override;
+    VoidResult setInt(const int& statementId, const int& paramIndex, const int& value) override;
+    VoidResult setDouble(const int& statementId, const int& paramIndex, const double& value) override;
+    VoidResult setDateTime(const int& statementId, const int& paramIndex, const std::tm& value) override;
+    Result<bool> executeStatement(const int& statementId) override;
+    Result<int> executeUpdate(const int& statementId) override;
+    Result<std::unique_ptr<IDatabaseResult>> executeQueryStatement(const int& statementId) override;
+    VoidResult freeStatement(const int& statementId) override;
+
+    Result<int> getLastInsertId() override;
+    Result<bool> isConnected() const override;
+    Result<std::string> getLastError() const override;
+
+    Result<bool> beginTransaction() override;
+    Result<bool> commitTransaction() override;
+    Result<bool> rollbackTransaction() override;
+};
+
+#endif // TRACE_CONNECTION_H
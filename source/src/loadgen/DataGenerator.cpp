@@ -0,0 +1,259 @@
+#include "DataGenerator.h"
+#include <cctype>
+#include <cmath>
+#include <random>
+
+namespace LoadGen {
+
+namespace {
+    const char* const FIRST_NAMES[] = {
+        "An", "Binh", "Chi", "Dung", "Giang", "Ha", "Hai", "Hoa", "Hung", "Khanh",
+        "Lan", "Linh", "Long", "Mai", "Minh", "Nam", "Ngoc", "Phuong", "Quang", "Son",
+        "Thao", "Thu", "Trang", "Tuan", "Viet", "Yen"
+    };
+    const char* const MIDDLE_NAMES[] = {"Van", "Thi", "Minh", "Duc", "Ngoc", "Thanh", "Huu", "Kim"};
+    const char* const LAST_NAMES[] = {
+        "Nguyen", "Tran", "Le", "Pham", "Hoang", "Huynh", "Phan", "Vu", "Vo", "Dang",
+        "Bui", "Do", "Ho", "Ngo", "Duong", "Ly"
+    };
+    const char* const STREETS[] = {
+        "Nguyen Hue", "Le Loi", "Dong Khoi", "Tran Hung Dao", "Hai Ba Trung", "Nguyen Trai",
+        "Ly Tu Trong", "Vo Van Tan", "Dien Bien Phu", "Cach Mang Thang Tam", "Le Duan", "Pasteur"
+    };
+    const char* const CITIES[] = {"Ho Chi Minh City", "Ha Noi", "Da Nang", "Hai Phong", "Can Tho", "Nha Trang", "Hue"};
+
+    template <size_t N>
+    const char* pick(const char* const (&values)[N], uint64_t draw) {
+        return values[draw % N];
+    }
+
+    std::string lower(std::string text) {
+        for (auto& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return text;
+    }
+}
+
+// === Sink ===
+
+VoidResult ConnectionSink::write(const std::string& statement) {
+    if (_pending == 0) {
+        auto beginResult = _connection->beginTransaction();
+        if (!beginResult) return Failure(beginResult.error());
+    }
+    auto executeResult = _connection->execute(statement);
+    if (!executeResult) {
+        _connection->rollbackTransaction();
+        _pending = 0;
+        return Failure(executeResult.error());
+    }
+    if (++_pending >= _statementsPerTransaction) {
+        return finish();
+    }
+    return Success();
+}
+
+VoidResult ConnectionSink::finish() {
+    if (_pending == 0) return Success();
+    _pending = 0;
+    auto commitResult = _connection->commitTransaction();
+    if (!commitResult) return Failure(commitResult.error());
+    return Success();
+}
+
+VoidResult SqlScriptSink::write(const std::string& statement) {
+    if (!_started) {
+        _started = true;
+        _out << "SET autocommit = 0;\nSET unique_checks = 0;\nSET foreign_key_checks = 0;\n";
+    }
+    _out << statement << ";\n";
+    if (++_pending >= _statementsPerTransaction) {
+        _pending = 0;
+        _out << "COMMIT;\n";
+    }
+    if (!_out.good()) {
+        return Failure(CoreError("Failed to write SQL script", "GENERATOR_IO"));
+    }
+    return Success();
+}
+
+VoidResult SqlScriptSink::finish() {
+    if (!_started) return Success();
+    _out << "COMMIT;\nSET unique_checks = 1;\nSET foreign_key_checks = 1;\nSET autocommit = 1;\n";
+    _out.flush();
+    if (!_out.good()) {
+        return Failure(CoreError("Failed to write SQL script", "GENERATOR_IO"));
+    }
+    return Success();
+}
+
+// === BulkInserter ===
+
+BulkInserter::BulkInserter(IInsertSink& sink, const std::string& table, const std::string& columns, size_t batchSize)
+    : _sink(sink), _prefix("INSERT INTO " + table + " (" + columns + ") VALUES "), _batchSize(std::max<size_t>(1, batchSize)) {}
+
+VoidResult BulkInserter::add(const std::string& tuple) {
+    if (_rows == 0) {
+        _statement = _prefix;
+    } else {
+        _statement += ", ";
+    }
+    _statement += tuple;
+    ++_totalRows;
+    if (++_rows >= _batchSize) {
+        return flush();
+    }
+    return Success();
+}
+
+VoidResult BulkInserter::flush() {
+    if (_rows == 0) return Success();
+    _rows = 0;
+    return _sink.write(_statement);
+}
+
+// === DataGenerator ===
+
+void DataGenerator::reportProgress(const std::string& table, size_t done, size_t total, bool force) {
+    if (_progress && (force || done % PROGRESS_INTERVAL == 0)) {
+        _progress(table, done, total);
+    }
+}
+
+VoidResult DataGenerator::generateAircraft(IInsertSink& sink, GenerationSummary& summary) {
+    const size_t count = _dataset.config().aircraftCount;
+    BulkInserter aircraft(sink, "aircraft", "id, serial_number, model, economy_seats, business_seats, first_seats", _batchSize);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& model = _dataset.aircraftModelOf(i);
+        auto result = aircraft.add("(" + std::to_string(_dataset.aircraftId(i)) + ", " +
+                                   sqlQuote(_dataset.aircraftSerial(i)) + ", " + sqlQuote(model.name) + ", " +
+                                   std::to_string(model.economySeats) + ", " + std::to_string(model.businessSeats) + ", " +
+                                   std::to_string(model.firstSeats) + ")");
+        if (!result) return result;
+    }
+    if (auto result = aircraft.flush(); !result) return result;
+    summary.aircraft = aircraft.totalRows();
+    reportProgress("aircraft", summary.aircraft, count, true);
+
+    BulkInserter layout(sink, "aircraft_seat_layout", "aircraft_id, seat_class_code, seat_count", _batchSize);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& model = _dataset.aircraftModelOf(i);
+        const std::pair<char, int> classes[] = {{'E', model.economySeats}, {'B', model.businessSeats}, {'F', model.firstSeats}};
+        for (const auto& [code, seats] : classes) {
+            if (seats == 0) continue;
+            auto result = layout.add("(" + std::to_string(_dataset.aircraftId(i)) + ", '" + code + "', " + std::to_string(seats) + ")");
+            if (!result) return result;
+        }
+    }
+    if (auto result = layout.flush(); !result) return result;
+    summary.seatLayouts = layout.totalRows();
+    return Success();
+}
+
+VoidResult DataGenerator::generatePassengers(IInsertSink& sink, GenerationSummary& summary) {
+    const size_t count = _dataset.config().passengerCount;
+    std::mt19937_64 rng(_dataset.config().seed ^ 0x70617373656e67ULL);
+    BulkInserter passengers(sink, "passenger", "id, passport_number, name, email, phone, address", _batchSize);
+    for (size_t i = 0; i < count; ++i) {
+        std::string last = pick(LAST_NAMES, rng());
+        std::string middle = pick(MIDDLE_NAMES, rng());
+        std::string first = pick(FIRST_NAMES, rng());
+        // Email và số điện thoại chứa chỉ số nên luôn khác nhau
+        std::string email = lower(first) + "." + lower(last) + std::to_string(i) + "@example.com";
+        std::string phone = "+84" + std::to_string(900000000 + i % 100000000);
+        std::string address = std::to_string(1 + rng() % 400) + " " + pick(STREETS, rng()) +
+                              ", District " + std::to_string(1 + rng() % 12) + ", " + pick(CITIES, rng());
+
+        auto result = passengers.add("(" + std::to_string(_dataset.passengerId(i)) + ", " +
+                                     sqlQuote(_dataset.passportNumber(i)) + ", " +
+                                     sqlQuote(last + " " + middle + " " + first) + ", " + sqlQuote(email) + ", " +
+                                     sqlQuote(phone) + ", " + sqlQuote(address) + ")");
+        if (!result) return result;
+        reportProgress("passenger", i + 1, count);
+    }
+    if (auto result = passengers.flush(); !result) return result;
+    summary.passengers = passengers.totalRows();
+    reportProgress("passenger", summary.passengers, count, true);
+    return Success();
+}
+
+VoidResult DataGenerator::generateFlights(IInsertSink& sink, GenerationSummary& summary) {
+    const auto& plans = _dataset.flights();
+    const auto& airports = SyntheticDataset::airports();
+    const auto& statusNames = SyntheticDataset::flightStatusNames();
+    BulkInserter flights(sink, "flight",
+                         "id, flight_number, departure_code, departure_name, arrival_code, arrival_name, "
+                         "aircraft_id, departure_time, arrival_time, status", _batchSize);
+    for (size_t i = 0; i < plans.size(); ++i) {
+        const auto& route = _dataset.routes()[plans[i].route];
+        const auto& origin = airports[route.origin];
+        const auto& destination = airports[route.destination];
+        auto result = flights.add("(" + std::to_string(_dataset.flightId(i)) + ", " + sqlQuote(_dataset.flightNumber(i)) + ", " +
+                                  sqlQuote(origin.code) + ", " + sqlQuote(origin.name) + ", " +
+                                  sqlQuote(destination.code) + ", " + sqlQuote(destination.name) + ", " +
+                                  std::to_string(_dataset.aircraftId(plans[i].aircraft)) + ", " +
+                                  sqlQuote(_dataset.departureTime(i)) + ", " + sqlQuote(_dataset.arrivalTime(i)) + ", " +
+                                  sqlQuote(statusNames[plans[i].status]) + ")");
+        if (!result) return result;
+        reportProgress("flight", i + 1, plans.size());
+    }
+    if (auto result = flights.flush(); !result) return result;
+    summary.flights = flights.totalRows();
+    reportProgress("flight", summary.flights, plans.size(), true);
+    return Success();
+}
+
+VoidResult DataGenerator::generateTickets(IInsertSink& sink, GenerationSummary& summary) {
+    const auto& plans = _dataset.flights();
+    std::mt19937_64 rng(_dataset.config().seed ^ 0x7469636b6574ULL);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    BulkInserter tickets(sink, "ticket",
+                         "ticket_number, flight_id, passenger_id, seat_number, price, currency, status", _batchSize);
+    BulkInserter availability(sink, "flight_seat_availability", "flight_id, seat_number, is_available", _batchSize);
+
+    for (size_t i = 0; i < plans.size(); ++i) {
+        const auto& route = _dataset.routes()[plans[i].route];
+        const bool flightCancelled = plans[i].status == 2;
+        const std::string flightId = std::to_string(_dataset.flightId(i));
+        auto seats = _dataset.seatOrder(i);
+
+        for (size_t seat = 0; seat < seats.size(); ++seat) {
+            bool sold = seat < plans[i].ticketCount;
+            bool active = sold;
+            if (sold) {
+                double statusDraw = unit(rng);
+                bool cancelled = flightCancelled || statusDraw < 0.04;
+                const char* status = cancelled ? "CANCELLED" : (statusDraw < 0.14 ? "CHECKED_IN" : "CONFIRMED");
+                active = !cancelled;   // vé đã hủy trả lại ghế
+                double classFactor = seats[seat][0] == 'F' ? 4.0 : (seats[seat][0] == 'B' ? 2.5 : 1.0);
+                auto price = std::llround(route.basePrice * classFactor * (0.8 + 0.4 * unit(rng)) / 1000) * 1000;
+                auto passenger = _dataset.samplePassenger(rng);
+
+                auto result = tickets.add("(" + sqlQuote(_dataset.ticketNumber(i, seat + 1)) + ", " + flightId + ", " +
+                                          std::to_string(_dataset.passengerId(passenger)) + ", " + sqlQuote(seats[seat]) + ", " +
+                                          std::to_string(price) + ", 'VND', " + sqlQuote(status) + ")");
+                if (!result) return result;
+                reportProgress("ticket", tickets.totalRows(), _dataset.plannedTickets());
+            }
+            auto result = availability.add("(" + flightId + ", " + sqlQuote(seats[seat]) + ", " + (active ? "FALSE" : "TRUE") + ")");
+            if (!result) return result;
+        }
+    }
+    if (auto result = tickets.flush(); !result) return result;
+    if (auto result = availability.flush(); !result) return result;
+    summary.tickets = tickets.totalRows();
+    summary.seatAvailability = availability.totalRows();
+    reportProgress("ticket", summary.tickets, _dataset.plannedTickets(), true);
+    return Success();
+}
+
+Result<GenerationSummary> DataGenerator::generate(IInsertSink& sink) {
+    GenerationSummary summary;
+    if (auto result = generateAircraft(sink, summary); !result) return Failure<GenerationSummary>(result.error());
+    if (auto result = generatePassengers(sink, summary); !result) return Failure<GenerationSummary>(result.error());
+    if (auto result = generateFlights(sink, summary); !result) return Failure<GenerationSummary>(result.error());
+    if (auto result = generateTickets(sink, summary); !result) return Failure<GenerationSummary>(result.error());
+    if (auto result = sink.finish(); !result) return Failure<GenerationSummary>(result.error());
+    return Success(summary);
+}
+
+} // namespace LoadGen
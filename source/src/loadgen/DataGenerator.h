@@ -0,0 +1,153 @@
+/**
+ * @file DataGenerator.h
+ * @brief Nạp SyntheticDataset vào cơ sở dữ liệu bằng INSERT nhiều hàng
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi bảng có một BulkInserter gom các bộ giá trị thành câu INSERT ... VALUES (...), (...) với
+ * tối đa batchSize hàng. Câu lệnh được chuyển cho một IInsertSink:
+ * - ConnectionSink: thực thi qua IDatabaseConnection (MySQLXConnection hoặc InMemoryConnection),
+ *   gom nhiều câu lệnh vào một transaction;
+ * - SqlScriptSink: ghi ra file .sql để nạp bằng `mysql airlines_db < data.sql`, nhanh hơn nhiều
+ *   khi dữ liệu lớn vì không phải đi qua X Protocol.
+ *
+ * Thứ tự nạp tuân theo khóa ngoại: aircraft, aircraft_seat_layout, passenger, flight, rồi vé và
+ * flight_seat_availability theo từng chuyến bay. Các bảng đích phải chưa có hàng nào trùng id
+ * (xem GeneratorConfig::idOffset).
+ */
+
+#ifndef DATA_GENERATOR_H
+#define DATA_GENERATOR_H
+
+#include "SyntheticDataset.h"
+#include "../database/InterfaceDatabaseConnection.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace LoadGen {
+
+/**
+ * @brief Đích nhận các câu INSERT đã ghép
+ */
+class IInsertSink {
+public:
+    virtual ~IInsertSink() = default;
+
+    virtual VoidResult write(const std::string& statement) = 0;
+    /// Kết thúc transaction đang mở (nếu có); gọi một lần sau câu lệnh cuối
+    virtual VoidResult finish() = 0;
+};
+
+/**
+ * @brief Thực thi trực tiếp qua kết nối, commit sau mỗi statementsPerTransaction câu lệnh
+ */
+class ConnectionSink : public IInsertSink {
+private:
+    std::shared_ptr<IDatabaseConnection> _connection;
+    size_t _statementsPerTransaction;
+    size_t _pending = 0;
+
+public:
+    ConnectionSink(std::shared_ptr<IDatabaseConnection> connection, size_t statementsPerTransaction = 20)
+        : _connection(std::move(connection)), _statementsPerTransaction(std::max<size_t>(1, statementsPerTransaction)) {}
+
+    VoidResult write(const std::string& statement) override;
+    VoidResult finish() override;
+};
+
+/**
+ * @brief Ghi script SQL, tắt kiểm tra khóa ngoại/khóa duy nhất và commit theo lô để nạp nhanh
+ */
+class SqlScriptSink : public IInsertSink {
+private:
+    std::ostream& _out;
+    size_t _statementsPerTransaction;
+    size_t _pending = 0;
+    bool _started = false;
+
+public:
+    explicit SqlScriptSink(std::ostream& out, size_t statementsPerTransaction = 20)
+        : _out(out), _statementsPerTransaction(std::max<size_t>(1, statementsPerTransaction)) {}
+
+    VoidResult write(const std::string& statement) override;
+    VoidResult finish() override;
+};
+
+/**
+ * @brief Gom các hàng của một bảng thành INSERT nhiều hàng
+ */
+class BulkInserter {
+private:
+    IInsertSink& _sink;
+    std::string _prefix;      ///< "INSERT INTO bảng (cột, ...) VALUES "
+    std::string _statement;
+    size_t _batchSize;
+    size_t _rows = 0;
+    size_t _totalRows = 0;
+
+public:
+    BulkInserter(IInsertSink& sink, const std::string& table, const std::string& columns, size_t batchSize);
+
+    /// Thêm một bộ giá trị đã định dạng, ví dụ "(1, 'VN10000', 170)"; tự ghi khi đủ lô
+    VoidResult add(const std::string& tuple);
+    VoidResult flush();
+
+    size_t totalRows() const { return _totalRows; }
+};
+
+/**
+ * @brief Số hàng đã nạp cho từng bảng
+ */
+struct GenerationSummary {
+    size_t aircraft = 0;
+    size_t seatLayouts = 0;
+    size_t passengers = 0;
+    size_t flights = 0;
+    size_t tickets = 0;
+    size_t seatAvailability = 0;
+};
+
+class DataGenerator {
+public:
+    static constexpr size_t PROGRESS_INTERVAL = 100000;
+
+private:
+    const SyntheticDataset& _dataset;
+    size_t _batchSize;
+    std::function<void(const std::string&, size_t, size_t)> _progress;
+
+    VoidResult generateAircraft(IInsertSink& sink, GenerationSummary& summary);
+    VoidResult generatePassengers(IInsertSink& sink, GenerationSummary& summary);
+    VoidResult generateFlights(IInsertSink& sink, GenerationSummary& summary);
+    VoidResult generateTickets(IInsertSink& sink, GenerationSummary& summary);
+    void reportProgress(const std::string& table, size_t done, size_t total, bool force = false);
+
+public:
+    /**
+     * @param dataset Tập dữ liệu đã lập kế hoạch; phải sống lâu hơn DataGenerator
+     * @param batchSize Số hàng tối đa trong một câu INSERT
+     */
+    explicit DataGenerator(const SyntheticDataset& dataset, size_t batchSize = 1000)
+        : _dataset(dataset), _batchSize(std::max<size_t>(1, batchSize)) {}
+
+    /**
+     * @brief Đăng ký callback tiến độ (tên bảng, số hàng đã sinh, tổng dự kiến)
+     *
+     * Được gọi sau mỗi PROGRESS_INTERVAL hàng và khi xong mỗi bảng, đủ thưa để in ra console.
+     */
+    void onProgress(std::function<void(const std::string&, size_t, size_t)> progress) { _progress = std::move(progress); }
+
+    /**
+     * @brief Sinh và ghi toàn bộ dữ liệu
+     * @return Số hàng theo bảng, hoặc lỗi đầu tiên từ sink (dữ liệu đã commit trước đó được giữ nguyên)
+     */
+    Result<GenerationSummary> generate(IInsertSink& sink);
+};
+
+} // namespace LoadGen
+
+#endif // DATA_GENERATOR_H
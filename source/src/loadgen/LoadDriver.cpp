@@ -0,0 +1,259 @@
+#include "LoadDriver.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace LoadGen {
+
+namespace {
+    const char* const OPERATION_NAMES[OPERATION_COUNT] = {"book", "cancel", "search", "checkin"};
+    // Vé tự đặt được giữ lại để hủy hoặc check-in sau, tối đa số này mỗi luồng
+    constexpr size_t MAX_OWN_TICKETS = 1024;
+
+    double millis(uint64_t nanos) {
+        return nanos / 1e6;
+    }
+}
+
+const char* operationName(Operation operation) {
+    return OPERATION_NAMES[static_cast<size_t>(operation)];
+}
+
+Result<WorkloadMix> WorkloadMix::parse(const std::string& text) {
+    WorkloadMix mix;
+    mix.weights.fill(0);
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        auto separator = item.find('=');
+        if (separator == std::string::npos) {
+            return Failure<WorkloadMix>(CoreError("Expected name=weight in workload mix: " + item, "INVALID_DRIVER_CONFIG"));
+        }
+        std::string name = item.substr(0, separator);
+        auto it = std::find(std::begin(OPERATION_NAMES), std::end(OPERATION_NAMES), name);
+        if (it == std::end(OPERATION_NAMES)) {
+            return Failure<WorkloadMix>(CoreError("Unknown operation in workload mix: " + name, "INVALID_DRIVER_CONFIG"));
+        }
+        try {
+            double weight = std::stod(item.substr(separator + 1));
+            if (weight < 0) throw std::invalid_argument("negative");
+            mix.weights[it - std::begin(OPERATION_NAMES)] = weight;
+        } catch (const std::exception&) {
+            return Failure<WorkloadMix>(CoreError("Invalid weight in workload mix: " + item, "INVALID_DRIVER_CONFIG"));
+        }
+    }
+    return Success(mix);
+}
+
+// === LoadReport ===
+
+uint64_t LoadReport::totalOperations() const {
+    uint64_t total = 0;
+    for (const auto& operation : operations) total += operation.total();
+    return total;
+}
+
+void LoadReport::print(std::ostream& out) const {
+    char line[256];
+    std::snprintf(line, sizeof(line), "%zu threads, %.2f s, %llu operations, %.1f ops/s\n\n", threads, elapsedSeconds,
+                  static_cast<unsigned long long>(totalOperations()), throughput());
+    out << line;
+    std::snprintf(line, sizeof(line), "%-8s %10s %10s %10s %10s %9s %9s %9s %9s %9s\n",
+                  "op", "ok", "failed", "ops/s", "mean ms", "p50", "p95", "p99", "p99.9", "max");
+    out << line;
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        const auto& report = operations[i];
+        if (report.total() == 0) continue;
+        const auto& latency = report.latencyNanos;
+        std::snprintf(line, sizeof(line), "%-8s %10llu %10llu %10.1f %10.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                      OPERATION_NAMES[i], static_cast<unsigned long long>(report.succeeded),
+                      static_cast<unsigned long long>(report.failed),
+                      elapsedSeconds > 0 ? report.total() / elapsedSeconds : 0.0, latency.mean() / 1e6,
+                      millis(latency.valueAtPercentile(50)), millis(latency.valueAtPercentile(95)),
+                      millis(latency.valueAtPercentile(99)), millis(latency.valueAtPercentile(99.9)),
+                      millis(latency.max()));
+        out << line;
+    }
+
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        if (operations[i].errors.empty()) continue;
+        std::vector<std::pair<std::string, uint64_t>> errors(operations[i].errors.begin(), operations[i].errors.end());
+        std::sort(errors.begin(), errors.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        out << "\n" << OPERATION_NAMES[i] << " errors:";
+        for (size_t e = 0; e < std::min<size_t>(errors.size(), 5); ++e) {
+            out << " " << errors[e].first << "=" << errors[e].second;
+        }
+        out << "\n";
+    }
+}
+
+// === LoadDriver ===
+
+struct LoadDriver::Worker {
+    std::mt19937_64 rng;
+    DriverServices services;
+    std::array<OperationReport, OPERATION_COUNT> operations;
+    std::vector<std::string> ownTickets;
+    uint64_t completed = 0;
+};
+
+Result<LoadReport> LoadDriver::run() {
+    double totalWeight = 0;
+    for (double weight : _config.mix.weights) totalWeight += weight;
+    if (_config.threads == 0 || totalWeight <= 0) {
+        return Failure<LoadReport>(CoreError("Load driver needs at least one thread and a positive workload mix", "INVALID_DRIVER_CONFIG"));
+    }
+    if (_dataset.flights().empty() || _dataset.config().passengerCount == 0) {
+        return Failure<LoadReport>(CoreError("Load driver needs a dataset with flights and passengers", "INVALID_DRIVER_CONFIG"));
+    }
+
+    std::vector<Worker> workers(_config.threads);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].rng.seed(_config.seed * 1000003 + i);
+        workers[i].services = _factory();
+    }
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    auto startTime = std::chrono::steady_clock::now();
+    for (auto& worker : workers) {
+        threads.emplace_back([this, &worker, &start, &startTime] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+            runWorker(worker, startTime + _config.duration);
+        });
+    }
+    startTime = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : threads) thread.join();
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+    LoadReport report;
+    report.threads = workers.size();
+    report.elapsedSeconds = std::chrono::duration<double>(elapsed).count();
+    for (auto& worker : workers) {
+        for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+            auto& target = report.operations[i];
+            const auto& source = worker.operations[i];
+            target.succeeded += source.succeeded;
+            target.failed += source.failed;
+            target.latencyNanos.merge(source.latencyNanos);
+            for (const auto& [code, count] : source.errors) target.errors[code] += count;
+        }
+    }
+    return Success(std::move(report));
+}
+
+void LoadDriver::runWorker(Worker& worker, std::chrono::steady_clock::time_point deadline) const {
+    std::discrete_distribution<size_t> pickOperation(_config.mix.weights.begin(), _config.mix.weights.end());
+    for (;;) {
+        if (_config.operationsPerThread > 0) {
+            if (worker.completed >= _config.operationsPerThread) return;
+        } else if (std::chrono::steady_clock::now() >= deadline) {
+            return;
+        }
+        execute(worker, static_cast<Operation>(pickOperation(worker.rng)));
+        ++worker.completed;
+    }
+}
+
+void LoadDriver::execute(Worker& worker, Operation operation) const {
+    auto& report = worker.operations[static_cast<size_t>(operation)];
+    auto& rng = worker.rng;
+
+    // Vé để hủy/check-in: ưu tiên vé luồng này vừa đặt, còn lại lấy từ dữ liệu đã sinh
+    auto pickTicket = [&]() -> std::string {
+        if (!worker.ownTickets.empty() && (rng() & 1)) {
+            std::string ticket = std::move(worker.ownTickets.back());
+            worker.ownTickets.pop_back();
+            return ticket;
+        }
+        if (_dataset.plannedTickets() == 0) return "";
+        auto [flight, sequence] = _dataset.sampleTicket(rng);
+        return _dataset.ticketNumber(flight, sequence);
+    };
+
+    // Chuẩn bị tham số trước khi bấm giờ để chỉ đo lượt gọi service
+    std::function<Result<bool>()> call;
+    switch (operation) {
+        case Operation::BOOK: {
+            size_t flight = _dataset.sampleFlight(rng);
+            const auto& model = _dataset.aircraftModelOf(_dataset.flights()[flight].aircraft);
+            double classDraw = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+            char classCode = 'E';
+            int classSeats = model.economySeats;
+            double factor = 1.0;
+            if (classDraw < 0.03 && model.firstSeats > 0) {
+                classCode = 'F', classSeats = model.firstSeats, factor = 4.0;
+            } else if (classDraw < 0.15 && model.businessSeats > 0) {
+                classCode = 'B', classSeats = model.businessSeats, factor = 2.5;
+            }
+            std::string seat = std::string(1, classCode) + std::to_string(1 + rng() % classSeats);
+            auto passport = PassportNumber::create(_dataset.passportNumber(_dataset.samplePassenger(rng))).value();
+            auto flightNumber = FlightNumber::create(_dataset.flightNumber(flight)).value();
+            auto price = Price::create(static_cast<double>(_dataset.routes()[_dataset.flights()[flight].route].basePrice * factor), "VND").value();
+            call = [&worker, passport, flightNumber, seat, price]() -> Result<bool> {
+                auto ticket = worker.services.tickets->bookTicket(passport, flightNumber, seat, price);
+                if (!ticket) return Failure<bool>(ticket.error());
+                if (worker.ownTickets.size() < MAX_OWN_TICKETS) {
+                    worker.ownTickets.push_back(ticket.value().getTicketNumber().toString());
+                }
+                return Success(true);
+            };
+            break;
+        }
+        case Operation::CANCEL:
+        case Operation::CHECK_IN: {
+            auto ticketNumber = TicketNumber::create(pickTicket());
+            if (!ticketNumber) {
+                ++report.failed;
+                ++report.errors["NO_TICKET"];
+                return;
+            }
+            bool cancel = operation == Operation::CANCEL;
+            call = [&worker, cancel, ticketNumber = ticketNumber.value()]() -> Result<bool> {
+                return cancel ? worker.services.tickets->cancelTicket(ticketNumber, "Load test")
+                              : worker.services.tickets->checkInTicket(ticketNumber);
+            };
+            break;
+        }
+        case Operation::SEARCH: {
+            // Nửa số lượt xem sơ đồ ghế trống của một chuyến bay (lệch theo tuyến), nửa còn lại tra vé
+            // của một hành khách; FlightService::getFlightsByRoute chưa được cài đặt nên không dùng
+            if (rng() & 1) {
+                auto flightNumber = FlightNumber::create(_dataset.flightNumber(_dataset.sampleFlight(rng))).value();
+                call = [&worker, flightNumber]() -> Result<bool> {
+                    auto seats = worker.services.flights->getAvailableSeats(flightNumber, "ECONOMY");
+                    if (!seats) return Failure<bool>(seats.error());
+                    return Success(true);
+                };
+            } else {
+                auto passport = PassportNumber::create(_dataset.passportNumber(_dataset.samplePassenger(rng))).value();
+                call = [&worker, passport]() -> Result<bool> {
+                    auto tickets = worker.services.tickets->searchByPassenger(passport);
+                    if (!tickets) return Failure<bool>(tickets.error());
+                    return Success(true);
+                };
+            }
+            break;
+        }
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    auto result = call();
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    report.latencyNanos.record(static_cast<uint64_t>(nanos));
+    if (result && result.value()) {
+        ++report.succeeded;
+    } else {
+        ++report.failed;
+        std::string code = result ? "REJECTED" : result.error().code;
+        ++report.errors[code.empty() ? "UNKNOWN" : code];
+    }
+}
+
+} // namespace LoadGen
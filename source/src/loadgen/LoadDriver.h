@@ -0,0 +1,129 @@
+/**
+ * @file LoadDriver.h
+ * @brief Phát tải hỗn hợp đặt vé, hủy vé, tìm kiếm và check-in từ nhiều luồng lên các service
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi luồng có bộ service riêng (do ServiceFactory tạo) và bộ sinh số ngẫu nhiên riêng, chọn
+ * thao tác theo trọng số của WorkloadMix. Khóa nghiệp vụ (hộ chiếu, số hiệu chuyến bay, số vé)
+ * được lấy mẫu từ SyntheticDataset với cùng độ lệch như lúc sinh dữ liệu, nên các tuyến phổ biến
+ * nhận nhiều đặt vé và tìm kiếm hơn.
+ *
+ * Độ trễ từng lượt gọi được ghi vào LatencyHistogram riêng của luồng (không khóa) rồi gộp khi kết
+ * thúc. Thông lượng tính trên thời gian tường từ lúc mọi luồng cùng bắt đầu.
+ *
+ * Lưu ý: MySQLXConnection là singleton, mọi luồng dùng chung một session có mutex, nên với MySQL
+ * con số đo được gồm cả thời gian chờ session đó.
+ */
+
+#ifndef LOAD_DRIVER_H
+#define LOAD_DRIVER_H
+
+#include "SyntheticDataset.h"
+#include "../database/QueryStats.h"
+#include "../services/FlightService.h"
+#include "../services/TicketService.h"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace LoadGen {
+
+enum class Operation {
+    BOOK,
+    CANCEL,
+    SEARCH,
+    CHECK_IN
+};
+
+constexpr size_t OPERATION_COUNT = 4;
+
+const char* operationName(Operation operation);
+
+/**
+ * @brief Trọng số tương đối của từng thao tác
+ */
+struct WorkloadMix {
+    std::array<double, OPERATION_COUNT> weights = {30, 10, 50, 10};  ///< Theo thứ tự của Operation
+
+    /**
+     * @brief Đọc chuỗi dạng "book=30,cancel=10,search=50,checkin=10"
+     *
+     * Thao tác không được nêu có trọng số 0.
+     */
+    static Result<WorkloadMix> parse(const std::string& text);
+};
+
+struct LoadDriverConfig {
+    size_t threads = 4;
+    std::chrono::milliseconds duration{10000};
+    uint64_t operationsPerThread = 0;   ///< Khác 0 thì dừng sau số thao tác này thay vì theo duration
+    WorkloadMix mix;
+    uint64_t seed = 7;
+};
+
+/**
+ * @brief Service dùng riêng cho một luồng
+ */
+struct DriverServices {
+    std::shared_ptr<TicketService> tickets;
+    std::shared_ptr<FlightService> flights;
+};
+
+struct OperationReport {
+    uint64_t succeeded = 0;
+    uint64_t failed = 0;
+    LatencyHistogram latencyNanos;
+    std::map<std::string, uint64_t> errors;   ///< Số lần theo mã lỗi
+
+    uint64_t total() const { return succeeded + failed; }
+};
+
+struct LoadReport {
+    double elapsedSeconds = 0;
+    size_t threads = 0;
+    std::array<OperationReport, OPERATION_COUNT> operations;
+
+    uint64_t totalOperations() const;
+    double throughput() const { return elapsedSeconds > 0 ? totalOperations() / elapsedSeconds : 0.0; }
+
+    /// Bảng thông lượng, p50/p95/p99/p99.9/max (ms) và các mã lỗi thường gặp của từng thao tác
+    void print(std::ostream& out) const;
+};
+
+class LoadDriver {
+public:
+    using ServiceFactory = std::function<DriverServices()>;
+
+private:
+    const SyntheticDataset& _dataset;
+    ServiceFactory _factory;
+    LoadDriverConfig _config;
+
+    struct Worker;
+    void runWorker(Worker& worker, std::chrono::steady_clock::time_point deadline) const;
+    void execute(Worker& worker, Operation operation) const;
+
+public:
+    /**
+     * @param dataset Mô tả dữ liệu đã nạp; phải sống lâu hơn LoadDriver
+     * @param factory Được gọi một lần cho mỗi luồng trước khi bắt đầu đo
+     */
+    LoadDriver(const SyntheticDataset& dataset, ServiceFactory factory, LoadDriverConfig config)
+        : _dataset(dataset), _factory(std::move(factory)), _config(std::move(config)) {}
+
+    /**
+     * @brief Chạy tải cho đến hết duration (hoặc đủ operationsPerThread) và gộp kết quả
+     * @return Lỗi INVALID_DRIVER_CONFIG nếu không có luồng, tổng trọng số bằng 0 hoặc tập dữ liệu rỗng
+     */
+    Result<LoadReport> run();
+};
+
+} // namespace LoadGen
+
+#endif // LOAD_DRIVER_H
@@ -0,0 +1,356 @@
+#include "SyntheticDataset.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+namespace LoadGen {
+
+namespace {
+    constexpr size_t FLIGHT_NUMBERS_PER_PREFIX = 9999;
+    constexpr double EARTH_RADIUS_KM = 6371.0;
+    constexpr double CRUISE_SPEED_KMH = 800.0;
+    constexpr double PI = 3.14159265358979323846;
+
+    struct AirportLocation {
+        double latitude;
+        double longitude;
+    };
+
+    // Cùng thứ tự với airports(); sân bay đứng trước được coi là lớn hơn
+    const AirportLocation AIRPORT_LOCATIONS[] = {
+        {10.8188, 106.6520}, {21.2212, 105.8072}, {16.0439, 108.1994}, {11.9982, 109.2194},
+        {10.1698, 103.9931}, {37.4602, 126.4407}, {13.6900, 100.7501}, {1.3644, 103.9915},
+        {20.8194, 106.7250}, {35.7720, 140.3929}, {22.3080, 113.9185}, {25.0797, 121.2342},
+        {16.4015, 107.7026}, {18.7376, 105.6708}, {2.7456, 101.7072}, {31.1443, 121.8083},
+        {10.0851, 105.7117}, {11.7500, 108.3670}, {34.4320, 135.2304}, {14.5086, 121.0194},
+        {-6.1256, 106.6559}, {11.5466, 104.8441}, {13.9550, 109.0420}, {12.6683, 108.1203},
+        {-33.9399, 151.1753}, {49.0097, 2.5479}, {50.0379, 8.5622}, {51.4700, -0.4543},
+        {37.6213, -122.3790}, {17.9883, 102.5633}
+    };
+
+    double distanceKm(const AirportLocation& a, const AirportLocation& b) {
+        auto radians = [](double degrees) { return degrees * PI / 180.0; };
+        double dLat = radians(b.latitude - a.latitude);
+        double dLon = radians(b.longitude - a.longitude);
+        double h = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                   std::cos(radians(a.latitude)) * std::cos(radians(b.latitude)) * std::sin(dLon / 2) * std::sin(dLon / 2);
+        return 2 * EARTH_RADIUS_KM * std::asin(std::sqrt(h));
+    }
+
+    std::string formatDateTime(int64_t day, int64_t minuteOfDay) {
+        day += minuteOfDay / 1440;
+        minuteOfDay %= 1440;
+        std::chrono::year_month_day date{std::chrono::sys_days{std::chrono::days{day}}};
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02lld:%02lld:00",
+                      static_cast<int>(date.year()), static_cast<unsigned>(date.month()),
+                      static_cast<unsigned>(date.day()),
+                      static_cast<long long>(minuteOfDay / 60), static_cast<long long>(minuteOfDay % 60));
+        return buffer;
+    }
+
+    // Seed riêng cho từng chuyến bay, để seatOrder() không phụ thuộc thứ tự gọi
+    uint64_t mixSeed(uint64_t seed, uint64_t value) {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (value + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
+std::string sqlQuote(const std::string& value) {
+    std::string out;
+    out.reserve(value.size() + 2);
+    out += '\'';
+    for (char c : value) {
+        if (c == '\'' || c == '\\') out += c;
+        out += c;
+    }
+    out += '\'';
+    return out;
+}
+
+// === Danh mục cố định ===
+
+const std::vector<Airport>& SyntheticDataset::airports() {
+    static const std::vector<Airport> airports = {
+        {"SGN", "Tan Son Nhat"}, {"HAN", "Noi Bai"}, {"DAD", "Da Nang"}, {"CXR", "Cam Ranh"},
+        {"PQC", "Phu Quoc"}, {"ICN", "Incheon"}, {"BKK", "Suvarnabhumi"}, {"SIN", "Changi"},
+        {"HPH", "Cat Bi"}, {"NRT", "Narita"}, {"HKG", "Hong Kong"}, {"TPE", "Taoyuan"},
+        {"HUI", "Phu Bai"}, {"VII", "Vinh"}, {"KUL", "Kuala Lumpur"}, {"PVG", "Pudong"},
+        {"VCA", "Can Tho"}, {"DLI", "Lien Khuong"}, {"KIX", "Kansai"}, {"MNL", "Ninoy Aquino"},
+        {"CGK", "Soekarno Hatta"}, {"PNH", "Phnom Penh"}, {"UIH", "Phu Cat"}, {"BMV", "Buon Ma Thuot"},
+        {"SYD", "Sydney"}, {"CDG", "Charles de Gaulle"}, {"FRA", "Frankfurt"}, {"LHR", "Heathrow"},
+        {"SFO", "San Francisco"}, {"VTE", "Wattay"}
+    };
+    return airports;
+}
+
+const std::vector<AircraftModel>& SyntheticDataset::aircraftModels() {
+    static const std::vector<AircraftModel> models = {
+        {"Airbus A321neo", 170, 16, 4},
+        {"Airbus A320neo", 162, 12, 4},
+        {"Boeing 787-9", 247, 28, 8},
+        {"Boeing 787-10", 283, 24, 8},
+        {"Airbus A350-900", 265, 29, 12},
+        {"Boeing 777-300ER", 296, 42, 8},
+        {"Airbus A330-300", 250, 36, 6},
+        {"ATR 72-600", 64, 4, 2}
+    };
+    return models;
+}
+
+const std::array<const char*, 3>& SyntheticDataset::flightStatusNames() {
+    static const std::array<const char*, 3> names = {"SCHEDULED", "DELAYED", "CANCELLED"};
+    return names;
+}
+
+// === Lập kế hoạch ===
+
+Result<SyntheticDataset> SyntheticDataset::create(GeneratorConfig config) {
+    int year = 0;
+    unsigned month = 0, day = 0;
+    if (std::sscanf(config.startDate.c_str(), "%4d-%2u-%2u", &year, &month, &day) != 3) {
+        return Failure<SyntheticDataset>(CoreError("Invalid start date: " + config.startDate, "INVALID_GENERATOR_CONFIG"));
+    }
+    std::chrono::year_month_day start{std::chrono::year{year}, std::chrono::month{month}, std::chrono::day{day}};
+    if (!start.ok()) {
+        return Failure<SyntheticDataset>(CoreError("Invalid start date: " + config.startDate, "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.days < 1) {
+        return Failure<SyntheticDataset>(CoreError("Number of days must be positive", "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.flightCount > 0 && config.aircraftCount == 0) {
+        return Failure<SyntheticDataset>(CoreError("Flights require at least one aircraft", "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.ticketCount > 0 && (config.passengerCount == 0 || config.flightCount == 0)) {
+        return Failure<SyntheticDataset>(CoreError("Tickets require passengers and flights", "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.flightCount > 26 * 26 * FLIGHT_NUMBERS_PER_PREFIX) {
+        return Failure<SyntheticDataset>(CoreError("Too many flights for unique flight numbers", "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.aircraftCount > 9990000 || config.passengerCount > 900000000) {
+        return Failure<SyntheticDataset>(CoreError("Too many aircraft or passengers for unique keys", "INVALID_GENERATOR_CONFIG"));
+    }
+    if (config.routeSkew < 0) {
+        return Failure<SyntheticDataset>(CoreError("Route skew must not be negative", "INVALID_GENERATOR_CONFIG"));
+    }
+
+    SyntheticDataset dataset(std::move(config));
+    dataset._startDay = std::chrono::sys_days{start}.time_since_epoch().count();
+
+    std::mt19937_64 rng(dataset._config.seed);
+    dataset.planRoutes(rng);
+    dataset.planFlights(rng);
+    dataset.planTickets();
+    return Success(std::move(dataset));
+}
+
+void SyntheticDataset::planRoutes(std::mt19937_64& rng) {
+    const auto& airportList = airports();
+    struct Candidate {
+        RoutePlan route;
+        double gravity;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(airportList.size() * (airportList.size() - 1));
+
+    for (uint16_t origin = 0; origin < airportList.size(); ++origin) {
+        for (uint16_t destination = 0; destination < airportList.size(); ++destination) {
+            if (origin == destination) continue;
+            double distance = distanceKm(AIRPORT_LOCATIONS[origin], AIRPORT_LOCATIONS[destination]);
+            RoutePlan route{};
+            route.origin = origin;
+            route.destination = destination;
+            // Thêm 30 phút lăn bánh, làm tròn 5 phút
+            route.durationMinutes = static_cast<int>(std::lround((30 + distance / CRUISE_SPEED_KMH * 60) / 5) * 5);
+            route.basePrice = std::lround((500000 + distance * 1500) / 1000) * 1000;
+            // Mô hình trọng lực: tuyến giữa hai sân bay lớn phổ biến hơn, có nhiễu để thứ hạng không quá đều
+            double noise = std::uniform_real_distribution<double>(0.5, 1.5)(rng);
+            candidates.push_back({route, noise / ((origin + 1.0) * (destination + 1.0))});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.gravity > b.gravity; });
+
+    double total = 0;
+    _routes.reserve(candidates.size());
+    _routeCumulative.reserve(candidates.size());
+    for (size_t rank = 0; rank < candidates.size(); ++rank) {
+        RoutePlan route = candidates[rank].route;
+        route.weight = 1.0 / std::pow(rank + 1.0, _config.routeSkew);
+        total += route.weight;
+        _routes.push_back(route);
+        _routeCumulative.push_back(total);
+    }
+}
+
+void SyntheticDataset::planFlights(std::mt19937_64& rng) {
+    const auto modelCount = static_cast<uint32_t>(aircraftModels().size());
+    _aircraftModel.resize(_config.aircraftCount);
+    for (auto& model : _aircraftModel) {
+        model = static_cast<uint32_t>(rng() % modelCount);
+    }
+
+    _flightsByRoute.assign(_routes.size(), {});
+    _flights.resize(_config.flightCount);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t i = 0; i < _flights.size(); ++i) {
+        auto& flight = _flights[i];
+        flight.route = static_cast<uint32_t>(sampleRoute(rng));
+        flight.aircraft = static_cast<uint32_t>(rng() % _config.aircraftCount);
+        // Khởi hành từ 05:00 đến 22:55, theo bước 5 phút
+        uint64_t day = rng() % static_cast<uint64_t>(_config.days);
+        uint64_t minuteOfDay = 300 + (rng() % 216) * 5;
+        flight.departureMinute = static_cast<uint32_t>(day * 1440 + minuteOfDay);
+        double statusDraw = unit(rng);
+        flight.status = statusDraw < 0.01 ? 2 : (statusDraw < 0.05 ? 1 : 0);
+        _flightsByRoute[flight.route].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+void SyntheticDataset::planTickets() {
+    if (_flights.empty()) return;
+
+    // Nhu cầu của chuyến bay = trọng số tuyến nhân nhiễu; tìm hệ số k sao cho
+    // tổng min(sức chứa, k * nhu cầu) gần với số vé mục tiêu nhất
+    std::mt19937_64 rng(mixSeed(_config.seed, 0x7469636b657473ULL));
+    std::uniform_real_distribution<double> noise(0.7, 1.3);
+    std::vector<double> demand(_flights.size());
+    std::vector<int> capacity(_flights.size());
+    size_t totalCapacity = 0;
+    for (size_t i = 0; i < _flights.size(); ++i) {
+        demand[i] = _routes[_flights[i].route].weight * noise(rng);
+        const auto& model = aircraftModelOf(_flights[i].aircraft);
+        capacity[i] = model.economySeats + model.businessSeats + model.firstSeats;
+        totalCapacity += capacity[i];
+    }
+
+    auto ticketsAt = [&](double k) {
+        size_t total = 0;
+        for (size_t i = 0; i < _flights.size(); ++i) {
+            total += static_cast<size_t>(std::min<double>(capacity[i], std::floor(k * demand[i])));
+        }
+        return total;
+    };
+
+    double k = 0;
+    size_t target = std::min(_config.ticketCount, totalCapacity);
+    if (target > 0) {
+        double low = 0;
+        double high = 1;
+        while (ticketsAt(high) < target) high *= 2;
+        for (int iteration = 0; iteration < 64; ++iteration) {
+            double middle = (low + high) / 2;
+            (ticketsAt(middle) < target ? low : high) = middle;
+        }
+        k = high;
+    }
+
+    _plannedTickets = 0;
+    _flightCumulative.resize(_flights.size());
+    for (size_t i = 0; i < _flights.size(); ++i) {
+        auto count = static_cast<size_t>(std::min<double>(capacity[i], std::floor(k * demand[i])));
+        // Phần vượt mục tiêu do làm tròn được cắt ở các chuyến bay cuối
+        count = std::min(count, target - _plannedTickets);
+        _flights[i].ticketCount = static_cast<uint16_t>(count);
+        _plannedTickets += count;
+        _flightCumulative[i] = static_cast<double>(_plannedTickets);
+    }
+}
+
+// === Khóa nghiệp vụ ===
+
+std::string SyntheticDataset::aircraftSerial(size_t index) const {
+    return "VN" + std::to_string(10000 + index);
+}
+
+const AircraftModel& SyntheticDataset::aircraftModelOf(size_t aircraftIndex) const {
+    return aircraftModels()[_aircraftModel[aircraftIndex]];
+}
+
+std::string SyntheticDataset::flightNumber(size_t index) const {
+    size_t prefix = index / FLIGHT_NUMBERS_PER_PREFIX;
+    std::string number;
+    number += static_cast<char>('A' + prefix / 26);
+    number += static_cast<char>('A' + prefix % 26);
+    number += std::to_string(index % FLIGHT_NUMBERS_PER_PREFIX + 1);
+    return number;
+}
+
+std::string SyntheticDataset::passportNumber(size_t index) const {
+    // Khoảng 70% hộ chiếu Việt Nam; số 9 chữ số duy nhất theo chỉ số
+    static const char* const countries[] = {"VN", "VN", "VN", "VN", "VN", "VN", "VN", "US", "KR", "JP"};
+    return std::string(countries[index % 10]) + ":" + std::to_string(100000000 + index);
+}
+
+std::string SyntheticDataset::ticketNumber(size_t flightIndex, size_t sequence) const {
+    std::string departure = departureTime(flightIndex);
+    char suffix[8];
+    std::snprintf(suffix, sizeof(suffix), "%04zu", sequence);
+    return flightNumber(flightIndex) + "-" + departure.substr(0, 4) + departure.substr(5, 2) +
+           departure.substr(8, 2) + "-" + suffix;
+}
+
+std::string SyntheticDataset::departureTime(size_t flightIndex) const {
+    return formatDateTime(_startDay, _flights[flightIndex].departureMinute);
+}
+
+std::string SyntheticDataset::arrivalTime(size_t flightIndex) const {
+    const auto& flight = _flights[flightIndex];
+    return formatDateTime(_startDay, flight.departureMinute + _routes[flight.route].durationMinutes);
+}
+
+std::string SyntheticDataset::seatNumber(char classCode, int sequence, int classSeats) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), classSeats >= 100 ? "%c%03d" : "%c%02d", classCode, sequence);
+    return buffer;
+}
+
+std::vector<std::string> SyntheticDataset::seatOrder(size_t flightIndex) const {
+    const auto& model = aircraftModelOf(_flights[flightIndex].aircraft);
+    std::vector<std::string> seats;
+    seats.reserve(model.economySeats + model.businessSeats + model.firstSeats);
+    for (int i = 1; i <= model.firstSeats; ++i) seats.push_back(seatNumber('F', i, model.firstSeats));
+    for (int i = 1; i <= model.businessSeats; ++i) seats.push_back(seatNumber('B', i, model.businessSeats));
+    for (int i = 1; i <= model.economySeats; ++i) seats.push_back(seatNumber('E', i, model.economySeats));
+
+    std::mt19937_64 rng(mixSeed(_config.seed, flightIndex));
+    std::shuffle(seats.begin(), seats.end(), rng);
+    return seats;
+}
+
+// === Lấy mẫu ===
+
+size_t SyntheticDataset::sampleRoute(std::mt19937_64& rng) const {
+    double draw = std::uniform_real_distribution<double>(0.0, _routeCumulative.back())(rng);
+    auto it = std::upper_bound(_routeCumulative.begin(), _routeCumulative.end(), draw);
+    return std::min<size_t>(it - _routeCumulative.begin(), _routes.size() - 1);
+}
+
+size_t SyntheticDataset::sampleFlight(std::mt19937_64& rng) const {
+    // Tuyến ít phổ biến có thể không có chuyến nào khi số chuyến bay nhỏ
+    for (;;) {
+        const auto& candidates = _flightsByRoute[sampleRoute(rng)];
+        if (!candidates.empty()) {
+            return candidates[rng() % candidates.size()];
+        }
+    }
+}
+
+std::pair<size_t, size_t> SyntheticDataset::sampleTicket(std::mt19937_64& rng) const {
+    double draw = std::uniform_real_distribution<double>(0.0, static_cast<double>(_plannedTickets))(rng);
+    auto it = std::upper_bound(_flightCumulative.begin(), _flightCumulative.end(), draw);
+    size_t flight = std::min<size_t>(it - _flightCumulative.begin(), _flights.size() - 1);
+    while (_flights[flight].ticketCount == 0) --flight;
+    return {flight, 1 + rng() % _flights[flight].ticketCount};
+}
+
+size_t SyntheticDataset::samplePassenger(std::mt19937_64& rng) const {
+    return rng() % _config.passengerCount;
+}
+
+} // namespace LoadGen
@@ -0,0 +1,164 @@
+/**
+ * @file SyntheticDataset.h
+ * @brief Mô hình dữ liệu tổng hợp quy mô lớn: sân bay, tuyến bay phân bố lệch, máy bay, chuyến bay, hành khách, vé
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Toàn bộ dữ liệu được suy ra một cách tất định từ GeneratorConfig (kể cả seed), nên
+ * DataGenerator và LoadDriver dựng cùng một SyntheticDataset là biết chính xác số hiệu chuyến
+ * bay, số hộ chiếu và số vé đã nạp mà không cần đọc lại cơ sở dữ liệu.
+ *
+ * Độ phổ biến của tuyến bay theo luật Zipf: tuyến hạng r có trọng số 1 / r^routeSkew. Mỗi chuyến
+ * bay chọn tuyến theo trọng số này, và số vé của chuyến bay cũng tỷ lệ với trọng số tuyến (bị chặn
+ * bởi sức chứa máy bay), nên các tuyến đầu vừa có nhiều chuyến vừa kín chỗ hơn.
+ *
+ * Chỉ các chuyến bay (vài byte mỗi chuyến) được giữ trong bộ nhớ; hành khách và vé được sinh
+ * theo chỉ số khi cần.
+ */
+
+#ifndef SYNTHETIC_DATASET_H
+#define SYNTHETIC_DATASET_H
+
+#include "../core/exceptions/Result.h"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace LoadGen {
+
+/**
+ * @brief Quy mô và tham số sinh dữ liệu
+ */
+struct GeneratorConfig {
+    size_t aircraftCount = 500;
+    size_t flightCount = 200000;
+    size_t passengerCount = 5000000;
+    size_t ticketCount = 50000000;     ///< Mục tiêu; thực tế có thể ít hơn nếu vượt tổng sức chứa
+    double routeSkew = 1.1;            ///< Số mũ Zipf của độ phổ biến tuyến bay
+    uint64_t seed = 42;
+    /**
+     * @brief Ngày bay đầu tiên (YYYY-MM-DD)
+     *
+     * Mặc định nằm trong quá khứ vì TicketService::canBookFlight chỉ cho đặt vé chuyến bay đã
+     * qua giờ khởi hành.
+     */
+    std::string startDate = "2024-01-01";
+    int days = 365;                    ///< Các chuyến bay trải đều trong số ngày này
+    /**
+     * @brief Cộng vào mọi khóa chính được sinh
+     *
+     * Dùng khi nạp chồng lên dữ liệu có sẵn (ví dụ dữ liệu mẫu của schema.sql) để id không trùng.
+     */
+    int64_t idOffset = 0;
+};
+
+struct Airport {
+    const char* code;
+    const char* name;
+};
+
+struct AircraftModel {
+    const char* name;
+    int economySeats;
+    int businessSeats;
+    int firstSeats;
+};
+
+struct RoutePlan {
+    uint16_t origin;              ///< Chỉ số trong airports()
+    uint16_t destination;
+    int durationMinutes;
+    int64_t basePrice;            ///< Giá hạng phổ thông (VND) trước dao động
+    double weight;                ///< Trọng số Zipf chưa chuẩn hóa
+};
+
+struct FlightPlan {
+    uint32_t route;
+    uint32_t aircraft;
+    uint32_t departureMinute;     ///< Số phút tính từ 00:00 của startDate
+    uint16_t ticketCount;         ///< Số vé đã bán, ghế 1..ticketCount theo thứ tự trong seatOrder()
+    uint8_t status;               ///< Chỉ số trong flightStatusNames()
+};
+
+class SyntheticDataset {
+private:
+    GeneratorConfig _config;
+    std::vector<RoutePlan> _routes;                 ///< Sắp giảm dần theo trọng số
+    std::vector<double> _routeCumulative;           ///< Tổng tích lũy trọng số để lấy mẫu
+    std::vector<uint32_t> _aircraftModel;           ///< Mẫu máy bay của từng chiếc
+    std::vector<FlightPlan> _flights;
+    std::vector<std::vector<uint32_t>> _flightsByRoute;
+    std::vector<double> _flightCumulative;          ///< Tổng tích lũy số vé, để lấy mẫu vé đã bán
+    size_t _plannedTickets = 0;
+    int64_t _startDay = 0;                          ///< startDate tính bằng ngày kể từ 1970-01-01
+
+    explicit SyntheticDataset(GeneratorConfig config) : _config(std::move(config)) {}
+
+    void planRoutes(std::mt19937_64& rng);
+    void planFlights(std::mt19937_64& rng);
+    void planTickets();
+
+public:
+    /**
+     * @brief Kiểm tra cấu hình và lập kế hoạch toàn bộ tập dữ liệu
+     * @return Lỗi INVALID_GENERATOR_CONFIG nếu ngày bắt đầu sai định dạng hoặc quy mô không hợp lệ
+     */
+    static Result<SyntheticDataset> create(GeneratorConfig config);
+
+    const GeneratorConfig& config() const { return _config; }
+
+    static const std::vector<Airport>& airports();
+    static const std::vector<AircraftModel>& aircraftModels();
+    /// "SCHEDULED", "DELAYED", "CANCELLED"
+    static const std::array<const char*, 3>& flightStatusNames();
+
+    const std::vector<RoutePlan>& routes() const { return _routes; }
+    const std::vector<FlightPlan>& flights() const { return _flights; }
+    size_t plannedTickets() const { return _plannedTickets; }
+
+    // === Khóa nghiệp vụ theo chỉ số (0-based) ===
+
+    int64_t aircraftId(size_t index) const { return _config.idOffset + static_cast<int64_t>(index) + 1; }
+    int64_t flightId(size_t index) const { return _config.idOffset + static_cast<int64_t>(index) + 1; }
+    int64_t passengerId(size_t index) const { return _config.idOffset + static_cast<int64_t>(index) + 1; }
+
+    std::string aircraftSerial(size_t index) const;
+    const AircraftModel& aircraftModelOf(size_t aircraftIndex) const;
+    /// Hai chữ cái (AA, AB, ...) và số 1..9999, đúng định dạng FlightNumber
+    std::string flightNumber(size_t index) const;
+    std::string passportNumber(size_t index) const;
+    /// <số hiệu chuyến bay>-<ngày khởi hành YYYYMMDD>-<thứ tự 4 chữ số>, thứ tự bắt đầu từ 1
+    std::string ticketNumber(size_t flightIndex, size_t sequence) const;
+    /// "YYYY-MM-DD HH:MM:SS"
+    std::string departureTime(size_t flightIndex) const;
+    std::string arrivalTime(size_t flightIndex) const;
+
+    /**
+     * @brief Danh sách ghế của chuyến bay theo thứ tự bán
+     *
+     * Mã ghế theo cùng quy ước với schema.sql và TicketService::bookTicket (E001 khi hạng có
+     * từ 100 ghế, E01 khi ít hơn). Thứ tự được xáo trộn tất định theo chỉ số chuyến bay.
+     */
+    std::vector<std::string> seatOrder(size_t flightIndex) const;
+    static std::string seatNumber(char classCode, int sequence, int classSeats);
+
+    // === Lấy mẫu có độ lệch như dữ liệu ===
+
+    size_t sampleRoute(std::mt19937_64& rng) const;
+    /// Chọn tuyến theo độ phổ biến rồi chọn đều một chuyến bay trên tuyến đó
+    size_t sampleFlight(std::mt19937_64& rng) const;
+    /// Chọn một vé đã sinh (cần plannedTickets() > 0), xác suất tỷ lệ với số vé của chuyến bay; trả {chuyến bay, thứ tự}
+    std::pair<size_t, size_t> sampleTicket(std::mt19937_64& rng) const;
+    size_t samplePassenger(std::mt19937_64& rng) const;
+};
+
+/// Hằng số SQL dạng '...' với ' và \ được thoát
+std::string sqlQuote(const std::string& value);
+
+} // namespace LoadGen
+
+#endif // SYNTHETIC_DATASET_H
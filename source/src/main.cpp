@@ -1,17 +1,45 @@
 #include <wx/wx.h>
 #include "ui/MainUI.h"
-#include "services/AircraftService.h"
-#include "services/FlightService.h"
-#include "services/PassengerService.h"
-#include "repositories/MySQLRepository/AircraftRepository.h"
-#include "repositories/MySQLRepository/FlightRepository.h"
-#include "repositories/MySQLRepository/PassengerRepository.h"
-#include "repositories/MySQLRepository/TicketRepository.h"
-#include "database/MySQLXConnection.h"
+#include "app/ApplicationContext.h"
+#include "app/DatabaseSettings.h"
+#include "reporting/ReferenceSnapshot.h"
 #include "utils/Logger.h"
+#include "utils/Tracing.h"
+#include <cstdlib>
 
 class AirlinesApp : public wxApp
 {
+private:
+    std::string _tracePath;
+    std::shared_ptr<ApplicationContext> _context;
+
+    static constexpr size_t ASYNC_SESSIONS = 2;
+    static constexpr const char *DEFAULT_SNAPSHOT_PATH = "airlines_reference.snapshot";
+
+    /// AIRLINES_SNAPSHOT=<file>: tệp ảnh chụp dữ liệu tham chiếu; đặt rỗng để tắt
+    void LoadReferenceSnapshot(const std::shared_ptr<Logger> &logger)
+    {
+        const char *configured = std::getenv("AIRLINES_SNAPSHOT");
+        std::string path = configured ? configured : DEFAULT_SNAPSHOT_PATH;
+        if (path.empty())
+            return;
+
+        Tracing::Span span("startup.referenceSnapshot", "ui");
+        Reporting::TopUpStats stats;
+        auto reference = Reporting::openReferenceData(path, *_context->aircraftRepository(), *_context->flightRepository(),
+                                                      *_context->ticketRepository(), &stats);
+        if (!reference)
+        {
+            logger->warning("Reference snapshot unavailable: " + reference.error().message);
+            return;
+        }
+        logger->info("Reference snapshot " + path + (stats.fullLoad ? " rebuilt" : " loaded") + ": " +
+                     std::to_string(reference.value().flights.size()) + " flights, " +
+                     std::to_string(stats.flightsLoaded) + " reloaded, " +
+                     std::to_string(stats.occupancyFlights) + " recounted");
+        MainWindow::setReferenceData(std::make_shared<const Reporting::ReferenceData>(std::move(reference.value())));
+    }
+
 public:
     virtual bool OnInit()
     {
@@ -19,44 +47,67 @@ public:
         auto logger = Logger::getInstance();
         logger->setMinLevel(LogLevel::DEBUG);
 
+        // AIRLINES_TRACE=<file>: ghi trace (Chrome trace-event JSON) của phiên làm việc khi thoát
+        if (const char *tracePath = std::getenv("AIRLINES_TRACE"))
+        {
+            _tracePath = tracePath;
+            Tracing::Tracer::getInstance()->enable();
+        }
+
         // Initialize Database Connection
-        auto connection = MySQLXConnection::getInstance();
-        if (!connection->connect("localhost", "cuong116", "1162005", "airlines_db", 33060))
+        auto settings = DatabaseSettings::fromEnvironment();
+        configureQueryStats(settings);
+        auto connection = connectDatabase(settings);
+        if (!connection)
         {
-            auto err = connection->getLastError();
-            if (err.has_value())
-            {
-                logger->error(std::string("Failed to connect to the database: ") + err.value());
-            }
-            else
-            {
-                logger->error("Failed to connect to the database: Unknown error");
-            }
+            logger->error(connection.error().message);
             std::cerr << "Server is not start !!!" << std::endl;
             return false;
         }
 
-        // Create repositories
-        auto aircraftRepo = std::make_shared<AircraftRepository>(connection, logger);
-        auto flightRepo = std::make_shared<FlightRepository>(connection, logger);
-        auto passengerRepo = std::make_shared<PassengerRepository>(connection, logger);
-        auto ticketRepo = std::make_shared<TicketRepository>(connection, passengerRepo, flightRepo, logger);
+        // Create repositories and services
+        _context = std::make_shared<ApplicationContext>(connection.value(), logger);
 
-        // Create services with their repositories
-        auto aircraftService = std::make_shared<AircraftService>(aircraftRepo, flightRepo, ticketRepo, logger);
-        auto flightService = std::make_shared<FlightService>(flightRepo, aircraftRepo, ticketRepo, logger);
-        auto passengerService = std::make_shared<PassengerService>(passengerRepo, ticketRepo, flightRepo, logger);
-        auto ticketService = std::make_shared<TicketService>(ticketRepo, passengerRepo, flightRepo, aircraftRepo, logger);
+        // Danh sách chuyến bay mở từ ảnh chụp cục bộ, cơ sở dữ liệu chỉ được hỏi phần đã đổi
+        LoadReferenceSnapshot(logger);
+
+        // Các session riêng cho facade bất đồng bộ để tải danh sách không chặn luồng giao diện;
+        // không mở được thì giao diện vẫn chạy đồng bộ trên kết nối chính
+        auto pool = connectDatabasePool(settings, ASYNC_SESSIONS);
+        if (pool)
+        {
+            MainWindow::setAsyncServices(std::make_shared<Async::AsyncServices>(pool.value(), logger, ASYNC_SESSIONS));
+        }
+        else
+        {
+            logger->warning("Async services disabled: " + pool.error().message);
+        }
 
         // Create and show main window
         MainWindow *mainWindow = new MainWindow("Quản lý hãng hàng không",
-                                                aircraftService,
-                                                flightService,
-                                                passengerService,
-                                                ticketService);
+                                                _context->aircraftService(),
+                                                _context->flightService(),
+                                                _context->passengerService(),
+                                                _context->ticketService());
         mainWindow->Show(true);
         return true;
     }
+
+    virtual int OnExit()
+    {
+        MainWindow::setAsyncServices(nullptr);
+        MainWindow::setReferenceData(nullptr);
+
+        if (!_tracePath.empty())
+        {
+            auto result = Tracing::Tracer::getInstance()->writeChromeTraceFile(_tracePath);
+            if (!result)
+            {
+                Logger::getInstance()->error(result.error().message);
+            }
+        }
+        return wxApp::OnExit();
+    }
 };
 
 wxIMPLEMENT_APP(AirlinesApp);
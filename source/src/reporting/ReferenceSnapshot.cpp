@@ -0,0 +1,696 @@
+#include "ReferenceSnapshot.h"
+#include "../utils/Logger.h"
+#include "../utils/MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Reporting {
+
+namespace {
+    constexpr char MAGIC[8] = {'A', 'I', 'R', 'L', 'R', 'E', 'F', '\0'};
+
+    /// Đầu tệp; phần dữ liệu theo sau gồm bản ghi máy bay, bản ghi chuyến bay, rồi vùng chuỗi
+    struct FileHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t headerSize;            ///< sizeof(FileHeader) của bên ghi, phát hiện bố cục khác
+        uint64_t payloadSize;
+        uint64_t checksum;              ///< payloadChecksum của phần dữ liệu
+        uint64_t aircraftChecksum;
+        HighWaterMark flights;
+        HighWaterMark tickets;
+        uint32_t aircraftCount;
+        uint32_t flightCount;
+        uint64_t stringBytes;
+    };
+
+    /// Chuỗi trong vùng chuỗi
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /// Các trường của std::tm như đã đọc từ cơ sở dữ liệu (đã chuẩn hóa), để giải mã lại y hệt
+    struct TimeRecord {
+        int32_t fields[9];
+    };
+
+    struct AircraftRecord {
+        int32_t id;
+        int32_t seats[3];
+        StringRef serial;
+        StringRef model;
+    };
+
+    struct FlightRecord {
+        int32_t id;
+        int32_t version;
+        TimeRecord departure;
+        TimeRecord arrival;
+        int32_t status;
+        int32_t seats[3];
+        int32_t booked[3];
+        StringRef flightNumber;
+        StringRef departureCode;
+        StringRef departureName;
+        StringRef arrivalCode;
+        StringRef arrivalName;
+        StringRef aircraftSerial;
+    };
+
+    // Bản ghi nằm liền sau đầu tệp trong vùng mmap (đầu trang) nên phải giữ căn lề tự nhiên
+    static_assert(sizeof(FileHeader) % alignof(uint64_t) == 0);
+    static_assert(sizeof(AircraftRecord) % alignof(FlightRecord) == 0);
+    // Byte đệm không xác định sẽ lọt vào tệp và tổng kiểm tra; các bản ghi phải không có byte đệm
+    static_assert(std::has_unique_object_representations_v<FileHeader>);
+    static_assert(std::has_unique_object_representations_v<AircraftRecord>);
+    static_assert(std::has_unique_object_representations_v<FlightRecord>);
+
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    /**
+     * @brief FNV-1a theo từ 8 byte, thêm bước trộn bit cao xuống bit thấp sau mỗi từ
+     *
+     * Nhanh gấp nhiều lần FNV-1a theo byte trên vài chục MB; chỉ dùng để phát hiện tệp hỏng.
+     */
+    uint64_t payloadChecksum(const unsigned char* data, size_t size) {
+        uint64_t hash = FNV_OFFSET;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash ^= word;
+            hash *= FNV_PRIME;
+            hash ^= hash >> 32;
+        }
+        for (; i < size; ++i) {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    /**
+     * @brief Tạo tệp tạm tên duy nhất cạnh path, ghi lần lượt các khối rồi đẩy xuống đĩa
+     *
+     * Tên duy nhất để hai tiến trình cùng ghi một ảnh chụp không ghi đè tệp tạm của nhau.
+     * @return Tên tệp tạm (đã đóng), hoặc lỗi SNAPSHOT_IO (tệp tạm đã bị xóa)
+     */
+    Result<std::string> writeTemporary(const std::string& path, std::initializer_list<std::string_view> blocks) {
+#if defined(_WIN32) || defined(_WIN64)
+        static std::atomic<unsigned> sequence{0};
+        std::string temporary;
+        int fd = -1;
+        for (int attempt = 0; attempt < 100 && fd < 0; ++attempt) {
+            temporary = path + ".tmp." + std::to_string(::_getpid()) + "." + std::to_string(sequence++);
+            fd = ::_open(temporary.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+            if (fd < 0 && errno != EEXIST) break;
+        }
+#else
+        std::string temporary = path + ".XXXXXX";
+        int fd = ::mkstemp(temporary.data());
+        // mkstemp tạo quyền 0600; ảnh chụp cần đọc được như tệp thường
+        if (fd >= 0) ::fchmod(fd, 0644);
+#endif
+        if (fd < 0) return Failure<std::string>(CoreError("Cannot create temporary file for " + path, "SNAPSHOT_IO"));
+
+        bool written = true;
+        for (std::string_view block : blocks) {
+            while (written && !block.empty()) {
+#if defined(_WIN32) || defined(_WIN64)
+                auto count = ::_write(fd, block.data(), static_cast<unsigned>(std::min<size_t>(block.size(), 1u << 30)));
+#else
+                auto count = ::write(fd, block.data(), block.size());
+#endif
+                if (count < 0 && errno == EINTR) continue;
+                if (count <= 0) written = false;
+                else block.remove_prefix(static_cast<size_t>(count));
+            }
+        }
+        // Dữ liệu phải nằm trên đĩa trước khi đổi tên, nếu không sự cố lúc đó để lại tệp rỗng dưới tên thật
+#if defined(_WIN32) || defined(_WIN64)
+        written = written && ::_commit(fd) == 0;
+        written = ::_close(fd) == 0 && written;
+        if (!written) ::_unlink(temporary.c_str());
+#else
+        written = written && ::fsync(fd) == 0;
+        written = ::close(fd) == 0 && written;
+        if (!written) ::unlink(temporary.c_str());
+#endif
+        if (!written) return Failure<std::string>(CoreError("Cannot write snapshot " + temporary, "SNAPSHOT_IO"));
+        return Success(temporary);
+    }
+
+    /// Đẩy mục thư mục (tên mới sau rename) xuống đĩa; Windows không hỗ trợ nên bỏ qua
+    void syncDirectory(const std::string& path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+        auto directory = std::filesystem::path(path).parent_path();
+        int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        ::fsync(fd);
+        ::close(fd);
+#else
+        (void)path;
+#endif
+    }
+
+    /// Băm nội dung bảng máy bay; bảng không có cột version nên so cả hàng
+    uint64_t aircraftChecksum(const std::vector<AircraftListRow>& rows) {
+        uint64_t hash = FNV_OFFSET;
+        for (const auto& row : rows) {
+            int32_t numbers[] = {row.id, row.economySeats, row.businessSeats, row.firstSeats};
+            hashBytes(hash, numbers, sizeof(numbers));
+            // Độ dài trước nội dung để ("AB", "C") khác ("A", "BC")
+            for (const std::string* text : {&row.serial, &row.model}) {
+                uint64_t length = text->size();
+                hashBytes(hash, &length, sizeof(length));
+                hashBytes(hash, text->data(), text->size());
+            }
+        }
+        return hash;
+    }
+
+    TimeRecord toRecord(const std::tm& time) {
+        return TimeRecord{{time.tm_sec, time.tm_min, time.tm_hour, time.tm_mday, time.tm_mon, time.tm_year,
+                           time.tm_wday, time.tm_yday, time.tm_isdst}};
+    }
+
+    std::tm fromRecord(const TimeRecord& record) {
+        std::tm time{};
+        time.tm_sec = record.fields[0];
+        time.tm_min = record.fields[1];
+        time.tm_hour = record.fields[2];
+        time.tm_mday = record.fields[3];
+        time.tm_mon = record.fields[4];
+        time.tm_year = record.fields[5];
+        time.tm_wday = record.fields[6];
+        time.tm_yday = record.fields[7];
+        time.tm_isdst = record.fields[8];
+        return time;
+    }
+
+    /// Vùng chuỗi khi ghi; chuỗi trùng nhau chỉ được lưu một lần
+    class StringArena {
+    private:
+        std::string _bytes;
+        std::unordered_map<std::string, StringRef> _refs;
+
+    public:
+        StringRef add(const std::string& value) {
+            auto [it, inserted] = _refs.try_emplace(value, StringRef{static_cast<uint32_t>(_bytes.size()),
+                                                                     static_cast<uint32_t>(value.size())});
+            if (inserted) _bytes += value;
+            return it->second;
+        }
+        const std::string& bytes() const { return _bytes; }
+    };
+
+    /// Đi qua (id, version) của cả bảng từ sau afterId, nối vào cuối rows
+    template <typename Repository>
+    Result<size_t> scanVersions(Repository& repository, int afterId, size_t batchSize, std::vector<RowVersion>& rows) {
+        std::vector<RowVersion> page;
+        do {
+            auto loaded = repository.findVersionsAfter(afterId, batchSize, page);
+            if (!loaded) return Failure<size_t>(loaded.error());
+            rows.insert(rows.end(), page.begin(), page.end());
+            if (!page.empty()) afterId = page.back().id;
+        } while (page.size() == batchSize);
+        return Success(rows.size());
+    }
+
+    /// Chỉ có hàng mới: các hàng id > maxId cũ giải thích đủ chênh lệch số hàng và tổng version
+    bool onlyAppended(const HighWaterMark& before, const HighWaterMark& now, const std::vector<RowVersion>& appended) {
+        int64_t versions = 0;
+        for (const auto& row : appended) versions += row.version;
+        return before.count + static_cast<int64_t>(appended.size()) == now.count &&
+               before.versionSum + versions == now.versionSum;
+    }
+
+    Result<size_t> loadAircraft(AircraftRepository& repository, size_t batchSize, std::vector<AircraftListRow>& rows) {
+        rows.clear();
+        std::vector<AircraftListRow> page;
+        do {
+            auto loaded = repository.findListRowsPage(rows.size(), batchSize, page);
+            if (!loaded) return Failure<size_t>(loaded.error());
+            std::move(page.begin(), page.end(), std::back_inserter(rows));
+        } while (page.size() == batchSize);
+        return Success(rows.size());
+    }
+
+    Result<size_t> loadSummariesAfter(FlightRepository& repository, int afterId, size_t batchSize,
+                                      std::vector<FlightSummaryRow>& rows) {
+        std::vector<FlightSummaryRow> page;
+        do {
+            auto loaded = repository.findSummariesAfter(afterId, batchSize, page);
+            if (!loaded) return Failure<size_t>(loaded.error());
+            std::move(page.begin(), page.end(), std::back_inserter(rows));
+            if (!rows.empty()) afterId = rows.back().id;
+        } while (page.size() == batchSize);
+        return Success(rows.size());
+    }
+
+    Result<size_t> loadSummariesByIds(FlightRepository& repository, const std::vector<int>& ids,
+                                      std::vector<FlightSummaryRow>& rows) {
+        std::vector<FlightSummaryRow> chunk;
+        for (size_t first = 0; first < ids.size(); first += ReferenceData::SYNC_CHUNK) {
+            std::vector<int> part(ids.begin() + first, ids.begin() + std::min(ids.size(), first + ReferenceData::SYNC_CHUNK));
+            auto loaded = repository.findSummariesByIds(part, chunk);
+            if (!loaded) return Failure<size_t>(loaded.error());
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(rows));
+        }
+        return Success(rows.size());
+    }
+
+    /// Version của id trong versions (theo thứ tự id); -1 nếu không có để lần sau chắc chắn nạp lại
+    int versionOf(const std::vector<RowVersion>& versions, int id) {
+        auto found = std::lower_bound(versions.begin(), versions.end(), id,
+                                      [](const RowVersion& row, int value) { return row.id < value; });
+        return found != versions.end() && found->id == id ? found->version : -1;
+    }
+
+    void clearBooked(FlightSummaryRow& row) {
+        row.bookedEconomy = 0;
+        row.bookedBusiness = 0;
+        row.bookedFirst = 0;
+    }
+
+    void applyOccupancy(ReferenceData& data, const std::vector<SeatOccupancyRow>& occupancy) {
+        for (const auto& group : occupancy) {
+            auto found = std::lower_bound(data.flights.begin(), data.flights.end(), group.flightId,
+                                          [](const FlightSummaryRow& row, int id) { return row.id < id; });
+            if (found == data.flights.end() || found->id != group.flightId) continue;
+            switch (group.seatClass) {
+                case 'E': found->bookedEconomy = group.booked; break;
+                case 'B': found->bookedBusiness = group.booked; break;
+                case 'F': found->bookedFirst = group.booked; break;
+            }
+        }
+    }
+
+    /// Đếm lại số ghế đã đặt cho toàn bộ chuyến bay
+    Result<size_t> recountOccupancy(ReferenceData& data, TicketRepository& repository) {
+        std::vector<SeatOccupancyRow> occupancy;
+        auto counted = repository.countSeatOccupancy(occupancy);
+        if (!counted) return Failure<size_t>(counted.error());
+        for (auto& row : data.flights) clearBooked(row);
+        applyOccupancy(data, occupancy);
+        return Success(data.flights.size());
+    }
+
+    /// Đếm lại số ghế đã đặt cho các chuyến bay có id trong flightIds (theo thứ tự, không trùng)
+    Result<size_t> recountOccupancy(ReferenceData& data, TicketRepository& repository, const std::vector<int>& flightIds) {
+        std::vector<SeatOccupancyRow> occupancy;
+        for (size_t first = 0; first < flightIds.size(); first += ReferenceData::SYNC_CHUNK) {
+            std::vector<int> part(flightIds.begin() + first,
+                                  flightIds.begin() + std::min(flightIds.size(), first + ReferenceData::SYNC_CHUNK));
+            auto counted = repository.countSeatOccupancy(part, occupancy);
+            if (!counted) return Failure<size_t>(counted.error());
+            for (int id : part) {
+                auto found = std::lower_bound(data.flights.begin(), data.flights.end(), id,
+                                              [](const FlightSummaryRow& row, int value) { return row.id < value; });
+                if (found != data.flights.end() && found->id == id) clearBooked(*found);
+            }
+            applyOccupancy(data, occupancy);
+        }
+        return Success(flightIds.size());
+    }
+
+    /**
+     * @brief Trộn các hàng vừa nạp (theo thứ tự id) vào ảnh chụp, bỏ các id trong removed
+     * @return Số hàng cũ bị bỏ
+     */
+    size_t mergeFlights(ReferenceData& data, std::vector<FlightSummaryRow>& loaded, const std::vector<RowVersion>& versions,
+                        const std::vector<int>& removed) {
+        std::vector<FlightSummaryRow> merged;
+        std::vector<int> mergedVersions;
+        merged.reserve(data.flights.size() + loaded.size());
+        mergedVersions.reserve(merged.capacity());
+        size_t dropped = 0;
+        size_t i = 0, j = 0;
+        while (i < data.flights.size() || j < loaded.size()) {
+            if (j == loaded.size() || (i < data.flights.size() && data.flights[i].id < loaded[j].id)) {
+                if (std::binary_search(removed.begin(), removed.end(), data.flights[i].id)) {
+                    ++dropped;
+                } else {
+                    merged.push_back(std::move(data.flights[i]));
+                    mergedVersions.push_back(data.flightVersions[i]);
+                }
+                ++i;
+                continue;
+            }
+            if (i < data.flights.size() && data.flights[i].id == loaded[j].id) ++i;
+            mergedVersions.push_back(versionOf(versions, loaded[j].id));
+            merged.push_back(std::move(loaded[j]));
+            ++j;
+        }
+        data.flights = std::move(merged);
+        data.flightVersions = std::move(mergedVersions);
+        return dropped;
+    }
+
+    /// Id trong changed không có hàng nào trong loaded: hàng đã bị xóa giữa hai truy vấn
+    std::vector<int> missingIds(const std::vector<int>& changed, const std::vector<FlightSummaryRow>& loaded) {
+        std::vector<int> missing;
+        size_t j = 0;
+        for (int id : changed) {
+            while (j < loaded.size() && loaded[j].id < id) ++j;
+            if (j == loaded.size() || loaded[j].id != id) missing.push_back(id);
+        }
+        return missing;
+    }
+}
+
+const FlightSummaryRow* ReferenceData::findFlight(int id) const {
+    auto found = std::lower_bound(flights.begin(), flights.end(), id,
+                                  [](const FlightSummaryRow& row, int value) { return row.id < value; });
+    return found != flights.end() && found->id == id ? &*found : nullptr;
+}
+
+Result<ReferenceData> ReferenceData::load(AircraftRepository& aircraftRepository, FlightRepository& flightRepository,
+                                          TicketRepository& ticketRepository, size_t batchSize) {
+    batchSize = std::max<size_t>(batchSize, 1);
+    ReferenceData data;
+
+    // Dấu trước dữ liệu: thay đổi trong lúc nạp làm lần kiểm tra sau thấy dấu khác
+    auto flightMark = flightRepository.readHighWaterMark();
+    if (!flightMark) return Failure<ReferenceData>(flightMark.error());
+    auto ticketMark = ticketRepository.readHighWaterMark();
+    if (!ticketMark) return Failure<ReferenceData>(ticketMark.error());
+    data.marks.flights = flightMark.value();
+    data.marks.tickets = ticketMark.value();
+
+    auto aircraft = loadAircraft(aircraftRepository, batchSize, data.aircraft);
+    if (!aircraft) return Failure<ReferenceData>(aircraft.error());
+    data.marks.aircraftChecksum = aircraftChecksum(data.aircraft);
+
+    // Version đọc trước hàng: hàng sửa giữa hai lượt có version cũ và sẽ được nạp lại lần sau
+    std::vector<RowVersion> versions;
+    auto scanned = scanVersions(flightRepository, 0, batchSize, versions);
+    if (!scanned) return Failure<ReferenceData>(scanned.error());
+    auto flights = loadSummariesAfter(flightRepository, 0, batchSize, data.flights);
+    if (!flights) return Failure<ReferenceData>(flights.error());
+    data.flightVersions.reserve(data.flights.size());
+    for (const auto& row : data.flights) data.flightVersions.push_back(versionOf(versions, row.id));
+
+    auto occupancy = recountOccupancy(data, ticketRepository);
+    if (!occupancy) return Failure<ReferenceData>(occupancy.error());
+    return Success(std::move(data));
+}
+
+Result<TopUpStats> ReferenceData::topUp(AircraftRepository& aircraftRepository, FlightRepository& flightRepository,
+                                        TicketRepository& ticketRepository, size_t batchSize) {
+    batchSize = std::max<size_t>(batchSize, 1);
+    TopUpStats stats;
+
+    ReferenceMarks now;
+    auto flightMark = flightRepository.readHighWaterMark();
+    if (!flightMark) return Failure<TopUpStats>(flightMark.error());
+    auto ticketMark = ticketRepository.readHighWaterMark();
+    if (!ticketMark) return Failure<TopUpStats>(ticketMark.error());
+    now.flights = flightMark.value();
+    now.tickets = ticketMark.value();
+
+    std::vector<AircraftListRow> currentAircraft;
+    auto aircraftLoaded = loadAircraft(aircraftRepository, batchSize, currentAircraft);
+    if (!aircraftLoaded) return Failure<TopUpStats>(aircraftLoaded.error());
+    now.aircraftChecksum = aircraftChecksum(currentAircraft);
+
+    bool recountAll = false;
+    std::vector<int> recountIds;
+
+    if (now.aircraftChecksum != marks.aircraftChecksum) {
+        // Số ghế và serial trong tóm tắt đến từ máy bay: nạp lại mọi chuyến bay
+        stats.aircraftChanged = true;
+        aircraft = std::move(currentAircraft);
+        std::vector<RowVersion> versions;
+        auto scanned = scanVersions(flightRepository, 0, batchSize, versions);
+        if (!scanned) return Failure<TopUpStats>(scanned.error());
+        std::vector<FlightSummaryRow> loaded;
+        auto reloaded = loadSummariesAfter(flightRepository, 0, batchSize, loaded);
+        if (!reloaded) return Failure<TopUpStats>(reloaded.error());
+        size_t before = flights.size();
+        flights = std::move(loaded);
+        flightVersions.clear();
+        for (const auto& row : flights) flightVersions.push_back(versionOf(versions, row.id));
+        stats.flightsLoaded = flights.size();
+        stats.flightsRemoved = before > flights.size() ? before - flights.size() : 0;
+        recountAll = true;
+    } else if (now.flights != marks.flights) {
+        std::vector<RowVersion> changed;
+        auto appended = scanVersions(flightRepository, static_cast<int>(marks.flights.maxId), batchSize, changed);
+        if (!appended) return Failure<TopUpStats>(appended.error());
+        std::vector<int> removed;
+
+        if (!onlyAppended(marks.flights, now.flights, changed)) {
+            // Có hàng bị sửa hoặc xóa: so (id, version) của cả bảng với bản đã lưu
+            std::vector<RowVersion> all;
+            auto scanned = scanVersions(flightRepository, 0, batchSize, all);
+            if (!scanned) return Failure<TopUpStats>(scanned.error());
+            changed.clear();
+            size_t i = 0;
+            for (const auto& row : all) {
+                while (i < flights.size() && flights[i].id < row.id) removed.push_back(flights[i++].id);
+                bool same = i < flights.size() && flights[i].id == row.id && flightVersions[i] == row.version;
+                if (i < flights.size() && flights[i].id == row.id) ++i;
+                if (!same) changed.push_back(row);
+            }
+            for (; i < flights.size(); ++i) removed.push_back(flights[i].id);
+        }
+
+        std::vector<int> ids;
+        ids.reserve(changed.size());
+        for (const auto& row : changed) ids.push_back(row.id);
+        std::vector<FlightSummaryRow> loaded;
+        auto reloaded = loadSummariesByIds(flightRepository, ids, loaded);
+        if (!reloaded) return Failure<TopUpStats>(reloaded.error());
+        auto missing = missingIds(ids, loaded);
+        removed.insert(removed.end(), missing.begin(), missing.end());
+        std::sort(removed.begin(), removed.end());
+
+        stats.flightsLoaded = loaded.size();
+        for (const auto& row : loaded) recountIds.push_back(row.id);
+        stats.flightsRemoved = mergeFlights(*this, loaded, changed, removed);
+    }
+
+    if (!recountAll && now.tickets != marks.tickets) {
+        std::vector<RowVersion> appended;
+        auto scanned = scanVersions(ticketRepository, static_cast<int>(marks.tickets.maxId), batchSize, appended);
+        if (!scanned) return Failure<TopUpStats>(scanned.error());
+        if (onlyAppended(marks.tickets, now.tickets, appended)) {
+            for (const auto& row : appended) recountIds.push_back(row.flightId);
+        } else {
+            // Vé bị sửa hoặc xóa không cho biết chuyến bay nào đổi: đếm lại cả bảng bằng một truy vấn gộp
+            recountAll = true;
+        }
+    }
+
+    if (recountAll) {
+        auto counted = recountOccupancy(*this, ticketRepository);
+        if (!counted) return Failure<TopUpStats>(counted.error());
+        stats.occupancyFlights = counted.value();
+    } else if (!recountIds.empty()) {
+        std::sort(recountIds.begin(), recountIds.end());
+        recountIds.erase(std::unique(recountIds.begin(), recountIds.end()), recountIds.end());
+        auto counted = recountOccupancy(*this, ticketRepository, recountIds);
+        if (!counted) return Failure<TopUpStats>(counted.error());
+        stats.occupancyFlights = counted.value();
+    }
+
+    stats.marksChanged = now != marks;
+    marks = now;
+    return Success(stats);
+}
+
+Result<size_t> ReferenceData::save(const std::string& path) const {
+    StringArena strings;
+    std::vector<AircraftRecord> aircraftRecords;
+    aircraftRecords.reserve(aircraft.size());
+    for (const auto& row : aircraft) {
+        aircraftRecords.push_back({row.id, {row.economySeats, row.businessSeats, row.firstSeats},
+                                   strings.add(row.serial), strings.add(row.model)});
+    }
+    std::vector<FlightRecord> flightRecords;
+    flightRecords.reserve(flights.size());
+    for (size_t i = 0; i < flights.size(); ++i) {
+        const auto& row = flights[i];
+        flightRecords.push_back({row.id, flightVersions[i], toRecord(row.departureTime), toRecord(row.arrivalTime),
+                                 static_cast<int32_t>(row.status),
+                                 {row.economySeats, row.businessSeats, row.firstSeats},
+                                 {row.bookedEconomy, row.bookedBusiness, row.bookedFirst},
+                                 strings.add(row.flightNumber), strings.add(row.departureCode), strings.add(row.departureName),
+                                 strings.add(row.arrivalCode), strings.add(row.arrivalName), strings.add(row.aircraftSerial)});
+    }
+
+    const size_t aircraftBytes = aircraftRecords.size() * sizeof(AircraftRecord);
+    const size_t flightBytes = flightRecords.size() * sizeof(FlightRecord);
+    std::string payload(aircraftBytes + flightBytes + strings.bytes().size(), '\0');
+    std::memcpy(payload.data(), aircraftRecords.data(), aircraftBytes);
+    std::memcpy(payload.data() + aircraftBytes, flightRecords.data(), flightBytes);
+    std::memcpy(payload.data() + aircraftBytes + flightBytes, strings.bytes().data(), strings.bytes().size());
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.payloadSize = payload.size();
+    header.checksum = payloadChecksum(reinterpret_cast<const unsigned char*>(payload.data()), payload.size());
+    header.aircraftChecksum = marks.aircraftChecksum;
+    header.flights = marks.flights;
+    header.tickets = marks.tickets;
+    header.aircraftCount = static_cast<uint32_t>(aircraftRecords.size());
+    header.flightCount = static_cast<uint32_t>(flightRecords.size());
+    header.stringBytes = strings.bytes().size();
+
+    // Ghi tệp tạm rồi đổi tên: tệp cũ luôn còn nguyên cho tới khi tệp mới đầy đủ
+    auto temporary = writeTemporary(path, {std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)), payload});
+    if (!temporary) return Failure<size_t>(temporary.error());
+    std::error_code error;
+    std::filesystem::rename(temporary.value(), path, error);
+    if (error) {
+        std::filesystem::remove(temporary.value(), error);
+        return Failure<size_t>(CoreError("Cannot replace snapshot " + path, "SNAPSHOT_IO"));
+    }
+    syncDirectory(path);
+    return Success(sizeof(header) + payload.size());
+}
+
+Result<ReferenceData> ReferenceData::read(const std::string& path) {
+    MappedFile file;
+    auto opened = file.open(path, "SNAPSHOT_IO");
+    if (!opened) return Failure<ReferenceData>(opened.error());
+    if (file.size() < sizeof(FileHeader)) {
+        return Failure<ReferenceData>(CoreError("Snapshot " + path + " is truncated", "SNAPSHOT_CORRUPT"));
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return Failure<ReferenceData>(CoreError("Not a reference snapshot: " + path, "SNAPSHOT_CORRUPT"));
+    }
+    if (header.formatVersion != FORMAT_VERSION || header.headerSize != sizeof(FileHeader)) {
+        return Failure<ReferenceData>(CoreError("Unsupported snapshot format in " + path, "SNAPSHOT_VERSION"));
+    }
+    const uint64_t aircraftBytes = uint64_t{header.aircraftCount} * sizeof(AircraftRecord);
+    const uint64_t flightBytes = uint64_t{header.flightCount} * sizeof(FlightRecord);
+    if (header.payloadSize != file.size() - sizeof(FileHeader) ||
+        aircraftBytes + flightBytes + header.stringBytes != header.payloadSize) {
+        return Failure<ReferenceData>(CoreError("Snapshot " + path + " has inconsistent sizes", "SNAPSHOT_CORRUPT"));
+    }
+    const unsigned char* payload = file.data() + sizeof(FileHeader);
+    if (payloadChecksum(payload, header.payloadSize) != header.checksum) {
+        return Failure<ReferenceData>(CoreError("Snapshot " + path + " failed its checksum", "SNAPSHOT_CORRUPT"));
+    }
+
+    // Bản ghi được đọc thẳng trên vùng mmap (đầu tệp và các bản ghi đều giữ căn lề tự nhiên)
+    const auto* aircraftRecords = reinterpret_cast<const AircraftRecord*>(payload);
+    const auto* flightRecords = reinterpret_cast<const FlightRecord*>(payload + aircraftBytes);
+    const char* arena = reinterpret_cast<const char*>(payload + aircraftBytes + flightBytes);
+    bool outOfRange = false;
+    auto text = [&](const StringRef& ref) {
+        if (uint64_t{ref.offset} + ref.length > header.stringBytes) {
+            outOfRange = true;
+            return std::string();
+        }
+        return std::string(arena + ref.offset, ref.length);
+    };
+
+    ReferenceData data;
+    data.marks.flights = header.flights;
+    data.marks.tickets = header.tickets;
+    data.marks.aircraftChecksum = header.aircraftChecksum;
+    data.aircraft.resize(header.aircraftCount);
+    for (size_t i = 0; i < header.aircraftCount; ++i) {
+        const AircraftRecord& record = aircraftRecords[i];
+        AircraftListRow& row = data.aircraft[i];
+        row.id = record.id;
+        row.economySeats = record.seats[0];
+        row.businessSeats = record.seats[1];
+        row.firstSeats = record.seats[2];
+        row.serial = text(record.serial);
+        row.model = text(record.model);
+    }
+    data.flights.resize(header.flightCount);
+    data.flightVersions.resize(header.flightCount);
+    for (size_t i = 0; i < header.flightCount; ++i) {
+        const FlightRecord& record = flightRecords[i];
+        FlightSummaryRow& row = data.flights[i];
+        row.id = record.id;
+        data.flightVersions[i] = record.version;
+        row.flightNumber = text(record.flightNumber);
+        row.departureCode = text(record.departureCode);
+        row.departureName = text(record.departureName);
+        row.arrivalCode = text(record.arrivalCode);
+        row.arrivalName = text(record.arrivalName);
+        row.departureTime = fromRecord(record.departure);
+        row.arrivalTime = fromRecord(record.arrival);
+        row.status = static_cast<FlightStatus>(record.status);
+        row.aircraftSerial = text(record.aircraftSerial);
+        row.economySeats = record.seats[0];
+        row.businessSeats = record.seats[1];
+        row.firstSeats = record.seats[2];
+        row.bookedEconomy = record.booked[0];
+        row.bookedBusiness = record.booked[1];
+        row.bookedFirst = record.booked[2];
+    }
+    if (outOfRange) {
+        return Failure<ReferenceData>(CoreError("Snapshot " + path + " has a string outside its arena", "SNAPSHOT_CORRUPT"));
+    }
+    return Success(std::move(data));
+}
+
+Result<ReferenceData> openReferenceData(const std::string& path, AircraftRepository& aircraftRepository,
+                                        FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                                        TopUpStats* stats, size_t batchSize) {
+    TopUpStats result;
+    auto data = ReferenceData::read(path);
+    if (data) {
+        auto topped = data.value().topUp(aircraftRepository, flightRepository, ticketRepository, batchSize);
+        if (!topped) return Failure<ReferenceData>(topped.error());
+        result = topped.value();
+    } else {
+        if (data.error().code != "SNAPSHOT_IO") {
+            Logger::getInstance()->warning("Reference snapshot discarded: " + data.error().message);
+        }
+        data = ReferenceData::load(aircraftRepository, flightRepository, ticketRepository, batchSize);
+        if (!data) return data;
+        result.fullLoad = true;
+    }
+
+    if (result.changed()) {
+        auto saved = data.value().save(path);
+        if (!saved) Logger::getInstance()->warning(saved.error().message);
+    }
+    if (stats) *stats = result;
+    return data;
+}
+
+} // namespace Reporting
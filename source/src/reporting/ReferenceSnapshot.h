@@ -0,0 +1,129 @@
+/**
+ * @file ReferenceSnapshot.h
+ * @brief Ảnh chụp nhị phân của dữ liệu tham chiếu (máy bay, chuyến bay, số ghế đã đặt) để khởi động nhanh
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi lần mở, giao diện nạp tóm tắt chuyến bay (join máy bay) và số ghế đã đặt (GROUP BY trên bảng
+ * vé) qua mạng; ở văn phòng xa, lượt nạp đó mất hàng chục giây. Dữ liệu này đổi chậm so với số lần
+ * mở ứng dụng, nên ReferenceData được ghi ra một tệp cục bộ và lần khởi động sau chỉ hỏi cơ sở dữ
+ * liệu phần đã đổi:
+ *
+ * 1. Tệp được mmap chỉ đọc và kiểm tra: mã nhận dạng, phiên bản định dạng, kích thước các phần,
+ *    tổng kiểm tra FNV-1a trên toàn bộ phần dữ liệu. Tệp không qua được thì bị bỏ và nạp lại toàn bộ.
+ * 2. Dấu mực nước cao (HighWaterMark: số hàng, id lớn nhất, tổng version) của bảng chuyến bay và
+ *    bảng vé được đọc bằng hai truy vấn gộp một hàng, bảng máy bay (nhỏ, không có cột version)
+ *    được đọc hết và so bằng băm nội dung.
+ * 3. Dấu không đổi thì không nạp gì thêm. Nếu chỉ có hàng mới (mọi hàng id > maxId cũ giải thích
+ *    đủ chênh lệch số hàng và tổng version) thì chỉ nạp các hàng đó; nếu không thì so (id, version)
+ *    của cả bảng chuyến bay với bản đã lưu (8 byte mỗi hàng) và chỉ nạp lại hàng mới hoặc đã sửa.
+ *    Số ghế đã đặt chỉ được đếm lại cho chuyến bay có vé mới; vé bị sửa hay xóa thì đếm lại cả bảng
+ *    bằng truy vấn gộp.
+ *
+ * Dấu được đọc trước dữ liệu, nên thay đổi xảy ra trong lúc nạp luôn làm lần kiểm tra sau thấy
+ * dấu khác: ảnh chụp có thể mới hơn dấu của nó nhưng không bao giờ cũ hơn mà không bị phát hiện.
+ *
+ * Tệp được ghi vào tệp tạm rồi đổi tên, nên tiến trình khác đang mmap tệp cũ không bị ảnh hưởng.
+ * Bản ghi có kích thước cố định, chuỗi nằm trong một vùng chung (chuỗi lặp lại như tên sân bay chỉ
+ * lưu một lần). Số nguyên theo thứ tự byte của máy ghi; tệp từ máy khác thứ tự byte không qua được
+ * kiểm tra phiên bản và bị nạp lại.
+ */
+
+#ifndef REPORTING_REFERENCE_SNAPSHOT_H
+#define REPORTING_REFERENCE_SNAPSHOT_H
+
+#include "../repositories/MySQLRepository/AircraftRepository.h"
+#include "../repositories/MySQLRepository/FlightRepository.h"
+#include "../repositories/MySQLRepository/TicketRepository.h"
+#include "../repositories/ReadModels.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Reporting {
+
+/**
+ * @brief Dấu của các bảng lúc ảnh chụp được nạp
+ */
+struct ReferenceMarks {
+    HighWaterMark flights;
+    HighWaterMark tickets;              ///< Số ghế đã đặt được đếm trên bảng vé
+    uint64_t aircraftChecksum = 0;      ///< Băm nội dung bảng máy bay
+
+    bool operator==(const ReferenceMarks&) const = default;
+};
+
+/**
+ * @brief Những gì một lần topUp đã nạp lại
+ */
+struct TopUpStats {
+    bool fullLoad = false;              ///< Không dùng được tệp (thiếu, hỏng, khác định dạng): đã nạp toàn bộ
+    bool aircraftChanged = false;       ///< Bảng máy bay đổi: đã nạp lại mọi chuyến bay
+    size_t flightsLoaded = 0;           ///< Chuyến bay mới hoặc đã sửa được nạp lại
+    size_t flightsRemoved = 0;          ///< Chuyến bay không còn trong bảng
+    size_t occupancyFlights = 0;        ///< Số chuyến bay được đếm lại số ghế đã đặt
+    bool marksChanged = false;          ///< Dấu khác dấu đã lưu: nên ghi lại tệp
+
+    bool changed() const { return fullLoad || marksChanged; }
+};
+
+/**
+ * @brief Máy bay và tóm tắt chuyến bay kèm số ghế đã đặt, theo thứ tự id
+ */
+struct ReferenceData {
+    static constexpr size_t DEFAULT_BATCH_SIZE = 5000;
+    /// Số id tối đa của một truy vấn IN khi nạp lại hàng đã đổi
+    static constexpr size_t SYNC_CHUNK = 500;
+    /// Phiên bản định dạng tệp; đổi bố cục bản ghi thì tăng số này
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    ReferenceMarks marks;
+    std::vector<AircraftListRow> aircraft;
+    std::vector<FlightSummaryRow> flights;      ///< Kèm bookedEconomy/Business/First
+    std::vector<int> flightVersions;            ///< flightVersions[i] là version của flights[i] khi nạp
+
+    /// Hàng của chuyến bay có id cho trước, hoặc nullptr
+    const FlightSummaryRow* findFlight(int id) const;
+
+    /**
+     * @brief Nạp toàn bộ từ cơ sở dữ liệu
+     * @param batchSize Số hàng mỗi truy vấn theo khóa
+     */
+    static Result<ReferenceData> load(AircraftRepository& aircraftRepository, FlightRepository& flightRepository,
+                                      TicketRepository& ticketRepository, size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    /**
+     * @brief Đưa ảnh chụp về trạng thái hiện tại của cơ sở dữ liệu, chỉ nạp phần đã đổi
+     * @return Những gì đã nạp lại, hoặc lỗi truy vấn (ảnh chụp có thể đã được áp dụng một phần)
+     */
+    Result<TopUpStats> topUp(AircraftRepository& aircraftRepository, FlightRepository& flightRepository,
+                             TicketRepository& ticketRepository, size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    /**
+     * @brief Ghi ảnh chụp ra tệp qua tệp tạm tên duy nhất, fsync rồi đổi tên
+     * @return Số byte đã ghi, hoặc lỗi SNAPSHOT_IO
+     */
+    Result<size_t> save(const std::string& path) const;
+
+    /**
+     * @brief Mmap chỉ đọc một tệp ảnh chụp, kiểm tra rồi giải mã
+     * @return Ảnh chụp, hoặc lỗi SNAPSHOT_IO (không mở được), SNAPSHOT_VERSION (định dạng khác),
+     *         SNAPSHOT_CORRUPT (kích thước hoặc tổng kiểm tra sai)
+     */
+    static Result<ReferenceData> read(const std::string& path);
+};
+
+/**
+ * @brief Đọc ảnh chụp từ tệp và bổ sung phần đã đổi; tệp không dùng được thì nạp toàn bộ.
+ *        Ghi lại tệp khi có thay đổi (lỗi ghi chỉ được ghi log)
+ * @param stats Nếu khác null, nhận những gì đã nạp lại
+ */
+Result<ReferenceData> openReferenceData(const std::string& path, AircraftRepository& aircraftRepository,
+                                        FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                                        TopUpStats* stats = nullptr,
+                                        size_t batchSize = ReferenceData::DEFAULT_BATCH_SIZE);
+
+} // namespace Reporting
+
+#endif // REPORTING_REFERENCE_SNAPSHOT_H
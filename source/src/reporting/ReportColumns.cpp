@@ -0,0 +1,403 @@
+#include "ReportColumns.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <format>
+
+namespace Reporting {
+
+namespace {
+    /// Mã 16 bit: tối đa 65536 giá trị khác nhau mỗi từ điển
+    constexpr size_t MAX_DICTIONARY_SIZE = 65536;
+
+    /// Dùng mảng trực tiếp khi id lớn nhất không quá số hàng nhân hệ số này (cộng phần dư)
+    constexpr size_t DENSE_INDEX_FACTOR = 4;
+    constexpr size_t DENSE_INDEX_SLACK = 1024;
+
+    Result<uint16_t> encodeSmall(Dictionary& dictionary, const std::string& value, const char* what) {
+        uint32_t code = dictionary.encode(value);
+        if (code >= MAX_DICTIONARY_SIZE) {
+            return Failure<uint16_t>(CoreError(std::string("Too many distinct ") + what + " for report columns",
+                                               "REPORT_DICTIONARY_FULL"));
+        }
+        return Success(static_cast<uint16_t>(code));
+    }
+
+    /// Hàng cho id: hàng đã có, hoặc hàng mới ở cuối (các cột được nối thêm bởi bên gọi)
+    uint32_t rowFor(RowIndex& rows, int id, size_t size, bool& appended) {
+        uint32_t row = rows.find(id);
+        appended = row == NO_ROW;
+        if (appended) {
+            row = static_cast<uint32_t>(size);
+            rows.set(id, row);
+        }
+        return row;
+    }
+
+    /// Đặt column[row], nối thêm khi row là hàng mới
+    template <typename Column, typename Value>
+    void put(Column& column, uint32_t row, bool appended, Value&& value) {
+        if (appended) column.push_back(std::forward<Value>(value));
+        else column[row] = std::forward<Value>(value);
+    }
+
+    /// Chép hàng cuối vào row rồi bỏ hàng cuối
+    template <typename Column>
+    void moveLastInto(Column& column, uint32_t row) {
+        if (row + 1 < column.size()) column[row] = std::move(column.back());
+        column.pop_back();
+    }
+
+    /// Đổi phần tử value của danh sách không thứ tự thành replacement, hoặc bỏ nó khi replacement là NO_ROW
+    void relink(std::vector<uint32_t>& rows, uint32_t value, uint32_t replacement) {
+        auto found = std::find(rows.begin(), rows.end(), value);
+        if (found == rows.end()) return;
+        if (replacement != NO_ROW) {
+            *found = replacement;
+            return;
+        }
+        *found = rows.back();
+        rows.pop_back();
+    }
+
+    /// Đổi hàng vé value trong danh sách chờ của flightId, bỏ danh sách khi nó rỗng
+    void relinkUnlinked(TicketColumns& tickets, int flightId, uint32_t value, uint32_t replacement) {
+        auto waiting = tickets.unlinked.find(flightId);
+        if (waiting == tickets.unlinked.end()) return;
+        relink(waiting->second, value, replacement);
+        if (waiting->second.empty()) tickets.unlinked.erase(waiting);
+    }
+
+    template <typename Column>
+    size_t bytesOf(const Column& column) {
+        return column.capacity() * sizeof(typename Column::value_type);
+    }
+}
+
+int64_t toScaledPrice(double amount) {
+    return std::llround(amount * PRICE_SCALE);
+}
+
+const char* seatClassName(size_t seatClass) {
+    static const char* names[] = {"ECONOMY", "BUSINESS", "FIRST", "UNKNOWN"};
+    return names[seatClass < SEAT_CLASS_COUNT ? seatClass : SEAT_CLASS_COUNT];
+}
+
+uint8_t seatClassIndex(char code) {
+    switch (code) {
+        case 'E': return 0;
+        case 'B': return 1;
+        case 'F': return 2;
+        default:  return UNKNOWN_SEAT_CLASS;
+    }
+}
+
+int32_t civilDay(int year, unsigned month, unsigned day) {
+    // Đếm ngày theo năm bắt đầu từ tháng 3 để ngày nhuận rơi vào cuối năm
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int32_t>(dayOfEra) - 719468;
+}
+
+int32_t civilDay(const std::tm& time) {
+    return civilDay(time.tm_year + 1900, static_cast<unsigned>(time.tm_mon + 1), static_cast<unsigned>(time.tm_mday));
+}
+
+int64_t civilSeconds(const std::tm& time) {
+    return static_cast<int64_t>(civilDay(time)) * 86400 + time.tm_hour * 3600 + time.tm_min * 60 + time.tm_sec;
+}
+
+std::string formatDay(int32_t day) {
+    // Phép ngược của civilDay
+    day += 719468;
+    const int era = (day >= 0 ? day : day - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(day - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    const unsigned dayOfMonth = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    const unsigned month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    const int year = static_cast<int>(yearOfEra) + era * 400 + (month <= 2);
+
+    // std::format không cắt cụt dù năm có nhiều chữ số hơn dự kiến
+    return std::format("{:04}-{:02}-{:02}", year, month, dayOfMonth);
+}
+
+Result<int32_t> parseDay(const std::string& text) {
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    char tail = 0;
+    if (text.size() != 10 || std::sscanf(text.c_str(), "%4d-%2u-%2u%c", &year, &month, &day, &tail) != 3 ||
+        month < 1 || month > 12 || day < 1 || day > 31) {
+        return Failure<int32_t>(CoreError("Invalid date (expected YYYY-MM-DD): " + text, "INVALID_DATE"));
+    }
+    int32_t result = civilDay(year, month, day);
+    // Ngày không tồn tại (30/02...) sẽ không định dạng lại được thành chính nó
+    if (formatDay(result) != text) {
+        return Failure<int32_t>(CoreError("Invalid date: " + text, "INVALID_DATE"));
+    }
+    return Success(result);
+}
+
+uint32_t Dictionary::encode(const std::string& value) {
+    auto [it, inserted] = _codes.try_emplace(value, static_cast<uint32_t>(_values.size()));
+    if (inserted) _values.push_back(value);
+    return it->second;
+}
+
+uint32_t Dictionary::find(const std::string& value) const {
+    auto found = _codes.find(value);
+    return found == _codes.end() ? NO_ROW : found->second;
+}
+
+void RowIndex::moveToSparse() {
+    _sparse.reserve(_size);
+    for (size_t id = 0; id < _dense.size(); ++id) {
+        if (_dense[id] != NO_ROW) _sparse.emplace(static_cast<int>(id), _dense[id]);
+    }
+    _dense.clear();
+    _dense.shrink_to_fit();
+    _isSparse = true;
+}
+
+uint32_t RowIndex::find(int id) const {
+    if (_isSparse) {
+        auto found = _sparse.find(id);
+        return found == _sparse.end() ? NO_ROW : found->second;
+    }
+    if (id < 0 || static_cast<size_t>(id) >= _dense.size()) return NO_ROW;
+    return _dense[static_cast<size_t>(id)];
+}
+
+void RowIndex::set(int id, uint32_t row) {
+    if (!_isSparse) {
+        size_t slot = static_cast<size_t>(id);
+        if (id >= 0 && slot >= _dense.size() && slot <= (_size + 1) * DENSE_INDEX_FACTOR + DENSE_INDEX_SLACK) {
+            _dense.resize(slot + 1, NO_ROW);
+        }
+        if (id >= 0 && slot < _dense.size()) {
+            if (_dense[slot] == NO_ROW) ++_size;
+            _dense[slot] = row;
+            return;
+        }
+        moveToSparse();
+    }
+    if (_sparse.insert_or_assign(id, row).second) ++_size;
+}
+
+void RowIndex::erase(int id) {
+    if (_isSparse) {
+        _size -= _sparse.erase(id);
+        return;
+    }
+    if (id < 0 || static_cast<size_t>(id) >= _dense.size() || _dense[static_cast<size_t>(id)] == NO_ROW) return;
+    _dense[static_cast<size_t>(id)] = NO_ROW;
+    --_size;
+}
+
+Result<bool> ReportColumns::upsertFlight(const FlightSummaryRow& row) {
+    auto departure = encodeSmall(flights.airports, row.departureCode, "airports");
+    auto arrival = encodeSmall(flights.airports, row.arrivalCode, "airports");
+    auto route = encodeSmall(flights.routes, row.departureCode + "-" + row.arrivalCode, "routes");
+    if (!departure || !arrival || !route) {
+        return Failure<bool>((!departure ? departure : !arrival ? arrival : route).error());
+    }
+
+    bool appended = false;
+    uint32_t at = rowFor(flights.rows, row.id, flights.size(), appended);
+    int64_t departureTime = civilSeconds(row.departureTime);
+    put(flights.id, at, appended, row.id);
+    put(flights.flightNumber, at, appended, row.flightNumber);
+    put(flights.departureAirport, at, appended, departure.value());
+    put(flights.arrivalAirport, at, appended, arrival.value());
+    put(flights.route, at, appended, route.value());
+    put(flights.departureTime, at, appended, departureTime);
+    put(flights.arrivalTime, at, appended, civilSeconds(row.arrivalTime));
+    put(flights.departureDay, at, appended, dayOfSeconds(departureTime));
+    put(flights.status, at, appended, static_cast<uint8_t>(row.status));
+    put(flights.seats[0], at, appended, row.economySeats);
+    put(flights.seats[1], at, appended, row.businessSeats);
+    put(flights.seats[2], at, appended, row.firstSeats);
+    if (appended) {
+        flights.ticketRows.emplace_back();
+        auto waiting = tickets.unlinked.find(row.id);
+        if (waiting != tickets.unlinked.end()) {
+            for (uint32_t ticket : waiting->second) tickets.flightRow[ticket] = at;
+            flights.ticketRows[at] = std::move(waiting->second);
+            tickets.unlinked.erase(waiting);
+        }
+    }
+    return Success(appended);
+}
+
+Result<bool> ReportColumns::upsertTicket(const TicketFactRow& row) {
+    auto currency = encodeSmall(tickets.currencies, row.currency, "currencies");
+    if (!currency) return Failure<bool>(currency.error());
+
+    bool appended = false;
+    uint32_t at = rowFor(tickets.rows, row.id, tickets.size(), appended);
+    put(tickets.id, at, appended, row.id);
+    put(tickets.passengerId, at, appended, row.passengerId);
+    uint32_t flightRow = flights.rowOf(row.flightId);
+    uint32_t previousFlightRow = appended ? NO_FLIGHT : tickets.flightRow[at];
+    if (flightRow != previousFlightRow) {
+        if (previousFlightRow != NO_FLIGHT) relink(flights.ticketRows[previousFlightRow], at, NO_ROW);
+        if (flightRow != NO_FLIGHT) flights.ticketRows[flightRow].push_back(at);
+    }
+    // Vé chưa có chuyến bay chờ theo id chuyến bay của nó
+    bool wasUnlinked = !appended && previousFlightRow == NO_FLIGHT;
+    if (wasUnlinked && (flightRow != NO_FLIGHT || tickets.flightId[at] != row.flightId)) {
+        relinkUnlinked(tickets, tickets.flightId[at], at, NO_ROW);
+        wasUnlinked = false;
+    }
+    if (flightRow == NO_FLIGHT && !wasUnlinked) tickets.unlinked[row.flightId].push_back(at);
+    put(tickets.flightId, at, appended, row.flightId);
+    put(tickets.flightRow, at, appended, flightRow);
+    put(tickets.seatClass, at, appended, seatClassIndex(row.seatClass));
+    put(tickets.status, at, appended, static_cast<uint8_t>(row.status));
+    put(tickets.currency, at, appended, currency.value());
+    put(tickets.price, at, appended, toScaledPrice(row.price));
+    return Success(appended);
+}
+
+void ReportColumns::upsertPassenger(const PassengerListRow& row) {
+    bool appended = false;
+    uint32_t at = rowFor(passengers.rows, row.id, passengers.size(), appended);
+    put(passengers.id, at, appended, row.id);
+    put(passengers.passport, at, appended, row.passportNumber);
+    put(passengers.name, at, appended, row.name);
+}
+
+bool ReportColumns::removeFlight(int flightId) {
+    uint32_t row = flights.rowOf(flightId);
+    if (row == NO_ROW) return false;
+    const uint32_t last = static_cast<uint32_t>(flights.size() - 1);
+
+    flights.rows.erase(flightId);
+    if (row != last) flights.rows.set(flights.id[last], row);
+    moveLastInto(flights.id, row);
+    moveLastInto(flights.flightNumber, row);
+    moveLastInto(flights.departureAirport, row);
+    moveLastInto(flights.arrivalAirport, row);
+    moveLastInto(flights.route, row);
+    moveLastInto(flights.departureTime, row);
+    moveLastInto(flights.arrivalTime, row);
+    moveLastInto(flights.departureDay, row);
+    moveLastInto(flights.status, row);
+    for (auto& seats : flights.seats) moveLastInto(seats, row);
+
+    // Chỉ vé của chuyến bay bị xóa và của chuyến bay cuối bảng phải sửa; vé của chuyến bay bị xóa
+    // chờ trong tickets.unlinked phòng khi id đó xuất hiện lại
+    for (uint32_t ticket : flights.ticketRows[row]) tickets.flightRow[ticket] = NO_FLIGHT;
+    if (!flights.ticketRows[row].empty()) {
+        auto& waiting = tickets.unlinked[flightId];
+        waiting.insert(waiting.end(), flights.ticketRows[row].begin(), flights.ticketRows[row].end());
+    }
+    if (row != last) {
+        for (uint32_t ticket : flights.ticketRows[last]) tickets.flightRow[ticket] = row;
+    }
+    moveLastInto(flights.ticketRows, row);
+    return true;
+}
+
+bool ReportColumns::removeTicket(int ticketId) {
+    uint32_t row = tickets.rowOf(ticketId);
+    if (row == NO_ROW) return false;
+    const uint32_t last = static_cast<uint32_t>(tickets.size() - 1);
+
+    tickets.rows.erase(ticketId);
+    if (row != last) tickets.rows.set(tickets.id[last], row);
+    if (tickets.flightRow[row] != NO_FLIGHT) relink(flights.ticketRows[tickets.flightRow[row]], row, NO_ROW);
+    else relinkUnlinked(tickets, tickets.flightId[row], row, NO_ROW);
+    if (row != last && tickets.flightRow[last] != NO_FLIGHT) {
+        relink(flights.ticketRows[tickets.flightRow[last]], last, row);
+    } else if (row != last) {
+        relinkUnlinked(tickets, tickets.flightId[last], last, row);
+    }
+    moveLastInto(tickets.id, row);
+    moveLastInto(tickets.passengerId, row);
+    moveLastInto(tickets.flightId, row);
+    moveLastInto(tickets.flightRow, row);
+    moveLastInto(tickets.seatClass, row);
+    moveLastInto(tickets.status, row);
+    moveLastInto(tickets.currency, row);
+    moveLastInto(tickets.price, row);
+    return true;
+}
+
+bool ReportColumns::removePassenger(int passengerId) {
+    uint32_t row = passengers.rowOf(passengerId);
+    if (row == NO_ROW) return false;
+    const uint32_t last = static_cast<uint32_t>(passengers.size() - 1);
+
+    passengers.rows.erase(passengerId);
+    if (row != last) passengers.rows.set(passengers.id[last], row);
+    moveLastInto(passengers.id, row);
+    moveLastInto(passengers.passport, row);
+    moveLastInto(passengers.name, row);
+    return true;
+}
+
+size_t ReportColumns::memoryBytes() const {
+    size_t bytes = bytesOf(flights.id) + bytesOf(flights.flightNumber) + bytesOf(flights.departureAirport) +
+                   bytesOf(flights.arrivalAirport) + bytesOf(flights.route) + bytesOf(flights.departureTime) +
+                   bytesOf(flights.arrivalTime) + bytesOf(flights.departureDay) + bytesOf(flights.status);
+    for (const auto& seats : flights.seats) bytes += bytesOf(seats);
+    bytes += bytesOf(flights.ticketRows);
+    for (const auto& ticketRows : flights.ticketRows) bytes += bytesOf(ticketRows);
+    bytes += bytesOf(tickets.id) + bytesOf(tickets.passengerId) + bytesOf(tickets.flightId) + bytesOf(tickets.flightRow) +
+             bytesOf(tickets.seatClass) + bytesOf(tickets.status) + bytesOf(tickets.currency) + bytesOf(tickets.price);
+    bytes += bytesOf(passengers.id) + bytesOf(passengers.passport) + bytesOf(passengers.name);
+    return bytes;
+}
+
+Result<ReportColumns> ReportColumns::load(FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                                          size_t batchSize) {
+    batchSize = std::max<size_t>(batchSize, 1);
+    ReportColumns columns;
+
+    std::vector<FlightSummaryRow> flightRows;
+    int afterId = 0;
+    do {
+        auto page = flightRepository.findSummariesAfter(afterId, batchSize, flightRows);
+        if (!page) return Failure<ReportColumns>(page.error());
+        for (const auto& row : flightRows) {
+            auto added = columns.upsertFlight(row);
+            if (!added) return Failure<ReportColumns>(added.error());
+        }
+        if (!flightRows.empty()) afterId = flightRows.back().id;
+    } while (flightRows.size() == batchSize);
+
+    std::vector<TicketFactRow> ticketRows;
+    afterId = 0;
+    do {
+        auto page = ticketRepository.findFactsAfter(afterId, batchSize, ticketRows);
+        if (!page) return Failure<ReportColumns>(page.error());
+        for (const auto& row : ticketRows) {
+            auto added = columns.upsertTicket(row);
+            if (!added) return Failure<ReportColumns>(added.error());
+        }
+        if (!ticketRows.empty()) afterId = ticketRows.back().id;
+    } while (ticketRows.size() == batchSize);
+
+    return Success(std::move(columns));
+}
+
+Result<size_t> ReportColumns::loadPassengers(PassengerRepository& passengerRepository, size_t batchSize) {
+    batchSize = std::max<size_t>(batchSize, 1);
+    std::vector<PassengerListRow> rows;
+    int afterId = 0;
+    do {
+        auto page = passengerRepository.findListRowsAfter(afterId, batchSize, rows);
+        if (!page) return Failure<size_t>(page.error());
+        for (const auto& row : rows) upsertPassenger(row);
+        if (!rows.empty()) afterId = rows.back().id;
+    } while (rows.size() == batchSize);
+    return Success(passengers.size());
+}
+
+} // namespace Reporting
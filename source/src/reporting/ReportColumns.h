@@ -0,0 +1,226 @@
+/**
+ * @file ReportColumns.h
+ * @brief Bảng vé, chuyến bay và hành khách dạng cột cho báo cáo và tìm kiếm trong bộ nhớ
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Báo cáo cuối tháng phải đi qua hàng chục triệu vé. Dựng entity hay read model đầy đủ cho từng
+ * vé vừa tốn bộ nhớ vừa làm vòng gộp nhảy khắp heap, nên ReportColumns giữ mỗi thuộc tính cần
+ * gộp trong một mảng liền nhau (struct-of-arrays): vé chỉ còn chỉ số hàng chuyến bay, hạng ghế,
+ * trạng thái, mã tiền tệ và giá. Chuỗi lặp lại (mã sân bay, tuyến, tiền tệ) được mã hóa thành số
+ * nhỏ qua Dictionary; thời gian là giây kể từ 1970-01-01 00:00 theo giờ lưu trong cơ sở dữ liệu
+ * (không đổi múi giờ); giá là số nguyên theo 1/100 đơn vị.
+ *
+ * Cột được nạp bằng các truy vấn theo khóa (id > ?) trên projection riêng của báo cáo, không join
+ * và không OFFSET, nên chi phí nạp tỷ lệ với số hàng. Sau khi nạp, từng hàng có thể được thêm,
+ * sửa hoặc xóa theo id (xem Snapshot); hàng bị xóa được thay bằng hàng cuối bảng, nên thứ tự hàng
+ * là thứ tự nạp, không phải thứ tự id.
+ */
+
+#ifndef REPORT_COLUMNS_H
+#define REPORT_COLUMNS_H
+
+#include "../repositories/MySQLRepository/FlightRepository.h"
+#include "../repositories/MySQLRepository/PassengerRepository.h"
+#include "../repositories/MySQLRepository/TicketRepository.h"
+#include "../repositories/ReadModels.h"
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Reporting {
+
+/// Hạng phổ thông, thương gia, hạng nhất theo thứ tự ký tự đầu E/B/F của số ghế
+constexpr size_t SEAT_CLASS_COUNT = 3;
+/// Hàng không thuộc hạng nào (số ghế không bắt đầu bằng E/B/F)
+constexpr uint8_t UNKNOWN_SEAT_CLASS = SEAT_CLASS_COUNT;
+/// Id không có hàng nào
+constexpr uint32_t NO_ROW = std::numeric_limits<uint32_t>::max();
+/// Vé có chuyến bay không còn trong bảng chuyến bay
+constexpr uint32_t NO_FLIGHT = NO_ROW;
+/// Giá được lưu bằng số nguyên theo 1/PRICE_SCALE đơn vị tiền tệ, để tổng cộng chính xác
+constexpr int64_t PRICE_SCALE = 100;
+
+/// Giá dạng số nguyên của một số tiền (làm tròn tới 1/PRICE_SCALE)
+int64_t toScaledPrice(double amount);
+/// Số tiền của giá dạng số nguyên
+inline double fromScaledPrice(int64_t scaled) { return static_cast<double>(scaled) / PRICE_SCALE; }
+
+/// Tên hạng ghế theo chỉ số
+const char* seatClassName(size_t seatClass);
+/// Chỉ số hạng ghế của ký tự đầu số ghế, hoặc UNKNOWN_SEAT_CLASS
+uint8_t seatClassIndex(char code);
+
+/// Số ngày từ 1970-01-01 tới ngày lịch cho trước (lịch Gregory, không múi giờ)
+int32_t civilDay(int year, unsigned month, unsigned day);
+/// Số ngày từ 1970-01-01 tới ngày lịch của tm (bỏ qua giờ)
+int32_t civilDay(const std::tm& time);
+/// Số giây từ 1970-01-01 00:00 tới thời điểm của tm, coi tm là giờ không múi giờ
+int64_t civilSeconds(const std::tm& time);
+/// Ngày chứa thời điểm civilSeconds
+inline int32_t dayOfSeconds(int64_t seconds) {
+    return static_cast<int32_t>((seconds >= 0 ? seconds : seconds - 86399) / 86400);
+}
+/// Định dạng số ngày thành "YYYY-MM-DD"
+std::string formatDay(int32_t day);
+/**
+ * @brief Đọc ngày "YYYY-MM-DD"
+ * @return Số ngày từ 1970-01-01, hoặc lỗi INVALID_DATE
+ */
+Result<int32_t> parseDay(const std::string& text);
+
+/**
+ * @brief Mã hóa chuỗi lặp lại thành mã nhỏ liên tiếp theo thứ tự xuất hiện
+ */
+class Dictionary {
+private:
+    std::vector<std::string> _values;
+    std::unordered_map<std::string, uint32_t> _codes;
+
+public:
+    /// Mã của giá trị, thêm mã mới nếu chưa có
+    uint32_t encode(const std::string& value);
+    /// Mã của giá trị đã có, hoặc NO_ROW
+    uint32_t find(const std::string& value) const;
+    const std::string& decode(uint32_t code) const { return _values[code]; }
+    size_t size() const { return _values.size(); }
+    const std::vector<std::string>& values() const { return _values; }
+};
+
+/**
+ * @brief Tra id -> hàng, cập nhật được từng id
+ *
+ * Id thường tăng dần và dày nên dùng mảng trực tiếp; khi id quá thưa so với số hàng (hoặc âm)
+ * thì chuyển hẳn sang bảng băm.
+ */
+class RowIndex {
+private:
+    std::vector<uint32_t> _dense;                   ///< _dense[id] là hàng của id, hoặc NO_ROW
+    std::unordered_map<int, uint32_t> _sparse;
+    bool _isSparse = false;
+    size_t _size = 0;
+
+    void moveToSparse();
+
+public:
+    /// Hàng của id, hoặc NO_ROW
+    uint32_t find(int id) const;
+    void set(int id, uint32_t row);
+    void erase(int id);
+    size_t size() const { return _size; }
+};
+
+/**
+ * @brief Cột của bảng chuyến bay
+ */
+struct FlightColumns {
+    std::vector<int> id;
+    std::vector<std::string> flightNumber;
+    std::vector<uint16_t> departureAirport;                     ///< Mã trong airports
+    std::vector<uint16_t> arrivalAirport;                       ///< Mã trong airports
+    std::vector<uint16_t> route;                                ///< Mã trong routes, "HAN-SGN"
+    std::vector<int64_t> departureTime;                         ///< civilSeconds
+    std::vector<int64_t> arrivalTime;                           ///< civilSeconds
+    std::vector<int32_t> departureDay;                          ///< Ngày khởi hành, số ngày từ 1970-01-01
+    std::vector<uint8_t> status;                                ///< FlightStatus
+    std::array<std::vector<int32_t>, SEAT_CLASS_COUNT> seats;   ///< Số ghế theo hạng
+    std::vector<std::vector<uint32_t>> ticketRows;              ///< Hàng vé trỏ tới chuyến bay, không theo thứ tự
+    Dictionary airports;
+    Dictionary routes;
+    RowIndex rows;
+
+    size_t size() const { return id.size(); }
+
+    /// Hàng của chuyến bay có id cho trước, hoặc NO_FLIGHT
+    uint32_t rowOf(int flightId) const { return rows.find(flightId); }
+};
+
+/**
+ * @brief Cột của bảng hành khách: chỉ các trường dùng để tìm và hiển thị kết quả
+ */
+struct PassengerColumns {
+    std::vector<int> id;
+    std::vector<std::string> passport;
+    std::vector<std::string> name;
+    RowIndex rows;
+
+    size_t size() const { return id.size(); }
+    uint32_t rowOf(int passengerId) const { return rows.find(passengerId); }
+};
+
+/**
+ * @brief Cột của bảng vé
+ */
+struct TicketColumns {
+    std::vector<int> id;
+    std::vector<int> passengerId;
+    std::vector<int> flightId;          ///< Id chuyến bay của vé, giữ cả khi flightRow là NO_FLIGHT
+    std::vector<uint32_t> flightRow;    ///< Hàng trong FlightColumns, hoặc NO_FLIGHT
+    std::vector<uint8_t> seatClass;     ///< Chỉ số hạng ghế, hoặc UNKNOWN_SEAT_CLASS
+    std::vector<uint8_t> status;        ///< TicketStatus
+    std::vector<uint16_t> currency;     ///< Mã trong currencies
+    std::vector<int64_t> price;         ///< Theo 1/PRICE_SCALE đơn vị tiền tệ
+    Dictionary currencies;
+    RowIndex rows;
+    /// Hàng vé NO_FLIGHT theo id chuyến bay của chúng; được gắn lại khi chuyến bay đó được thêm vào
+    std::unordered_map<int, std::vector<uint32_t>> unlinked;
+
+    size_t size() const { return price.size(); }
+    uint32_t rowOf(int ticketId) const { return rows.find(ticketId); }
+};
+
+/**
+ * @brief Các bảng cột dùng cho báo cáo và tìm kiếm
+ */
+struct ReportColumns {
+    /// Số hàng mỗi truy vấn khi nạp
+    static constexpr size_t DEFAULT_BATCH_SIZE = 50000;
+
+    FlightColumns flights;
+    TicketColumns tickets;
+    PassengerColumns passengers;        ///< Chỉ có khi đã gọi loadPassengers
+
+    /**
+     * @brief Nạp toàn bộ chuyến bay rồi toàn bộ vé theo từng lô
+     * @return Các cột đã nạp, hoặc lỗi truy vấn / REPORT_DICTIONARY_FULL nếu quá 65536 giá trị một từ điển
+     */
+    static Result<ReportColumns> load(FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                                      size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    /**
+     * @brief Nạp toàn bộ hành khách theo từng lô
+     * @return Số hành khách đã nạp, hoặc lỗi truy vấn
+     */
+    Result<size_t> loadPassengers(PassengerRepository& passengerRepository, size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    /**
+     * @brief Thêm chuyến bay mới hoặc ghi đè hàng của chuyến bay đã có
+     * @note Vé đang NO_FLIGHT với đúng id chuyến bay này (vé nạp trước chuyến bay của nó, hoặc
+     *       chuyến bay bị xóa rồi xuất hiện lại) được gắn vào hàng mới qua tickets.unlinked
+     */
+    Result<bool> upsertFlight(const FlightSummaryRow& row);
+    /// Thêm hoặc ghi đè vé; chuyến bay chưa có thì vé nhận NO_FLIGHT cho tới khi chuyến bay được thêm
+    Result<bool> upsertTicket(const TicketFactRow& row);
+    void upsertPassenger(const PassengerListRow& row);
+
+    /**
+     * @brief Xóa chuyến bay; vé còn trỏ tới nó nhận NO_FLIGHT
+     * @note Chuyến bay cuối bảng chuyển vào hàng bị xóa; chỉ vé của hai chuyến bay này được sửa,
+     *       nhờ flights.ticketRows, nên không phải quét cả cột flightRow
+     */
+    bool removeFlight(int flightId);
+    bool removeTicket(int ticketId);
+    bool removePassenger(int passengerId);
+
+    /// Số byte ước lượng của các cột (không tính chuỗi ngắn nằm trong đối tượng string)
+    size_t memoryBytes() const;
+};
+
+} // namespace Reporting
+
+#endif // REPORT_COLUMNS_H
@@ -0,0 +1,263 @@
+#include "SalesReport.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <thread>
+
+namespace Reporting {
+
+namespace {
+    /// Dưới ngưỡng này thêm luồng tốn hơn lợi
+    constexpr size_t MIN_TICKETS_PER_THREAD = 65536;
+    /// Số ô đếm vé bán theo hạng ghế mỗi chuyến: ba hạng và ô "không rõ"
+    constexpr size_t CLASS_SLOTS = SEAT_CLASS_COUNT + 1;
+
+    bool isActive(TicketStatus status) {
+        return status != TicketStatus::CANCELLED && status != TicketStatus::REFUNDED;
+    }
+
+    /**
+     * @brief Tổng riêng của một luồng, mảng dày theo ô chuyến bay
+     *
+     * Ô cuối (chỉ số bằng số chuyến bay) nhận vé ngoài kỳ hoặc không có chuyến bay và bị bỏ qua.
+     */
+    struct Partial {
+        std::vector<int64_t> revenue;       ///< [ô * số tiền tệ + tiền tệ]
+        std::vector<uint32_t> statuses;     ///< [ô * TICKET_STATUS_SLOTS + trạng thái]
+        std::vector<uint32_t> sold;         ///< [ô * CLASS_SLOTS + hạng ghế], vé chưa hủy/hoàn tiền
+
+        Partial(size_t slots, size_t currencies)
+            : revenue(slots * currencies, 0), statuses(slots * TICKET_STATUS_SLOTS, 0), sold(slots * CLASS_SLOTS, 0) {}
+    };
+
+    void aggregate(const TicketColumns& tickets, const std::vector<uint32_t>& slotOfRow,
+                   const std::array<uint32_t, TICKET_STATUS_SLOTS>& activeWeight,
+                   size_t begin, size_t end, Partial& partial) {
+        const uint32_t discard = static_cast<uint32_t>(slotOfRow.size() - 1);
+        const size_t currencies = tickets.currencies.size();
+        const uint32_t* flightRow = tickets.flightRow.data();
+        const uint8_t* seatClass = tickets.seatClass.data();
+        const uint8_t* status = tickets.status.data();
+        const uint16_t* currency = tickets.currency.data();
+        const int64_t* price = tickets.price.data();
+        int64_t* revenue = partial.revenue.data();
+        uint32_t* statuses = partial.statuses.data();
+        uint32_t* sold = partial.sold.data();
+
+        for (size_t i = begin; i < end; ++i) {
+            const size_t slot = slotOfRow[std::min(flightRow[i], discard)];
+            const uint32_t weight = activeWeight[status[i] & (TICKET_STATUS_SLOTS - 1)];
+            revenue[slot * currencies + currency[i]] += price[i] * weight;
+            statuses[slot * TICKET_STATUS_SLOTS + (status[i] & (TICKET_STATUS_SLOTS - 1))] += 1;
+            sold[slot * CLASS_SLOTS + std::min<size_t>(seatClass[i], SEAT_CLASS_COUNT)] += weight;
+        }
+    }
+
+    /// Cộng các tổng riêng vào tổng riêng đầu tiên, trên dải ô [begin, end)
+    void merge(std::vector<Partial>& partials, size_t currencies, size_t begin, size_t end) {
+        Partial& into = partials.front();
+        for (size_t p = 1; p < partials.size(); ++p) {
+            const Partial& from = partials[p];
+            for (size_t i = begin * currencies; i < end * currencies; ++i) into.revenue[i] += from.revenue[i];
+            for (size_t i = begin * TICKET_STATUS_SLOTS; i < end * TICKET_STATUS_SLOTS; ++i) into.statuses[i] += from.statuses[i];
+            for (size_t i = begin * CLASS_SLOTS; i < end * CLASS_SLOTS; ++i) into.sold[i] += from.sold[i];
+        }
+    }
+
+    /// Chạy work(index, begin, end) trên count phần việc chia đều cho tối đa threads luồng
+    template <typename Work>
+    void runPartitioned(size_t count, size_t items, Work work) {
+        if (count <= 1) {
+            work(0, 0, items);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (size_t t = 0; t < count; ++t) {
+            size_t begin = items * t / count;
+            size_t end = items * (t + 1) / count;
+            threads.emplace_back(work, t, begin, end);
+        }
+        for (auto& thread : threads) thread.join();
+    }
+
+    std::string formatAmount(int64_t scaled) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", fromScaledPrice(scaled));
+        return buffer;
+    }
+
+    std::string formatPercent(double ratio) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.1f%%", ratio * 100.0);
+        return buffer;
+    }
+}
+
+void RevenueLine::add(const RevenueLine& other) {
+    if (revenue.size() < other.revenue.size()) revenue.resize(other.revenue.size(), 0);
+    for (size_t i = 0; i < other.revenue.size(); ++i) revenue[i] += other.revenue[i];
+    ticketsSold += other.ticketsSold;
+    cancelled += other.cancelled;
+    refunded += other.refunded;
+    seats += other.seats;
+    bookedSeats += other.bookedSeats;
+}
+
+double SalesReport::revenueOf(const RevenueLine& line, const std::string& currency) const {
+    auto found = std::find(currencies.begin(), currencies.end(), currency);
+    size_t code = static_cast<size_t>(found - currencies.begin());
+    return code < line.revenue.size() ? fromScaledPrice(line.revenue[code]) : 0.0;
+}
+
+SalesReport buildSalesReport(const ReportColumns& columns, const ReportOptions& options) {
+    const FlightColumns& flights = columns.flights;
+    const TicketColumns& tickets = columns.tickets;
+    const size_t flightCount = flights.size();
+    const size_t currencies = tickets.currencies.size();
+    const size_t slots = flightCount + 1;
+
+    SalesReport report;
+    report.currencies = tickets.currencies.values();
+    report.total.key = "TOTAL";
+    report.total.revenue.assign(currencies, 0);
+
+    // Hàng chuyến bay -> ô gộp; chuyến ngoài kỳ và hàng NO_FLIGHT (bị kẹp về flightCount) vào ô bỏ đi
+    std::vector<uint32_t> slotOfRow(slots, static_cast<uint32_t>(flightCount));
+    for (size_t row = 0; row < flightCount; ++row) {
+        int32_t day = flights.departureDay[row];
+        if (day >= options.fromDay && day <= options.toDay) slotOfRow[row] = static_cast<uint32_t>(row);
+    }
+
+    std::array<uint32_t, TICKET_STATUS_SLOTS> activeWeight{};
+    for (size_t status = 0; status < TICKET_STATUS_SLOTS; ++status) {
+        activeWeight[status] = isActive(static_cast<TicketStatus>(status)) ? 1 : 0;
+    }
+
+    size_t threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min(threads, tickets.size() / MIN_TICKETS_PER_THREAD));
+
+    std::vector<Partial> partials;
+    partials.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) partials.emplace_back(slots, currencies);
+
+    runPartitioned(threads, tickets.size(), [&](size_t t, size_t begin, size_t end) {
+        aggregate(tickets, slotOfRow, activeWeight, begin, end, partials[t]);
+    });
+    runPartitioned(threads, flightCount, [&](size_t, size_t begin, size_t end) {
+        merge(partials, currencies, begin, end);
+    });
+    const Partial& sum = partials.front();
+
+    std::vector<RevenueLine> routes(flights.routes.size());
+    std::vector<bool> routeInPeriod(flights.routes.size(), false);
+    std::map<int32_t, RevenueLine> days;
+    bool anyFlight = false;
+
+    for (size_t row = 0; row < flightCount; ++row) {
+        if (slotOfRow[row] != row) continue;
+
+        RevenueLine line;
+        line.key = flights.flightNumber[row];
+        line.revenue.assign(sum.revenue.begin() + row * currencies, sum.revenue.begin() + (row + 1) * currencies);
+        const uint32_t* statuses = &sum.statuses[row * TICKET_STATUS_SLOTS];
+        for (size_t status = 0; status < TICKET_STATUS_SLOTS; ++status) {
+            report.ticketsByStatus[status] += statuses[status];
+            if (activeWeight[status]) line.ticketsSold += statuses[status];
+        }
+        line.cancelled = statuses[static_cast<size_t>(TicketStatus::CANCELLED)];
+        line.refunded = statuses[static_cast<size_t>(TicketStatus::REFUNDED)];
+
+        if (flights.status[row] != static_cast<uint8_t>(FlightStatus::CANCELLED)) {
+            line.bookedSeats = line.ticketsSold;
+            for (size_t seatClass = 0; seatClass < SEAT_CLASS_COUNT; ++seatClass) {
+                uint64_t seats = static_cast<uint64_t>(std::max(0, flights.seats[seatClass][row]));
+                line.seats += seats;
+                report.seatClasses[seatClass].seats += seats;
+                report.seatClasses[seatClass].bookedSeats += sum.sold[row * CLASS_SLOTS + seatClass];
+            }
+        }
+
+        const int32_t day = flights.departureDay[row];
+        report.fromDay = anyFlight ? std::min(report.fromDay, day) : day;
+        report.toDay = anyFlight ? std::max(report.toDay, day) : day;
+        anyFlight = true;
+
+        report.total.add(line);
+        routes[flights.route[row]].add(line);
+        routeInPeriod[flights.route[row]] = true;
+        days[day].add(line);
+        report.flights.push_back(std::move(line));
+    }
+
+    for (size_t code = 0; code < routes.size(); ++code) {
+        if (!routeInPeriod[code]) continue;
+        routes[code].key = flights.routes.decode(static_cast<uint32_t>(code));
+        report.routes.push_back(std::move(routes[code]));
+    }
+    std::sort(report.routes.begin(), report.routes.end(),
+              [](const RevenueLine& a, const RevenueLine& b) { return a.key < b.key; });
+
+    report.days.reserve(days.size());
+    for (auto& [day, line] : days) {
+        line.key = formatDay(day);
+        report.days.push_back(std::move(line));
+    }
+    return report;
+}
+
+void SalesReport::print(std::ostream& out, size_t flightLimit) const {
+    if (flights.empty()) {
+        out << "Sales report: no flights in period\n";
+        return;
+    }
+
+    auto revenueText = [this](const RevenueLine& line) {
+        std::string text;
+        for (size_t code = 0; code < currencies.size() && code < line.revenue.size(); ++code) {
+            if (line.revenue[code] == 0) continue;
+            if (!text.empty()) text += ", ";
+            text += formatAmount(line.revenue[code]) + " " + currencies[code];
+        }
+        return text.empty() ? std::string("0.00") : text;
+    };
+    auto printLine = [&](const RevenueLine& line) {
+        char buffer[160];
+        std::snprintf(buffer, sizeof(buffer), "  %-16s sold=%-8llu load=%-7s cancelled=%-6s refunded=%-6s ",
+                      line.key.c_str(), static_cast<unsigned long long>(line.ticketsSold),
+                      formatPercent(line.loadFactor()).c_str(), formatPercent(line.cancellationRate()).c_str(),
+                      formatPercent(line.refundRate()).c_str());
+        out << buffer << revenueText(line) << "\n";
+    };
+
+    out << "Sales report " << formatDay(fromDay) << " .. " << formatDay(toDay) << " (" << flights.size()
+        << " flights, " << total.tickets() << " tickets)\n";
+    out << "Tickets sold: " << total.ticketsSold << ", cancelled: " << total.cancelled << " ("
+        << formatPercent(total.cancellationRate()) << "), refunded: " << total.refunded << " ("
+        << formatPercent(total.refundRate()) << ")\n";
+    out << "Revenue: " << revenueText(total) << "\n";
+    out << "Load factor: " << formatPercent(total.loadFactor()) << " (" << total.bookedSeats << " of " << total.seats
+        << " seats)\n";
+    for (size_t seatClass = 0; seatClass < SEAT_CLASS_COUNT; ++seatClass) {
+        out << "  " << seatClassName(seatClass) << ": " << formatPercent(seatClasses[seatClass].loadFactor()) << " ("
+            << seatClasses[seatClass].bookedSeats << " of " << seatClasses[seatClass].seats << ")\n";
+    }
+
+    out << "By route:\n";
+    for (const auto& line : routes) printLine(line);
+    out << "By day:\n";
+    for (const auto& line : days) printLine(line);
+
+    if (flightLimit == 0) return;
+    std::vector<const RevenueLine*> top;
+    top.reserve(flights.size());
+    for (const auto& line : flights) top.push_back(&line);
+    size_t shown = std::min(flightLimit, top.size());
+    std::partial_sort(top.begin(), top.begin() + shown, top.end(), [](const RevenueLine* a, const RevenueLine* b) {
+        return a->ticketsSold != b->ticketsSold ? a->ticketsSold > b->ticketsSold : a->key < b->key;
+    });
+    out << "Top " << shown << " flights by tickets sold:\n";
+    for (size_t i = 0; i < shown; ++i) printLine(*top[i]);
+}
+
+} // namespace Reporting
@@ -0,0 +1,98 @@
+/**
+ * @file SalesReport.h
+ * @brief Báo cáo doanh thu, hệ số lấp đầy và tỷ lệ hủy/hoàn vé theo chuyến bay, tuyến và ngày
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * buildSalesReport chia mảng vé của ReportColumns thành các đoạn liền nhau, mỗi luồng gộp một đoạn
+ * vào mảng dày riêng theo hàng chuyến bay (không khóa, không bảng băm). Vòng trong không rẽ nhánh:
+ * vé ngoài kỳ báo cáo hoặc không có chuyến bay được dồn vào một ô bỏ đi, vé đã hủy/hoàn cộng với
+ * trọng số 0. Sau đó các mảng riêng được cộng lại song song theo dải chuyến bay, rồi cuộn lên
+ * theo tuyến và theo ngày.
+ *
+ * Quy ước (giống OperationsReport):
+ * - Kỳ báo cáo lọc theo ngày khởi hành của chuyến bay
+ * - Doanh thu và vé bán tính các vé chưa hủy/hoàn tiền, theo từng tiền tệ, không quy đổi
+ * - Ghế và ghế đã đặt chỉ tính chuyến bay chưa hủy
+ */
+
+#ifndef SALES_REPORT_H
+#define SALES_REPORT_H
+
+#include "ReportColumns.h"
+#include <array>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Reporting {
+
+/// Số trạng thái vé có thể có (TicketStatus), làm tròn lên để đánh chỉ số trực tiếp
+constexpr size_t TICKET_STATUS_SLOTS = 8;
+
+struct ReportOptions {
+    int32_t fromDay = std::numeric_limits<int32_t>::min();  ///< Ngày khởi hành đầu tiên (kể cả), xem civilDay
+    int32_t toDay = std::numeric_limits<int32_t>::max();    ///< Ngày khởi hành cuối cùng (kể cả)
+    size_t threads = 0;                                     ///< 0: theo số nhân CPU
+};
+
+/**
+ * @brief Số liệu của một chuyến bay, tuyến, ngày hoặc toàn kỳ
+ */
+struct RevenueLine {
+    std::string key;                                ///< Số hiệu chuyến bay, "HAN-SGN", "YYYY-MM-DD" hoặc "TOTAL"
+    std::vector<int64_t> revenue;                   ///< Theo mã tiền tệ của SalesReport::currencies, 1/PRICE_SCALE
+    uint64_t ticketsSold = 0;                       ///< Vé chưa hủy/hoàn tiền
+    uint64_t cancelled = 0;
+    uint64_t refunded = 0;
+    uint64_t seats = 0;                             ///< Ghế của các chuyến chưa hủy
+    uint64_t bookedSeats = 0;                       ///< Vé bán trên các chuyến đó
+
+    uint64_t tickets() const { return ticketsSold + cancelled + refunded; }
+    double loadFactor() const { return seats > 0 ? static_cast<double>(bookedSeats) / seats : 0.0; }
+    double cancellationRate() const { return tickets() > 0 ? static_cast<double>(cancelled) / tickets() : 0.0; }
+    double refundRate() const { return tickets() > 0 ? static_cast<double>(refunded) / tickets() : 0.0; }
+
+    void add(const RevenueLine& other);
+};
+
+struct SeatClassLoad {
+    uint64_t seats = 0;
+    uint64_t bookedSeats = 0;
+
+    double loadFactor() const { return seats > 0 ? static_cast<double>(bookedSeats) / seats : 0.0; }
+};
+
+struct SalesReport {
+    int32_t fromDay = 0;                            ///< Ngày khởi hành sớm nhất trong kỳ có chuyến bay
+    int32_t toDay = 0;                              ///< Ngày khởi hành muộn nhất trong kỳ có chuyến bay
+    std::vector<std::string> currencies;
+    RevenueLine total;
+    std::vector<RevenueLine> flights;               ///< Theo thứ tự hàng trong FlightColumns
+    std::vector<RevenueLine> routes;                ///< Theo thứ tự tên tuyến
+    std::vector<RevenueLine> days;                  ///< Theo thứ tự ngày, chỉ ngày có chuyến bay
+    std::array<SeatClassLoad, SEAT_CLASS_COUNT> seatClasses{};
+    std::array<uint64_t, TICKET_STATUS_SLOTS> ticketsByStatus{};
+
+    /// Doanh thu của tiền tệ trên một dòng, 0 nếu không có
+    double revenueOf(const RevenueLine& line, const std::string& currency) const;
+
+    /**
+     * @brief In báo cáo dạng bảng
+     * @param flightLimit Số chuyến bay bán nhiều vé nhất được in
+     */
+    void print(std::ostream& out, size_t flightLimit = 10) const;
+};
+
+/**
+ * @brief Gộp các cột thành báo cáo của kỳ trong options
+ *
+ * Tiền được cộng bằng số nguyên nên kết quả giống hệt nhau với mọi số luồng.
+ */
+SalesReport buildSalesReport(const ReportColumns& columns, const ReportOptions& options = {});
+
+} // namespace Reporting
+
+#endif // SALES_REPORT_H
@@ -0,0 +1,200 @@
+#include "Snapshot.h"
+#include <algorithm>
+
+namespace Reporting {
+
+namespace {
+    /// Nạp các hàng theo id, từng lô SYNC_CHUNK id, nối vào cuối rows
+    template <typename Row, typename LoadByIds>
+    Result<size_t> loadByIds(const std::vector<int>& ids, LoadByIds loadChunk, std::vector<Row>& rows) {
+        std::vector<Row> chunk;
+        for (size_t first = 0; first < ids.size(); first += Snapshot::SYNC_CHUNK) {
+            std::vector<int> part(ids.begin() + first, ids.begin() + std::min(ids.size(), first + Snapshot::SYNC_CHUNK));
+            auto loaded = loadChunk(part, chunk);
+            if (!loaded) return Failure<size_t>(loaded.error());
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(rows));
+        }
+        return Success(rows.size());
+    }
+
+    /// Id trong ids không có hàng nào trong rows: hàng đã bị xóa
+    template <typename Row>
+    std::vector<int> missingIds(const std::vector<int>& ids, const std::vector<Row>& rows) {
+        std::unordered_set<int> present;
+        present.reserve(rows.size());
+        for (const auto& row : rows) present.insert(row.id);
+        std::vector<int> missing;
+        for (int id : ids) {
+            if (!present.contains(id)) missing.push_back(id);
+        }
+        return missing;
+    }
+
+    std::vector<int> takeSorted(std::unordered_set<int>& pending) {
+        std::vector<int> ids(pending.begin(), pending.end());
+        pending.clear();
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+}
+
+Snapshot::Snapshot(std::shared_ptr<Changes::Feed> feed, size_t batchSize)
+    : _batchSize(std::max<size_t>(batchSize, 1)) {
+    if (feed) {
+        _subscription = feed->subscribe([this](const Changes::Event& event) { onChange(event); });
+    }
+}
+
+void Snapshot::onChange(const Changes::Event& event) {
+    if (!_tracking.load()) return;
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    switch (event.entity) {
+        case Changes::Entity::FLIGHT:    _pendingFlights.insert(event.id); break;
+        case Changes::Entity::TICKET:    _pendingTickets.insert(event.id); break;
+        case Changes::Entity::PASSENGER: _pendingPassengers.insert(event.id); break;
+        case Changes::Entity::AIRCRAFT:  _flightsStale = true; break;
+    }
+}
+
+size_t Snapshot::pendingChanges() const {
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    return _pendingFlights.size() + _pendingTickets.size() + _pendingPassengers.size() + (_flightsStale ? 1 : 0);
+}
+
+Result<size_t> Snapshot::refresh(FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                                 PassengerRepository& passengerRepository) {
+    std::lock_guard<std::mutex> refreshing(_refreshMutex);
+    size_t changed = 0;
+
+    if (!_loaded) {
+        // Bắt đầu ghi lại thay đổi trước khi đọc trang đầu: hàng đổi trong lúc đọc sẽ được nạp lại ở dưới
+        _tracking = true;
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            _pendingFlights.clear();
+            _pendingTickets.clear();
+            _pendingPassengers.clear();
+            _flightsStale = false;
+        }
+
+        // Dựng ngoài khóa để báo cáo trên ảnh chụp cũ (nếu có) không phải chờ
+        auto columns = ReportColumns::load(flightRepository, ticketRepository, _batchSize);
+        if (!columns) return Failure<size_t>(columns.error());
+        auto passengers = columns.value().loadPassengers(passengerRepository, _batchSize);
+        if (!passengers) return Failure<size_t>(passengers.error());
+        changed = columns.value().flights.size() + columns.value().tickets.size() + passengers.value();
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        _columns = std::move(columns.value());
+        _loaded = true;
+    }
+
+    std::vector<int> flightIds, ticketIds, passengerIds;
+    bool reloadFlights = false;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        flightIds = takeSorted(_pendingFlights);
+        ticketIds = takeSorted(_pendingTickets);
+        passengerIds = takeSorted(_pendingPassengers);
+        reloadFlights = std::exchange(_flightsStale, false);
+    }
+    // Giữ lại các thay đổi chưa áp dụng cho lần sau
+    auto keepPending = [&](const CoreError& error) {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingFlights.insert(flightIds.begin(), flightIds.end());
+        _pendingTickets.insert(ticketIds.begin(), ticketIds.end());
+        _pendingPassengers.insert(passengerIds.begin(), passengerIds.end());
+        _flightsStale = _flightsStale || reloadFlights;
+        return Failure<size_t>(error);
+    };
+
+    std::vector<FlightSummaryRow> flights;
+    if (reloadFlights) {
+        std::vector<FlightSummaryRow> page;
+        int afterId = 0;
+        do {
+            auto loaded = flightRepository.findSummariesAfter(afterId, _batchSize, page);
+            if (!loaded) return keepPending(loaded.error());
+            std::move(page.begin(), page.end(), std::back_inserter(flights));
+            if (!flights.empty()) afterId = flights.back().id;
+        } while (page.size() == _batchSize);
+    } else {
+        auto loaded = loadByIds(flightIds, [&](const std::vector<int>& ids, std::vector<FlightSummaryRow>& rows) {
+            return flightRepository.findSummariesByIds(ids, rows);
+        }, flights);
+        if (!loaded) return keepPending(loaded.error());
+    }
+
+    std::vector<TicketFactRow> tickets;
+    auto loadedTickets = loadByIds(ticketIds, [&](const std::vector<int>& ids, std::vector<TicketFactRow>& rows) {
+        return ticketRepository.findFactsByIds(ids, rows);
+    }, tickets);
+    if (!loadedTickets) return keepPending(loadedTickets.error());
+
+    std::vector<PassengerListRow> passengers;
+    auto loadedPassengers = loadByIds(passengerIds, [&](const std::vector<int>& ids, std::vector<PassengerListRow>& rows) {
+        return passengerRepository.findListRowsByIds(ids, rows);
+    }, passengers);
+    if (!loadedPassengers) return keepPending(loadedPassengers.error());
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    // Chuyến bay trước vé để vé mới tìm được hàng chuyến bay của nó; xóa sau cùng
+    for (const auto& row : flights) {
+        auto applied = _columns.upsertFlight(row);
+        if (!applied) return keepPending(applied.error());
+    }
+    for (const auto& row : passengers) _columns.upsertPassenger(row);
+    for (const auto& row : tickets) {
+        auto applied = _columns.upsertTicket(row);
+        if (!applied) return keepPending(applied.error());
+    }
+    for (int id : missingIds(ticketIds, tickets)) _columns.removeTicket(id);
+    for (int id : missingIds(flightIds, flights)) _columns.removeFlight(id);
+    for (int id : missingIds(passengerIds, passengers)) _columns.removePassenger(id);
+    return Success(changed + flights.size() + tickets.size() + passengers.size());
+}
+
+SalesReport Snapshot::salesReport(const ReportOptions& options) const {
+    return read([&options](const ReportColumns& columns) { return buildSalesReport(columns, options); });
+}
+
+std::vector<int> Snapshot::findFlights(const FlightQuery& query) const {
+    return read([&query](const ReportColumns& columns) {
+        const FlightColumns& flights = columns.flights;
+        std::vector<int> ids;
+        // Mã sân bay chưa từng xuất hiện thì không chuyến nào khớp
+        uint32_t departure = query.departureCode.empty() ? NO_ROW : flights.airports.find(query.departureCode);
+        uint32_t arrival = query.arrivalCode.empty() ? NO_ROW : flights.airports.find(query.arrivalCode);
+        if ((!query.departureCode.empty() && departure == NO_ROW) || (!query.arrivalCode.empty() && arrival == NO_ROW)) {
+            return ids;
+        }
+
+        std::vector<std::pair<int64_t, int>> matches;
+        for (size_t row = 0; row < flights.size(); ++row) {
+            if (departure != NO_ROW && flights.departureAirport[row] != departure) continue;
+            if (arrival != NO_ROW && flights.arrivalAirport[row] != arrival) continue;
+            if (flights.departureTime[row] < query.departFrom || flights.departureTime[row] > query.departTo) continue;
+            if (!query.includeCancelled && flights.status[row] == static_cast<uint8_t>(FlightStatus::CANCELLED)) continue;
+            matches.emplace_back(flights.departureTime[row], flights.id[row]);
+        }
+        size_t shown = std::min(query.limit, matches.size());
+        std::partial_sort(matches.begin(), matches.begin() + shown, matches.end());
+        ids.reserve(shown);
+        for (size_t i = 0; i < shown; ++i) ids.push_back(matches[i].second);
+        return ids;
+    });
+}
+
+std::vector<int> Snapshot::findTicketsOfPassenger(int passengerId) const {
+    return read([passengerId](const ReportColumns& columns) {
+        const TicketColumns& tickets = columns.tickets;
+        std::vector<int> ids;
+        for (size_t row = 0; row < tickets.size(); ++row) {
+            if (tickets.passengerId[row] == passengerId) ids.push_back(tickets.id[row]);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    });
+}
+
+} // namespace Reporting
@@ -0,0 +1,121 @@
+/**
+ * @file Snapshot.h
+ * @brief Ảnh chụp dạng cột của chuyến bay, vé và hành khách, giữ khớp với bảng qua Changes::Feed
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * ReportColumns::load đi qua cả hai bảng lớn mỗi lần lập báo cáo. Snapshot giữ một bộ
+ * ReportColumns sống trong tiến trình: lần refresh đầu nạp toàn bộ bằng truy vấn theo khóa,
+ * các lần sau chỉ nạp lại những id mà Changes::Feed báo đã đổi (truy vấn IN theo lô), rồi áp
+ * dụng vào cột tại chỗ. Báo cáo và tìm kiếm sau đó chạy trên bộ nhớ, không chạm cơ sở dữ liệu.
+ *
+ * Cách theo dõi thay đổi giống TypeAheadIndex: handler chỉ ghi lại id (nó chạy bên trong lệnh ghi
+ * của repository), việc nạp để refresh kế tiếp làm. Máy bay đổi sơ đồ ghế thì số ghế của mọi
+ * chuyến bay có thể đổi theo, nên thay đổi máy bay làm lần refresh sau nạp lại cả bảng chuyến bay
+ * (nhỏ so với bảng vé).
+ *
+ * Đọc qua read(): giữ khóa chung trong lúc hàm đọc chạy, nên nhiều báo cáo chạy song song được,
+ * và refresh chỉ chờ chúng khi áp dụng thay đổi.
+ *
+ * Nơi dùng: Server::RequestDispatcher giữ một Snapshot suốt đời server cho flight.search (theo sân
+ * bay/tuyến và ngày) và report.routes; airlines_cli report và buildOperationsReport dựng một Snapshot
+ * không theo dõi feed vì tiến trình chỉ lập một báo cáo. Tìm theo tiền tố số hiệu, tên, hộ chiếu
+ * vẫn đi qua TypeAheadIndex. Feed chỉ mang lệnh ghi của tiến trình hiện tại.
+ */
+
+#ifndef REPORTING_SNAPSHOT_H
+#define REPORTING_SNAPSHOT_H
+
+#include "ReportColumns.h"
+#include "SalesReport.h"
+#include "../utils/ChangeFeed.h"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+namespace Reporting {
+
+/**
+ * @brief Điều kiện tìm chuyến bay trên ảnh chụp
+ */
+struct FlightQuery {
+    std::string departureCode;                                  ///< Mã sân bay đi; rỗng là mọi sân bay
+    std::string arrivalCode;                                    ///< Mã sân bay đến; rỗng là mọi sân bay
+    int64_t departFrom = std::numeric_limits<int64_t>::min();   ///< Khởi hành từ (civilSeconds, kể cả)
+    int64_t departTo = std::numeric_limits<int64_t>::max();     ///< Khởi hành tới (civilSeconds, kể cả)
+    bool includeCancelled = false;
+    size_t limit = 100;
+};
+
+class Snapshot {
+private:
+    mutable std::shared_mutex _mutex;           ///< Đọc giữ chung, áp dụng thay đổi giữ riêng
+    ReportColumns _columns;
+
+    std::mutex _refreshMutex;                   ///< Chỉ một luồng refresh tại một thời điểm
+    bool _loaded = false;                       ///< Chỉ đọc/ghi khi giữ _refreshMutex
+    std::atomic<bool> _tracking{false};         ///< Đã bắt đầu nạp: từ đây mọi thay đổi phải được ghi lại
+
+    mutable std::mutex _pendingMutex;
+    std::unordered_set<int> _pendingFlights;
+    std::unordered_set<int> _pendingTickets;
+    std::unordered_set<int> _pendingPassengers;
+    bool _flightsStale = false;                 ///< Máy bay đã đổi: nạp lại cả bảng chuyến bay
+
+    size_t _batchSize;
+    Changes::Subscription _subscription;        ///< Khai báo cuối để bị hủy trước các cột
+
+    void onChange(const Changes::Event& event);
+
+public:
+    /// Số id tối đa của một truy vấn IN khi áp dụng thay đổi
+    static constexpr size_t SYNC_CHUNK = 500;
+
+    /**
+     * @param feed Nguồn sự kiện thay đổi; null để không theo dõi thay đổi (chỉ dùng trong test)
+     * @param batchSize Số hàng mỗi truy vấn khi nạp
+     */
+    explicit Snapshot(std::shared_ptr<Changes::Feed> feed = Changes::Feed::getInstance(),
+                      size_t batchSize = ReportColumns::DEFAULT_BATCH_SIZE);
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    /**
+     * @brief Nạp ảnh chụp nếu chưa nạp, rồi áp dụng các thay đổi đang chờ
+     * @return Số hàng vừa nạp hoặc nạp lại, hoặc lỗi truy vấn (ảnh chụp giữ nguyên, thay đổi vẫn đang chờ)
+     * @note Lần đầu đi qua cả ba bảng nên có thể lâu; gọi trên worker
+     */
+    Result<size_t> refresh(FlightRepository& flightRepository, TicketRepository& ticketRepository,
+                           PassengerRepository& passengerRepository);
+
+    /// Số id đã thay đổi chưa được áp dụng
+    size_t pendingChanges() const;
+
+    /**
+     * @brief Chạy fn(const ReportColumns&) trên ảnh chụp, giữ khóa đọc
+     * @note fn không được gọi refresh
+     */
+    template <typename Fn>
+    auto read(Fn&& fn) const {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        return fn(static_cast<const ReportColumns&>(_columns));
+    }
+
+    /// buildSalesReport trên ảnh chụp hiện tại
+    SalesReport salesReport(const ReportOptions& options = {}) const;
+
+    /// Id các chuyến bay thỏa điều kiện, theo thứ tự giờ khởi hành
+    std::vector<int> findFlights(const FlightQuery& query) const;
+
+    /// Id các vé của hành khách, theo thứ tự id
+    std::vector<int> findTicketsOfPassenger(int passengerId) const;
+};
+
+} // namespace Reporting
+
+#endif // REPORTING_SNAPSHOT_H
@@ -1,5 +1,7 @@
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
 #include "TicketMockRepository.h"
 #include "core/exceptions/Result.h"
 #include "utils/Logger.h"
@@ -117,6 +119,21 @@ Result<std::vector<Ticket>> TicketMockRepository::findByPassengerId(int passenge
     return result;
 }
 
+Result<size_t> TicketMockRepository::countActiveBookings(PassengerStatistics &statistics)
+{
+    std::unordered_set<int> passengers;
+    statistics.activeTickets = 0;
+    for (const auto &[id, ticket] : _tickets)
+    {
+        if (!PassengerStatistics::isActive(ticket->getStatus()))
+            continue;
+        passengers.insert(ticket->getPassenger()->getId());
+        ++statistics.activeTickets;
+    }
+    statistics.passengersWithActiveBookings = passengers.size();
+    return statistics.passengersWithActiveBookings;
+}
+
 // Result<std::vector<Ticket>> TicketMockRepository::findByFlightId(int flightId)
 // {
 //     std::vector<Ticket> result;
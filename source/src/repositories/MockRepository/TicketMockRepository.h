@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include "core/entities/Ticket.h"
 #include "repositories/InterfaceRepository.h"
+#include "repositories/ReadModels.h"
 #include "core/exceptions/Result.h"
 #include "utils/Logger.h"
 #include <memory>
@@ -34,6 +35,9 @@ public:
     Result<bool> existsTicket(const TicketNumber &ticketNumber);
     Result<std::vector<Ticket>> findByPassengerId(int passengerId);
     Result<std::vector<Ticket>> findBySerialNumber(const AircraftSerial &serial);
+
+    // Cùng kết quả với TicketRepository::countActiveBookings, đếm trong một lượt duyệt
+    Result<size_t> countActiveBookings(PassengerStatistics &statistics);
 };
 
 #endif // TICKET_MOCK_REPOSITORY_H
\ No newline at end of file
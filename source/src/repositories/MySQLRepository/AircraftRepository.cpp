@@ -1,12 +1,19 @@
 #include "AircraftRepository.h"
+#include "../PageQuery.h"
 #include "../../core/exceptions/Result.h"
 #include "../../utils/Logger.h"
+#include "../../utils/ChangeFeed.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracing.h"
 #include <sstream>
 #include <map>
 
 using namespace Tables::Aircraft;
 
 Result<Aircraft> AircraftRepository::findById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "aircraft", "find_by_id");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding aircraft by id: " + std::to_string(id));
 
@@ -66,9 +73,10 @@ Result<Aircraft> AircraftRepository::findById(const int& id) {
         auto seatLayout = SeatClassMap::create(seatLayoutStr.str()).value();
         auto aircraft = Aircraft::create(serial, modelResult.value(), seatLayout).value();
         aircraft.setId(idResult.value());
+        aircraft.clearDirty();
 
         if (_logger) _logger->debug("Successfully found aircraft with id: " + std::to_string(id));
-        return Success(aircraft);
+        return timer.complete(Success(aircraft));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding aircraft by id: " + std::string(e.what()));
         return Failure<Aircraft>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -76,6 +84,9 @@ Result<Aircraft> AircraftRepository::findById(const int& id) {
 }
 
 Result<std::vector<Aircraft>> AircraftRepository::findAll() {
+    static const Metrics::OperationMetrics metrics("repository", "aircraft", "find_all");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding all aircraft");
 
@@ -134,11 +145,12 @@ Result<std::vector<Aircraft>> AircraftRepository::findAll() {
             }
 
             aircraft->setId(idResult.value());
+            aircraft->clearDirty();
             aircrafts.push_back(*aircraft);
         }
 
         if (_logger) _logger->debug("Successfully found " + std::to_string(aircrafts.size()) + " aircraft");
-        return Success(aircrafts);
+        return timer.complete(Success(aircrafts));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding all aircraft: " + std::string(e.what()));
         return Failure<std::vector<Aircraft>>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -224,6 +236,9 @@ Result<size_t> AircraftRepository::count() {
 }
 
 Result<Aircraft> AircraftRepository::create(const Aircraft& aircraft) {
+    static const Metrics::OperationMetrics metrics("repository", "aircraft", "create");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Creating new aircraft");
 
@@ -271,8 +286,10 @@ Result<Aircraft> AircraftRepository::create(const Aircraft& aircraft) {
 
         auto newAircraft = aircraft;
         newAircraft.setId(idResult.value());
+        newAircraft.clearDirty();
+        Changes::Feed::getInstance()->publish(Changes::Entity::AIRCRAFT, Changes::Kind::CREATED, newAircraft.getId());
         if (_logger) _logger->debug("Successfully created aircraft with id: " + std::to_string(idResult.value()));
-        return Success(newAircraft);
+        return timer.complete(Success(newAircraft));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error creating aircraft: " + std::string(e.what()));
@@ -281,6 +298,9 @@ Result<Aircraft> AircraftRepository::create(const Aircraft& aircraft) {
 }
 
 Result<Aircraft> AircraftRepository::update(const Aircraft& aircraft) {
+    static const Metrics::OperationMetrics metrics("repository", "aircraft", "update");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Updating aircraft with id: " + std::to_string(aircraft.getId()));
 
@@ -295,6 +315,11 @@ Result<Aircraft> AircraftRepository::update(const Aircraft& aircraft) {
             return Failure<Aircraft>(CoreError("Aircraft not found with id: " + std::to_string(aircraft.getId()), "DB_ERROR"));
         }
 
+        // Only write the changed columns when the entity tracks its changes
+        if (aircraft.hasPartialChanges()) {
+            return timer.complete(updateDirtyFields(aircraft));
+        }
+
         // Start transaction
         _connection->beginTransaction();
 
@@ -331,8 +356,12 @@ Result<Aircraft> AircraftRepository::update(const Aircraft& aircraft) {
 
         _connection->commitTransaction();
 
+        auto updatedAircraft = aircraft;
+        updatedAircraft.clearDirty();
+
+        Changes::Feed::getInstance()->publish(Changes::Entity::AIRCRAFT, Changes::Kind::UPDATED, aircraft.getId());
         if (_logger) _logger->debug("Successfully updated aircraft with id: " + std::to_string(aircraft.getId()));
-        return Success(aircraft);
+        return timer.complete(Success(updatedAircraft));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error updating aircraft: " + std::string(e.what()));
@@ -341,6 +370,9 @@ Result<Aircraft> AircraftRepository::update(const Aircraft& aircraft) {
 }
 
 Result<bool> AircraftRepository::deleteById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "aircraft", "delete");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Deleting aircraft with id: " + std::to_string(id));
 
@@ -386,8 +418,9 @@ Result<bool> AircraftRepository::deleteById(const int& id) {
 
         _connection->commitTransaction();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::AIRCRAFT, Changes::Kind::DELETED, id);
         if (_logger) _logger->debug("Successfully deleted aircraft with id: " + std::to_string(id));
-        return Success(true);
+        return timer.complete(Success(true));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error deleting aircraft: " + std::string(e.what()));
@@ -419,10 +452,13 @@ Aircraft AircraftRepository::mapRowToAircraft(const std::map<std::string, std::s
     auto seatLayout = SeatClassMap::create(seatLayoutStr.str()).value();
     auto aircraft = Aircraft::create(serial, model, seatLayout).value();
     aircraft.setId(id);
+    aircraft.clearDirty();
     return aircraft;
 }
 
 Result<Aircraft> AircraftRepository::findBySerialNumber(const AircraftSerial& serial) {
+    Tracing::Span span("aircraft.find_by_serial_number", "repository");
+
     try {
         if (_logger) _logger->debug("Finding aircraft by serial number: " + serial.toString());
 
@@ -483,6 +519,7 @@ Result<Aircraft> AircraftRepository::findBySerialNumber(const AircraftSerial& se
         auto seatLayout = SeatClassMap::create(seatLayoutStr.str()).value();
         auto aircraft = Aircraft::create(serial, modelResult.value(), seatLayout).value();
         aircraft.setId(idResult.value());
+        aircraft.clearDirty();
 
         if (_logger) _logger->debug("Successfully found aircraft with serial number: " + serial.toString());
         return Success(aircraft);
@@ -543,13 +580,13 @@ Result<bool> AircraftRepository::deleteBySerialNumber(const AircraftSerial& seri
     try {
         if (_logger) _logger->debug("Deleting aircraft with  serial number: " + serial.toString());
 
-        // First check if aircraft exists
-        auto existsResult = existsAircraft(serial);
-        if (!existsResult) {
-            if (_logger) _logger->error("Failed to check aircraft existence");
-            return Failure<bool>(CoreError("Failed to check aircraft existence", "DB_ERROR"));
-        }
-        if (!existsResult.value()) {
+        // First check if aircraft exists; the id is needed for the change event
+        auto existingResult = findBySerialNumber(serial);
+        if (!existingResult) {
+            if (existingResult.error().code != "NOT_FOUND") {
+                if (_logger) _logger->error("Failed to check aircraft existence");
+                return Failure<bool>(CoreError("Failed to check aircraft existence", "DB_ERROR"));
+            }
             if (_logger) _logger->error("Aircraft not found with  serial number: " + serial.toString());
             return Failure<bool>(CoreError("Aircraft not found with serial number: " + serial.toString(), "DB_ERROR"));
         }
@@ -585,6 +622,7 @@ Result<bool> AircraftRepository::deleteBySerialNumber(const AircraftSerial& seri
 
         _connection->commitTransaction();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::AIRCRAFT, Changes::Kind::DELETED, existingResult.value().getId());
         if (_logger) _logger->debug("Successfully deleted aircraft with  serial number: " + serial.toString());
         return Success(true);
     } catch (const std::exception& e) {
@@ -592,4 +630,106 @@ Result<bool> AircraftRepository::deleteBySerialNumber(const AircraftSerial& seri
         if (_logger) _logger->error("Error deleting aircraft: " + std::string(e.what()));
         return Failure<bool>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
     }
-}
\ No newline at end of file
+}
+Result<Aircraft> AircraftRepository::updateDirtyFields(const Aircraft& aircraft) {
+    std::vector<const char*> columns;
+    if (aircraft.isFieldDirty(Aircraft::FIELD_MODEL)) {
+        columns.push_back(ColumnName[MODEL]);
+    }
+    if (aircraft.isFieldDirty(Aircraft::FIELD_SEAT_LAYOUT)) {
+        columns.push_back(ColumnName[ECONOMY_SEATS]);
+        columns.push_back(ColumnName[BUSINESS_SEATS]);
+        columns.push_back(ColumnName[FIRST_SEATS]);
+    }
+
+    auto query = Tables::buildPartialUpdateQuery(NAME_TABLE, columns);
+    if (_logger) _logger->debug("Partial aircraft update: " + query);
+
+    auto prepareResult = _connection->prepareStatement(query);
+    if (!prepareResult) {
+        if (_logger) _logger->error("Failed to prepare statement for partial aircraft update");
+        return Failure<Aircraft>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    }
+    int stmtId = prepareResult.value();
+
+    int paramIndex = 1;
+    bool bound = true;
+    if (aircraft.isFieldDirty(Aircraft::FIELD_MODEL)) {
+        bound = bound && _connection->setString(stmtId, paramIndex++, aircraft.getModel()).has_value();
+    }
+    if (aircraft.isFieldDirty(Aircraft::FIELD_SEAT_LAYOUT)) {
+        bound = bound && _connection->setInt(stmtId, paramIndex++, aircraft.getSeatLayout().getSeatCount("E")).has_value();
+        bound = bound && _connection->setInt(stmtId, paramIndex++, aircraft.getSeatLayout().getSeatCount("B")).has_value();
+        bound = bound && _connection->setInt(stmtId, paramIndex++, aircraft.getSeatLayout().getSeatCount("F")).has_value();
+    }
+    bound = bound && _connection->setInt(stmtId, paramIndex, aircraft.getId()).has_value();
+
+    if (!bound) {
+        _connection->freeStatement(stmtId);
+        if (_logger) _logger->error("Failed to set parameters for partial aircraft update");
+        return Failure<Aircraft>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+    }
+
+    auto result = _connection->executeStatement(stmtId);
+    _connection->freeStatement(stmtId);
+
+    if (!result) {
+        if (_logger) _logger->error("Failed to execute partial aircraft update");
+        return Failure<Aircraft>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+    }
+
+    auto updatedAircraft = aircraft;
+    updatedAircraft.clearDirty();
+
+    Changes::Feed::getInstance()->publish(Changes::Entity::AIRCRAFT, Changes::Kind::UPDATED, aircraft.getId());
+    if (_logger) _logger->debug("Successfully updated " + std::to_string(columns.size()) + " column(s) of aircraft with id: " + std::to_string(aircraft.getId()));
+    return Success(updatedAircraft);
+}
+
+/**
+ * @brief Nạp một trang máy bay dạng phẳng cho màn hình danh sách
+ *
+ * Giải mã theo chỉ số cột, không dựng SeatClassMap hay Aircraft.
+ *
+ * @param offset Số hàng bỏ qua
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> AircraftRepository::findListRowsPage(size_t offset, size_t limit, std::vector<AircraftListRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executePageQuery(*_connection, FIND_LIST_ROW_PAGE_QUERY, offset, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load aircraft page: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+
+        auto dbResult = std::move(result.value());
+        while (dbResult->next().value()) {
+            auto idResult = dbResult->getInt(ID);
+            auto serialResult = dbResult->getString(SERIAL);
+            auto modelResult = dbResult->getString(MODEL);
+            auto economyResult = dbResult->getInt(ECONOMY_SEATS);
+            auto businessResult = dbResult->getInt(BUSINESS_SEATS);
+            auto firstResult = dbResult->getInt(FIRST_SEATS);
+
+            if (!idResult || !serialResult || !modelResult || !economyResult || !businessResult || !firstResult) {
+                if (_logger) _logger->error("Failed to get aircraft list row data");
+                return Failure<size_t>(CoreError("Failed to get aircraft list row data", "DATA_ERROR"));
+            }
+
+            auto& row = rows.emplace_back();
+            row.id = idResult.value();
+            row.serial = std::move(serialResult.value());
+            row.model = std::move(modelResult.value());
+            row.economySeats = economyResult.value();
+            row.businessSeats = businessResult.value();
+            row.firstSeats = firstResult.value();
+        }
+        return Success(rows.size());
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading aircraft page: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
@@ -20,6 +20,7 @@
 #include "../../database/InterfaceDatabaseConnection.h"
 #include "../../utils/Logger.h"
 #include "../../utils/TableConstants.h"
+#include "../ReadModels.h"
 #include <memory>
 #include <string>
 #include <map>
@@ -49,6 +50,14 @@ private:
     std::shared_ptr<IDatabaseConnection> _connection; ///< Kết nối database được inject
     std::shared_ptr<Logger> _logger;                  ///< Logger để ghi log debug/error
 
+    /**
+     * @brief Cập nhật chỉ các cột đã thay đổi của máy bay.
+     * 
+     * @param aircraft Máy bay có ít nhất một trường đã được đánh dấu thay đổi
+     * @return Result<Aircraft> Máy bay đã cập nhật hoặc lỗi
+     */
+    Result<Aircraft> updateDirtyFields(const Aircraft& aircraft);
+
 public:
     /**
      * @brief Constructor với dependency injection.
@@ -214,6 +223,17 @@ public:
      */
     Result<bool> deleteBySerialNumber(const AircraftSerial& serial);
 
+    // Phương thức projection cho màn hình danh sách
+
+    /**
+     * @brief Nạp một trang máy bay dạng phẳng, theo thứ tự id
+     * @param offset Số hàng bỏ qua
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> findListRowsPage(size_t offset, size_t limit, std::vector<AircraftListRow>& rows);
+
 private:
     /**
      * @brief Chuyển đổi dữ liệu từ database row sang Aircraft object.
@@ -1,10 +1,15 @@
 #include "FlightRepository.h"
+#include "../PageQuery.h"
 #include "../../core/exceptions/Result.h"
 #include "../../utils/Logger.h"
+#include "../../utils/ChangeFeed.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracing.h"
 #include <sstream>
 #include <map>
 #include <format>
 #include <iomanip>
+#include <unordered_map>
 
 using namespace Tables::Flight;
 
@@ -19,6 +24,9 @@ using namespace Tables::Flight;
  */
 Result<Flight> FlightRepository::findById(const int &id)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "find_by_id");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
@@ -71,6 +79,7 @@ Result<Flight> FlightRepository::findById(const int &id)
         auto departureTimeResult = dbResult->getDateTime(ColumnName[DEPARTURE_TIME]);
         auto arrivalTimeResult = dbResult->getDateTime(ColumnName[ARRIVAL_TIME]);
         auto statusResult = dbResult->getString(ColumnName[STATUS]);
+        auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
         // Get aircraft data
         auto serialNumberResult = dbResult->getString("serial_number");
@@ -81,7 +90,7 @@ Result<Flight> FlightRepository::findById(const int &id)
 
         if (!idResult || !flightNumberResult || !departureCodeResult || !departureNameResult ||
             !arrivalCodeResult || !arrivalNameResult || !aircraftIdResult ||
-            !departureTimeResult || !arrivalTimeResult || !statusResult ||
+            !departureTimeResult || !arrivalTimeResult || !statusResult || !versionResult ||
             !serialNumberResult || !modelResult || !economySeatsResult || !businessSeatsResult || !firstSeatsResult)
         {
             if (_logger)
@@ -130,6 +139,8 @@ Result<Flight> FlightRepository::findById(const int &id)
         auto flight = Flight::create(flightNumber, route, schedule, std::make_shared<Aircraft>(aircraft)).value();
         flight.setId(idResult.value());
         flight.setStatus(FlightStatusUtil::fromString(statusResult.value()));
+        flight.setVersion(versionResult.value());
+        flight.clearDirty();
 
         // Get seat availability
         auto seatAvailability = getSeatAvailability(flight);
@@ -137,7 +148,7 @@ Result<Flight> FlightRepository::findById(const int &id)
 
         if (_logger)
             _logger->debug("Successfully found flight with id: " + std::to_string(id));
-        return Success(flight);
+        return timer.complete(Success(flight));
     }
     catch (const std::exception &e)
     {
@@ -157,6 +168,9 @@ Result<Flight> FlightRepository::findById(const int &id)
  */
 Result<std::vector<Flight>> FlightRepository::findAll()
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "find_all");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
@@ -188,6 +202,7 @@ Result<std::vector<Flight>> FlightRepository::findAll()
             auto departureTimeResult = dbResult->getDateTime(ColumnName[DEPARTURE_TIME]);
             auto arrivalTimeResult = dbResult->getDateTime(ColumnName[ARRIVAL_TIME]);
             auto statusResult = dbResult->getString(ColumnName[STATUS]);
+            auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
             // Get aircraft data
             auto serialNumberResult = dbResult->getString("serial_number");
@@ -198,7 +213,7 @@ Result<std::vector<Flight>> FlightRepository::findAll()
 
             if (!flightNumberResult || !departureCodeResult || !departureNameResult ||
                 !arrivalCodeResult || !arrivalNameResult || !aircraftIdResult ||
-                !departureTimeResult || !arrivalTimeResult || !statusResult ||
+                !departureTimeResult || !arrivalTimeResult || !statusResult || !versionResult ||
                 !serialNumberResult || !modelResult || !economySeatsResult || !businessSeatsResult || !firstSeatsResult)
             {
                 if (_logger)
@@ -295,12 +310,14 @@ Result<std::vector<Flight>> FlightRepository::findAll()
 
             flight->setId(idResult.value());
             flight->setStatus(FlightStatusUtil::fromString(statusResult.value()));
+            flight->setVersion(versionResult.value());
+            flight->clearDirty();
             flights.push_back(*flight);
         }
 
         if (_logger)
             _logger->debug("Successfully found " + std::to_string(flights.size()) + " flights");
-        return Success(flights);
+        return timer.complete(Success(flights));
     }
     catch (const std::exception &e)
     {
@@ -390,6 +407,8 @@ Result<bool> FlightRepository::exists(const int &id)
  */
 Result<size_t> FlightRepository::count()
 {
+    // Danh sách làm mới luôn đếm trước: mốc trang của lượt trước có thể đã lệch
+    _pageAnchors->clear();
     try
     {
         if (_logger)
@@ -443,6 +462,9 @@ Result<size_t> FlightRepository::count()
  */
 Result<Flight> FlightRepository::create(const Flight &flight)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "create");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
@@ -521,6 +543,7 @@ Result<Flight> FlightRepository::create(const Flight &flight)
 
         auto newFlight = flight;
         newFlight.setId(idResult.value());
+        newFlight.clearDirty();
 
         // Create seat availability records
         std::string insertSeatQuery = "INSERT INTO flight_seat_availability (flight_id, seat_number, is_available) VALUES (?, ?, TRUE)";
@@ -570,9 +593,10 @@ Result<Flight> FlightRepository::create(const Flight &flight)
 
         _connection->freeStatement(seatStmtId);
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::CREATED, newFlight.getId());
         if (_logger)
             _logger->debug("Successfully created flight with id: " + std::to_string(idResult.value()));
-        return Success(newFlight);
+        return timer.complete(Success(newFlight));
     }
     catch (const std::exception &e)
     {
@@ -583,6 +607,207 @@ Result<Flight> FlightRepository::create(const Flight &flight)
     }
 }
 
+/**
+ * @brief Tạo nhiều chuyến bay trong một transaction
+ *
+ * Chuyến bay được chèn bằng một câu INSERT nhiều hàng; với INSERT đơn giản InnoDB cấp các giá trị
+ * AUTO_INCREMENT liên tiếp nên ID của chuyến bay thứ i là LAST_INSERT_ID() + i. Ghế trống được
+ * chèn theo lô SEAT_ROWS_PER_STATEMENT hàng, số ghế sinh một lần cho mỗi máy bay theo cùng quy tắc
+ * với create().
+ *
+ * @param rows Các chuyến bay cần tạo
+ * @return Result<std::vector<int>> ID của các chuyến bay đã tạo hoặc lỗi
+ */
+Result<std::vector<int>> FlightRepository::createBatch(const std::vector<FlightInsertRow> &rows)
+{
+    static const Metrics::OperationMetrics metrics("repository", "flight", "create_batch");
+    Metrics::OperationTimer timer(metrics);
+
+    if (rows.empty())
+    {
+        return timer.complete(Success(std::vector<int>{}));
+    }
+    for (const auto &row : rows)
+    {
+        if (!row.aircraft)
+        {
+            return Failure<std::vector<int>>(CoreError("Aircraft cannot be null", "INVALID_AIRCRAFT"));
+        }
+    }
+
+    if (_logger)
+        _logger->debug("Creating " + std::to_string(rows.size()) + " flights");
+
+    auto beginResult = _connection->beginTransaction();
+    if (!beginResult)
+    {
+        if (_logger)
+            _logger->error("Failed to begin transaction for creating flights");
+        return Failure<std::vector<int>>(beginResult.error());
+    }
+
+    auto fail = [this](const CoreError &error)
+    {
+        _connection->rollbackTransaction();
+        return Failure<std::vector<int>>(error);
+    };
+
+    try
+    {
+        auto insertPrepareResult = _connection->prepareStatement(buildBatchInsertQuery(rows.size()));
+        if (!insertPrepareResult)
+        {
+            if (_logger)
+                _logger->error("Failed to prepare statement for creating flights");
+            return fail(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int insertStmtId = insertPrepareResult.value();
+
+        bool paramsOk = true;
+        for (size_t i = 0; i < rows.size() && paramsOk; ++i)
+        {
+            const auto &row = rows[i];
+            const int base = static_cast<int>(i * INSERT_COLUMN_COUNT);
+            paramsOk = _connection->setString(insertStmtId, base + 1, row.flightNumber) &&
+                       _connection->setString(insertStmtId, base + 2, row.departureCode) &&
+                       _connection->setString(insertStmtId, base + 3, row.departureName) &&
+                       _connection->setString(insertStmtId, base + 4, row.arrivalCode) &&
+                       _connection->setString(insertStmtId, base + 5, row.arrivalName) &&
+                       _connection->setInt(insertStmtId, base + 6, row.aircraft->getId()) &&
+                       _connection->setDateTime(insertStmtId, base + 7, row.departureTime) &&
+                       _connection->setDateTime(insertStmtId, base + 8, row.arrivalTime) &&
+                       _connection->setString(insertStmtId, base + 9, FlightStatusUtil::toString(row.status));
+        }
+        if (!paramsOk)
+        {
+            _connection->freeStatement(insertStmtId);
+            if (_logger)
+                _logger->error("Failed to set parameters for creating flights");
+            return fail(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto insertResult = _connection->executeStatement(insertStmtId);
+        _connection->freeStatement(insertStmtId);
+        if (!insertResult)
+        {
+            if (_logger)
+                _logger->error("Failed to execute statement for creating flights");
+            return fail(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+        }
+
+        auto firstIdResult = _connection->getLastInsertId();
+        if (!firstIdResult)
+        {
+            if (_logger)
+                _logger->error("Failed to get last insert id for flights");
+            return fail(CoreError("Failed to get last insert id", "GET_ID_FAILED"));
+        }
+
+        std::vector<int> ids(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            ids[i] = firstIdResult.value() + static_cast<int>(i);
+        }
+
+        // Số ghế của mỗi máy bay chỉ sinh một lần
+        std::unordered_map<int, std::vector<std::string>> seatsByAircraft;
+        std::vector<std::pair<int, const std::string *>> pending;
+        pending.reserve(SEAT_ROWS_PER_STATEMENT);
+
+        auto flushSeats = [&]() -> Result<bool>
+        {
+            if (pending.empty())
+                return Success(true);
+            auto seatPrepareResult = _connection->prepareStatement(buildSeatAvailabilityInsertQuery(pending.size()));
+            if (!seatPrepareResult)
+                return Failure<bool>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+            int seatStmtId = seatPrepareResult.value();
+            bool seatParamsOk = true;
+            for (size_t i = 0; i < pending.size() && seatParamsOk; ++i)
+            {
+                const int base = static_cast<int>(i * 2);
+                seatParamsOk = _connection->setInt(seatStmtId, base + 1, pending[i].first) &&
+                               _connection->setString(seatStmtId, base + 2, *pending[i].second);
+            }
+            if (!seatParamsOk)
+            {
+                _connection->freeStatement(seatStmtId);
+                return Failure<bool>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+            }
+            auto seatResult = _connection->executeStatement(seatStmtId);
+            _connection->freeStatement(seatStmtId);
+            if (!seatResult)
+                return Failure<bool>(CoreError("Failed to create seat availability", "CREATE_FAILED"));
+            pending.clear();
+            return Success(true);
+        };
+
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            const auto &aircraft = *rows[i].aircraft;
+            auto seats = seatsByAircraft.find(aircraft.getId());
+            if (seats == seatsByAircraft.end())
+            {
+                std::vector<std::string> numbers;
+                for (const auto &[classCode, count] : aircraft.getSeatLayout().getSeatCounts())
+                {
+                    int padding = count > 99 ? 3 : 2;
+                    for (int seat = 1; seat <= count; seat++)
+                    {
+                        std::stringstream ss;
+                        ss << classCode.getCode() << std::setfill('0') << std::setw(padding) << seat;
+                        numbers.push_back(ss.str());
+                    }
+                }
+                seats = seatsByAircraft.emplace(aircraft.getId(), std::move(numbers)).first;
+            }
+
+            for (const auto &seatNumber : seats->second)
+            {
+                pending.emplace_back(ids[i], &seatNumber);
+                if (pending.size() < SEAT_ROWS_PER_STATEMENT)
+                    continue;
+                auto flushed = flushSeats();
+                if (!flushed)
+                {
+                    if (_logger)
+                        _logger->error("Failed to create seat availability records");
+                    return fail(flushed.error());
+                }
+            }
+        }
+        auto flushed = flushSeats();
+        if (!flushed)
+        {
+            if (_logger)
+                _logger->error("Failed to create seat availability records");
+            return fail(flushed.error());
+        }
+
+        auto commitResult = _connection->commitTransaction();
+        if (!commitResult)
+        {
+            if (_logger)
+                _logger->error("Failed to commit transaction for creating flights");
+            return fail(commitResult.error());
+        }
+
+        for (int id : ids)
+        {
+            Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::CREATED, id);
+        }
+        if (_logger)
+            _logger->debug("Successfully created " + std::to_string(ids.size()) + " flights");
+        return timer.complete(Success(std::move(ids)));
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error creating flights: " + std::string(e.what()));
+        return fail(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
 /**
  * @brief Cập nhật thông tin chuyến bay
  *
@@ -591,24 +816,18 @@ Result<Flight> FlightRepository::create(const Flight &flight)
  */
 Result<Flight> FlightRepository::update(const Flight &flight)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "update");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
             _logger->debug("Updating flight with id: " + std::to_string(flight.getId()));
 
-        // First check if flight exists
-        auto existsResult = exists(flight.getId());
-        if (!existsResult)
-        {
-            if (_logger)
-                _logger->error("Failed to check flight existence");
-            return Failure<Flight>(CoreError("Failed to check flight existence", "DB_ERROR"));
-        }
-        if (!existsResult.value())
+        // Only write the changed columns when the entity tracks its changes
+        if (flight.hasPartialChanges())
         {
-            if (_logger)
-                _logger->error("Flight not found with id: " + std::to_string(flight.getId()));
-            return Failure<Flight>(CoreError("Flight not found with id: " + std::to_string(flight.getId()), "DB_ERROR"));
+            return timer.complete(updateDirtyFields(flight));
         }
 
         // Start transaction
@@ -634,10 +853,11 @@ Result<Flight> FlightRepository::update(const Flight &flight)
         auto setArrivalTimeResult = _connection->setDateTime(stmtId, 8, flight.getSchedule().getArrival());
         auto setStatusResult = _connection->setString(stmtId, 9, flight.getStatusString());
         auto setIdResult = _connection->setInt(stmtId, 10, flight.getId());
+        auto setVersionResult = _connection->setInt(stmtId, 11, flight.getVersion());
 
         if (!setFlightNumberResult || !setDepartureCodeResult || !setDepartureNameResult ||
             !setArrivalCodeResult || !setArrivalNameResult || !setAircraftIdResult ||
-            !setDepartureTimeResult || !setArrivalTimeResult || !setStatusResult || !setIdResult)
+            !setDepartureTimeResult || !setArrivalTimeResult || !setStatusResult || !setIdResult || !setVersionResult)
         {
             _connection->freeStatement(stmtId);
             _connection->rollbackTransaction();
@@ -646,7 +866,7 @@ Result<Flight> FlightRepository::update(const Flight &flight)
             return Failure<Flight>(CoreError("Failed to set parameters", "PARAM_FAILED"));
         }
 
-        auto result = _connection->executeStatement(stmtId);
+        auto result = _connection->executeUpdate(stmtId);
         _connection->freeStatement(stmtId);
 
         if (!result)
@@ -657,11 +877,23 @@ Result<Flight> FlightRepository::update(const Flight &flight)
             return Failure<Flight>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
         }
 
+        auto versionCheck = checkVersionedUpdate(flight.getId(), result.value());
+        if (!versionCheck)
+        {
+            _connection->rollbackTransaction();
+            return Failure<Flight>(versionCheck.error());
+        }
+
         _connection->commitTransaction();
 
+        auto updatedFlight = flight;
+        updatedFlight.setVersion(flight.getVersion() + 1);
+        updatedFlight.clearDirty();
+
+        Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::UPDATED, flight.getId());
         if (_logger)
             _logger->debug("Successfully updated flight with id: " + std::to_string(flight.getId()));
-        return Success(flight);
+        return timer.complete(Success(updatedFlight));
     }
     catch (const std::exception &e)
     {
@@ -680,6 +912,10 @@ Result<Flight> FlightRepository::update(const Flight &flight)
  */
 Result<bool> FlightRepository::deleteById(const int &id)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "delete");
+    Metrics::OperationTimer timer(metrics);
+    _pageAnchors->clear();
+
     try
     {
         if (_logger)
@@ -773,9 +1009,10 @@ Result<bool> FlightRepository::deleteById(const int &id)
 
         _connection->commitTransaction();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::DELETED, id);
         if (_logger)
             _logger->debug("Successfully deleted flight with id: " + std::to_string(id));
-        return Success(true);
+        return timer.complete(Success(true));
     }
     catch (const std::exception &e)
     {
@@ -832,6 +1069,12 @@ Flight FlightRepository::mapRowToFlight(const std::map<std::string, std::string>
     auto flight = Flight::create(flightNumber, route, schedule, std::make_shared<Aircraft>(aircraft)).value();
     flight.setId(id);
     flight.setStatus(FlightStatusUtil::fromString(row.at(ColumnName[STATUS])));
+    auto versionIt = row.find(ColumnName[VERSION]);
+    if (versionIt != row.end())
+    {
+        flight.setVersion(std::stoi(versionIt->second));
+    }
+    flight.clearDirty();
     return flight;
 }
 
@@ -843,6 +1086,8 @@ Flight FlightRepository::mapRowToFlight(const std::map<std::string, std::string>
  */
 Result<Flight> FlightRepository::findByFlightNumber(const FlightNumber &number)
 {
+    Tracing::Span span("flight.find_by_flight_number", "repository");
+
     try
     {
         if (_logger)
@@ -895,6 +1140,7 @@ Result<Flight> FlightRepository::findByFlightNumber(const FlightNumber &number)
         auto departureTimeResult = dbResult->getDateTime(ColumnName[DEPARTURE_TIME]);
         auto arrivalTimeResult = dbResult->getDateTime(ColumnName[ARRIVAL_TIME]);
         auto statusResult = dbResult->getString(ColumnName[STATUS]);
+        auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
         // Get aircraft data
         auto serialNumberResult = dbResult->getString("serial_number");
@@ -905,7 +1151,7 @@ Result<Flight> FlightRepository::findByFlightNumber(const FlightNumber &number)
 
         if (!idResult || !flightNumberResult || !departureCodeResult || !departureNameResult ||
             !arrivalCodeResult || !arrivalNameResult || !aircraftIdResult ||
-            !departureTimeResult || !arrivalTimeResult || !statusResult ||
+            !departureTimeResult || !arrivalTimeResult || !statusResult || !versionResult ||
             !serialNumberResult || !modelResult || !economySeatsResult || !businessSeatsResult || !firstSeatsResult)
         {
             if (_logger)
@@ -954,6 +1200,8 @@ Result<Flight> FlightRepository::findByFlightNumber(const FlightNumber &number)
         auto flight = Flight::create(flightNumber, route, schedule, std::make_shared<Aircraft>(aircraft)).value();
         flight.setId(idResult.value());
         flight.setStatus(FlightStatusUtil::fromString(statusResult.value()));
+        flight.setVersion(versionResult.value());
+        flight.clearDirty();
 
         if (_logger)
             _logger->debug("Successfully found flight with flight number: " + number.toString());
@@ -1095,6 +1343,7 @@ Result<std::vector<Flight>> FlightRepository::findFlightByAircraft(const Aircraf
             auto departureTimeResult = dbResult->getDateTime(ColumnName[DEPARTURE_TIME]);
             auto arrivalTimeResult = dbResult->getDateTime(ColumnName[ARRIVAL_TIME]);
             auto statusResult = dbResult->getString(ColumnName[STATUS]);
+            auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
             // Get aircraft data
             auto serialNumberResult = dbResult->getString("serial_number");
@@ -1105,7 +1354,7 @@ Result<std::vector<Flight>> FlightRepository::findFlightByAircraft(const Aircraf
 
             if (!flightNumberResult || !departureCodeResult || !departureNameResult ||
                 !arrivalCodeResult || !arrivalNameResult || !aircraftIdResult ||
-                !departureTimeResult || !arrivalTimeResult || !statusResult ||
+                !departureTimeResult || !arrivalTimeResult || !statusResult || !versionResult ||
                 !serialNumberResult || !modelResult || !economySeatsResult || !businessSeatsResult || !firstSeatsResult)
             {
                 if (_logger)
@@ -1202,6 +1451,8 @@ Result<std::vector<Flight>> FlightRepository::findFlightByAircraft(const Aircraf
 
             flight->setId(idResult.value());
             flight->setStatus(FlightStatusUtil::fromString(statusResult.value()));
+            flight->setVersion(versionResult.value());
+            flight->clearDirty();
             flights.push_back(*flight);
         }
 
@@ -1302,6 +1553,9 @@ std::map<SeatNumber, bool> FlightRepository::getSeatAvailability(const Flight &f
  */
 Result<bool> FlightRepository::reserveSeat(const Flight &flight, const SeatNumber &seatNumber)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "reserve_seat");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
@@ -1404,7 +1658,7 @@ Result<bool> FlightRepository::reserveSeat(const Flight &flight, const SeatNumbe
 
         if (_logger)
             _logger->debug("Seat reservation successful");
-        return Success(true);
+        return timer.complete(Success(true));
     }
     catch (const std::exception &e)
     {
@@ -1423,6 +1677,9 @@ Result<bool> FlightRepository::reserveSeat(const Flight &flight, const SeatNumbe
  */
 Result<bool> FlightRepository::releaseSeat(const Flight &flight, const SeatNumber &seatNumber)
 {
+    static const Metrics::OperationMetrics metrics("repository", "flight", "release_seat");
+    Metrics::OperationTimer timer(metrics);
+
     try
     {
         if (_logger)
@@ -1469,7 +1726,7 @@ Result<bool> FlightRepository::releaseSeat(const Flight &flight, const SeatNumbe
         bool success = result.value() > 0;
         if (_logger)
             _logger->debug("Seat release " + std::string(success ? "successful" : "failed"));
-        return Success(success);
+        return timer.complete(Success(success));
     }
     catch (const std::exception &e)
     {
@@ -1694,4 +1951,500 @@ Result<bool> FlightRepository::isSeatAvailable(const Flight &flight, const SeatN
     }
 
     return Success(countResult.value() > 0);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Giải mã các hàng tóm tắt chuyến bay theo chỉ số cột và thêm vào cuối rows
+ */
+Result<size_t> FlightRepository::readSummaries(IDatabaseResult &result, std::vector<FlightSummaryRow> &rows)
+{
+    while (result.next().value())
+    {
+        auto idResult = result.getInt(SUMMARY_ID);
+        auto flightNumberResult = result.getString(SUMMARY_FLIGHT_NUMBER);
+        auto departureCodeResult = result.getString(SUMMARY_DEPARTURE_CODE);
+        auto departureNameResult = result.getString(SUMMARY_DEPARTURE_NAME);
+        auto arrivalCodeResult = result.getString(SUMMARY_ARRIVAL_CODE);
+        auto arrivalNameResult = result.getString(SUMMARY_ARRIVAL_NAME);
+        auto departureTimeResult = result.getDateTime(SUMMARY_DEPARTURE_TIME);
+        auto arrivalTimeResult = result.getDateTime(SUMMARY_ARRIVAL_TIME);
+        auto statusResult = result.getString(SUMMARY_STATUS);
+        auto serialNumberResult = result.getString(SUMMARY_SERIAL);
+        auto economySeatsResult = result.getInt(SUMMARY_ECONOMY_SEATS);
+        auto businessSeatsResult = result.getInt(SUMMARY_BUSINESS_SEATS);
+        auto firstSeatsResult = result.getInt(SUMMARY_FIRST_SEATS);
+
+        if (!idResult || !flightNumberResult || !departureCodeResult || !departureNameResult ||
+            !arrivalCodeResult || !arrivalNameResult || !departureTimeResult || !arrivalTimeResult ||
+            !statusResult || !serialNumberResult || !economySeatsResult || !businessSeatsResult || !firstSeatsResult)
+        {
+            if (_logger)
+                _logger->error("Failed to get flight summary data");
+            return Failure<size_t>(CoreError("Failed to get flight summary data", "DATA_ERROR"));
+        }
+
+        auto &row = rows.emplace_back();
+        row.id = idResult.value();
+        row.flightNumber = std::move(flightNumberResult.value());
+        row.departureCode = std::move(departureCodeResult.value());
+        row.departureName = std::move(departureNameResult.value());
+        row.arrivalCode = std::move(arrivalCodeResult.value());
+        row.arrivalName = std::move(arrivalNameResult.value());
+        row.departureTime = departureTimeResult.value();
+        row.arrivalTime = arrivalTimeResult.value();
+        row.status = FlightStatusUtil::fromString(statusResult.value());
+        row.aircraftSerial = std::move(serialNumberResult.value());
+        row.economySeats = economySeatsResult.value();
+        row.businessSeats = businessSeatsResult.value();
+        row.firstSeats = firstSeatsResult.value();
+    }
+    return Success(rows.size());
+}
+
+/**
+ * @brief Nạp một trang tóm tắt chuyến bay dạng phẳng, theo thứ tự id
+ *
+ * @param offset Số hàng bỏ qua
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> FlightRepository::findSummariesPage(size_t offset, size_t limit, std::vector<FlightSummaryRow> &rows)
+{
+    try
+    {
+        rows.clear();
+        auto result = executePageQuery(*_connection, FIND_SUMMARY_PAGE_QUERY, FIND_SUMMARIES_AFTER_QUERY,
+                                       *_pageAnchors, offset, limit);
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to load flight summary page: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        auto read = readSummaries(*result.value(), rows);
+        if (read && !rows.empty())
+            _pageAnchors->record(offset + rows.size(), rows.back().id);
+        return read;
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error loading flight summary page: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp trang tóm tắt chuyến bay tiếp theo theo khóa, theo thứ tự id
+ *
+ * @param afterId Id lớn nhất của trang trước
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> FlightRepository::findSummariesAfter(int afterId, size_t limit, std::vector<FlightSummaryRow> &rows)
+{
+    try
+    {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, FIND_SUMMARIES_AFTER_QUERY, afterId, limit);
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to load flight summaries after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readSummaries(*result.value(), rows);
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error loading flight summaries after id: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp tóm tắt chuyến bay theo danh sách id, theo thứ tự id
+ *
+ * @param ids Các id chuyến bay cần nạp
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> FlightRepository::findSummariesByIds(const std::vector<int> &ids, std::vector<FlightSummaryRow> &rows)
+{
+    try
+    {
+        rows.clear();
+        if (ids.empty())
+            return Success(size_t(0));
+        auto result = executeIdListQuery(*_connection, buildFindSummariesByIdsQuery(ids.size()), ids);
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to load flight summaries by ids: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readSummaries(*result.value(), rows);
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error loading flight summaries by ids: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<HighWaterMark> FlightRepository::readHighWaterMark()
+{
+    try
+    {
+        auto mark = executeHighWaterMarkQuery(*_connection, HIGH_WATER_MARK_QUERY);
+        if (!mark && _logger)
+            _logger->error("Failed to read flight high-water mark: " + mark.error().message);
+        return mark;
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error reading flight high-water mark: " + std::string(e.what()));
+        return Failure<HighWaterMark>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> FlightRepository::findVersionsAfter(int afterId, size_t limit, std::vector<RowVersion> &rows)
+{
+    try
+    {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, FIND_VERSIONS_AFTER_QUERY, afterId, limit);
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to load flight versions after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readRowVersions(*result.value(), false, rows);
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error loading flight versions: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp danh sách tóm tắt chuyến bay cho màn hình danh sách
+ *
+ * Truy vấn chỉ các cột hiển thị (kèm serial và số ghế của máy bay) và giải mã
+ * theo chỉ số cột thẳng vào vector đích. Không tạo value object, Aircraft hay
+ * bản đồ ghế. Lần nạp đầu tiên cấp phát trước theo COUNT(*), các lần sau tái
+ * sử dụng dung lượng sẵn có của vector.
+ *
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> FlightRepository::findAllSummaries(std::vector<FlightSummaryRow> &rows)
+{
+    try
+    {
+        if (_logger)
+            _logger->debug("Loading flight summaries");
+
+        rows.clear();
+        if (rows.capacity() == 0)
+        {
+            auto countResult = count();
+            if (countResult)
+                rows.reserve(countResult.value());
+        }
+
+        auto result = _connection->executeQuery(FIND_ALL_SUMMARY_QUERY);
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to execute query for loading flight summaries");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        auto decoded = readSummaries(*dbResult, rows);
+        if (!decoded) return decoded;
+
+        if (_logger)
+            _logger->debug("Loaded " + std::to_string(rows.size()) + " flight summaries");
+        return Success(rows.size());
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error loading flight summaries: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Cập nhật chỉ các cột của chuyến bay đã được đánh dấu thay đổi
+ *
+ * @param flight Chuyến bay có ít nhất một trường đã thay đổi
+ * @return Result<Flight> Chuyến bay đã cập nhật (không còn trường thay đổi) hoặc lỗi
+ */
+Result<Flight> FlightRepository::updateDirtyFields(const Flight &flight)
+{
+    std::vector<const char *> columns;
+    if (flight.isFieldDirty(Flight::FIELD_AIRCRAFT))
+    {
+        columns.push_back(ColumnName[AIRCRAFT_ID]);
+    }
+    if (flight.isFieldDirty(Flight::FIELD_SCHEDULE))
+    {
+        columns.push_back(ColumnName[DEPARTURE_TIME]);
+        columns.push_back(ColumnName[ARRIVAL_TIME]);
+    }
+    if (flight.isFieldDirty(Flight::FIELD_STATUS))
+    {
+        columns.push_back(ColumnName[STATUS]);
+    }
+
+    auto query = Tables::buildPartialUpdateQuery(NAME_TABLE, columns, ColumnName[ID], ColumnName[VERSION]);
+    if (_logger)
+        _logger->debug("Partial flight update: " + query);
+
+    auto prepareResult = _connection->prepareStatement(query);
+    if (!prepareResult)
+    {
+        if (_logger)
+            _logger->error("Failed to prepare statement for partial flight update");
+        return Failure<Flight>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    }
+    int stmtId = prepareResult.value();
+
+    int paramIndex = 1;
+    bool bound = true;
+    if (flight.isFieldDirty(Flight::FIELD_AIRCRAFT))
+    {
+        bound = bound && _connection->setInt(stmtId, paramIndex++, flight.getAircraft()->getId()).has_value();
+    }
+    if (flight.isFieldDirty(Flight::FIELD_SCHEDULE))
+    {
+        bound = bound && _connection->setDateTime(stmtId, paramIndex++, flight.getSchedule().getDeparture()).has_value();
+        bound = bound && _connection->setDateTime(stmtId, paramIndex++, flight.getSchedule().getArrival()).has_value();
+    }
+    if (flight.isFieldDirty(Flight::FIELD_STATUS))
+    {
+        bound = bound && _connection->setString(stmtId, paramIndex++, flight.getStatusString()).has_value();
+    }
+    bound = bound && _connection->setInt(stmtId, paramIndex++, flight.getId()).has_value();
+    bound = bound && _connection->setInt(stmtId, paramIndex, flight.getVersion()).has_value();
+
+    if (!bound)
+    {
+        _connection->freeStatement(stmtId);
+        if (_logger)
+            _logger->error("Failed to set parameters for partial flight update");
+        return Failure<Flight>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+    }
+
+    auto result = _connection->executeUpdate(stmtId);
+    _connection->freeStatement(stmtId);
+
+    if (!result)
+    {
+        if (_logger)
+            _logger->error("Failed to execute partial flight update");
+        return Failure<Flight>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+    }
+
+    auto versionCheck = checkVersionedUpdate(flight.getId(), result.value());
+    if (!versionCheck)
+    {
+        return Failure<Flight>(versionCheck.error());
+    }
+
+    auto updatedFlight = flight;
+    updatedFlight.setVersion(flight.getVersion() + 1);
+    updatedFlight.clearDirty();
+
+    Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::UPDATED, flight.getId());
+    if (_logger)
+        _logger->debug("Successfully updated " + std::to_string(columns.size()) + " column(s) of flight with id: " + std::to_string(flight.getId()));
+    return Success(updatedFlight);
+}
+
+/**
+ * @brief Lấy thông tin trạng thái tối thiểu của chuyến bay theo số hiệu
+ *
+ * Chỉ đọc id, trạng thái và giờ khởi hành, không JOIN bảng aircraft và không
+ * dựng entity Flight.
+ *
+ * @param number Số hiệu chuyến bay
+ * @return Result<FlightStatusRow> Thông tin trạng thái hoặc lỗi NOT_FOUND
+ */
+Result<FlightStatusRow> FlightRepository::findStatusRow(const FlightNumber &number)
+{
+    Tracing::Span span("flight.find_status_row", "repository");
+
+    try
+    {
+        if (_logger)
+            _logger->debug("Finding flight status by number: " + number.toString());
+
+        auto prepareResult = _connection->prepareStatement(FIND_STATUS_BY_NUMBER_QUERY);
+        if (!prepareResult)
+        {
+            if (_logger)
+                _logger->error("Failed to prepare statement for finding flight status");
+            return Failure<FlightStatusRow>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        auto setParamResult = _connection->setString(stmtId, 1, number.toString());
+        if (!setParamResult)
+        {
+            _connection->freeStatement(stmtId);
+            if (_logger)
+                _logger->error("Failed to set parameter for finding flight status");
+            return Failure<FlightStatusRow>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeQueryStatement(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to execute query for finding flight status");
+            return Failure<FlightStatusRow>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        if (!dbResult->next().value())
+        {
+            if (_logger)
+                _logger->warning("Flight not found with number: " + number.toString());
+            return Failure<FlightStatusRow>(CoreError("Flight not found with number: " + number.toString(), "NOT_FOUND"));
+        }
+
+        auto idResult = dbResult->getInt(0);
+        auto statusResult = dbResult->getString(1);
+        auto departureResult = dbResult->getDateTime(2);
+        auto versionResult = dbResult->getInt(3);
+        if (!idResult || !statusResult || !departureResult || !versionResult)
+        {
+            if (_logger)
+                _logger->error("Failed to get flight status data");
+            return Failure<FlightStatusRow>(CoreError("Failed to get flight status data", "DATA_ERROR"));
+        }
+
+        FlightStatusRow row;
+        row.id = idResult.value();
+        row.status = FlightStatusUtil::fromString(statusResult.value());
+        row.departureTime = departureResult.value();
+        row.version = versionResult.value();
+        return Success(row);
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error finding flight status: " + std::string(e.what()));
+        return Failure<FlightStatusRow>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Ghi trực tiếp trạng thái mới cho chuyến bay nếu phiên bản chưa thay đổi
+ *
+ * @param id ID chuyến bay
+ * @param status Trạng thái mới
+ * @param expectedVersion Phiên bản đã đọc trước đó (FlightStatusRow::version)
+ * @return Result<bool> True nếu cập nhật thành công, lỗi VERSION_CONFLICT nếu chuyến bay đã bị thay đổi
+ */
+Result<bool> FlightRepository::updateStatus(int id, FlightStatus status, int expectedVersion)
+{
+    Tracing::Span span("flight.update_status", "repository");
+
+    try
+    {
+        if (_logger)
+            _logger->debug("Updating status of flight " + std::to_string(id) + " to " + FlightStatusUtil::toString(status));
+
+        auto prepareResult = _connection->prepareStatement(UPDATE_STATUS_QUERY);
+        if (!prepareResult)
+        {
+            if (_logger)
+                _logger->error("Failed to prepare statement for updating flight status");
+            return Failure<bool>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        auto setStatusResult = _connection->setString(stmtId, 1, FlightStatusUtil::toString(status));
+        auto setIdResult = _connection->setInt(stmtId, 2, id);
+        auto setVersionResult = _connection->setInt(stmtId, 3, expectedVersion);
+        if (!setStatusResult || !setIdResult || !setVersionResult)
+        {
+            _connection->freeStatement(stmtId);
+            if (_logger)
+                _logger->error("Failed to set parameters for updating flight status");
+            return Failure<bool>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeUpdate(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result)
+        {
+            if (_logger)
+                _logger->error("Failed to execute statement for updating flight status");
+            return Failure<bool>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+        }
+
+        auto versionCheck = checkVersionedUpdate(id, result.value());
+        if (versionCheck)
+            Changes::Feed::getInstance()->publish(Changes::Entity::FLIGHT, Changes::Kind::UPDATED, id);
+        return versionCheck;
+    }
+    catch (const std::exception &e)
+    {
+        if (_logger)
+            _logger->error("Error updating flight status: " + std::string(e.what()));
+        return Failure<bool>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Kiểm tra kết quả của một UPDATE có điều kiện theo phiên bản
+ *
+ * Chỉ khi không có hàng nào bị ảnh hưởng mới đọc thêm để phân biệt chuyến bay
+ * không tồn tại với chuyến bay đã bị phiên khác thay đổi.
+ *
+ * @param id ID chuyến bay vừa cập nhật
+ * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+ * @return Result<bool> True nếu có hàng được cập nhật, lỗi VERSION_CONFLICT hoặc không tìm thấy
+ */
+Result<bool> FlightRepository::checkVersionedUpdate(const int &id, int affectedRows)
+{
+    if (affectedRows > 0)
+    {
+        return Success(true);
+    }
+
+    auto existsResult = exists(id);
+    if (!existsResult)
+    {
+        if (_logger)
+            _logger->error("Failed to check flight existence");
+        return Failure<bool>(CoreError("Failed to check flight existence", "DB_ERROR"));
+    }
+    if (!existsResult.value())
+    {
+        if (_logger)
+            _logger->error("Flight not found with id: " + std::to_string(id));
+        return Failure<bool>(CoreError("Flight not found with id: " + std::to_string(id), "DB_ERROR"));
+    }
+
+    if (_logger)
+        _logger->warning("Flight " + std::to_string(id) + " was modified concurrently");
+    return Failure<bool>(CoreError("Flight was modified by another session", "VERSION_CONFLICT"));
+}
@@ -6,9 +6,29 @@
 #include "../../utils/Logger.h"
 #include "../../utils/TableConstants.h"
 #include "../../database/InterfaceDatabaseConnection.h"
+#include "../PageQuery.h"
+#include "../ReadModels.h"
+#include <ctime>
 #include <memory>
+#include <string>
 #include <vector>
 
+/**
+ * @brief Chuyến bay mới đã được kiểm tra, đầu vào của FlightRepository::createBatch
+ * @note Không dùng entity Flight vì entity dựng bản đồ ghế cho từng chuyến bay khi được tạo
+ */
+struct FlightInsertRow {
+    std::string flightNumber;
+    std::string departureCode;
+    std::string departureName;
+    std::string arrivalCode;
+    std::string arrivalName;
+    std::tm departureTime{};
+    std::tm arrivalTime{};
+    FlightStatus status = FlightStatus::SCHEDULED;
+    std::shared_ptr<const Aircraft> aircraft;   ///< Cho aircraft_id và sơ đồ ghế của flight_seat_availability
+};
+
 /**
  * @brief Lớp repository để quản lý các thao tác cơ sở dữ liệu cho thực thể Flight
  * 
@@ -17,9 +37,14 @@
  * truy vấn đặc biệt cho chuyến bay.
  */
 class FlightRepository : public IRepository<Flight> {
+public:
+    /// Số ghế tối đa của một câu INSERT vào flight_seat_availability
+    static constexpr size_t SEAT_ROWS_PER_STATEMENT = 2000;
+
 private:
     std::shared_ptr<IDatabaseConnection> _connection; ///< Kết nối cơ sở dữ liệu
     std::shared_ptr<Logger> _logger; ///< Logger để ghi log
+    std::shared_ptr<PageAnchors> _pageAnchors = std::make_shared<PageAnchors>(); ///< Mốc để trang kế tiếp nạp theo khóa
 
     /**
      * @brief Ánh xạ một hàng dữ liệu từ cơ sở dữ liệu thành đối tượng Flight
@@ -35,6 +60,26 @@ private:
      */
     std::map<SeatNumber, bool> getSeatAvailability(const Flight& flight) const;
 
+    /**
+     * @brief Giải mã tập kết quả tóm tắt chuyến bay vào cuối rows
+     */
+    Result<size_t> readSummaries(IDatabaseResult& result, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Cập nhật chỉ các cột đã thay đổi của chuyến bay
+     * @param flight Chuyến bay có ít nhất một trường đã được đánh dấu thay đổi
+     * @return Result chứa chuyến bay đã cập nhật hoặc lỗi nếu thất bại
+     */
+    Result<Flight> updateDirtyFields(const Flight& flight);
+
+    /**
+     * @brief Kiểm tra UPDATE có điều kiện theo phiên bản đã cập nhật được hàng
+     * @param id ID chuyến bay vừa cập nhật
+     * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+     * @return Result chứa true nếu thành công, lỗi VERSION_CONFLICT nếu chuyến bay đã bị thay đổi
+     */
+    Result<bool> checkVersionedUpdate(const int& id, int affectedRows);
+
 public:
     /**
      * @brief Constructor tạo FlightRepository với kết nối cơ sở dữ liệu và logger
@@ -81,6 +126,15 @@ public:
      * @return Result chứa đối tượng Flight đã được tạo (có ID) nếu thành công, hoặc lỗi nếu thất bại
      */
     Result<Flight> create(const Flight& flight) override;
+
+    /**
+     * @brief Chèn nhiều chuyến bay cùng ghế trống của chúng trong một transaction
+     * @param rows Các chuyến bay cần tạo; số hiệu và lịch trình phải đã được kiểm tra
+     * @return Result chứa id của từng chuyến bay theo thứ tự rows, hoặc lỗi nếu thất bại
+     * @note Chuyến bay được chèn bằng một câu INSERT nhiều hàng, ghế theo từng lô SEAT_ROWS_PER_STATEMENT;
+     *       mọi thay đổi bị rollback nếu một bước thất bại. Không kiểm tra trùng số hiệu
+     */
+    Result<std::vector<int>> createBatch(const std::vector<FlightInsertRow>& rows);
     
     /**
      * @brief Cập nhật thông tin chuyến bay trong cơ sở dữ liệu
@@ -158,6 +212,80 @@ public:
      * @return Result chứa bool (true nếu ghế còn trống) hoặc lỗi nếu thất bại
      */
     Result<bool> isSeatAvailable(const Flight& flight, const SeatNumber& seatNumber);
+
+    // Phương thức projection cho màn hình danh sách
+
+    /**
+     * @brief Nạp danh sách tóm tắt chuyến bay cho màn hình danh sách
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng để tái sử dụng giữa các lần làm mới
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Chỉ truy vấn các cột cần hiển thị và không dựng entity Flight/Aircraft
+     */
+    Result<size_t> findAllSummaries(std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Nạp một trang tóm tắt chuyến bay, theo thứ tự id
+     * @param offset Số hàng bỏ qua
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Số ghế đã đặt không được điền; xem FlightService::getFlightSummariesPage
+     * @note Trang đầu và trang ngay sau trang vừa nạp đi theo khóa; chỉ nhảy cóc mới dùng OFFSET
+     */
+    Result<size_t> findSummariesPage(size_t offset, size_t limit, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Nạp trang tóm tắt chuyến bay tiếp theo theo khóa: các hàng có id lớn hơn afterId, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Dùng để đi qua cả bảng mà không phải bỏ qua lại các hàng đầu như OFFSET
+     */
+    Result<size_t> findSummariesAfter(int afterId, size_t limit, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Nạp tóm tắt chuyến bay theo danh sách id bằng một truy vấn, theo thứ tự id
+     * @param ids Các id cần nạp; nên nhỏ (một câu lệnh IN)
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Id không tồn tại đơn giản là không có trong kết quả; số ghế đã đặt không được điền
+     */
+    Result<size_t> findSummariesByIds(const std::vector<int>& ids, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Đọc dấu mực nước cao của bảng chuyến bay (số hàng, id lớn nhất, tổng version)
+     * @return Result chứa dấu, hoặc lỗi nếu thất bại
+     * @note Một truy vấn gộp trả về một hàng; dùng để biết bản sao cục bộ còn khớp với bảng không
+     */
+    Result<HighWaterMark> readHighWaterMark();
+
+    /**
+     * @brief Nạp trang kế tiếp (id, version) của chuyến bay theo khóa, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     */
+    Result<size_t> findVersionsAfter(int afterId, size_t limit, std::vector<RowVersion>& rows);
+
+    // Phương thức chuyển trạng thái trực tiếp
+
+    /**
+     * @brief Lấy thông tin trạng thái tối thiểu của chuyến bay (id, trạng thái, giờ khởi hành)
+     * @param number Số hiệu chuyến bay
+     * @return Result chứa FlightStatusRow hoặc lỗi NOT_FOUND nếu không tồn tại
+     */
+    Result<FlightStatusRow> findStatusRow(const FlightNumber& number);
+
+    /**
+     * @brief Ghi trạng thái mới cho chuyến bay bằng một câu lệnh UPDATE có điều kiện theo phiên bản
+     * @param id ID chuyến bay
+     * @param status Trạng thái mới
+     * @param expectedVersion Phiên bản đã đọc trước đó
+     * @return Result chứa true nếu thành công, lỗi VERSION_CONFLICT nếu chuyến bay đã bị thay đổi
+     */
+    Result<bool> updateStatus(int id, FlightStatus status, int expectedVersion);
 };
 
 #endif // FLIGHT_REPOSITORY_H
\ No newline at end of file
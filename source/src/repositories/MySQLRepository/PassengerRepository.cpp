@@ -1,7 +1,11 @@
 #include "PassengerRepository.h"
+#include "../PageQuery.h"
 #include "../../core/exceptions/Result.h"
 #include "../../utils/Logger.h"
 #include "../../utils/TableConstants.h"
+#include "../../utils/ChangeFeed.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracing.h"
 #include <sstream>
 #include <map>
 
@@ -17,6 +21,9 @@ using namespace Tables::Passenger;
  * @return Result<Passenger> Kết quả chứa đối tượng Passenger hoặc lỗi
  */
 Result<Passenger> PassengerRepository::findById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "find_by_id");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding passenger by id: " + std::to_string(id));
 
@@ -54,8 +61,9 @@ Result<Passenger> PassengerRepository::findById(const int& id) {
         auto emailResult = dbResult->getString(ColumnName[EMAIL]);
         auto phoneResult = dbResult->getString(ColumnName[PHONE]);
         auto addressResult = dbResult->getString(ColumnName[ADDRESS]);
+        auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
-        if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult) {
+        if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult || !versionResult) {
             if (_logger) _logger->error("Failed to get passenger data for id: " + std::to_string(id));
             return Failure<Passenger>(CoreError("Failed to get passenger data", "DATA_ERROR"));
         }
@@ -71,9 +79,11 @@ Result<Passenger> PassengerRepository::findById(const int& id) {
         auto contactInfo = ContactInfo::create(contactInfoStr.str()).value();
         auto passenger = Passenger::create(nameResult.value(), contactInfo, passport).value();
         passenger.setId(idResult.value());
+        passenger.setVersion(versionResult.value());
+        passenger.clearDirty();
 
         if (_logger) _logger->debug("Successfully found passenger with id: " + std::to_string(id));
-        return Success(passenger);
+        return timer.complete(Success(passenger));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding passenger by id: " + std::string(e.what()));
         return Failure<Passenger>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -89,6 +99,9 @@ Result<Passenger> PassengerRepository::findById(const int& id) {
  * @return Result<std::vector<Passenger>> Vector chứa tất cả hành khách hoặc lỗi
  */
 Result<std::vector<Passenger>> PassengerRepository::findAll() {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "find_all");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding all passengers");
 
@@ -110,8 +123,9 @@ Result<std::vector<Passenger>> PassengerRepository::findAll() {
             auto emailResult = dbResult->getString(ColumnName[EMAIL]);
             auto phoneResult = dbResult->getString(ColumnName[PHONE]);
             auto addressResult = dbResult->getString(ColumnName[ADDRESS]);
+            auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
-            if (!passportResult || !nameResult || !emailResult || !phoneResult || !addressResult) {
+            if (!passportResult || !nameResult || !emailResult || !phoneResult || !addressResult || !versionResult) {
                 if (_logger) _logger->warning("Skipping invalid passenger data");
                 continue;
             }
@@ -142,11 +156,13 @@ Result<std::vector<Passenger>> PassengerRepository::findAll() {
             }
 
             passenger->setId(idResult.value());
+            passenger->setVersion(versionResult.value());
+            passenger->clearDirty();
             passengers.push_back(*passenger);
         }
 
         if (_logger) _logger->debug("Successfully found " + std::to_string(passengers.size()) + " passengers");
-        return Success(passengers);
+        return timer.complete(Success(passengers));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding all passengers: " + std::string(e.what()));
         return Failure<std::vector<Passenger>>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -212,6 +228,8 @@ Result<bool> PassengerRepository::exists(const int& id) {
  * @return Result<size_t> Số lượng hành khách hoặc lỗi
  */
 Result<size_t> PassengerRepository::count() {
+    // Danh sách làm mới luôn đếm trước: mốc trang của lượt trước có thể đã lệch
+    _pageAnchors->clear();
     try {
         if (_logger) _logger->debug("Counting total passengers");
 
@@ -252,6 +270,9 @@ Result<size_t> PassengerRepository::count() {
  * @return Result<Passenger> Hành khách đã được tạo với ID hoặc lỗi
  */
 Result<Passenger> PassengerRepository::create(const Passenger& passenger) {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "create");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Creating new passenger");
 
@@ -304,8 +325,10 @@ Result<Passenger> PassengerRepository::create(const Passenger& passenger) {
 
         auto newPassenger = passenger;
         newPassenger.setId(idResult.value());
+        newPassenger.clearDirty();
+        Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::CREATED, newPassenger.getId());
         if (_logger) _logger->debug("Successfully created passenger with id: " + std::to_string(idResult.value()));
-        return Success(newPassenger);
+        return timer.complete(Success(newPassenger));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error creating passenger: " + std::string(e.what()));
@@ -313,6 +336,100 @@ Result<Passenger> PassengerRepository::create(const Passenger& passenger) {
     }
 }
 
+/**
+ * @brief Tạo nhiều hành khách trong một transaction
+ *
+ * Với INSERT đơn giản InnoDB cấp các giá trị AUTO_INCREMENT liên tiếp nên ID của hành khách
+ * thứ i là LAST_INSERT_ID() + i.
+ *
+ * @param passengers Các hành khách cần tạo
+ * @return Result<std::vector<Passenger>> Các hành khách đã tạo hoặc lỗi
+ */
+Result<std::vector<Passenger>> PassengerRepository::createBatch(const std::vector<Passenger>& passengers) {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "create_batch");
+    Metrics::OperationTimer timer(metrics);
+
+    if (passengers.empty()) {
+        return timer.complete(Success(std::vector<Passenger>{}));
+    }
+
+    if (_logger) _logger->debug("Creating " + std::to_string(passengers.size()) + " passengers");
+
+    auto beginResult = _connection->beginTransaction();
+    if (!beginResult) {
+        if (_logger) _logger->error("Failed to begin transaction for creating passengers");
+        return Failure<std::vector<Passenger>>(beginResult.error());
+    }
+
+    auto fail = [this](const CoreError& error) {
+        _connection->rollbackTransaction();
+        return Failure<std::vector<Passenger>>(error);
+    };
+
+    try {
+        auto prepareResult = _connection->prepareStatement(buildBatchInsertQuery(passengers.size()));
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for creating passengers");
+            return fail(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        bool paramsOk = true;
+        for (size_t i = 0; i < passengers.size() && paramsOk; ++i) {
+            const auto& passenger = passengers[i];
+            const auto& contact = passenger.getContactInfo();
+            const int base = static_cast<int>(i * INSERT_COLUMN_COUNT);
+            paramsOk = _connection->setString(stmtId, base + 1, passenger.getPassport().toString()) &&
+                       _connection->setString(stmtId, base + 2, passenger.getName()) &&
+                       _connection->setString(stmtId, base + 3, contact.getEmail()) &&
+                       _connection->setString(stmtId, base + 4, contact.getPhone()) &&
+                       _connection->setString(stmtId, base + 5, contact.getAddress());
+        }
+        if (!paramsOk) {
+            _connection->freeStatement(stmtId);
+            if (_logger) _logger->error("Failed to set parameters for creating passengers");
+            return fail(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeStatement(stmtId);
+        _connection->freeStatement(stmtId);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute statement for creating passengers");
+            return fail(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+        }
+
+        auto firstIdResult = _connection->getLastInsertId();
+        if (!firstIdResult) {
+            if (_logger) _logger->error("Failed to get last insert id for passengers");
+            return fail(CoreError("Failed to get last insert id", "GET_ID_FAILED"));
+        }
+
+        auto commitResult = _connection->commitTransaction();
+        if (!commitResult) {
+            if (_logger) _logger->error("Failed to commit transaction for creating passengers");
+            return fail(commitResult.error());
+        }
+
+        std::vector<Passenger> created;
+        created.reserve(passengers.size());
+        for (size_t i = 0; i < passengers.size(); ++i) {
+            auto passenger = passengers[i];
+            passenger.setId(firstIdResult.value() + static_cast<int>(i));
+            passenger.clearDirty();
+            created.push_back(std::move(passenger));
+        }
+
+        for (const auto& passenger : created) {
+            Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::CREATED, passenger.getId());
+        }
+        if (_logger) _logger->debug("Successfully created " + std::to_string(created.size()) + " passengers");
+        return timer.complete(Success(std::move(created)));
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error creating passengers: " + std::string(e.what()));
+        return fail(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
 /**
  * @brief Cập nhật thông tin hành khách trong cơ sở dữ liệu
  * 
@@ -320,18 +437,15 @@ Result<Passenger> PassengerRepository::create(const Passenger& passenger) {
  * @return Result<Passenger> Hành khách đã được cập nhật hoặc lỗi
  */
 Result<Passenger> PassengerRepository::update(const Passenger& passenger) {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "update");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Updating passenger with id: " + std::to_string(passenger.getId()));
 
-        // First check if passenger exists
-        auto existsResult = exists(passenger.getId());
-        if (!existsResult) {
-            if (_logger) _logger->error("Failed to check passenger existence");
-            return Failure<Passenger>(CoreError("Failed to check passenger existence", "DB_ERROR"));
-        }
-        if (!existsResult.value()) {
-            if (_logger) _logger->error("Passenger not found with id: " + std::to_string(passenger.getId()));
-            return Failure<Passenger>(CoreError("Passenger not found with id: " + std::to_string(passenger.getId()), "DB_ERROR"));
+        // Only write the changed columns when the entity tracks its changes
+        if (passenger.hasPartialChanges()) {
+            return timer.complete(updateDirtyFields(passenger));
         }
 
         // Start transaction
@@ -356,15 +470,16 @@ Result<Passenger> PassengerRepository::update(const Passenger& passenger) {
         auto setPhoneResult = _connection->setString(stmtId, 4, phone);
         auto setAddressResult = _connection->setString(stmtId, 5, address);
         auto setIdResult = _connection->setInt(stmtId, 6, passenger.getId());
+        auto setVersionResult = _connection->setInt(stmtId, 7, passenger.getVersion());
 
-        if (!setPassportResult || !setNameResult || !setEmailResult || !setPhoneResult || !setAddressResult || !setIdResult) {
+        if (!setPassportResult || !setNameResult || !setEmailResult || !setPhoneResult || !setAddressResult || !setIdResult || !setVersionResult) {
             _connection->freeStatement(stmtId);
             _connection->rollbackTransaction();
             if (_logger) _logger->error("Failed to set parameters for updating passenger");
             return Failure<Passenger>(CoreError("Failed to set parameters", "PARAM_FAILED"));
         }
 
-        auto result = _connection->executeStatement(stmtId);
+        auto result = _connection->executeUpdate(stmtId);
         _connection->freeStatement(stmtId);
 
         if (!result) {
@@ -373,10 +488,21 @@ Result<Passenger> PassengerRepository::update(const Passenger& passenger) {
             return Failure<Passenger>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
         }
 
+        auto versionCheck = checkVersionedUpdate(passenger.getId(), result.value());
+        if (!versionCheck) {
+            _connection->rollbackTransaction();
+            return Failure<Passenger>(versionCheck.error());
+        }
+
         _connection->commitTransaction();
 
+        auto updatedPassenger = passenger;
+        updatedPassenger.setVersion(passenger.getVersion() + 1);
+        updatedPassenger.clearDirty();
+
+        Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::UPDATED, passenger.getId());
         if (_logger) _logger->debug("Successfully updated passenger with id: " + std::to_string(passenger.getId()));
-        return Success(passenger);
+        return timer.complete(Success(updatedPassenger));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error updating passenger: " + std::string(e.what()));
@@ -391,6 +517,10 @@ Result<Passenger> PassengerRepository::update(const Passenger& passenger) {
  * @return Result<bool> True nếu xóa thành công hoặc lỗi
  */
 Result<bool> PassengerRepository::deleteById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "passenger", "delete");
+    Metrics::OperationTimer timer(metrics);
+    _pageAnchors->clear();
+
     try {
         if (_logger) _logger->debug("Deleting passenger with id: " + std::to_string(id));
 
@@ -436,8 +566,9 @@ Result<bool> PassengerRepository::deleteById(const int& id) {
 
         _connection->commitTransaction();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::DELETED, id);
         if (_logger) _logger->debug("Successfully deleted passenger with id: " + std::to_string(id));
-        return Success(true);
+        return timer.complete(Success(true));
     } catch (const std::exception& e) {
         _connection->rollbackTransaction();
         if (_logger) _logger->error("Error deleting passenger: " + std::string(e.what()));
@@ -452,6 +583,8 @@ Result<bool> PassengerRepository::deleteById(const int& id) {
  * @return Result<Passenger> Hành khách tìm được hoặc lỗi
  */
 Result<Passenger> PassengerRepository::findByPassportNumber(const PassportNumber& passport) {
+    Tracing::Span span("passenger.find_by_passport_number", "repository");
+
     try {
         if (_logger) _logger->debug("Finding passenger by passport number: " + passport.toString());
 
@@ -489,8 +622,9 @@ Result<Passenger> PassengerRepository::findByPassportNumber(const PassportNumber
         auto emailResult = dbResult->getString(ColumnName[EMAIL]);
         auto phoneResult = dbResult->getString(ColumnName[PHONE]);
         auto addressResult = dbResult->getString(ColumnName[ADDRESS]);
+        auto versionResult = dbResult->getInt(ColumnName[VERSION]);
 
-        if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult) {
+        if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult || !versionResult) {
             if (_logger) _logger->error("Failed to get passenger data for passport number: " + passport.toString());
             return Failure<Passenger>(CoreError("Failed to get passenger data", "DATA_ERROR"));
         }
@@ -506,6 +640,8 @@ Result<Passenger> PassengerRepository::findByPassportNumber(const PassportNumber
         auto contactInfo = ContactInfo::create(contactInfoStr.str()).value();
         auto passenger = Passenger::create(nameResult.value(), contactInfo, passport).value();
         passenger.setId(idResult.value());
+        passenger.setVersion(versionResult.value());
+        passenger.clearDirty();
 
         if (_logger) _logger->debug("Successfully found passenger with passport number: " + passport.toString());
         return Success(passenger);
@@ -515,6 +651,89 @@ Result<Passenger> PassengerRepository::findByPassportNumber(const PassportNumber
     }
 }
 
+/**
+ * @brief Tìm nhiều hành khách theo số hộ chiếu
+ *
+ * Dùng một câu SELECT ... IN (...) thay vì gọi findByPassportNumber cho từng người.
+ *
+ * @param passports Danh sách số hộ chiếu cần tìm
+ * @return Result<std::vector<Passenger>> Các hành khách tìm thấy hoặc lỗi
+ */
+Result<std::vector<Passenger>> PassengerRepository::findByPassportNumbers(const std::vector<PassportNumber>& passports) {
+    Tracing::Span span("passenger.find_by_passport_numbers", "repository");
+
+    try {
+        if (_logger) _logger->debug("Finding " + std::to_string(passports.size()) + " passengers by passport number");
+
+        std::vector<Passenger> passengers;
+        if (passports.empty()) {
+            return Success(passengers);
+        }
+
+        auto prepareResult = _connection->prepareStatement(buildFindByPassportsQuery(passports.size()));
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for finding passengers by passport numbers");
+            return Failure<std::vector<Passenger>>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        for (size_t i = 0; i < passports.size(); ++i) {
+            auto setParamResult = _connection->setString(stmtId, static_cast<int>(i) + 1, passports[i].toString());
+            if (!setParamResult) {
+                _connection->freeStatement(stmtId);
+                if (_logger) _logger->error("Failed to set parameter for finding passengers by passport numbers");
+                return Failure<std::vector<Passenger>>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+            }
+        }
+
+        auto result = _connection->executeQueryStatement(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for finding passengers by passport numbers");
+            return Failure<std::vector<Passenger>>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        passengers.reserve(passports.size());
+
+        while (dbResult->next().value()) {
+            auto idResult = dbResult->getInt(ID);
+            auto passportResult = dbResult->getString(PASSPORT_NUMBER);
+            auto nameResult = dbResult->getString(NAME);
+            auto emailResult = dbResult->getString(EMAIL);
+            auto phoneResult = dbResult->getString(PHONE);
+            auto addressResult = dbResult->getString(ADDRESS);
+            auto versionResult = dbResult->getInt(VERSION);
+
+            if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult || !versionResult) {
+                if (_logger) _logger->error("Failed to get passenger data");
+                return Failure<std::vector<Passenger>>(CoreError("Failed to get passenger data", "DATA_ERROR"));
+            }
+
+            std::stringstream contactInfoStr;
+            contactInfoStr << emailResult.value() << "|" << phoneResult.value();
+            if (!addressResult.value().empty()) {
+                contactInfoStr << "|" << addressResult.value();
+            }
+
+            auto passport = PassportNumber::create(passportResult.value()).value();
+            auto contactInfo = ContactInfo::create(contactInfoStr.str()).value();
+            auto passenger = Passenger::create(nameResult.value(), contactInfo, passport).value();
+            passenger.setId(idResult.value());
+            passenger.setVersion(versionResult.value());
+            passenger.clearDirty();
+            passengers.push_back(std::move(passenger));
+        }
+
+        if (_logger) _logger->debug("Successfully found " + std::to_string(passengers.size()) + " passengers by passport number");
+        return Success(passengers);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error finding passengers by passport numbers: " + std::string(e.what()));
+        return Failure<std::vector<Passenger>>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
 /**
  * @brief Kiểm tra sự tồn tại của hành khách theo số hộ chiếu
  * 
@@ -575,16 +794,17 @@ Result<bool> PassengerRepository::existsPassport(const PassportNumber& passport)
  * @return Result<bool> True nếu xóa thành công hoặc lỗi
  */
 Result<bool> PassengerRepository::deleteByPassportNumber(const PassportNumber& passport) {
+    _pageAnchors->clear();
     try {
         if (_logger) _logger->debug("Deleting passenger with passport: " + passport.toString());
 
-        // First check if passenger exists
-        auto existsResult = existsPassport(passport);
-        if (!existsResult) {
-            if (_logger) _logger->error("Failed to check passenger existence");
-            return Failure<bool>(CoreError("Failed to check passenger existence", "DB_ERROR"));
-        }
-        if (!existsResult.value()) {
+        // First check if passenger exists; the id is needed for the change event
+        auto existingResult = findByPassportNumber(passport);
+        if (!existingResult) {
+            if (existingResult.error().code != "NOT_FOUND") {
+                if (_logger) _logger->error("Failed to check passenger existence");
+                return Failure<bool>(CoreError("Failed to check passenger existence", "DB_ERROR"));
+            }
             if (_logger) _logger->error("Passenger not found with passport: " + passport.toString());
             return Failure<bool>(CoreError("Passenger not found with passport: " + passport.toString(), "DB_ERROR"));
         }
@@ -620,6 +840,7 @@ Result<bool> PassengerRepository::deleteByPassportNumber(const PassportNumber& p
 
         _connection->commitTransaction();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::DELETED, existingResult.value().getId());
         if (_logger) _logger->debug("Successfully deleted passenger with passport: " + passport.toString());
         return Success(true);
     } catch (const std::exception& e) {
@@ -627,4 +848,228 @@ Result<bool> PassengerRepository::deleteByPassportNumber(const PassportNumber& p
         if (_logger) _logger->error("Error deleting passenger: " + std::string(e.what()));
         return Failure<bool>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Giải mã các hàng hành khách theo chỉ số cột và thêm vào cuối rows
+ */
+Result<size_t> PassengerRepository::readListRows(IDatabaseResult& result, std::vector<PassengerListRow>& rows) {
+    while (result.next().value()) {
+        auto idResult = result.getInt(ID);
+        auto passportResult = result.getString(PASSPORT_NUMBER);
+        auto nameResult = result.getString(NAME);
+        auto emailResult = result.getString(EMAIL);
+        auto phoneResult = result.getString(PHONE);
+        auto addressResult = result.getString(ADDRESS);
+
+        if (!idResult || !passportResult || !nameResult || !emailResult || !phoneResult || !addressResult) {
+            if (_logger) _logger->error("Failed to get passenger list row data");
+            return Failure<size_t>(CoreError("Failed to get passenger list row data", "DATA_ERROR"));
+        }
+
+        auto& row = rows.emplace_back();
+        row.id = idResult.value();
+        row.passportNumber = std::move(passportResult.value());
+        row.name = std::move(nameResult.value());
+        row.email = std::move(emailResult.value());
+        row.phone = std::move(phoneResult.value());
+        row.address = std::move(addressResult.value());
+    }
+    return Success(rows.size());
+}
+
+/**
+ * @brief Nạp một trang hành khách dạng phẳng, theo thứ tự id
+ *
+ * @param offset Số hàng bỏ qua
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> PassengerRepository::findListRowsPage(size_t offset, size_t limit, std::vector<PassengerListRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executePageQuery(*_connection, FIND_LIST_ROW_PAGE_QUERY, FIND_LIST_ROWS_AFTER_QUERY,
+                                       *_pageAnchors, offset, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load passenger page: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        auto read = readListRows(*result.value(), rows);
+        if (read && !rows.empty()) _pageAnchors->record(offset + rows.size(), rows.back().id);
+        return read;
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading passenger page: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp trang hành khách dạng phẳng tiếp theo theo khóa, theo thứ tự id
+ *
+ * @param afterId Id lớn nhất của trang trước
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> PassengerRepository::findListRowsAfter(int afterId, size_t limit, std::vector<PassengerListRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, FIND_LIST_ROWS_AFTER_QUERY, afterId, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load passengers after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readListRows(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading passengers after id: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp hành khách dạng phẳng theo danh sách id, theo thứ tự id
+ *
+ * @param ids Các id cần nạp
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> PassengerRepository::findListRowsByIds(const std::vector<int>& ids, std::vector<PassengerListRow>& rows) {
+    try {
+        rows.clear();
+        if (ids.empty()) return Success(size_t(0));
+        auto result = executeIdListQuery(*_connection, buildFindListRowsByIdsQuery(ids.size()), ids);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load passengers by ids: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readListRows(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading passengers by ids: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp danh sách hành khách dạng phẳng cho màn hình danh sách
+ * 
+ * Giải mã theo chỉ số cột thẳng vào vector đích mà không qua bước validate
+ * của các value object.
+ * 
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> PassengerRepository::findAllListRows(std::vector<PassengerListRow>& rows) {
+    try {
+        if (_logger) _logger->debug("Loading passenger list rows");
+
+        rows.clear();
+        if (rows.capacity() == 0) {
+            auto countResult = count();
+            if (countResult) rows.reserve(countResult.value());
+        }
+
+        auto result = _connection->executeQuery(FIND_ALL_LIST_ROW_QUERY);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for loading passenger list rows");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        auto decoded = readListRows(*dbResult, rows);
+        if (!decoded) return decoded;
+
+        if (_logger) _logger->debug("Loaded " + std::to_string(rows.size()) + " passenger list rows");
+        return Success(rows.size());
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading passenger list rows: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Cập nhật chỉ các cột của hành khách đã được đánh dấu thay đổi
+ * 
+ * @param passenger Hành khách có ít nhất một trường đã thay đổi
+ * @return Result<Passenger> Hành khách đã cập nhật (không còn trường thay đổi) hoặc lỗi
+ */
+Result<Passenger> PassengerRepository::updateDirtyFields(const Passenger& passenger) {
+    std::vector<const char*> columns;
+    if (passenger.isFieldDirty(Passenger::FIELD_NAME)) {
+        columns.push_back(ColumnName[NAME]);
+    }
+
+    auto query = Tables::buildPartialUpdateQuery(NAME_TABLE, columns, ColumnName[ID], ColumnName[VERSION]);
+    if (_logger) _logger->debug("Partial passenger update: " + query);
+
+    auto prepareResult = _connection->prepareStatement(query);
+    if (!prepareResult) {
+        if (_logger) _logger->error("Failed to prepare statement for partial passenger update");
+        return Failure<Passenger>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    }
+    int stmtId = prepareResult.value();
+
+    int paramIndex = 1;
+    bool bound = true;
+    if (passenger.isFieldDirty(Passenger::FIELD_NAME)) {
+        bound = bound && _connection->setString(stmtId, paramIndex++, passenger.getName()).has_value();
+    }
+    bound = bound && _connection->setInt(stmtId, paramIndex++, passenger.getId()).has_value();
+    bound = bound && _connection->setInt(stmtId, paramIndex, passenger.getVersion()).has_value();
+
+    if (!bound) {
+        _connection->freeStatement(stmtId);
+        if (_logger) _logger->error("Failed to set parameters for partial passenger update");
+        return Failure<Passenger>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+    }
+
+    auto result = _connection->executeUpdate(stmtId);
+    _connection->freeStatement(stmtId);
+
+    if (!result) {
+        if (_logger) _logger->error("Failed to execute partial passenger update");
+        return Failure<Passenger>(CoreError("Failed to execute statement", "EXECUTE_FAILED"));
+    }
+
+    auto versionCheck = checkVersionedUpdate(passenger.getId(), result.value());
+    if (!versionCheck) {
+        return Failure<Passenger>(versionCheck.error());
+    }
+
+    auto updatedPassenger = passenger;
+    updatedPassenger.setVersion(passenger.getVersion() + 1);
+    updatedPassenger.clearDirty();
+
+    Changes::Feed::getInstance()->publish(Changes::Entity::PASSENGER, Changes::Kind::UPDATED, passenger.getId());
+    if (_logger) _logger->debug("Successfully updated " + std::to_string(columns.size()) + " column(s) of passenger with id: " + std::to_string(passenger.getId()));
+    return Success(updatedPassenger);
+}
+
+/**
+ * @brief Kiểm tra kết quả của một UPDATE có điều kiện theo phiên bản
+ * 
+ * Chỉ khi không có hàng nào bị ảnh hưởng mới đọc thêm để phân biệt hành khách
+ * không tồn tại với hành khách đã bị phiên khác thay đổi.
+ * 
+ * @param id ID hành khách vừa cập nhật
+ * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+ * @return Result<bool> True nếu có hàng được cập nhật, lỗi VERSION_CONFLICT hoặc không tìm thấy
+ */
+Result<bool> PassengerRepository::checkVersionedUpdate(const int& id, int affectedRows) {
+    if (affectedRows > 0) {
+        return Success(true);
+    }
+
+    auto existsResult = exists(id);
+    if (!existsResult) {
+        if (_logger) _logger->error("Failed to check passenger existence");
+        return Failure<bool>(CoreError("Failed to check passenger existence", "DB_ERROR"));
+    }
+    if (!existsResult.value()) {
+        if (_logger) _logger->error("Passenger not found with id: " + std::to_string(id));
+        return Failure<bool>(CoreError("Passenger not found with id: " + std::to_string(id), "DB_ERROR"));
+    }
+
+    if (_logger) _logger->warning("Passenger " + std::to_string(id) + " was modified concurrently");
+    return Failure<bool>(CoreError("Passenger was modified by another session", "VERSION_CONFLICT"));
+}
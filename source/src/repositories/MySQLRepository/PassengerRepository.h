@@ -5,6 +5,8 @@
 #include "../../core/entities/Passenger.h"
 #include "../../database/InterfaceDatabaseConnection.h"
 #include "../../utils/Logger.h"
+#include "../PageQuery.h"
+#include "../ReadModels.h"
 #include <memory>
 #include <vector>
 
@@ -19,6 +21,27 @@ class PassengerRepository : public IRepository<Passenger> {
 private:
     std::shared_ptr<IDatabaseConnection> _connection; ///< Kết nối cơ sở dữ liệu
     std::shared_ptr<Logger> _logger; ///< Logger để ghi log
+    std::shared_ptr<PageAnchors> _pageAnchors = std::make_shared<PageAnchors>(); ///< Mốc để trang kế tiếp nạp theo khóa
+
+    /**
+     * @brief Cập nhật chỉ các cột đã thay đổi của hành khách
+     * @param passenger Hành khách có ít nhất một trường đã được đánh dấu thay đổi
+     * @return Result chứa hành khách đã cập nhật hoặc lỗi nếu thất bại
+     */
+    Result<Passenger> updateDirtyFields(const Passenger& passenger);
+
+    /**
+     * @brief Kiểm tra UPDATE có điều kiện theo phiên bản đã cập nhật được hàng
+     * @param id ID hành khách vừa cập nhật
+     * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+     * @return Result chứa true nếu thành công, lỗi VERSION_CONFLICT nếu hành khách đã bị thay đổi
+     */
+    Result<bool> checkVersionedUpdate(const int& id, int affectedRows);
+
+    /**
+     * @brief Giải mã tập kết quả danh sách hành khách vào cuối rows
+     */
+    Result<size_t> readListRows(IDatabaseResult& result, std::vector<PassengerListRow>& rows);
 
 public:
     /**
@@ -61,6 +84,14 @@ public:
      * @return Result chứa đối tượng Passenger đã được tạo (có ID) nếu thành công, hoặc lỗi nếu thất bại
      */
     Result<Passenger> create(const Passenger& passenger) override;
+
+    /**
+     * @brief Chèn nhiều hành khách trong một transaction bằng một câu INSERT nhiều hàng
+     * @param passengers Các hành khách cần tạo
+     * @return Result chứa các hành khách đã được gán ID theo thứ tự đầu vào, hoặc lỗi nếu thất bại
+     * @note Không kiểm tra trùng hộ chiếu trước; một hộ chiếu đã tồn tại làm cả lô bị rollback
+     */
+    Result<std::vector<Passenger>> createBatch(const std::vector<Passenger>& passengers);
     
     /**
      * @brief Cập nhật thông tin hành khách trong cơ sở dữ liệu
@@ -96,6 +127,53 @@ public:
      * @return Result chứa bool (true nếu tồn tại, false nếu không) hoặc lỗi nếu thất bại
      */
     Result<bool> existsPassport(const PassportNumber& passport);
+
+    /**
+     * @brief Tìm nhiều hành khách theo danh sách số hộ chiếu bằng một truy vấn
+     * @param passports Danh sách số hộ chiếu cần tìm
+     * @return Result chứa các hành khách tìm thấy (không theo thứ tự đầu vào), hoặc lỗi nếu thất bại
+     * @note Số hộ chiếu không tồn tại đơn giản là không có trong kết quả
+     */
+    Result<std::vector<Passenger>> findByPassportNumbers(const std::vector<PassportNumber>& passports);
+
+    // Phương thức projection cho màn hình danh sách
+
+    /**
+     * @brief Nạp danh sách hành khách dạng phẳng cho màn hình danh sách
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng để tái sử dụng giữa các lần làm mới
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Không dựng Passenger, ContactInfo hay PassportNumber
+     */
+    Result<size_t> findAllListRows(std::vector<PassengerListRow>& rows);
+
+    /**
+     * @brief Nạp một trang hành khách dạng phẳng, theo thứ tự id
+     * @param offset Số hàng bỏ qua
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Trang đầu và trang ngay sau trang vừa nạp đi theo khóa; chỉ nhảy cóc mới dùng OFFSET
+     */
+    Result<size_t> findListRowsPage(size_t offset, size_t limit, std::vector<PassengerListRow>& rows);
+
+    /**
+     * @brief Nạp trang hành khách dạng phẳng tiếp theo theo khóa: các hàng có id lớn hơn afterId, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Dùng để đi qua cả bảng mà không phải bỏ qua lại các hàng đầu như OFFSET
+     */
+    Result<size_t> findListRowsAfter(int afterId, size_t limit, std::vector<PassengerListRow>& rows);
+
+    /**
+     * @brief Nạp hành khách dạng phẳng theo danh sách id bằng một truy vấn, theo thứ tự id
+     * @param ids Các id cần nạp; nên nhỏ (một câu lệnh IN)
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Id không tồn tại đơn giản là không có trong kết quả
+     */
+    Result<size_t> findListRowsByIds(const std::vector<int>& ids, std::vector<PassengerListRow>& rows);
 };
 
 #endif
\ No newline at end of file
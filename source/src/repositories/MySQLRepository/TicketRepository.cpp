@@ -1,7 +1,11 @@
 #include "TicketRepository.h"
+#include "../PageQuery.h"
 #include "../../core/exceptions/Result.h"
 #include "../../utils/Logger.h"
 #include "../../utils/TableConstants.h"
+#include "../../utils/ChangeFeed.h"
+#include "../../utils/Metrics.h"
+#include "../../utils/Tracing.h"
 #include <sstream>
 #include <map>
 
@@ -17,6 +21,9 @@
  * @return Result<Ticket> Kết quả chứa đối tượng Ticket hoặc lỗi
  */
 Result<Ticket> TicketRepository::findById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "find_by_id");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding ticket by id: " + std::to_string(id));
 
@@ -57,9 +64,10 @@ Result<Ticket> TicketRepository::findById(const int& id) {
         auto statusResult = dbResult->getString(Tables::Ticket::ColumnName[Tables::Ticket::STATUS]);
         auto passengerIdResult = dbResult->getInt(Tables::Ticket::ColumnName[Tables::Ticket::PASSENGER_ID]);
         auto flightIdResult = dbResult->getInt(Tables::Ticket::ColumnName[Tables::Ticket::FLIGHT_ID]);
+        auto versionResult = dbResult->getInt(Tables::Ticket::ColumnName[Tables::Ticket::VERSION]);
 
         if (!idResult || !ticketNumberResult || !seatNumberResult || !priceResult || 
-            !currencyResult || !statusResult || !passengerIdResult || !flightIdResult) {
+            !currencyResult || !statusResult || !passengerIdResult || !flightIdResult || !versionResult) {
             if (_logger) _logger->error("Failed to get ticket data for id: " + std::to_string(id));
             return Failure<Ticket>(CoreError("Failed to get ticket data", "DATA_ERROR"));
         }
@@ -111,9 +119,11 @@ Result<Ticket> TicketRepository::findById(const int& id) {
         auto ticket = ticketResult.value();
         ticket.setId(idResult.value());
         ticket.setStatus(TicketStatusUtil::fromString(statusResult.value()));
+        ticket.setVersion(versionResult.value());
+        ticket.clearDirty();
 
         if (_logger) _logger->debug("Successfully found ticket with id: " + std::to_string(id));
-        return Success(ticket);
+        return timer.complete(Success(ticket));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding ticket by id: " + std::string(e.what()));
         return Failure<Ticket>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -129,6 +139,9 @@ Result<Ticket> TicketRepository::findById(const int& id) {
  * @return Result<std::vector<Ticket>> Vector chứa tất cả vé hoặc lỗi
  */
 Result<std::vector<Ticket>> TicketRepository::findAll() {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "find_all");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Finding all tickets");
 
@@ -166,7 +179,7 @@ Result<std::vector<Ticket>> TicketRepository::findAll() {
         }
 
         if (_logger) _logger->debug("Successfully found " + std::to_string(tickets.size()) + " tickets");
-        return Success(tickets);
+        return timer.complete(Success(tickets));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error finding all tickets: " + std::string(e.what()));
         return Failure<std::vector<Ticket>>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -232,6 +245,8 @@ Result<bool> TicketRepository::exists(const int& id) {
  * @return Result<size_t> Số lượng vé hoặc lỗi
  */
 Result<size_t> TicketRepository::count() {
+    // Danh sách làm mới luôn đếm trước: mốc trang của lượt trước có thể đã lệch
+    _pageAnchors->clear();
     try {
         if (_logger) _logger->debug("Counting total tickets");
 
@@ -280,6 +295,9 @@ Result<size_t> TicketRepository::count() {
  * @return Result<Ticket> Vé đã được tạo với ID hoặc lỗi
  */
 Result<Ticket> TicketRepository::create(const Ticket& ticket) {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "create");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Creating new ticket");
 
@@ -328,9 +346,11 @@ Result<Ticket> TicketRepository::create(const Ticket& ticket) {
 
         auto createdTicket = ticket;
         createdTicket.setId(lastIdResult.value());
+        createdTicket.clearDirty();
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::CREATED, createdTicket.getId());
         if (_logger) _logger->debug("Successfully created ticket with id: " + std::to_string(lastIdResult.value()));
-        return Success(createdTicket);
+        return timer.complete(Success(createdTicket));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error creating ticket: " + std::string(e.what()));
         return Failure<Ticket>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -344,17 +364,15 @@ Result<Ticket> TicketRepository::create(const Ticket& ticket) {
  * @return Result<Ticket> Vé đã được cập nhật hoặc lỗi
  */
 Result<Ticket> TicketRepository::update(const Ticket& ticket) {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "update");
+    Metrics::OperationTimer timer(metrics);
+
     try {
         if (_logger) _logger->debug("Updating ticket with id: " + std::to_string(ticket.getId()));
 
-        auto existsResult = exists(ticket.getId());
-        if (!existsResult) {
-            if (_logger) _logger->error("Failed to check ticket existence");
-            return Failure<Ticket>(CoreError("Failed to check ticket existence", "DB_ERROR"));
-        }
-        if (!existsResult.value()) {
-            if (_logger) _logger->error("Ticket not found with id: " + std::to_string(ticket.getId()));
-            return Failure<Ticket>(CoreError("Ticket not found with id: " + std::to_string(ticket.getId()), "DB_ERROR"));
+        // Chỉ ghi các cột đã thay đổi nếu thực thể có theo dõi thay đổi
+        if (ticket.hasPartialChanges()) {
+            return timer.complete(updateDirtyFields(ticket));
         }
 
         auto prepareResult = _connection->prepareStatement(Tables::Ticket::UPDATE_QUERY);
@@ -373,15 +391,16 @@ Result<Ticket> TicketRepository::update(const Ticket& ticket) {
         auto setCurrencyResult = _connection->setString(stmtId, 6, ticket.getPrice().getCurrency());
         auto setStatusResult = _connection->setString(stmtId, 7, TicketStatusUtil::toString(ticket.getStatus()));
         auto setIdResult = _connection->setInt(stmtId, 8, ticket.getId());
+        auto setVersionResult = _connection->setInt(stmtId, 9, ticket.getVersion());
 
         if (!setTicketNumberResult || !setPassengerIdResult || !setFlightIdResult || !setSeatNumberResult || 
-            !setPriceResult || !setCurrencyResult || !setStatusResult || !setIdResult) {
+            !setPriceResult || !setCurrencyResult || !setStatusResult || !setIdResult || !setVersionResult) {
             _connection->freeStatement(stmtId);
             if (_logger) _logger->error("Failed to set parameters for updating ticket");
             return Failure<Ticket>(CoreError("Failed to set parameters", "PARAM_FAILED"));
         }
 
-        auto result = _connection->executeStatement(stmtId);
+        auto result = _connection->executeUpdate(stmtId);
         _connection->freeStatement(stmtId);
 
         if (!result) {
@@ -389,14 +408,18 @@ Result<Ticket> TicketRepository::update(const Ticket& ticket) {
             return Failure<Ticket>(CoreError("Failed to execute update", "UPDATE_FAILED"));
         }
 
-        auto updateResult = std::move(result.value());
-        if (updateResult != 1) {
-            if (_logger) _logger->error("Unexpected number of rows affected: " + std::to_string(updateResult));
-            return Failure<Ticket>(CoreError("Unexpected number of rows affected", "UPDATE_FAILED"));
+        auto versionCheck = checkVersionedUpdate(ticket.getId(), result.value());
+        if (!versionCheck) {
+            return Failure<Ticket>(versionCheck.error());
         }
 
+        auto updatedTicket = ticket;
+        updatedTicket.setVersion(ticket.getVersion() + 1);
+        updatedTicket.clearDirty();
+
+        Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::UPDATED, ticket.getId());
         if (_logger) _logger->debug("Successfully updated ticket with id: " + std::to_string(ticket.getId()));
-        return Success(ticket);
+        return timer.complete(Success(updatedTicket));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error updating ticket: " + std::string(e.what()));
         return Failure<Ticket>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -410,6 +433,10 @@ Result<Ticket> TicketRepository::update(const Ticket& ticket) {
  * @return Result<bool> True nếu xóa thành công hoặc lỗi
  */
 Result<bool> TicketRepository::deleteById(const int& id) {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "delete");
+    Metrics::OperationTimer timer(metrics);
+    _pageAnchors->clear();
+
     try {
         if (_logger) _logger->debug("Deleting ticket with id: " + std::to_string(id));
 
@@ -451,8 +478,9 @@ Result<bool> TicketRepository::deleteById(const int& id) {
             return Failure<bool>(CoreError("Unexpected number of rows affected", "UPDATE_FAILED"));
         }
 
+        Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::DELETED, id);
         if (_logger) _logger->debug("Successfully deleted ticket with id: " + std::to_string(id));
-        return Success(true);
+        return timer.complete(Success(true));
     } catch (const std::exception& e) {
         if (_logger) _logger->error("Error deleting ticket: " + std::string(e.what()));
         return Failure<bool>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
@@ -466,6 +494,8 @@ Result<bool> TicketRepository::deleteById(const int& id) {
  * @return Result<Ticket> Vé tìm được hoặc lỗi
  */
 Result<Ticket> TicketRepository::findByTicketNumber(const TicketNumber& ticketNumber) {
+    Tracing::Span span("ticket.find_by_ticket_number", "repository");
+
     try {
         if (_logger) _logger->debug("Finding ticket by ticket number: " + ticketNumber.getValue());
 
@@ -737,6 +767,195 @@ Result<std::vector<Ticket>> TicketRepository::findByFlightId(int flightId) {
     }
 }
 
+/**
+ * @brief Đếm số vé của một chuyến bay
+ *
+ * Chỉ chạy một truy vấn COUNT, không dựng lại từng vé như findByFlightId.
+ *
+ * @param flightId ID của chuyến bay
+ * @return Result<size_t> Số vé của chuyến bay hoặc lỗi
+ */
+Result<size_t> TicketRepository::countByFlightId(int flightId) {
+    Tracing::Span span("ticket.count_by_flight_id", "repository");
+
+    try {
+        if (_logger) _logger->debug("Counting tickets by flight id: " + std::to_string(flightId));
+
+        auto prepareResult = _connection->prepareStatement(Tables::Ticket::COUNT_BY_FLIGHT_ID_QUERY);
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for counting tickets by flight id");
+            return Failure<size_t>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        auto setParamResult = _connection->setInt(stmtId, 1, flightId);
+        if (!setParamResult) {
+            _connection->freeStatement(stmtId);
+            if (_logger) _logger->error("Failed to set parameter for counting tickets by flight id");
+            return Failure<size_t>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeQueryStatement(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for counting tickets by flight id");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        if (!dbResult->next().value()) {
+            if (_logger) _logger->warning("No result returned when counting tickets by flight id");
+            return Failure<size_t>(CoreError("No result returned", "QUERY_FAILED"));
+        }
+
+        auto countResult = dbResult->getInt(0);
+        if (!countResult) {
+            if (_logger) _logger->error("Failed to get count result");
+            return Failure<size_t>(CoreError("Failed to get count result", "DATA_ERROR"));
+        }
+
+        return Success(static_cast<size_t>(countResult.value()));
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error counting tickets by flight id: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Tạo nhiều vé của một chuyến bay trong một transaction
+ *
+ * Ghế được giữ bằng một câu UPDATE ... IN (...); nếu số hàng bị ảnh hưởng ít hơn số vé
+ * thì có ghế đã bị phiên khác đặt và toàn bộ transaction bị rollback. Vé được chèn bằng
+ * một câu INSERT nhiều hàng; với INSERT đơn giản InnoDB cấp các giá trị AUTO_INCREMENT
+ * liên tiếp nên ID của vé thứ i là LAST_INSERT_ID() + i.
+ *
+ * @param tickets Các vé cần tạo
+ * @return Result<std::vector<Ticket>> Các vé đã tạo hoặc lỗi
+ */
+Result<std::vector<Ticket>> TicketRepository::createBatch(const std::vector<Ticket>& tickets) {
+    static const Metrics::OperationMetrics metrics("repository", "ticket", "create_batch");
+    Metrics::OperationTimer timer(metrics);
+
+    if (tickets.empty()) {
+        return timer.complete(Success(std::vector<Ticket>{}));
+    }
+
+    const int flightId = tickets.front().getFlight()->getId();
+    for (const auto& ticket : tickets) {
+        if (ticket.getFlight()->getId() != flightId) {
+            if (_logger) _logger->error("Batch tickets must belong to the same flight");
+            return Failure<std::vector<Ticket>>(CoreError("Batch tickets must belong to the same flight", "INVALID_BATCH"));
+        }
+    }
+
+    if (_logger) _logger->debug("Creating " + std::to_string(tickets.size()) + " tickets for flight id: " + std::to_string(flightId));
+
+    auto beginResult = _connection->beginTransaction();
+    if (!beginResult) {
+        if (_logger) _logger->error("Failed to begin transaction for creating tickets");
+        return Failure<std::vector<Ticket>>(beginResult.error());
+    }
+
+    auto fail = [this](const CoreError& error) {
+        _connection->rollbackTransaction();
+        return Failure<std::vector<Ticket>>(error);
+    };
+
+    try {
+        // Reserve all seats in one statement
+        auto reservePrepareResult = _connection->prepareStatement(Tables::Ticket::buildReserveSeatsQuery(tickets.size()));
+        if (!reservePrepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for reserving seats");
+            return fail(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int reserveStmtId = reservePrepareResult.value();
+
+        bool paramsOk = static_cast<bool>(_connection->setInt(reserveStmtId, 1, flightId));
+        for (size_t i = 0; i < tickets.size() && paramsOk; ++i) {
+            paramsOk = static_cast<bool>(_connection->setString(reserveStmtId, static_cast<int>(i) + 2, tickets[i].getSeatNumber().getValue()));
+        }
+        if (!paramsOk) {
+            _connection->freeStatement(reserveStmtId);
+            if (_logger) _logger->error("Failed to set parameters for reserving seats");
+            return fail(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto reservedRows = _connection->executeUpdate(reserveStmtId);
+        _connection->freeStatement(reserveStmtId);
+        if (!reservedRows) {
+            if (_logger) _logger->error("Failed to execute update for reserving seats");
+            return fail(CoreError("Failed to execute update", "UPDATE_FAILED"));
+        }
+        if (reservedRows.value() != static_cast<int>(tickets.size())) {
+            if (_logger) _logger->error("Some seats are no longer available");
+            return fail(CoreError("Seat is not available", "SEAT_NOT_AVAILABLE"));
+        }
+
+        // Insert all tickets in one statement
+        auto insertPrepareResult = _connection->prepareStatement(Tables::Ticket::buildBatchInsertQuery(tickets.size()));
+        if (!insertPrepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for creating tickets");
+            return fail(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int insertStmtId = insertPrepareResult.value();
+
+        for (size_t i = 0; i < tickets.size() && paramsOk; ++i) {
+            const auto& ticket = tickets[i];
+            const int base = static_cast<int>(i * Tables::Ticket::INSERT_COLUMN_COUNT);
+            paramsOk = _connection->setString(insertStmtId, base + 1, ticket.getTicketNumber().getValue()) &&
+                       _connection->setInt(insertStmtId, base + 2, ticket.getPassenger()->getId()) &&
+                       _connection->setInt(insertStmtId, base + 3, flightId) &&
+                       _connection->setString(insertStmtId, base + 4, ticket.getSeatNumber().getValue()) &&
+                       _connection->setDouble(insertStmtId, base + 5, ticket.getPrice().getAmount()) &&
+                       _connection->setString(insertStmtId, base + 6, ticket.getPrice().getCurrency()) &&
+                       _connection->setString(insertStmtId, base + 7, TicketStatusUtil::toString(ticket.getStatus()));
+        }
+        if (!paramsOk) {
+            _connection->freeStatement(insertStmtId);
+            if (_logger) _logger->error("Failed to set parameters for creating tickets");
+            return fail(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto insertResult = _connection->executeStatement(insertStmtId);
+        _connection->freeStatement(insertStmtId);
+        if (!insertResult) {
+            if (_logger) _logger->error("Failed to execute update for creating tickets");
+            return fail(CoreError("Failed to execute update", "UPDATE_FAILED"));
+        }
+
+        auto firstIdResult = _connection->getLastInsertId();
+        if (!firstIdResult) {
+            if (_logger) _logger->error("Failed to get last insert id");
+            return fail(CoreError("Failed to get last insert id", "ID_ERROR"));
+        }
+
+        auto commitResult = _connection->commitTransaction();
+        if (!commitResult) {
+            if (_logger) _logger->error("Failed to commit transaction for creating tickets");
+            return fail(commitResult.error());
+        }
+
+        std::vector<Ticket> createdTickets;
+        createdTickets.reserve(tickets.size());
+        for (size_t i = 0; i < tickets.size(); ++i) {
+            auto createdTicket = tickets[i];
+            createdTicket.setId(firstIdResult.value() + static_cast<int>(i));
+            createdTicket.clearDirty();
+            createdTickets.push_back(std::move(createdTicket));
+        }
+
+        for (const auto& createdTicket : createdTickets) {
+            Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::CREATED, createdTicket.getId());
+        }
+        if (_logger) _logger->debug("Successfully created " + std::to_string(createdTickets.size()) + " tickets");
+        return timer.complete(Success(createdTickets));
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error creating tickets: " + std::string(e.what()));
+        return fail(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
 /**
  * @brief Tìm kiếm vé theo nhiều tiêu chí với tùy chọn sắp xếp và giới hạn
  * 
@@ -833,3 +1052,574 @@ Result<std::vector<Ticket>> TicketRepository::findByCriteria(
         return Failure<std::vector<Ticket>>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
     }
 }
+
+/**
+ * @brief Giải mã các hàng vé theo chỉ số cột và thêm vào cuối rows
+ */
+Result<size_t> TicketRepository::readListRows(IDatabaseResult& result, std::vector<TicketListRow>& rows) {
+    while (result.next().value()) {
+        auto idResult = result.getInt(Tables::Ticket::LIST_ID);
+        auto ticketNumberResult = result.getString(Tables::Ticket::LIST_TICKET_NUMBER);
+        auto passengerIdResult = result.getInt(Tables::Ticket::LIST_PASSENGER_ID);
+        auto passportResult = result.getString(Tables::Ticket::LIST_PASSPORT_NUMBER);
+        auto flightIdResult = result.getInt(Tables::Ticket::LIST_FLIGHT_ID);
+        auto flightNumberResult = result.getString(Tables::Ticket::LIST_FLIGHT_NUMBER);
+        auto seatNumberResult = result.getString(Tables::Ticket::LIST_SEAT_NUMBER);
+        auto priceResult = result.getDouble(Tables::Ticket::LIST_PRICE);
+        auto currencyResult = result.getString(Tables::Ticket::LIST_CURRENCY);
+        auto statusResult = result.getString(Tables::Ticket::LIST_STATUS);
+
+        if (!idResult || !ticketNumberResult || !passengerIdResult || !passportResult ||
+            !flightIdResult || !flightNumberResult || !seatNumberResult || !priceResult ||
+            !currencyResult || !statusResult) {
+            if (_logger) _logger->error("Failed to get ticket list row data");
+            return Failure<size_t>(CoreError("Failed to get ticket list row data", "DATA_ERROR"));
+        }
+
+        auto& row = rows.emplace_back();
+        row.id = idResult.value();
+        row.ticketNumber = std::move(ticketNumberResult.value());
+        row.passengerId = passengerIdResult.value();
+        row.passportNumber = std::move(passportResult.value());
+        row.flightId = flightIdResult.value();
+        row.flightNumber = std::move(flightNumberResult.value());
+        row.seatNumber = std::move(seatNumberResult.value());
+        row.price = priceResult.value();
+        row.currency = std::move(currencyResult.value());
+        row.status = TicketStatusUtil::fromString(statusResult.value());
+    }
+    return Success(rows.size());
+}
+
+/**
+ * @brief Nạp một trang vé dạng phẳng, theo thứ tự id
+ *
+ * @param offset Số hàng bỏ qua
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> TicketRepository::findListRowsPage(size_t offset, size_t limit, std::vector<TicketListRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executePageQuery(*_connection, Tables::Ticket::FIND_LIST_ROW_PAGE_QUERY,
+                                       Tables::Ticket::FIND_LIST_ROWS_AFTER_QUERY, *_pageAnchors, offset, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load ticket page: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        auto read = readListRows(*result.value(), rows);
+        if (read && !rows.empty()) _pageAnchors->record(offset + rows.size(), rows.back().id);
+        return read;
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading ticket page: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp trang vé dạng phẳng tiếp theo theo khóa, theo thứ tự id
+ *
+ * @param afterId Id lớn nhất của trang trước
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> TicketRepository::findListRowsAfter(int afterId, size_t limit, std::vector<TicketListRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, Tables::Ticket::FIND_LIST_ROWS_AFTER_QUERY, afterId, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load tickets after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readListRows(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading tickets after id: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp vé dạng phẳng theo danh sách id, theo thứ tự id
+ *
+ * @param ids Các id cần nạp
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> TicketRepository::findListRowsByIds(const std::vector<int>& ids, std::vector<TicketListRow>& rows) {
+    try {
+        rows.clear();
+        if (ids.empty()) return Success(size_t(0));
+        auto result = executeIdListQuery(*_connection, Tables::Ticket::buildFindListRowsByIdsQuery(ids.size()), ids);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load tickets by ids: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readListRows(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading tickets by ids: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Nạp danh sách vé dạng phẳng cho màn hình danh sách
+ * 
+ * Thay cho findAll (truy vấn id rồi gọi findById cho từng vé, dựng lại cả hành khách
+ * và chuyến bay), phương thức này dùng một truy vấn JOIN chỉ lấy các cột hiển thị và
+ * giải mã theo chỉ số cột thẳng vào vector đích.
+ * 
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> TicketRepository::findAllListRows(std::vector<TicketListRow>& rows) {
+    try {
+        if (_logger) _logger->debug("Loading ticket list rows");
+
+        rows.clear();
+        if (rows.capacity() == 0) {
+            auto countResult = count();
+            if (countResult) rows.reserve(countResult.value());
+        }
+
+        auto result = _connection->executeQuery(Tables::Ticket::FIND_ALL_LIST_ROW_QUERY);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for loading ticket list rows");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        auto decoded = readListRows(*dbResult, rows);
+        if (!decoded) return decoded;
+
+        if (_logger) _logger->debug("Loaded " + std::to_string(rows.size()) + " ticket list rows");
+        return Success(rows.size());
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading ticket list rows: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Giải mã các nhóm (chuyến bay, hạng ghế, số vé) vào cuối rows
+ */
+Result<size_t> TicketRepository::readSeatOccupancy(IDatabaseResult& result, std::vector<SeatOccupancyRow>& rows) {
+    while (result.next().value()) {
+        auto flightIdResult = result.getInt(Tables::Ticket::OCCUPANCY_FLIGHT_ID);
+        auto seatClassResult = result.getString(Tables::Ticket::OCCUPANCY_SEAT_CLASS);
+        auto bookedResult = result.getInt(Tables::Ticket::OCCUPANCY_BOOKED);
+
+        if (!flightIdResult || !seatClassResult || !bookedResult) {
+            if (_logger) _logger->error("Failed to get seat occupancy data");
+            return Failure<size_t>(CoreError("Failed to get seat occupancy data", "DATA_ERROR"));
+        }
+        if (seatClassResult.value().empty()) continue;
+
+        auto& row = rows.emplace_back();
+        row.flightId = flightIdResult.value();
+        row.seatClass = seatClassResult.value()[0];
+        row.booked = bookedResult.value();
+    }
+    return Success(rows.size());
+}
+
+Result<size_t> TicketRepository::readFacts(IDatabaseResult& result, std::vector<TicketFactRow>& rows) {
+    while (result.next().value()) {
+        auto idResult = result.getInt(Tables::Ticket::FACT_ID);
+        auto passengerIdResult = result.getInt(Tables::Ticket::FACT_PASSENGER_ID);
+        auto flightIdResult = result.getInt(Tables::Ticket::FACT_FLIGHT_ID);
+        auto seatNumberResult = result.getString(Tables::Ticket::FACT_SEAT_NUMBER);
+        auto priceResult = result.getDouble(Tables::Ticket::FACT_PRICE);
+        auto currencyResult = result.getString(Tables::Ticket::FACT_CURRENCY);
+        auto statusResult = result.getString(Tables::Ticket::FACT_STATUS);
+
+        if (!idResult || !passengerIdResult || !flightIdResult || !seatNumberResult || !priceResult || !currencyResult || !statusResult) {
+            if (_logger) _logger->error("Failed to get ticket fact data");
+            return Failure<size_t>(CoreError("Failed to get ticket fact data", "DATA_ERROR"));
+        }
+
+        auto& row = rows.emplace_back();
+        row.id = idResult.value();
+        row.passengerId = passengerIdResult.value();
+        row.flightId = flightIdResult.value();
+        row.seatClass = seatNumberResult.value().empty() ? 0 : seatNumberResult.value()[0];
+        row.price = priceResult.value();
+        row.currency = std::move(currencyResult.value());
+        row.status = TicketStatusUtil::fromString(statusResult.value());
+    }
+    return Success(rows.size());
+}
+
+/**
+ * @brief Nạp trang kế tiếp các cột báo cáo của vé theo khóa, theo thứ tự id
+ *
+ * @param afterId Id lớn nhất của trang trước
+ * @param limit Số hàng tối đa của trang
+ * @param rows Vector đích
+ * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+ */
+Result<size_t> TicketRepository::findFactsAfter(int afterId, size_t limit, std::vector<TicketFactRow>& rows) {
+    try {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, Tables::Ticket::FIND_FACTS_AFTER_QUERY, afterId, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load ticket facts after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readFacts(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading ticket facts: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::findFactsByIds(const std::vector<int>& ids, std::vector<TicketFactRow>& rows) {
+    try {
+        rows.clear();
+        if (ids.empty()) return Success(size_t(0));
+        auto result = executeIdListQuery(*_connection, Tables::Ticket::buildFindFactsByIdsQuery(ids.size()), ids);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load ticket facts by ids: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readFacts(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading ticket facts by ids: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::countSeatOccupancy(std::vector<SeatOccupancyRow>& rows) {
+    try {
+        if (_logger) _logger->debug("Counting booked seats by flight and seat class");
+
+        rows.clear();
+        auto result = _connection->executeQuery(Tables::Ticket::SEAT_OCCUPANCY_QUERY);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for counting booked seats");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+        return readSeatOccupancy(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error counting booked seats: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::countSeatOccupancy(int firstFlightId, int lastFlightId, std::vector<SeatOccupancyRow>& rows) {
+    try {
+        rows.clear();
+        auto prepareResult = _connection->prepareStatement(Tables::Ticket::SEAT_OCCUPANCY_RANGE_QUERY);
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for counting booked seats");
+            return Failure<size_t>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        if (!_connection->setInt(stmtId, 1, firstFlightId) || !_connection->setInt(stmtId, 2, lastFlightId)) {
+            _connection->freeStatement(stmtId);
+            if (_logger) _logger->error("Failed to set parameters for counting booked seats");
+            return Failure<size_t>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeQueryStatement(stmtId);
+        _connection->freeStatement(stmtId);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for counting booked seats");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+        return readSeatOccupancy(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error counting booked seats: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::countSeatOccupancy(const std::vector<int>& flightIds, std::vector<SeatOccupancyRow>& rows) {
+    try {
+        rows.clear();
+        if (flightIds.empty()) return Success(size_t(0));
+        auto result = executeIdListQuery(*_connection, Tables::Ticket::buildSeatOccupancyByFlightIdsQuery(flightIds.size()), flightIds);
+        if (!result) {
+            if (_logger) _logger->error("Failed to count booked seats by flight ids: " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readSeatOccupancy(*result.value(), rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error counting booked seats: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<HighWaterMark> TicketRepository::readHighWaterMark() {
+    try {
+        auto mark = executeHighWaterMarkQuery(*_connection, Tables::Ticket::HIGH_WATER_MARK_QUERY);
+        if (!mark && _logger) _logger->error("Failed to read ticket high-water mark: " + mark.error().message);
+        return mark;
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error reading ticket high-water mark: " + std::string(e.what()));
+        return Failure<HighWaterMark>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::findVersionsAfter(int afterId, size_t limit, std::vector<RowVersion>& rows) {
+    try {
+        rows.clear();
+        auto result = executeKeysetQuery(*_connection, Tables::Ticket::FIND_VERSIONS_AFTER_QUERY, afterId, limit);
+        if (!result) {
+            if (_logger) _logger->error("Failed to load ticket versions after id " + std::to_string(afterId) + ": " + result.error().message);
+            return Failure<size_t>(result.error());
+        }
+        return readRowVersions(*result.value(), true, rows);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error loading ticket versions: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+Result<size_t> TicketRepository::countActiveBookings(PassengerStatistics& statistics) {
+    try {
+        if (_logger) _logger->debug("Counting active bookings by passenger");
+
+        auto result = _connection->executeQuery(Tables::Ticket::ACTIVE_BOOKINGS_BY_PASSENGER_QUERY);
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for counting active bookings");
+            return Failure<size_t>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        // Một hàng duy nhất: số hành khách phân biệt và tổng số vé đang hoạt động
+        auto& row = *result.value();
+        auto hasRow = row.next();
+        if (!hasRow || !hasRow.value()) {
+            if (_logger) _logger->error("No result for counting active bookings");
+            return Failure<size_t>(CoreError("No result for counting active bookings", "DATA_ERROR"));
+        }
+        auto passengersResult = row.getInt(Tables::Ticket::ACTIVE_BOOKING_PASSENGERS);
+        auto ticketsResult = row.getInt(Tables::Ticket::ACTIVE_BOOKING_TICKETS);
+        if (!passengersResult || !ticketsResult) {
+            if (_logger) _logger->error("Failed to get active booking data");
+            return Failure<size_t>(CoreError("Failed to get active booking data", "DATA_ERROR"));
+        }
+        statistics.passengersWithActiveBookings = static_cast<size_t>(passengersResult.value());
+        statistics.activeTickets = static_cast<size_t>(ticketsResult.value());
+        return Success(statistics.passengersWithActiveBookings);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error counting active bookings: " + std::string(e.what()));
+        return Failure<size_t>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Cập nhật chỉ các cột của vé đã được đánh dấu thay đổi
+ * 
+ * Sinh câu lệnh UPDATE ... SET chỉ gồm các cột tương ứng với bit mask
+ * Ticket::Field của thực thể, thay vì ghi lại toàn bộ bảy cột.
+ * 
+ * @param ticket Vé có ít nhất một trường đã thay đổi
+ * @return Result<Ticket> Vé đã cập nhật (không còn trường thay đổi) hoặc lỗi
+ */
+Result<Ticket> TicketRepository::updateDirtyFields(const Ticket& ticket) {
+    std::vector<const char*> columns;
+    if (ticket.isFieldDirty(Ticket::FIELD_PRICE)) {
+        columns.push_back(Tables::Ticket::ColumnName[Tables::Ticket::PRICE]);
+        columns.push_back(Tables::Ticket::ColumnName[Tables::Ticket::CURRENCY]);
+    }
+    if (ticket.isFieldDirty(Ticket::FIELD_STATUS)) {
+        columns.push_back(Tables::Ticket::ColumnName[Tables::Ticket::STATUS]);
+    }
+
+    auto query = Tables::buildPartialUpdateQuery(Tables::Ticket::NAME_TABLE, columns,
+                                                 Tables::Ticket::ColumnName[Tables::Ticket::ID],
+                                                 Tables::Ticket::ColumnName[Tables::Ticket::VERSION]);
+    if (_logger) _logger->debug("Partial ticket update: " + query);
+
+    auto prepareResult = _connection->prepareStatement(query);
+    if (!prepareResult) {
+        if (_logger) _logger->error("Failed to prepare statement for partial ticket update");
+        return Failure<Ticket>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    }
+    int stmtId = prepareResult.value();
+
+    int paramIndex = 1;
+    bool bound = true;
+    if (ticket.isFieldDirty(Ticket::FIELD_PRICE)) {
+        bound = bound && _connection->setDouble(stmtId, paramIndex++, ticket.getPrice().getAmount()).has_value();
+        bound = bound && _connection->setString(stmtId, paramIndex++, ticket.getPrice().getCurrency()).has_value();
+    }
+    if (ticket.isFieldDirty(Ticket::FIELD_STATUS)) {
+        bound = bound && _connection->setString(stmtId, paramIndex++, TicketStatusUtil::toString(ticket.getStatus())).has_value();
+    }
+    bound = bound && _connection->setInt(stmtId, paramIndex++, ticket.getId()).has_value();
+    bound = bound && _connection->setInt(stmtId, paramIndex, ticket.getVersion()).has_value();
+
+    if (!bound) {
+        _connection->freeStatement(stmtId);
+        if (_logger) _logger->error("Failed to set parameters for partial ticket update");
+        return Failure<Ticket>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+    }
+
+    auto result = _connection->executeUpdate(stmtId);
+    _connection->freeStatement(stmtId);
+
+    if (!result) {
+        if (_logger) _logger->error("Failed to execute partial ticket update");
+        return Failure<Ticket>(CoreError("Failed to execute update", "UPDATE_FAILED"));
+    }
+
+    auto versionCheck = checkVersionedUpdate(ticket.getId(), result.value());
+    if (!versionCheck) {
+        return Failure<Ticket>(versionCheck.error());
+    }
+
+    auto updatedTicket = ticket;
+    updatedTicket.setVersion(ticket.getVersion() + 1);
+    updatedTicket.clearDirty();
+
+    Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::UPDATED, ticket.getId());
+    if (_logger) _logger->debug("Successfully updated " + std::to_string(columns.size()) + " column(s) of ticket with id: " + std::to_string(ticket.getId()));
+    return Success(updatedTicket);
+}
+
+/**
+ * @brief Lấy thông tin trạng thái tối thiểu của vé theo số vé
+ * 
+ * Một truy vấn JOIN với bảng flight trả về id, trạng thái vé và giờ khởi hành,
+ * đủ để kiểm tra điều kiện chuyển trạng thái mà không nạp hành khách, chuyến bay
+ * và bản đồ ghế.
+ * 
+ * @param ticketNumber Số vé cần tra cứu
+ * @return Result<TicketStatusRow> Thông tin trạng thái hoặc lỗi NOT_FOUND
+ */
+Result<TicketStatusRow> TicketRepository::findStatusRow(const TicketNumber& ticketNumber) {
+    Tracing::Span span("ticket.find_status_row", "repository");
+
+    try {
+        if (_logger) _logger->debug("Finding ticket status by ticket number: " + ticketNumber.getValue());
+
+        auto prepareResult = _connection->prepareStatement(Tables::Ticket::FIND_STATUS_BY_TICKET_NUMBER_QUERY);
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for finding ticket status");
+            return Failure<TicketStatusRow>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        auto setParamResult = _connection->setString(stmtId, 1, ticketNumber.getValue());
+        if (!setParamResult) {
+            _connection->freeStatement(stmtId);
+            if (_logger) _logger->error("Failed to set parameter for finding ticket status");
+            return Failure<TicketStatusRow>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeQueryStatement(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute query for finding ticket status");
+            return Failure<TicketStatusRow>(CoreError("Failed to execute query", "QUERY_FAILED"));
+        }
+
+        auto dbResult = std::move(result.value());
+        if (!dbResult->next().value()) {
+            if (_logger) _logger->warning("Ticket not found with ticket number: " + ticketNumber.getValue());
+            return Failure<TicketStatusRow>(CoreError("Ticket not found with ticket number: " + ticketNumber.getValue(), "NOT_FOUND"));
+        }
+
+        auto idResult = dbResult->getInt(0);
+        auto flightIdResult = dbResult->getInt(1);
+        auto statusResult = dbResult->getString(2);
+        auto departureResult = dbResult->getDateTime(3);
+        auto versionResult = dbResult->getInt(4);
+        if (!idResult || !flightIdResult || !statusResult || !departureResult || !versionResult) {
+            if (_logger) _logger->error("Failed to get ticket status data");
+            return Failure<TicketStatusRow>(CoreError("Failed to get ticket status data", "DATA_ERROR"));
+        }
+
+        TicketStatusRow row;
+        row.id = idResult.value();
+        row.flightId = flightIdResult.value();
+        row.status = TicketStatusUtil::fromString(statusResult.value());
+        row.departureTime = departureResult.value();
+        row.version = versionResult.value();
+        return Success(row);
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error finding ticket status: " + std::string(e.what()));
+        return Failure<TicketStatusRow>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Ghi trực tiếp trạng thái mới cho vé nếu phiên bản chưa thay đổi
+ * 
+ * @param id ID của vé
+ * @param status Trạng thái mới
+ * @param expectedVersion Phiên bản đã đọc trước đó (TicketStatusRow::version)
+ * @return Result<bool> True nếu cập nhật thành công, lỗi VERSION_CONFLICT nếu vé đã bị thay đổi
+ */
+Result<bool> TicketRepository::updateStatus(int id, TicketStatus status, int expectedVersion) {
+    Tracing::Span span("ticket.update_status", "repository");
+
+    try {
+        if (_logger) _logger->debug("Updating status of ticket " + std::to_string(id) + " to " + TicketStatusUtil::toString(status));
+
+        auto prepareResult = _connection->prepareStatement(Tables::Ticket::UPDATE_STATUS_QUERY);
+        if (!prepareResult) {
+            if (_logger) _logger->error("Failed to prepare statement for updating ticket status");
+            return Failure<bool>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+        }
+        int stmtId = prepareResult.value();
+
+        auto setStatusResult = _connection->setString(stmtId, 1, TicketStatusUtil::toString(status));
+        auto setIdResult = _connection->setInt(stmtId, 2, id);
+        auto setVersionResult = _connection->setInt(stmtId, 3, expectedVersion);
+        if (!setStatusResult || !setIdResult || !setVersionResult) {
+            _connection->freeStatement(stmtId);
+            if (_logger) _logger->error("Failed to set parameters for updating ticket status");
+            return Failure<bool>(CoreError("Failed to set parameters", "PARAM_FAILED"));
+        }
+
+        auto result = _connection->executeUpdate(stmtId);
+        _connection->freeStatement(stmtId);
+
+        if (!result) {
+            if (_logger) _logger->error("Failed to execute update for ticket status");
+            return Failure<bool>(CoreError("Failed to execute update", "UPDATE_FAILED"));
+        }
+
+        auto versionCheck = checkVersionedUpdate(id, result.value());
+        if (versionCheck) Changes::Feed::getInstance()->publish(Changes::Entity::TICKET, Changes::Kind::UPDATED, id);
+        return versionCheck;
+    } catch (const std::exception& e) {
+        if (_logger) _logger->error("Error updating ticket status: " + std::string(e.what()));
+        return Failure<bool>(CoreError("Database error: " + std::string(e.what()), "DB_ERROR"));
+    }
+}
+
+/**
+ * @brief Kiểm tra kết quả của một UPDATE có điều kiện theo phiên bản
+ * 
+ * Khi không có hàng nào bị ảnh hưởng, chỉ lúc đó mới đọc thêm để phân biệt
+ * vé không tồn tại với vé đã bị phiên khác thay đổi.
+ * 
+ * @param id ID của vé vừa cập nhật
+ * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+ * @return Result<bool> True nếu đúng một hàng được cập nhật, lỗi VERSION_CONFLICT hoặc không tìm thấy
+ */
+Result<bool> TicketRepository::checkVersionedUpdate(const int& id, int affectedRows) {
+    if (affectedRows > 0) {
+        return Success(true);
+    }
+
+    auto existsResult = exists(id);
+    if (!existsResult) {
+        if (_logger) _logger->error("Failed to check ticket existence");
+        return Failure<bool>(CoreError("Failed to check ticket existence", "DB_ERROR"));
+    }
+    if (!existsResult.value()) {
+        if (_logger) _logger->error("Ticket not found with id: " + std::to_string(id));
+        return Failure<bool>(CoreError("Ticket not found with id: " + std::to_string(id), "DB_ERROR"));
+    }
+
+    if (_logger) _logger->warning("Ticket " + std::to_string(id) + " was modified concurrently");
+    return Failure<bool>(CoreError("Ticket was modified by another session", "VERSION_CONFLICT"));
+}
@@ -10,6 +10,8 @@
 #include "../../database/InterfaceDatabaseConnection.h"
 #include "../../utils/Logger.h"
 #include "../../utils/TableConstants.h"
+#include "../PageQuery.h"
+#include "../ReadModels.h"
 #include "AircraftRepository.h"
 #include "FlightRepository.h"
 #include "PassengerRepository.h"
@@ -30,10 +32,41 @@ class TicketRepository : public IRepository<Ticket> {
 private:
     std::shared_ptr<IDatabaseConnection> _connection; ///< Kết nối cơ sở dữ liệu
     std::shared_ptr<Logger> _logger; ///< Logger để ghi log
+    std::shared_ptr<PageAnchors> _pageAnchors = std::make_shared<PageAnchors>(); ///< Mốc để trang kế tiếp nạp theo khóa
     std::shared_ptr<AircraftRepository> _aircraftRepository; ///< Repository để truy vấn máy bay
     std::shared_ptr<FlightRepository> _flightRepository; ///< Repository để truy vấn chuyến bay
     std::shared_ptr<PassengerRepository> _passengerRepository; ///< Repository để truy vấn hành khách
 
+    /**
+     * @brief Cập nhật chỉ các cột đã thay đổi của vé
+     * @param ticket Vé có ít nhất một trường đã được đánh dấu thay đổi
+     * @return Result chứa vé đã cập nhật hoặc lỗi nếu thất bại
+     */
+    Result<Ticket> updateDirtyFields(const Ticket& ticket);
+
+    /**
+     * @brief Giải mã tập kết quả danh sách vé vào cuối rows
+     */
+    Result<size_t> readListRows(IDatabaseResult& result, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Giải mã tập kết quả của truy vấn đếm ghế đã đặt vào cuối rows
+     */
+    Result<size_t> readSeatOccupancy(IDatabaseResult& result, std::vector<SeatOccupancyRow>& rows);
+
+    /**
+     * @brief Giải mã tập kết quả của projection báo cáo vào cuối rows
+     */
+    Result<size_t> readFacts(IDatabaseResult& result, std::vector<TicketFactRow>& rows);
+
+    /**
+     * @brief Kiểm tra UPDATE có điều kiện theo phiên bản đã cập nhật đúng một hàng
+     * @param id ID của vé vừa cập nhật
+     * @param affectedRows Số hàng executeUpdate trả về cho câu UPDATE đó
+     * @return Result chứa true nếu thành công, lỗi VERSION_CONFLICT nếu vé đã bị thay đổi
+     */
+    Result<bool> checkVersionedUpdate(const int& id, int affectedRows);
+
 public:
     /**
      * @brief Constructor tạo TicketRepository với các dependencies cần thiết
@@ -128,6 +161,22 @@ public:
      * @return Result chứa vector các vé của chuyến bay hoặc lỗi nếu thất bại
      */
     Result<std::vector<Ticket>> findByFlightId(int flightId);
+
+    /**
+     * @brief Đếm số vé của một chuyến bay mà không nạp các vé
+     * @param flightId ID của chuyến bay
+     * @return Result chứa số vé của chuyến bay hoặc lỗi nếu thất bại
+     */
+    Result<size_t> countByFlightId(int flightId);
+
+    /**
+     * @brief Giữ ghế và chèn nhiều vé của cùng một chuyến bay trong một transaction
+     * @param tickets Các vé cần tạo; tất cả phải thuộc cùng một chuyến bay
+     * @return Result chứa các vé đã được gán ID, hoặc lỗi SEAT_NOT_AVAILABLE nếu có ghế đã bị đặt
+     * @note Dùng một câu UPDATE để giữ toàn bộ ghế và một câu INSERT nhiều hàng để chèn vé;
+     *       mọi thay đổi bị rollback nếu một bước thất bại
+     */
+    Result<std::vector<Ticket>> createBatch(const std::vector<Ticket>& tickets);
     
     /**
      * @brief Tìm kiếm các vé theo số seri máy bay
@@ -148,6 +197,124 @@ public:
                                              std::optional<int> limit = std::nullopt,
                                              std::optional<std::string> sortBy = std::nullopt,
                                              bool sortAscending = true);
+
+    // Phương thức projection cho màn hình danh sách
+
+    /**
+     * @brief Nạp danh sách vé dạng phẳng cho màn hình danh sách
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng để tái sử dụng giữa các lần làm mới
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Một truy vấn JOIN duy nhất, không gọi findById cho từng vé và không dựng entity
+     */
+    Result<size_t> findAllListRows(std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Nạp một trang vé dạng phẳng, theo thứ tự id
+     * @param offset Số hàng bỏ qua
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Trang đầu và trang ngay sau trang vừa nạp đi theo khóa; chỉ nhảy cóc mới dùng OFFSET
+     */
+    Result<size_t> findListRowsPage(size_t offset, size_t limit, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Nạp trang vé dạng phẳng tiếp theo theo khóa: các hàng có id lớn hơn afterId, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Dùng để đi qua cả bảng mà không phải bỏ qua lại các hàng đầu như OFFSET
+     */
+    Result<size_t> findListRowsAfter(int afterId, size_t limit, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Nạp vé dạng phẳng theo danh sách id bằng một truy vấn, theo thứ tự id
+     * @param ids Các id cần nạp; nên nhỏ (một câu lệnh IN)
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Id không tồn tại đơn giản là không có trong kết quả
+     */
+    Result<size_t> findListRowsByIds(const std::vector<int>& ids, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Đếm số ghế đã đặt theo chuyến bay và hạng ghế
+     * @param rows Vector đích; mỗi phần tử là một cặp (chuyến bay, hạng ghế) có ít nhất một vé
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Một truy vấn GROUP BY; số hàng trả về tỷ lệ với số chuyến bay, không với số vé
+     */
+    Result<size_t> countSeatOccupancy(std::vector<SeatOccupancyRow>& rows);
+
+    /**
+     * @brief Như countSeatOccupancy nhưng chỉ cho các chuyến bay có id trong [firstFlightId, lastFlightId]
+     * @note Dùng cho một trang danh sách chuyến bay (các trang theo thứ tự id)
+     */
+    Result<size_t> countSeatOccupancy(int firstFlightId, int lastFlightId, std::vector<SeatOccupancyRow>& rows);
+
+    /**
+     * @brief Như countSeatOccupancy nhưng chỉ cho các chuyến bay có id trong flightIds
+     * @note Một câu lệnh IN; giữ flightIds nhỏ
+     */
+    Result<size_t> countSeatOccupancy(const std::vector<int>& flightIds, std::vector<SeatOccupancyRow>& rows);
+
+    /**
+     * @brief Đọc dấu mực nước cao của bảng vé (số hàng, id lớn nhất, tổng version)
+     * @return Result chứa dấu, hoặc lỗi nếu thất bại
+     */
+    Result<HighWaterMark> readHighWaterMark();
+
+    /**
+     * @brief Nạp trang kế tiếp (id, version, flight_id) của vé theo khóa, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     */
+    Result<size_t> findVersionsAfter(int afterId, size_t limit, std::vector<RowVersion>& rows);
+
+    /**
+     * @brief Nạp trang kế tiếp các cột báo cáo của vé theo khóa, theo thứ tự id
+     * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích; được xóa nhưng giữ dung lượng
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     * @note Đọc riêng bảng vé, không join hành khách hay chuyến bay; dùng để quét cả bảng khi lập báo cáo
+     */
+    Result<size_t> findFactsAfter(int afterId, size_t limit, std::vector<TicketFactRow>& rows);
+
+    /**
+     * @brief Nạp các cột báo cáo của các vé có id cho trước, theo thứ tự id
+     * @param ids Id cần nạp; id không còn trong bảng bị bỏ qua
+     * @param rows Vector đích
+     * @return Result chứa số hàng đã nạp, hoặc lỗi nếu thất bại
+     */
+    Result<size_t> findFactsByIds(const std::vector<int>& ids, std::vector<TicketFactRow>& rows);
+
+    /**
+     * @brief Đếm số hành khách có vé đang hoạt động và tổng số vé đang hoạt động
+     * @param statistics Đích; chỉ passengersWithActiveBookings và activeTickets được ghi
+     * @return Result chứa số hành khách có vé đang hoạt động, hoặc lỗi nếu thất bại
+     * @note Một truy vấn gộp COUNT(DISTINCT) trả về một hàng; không dựng vé, hành khách hay chuyến bay nào
+     */
+    Result<size_t> countActiveBookings(PassengerStatistics& statistics);
+
+    // Phương thức chuyển trạng thái trực tiếp
+
+    /**
+     * @brief Lấy thông tin trạng thái tối thiểu của vé (id, trạng thái, giờ khởi hành)
+     * @param ticketNumber Số vé cần tra cứu
+     * @return Result chứa TicketStatusRow hoặc lỗi NOT_FOUND nếu không tồn tại
+     */
+    Result<TicketStatusRow> findStatusRow(const TicketNumber& ticketNumber);
+
+    /**
+     * @brief Ghi trạng thái mới cho vé bằng một câu lệnh UPDATE có điều kiện theo phiên bản
+     * @param id ID của vé
+     * @param status Trạng thái mới
+     * @param expectedVersion Phiên bản đã đọc trước đó
+     * @return Result chứa true nếu thành công, lỗi VERSION_CONFLICT nếu vé đã bị thay đổi
+     */
+    Result<bool> updateStatus(int id, TicketStatus status, int expectedVersion);
 };
 
 #endif
\ No newline at end of file
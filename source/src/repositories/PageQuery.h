@@ -0,0 +1,210 @@
+/**
+ * @file PageQuery.h
+ * @brief Thực thi truy vấn danh sách có phân trang dùng chung cho các repository
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Màn hình danh sách chỉ nạp từng trang hàng khi người dùng cuộn tới. Truy vấn trang là truy vấn
+ * danh sách đã ORDER BY id kèm Tables::PAGE_CLAUSE, tham số theo thứ tự (limit, offset).
+ *
+ * ORDER BY khóa chính không làm OFFSET rẻ: cơ sở dữ liệu vẫn đọc rồi bỏ offset hàng phía trước, nên
+ * trang sâu tốn O(offset). Truy vấn theo khóa "WHERE id > ? ORDER BY id LIMIT ?" thì chỉ tốn
+ * O(limit). Vì vậy trang được nạp theo khóa mỗi khi biết id cuối của hàng ngay trước nó: trang đầu,
+ * và trang tiếp theo một trang vừa nạp (cuộn tuần tự), nhờ PageAnchors. Chỉ khi nhảy thẳng tới một
+ * vị trí chưa có mốc mới dùng OFFSET.
+ */
+
+#ifndef PAGE_QUERY_H
+#define PAGE_QUERY_H
+
+#include "../database/InterfaceDatabaseConnection.h"
+#include "../utils/TableConstants.h"
+#include "ReadModels.h"
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Mốc của các trang vừa nạp: vị trí hàng tiếp theo -> id của hàng ngay trước nó
+ *
+ * Một mốc chỉ đúng khi không có hàng nào phía trước nó bị xóa; repository xóa mọi mốc khi xóa hàng
+ * và khi đếm lại (danh sách làm mới luôn đếm trước). Thêm hàng không làm sai mốc vì id mới lớn hơn
+ * mọi id đã có.
+ */
+class PageAnchors {
+private:
+    static constexpr size_t MAX_ANCHORS = 64;
+
+    std::mutex _mutex;
+    std::map<size_t, int> _afterIdAt;
+
+public:
+    std::optional<int> find(size_t offset) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _afterIdAt.find(offset);
+        if (found == _afterIdAt.end()) return std::nullopt;
+        return found->second;
+    }
+
+    void record(size_t offset, int afterId) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_afterIdAt.size() >= MAX_ANCHORS && !_afterIdAt.contains(offset)) _afterIdAt.erase(_afterIdAt.begin());
+        _afterIdAt[offset] = afterId;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _afterIdAt.clear();
+    }
+};
+
+/**
+ * @brief Chuẩn bị, gắn tham số và thực thi một truy vấn trang
+ * @param connection Kết nối cơ sở dữ liệu
+ * @param query Truy vấn kết thúc bằng Tables::PAGE_CLAUSE
+ * @param offset Số hàng bỏ qua
+ * @param limit Số hàng tối đa
+ * @return Tập kết quả hoặc lỗi PREPARE_FAILED / PARAM_FAILED / QUERY_FAILED
+ */
+inline Result<std::unique_ptr<IDatabaseResult>> executePageQuery(IDatabaseConnection& connection, const std::string& query,
+                                                                 size_t offset, size_t limit) {
+    using Rows = std::unique_ptr<IDatabaseResult>;
+    auto prepareResult = connection.prepareStatement(query);
+    if (!prepareResult) return Failure<Rows>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    int stmtId = prepareResult.value();
+
+    auto clamp = [](size_t value) { return static_cast<int>(std::min<size_t>(value, INT_MAX)); };
+    if (!connection.setInt(stmtId, 1, clamp(limit)) || !connection.setInt(stmtId, 2, clamp(offset))) {
+        connection.freeStatement(stmtId);
+        return Failure<Rows>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+    }
+
+    auto result = connection.executeQueryStatement(stmtId);
+    connection.freeStatement(stmtId);
+    if (!result) return Failure<Rows>(CoreError("Failed to execute query", "QUERY_FAILED"));
+    return result;
+}
+
+/**
+ * @brief Chuẩn bị, gắn tham số và thực thi một truy vấn trang theo khóa
+ * @param connection Kết nối cơ sở dữ liệu
+ * @param query Truy vấn dạng "... WHERE id > ? ORDER BY id LIMIT ?"
+ * @param afterId Id lớn nhất của trang trước; 0 cho trang đầu
+ * @param limit Số hàng tối đa
+ * @return Tập kết quả hoặc lỗi PREPARE_FAILED / PARAM_FAILED / QUERY_FAILED
+ */
+inline Result<std::unique_ptr<IDatabaseResult>> executeKeysetQuery(IDatabaseConnection& connection, const std::string& query,
+                                                                   int afterId, size_t limit) {
+    using Rows = std::unique_ptr<IDatabaseResult>;
+    auto prepareResult = connection.prepareStatement(query);
+    if (!prepareResult) return Failure<Rows>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    int stmtId = prepareResult.value();
+
+    if (!connection.setInt(stmtId, 1, afterId) ||
+        !connection.setInt(stmtId, 2, static_cast<int>(std::min<size_t>(limit, INT_MAX)))) {
+        connection.freeStatement(stmtId);
+        return Failure<Rows>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+    }
+
+    auto result = connection.executeQueryStatement(stmtId);
+    connection.freeStatement(stmtId);
+    if (!result) return Failure<Rows>(CoreError("Failed to execute query", "QUERY_FAILED"));
+    return result;
+}
+
+/**
+ * @brief Nạp một trang, theo khóa khi có mốc cho offset và theo OFFSET khi không có
+ * @param pageQuery Truy vấn kết thúc bằng Tables::PAGE_CLAUSE
+ * @param keysetQuery Cùng truy vấn dạng "... WHERE id > ? ORDER BY id LIMIT ?"
+ * @param anchors Mốc của repository; bên gọi ghi mốc mới bằng id cuối của trang đã đọc
+ * @return Tập kết quả hoặc lỗi PREPARE_FAILED / PARAM_FAILED / QUERY_FAILED
+ */
+inline Result<std::unique_ptr<IDatabaseResult>> executePageQuery(IDatabaseConnection& connection, const std::string& pageQuery,
+                                                                 const std::string& keysetQuery, PageAnchors& anchors,
+                                                                 size_t offset, size_t limit) {
+    if (offset == 0) return executeKeysetQuery(connection, keysetQuery, 0, limit);
+    if (auto afterId = anchors.find(offset)) return executeKeysetQuery(connection, keysetQuery, *afterId, limit);
+    return executePageQuery(connection, pageQuery, offset, limit);
+}
+
+/**
+ * @brief Chuẩn bị, gắn danh sách id và thực thi một truy vấn "... WHERE id IN (?, ...)"
+ * @param connection Kết nối cơ sở dữ liệu
+ * @param query Truy vấn có đúng ids.size() placeholder
+ * @param ids Các id cần tìm
+ * @return Tập kết quả hoặc lỗi PREPARE_FAILED / PARAM_FAILED / QUERY_FAILED
+ */
+inline Result<std::unique_ptr<IDatabaseResult>> executeIdListQuery(IDatabaseConnection& connection, const std::string& query,
+                                                                   const std::vector<int>& ids) {
+    using Rows = std::unique_ptr<IDatabaseResult>;
+    auto prepareResult = connection.prepareStatement(query);
+    if (!prepareResult) return Failure<Rows>(CoreError("Failed to prepare statement", "PREPARE_FAILED"));
+    int stmtId = prepareResult.value();
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (!connection.setInt(stmtId, static_cast<int>(i) + 1, ids[i])) {
+            connection.freeStatement(stmtId);
+            return Failure<Rows>(CoreError("Failed to set parameter", "PARAM_FAILED"));
+        }
+    }
+
+    auto result = connection.executeQueryStatement(stmtId);
+    connection.freeStatement(stmtId);
+    if (!result) return Failure<Rows>(CoreError("Failed to execute query", "QUERY_FAILED"));
+    return result;
+}
+
+/**
+ * @brief Thực thi truy vấn dấu mực nước cao "SELECT COUNT(*), MAX(id), SUM(version) FROM bảng"
+ * @param connection Kết nối cơ sở dữ liệu
+ * @param query Truy vấn theo thứ tự cột Tables::HighWaterMarkColumn
+ * @return Dấu của bảng (mọi trường là 0 khi bảng rỗng), hoặc lỗi QUERY_FAILED / DATA_ERROR
+ * @note SUM trên MySQL trả về DECIMAL nên được đọc bằng getDouble (chính xác tới 2^53)
+ */
+inline Result<HighWaterMark> executeHighWaterMarkQuery(IDatabaseConnection& connection, const std::string& query) {
+    auto result = connection.executeQuery(query);
+    if (!result) return Failure<HighWaterMark>(CoreError("Failed to execute query", "QUERY_FAILED"));
+    auto& rows = *result.value();
+    HighWaterMark mark;
+    if (!rows.next().value()) return Success(mark);
+
+    auto count = rows.getInt(Tables::MARK_COUNT);
+    if (!count) return Failure<HighWaterMark>(CoreError("Failed to get high-water mark", "DATA_ERROR"));
+    if (count.value() == 0) return Success(mark);
+    auto maxId = rows.getInt(Tables::MARK_MAX_ID);
+    auto versionSum = rows.getDouble(Tables::MARK_VERSION_SUM);
+    if (!maxId || !versionSum) return Failure<HighWaterMark>(CoreError("Failed to get high-water mark", "DATA_ERROR"));
+    mark.count = count.value();
+    mark.maxId = maxId.value();
+    mark.versionSum = static_cast<int64_t>(versionSum.value());
+    return Success(mark);
+}
+
+/**
+ * @brief Giải mã kết quả truy vấn phiên bản (Tables::RowVersionColumn) vào cuối rows
+ * @param withFlightId Truy vấn có cột flight_id (bảng vé)
+ */
+inline Result<size_t> readRowVersions(IDatabaseResult& result, bool withFlightId, std::vector<RowVersion>& rows) {
+    while (result.next().value()) {
+        auto id = result.getInt(Tables::ROW_VERSION_ID);
+        auto version = result.getInt(Tables::ROW_VERSION_VALUE);
+        if (!id || !version) return Failure<size_t>(CoreError("Failed to get row version", "DATA_ERROR"));
+        auto& row = rows.emplace_back();
+        row.id = id.value();
+        row.version = version.value();
+        if (withFlightId) {
+            auto flightId = result.getInt(Tables::ROW_VERSION_FLIGHT_ID);
+            if (!flightId) return Failure<size_t>(CoreError("Failed to get row version", "DATA_ERROR"));
+            row.flightId = flightId.value();
+        }
+    }
+    return Success(rows.size());
+}
+
+#endif // PAGE_QUERY_H
@@ -0,0 +1,213 @@
+/**
+ * @file ReadModels.h
+ * @brief Các cấu trúc projection phẳng (read model) phục vụ màn hình danh sách
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Các màn hình danh sách chỉ hiển thị vài cột nhưng trước đây phải dựng đầy đủ
+ * entity (value object đã validate, đồ thị shared_ptr, bản đồ ghế). Các struct
+ * trong file này chỉ chứa dữ liệu thô cần hiển thị, được repository giải mã
+ * trực tiếp theo chỉ số cột vào vector đã cấp phát trước, không tạo đối tượng
+ * domain nào.
+ */
+
+#ifndef READ_MODELS_H
+#define READ_MODELS_H
+
+#include "../core/value_objects/flight_status/FlightStatus.h"
+#include "../core/value_objects/ticket_status/TicketStatus.h"
+#include <cstdint>
+#include <string>
+#include <ctime>
+
+/**
+ * @brief Một hàng máy bay cho danh sách máy bay
+ */
+struct AircraftListRow {
+    int id = 0;                         ///< ID máy bay
+    std::string serial;                 ///< Số serial (số đăng ký)
+    std::string model;                  ///< Mẫu máy bay
+    int economySeats = 0;               ///< Số ghế hạng phổ thông
+    int businessSeats = 0;              ///< Số ghế hạng thương gia
+    int firstSeats = 0;                 ///< Số ghế hạng nhất
+
+    /**
+     * @brief Tổng số ghế của máy bay
+     */
+    int totalSeats() const {
+        return economySeats + businessSeats + firstSeats;
+    }
+};
+
+/**
+ * @brief Một hàng tóm tắt chuyến bay cho danh sách chuyến bay
+ *
+ * Số ghế đã đặt theo từng hạng mặc định là 0 và được tầng trên điền vào
+ * khi cần hiển thị tình trạng ghế.
+ */
+struct FlightSummaryRow {
+    int id = 0;                         ///< ID chuyến bay
+    std::string flightNumber;           ///< Số hiệu chuyến bay
+    std::string departureCode;          ///< Mã sân bay khởi hành
+    std::string departureName;          ///< Tên sân bay khởi hành
+    std::string arrivalCode;            ///< Mã sân bay đến
+    std::string arrivalName;            ///< Tên sân bay đến
+    std::tm departureTime{};            ///< Thời gian khởi hành
+    std::tm arrivalTime{};              ///< Thời gian đến
+    FlightStatus status = FlightStatus::SCHEDULED; ///< Trạng thái chuyến bay
+    std::string aircraftSerial;         ///< Số serial máy bay
+    int economySeats = 0;               ///< Tổng số ghế hạng phổ thông
+    int businessSeats = 0;              ///< Tổng số ghế hạng thương gia
+    int firstSeats = 0;                 ///< Tổng số ghế hạng nhất
+    int bookedEconomy = 0;              ///< Số ghế phổ thông đã đặt
+    int bookedBusiness = 0;             ///< Số ghế thương gia đã đặt
+    int bookedFirst = 0;                ///< Số ghế hạng nhất đã đặt
+
+    /**
+     * @brief Tổng số ghế của máy bay
+     * @return Tổng số ghế của cả ba hạng
+     */
+    int totalSeats() const {
+        return economySeats + businessSeats + firstSeats;
+    }
+
+    /**
+     * @brief Tổng số ghế còn trống
+     * @return Tổng số ghế trừ đi số ghế đã đặt
+     */
+    int availableSeats() const {
+        return totalSeats() - (bookedEconomy + bookedBusiness + bookedFirst);
+    }
+};
+
+/**
+ * @brief Số ghế đã đặt của một hạng ghế trên một chuyến bay
+ *
+ * Mỗi hàng là một nhóm của truy vấn gộp GROUP BY chuyến bay, hạng ghế trên bảng vé.
+ */
+struct SeatOccupancyRow {
+    int flightId = 0;                   ///< ID chuyến bay
+    char seatClass = 0;                 ///< Mã hạng ghế (ký tự đầu của số ghế: E/B/F)
+    int booked = 0;                     ///< Số vé của hạng ghế này
+};
+
+/**
+ * @brief Dấu mực nước cao của một bảng có cột phiên bản, đọc bằng một truy vấn gộp
+ *
+ * Thêm hàng làm tăng count và maxId, xóa hàng làm giảm count, mỗi lệnh UPDATE tăng version nên
+ * tăng versionSum. Hai dấu bằng nhau nghĩa là bảng không đổi giữa hai lần đọc.
+ */
+struct HighWaterMark {
+    int64_t count = 0;                  ///< Số hàng
+    int64_t maxId = 0;                  ///< Id lớn nhất; 0 khi bảng rỗng
+    int64_t versionSum = 0;             ///< Tổng cột version
+
+    bool operator==(const HighWaterMark&) const = default;
+};
+
+/**
+ * @brief Id và phiên bản của một hàng, để so với bản đã lưu mà không đọc lại cả hàng
+ */
+struct RowVersion {
+    int id = 0;                         ///< ID hàng
+    int version = 0;                    ///< Giá trị cột version
+    int flightId = 0;                   ///< Chỉ với vé: chuyến bay của vé
+};
+
+/**
+ * @brief Một hàng vé cho danh sách vé
+ */
+struct TicketListRow {
+    int id = 0;                         ///< ID vé
+    std::string ticketNumber;           ///< Số vé
+    int passengerId = 0;                ///< ID hành khách
+    std::string passportNumber;         ///< Số hộ chiếu hành khách
+    int flightId = 0;                   ///< ID chuyến bay
+    std::string flightNumber;           ///< Số hiệu chuyến bay
+    std::string seatNumber;             ///< Số ghế (ví dụ: E01, B001)
+    double price = 0.0;                 ///< Giá vé
+    std::string currency;               ///< Đơn vị tiền tệ
+    TicketStatus status = TicketStatus::PENDING; ///< Trạng thái vé
+};
+
+/**
+ * @brief Các cột của một vé cần cho báo cáo doanh thu, không join bảng nào
+ */
+struct TicketFactRow {
+    int id = 0;                         ///< ID vé
+    int passengerId = 0;                ///< ID hành khách
+    int flightId = 0;                   ///< ID chuyến bay
+    char seatClass = 0;                 ///< Mã hạng ghế (ký tự đầu của số ghế: E/B/F)
+    double price = 0.0;                 ///< Giá vé
+    std::string currency;               ///< Đơn vị tiền tệ
+    TicketStatus status = TicketStatus::PENDING; ///< Trạng thái vé
+};
+
+/**
+ * @brief Thông tin tối thiểu để kiểm tra và chuyển trạng thái vé
+ */
+struct TicketStatusRow {
+    int id = 0;                         ///< ID vé
+    int flightId = 0;                   ///< ID chuyến bay
+    TicketStatus status = TicketStatus::PENDING; ///< Trạng thái hiện tại
+    std::tm departureTime{};            ///< Thời gian khởi hành của chuyến bay
+    int version = 0;                    ///< Phiên bản bản ghi vé, dùng cho UPDATE có điều kiện
+};
+
+/**
+ * @brief Thông tin tối thiểu để kiểm tra và chuyển trạng thái chuyến bay
+ */
+struct FlightStatusRow {
+    int id = 0;                         ///< ID chuyến bay
+    FlightStatus status = FlightStatus::SCHEDULED; ///< Trạng thái hiện tại
+    std::tm departureTime{};            ///< Thời gian khởi hành
+    int version = 0;                    ///< Phiên bản bản ghi chuyến bay, dùng cho UPDATE có điều kiện
+};
+
+/**
+ * @brief Một hàng hành khách cho danh sách hành khách
+ */
+struct PassengerListRow {
+    int id = 0;                         ///< ID hành khách
+    std::string passportNumber;         ///< Số hộ chiếu
+    std::string name;                   ///< Họ tên
+    std::string email;                  ///< Email
+    std::string phone;                  ///< Số điện thoại
+    std::string address;                ///< Địa chỉ
+};
+
+/**
+ * @brief Thống kê hành khách cho màn hình thống kê
+ *
+ * Vé đang hoạt động là vé chưa hủy và chưa hoàn tiền, cùng quy tắc với
+ * PassengerService::hasActiveBookings và getTotalFlightCount.
+ */
+struct PassengerStatistics {
+    size_t totalPassengers = 0;                 ///< Tổng số hành khách
+    size_t passengersWithActiveBookings = 0;    ///< Số hành khách có ít nhất một vé đang hoạt động
+    size_t activeTickets = 0;                   ///< Tổng số vé đang hoạt động (số chuyến bay đã đặt)
+
+    /**
+     * @brief Vé có được tính là đặt chỗ đang hoạt động không
+     */
+    static bool isActive(TicketStatus status) {
+        return status != TicketStatus::CANCELLED && status != TicketStatus::REFUNDED;
+    }
+
+    /**
+     * @brief Số chuyến bay trung bình của mỗi hành khách
+     */
+    double averageFlightsPerPassenger() const {
+        return totalPassengers > 0 ? static_cast<double>(activeTickets) / totalPassengers : 0.0;
+    }
+
+    /**
+     * @brief Tỷ lệ phần trăm hành khách có đặt chỗ đang hoạt động
+     */
+    double activeBookingPercentage() const {
+        return totalPassengers > 0 ? static_cast<double>(passengersWithActiveBookings) * 100.0 / totalPassengers : 0.0;
+    }
+};
+
+#endif // READ_MODELS_H
@@ -0,0 +1,431 @@
+#include "BookingServer.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Server {
+
+namespace {
+    constexpr uint64_t LISTEN_TOKEN = UINT64_MAX;
+    constexpr uint64_t WAKE_TOKEN = UINT64_MAX - 1;
+    constexpr int MAX_EVENTS = 256;
+    constexpr size_t READ_CHUNK = 64 * 1024;
+
+    bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    std::string systemError(const std::string& what) {
+        return what + ": " + std::strerror(errno);
+    }
+
+    Metrics::Gauge& clientsGauge() {
+        static Metrics::Gauge& gauge = Metrics::MetricsRegistry::getInstance()->gauge(
+            "airlines_server_clients", "Connected booking server clients");
+        return gauge;
+    }
+
+    Metrics::Gauge& queueGauge() {
+        static Metrics::Gauge& gauge = Metrics::MetricsRegistry::getInstance()->gauge(
+            "airlines_server_queued_requests", "Requests waiting for a booking server worker");
+        return gauge;
+    }
+
+    Metrics::Counter& rejectedCounter() {
+        static Metrics::Counter& counter = Metrics::MetricsRegistry::getInstance()->counter(
+            "airlines_server_rejected_requests_total", "Requests rejected because the worker queue was full");
+        return counter;
+    }
+}
+
+struct BookingServer::ClientConnection {
+    uint64_t id = 0;
+    int fd = -1;
+    FrameDecoder decoder;
+    std::string output;
+    size_t outputOffset = 0;
+    size_t queuedRequests = 0;  ///< Yêu cầu đã vào hàng đợi mà chưa có phản hồi
+    bool readPaused = false;    ///< Đang ngừng đọc do backpressure
+    uint32_t interest = EPOLLIN;    ///< Sự kiện đang đăng ký với epoll
+
+    bool hasPendingOutput() const { return outputOffset < output.size(); }
+    size_t pendingOutput() const { return output.size() - outputOffset; }
+};
+
+BookingServer::BookingServer(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Logger> logger, ServerConfig config)
+    : _pool(std::move(pool)), _logger(std::move(logger)), _config(std::move(config)) {}
+
+BookingServer::~BookingServer() {
+    stop();
+}
+
+VoidResult BookingServer::start() {
+    if (_running) return Failure(CoreError("Booking server is already running", "SERVER_START_FAILED"));
+    if (_config.workers == 0) return Failure(CoreError("Booking server needs at least one worker", "SERVER_START_FAILED"));
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* address = nullptr;
+    std::string service = std::to_string(_config.port);
+    if (int status = getaddrinfo(_config.host.c_str(), service.c_str(), &hints, &address); status != 0) {
+        return Failure(CoreError("Cannot resolve " + _config.host + ": " + gai_strerror(status), "SERVER_START_FAILED"));
+    }
+
+    auto fail = [this](const std::string& message) {
+        if (_listenFd >= 0) close(_listenFd);
+        if (_epollFd >= 0) close(_epollFd);
+        if (_wakeFd >= 0) close(_wakeFd);
+        _listenFd = _epollFd = _wakeFd = -1;
+        return Failure(CoreError(message, "SERVER_START_FAILED"));
+    };
+
+    _listenFd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (_listenFd < 0) {
+        freeaddrinfo(address);
+        return fail(systemError("socket"));
+    }
+    int reuse = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    int bound = bind(_listenFd, address->ai_addr, address->ai_addrlen);
+    freeaddrinfo(address);
+    if (bound != 0) return fail(systemError("bind " + _config.host + ":" + service));
+    if (listen(_listenFd, SOMAXCONN) != 0) return fail(systemError("listen"));
+    if (!setNonBlocking(_listenFd)) return fail(systemError("fcntl"));
+
+    sockaddr_in local{};
+    socklen_t length = sizeof(local);
+    getsockname(_listenFd, reinterpret_cast<sockaddr*>(&local), &length);
+    _boundPort = ntohs(local.sin_port);
+
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd < 0) return fail(systemError("epoll_create1"));
+    _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeFd < 0) return fail(systemError("eventfd"));
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TOKEN;
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, _listenFd, &event);
+    event.data.u64 = WAKE_TOKEN;
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeFd, &event);
+
+    _stopping = false;
+    _running = true;
+    for (size_t i = 0; i < _config.workers; ++i) {
+        _workerThreads.emplace_back([this] { workerLoop(); });
+    }
+    _reactorThread = std::thread([this] { reactorLoop(); });
+
+    if (_logger) {
+        _logger->info("Booking server listening on " + _config.host + ":" + std::to_string(_boundPort) + " with " +
+                      std::to_string(_config.workers) + " workers and " + std::to_string(_pool->size()) + " database sessions");
+    }
+    return Success();
+}
+
+void BookingServer::stop() {
+    if (!_running.exchange(false)) return;
+
+    _stopping = true;
+    wake();
+    if (_reactorThread.joinable()) _reactorThread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(_jobsMutex);
+        queueGauge().add(-static_cast<int64_t>(_jobs.size()));
+        _jobs.clear();
+    }
+    _jobsReady.notify_all();
+    for (auto& worker : _workerThreads) worker.join();
+    _workerThreads.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(_completionsMutex);
+        _completions.clear();
+    }
+    close(_listenFd);
+    close(_epollFd);
+    close(_wakeFd);
+    _listenFd = _epollFd = _wakeFd = -1;
+
+    if (_logger) _logger->info("Booking server stopped");
+}
+
+void BookingServer::wake() {
+    uint64_t one = 1;
+    if (write(_wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN && _logger) {
+        _logger->error(systemError("Failed to wake booking server reactor"));
+    }
+}
+
+// === Reactor ===
+
+void BookingServer::reactorLoop() {
+    epoll_event events[MAX_EVENTS];
+    while (!_stopping) {
+        int count = epoll_wait(_epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            if (_logger) _logger->error(systemError("epoll_wait"));
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            uint64_t token = events[i].data.u64;
+            if (token == LISTEN_TOKEN) {
+                acceptClients();
+                continue;
+            }
+            if (token == WAKE_TOKEN) {
+                uint64_t value;
+                while (read(_wakeFd, &value, sizeof(value)) > 0) {}
+                deliverCompletions();
+                continue;
+            }
+
+            auto it = _clients.find(token);
+            if (it == _clients.end()) continue;   // Đã đóng ở sự kiện trước trong cùng lượt
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeClient(token);
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                readClient(*it->second);
+                it = _clients.find(token);
+                if (it == _clients.end()) continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                writeClient(*it->second);
+            }
+        }
+    }
+
+    while (!_clients.empty()) closeClient(_clients.begin()->first);
+}
+
+void BookingServer::acceptClients() {
+    for (;;) {
+        int fd = accept4(_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && _logger) {
+                _logger->error(systemError("accept"));
+            }
+            return;
+        }
+        if (_clients.size() >= _config.maxConnections) {
+            close(fd);
+            continue;
+        }
+
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        auto client = std::make_unique<ClientConnection>();
+        client->id = _nextClientId++;
+        client->fd = fd;
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = client->id;
+        if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        _clients.emplace(client->id, std::move(client));
+        clientsGauge().inc();
+    }
+}
+
+void BookingServer::readClient(ClientConnection& client) {
+    char buffer[READ_CHUNK];
+    uint64_t id = client.id;
+    while (!client.readPaused) {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            // Tách khung sau từng lần đọc: header quá lớn bị phát hiện ngay, bộ đệm chỉ giữ khung dở dang
+            client.decoder.append(buffer, static_cast<size_t>(received));
+            if (!processFrames(client)) return;
+            if (!client.readPaused && client.decoder.buffered() > _config.maxClientInputBytes) {
+                if (_logger) _logger->warning("Closing booking client: input buffer limit exceeded");
+                closeClient(id);
+                return;
+            }
+            continue;
+        }
+        if (received == 0) {
+            closeClient(id);
+            return;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        closeClient(id);
+        return;
+    }
+}
+
+bool BookingServer::isBackpressured(const ClientConnection& client) const {
+    return client.pendingOutput() > _config.maxClientOutputBytes ||
+           client.queuedRequests >= _config.maxClientQueuedRequests;
+}
+
+bool BookingServer::processFrames(ClientConnection& client) {
+    uint64_t id = client.id;
+    while (!isBackpressured(client)) {
+        auto frame = client.decoder.next();
+        if (!frame) {
+            if (_logger) _logger->warning("Closing booking client: " + frame.error().message);
+            closeClient(id);
+            return false;
+        }
+        if (!frame.value()) break;
+
+        bool accepted = false;
+        {
+            std::lock_guard<std::mutex> lock(_jobsMutex);
+            if (_jobs.size() < _config.maxQueuedRequests) {
+                _jobs.push_back(Job{id, std::move(*frame.value())});
+                accepted = true;
+            }
+        }
+        if (accepted) {
+            ++client.queuedRequests;
+            queueGauge().inc();
+            _jobsReady.notify_one();
+            continue;
+        }
+
+        rejectedCounter().inc();
+        auto request = RequestDispatcher::parseRequest(*frame.value());
+        Json requestId = request ? request.value().id : Json();
+        queueResponse(client, encodeFrame(RequestDispatcher::formatResponse(
+            requestId, Failure<Json>(CoreError("Server is busy, retry later", "SERVER_BUSY")))));
+        if (_clients.find(id) == _clients.end()) return false;
+    }
+
+    // Khung còn lại trong bộ đệm được xử lý khi resumeReading mở lại
+    bool paused = isBackpressured(client);
+    if (paused != client.readPaused) {
+        client.readPaused = paused;
+        updateInterest(client);
+    }
+    return true;
+}
+
+void BookingServer::resumeReading(ClientConnection& client) {
+    if (!client.readPaused || isBackpressured(client)) return;
+    client.readPaused = false;
+    if (!processFrames(client)) return;
+    updateInterest(client);
+}
+
+void BookingServer::writeClient(ClientConnection& client) {
+    while (client.hasPendingOutput()) {
+        ssize_t sent = send(client.fd, client.output.data() + client.outputOffset,
+                            client.output.size() - client.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            client.outputOffset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        closeClient(client.id);
+        return;
+    }
+    if (!client.hasPendingOutput()) {
+        client.output.clear();
+        client.outputOffset = 0;
+    }
+    updateInterest(client);
+    resumeReading(client);
+}
+
+void BookingServer::queueResponse(ClientConnection& client, std::string frame) {
+    if (client.output.empty()) {
+        client.output = std::move(frame);
+    } else {
+        client.output += frame;
+    }
+    writeClient(client);
+}
+
+void BookingServer::updateInterest(ClientConnection& client) {
+    // EPOLLERR/EPOLLHUP vẫn được báo khi không đăng ký gì, nên client đang ngừng đọc vẫn được đóng đúng lúc
+    uint32_t interest = (client.readPaused ? 0u : uint32_t(EPOLLIN)) | (client.hasPendingOutput() ? uint32_t(EPOLLOUT) : 0u);
+    if (interest == client.interest) return;
+    epoll_event event{};
+    event.events = interest;
+    event.data.u64 = client.id;
+    epoll_ctl(_epollFd, EPOLL_CTL_MOD, client.fd, &event);
+    client.interest = interest;
+}
+
+void BookingServer::closeClient(uint64_t id) {
+    auto it = _clients.find(id);
+    if (it == _clients.end()) return;
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    _clients.erase(it);
+    clientsGauge().dec();
+}
+
+void BookingServer::deliverCompletions() {
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(_completionsMutex);
+        completions.swap(_completions);
+    }
+    for (auto& completion : completions) {
+        // Client có thể đã ngắt kết nối trong lúc worker xử lý
+        auto it = _clients.find(completion.client);
+        if (it == _clients.end()) continue;
+        --it->second->queuedRequests;
+        queueResponse(*it->second, std::move(completion.frame));
+    }
+}
+
+// === Workers ===
+
+void BookingServer::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_jobsMutex);
+            _jobsReady.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+            if (_stopping) return;
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+        queueGauge().dec();
+
+        std::string frame = encodeFrame(handle(job.payload));
+        {
+            std::lock_guard<std::mutex> lock(_completionsMutex);
+            _completions.push_back(Completion{job.client, std::move(frame)});
+        }
+        wake();
+    }
+}
+
+std::string BookingServer::handle(const std::string& payload) {
+    auto request = RequestDispatcher::parseRequest(payload);
+    if (!request) return RequestDispatcher::formatResponse(Json(), Failure<Json>(request.error()));
+
+    auto lease = _pool->acquire(_config.leaseTimeout);
+    if (!lease) return RequestDispatcher::formatResponse(request.value().id, Failure<Json>(lease.error()));
+
+    // ApplicationContext chỉ là vài shared_ptr; dựng mới mỗi lượt để luôn gắn với đúng session đang mượn
+    ApplicationContext context(lease.value().connection(), _logger);
+    return RequestDispatcher::formatResponse(request.value().id, _dispatcher.dispatch(context, request.value()));
+}
+
+} // namespace Server
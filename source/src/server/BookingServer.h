@@ -0,0 +1,143 @@
+/**
+ * @file BookingServer.h
+ * @brief Máy chủ đặt vé: reactor epoll một luồng + worker pool + ConnectionPool
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi đại lý trước đây chạy giao diện riêng với một session MySQL riêng. airlines_server cho
+ * nhiều client dùng chung một tiến trình: tập session có giới hạn (ConnectionPool), statement
+ * đã chuẩn bị và cache của driver luôn ấm.
+ *
+ * Luồng reactor sở hữu mọi socket: accept, đọc không chặn, tách khung (Protocol.h) và đẩy
+ * yêu cầu vào hàng đợi có giới hạn. Worker lấy yêu cầu, mượn một kết nối trong pool cho cả
+ * lượt xử lý (transaction của service nằm trọn trên session đó), dựng ApplicationContext trên
+ * kết nối ấy rồi gọi RequestDispatcher. Phản hồi được trả về reactor qua hàng đợi hoàn tất và
+ * eventfd; reactor ghi ra socket, phần chưa ghi hết chờ EPOLLOUT.
+ *
+ * Khi hàng đợi đầy, yêu cầu bị từ chối ngay với SERVER_BUSY thay vì làm tăng độ trễ của mọi
+ * yêu cầu khác. Mỗi client còn bị giới hạn riêng: khung được tách ngay sau mỗi lần recv và
+ * byte chưa thành khung không vượt maxClientInputBytes; client có quá nhiều phản hồi chưa gửi
+ * hoặc yêu cầu đang xử lý thì tạm ngừng đọc (bỏ EPOLLIN) cho đến khi xả bớt, để một client gửi
+ * dồn không chiếm hết bộ nhớ và hàng đợi. Chỉ hỗ trợ Linux (epoll, eventfd).
+ */
+
+#ifndef SERVER_BOOKING_SERVER_H
+#define SERVER_BOOKING_SERVER_H
+
+#include "Protocol.h"
+#include "RequestDispatcher.h"
+#include "../database/ConnectionPool.h"
+#include "../utils/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Server {
+
+struct ServerConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 7070;                       ///< 0 để hệ điều hành chọn cổng trống (xem BookingServer::port())
+    size_t workers = 4;
+    size_t maxQueuedRequests = 4096;
+    size_t maxConnections = 1024;
+    size_t maxClientInputBytes = FRAME_HEADER_SIZE + MAX_FRAME_SIZE;   ///< Byte chưa thành khung; vượt thì đóng kết nối
+    size_t maxClientOutputBytes = 4u << 20;     ///< Phản hồi chưa gửi được; vượt thì ngừng đọc client
+    size_t maxClientQueuedRequests = 64;        ///< Yêu cầu đang chờ hoặc đang xử lý; đạt thì ngừng đọc client
+    std::chrono::milliseconds leaseTimeout{5000};   ///< Thời gian chờ tối đa một kết nối trong pool
+};
+
+class BookingServer {
+private:
+    struct ClientConnection;
+
+    struct Job {
+        uint64_t client;
+        std::string payload;
+    };
+
+    struct Completion {
+        uint64_t client;
+        std::string frame;
+    };
+
+    std::shared_ptr<ConnectionPool> _pool;
+    std::shared_ptr<Logger> _logger;
+    ServerConfig _config;
+    RequestDispatcher _dispatcher;
+
+    int _listenFd = -1;
+    int _epollFd = -1;
+    int _wakeFd = -1;
+    uint16_t _boundPort = 0;
+
+    std::unordered_map<uint64_t, std::unique_ptr<ClientConnection>> _clients;   ///< Chỉ luồng reactor truy cập
+    uint64_t _nextClientId = 0;
+
+    std::deque<Job> _jobs;
+    std::mutex _jobsMutex;
+    std::condition_variable _jobsReady;
+
+    std::vector<Completion> _completions;
+    std::mutex _completionsMutex;
+
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _stopping{false};
+    std::thread _reactorThread;
+    std::vector<std::thread> _workerThreads;
+
+    void reactorLoop();
+    void workerLoop();
+
+    void acceptClients();
+    void readClient(ClientConnection& client);
+    bool processFrames(ClientConnection& client);
+    bool isBackpressured(const ClientConnection& client) const;
+    void resumeReading(ClientConnection& client);
+    void writeClient(ClientConnection& client);
+    void closeClient(uint64_t id);
+    void deliverCompletions();
+    void queueResponse(ClientConnection& client, std::string frame);
+    void updateInterest(ClientConnection& client);
+    void wake();
+
+    std::string handle(const std::string& payload);
+
+public:
+    BookingServer(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Logger> logger, ServerConfig config);
+    ~BookingServer();
+
+    BookingServer(const BookingServer&) = delete;
+    BookingServer& operator=(const BookingServer&) = delete;
+
+    /// Thêm phương thức ngoài bộ mặc định; phải gọi trước start()
+    RequestDispatcher& dispatcher() { return _dispatcher; }
+
+    /**
+     * @brief Mở socket lắng nghe rồi chạy reactor và worker trên các luồng nền
+     * @return Lỗi SERVER_START_FAILED nếu không bind/listen được hoặc server đang chạy
+     */
+    VoidResult start();
+
+    /**
+     * @brief Dừng nhận kết nối, đóng mọi client và chờ các luồng kết thúc
+     *
+     * Yêu cầu đang xử lý được làm xong nhưng phản hồi của chúng bị bỏ. Gọi nhiều lần không sao.
+     */
+    void stop();
+
+    /// Cổng thực sự đang lắng nghe (khác config khi config.port == 0)
+    uint16_t port() const { return _boundPort; }
+};
+
+} // namespace Server
+
+#endif // SERVER_BOOKING_SERVER_H
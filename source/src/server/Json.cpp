@@ -0,0 +1,315 @@
+#include "Json.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Server {
+
+namespace {
+    /// Giới hạn lồng nhau để thông điệp độc hại không làm tràn stack
+    constexpr int MAX_DEPTH = 64;
+
+    class Parser {
+    private:
+        const std::string& _text;
+        size_t _pos = 0;
+
+        CoreError error(const std::string& message) const {
+            return CoreError(message + " at offset " + std::to_string(_pos), "INVALID_JSON");
+        }
+
+        void skipWhitespace() {
+            while (_pos < _text.size() && (_text[_pos] == ' ' || _text[_pos] == '\t' || _text[_pos] == '\n' || _text[_pos] == '\r')) {
+                ++_pos;
+            }
+        }
+
+        bool consume(const char* literal) {
+            size_t length = std::char_traits<char>::length(literal);
+            if (_text.compare(_pos, length, literal) != 0) return false;
+            _pos += length;
+            return true;
+        }
+
+        static void appendUtf8(std::string& out, uint32_t codePoint) {
+            if (codePoint < 0x80) {
+                out += static_cast<char>(codePoint);
+            } else if (codePoint < 0x800) {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else if (codePoint < 0x10000) {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        Result<uint32_t> parseHex4() {
+            if (_pos + 4 > _text.size()) return Failure<uint32_t>(error("Truncated \\u escape"));
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = _text[_pos++];
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= c - '0';
+                else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+                else return Failure<uint32_t>(error("Invalid \\u escape"));
+            }
+            return Success(value);
+        }
+
+        Result<std::string> parseString() {
+            ++_pos;  // '"'
+            std::string out;
+            while (_pos < _text.size()) {
+                char c = _text[_pos++];
+                if (c == '"') return Success(std::move(out));
+                if (static_cast<unsigned char>(c) < 0x20) return Failure<std::string>(error("Control character in string"));
+                if (c != '\\') {
+                    out += c;
+                    continue;
+                }
+                if (_pos >= _text.size()) break;
+                char escape = _text[_pos++];
+                switch (escape) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        auto high = parseHex4();
+                        if (!high) return Failure<std::string>(high.error());
+                        uint32_t codePoint = high.value();
+                        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                            if (!consume("\\u")) return Failure<std::string>(error("Unpaired surrogate"));
+                            auto low = parseHex4();
+                            if (!low) return Failure<std::string>(low.error());
+                            if (low.value() < 0xDC00 || low.value() > 0xDFFF) return Failure<std::string>(error("Unpaired surrogate"));
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low.value() - 0xDC00);
+                        }
+                        appendUtf8(out, codePoint);
+                        break;
+                    }
+                    default:
+                        return Failure<std::string>(error("Invalid escape"));
+                }
+            }
+            return Failure<std::string>(error("Unterminated string"));
+        }
+
+        Result<Json> parseNumber() {
+            size_t start = _pos;
+            if (_text[_pos] == '-') ++_pos;
+            while (_pos < _text.size() && (std::isdigit(static_cast<unsigned char>(_text[_pos])) || _text[_pos] == '.' ||
+                                           _text[_pos] == 'e' || _text[_pos] == 'E' || _text[_pos] == '+' || _text[_pos] == '-')) {
+                ++_pos;
+            }
+            std::string token = _text.substr(start, _pos - start);
+            char* end = nullptr;
+            double value = std::strtod(token.c_str(), &end);
+            if (token.empty() || end != token.c_str() + token.size() || !std::isfinite(value)) {
+                _pos = start;
+                return Failure<Json>(error("Invalid number"));
+            }
+            return Success(Json(value));
+        }
+
+    public:
+        explicit Parser(const std::string& text) : _text(text) {}
+
+        Result<Json> parseValue(int depth) {
+            if (depth > MAX_DEPTH) return Failure<Json>(error("Nesting too deep"));
+            skipWhitespace();
+            if (_pos >= _text.size()) return Failure<Json>(error("Unexpected end of input"));
+
+            char c = _text[_pos];
+            if (c == '{') {
+                ++_pos;
+                Json::Object object;
+                skipWhitespace();
+                if (_pos < _text.size() && _text[_pos] == '}') {
+                    ++_pos;
+                    return Success(Json(std::move(object)));
+                }
+                for (;;) {
+                    skipWhitespace();
+                    if (_pos >= _text.size() || _text[_pos] != '"') return Failure<Json>(error("Expected object key"));
+                    auto key = parseString();
+                    if (!key) return Failure<Json>(key.error());
+                    skipWhitespace();
+                    if (_pos >= _text.size() || _text[_pos] != ':') return Failure<Json>(error("Expected ':'"));
+                    ++_pos;
+                    auto value = parseValue(depth + 1);
+                    if (!value) return value;
+                    object.emplace_back(std::move(key.value()), std::move(value.value()));
+                    skipWhitespace();
+                    if (_pos < _text.size() && _text[_pos] == ',') {
+                        ++_pos;
+                        continue;
+                    }
+                    if (_pos < _text.size() && _text[_pos] == '}') {
+                        ++_pos;
+                        return Success(Json(std::move(object)));
+                    }
+                    return Failure<Json>(error("Expected ',' or '}'"));
+                }
+            }
+            if (c == '[') {
+                ++_pos;
+                Json::Array array;
+                skipWhitespace();
+                if (_pos < _text.size() && _text[_pos] == ']') {
+                    ++_pos;
+                    return Success(Json(std::move(array)));
+                }
+                for (;;) {
+                    auto value = parseValue(depth + 1);
+                    if (!value) return value;
+                    array.push_back(std::move(value.value()));
+                    skipWhitespace();
+                    if (_pos < _text.size() && _text[_pos] == ',') {
+                        ++_pos;
+                        continue;
+                    }
+                    if (_pos < _text.size() && _text[_pos] == ']') {
+                        ++_pos;
+                        return Success(Json(std::move(array)));
+                    }
+                    return Failure<Json>(error("Expected ',' or ']'"));
+                }
+            }
+            if (c == '"') {
+                auto text = parseString();
+                if (!text) return Failure<Json>(text.error());
+                return Success(Json(std::move(text.value())));
+            }
+            if (consume("true")) return Success(Json(true));
+            if (consume("false")) return Success(Json(false));
+            if (consume("null")) return Success(Json(nullptr));
+            if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) return parseNumber();
+            return Failure<Json>(error("Unexpected character"));
+        }
+
+        bool atEnd() {
+            skipWhitespace();
+            return _pos == _text.size();
+        }
+
+        CoreError trailingError() const { return error("Unexpected trailing characters"); }
+    };
+
+    void dumpString(const std::string& value, std::string& out) {
+        out += '"';
+        for (char c : value) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        out += buffer;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        out += '"';
+    }
+}
+
+Result<Json> Json::parse(const std::string& text) {
+    Parser parser(text);
+    auto value = parser.parseValue(0);
+    if (!value) return value;
+    if (!parser.atEnd()) return Failure<Json>(parser.trailingError());
+    return value;
+}
+
+std::string Json::dump() const {
+    std::string out;
+    dump(out);
+    return out;
+}
+
+void Json::dump(std::string& out) const {
+    if (isNull()) {
+        out += "null";
+    } else if (isBool()) {
+        out += asBool() ? "true" : "false";
+    } else if (isNumber()) {
+        double value = asNumber();
+        char buffer[32];
+        // Số nguyên (id, số lượng) in không có phần thập phân
+        if (value == std::floor(value) && std::fabs(value) < 1e15) {
+            std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        }
+        out += buffer;
+    } else if (isString()) {
+        dumpString(asString(), out);
+    } else if (isArray()) {
+        out += '[';
+        bool first = true;
+        for (const auto& item : asArray()) {
+            if (!first) out += ',';
+            item.dump(out);
+            first = false;
+        }
+        out += ']';
+    } else {
+        out += '{';
+        bool first = true;
+        for (const auto& [key, item] : asObject()) {
+            if (!first) out += ',';
+            dumpString(key, out);
+            out += ':';
+            item.dump(out);
+            first = false;
+        }
+        out += '}';
+    }
+}
+
+Json& Json::push(Json value) {
+    if (!isArray()) _value = Array{};
+    std::get<Array>(_value).push_back(std::move(value));
+    return *this;
+}
+
+Json& Json::set(const std::string& key, Json value) {
+    if (!isObject()) _value = Object{};
+    auto& object = std::get<Object>(_value);
+    for (auto& [existing, item] : object) {
+        if (existing == key) {
+            item = std::move(value);
+            return *this;
+        }
+    }
+    object.emplace_back(key, std::move(value));
+    return *this;
+}
+
+const Json* Json::find(const std::string& key) const {
+    if (!isObject()) return nullptr;
+    for (const auto& [existing, item] : asObject()) {
+        if (existing == key) return &item;
+    }
+    return nullptr;
+}
+
+} // namespace Server
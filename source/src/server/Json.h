@@ -0,0 +1,84 @@
+/**
+ * @file Json.h
+ * @brief Giá trị JSON tối giản cho giao thức của airlines_server
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Chỉ đủ cho thông điệp yêu cầu/phản hồi: null, bool, số (double), chuỗi UTF-8, mảng và đối
+ * tượng. Đối tượng giữ thứ tự khóa lúc chèn để phản hồi dễ đọc; tra khóa là tuyến tính vì
+ * mỗi đối tượng chỉ có vài trường. Escape \\uXXXX được giải mã thành UTF-8 (kể cả cặp
+ * surrogate); khi ghi chỉ escape ký tự điều khiển, dấu nháy và gạch chéo ngược.
+ */
+
+#ifndef SERVER_JSON_H
+#define SERVER_JSON_H
+
+#include "../core/exceptions/Result.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Server {
+
+class Json {
+public:
+    using Array = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;
+
+private:
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> _value;
+
+public:
+    Json() : _value(nullptr) {}
+    Json(std::nullptr_t) : _value(nullptr) {}
+    Json(bool value) : _value(value) {}
+    Json(int value) : _value(static_cast<double>(value)) {}
+    Json(int64_t value) : _value(static_cast<double>(value)) {}
+    Json(uint64_t value) : _value(static_cast<double>(value)) {}
+    Json(double value) : _value(value) {}
+    Json(const char* value) : _value(std::string(value)) {}
+    Json(std::string value) : _value(std::move(value)) {}
+    Json(Array value) : _value(std::move(value)) {}
+    Json(Object value) : _value(std::move(value)) {}
+
+    static Json object() { return Json(Object{}); }
+    static Json array() { return Json(Array{}); }
+
+    /**
+     * @brief Đọc một văn bản JSON hoàn chỉnh
+     * @return Lỗi INVALID_JSON kèm vị trí nếu sai cú pháp hoặc còn ký tự thừa
+     */
+    static Result<Json> parse(const std::string& text);
+
+    std::string dump() const;
+    void dump(std::string& out) const;
+
+    bool isNull() const { return std::holds_alternative<std::nullptr_t>(_value); }
+    bool isBool() const { return std::holds_alternative<bool>(_value); }
+    bool isNumber() const { return std::holds_alternative<double>(_value); }
+    bool isString() const { return std::holds_alternative<std::string>(_value); }
+    bool isArray() const { return std::holds_alternative<Array>(_value); }
+    bool isObject() const { return std::holds_alternative<Object>(_value); }
+
+    bool asBool() const { return std::get<bool>(_value); }
+    double asNumber() const { return std::get<double>(_value); }
+    const std::string& asString() const { return std::get<std::string>(_value); }
+    const Array& asArray() const { return std::get<Array>(_value); }
+    const Object& asObject() const { return std::get<Object>(_value); }
+
+    /// Thêm phần tử vào mảng
+    Json& push(Json value);
+
+    /// Gán trường của đối tượng, ghi đè nếu khóa đã có
+    Json& set(const std::string& key, Json value);
+
+    /// Trường của đối tượng, nullptr nếu không phải đối tượng hoặc không có khóa
+    const Json* find(const std::string& key) const;
+};
+
+} // namespace Server
+
+#endif // SERVER_JSON_H
@@ -0,0 +1,46 @@
+#include "Protocol.h"
+
+namespace Server {
+
+std::string encodeFrame(const std::string& payload) {
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    std::string frame;
+    frame.reserve(FRAME_HEADER_SIZE + payload.size());
+    frame += static_cast<char>((size >> 24) & 0xFF);
+    frame += static_cast<char>((size >> 16) & 0xFF);
+    frame += static_cast<char>((size >> 8) & 0xFF);
+    frame += static_cast<char>(size & 0xFF);
+    frame += payload;
+    return frame;
+}
+
+void FrameDecoder::append(const char* data, size_t size) {
+    // Dồn phần chưa tiêu thụ về đầu khi phần đã tiêu thụ chiếm hơn nửa bộ đệm
+    if (_offset > 0 && _offset * 2 >= _buffer.size()) {
+        _buffer.erase(0, _offset);
+        _offset = 0;
+    }
+    _buffer.append(data, size);
+}
+
+Result<std::optional<std::string>> FrameDecoder::next() {
+    if (buffered() < FRAME_HEADER_SIZE) return Success(std::optional<std::string>());
+
+    const auto* header = reinterpret_cast<const unsigned char*>(_buffer.data() + _offset);
+    uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) | (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+    if (size > MAX_FRAME_SIZE) {
+        return Failure<std::optional<std::string>>(
+            CoreError("Frame of " + std::to_string(size) + " bytes exceeds the limit", "FRAME_TOO_LARGE"));
+    }
+    if (buffered() < FRAME_HEADER_SIZE + size) return Success(std::optional<std::string>());
+
+    std::string payload = _buffer.substr(_offset + FRAME_HEADER_SIZE, size);
+    _offset += FRAME_HEADER_SIZE + size;
+    if (_offset == _buffer.size()) {
+        _buffer.clear();
+        _offset = 0;
+    }
+    return Success(std::optional<std::string>(std::move(payload)));
+}
+
+} // namespace Server
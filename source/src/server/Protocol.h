@@ -0,0 +1,57 @@
+/**
+ * @file Protocol.h
+ * @brief Khung thông điệp của airlines_server: độ dài 4 byte big-endian + JSON UTF-8
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi yêu cầu là một khung: [độ dài payload, uint32 big-endian][payload JSON]
+ *
+ *   Yêu cầu:  {"id": 7, "method": "ticket.book", "params": {...}}
+ *   Phản hồi: {"id": 7, "ok": true, "result": ...}
+ *             {"id": 7, "ok": false, "error": {"code": "SEAT_NOT_AVAILABLE", "message": "..."}}
+ *
+ * Nhiều yêu cầu có thể gửi liên tiếp trên một kết nối mà không chờ phản hồi. Các yêu cầu được
+ * xử lý song song trên worker pool nên phản hồi có thể về khác thứ tự; client ghép theo "id".
+ */
+
+#ifndef SERVER_PROTOCOL_H
+#define SERVER_PROTOCOL_H
+
+#include "../core/exceptions/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Server {
+
+constexpr size_t FRAME_HEADER_SIZE = 4;
+constexpr uint32_t MAX_FRAME_SIZE = 1u << 20;   ///< Khung lớn hơn bị coi là lỗi giao thức và đóng kết nối
+
+/// Thêm header độ dài vào trước payload
+std::string encodeFrame(const std::string& payload);
+
+/**
+ * @brief Ghép byte nhận được từ socket thành các khung hoàn chỉnh
+ */
+class FrameDecoder {
+private:
+    std::string _buffer;
+    size_t _offset = 0;     ///< Byte đầu tiên chưa tiêu thụ trong _buffer
+
+public:
+    void append(const char* data, size_t size);
+
+    /**
+     * @brief Lấy khung kế tiếp nếu đã nhận đủ
+     * @return std::nullopt nếu còn thiếu byte; lỗi FRAME_TOO_LARGE nếu header vượt MAX_FRAME_SIZE
+     */
+    Result<std::optional<std::string>> next();
+
+    size_t buffered() const { return _buffer.size() - _offset; }
+};
+
+} // namespace Server
+
+#endif // SERVER_PROTOCOL_H
@@ -0,0 +1,389 @@
+#include "RequestDispatcher.h"
+#include "../core/value_objects/schedule/ScheduleFormatter.h"
+
+namespace Server {
+
+namespace {
+    CoreError invalidParams(const std::string& message) {
+        return CoreError(message, "INVALID_PARAMS");
+    }
+
+    Result<std::string> requireString(const Json& params, const std::string& name) {
+        const Json* value = params.find(name);
+        if (!value || !value->isString()) return Failure<std::string>(invalidParams("Expected string parameter: " + name));
+        return Success(value->asString());
+    }
+
+    Result<double> requireNumber(const Json& params, const std::string& name) {
+        const Json* value = params.find(name);
+        if (!value || !value->isNumber()) return Failure<double>(invalidParams("Expected number parameter: " + name));
+        return Success(value->asNumber());
+    }
+
+    std::string optionalString(const Json& params, const std::string& name, const std::string& fallback) {
+        const Json* value = params.find(name);
+        return value && value->isString() ? value->asString() : fallback;
+    }
+
+    /// Đọc tham số chuỗi rồi dựng value object, gộp hai loại lỗi về một Result
+    template <class T>
+    Result<T> requireValue(const Json& params, const std::string& name) {
+        auto text = requireString(params, name);
+        if (!text) return Failure<T>(text.error());
+        auto value = T::create(text.value());
+        if (!value) return Failure<T>(invalidParams("Invalid " + name + ": " + value.error().message));
+        return value;
+    }
+
+    Result<Price> requirePrice(const Json& params) {
+        auto amount = requireNumber(params, "price");
+        if (!amount) return Failure<Price>(amount.error());
+        auto price = Price::create(amount.value(), optionalString(params, "currency", "VND"));
+        if (!price) return Failure<Price>(invalidParams("Invalid price: " + price.error().message));
+        return price;
+    }
+
+    Json flightJson(const Flight& flight) {
+        const auto& route = flight.getRoute();
+        const auto& schedule = flight.getSchedule();
+        auto json = Json::object();
+        json.set("id", flight.getId());
+        json.set("flightNumber", flight.getFlightNumber().toString());
+        json.set("originCode", route.getOriginCode());
+        json.set("origin", route.getOrigin());
+        json.set("destinationCode", route.getDestinationCode());
+        json.set("destination", route.getDestination());
+        json.set("schedule", ScheduleFormatter::toString(schedule.getDeparture(), schedule.getArrival()));
+        json.set("status", flight.getStatusString());
+        json.set("aircraftSerial", flight.getAircraft() ? flight.getAircraft()->getSerial().toString() : "");
+        return json;
+    }
+
+    Json flightSummaryJson(const FlightSummaryRow& row) {
+        auto json = Json::object();
+        json.set("id", row.id);
+        json.set("flightNumber", row.flightNumber);
+        json.set("originCode", row.departureCode);
+        json.set("destinationCode", row.arrivalCode);
+        json.set("schedule", ScheduleFormatter::toString(row.departureTime, row.arrivalTime));
+        json.set("status", FlightStatusUtil::toString(row.status));
+        json.set("aircraftSerial", row.aircraftSerial);
+        json.set("totalSeats", row.totalSeats());
+        json.set("availableSeats", row.availableSeats());
+        return json;
+    }
+
+    Json passengerJson(const Passenger& passenger) {
+        const auto& contact = passenger.getContactInfo();
+        auto json = Json::object();
+        json.set("id", passenger.getId());
+        json.set("passport", passenger.getPassport().toString());
+        json.set("name", passenger.getName());
+        json.set("email", contact.getEmail());
+        json.set("phone", contact.getPhone());
+        json.set("address", contact.getAddress());
+        return json;
+    }
+
+    Json ticketJson(const Ticket& ticket) {
+        auto json = Json::object();
+        json.set("id", ticket.getId());
+        json.set("ticketNumber", ticket.getTicketNumber().toString());
+        json.set("passport", ticket.getPassenger() ? ticket.getPassenger()->getPassport().toString() : "");
+        json.set("flightNumber", ticket.getFlight() ? ticket.getFlight()->getFlightNumber().toString() : "");
+        json.set("seat", ticket.getSeatNumber().toString());
+        json.set("price", ticket.getPrice().getAmount());
+        json.set("currency", ticket.getPrice().getCurrency());
+        json.set("status", ticket.getStatusString());
+        return json;
+    }
+
+    Json ticketsJson(const std::vector<Ticket>& tickets) {
+        auto json = Json::array();
+        for (const auto& ticket : tickets) json.push(ticketJson(ticket));
+        return json;
+    }
+
+    /// Tham số ngày "YYYY-MM-DD" tùy chọn; không có thì giữ fallback
+    Result<int32_t> optionalDay(const Json& params, const std::string& name, int32_t fallback) {
+        const Json* value = params.find(name);
+        if (!value) return Success(fallback);
+        if (!value->isString()) return Failure<int32_t>(invalidParams("Expected string parameter: " + name));
+        auto day = Reporting::parseDay(value->asString());
+        if (!day) return Failure<int32_t>(invalidParams("Invalid " + name + ": " + day.error().message));
+        return day;
+    }
+
+    /// Áp dụng các thay đổi đang chờ lên ảnh chụp bằng repository của lượt hiện tại
+    Result<size_t> refreshSnapshot(Reporting::Snapshot& snapshot, const ApplicationContext& context) {
+        return snapshot.refresh(*context.flightRepository(), *context.ticketRepository(), *context.passengerRepository());
+    }
+
+    /// Chuyển Result<bool> của các thao tác trạng thái thành {"updated": ...}
+    Result<Json> updatedJson(const Result<bool>& result) {
+        if (!result) return Failure<Json>(result.error());
+        auto json = Json::object();
+        json.set("updated", result.value());
+        return Success(std::move(json));
+    }
+}
+
+RequestDispatcher::RequestDispatcher() : _snapshot(std::make_shared<Reporting::Snapshot>()) {
+    registerDefaults();
+}
+
+void RequestDispatcher::registerMethod(const std::string& name, Handler handler) {
+    auto separator = name.find('.');
+    std::string component = separator == std::string::npos ? "server" : name.substr(0, separator);
+    std::string operation = separator == std::string::npos ? name : name.substr(separator + 1);
+    _handlers[name] = Entry{std::move(handler), std::make_unique<Metrics::OperationMetrics>("server", component, operation)};
+}
+
+std::vector<std::string> RequestDispatcher::methods() const {
+    std::vector<std::string> names;
+    names.reserve(_handlers.size());
+    for (const auto& [name, entry] : _handlers) names.push_back(name);
+    return names;
+}
+
+Result<Request> RequestDispatcher::parseRequest(const std::string& payload) {
+    auto json = Json::parse(payload);
+    if (!json) return Failure<Request>(json.error());
+    if (!json.value().isObject()) return Failure<Request>(CoreError("Request must be a JSON object", "INVALID_REQUEST"));
+
+    Request request;
+    if (const Json* id = json.value().find("id")) request.id = *id;
+    const Json* method = json.value().find("method");
+    if (!method || !method->isString()) {
+        return Failure<Request>(CoreError("Request is missing \"method\"", "INVALID_REQUEST"));
+    }
+    request.method = method->asString();
+
+    const Json* params = json.value().find("params");
+    if (params && !params->isNull() && !params->isObject()) {
+        return Failure<Request>(CoreError("\"params\" must be an object", "INVALID_REQUEST"));
+    }
+    request.params = params && params->isObject() ? *params : Json::object();
+    return Success(std::move(request));
+}
+
+Result<Json> RequestDispatcher::dispatch(const ApplicationContext& context, const Request& request) const {
+    auto it = _handlers.find(request.method);
+    if (it == _handlers.end()) {
+        return Failure<Json>(CoreError("Unknown method: " + request.method, "UNKNOWN_METHOD"));
+    }
+    Metrics::OperationTimer timer(*it->second.metrics);
+    return timer.complete(it->second.handler(context, request.params));
+}
+
+std::string RequestDispatcher::formatResponse(const Json& id, const Result<Json>& result) {
+    auto response = Json::object();
+    response.set("id", id);
+    response.set("ok", result.has_value());
+    if (result) {
+        response.set("result", result.value());
+    } else {
+        auto error = Json::object();
+        error.set("code", result.error().code.empty() ? "UNKNOWN" : result.error().code);
+        error.set("message", result.error().message);
+        response.set("error", std::move(error));
+    }
+    return response.dump();
+}
+
+void RequestDispatcher::registerDefaults() {
+    registerMethod("ping", [](const ApplicationContext&, const Json&) -> Result<Json> {
+        auto json = Json::object();
+        json.set("pong", true);
+        return Success(std::move(json));
+    });
+
+    // === Flight ===
+
+    registerMethod("flight.get", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<FlightNumber>(params, "flightNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto flight = context.flightService()->getFlight(number.value());
+        if (!flight) return Failure<Json>(flight.error());
+        return Success(flightJson(flight.value()));
+    });
+
+    registerMethod("flight.list", [](const ApplicationContext& context, const Json&) -> Result<Json> {
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = context.flightService()->getFlightSummariesWithOccupancy(rows);
+        if (!loaded) return Failure<Json>(loaded.error());
+        auto json = Json::array();
+        for (const auto& row : rows) json.push(flightSummaryJson(row));
+        return Success(std::move(json));
+    });
+
+    registerMethod("flight.availableSeats", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<FlightNumber>(params, "flightNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto seatClass = requireString(params, "seatClass");
+        if (!seatClass) return Failure<Json>(seatClass.error());
+        auto seats = context.flightService()->getAvailableSeats(number.value(), seatClass.value());
+        if (!seats) return Failure<Json>(seats.error());
+        auto json = Json::array();
+        for (const auto& seat : seats.value()) json.push(seat);
+        return Success(std::move(json));
+    });
+
+    registerMethod("flight.search", [snapshot = _snapshot](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        Reporting::FlightQuery query;
+        query.departureCode = optionalString(params, "originCode", "");
+        query.arrivalCode = optionalString(params, "destinationCode", "");
+        auto from = optionalDay(params, "from", std::numeric_limits<int32_t>::min());
+        if (!from) return Failure<Json>(from.error());
+        auto to = optionalDay(params, "to", std::numeric_limits<int32_t>::max());
+        if (!to) return Failure<Json>(to.error());
+        if (params.find("from")) query.departFrom = static_cast<int64_t>(from.value()) * 86400;
+        if (params.find("to")) query.departTo = (static_cast<int64_t>(to.value()) + 1) * 86400 - 1;
+        const Json* cancelled = params.find("includeCancelled");
+        query.includeCancelled = cancelled && cancelled->isBool() && cancelled->asBool();
+        if (const Json* limit = params.find("limit")) {
+            if (!limit->isNumber() || limit->asNumber() < 1) return Failure<Json>(invalidParams("Expected positive number parameter: limit"));
+            query.limit = static_cast<size_t>(limit->asNumber());
+        }
+
+        auto refreshed = refreshSnapshot(*snapshot, context);
+        if (!refreshed) return Failure<Json>(refreshed.error());
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = context.flightService()->getFlightSummariesByIds(snapshot->findFlights(query), rows);
+        if (!loaded) return Failure<Json>(loaded.error());
+        auto json = Json::array();
+        for (const auto& row : rows) json.push(flightSummaryJson(row));
+        return Success(std::move(json));
+    });
+
+    // === Report ===
+
+    registerMethod("report.routes", [snapshot = _snapshot](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        Reporting::ReportOptions options;
+        auto from = optionalDay(params, "from", options.fromDay);
+        if (!from) return Failure<Json>(from.error());
+        auto to = optionalDay(params, "to", options.toDay);
+        if (!to) return Failure<Json>(to.error());
+        options.fromDay = from.value();
+        options.toDay = to.value();
+
+        auto refreshed = refreshSnapshot(*snapshot, context);
+        if (!refreshed) return Failure<Json>(refreshed.error());
+        auto report = snapshot->salesReport(options);
+        auto json = Json::array();
+        for (const auto& line : report.routes) {
+            auto route = Json::object();
+            route.set("route", line.key);
+            route.set("ticketsSold", line.ticketsSold);
+            route.set("loadFactor", line.loadFactor());
+            auto revenue = Json::object();
+            for (const auto& currency : report.currencies) revenue.set(currency, report.revenueOf(line, currency));
+            route.set("revenue", std::move(revenue));
+            json.push(std::move(route));
+        }
+        return Success(std::move(json));
+    });
+
+    // === Passenger ===
+
+    registerMethod("passenger.get", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto passport = requireValue<PassportNumber>(params, "passport");
+        if (!passport) return Failure<Json>(passport.error());
+        auto passenger = context.passengerService()->getPassenger(passport.value());
+        if (!passenger) return Failure<Json>(passenger.error());
+        return Success(passengerJson(passenger.value()));
+    });
+
+    registerMethod("passenger.create", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto passport = requireString(params, "passport");
+        auto name = requireString(params, "name");
+        if (!passport) return Failure<Json>(passport.error());
+        if (!name) return Failure<Json>(name.error());
+        std::string contact = optionalString(params, "email", "") + "|" + optionalString(params, "phone", "") + "|" +
+                              optionalString(params, "address", "");
+        auto passenger = Passenger::create(name.value(), contact, passport.value());
+        if (!passenger) return Failure<Json>(invalidParams(passenger.error().message));
+        auto created = context.passengerService()->createPassenger(passenger.value());
+        if (!created) return Failure<Json>(created.error());
+        return Success(passengerJson(created.value()));
+    });
+
+    // === Ticket ===
+
+    registerMethod("ticket.get", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<TicketNumber>(params, "ticketNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto ticket = context.ticketService()->getTicket(number.value());
+        if (!ticket) return Failure<Json>(ticket.error());
+        return Success(ticketJson(ticket.value()));
+    });
+
+    registerMethod("ticket.book", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto passport = requireValue<PassportNumber>(params, "passport");
+        if (!passport) return Failure<Json>(passport.error());
+        auto number = requireValue<FlightNumber>(params, "flightNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto seat = requireString(params, "seat");
+        if (!seat) return Failure<Json>(seat.error());
+        auto price = requirePrice(params);
+        if (!price) return Failure<Json>(price.error());
+
+        auto ticket = context.ticketService()->bookTicket(passport.value(), number.value(), seat.value(), price.value());
+        if (!ticket) return Failure<Json>(ticket.error());
+        return Success(ticketJson(ticket.value()));
+    });
+
+    registerMethod("ticket.bookGroup", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        const Json* passportList = params.find("passports");
+        if (!passportList || !passportList->isArray()) {
+            return Failure<Json>(invalidParams("Expected array parameter: passports"));
+        }
+        std::vector<PassportNumber> passports;
+        for (const auto& item : passportList->asArray()) {
+            if (!item.isString()) return Failure<Json>(invalidParams("Passports must be strings"));
+            auto passport = PassportNumber::create(item.asString());
+            if (!passport) return Failure<Json>(invalidParams("Invalid passport: " + passport.error().message));
+            passports.push_back(passport.value());
+        }
+        auto number = requireValue<FlightNumber>(params, "flightNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto seatClass = requireString(params, "seatClass");
+        if (!seatClass) return Failure<Json>(seatClass.error());
+        auto price = requirePrice(params);
+        if (!price) return Failure<Json>(price.error());
+
+        auto tickets = context.ticketService()->bookGroup(passports, number.value(), seatClass.value(), price.value());
+        if (!tickets) return Failure<Json>(tickets.error());
+        return Success(ticketsJson(tickets.value()));
+    });
+
+    registerMethod("ticket.cancel", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<TicketNumber>(params, "ticketNumber");
+        if (!number) return Failure<Json>(number.error());
+        return updatedJson(context.ticketService()->cancelTicket(number.value(), optionalString(params, "reason", "")));
+    });
+
+    registerMethod("ticket.checkIn", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<TicketNumber>(params, "ticketNumber");
+        if (!number) return Failure<Json>(number.error());
+        return updatedJson(context.ticketService()->checkInTicket(number.value()));
+    });
+
+    registerMethod("ticket.byPassenger", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto passport = requireValue<PassportNumber>(params, "passport");
+        if (!passport) return Failure<Json>(passport.error());
+        auto tickets = context.ticketService()->searchByPassenger(passport.value());
+        if (!tickets) return Failure<Json>(tickets.error());
+        return Success(ticketsJson(tickets.value()));
+    });
+
+    registerMethod("ticket.byFlight", [](const ApplicationContext& context, const Json& params) -> Result<Json> {
+        auto number = requireValue<FlightNumber>(params, "flightNumber");
+        if (!number) return Failure<Json>(number.error());
+        auto tickets = context.ticketService()->searchByFlight(number.value());
+        if (!tickets) return Failure<Json>(tickets.error());
+        return Success(ticketsJson(tickets.value()));
+    });
+}
+
+} // namespace Server
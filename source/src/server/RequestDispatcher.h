@@ -0,0 +1,89 @@
+/**
+ * @file RequestDispatcher.h
+ * @brief Ánh xạ tên phương thức của giao thức sang TicketService, FlightService và PassengerService
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Các phương thức mặc định (tham số trong "params"):
+ * - ping
+ * - flight.get {flightNumber}, flight.list, flight.availableSeats {flightNumber, seatClass}
+ * - passenger.get {passport}, passenger.create {passport, name, email, phone, address}
+ * - flight.search {originCode?, destinationCode?, from?, to?, includeCancelled?, limit?}: chuyến bay theo
+ *   sân bay/tuyến và ngày khởi hành (YYYY-MM-DD), theo thứ tự giờ khởi hành
+ * - report.routes {from?, to?}: vé bán, hệ số lấp đầy và doanh thu theo tuyến
+ * - ticket.get {ticketNumber}, ticket.book {passport, flightNumber, seat, price, currency},
+ *   ticket.bookGroup {passports[], flightNumber, seatClass, price, currency},
+ *   ticket.cancel {ticketNumber, reason}, ticket.checkIn {ticketNumber},
+ *   ticket.byPassenger {passport}, ticket.byFlight {flightNumber}
+ *
+ * flight.search và report.routes chạy trên một Reporting::Snapshot do dispatcher giữ suốt đời
+ * server: lần gọi đầu nạp cả bảng, các lần sau chỉ nạp lại những hàng mà Changes::Feed báo đã đổi.
+ * Feed chỉ thấy lệnh ghi của chính tiến trình này, nên thay đổi từ tiến trình khác (giao diện,
+ * airlines_cli import) chỉ hiện ra sau khi server khởi động lại.
+ *
+ * Lỗi nghiệp vụ của service được trả nguyên mã lỗi; tham số thiếu hoặc sai kiểu trả
+ * INVALID_PARAMS, phương thức lạ trả UNKNOWN_METHOD. Mỗi phương thức có số đo
+ * airlines_server_operations_* riêng (nhãn component "rpc").
+ */
+
+#ifndef SERVER_REQUEST_DISPATCHER_H
+#define SERVER_REQUEST_DISPATCHER_H
+
+#include "Json.h"
+#include "../app/ApplicationContext.h"
+#include "../reporting/Snapshot.h"
+#include "../utils/Metrics.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Server {
+
+struct Request {
+    Json id;            ///< Sao chép nguyên vào phản hồi
+    std::string method;
+    Json params;        ///< Luôn là đối tượng (rỗng nếu yêu cầu không có params)
+};
+
+class RequestDispatcher {
+public:
+    using Handler = std::function<Result<Json>(const ApplicationContext& context, const Json& params)>;
+
+private:
+    struct Entry {
+        Handler handler;
+        std::unique_ptr<Metrics::OperationMetrics> metrics;
+    };
+
+    std::map<std::string, Entry> _handlers;
+    std::shared_ptr<Reporting::Snapshot> _snapshot;     ///< Dùng chung cho flight.search và report.routes
+
+    void registerDefaults();
+
+public:
+    RequestDispatcher();
+
+    /// Thêm hoặc thay một phương thức
+    void registerMethod(const std::string& name, Handler handler);
+
+    std::vector<std::string> methods() const;
+
+    /**
+     * @brief Tách yêu cầu từ payload của một khung
+     * @return Lỗi INVALID_JSON hoặc INVALID_REQUEST (thiếu "method", "params" không phải đối tượng)
+     */
+    static Result<Request> parseRequest(const std::string& payload);
+
+    /// Gọi phương thức trên bộ service của context
+    Result<Json> dispatch(const ApplicationContext& context, const Request& request) const;
+
+    /// Dựng payload phản hồi thành công hoặc lỗi
+    static std::string formatResponse(const Json& id, const Result<Json>& result);
+};
+
+} // namespace Server
+
+#endif // SERVER_REQUEST_DISPATCHER_H
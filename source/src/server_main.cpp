@@ -0,0 +1,127 @@
+#include "server/BookingServer.h"
+#include "app/DatabaseSettings.h"
+#include "cli/CommandLine.h"
+#include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <pthread.h>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "Usage: airlines_server [options]\n"
+                  << "  --listen HOST      Address to listen on (default 127.0.0.1)\n"
+                  << "  --listen-port N    TCP port (default 7070)\n"
+                  << "  --workers N        Request worker threads (default 4)\n"
+                  << "  --sessions N       Pooled database sessions (default: same as --workers)\n"
+                  << "  --queue N          Maximum queued requests before SERVER_BUSY (default 4096)\n"
+                  << "  --metrics FILE     Write Prometheus metrics on shutdown\n"
+                  << "  --query-stats FILE Write per-statement latency table on shutdown\n"
+                  << "  --slow-query-ms N  Log statements slower than N ms to --slow-query-log FILE\n"
+                  << "                     (defaults from AIRLINES_SLOW_QUERY_MS, AIRLINES_SLOW_QUERY_LOG)\n"
+                  << "  --verbose          Log at DEBUG level\n"
+                  << "Connection: --host H --user U --password P --database D --port N\n"
+                  << "            (defaults from AIRLINES_DB_* environment variables)\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    auto commandLine = Cli::CommandLine::parseOptions(argc, argv);
+    if (!commandLine || commandLine.value().has("help"))
+    {
+        printUsage();
+        return 2;
+    }
+    const auto &options = commandLine.value();
+
+    auto logger = Logger::getInstance();
+    logger->setMinLevel(options.has("verbose") ? LogLevel::DEBUG : LogLevel::INFO);
+
+    Server::ServerConfig config;
+    auto listenPort = options.getUnsigned("listen-port", config.port);
+    auto workers = options.getUnsigned("workers", config.workers);
+    auto queue = options.getUnsigned("queue", config.maxQueuedRequests);
+    auto databasePort = options.getUnsigned("port", 0);
+    if (!listenPort || !workers || !queue || !databasePort || listenPort.value() > 65535)
+    {
+        printUsage();
+        return 2;
+    }
+    auto sessions = options.getUnsigned("sessions", workers.value());
+    auto slowQueryMillis = options.getUnsigned("slow-query-ms", 0);
+    if (!sessions || !slowQueryMillis)
+    {
+        printUsage();
+        return 2;
+    }
+    config.host = options.get("listen", config.host);
+    config.port = static_cast<uint16_t>(listenPort.value());
+    config.workers = workers.value();
+    config.maxQueuedRequests = queue.value();
+
+    auto settings = DatabaseSettings::fromEnvironment();
+    settings.host = options.get("host", settings.host);
+    settings.user = options.get("user", settings.user);
+    settings.password = options.get("password", settings.password);
+    settings.database = options.get("database", settings.database);
+    if (databasePort.value() != 0)
+    {
+        settings.port = static_cast<int>(databasePort.value());
+    }
+    if (slowQueryMillis.value() != 0)
+    {
+        settings.slowQueryMillis = static_cast<int>(slowQueryMillis.value());
+    }
+    settings.slowQueryLogPath = options.get("slow-query-log", settings.slowQueryLogPath);
+    configureQueryStats(settings);
+
+    // Chặn SIGINT/SIGTERM trước khi tạo luồng để chỉ luồng chính nhận qua sigwait
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto pool = connectDatabasePool(settings, sessions.value());
+    if (!pool)
+    {
+        logger->error(pool.error().message);
+        return 1;
+    }
+
+    Server::BookingServer server(pool.value(), logger, config);
+    auto started = server.start();
+    if (!started)
+    {
+        logger->error(started.error().message);
+        return 1;
+    }
+
+    int received = 0;
+    sigwait(&signals, &received);
+    logger->info("Received signal " + std::to_string(received) + ", shutting down");
+    server.stop();
+
+    if (auto metricsPath = options.get("metrics", ""); !metricsPath.empty())
+    {
+        auto written = Metrics::MetricsRegistry::getInstance()->writePrometheusFile(metricsPath);
+        if (!written)
+        {
+            logger->error(written.error().message);
+        }
+    }
+    if (auto statsPath = options.get("query-stats", ""); !statsPath.empty())
+    {
+        std::ofstream statsFile(statsPath);
+        statsFile << settings.queryStats->dump();
+        if (!statsFile)
+        {
+            logger->error("Failed to write query stats to " + statsPath);
+        }
+    }
+    return 0;
+}
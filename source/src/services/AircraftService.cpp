@@ -1,5 +1,6 @@
 #include "AircraftService.h"
 #include "../core/exceptions/Result.h"
+#include "../utils/Metrics.h"
 #include <algorithm>
 
 // Private helper methods
@@ -33,6 +34,16 @@ Result<std::vector<Aircraft>> AircraftService::getAllAircraft()
     return _aircraftRepository->findAll();
 }
 
+Result<size_t> AircraftService::countAircraft()
+{
+    return _aircraftRepository->count();
+}
+
+Result<size_t> AircraftService::getAircraftListPage(size_t offset, size_t limit, std::vector<AircraftListRow> &rows)
+{
+    return _aircraftRepository->findListRowsPage(offset, limit, rows);
+}
+
 Result<bool> AircraftService::aircraftExists(const AircraftSerial &serial)
 {
     if (_logger)
@@ -42,6 +53,9 @@ Result<bool> AircraftService::aircraftExists(const AircraftSerial &serial)
 
 Result<Aircraft> AircraftService::createAircraft(const Aircraft &aircraft)
 {
+    static const Metrics::OperationMetrics metrics("service", "aircraft", "create");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Creating aircraft with serial: " + aircraft.getSerial().toString());
 
@@ -61,11 +75,14 @@ Result<Aircraft> AircraftService::createAircraft(const Aircraft &aircraft)
     }
 
     // Create aircraft
-    return _aircraftRepository->create(aircraft);
+    return timer.complete(_aircraftRepository->create(aircraft));
 }
 
 Result<Aircraft> AircraftService::updateAircraft(const Aircraft &aircraft)
 {
+    static const Metrics::OperationMetrics metrics("service", "aircraft", "update");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Updating aircraft with serial: " + aircraft.getSerial().toString());
 
@@ -85,11 +102,14 @@ Result<Aircraft> AircraftService::updateAircraft(const Aircraft &aircraft)
     }
 
     // Update aircraft
-    return _aircraftRepository->update(aircraft);
+    return timer.complete(_aircraftRepository->update(aircraft));
 }
 
 Result<bool> AircraftService::deleteAircraft(const AircraftSerial &serial)
 {
+    static const Metrics::OperationMetrics metrics("service", "aircraft", "delete");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Deleting aircraft with serial: " + serial.toString());
 
@@ -148,7 +168,7 @@ Result<bool> AircraftService::deleteAircraft(const AircraftSerial &serial)
     }
 
     // Delete aircraft
-    return _aircraftRepository->deleteBySerialNumber(serial);
+    return timer.complete(_aircraftRepository->deleteBySerialNumber(serial));
 }
 
 // Business operations
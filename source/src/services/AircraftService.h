@@ -87,6 +87,21 @@ public:
      */
     Result<std::vector<Aircraft>> getAllAircraft();
 
+    /**
+     * @brief Đếm tổng số máy bay (số hàng của danh sách ảo)
+     * @return Result<size_t> Số máy bay hoặc lỗi
+     */
+    Result<size_t> countAircraft();
+
+    /**
+     * @brief Nạp một trang máy bay dạng phẳng cho danh sách ảo, theo thứ tự id
+     * @param offset Chỉ số hàng đầu tiên của trang
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getAircraftListPage(size_t offset, size_t limit, std::vector<AircraftListRow>& rows);
+
     /**
      * @brief Kiểm tra máy bay có tồn tại theo số serial
      * @param serial Số serial của máy bay
@@ -1,8 +1,11 @@
 #include "FlightService.h"
+#include "OptimisticRetry.h"
 #include "../core/exceptions/Result.h"
+#include "../utils/Metrics.h"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <unordered_map>
 
 // Private helper methods
 Result<Flight> FlightService::getFlightById(int id) {
@@ -28,12 +31,100 @@ Result<std::vector<Flight>> FlightService::getAllFlights() {
     return _flightRepository->findAll();
 }
 
+Result<size_t> FlightService::getFlightSummaries(std::vector<FlightSummaryRow>& rows) {
+    if (_logger) _logger->debug("Getting flight summaries");
+    return _flightRepository->findAllSummaries(rows);
+}
+
+namespace {
+    /// Điền số ghế đã đặt theo hạng vào các hàng tóm tắt có cùng id chuyến bay
+    void applyOccupancy(std::vector<FlightSummaryRow>& rows, const std::vector<SeatOccupancyRow>& occupancy) {
+        std::unordered_map<int, FlightSummaryRow*> rowById;
+        rowById.reserve(rows.size());
+        for (auto& row : rows) rowById[row.id] = &row;
+
+        for (const auto& group : occupancy) {
+            auto it = rowById.find(group.flightId);
+            if (it == rowById.end()) continue;
+            switch (group.seatClass) {
+                case 'E': it->second->bookedEconomy = group.booked; break;
+                case 'B': it->second->bookedBusiness = group.booked; break;
+                case 'F': it->second->bookedFirst = group.booked; break;
+            }
+        }
+    }
+}
+
+Result<size_t> FlightService::getFlightSummariesWithOccupancy(std::vector<FlightSummaryRow>& rows) {
+    auto loaded = getFlightSummaries(rows);
+    if (!loaded) return loaded;
+
+    std::vector<SeatOccupancyRow> occupancy;
+    auto counted = _ticketRepository->countSeatOccupancy(occupancy);
+    if (!counted) return Failure<size_t>(counted.error());
+    applyOccupancy(rows, occupancy);
+    return loaded;
+}
+
+Result<size_t> FlightService::countFlights() {
+    return _flightRepository->count();
+}
+
+Result<size_t> FlightService::getFlightSummariesPage(size_t offset, size_t limit, std::vector<FlightSummaryRow>& rows) {
+    auto loaded = _flightRepository->findSummariesPage(offset, limit, rows);
+    if (!loaded || rows.empty()) return loaded;
+
+    // Trang theo thứ tự id nên số ghế chỉ cần đếm trong khoảng id của trang
+    std::vector<SeatOccupancyRow> occupancy;
+    auto counted = _ticketRepository->countSeatOccupancy(rows.front().id, rows.back().id, occupancy);
+    if (!counted) return Failure<size_t>(counted.error());
+    applyOccupancy(rows, occupancy);
+    return loaded;
+}
+
+Result<size_t> FlightService::suggestFlights(const std::string& text, size_t limit, std::vector<FlightSummaryRow>& rows) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "suggest");
+    Metrics::OperationTimer timer(metrics);
+
+    rows.clear();
+    auto index = _searchIndex ? _searchIndex : TypeAheadIndex::getInstance();
+    auto prepared = index->prepareFlights(*_flightRepository);
+    if (!prepared) {
+        if (_logger) _logger->error("Failed to prepare flight search index: " + prepared.error().message);
+        return timer.complete(Result<size_t>(Failure<size_t>(prepared.error())));
+    }
+
+    std::vector<int> ids;
+    if (index->find(SearchField::FLIGHT_NUMBER, text, limit, ids) == 0) {
+        return timer.complete(Result<size_t>(Success(size_t(0))));
+    }
+    return timer.complete(getFlightSummariesByIds(ids, rows));
+}
+
+Result<size_t> FlightService::getFlightSummariesByIds(const std::vector<int>& ids, std::vector<FlightSummaryRow>& rows) {
+    rows.clear();
+    if (ids.empty()) return Success(size_t(0));
+    auto loaded = _flightRepository->findSummariesByIds(ids, rows);
+    if (!loaded || rows.empty()) return loaded;
+
+    // Hàng vừa nạp theo thứ tự id nên số ghế được đếm trong khoảng id của chúng, trước khi sắp lại
+    std::vector<SeatOccupancyRow> occupancy;
+    auto counted = _ticketRepository->countSeatOccupancy(rows.front().id, rows.back().id, occupancy);
+    if (!counted) return Failure<size_t>(counted.error());
+    applyOccupancy(rows, occupancy);
+    orderByIds(rows, ids);
+    return Success(rows.size());
+}
+
 Result<bool> FlightService::flightExists(const FlightNumber& number) {
     if (_logger) _logger->debug("Checking if flight exists with number: " + number.toString());
     return _flightRepository->existsFlight(number);
 }
 
 Result<Flight> FlightService::createFlight(const Flight& flight) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "create");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger) _logger->debug("Creating flight with number: " + flight.getFlightNumber().toString());
 
     // Business rule: Check if flight with same number already exists
@@ -55,7 +146,7 @@ Result<Flight> FlightService::createFlight(const Flight& flight) {
     }
 
     // Create flight
-    return _flightRepository->create(flight);
+    return timer.complete(_flightRepository->create(flight));
 }
 
 Result<Flight> FlightService::updateFlight(const Flight& flight) {
@@ -214,25 +305,51 @@ Result<std::vector<std::string>> FlightService::getAvailableSeats(const FlightNu
 Result<bool> FlightService::updateFlightStatus(const FlightNumber& number, FlightStatus status) {
     if (_logger) _logger->debug("Updating flight status for flight: " + number.toString());
 
-    // Get flight
-    auto flightResult = _flightRepository->findByFlightNumber(number);
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
-    }
+    // Re-read the flight and retry when another session updated it in between
+    return OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Get flight status row (no aircraft join, no seat map)
+        auto rowResult = _flightRepository->findStatusRow(number);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get flight");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Update status
-    auto flight = flightResult.value();
-    flight.setStatus(status);
+        // Save changes
+        auto updateResult = _flightRepository->updateStatus(rowResult.value().id, status, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update flight status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    // Save changes
-    auto updateResult = _flightRepository->update(flight);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update flight status");
-        return Failure<bool>(updateResult.error());
-    }
+        return Success(true);
+    });
+}
+
+Result<bool> FlightService::updateFlightStatus(const FlightNumber& number, FlightStatus status, FlightStatus expectedStatus) {
+    if (_logger) _logger->debug("Updating flight status for flight: " + number.toString());
+
+    // The version check makes the write conditional on the status read here; a retry re-checks it
+    return OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        auto rowResult = _flightRepository->findStatusRow(number);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get flight");
+            return Failure<bool>(rowResult.error());
+        }
+
+        // Another session changed the status since the caller looked at it
+        if (rowResult.value().status != expectedStatus) {
+            if (_logger) _logger->debug("Flight status changed concurrently, skipping: " + number.toString());
+            return Success(false);
+        }
 
-    return Success(true);
+        auto updateResult = _flightRepository->updateStatus(rowResult.value().id, status, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update flight status");
+            return Failure<bool>(updateResult.error());
+        }
+
+        return Success(true);
+    });
 }
 
 Result<bool> FlightService::isFlightFull(const FlightNumber& number) {
@@ -259,93 +376,105 @@ Result<bool> FlightService::isFlightFull(const FlightNumber& number) {
 }
 
 Result<bool> FlightService::cancelFlight(const FlightNumber& number, const std::string& reason) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "cancel");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger) _logger->debug("Cancelling flight: " + number.toString());
 
-    // Get flight
-    auto flightResult = _flightRepository->findByFlightNumber(number);
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
-    }
+    // Re-read the flight and retry when another session updated it in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Get flight status row (no aircraft join, no seat map)
+        auto rowResult = _flightRepository->findStatusRow(number);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get flight");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Check if flight can be cancelled
-    if (flightResult.value().getStatus() == FlightStatus::CANCELLED) {
-        if (_logger) _logger->error("Flight is already cancelled");
-        return Failure<bool>(CoreError("Flight is already cancelled", "INVALID_STATUS"));
-    }
+        // Check if flight can be cancelled
+        if (rowResult.value().status == FlightStatus::CANCELLED) {
+            if (_logger) _logger->error("Flight is already cancelled");
+            return Failure<bool>(CoreError("Flight is already cancelled", "INVALID_STATUS"));
+        }
 
-    // Update flight status
-    auto flight = flightResult.value();
-    flight.setStatus(FlightStatus::CANCELLED);
-    
-    auto updateResult = _flightRepository->update(flight);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update flight status");
-        return Failure<bool>(updateResult.error());
-    }
+        // Update flight status
+        auto updateResult = _flightRepository->updateStatus(rowResult.value().id, FlightStatus::CANCELLED, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update flight status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    return Success(true);
+        return Success(true);
+    }));
 }
 
 Result<bool> FlightService::delayFlight(const FlightNumber& number, const std::tm& newDepartureTime) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "delay");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger) _logger->debug("Delaying flight: " + number.toString());
 
-    // Get flight
-    auto flightResult = _flightRepository->findByFlightNumber(number);
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
-    }
+    // Re-read the flight and retry when another session updated it in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Get flight
+        auto flightResult = _flightRepository->findByFlightNumber(number);
+        if (!flightResult) {
+            if (_logger) _logger->error("Failed to get flight");
+            return Failure<bool>(flightResult.error());
+        }
 
-    // Check if flight can be delayed
-    if (flightResult.value().getStatus() == FlightStatus::CANCELLED) {
-        if (_logger) _logger->error("Cannot delay cancelled flight");
-        return Failure<bool>(CoreError("Cannot delay cancelled flight", "INVALID_STATUS"));
-    }
-
-    std::tm currentDeparture = flightResult.value().getSchedule().getDeparture();
-    
-    auto currentTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&currentDeparture));
-    auto newTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&newDepartureTime)));
-    
-    // Compare using chrono
-    if (newTimePoint <= currentTimePoint) {
-        if (_logger) _logger->error("New departure time must be later than current time");
-        return Failure<bool>(CoreError("Invalid departure time", "INVALID_TIME"));
-    }
-    
-    // Calculate delay duration
-    auto delayDuration = newTimePoint - currentTimePoint;
-    
-    // Calculate new arrival time
-    std::tm currentArrival = flightResult.value().getSchedule().getArrival();
-    auto arrivalTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&currentArrival));
-    auto newArrivalTimePoint = arrivalTimePoint + delayDuration;
-    
-    std::time_t newArrivalTime_t = std::chrono::system_clock::to_time_t(newArrivalTimePoint);
-    std::tm newArrival = *std::localtime(&newArrivalTime_t);
-    
-    // Create new schedule
-    auto newScheduleResult = Schedule::create(newDepartureTime, newArrival);
-    if (!newScheduleResult) {
-        return Failure<bool>(newScheduleResult.error());
-    }
-    
-    // Update flight
-    auto flight = flightResult.value();
-    flight.setSchedule(newScheduleResult.value());
-    flight.setStatus(FlightStatus::DELAYED);
-    
-    auto updateResult = _flightRepository->update(flight);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update flight schedule");
-        return Failure<bool>(updateResult.error());
-    }
-    
-    return Success(true);
+        // Check if flight can be delayed
+        if (flightResult.value().getStatus() == FlightStatus::CANCELLED) {
+            if (_logger) _logger->error("Cannot delay cancelled flight");
+            return Failure<bool>(CoreError("Cannot delay cancelled flight", "INVALID_STATUS"));
+        }
+
+        std::tm currentDeparture = flightResult.value().getSchedule().getDeparture();
+
+        auto currentTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&currentDeparture));
+        auto newTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&newDepartureTime)));
+
+        // Compare using chrono
+        if (newTimePoint <= currentTimePoint) {
+            if (_logger) _logger->error("New departure time must be later than current time");
+            return Failure<bool>(CoreError("Invalid departure time", "INVALID_TIME"));
+        }
+
+        // Calculate delay duration
+        auto delayDuration = newTimePoint - currentTimePoint;
+
+        // Calculate new arrival time
+        std::tm currentArrival = flightResult.value().getSchedule().getArrival();
+        auto arrivalTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&currentArrival));
+        auto newArrivalTimePoint = arrivalTimePoint + delayDuration;
+
+        std::time_t newArrivalTime_t = std::chrono::system_clock::to_time_t(newArrivalTimePoint);
+        std::tm newArrival = *std::localtime(&newArrivalTime_t);
+
+        // Create new schedule
+        auto newScheduleResult = Schedule::create(newDepartureTime, newArrival);
+        if (!newScheduleResult) {
+            return Failure<bool>(newScheduleResult.error());
+        }
+
+        // Update flight
+        auto flight = flightResult.value();
+        flight.setSchedule(newScheduleResult.value());
+        flight.setStatus(FlightStatus::DELAYED);
+
+        auto updateResult = _flightRepository->update(flight);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update flight schedule");
+            return Failure<bool>(updateResult.error());
+        }
+
+        return Success(true);
+    }));
 }
 
 Result<bool> FlightService::reserveSeat(const FlightNumber& number, const std::string& seatNumber) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "reserve_seat");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger) _logger->debug("Reserving seat for flight: " + number.toString());
 
     // Get flight
@@ -387,10 +516,13 @@ Result<bool> FlightService::reserveSeat(const FlightNumber& number, const std::s
         return Failure<bool>(reserveResult.error());
     }
 
-    return Success(true);
+    return timer.complete(Success(true));
 }
 
 Result<bool> FlightService::releaseSeat(const FlightNumber& number, const std::string& seatNumber) {
+    static const Metrics::OperationMetrics metrics("service", "flight", "release_seat");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger) _logger->debug("Releasing seat for flight: " + number.toString());
 
     // Get flight
@@ -432,7 +564,7 @@ Result<bool> FlightService::releaseSeat(const FlightNumber& number, const std::s
         return Failure<bool>(releaseResult.error());
     }
 
-    return Success(true);
+    return timer.complete(Success(true));
 }
 
 Result<int> FlightService::getRemainingCapacity(const FlightNumber& number) {
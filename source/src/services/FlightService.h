@@ -13,6 +13,7 @@
 #include "../repositories/MySQLRepository/AircraftRepository.h"
 #include "../repositories/MySQLRepository/TicketRepository.h"
 #include "../utils/Logger.h"
+#include "TypeAheadIndex.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -30,6 +31,7 @@ private:
     std::shared_ptr<AircraftRepository> _aircraftRepository;    ///< Repository để truy cập dữ liệu máy bay
     std::shared_ptr<TicketRepository> _ticketRepository;        ///< Repository để truy cập dữ liệu vé
     std::shared_ptr<Logger> _logger;                            ///< Logger để ghi log hệ thống
+    std::shared_ptr<TypeAheadIndex> _searchIndex;               ///< Chỉ mục tìm kiếm; null thì dùng chỉ mục dùng chung
 
     /**
      * @brief Lấy thông tin chuyến bay theo ID
@@ -88,6 +90,66 @@ public:
      */
     Result<std::vector<Flight>> getAllFlights();
     
+    /**
+     * @brief Nạp danh sách tóm tắt chuyến bay cho màn hình danh sách
+     * @param rows Vector đích, được tái sử dụng giữa các lần làm mới
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getFlightSummaries(std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Nạp danh sách tóm tắt chuyến bay kèm số ghế đã đặt theo từng hạng
+     *
+     * Số ghế đã đặt lấy từ một truy vấn gộp trên bảng vé, không nạp danh sách vé.
+     *
+     * @param rows Vector đích, được tái sử dụng giữa các lần làm mới
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getFlightSummariesWithOccupancy(std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Đếm tổng số chuyến bay (số hàng của danh sách ảo)
+     * @return Result<size_t> Số chuyến bay hoặc lỗi
+     */
+    Result<size_t> countFlights();
+
+    /**
+     * @brief Nạp một trang tóm tắt chuyến bay kèm số ghế đã đặt, theo thứ tự id
+     *
+     * Số ghế đã đặt chỉ được đếm cho khoảng id của trang.
+     *
+     * @param offset Chỉ số hàng đầu tiên của trang
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getFlightSummariesPage(size_t offset, size_t limit, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Tìm khi đang gõ: chuyến bay có số hiệu bắt đầu bằng text, kèm số ghế đã đặt
+     * @param text Văn bản đã gõ, không phân biệt hoa thường
+     * @param limit Số hàng tối đa
+     * @param rows Vector đích, theo thứ tự số hiệu
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     * @note Tra trên TypeAheadIndex; lần gọi đầu tiên nạp chỉ mục từ cả bảng chuyến bay
+     */
+    Result<size_t> suggestFlights(const std::string& text, size_t limit, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Nạp hàng tóm tắt kèm số ghế đã đặt của các chuyến bay cho trước
+     * @param ids Id chuyến bay, theo thứ tự muốn trả về
+     * @param rows Vector đích, theo thứ tự của ids; id không còn tồn tại bị bỏ qua
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getFlightSummariesByIds(const std::vector<int>& ids, std::vector<FlightSummaryRow>& rows);
+
+    /**
+     * @brief Dùng chỉ mục tìm kiếm riêng thay cho TypeAheadIndex::getInstance()
+     * @param index Chỉ mục; nullptr để quay về chỉ mục dùng chung
+     * @note Dùng trong test để mỗi cơ sở dữ liệu có chỉ mục của nó
+     */
+    void useSearchIndex(std::shared_ptr<TypeAheadIndex> index) { _searchIndex = std::move(index); }
+    
     /**
      * @brief Kiểm tra chuyến bay có tồn tại theo số hiệu
      * @param number Số hiệu chuyến bay
@@ -163,6 +225,18 @@ public:
      */
     Result<bool> updateFlightStatus(const FlightNumber& number, FlightStatus status);
 
+    /**
+     * @brief Cập nhật trạng thái chuyến bay chỉ khi trạng thái hiện tại vẫn là expectedStatus
+     *
+     * Dùng cho các tác vụ quyết định trạng thái mới từ một ảnh chụp đã đọc trước (sweep): nếu phiên
+     * khác đã đổi trạng thái trong lúc đó (ví dụ hủy chuyến), lệnh ghi bị bỏ qua thay vì ghi đè.
+     * @param number Số hiệu chuyến bay
+     * @param status Trạng thái mới
+     * @param expectedStatus Trạng thái mà người gọi đã thấy
+     * @return Result<bool> true nếu đã cập nhật, false nếu bỏ qua vì trạng thái đã khác
+     */
+    Result<bool> updateFlightStatus(const FlightNumber& number, FlightStatus status, FlightStatus expectedStatus);
+
     /**
      * @brief Hủy chuyến bay
      * @param number Số hiệu chuyến bay
@@ -0,0 +1,50 @@
+/**
+ * @file OptimisticRetry.h
+ * @brief Tiện ích thử lại thao tác khi UPDATE có điều kiện theo phiên bản bị xung đột
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Repository trả về lỗi có mã VERSION_CONFLICT khi bản ghi đã bị phiên khác thay đổi
+ * giữa lúc đọc và lúc ghi. Service bọc cả bước đọc lẫn bước ghi trong retryOnConflict
+ * để đọc lại phiên bản mới và ghi lại, thay vì giữ khóa trong suốt thao tác.
+ */
+
+#ifndef OPTIMISTIC_RETRY_H
+#define OPTIMISTIC_RETRY_H
+
+#include "../core/exceptions/Result.h"
+#include <string>
+
+namespace OptimisticRetry {
+    constexpr const char* VERSION_CONFLICT = "VERSION_CONFLICT"; ///< Mã lỗi xung đột phiên bản
+    constexpr int DEFAULT_MAX_ATTEMPTS = 3; ///< Số lần thử mặc định (gồm cả lần đầu)
+
+    /**
+     * @brief Kiểm tra lỗi có phải là xung đột phiên bản hay không
+     * @param error Lỗi cần kiểm tra
+     * @return true nếu mã lỗi là VERSION_CONFLICT
+     */
+    inline bool isVersionConflict(const CoreError& error) {
+        return error.code == VERSION_CONFLICT;
+    }
+
+    /**
+     * @brief Thực thi thao tác đọc-rồi-ghi và thử lại khi gặp xung đột phiên bản
+     *
+     * @tparam Operation Callable không tham số trả về Result<T>
+     * @param operation Thao tác cần thực thi; phải tự đọc lại dữ liệu ở mỗi lần gọi
+     * @param maxAttempts Số lần thử tối đa
+     * @return Kết quả của lần thử cuối cùng
+     */
+    template <typename Operation>
+    auto retryOnConflict(Operation&& operation, int maxAttempts = DEFAULT_MAX_ATTEMPTS) -> decltype(operation()) {
+        auto result = operation();
+        for (int attempt = 1; attempt < maxAttempts && !result && isVersionConflict(result.error()); ++attempt) {
+            result = operation();
+        }
+        return result;
+    }
+}
+
+#endif // OPTIMISTIC_RETRY_H
@@ -1,5 +1,6 @@
 #include "PassengerService.h"
 #include "../core/exceptions/Result.h"
+#include "../utils/Metrics.h"
 #include <algorithm>
 
 // Private helper methods
@@ -33,6 +34,23 @@ Result<std::vector<Passenger>> PassengerService::getAllPassengers()
     return _passengerRepository->findAll();
 }
 
+Result<size_t> PassengerService::getPassengerListRows(std::vector<PassengerListRow> &rows)
+{
+    if (_logger)
+        _logger->debug("Getting passenger list rows");
+    return _passengerRepository->findAllListRows(rows);
+}
+
+Result<size_t> PassengerService::countPassengers()
+{
+    return _passengerRepository->count();
+}
+
+Result<size_t> PassengerService::getPassengerListPage(size_t offset, size_t limit, std::vector<PassengerListRow> &rows)
+{
+    return _passengerRepository->findListRowsPage(offset, limit, rows);
+}
+
 Result<bool> PassengerService::passengerExists(const PassportNumber &passport)
 {
     if (_logger)
@@ -42,6 +60,9 @@ Result<bool> PassengerService::passengerExists(const PassportNumber &passport)
 
 Result<Passenger> PassengerService::createPassenger(const Passenger &passenger)
 {
+    static const Metrics::OperationMetrics metrics("service", "passenger", "create");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Creating passenger with passport: " + passenger.getPassport().toString());
 
@@ -61,11 +82,14 @@ Result<Passenger> PassengerService::createPassenger(const Passenger &passenger)
     }
 
     // Create passenger
-    return _passengerRepository->create(passenger);
+    return timer.complete(_passengerRepository->create(passenger));
 }
 
 Result<Passenger> PassengerService::updatePassenger(const Passenger &passenger)
 {
+    static const Metrics::OperationMetrics metrics("service", "passenger", "update");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Updating passenger with passport: " + passenger.getPassport().toString());
 
@@ -85,11 +109,14 @@ Result<Passenger> PassengerService::updatePassenger(const Passenger &passenger)
     }
 
     // Update passenger
-    return _passengerRepository->update(passenger);
+    return timer.complete(_passengerRepository->update(passenger));
 }
 
 Result<bool> PassengerService::deletePassenger(const PassportNumber &passport)
 {
+    static const Metrics::OperationMetrics metrics("service", "passenger", "delete");
+    Metrics::OperationTimer timer(metrics);
+
     if (_logger)
         _logger->debug("Deleting passenger with passport: " + passport.toString());
 
@@ -133,7 +160,7 @@ Result<bool> PassengerService::deletePassenger(const PassportNumber &passport)
     }
 
     // Delete passenger
-    return _passengerRepository->deleteByPassportNumber(passport);
+    return timer.complete(_passengerRepository->deleteByPassportNumber(passport));
 }
 
 // Passenger validation and business rules
@@ -235,4 +262,63 @@ Result<int> PassengerService::getTotalFlightCount(const PassportNumber &passport
     }
 
     return Success(count);
-}
\ No newline at end of file
+}
+
+Result<PassengerStatistics> PassengerService::getStatistics()
+{
+    static const Metrics::OperationMetrics metrics("service", "passenger", "statistics");
+    Metrics::OperationTimer timer(metrics);
+
+    if (_logger)
+        _logger->debug("Computing passenger statistics");
+
+    PassengerStatistics statistics;
+    auto countResult = _passengerRepository->count();
+    if (!countResult)
+    {
+        if (_logger)
+            _logger->error("Failed to count passengers");
+        return Failure<PassengerStatistics>(countResult.error());
+    }
+    statistics.totalPassengers = countResult.value();
+
+    // Một truy vấn COUNT(DISTINCT) trả về một hàng thay cho hai lần tải vé của từng hành khách
+    auto bookingsResult = _ticketRepository->countActiveBookings(statistics);
+    if (!bookingsResult)
+    {
+        if (_logger)
+            _logger->error("Failed to count active bookings");
+        return Failure<PassengerStatistics>(bookingsResult.error());
+    }
+
+    return timer.complete(Result<PassengerStatistics>(statistics));
+}
+
+Result<size_t> PassengerService::suggestPassengers(const std::string &text, size_t limit, std::vector<PassengerListRow> &rows)
+{
+    static const Metrics::OperationMetrics metrics("service", "passenger", "suggest");
+    Metrics::OperationTimer timer(metrics);
+
+    rows.clear();
+    auto index = _searchIndex ? _searchIndex : TypeAheadIndex::getInstance();
+    auto prepared = index->preparePassengers(*_passengerRepository);
+    if (!prepared)
+    {
+        if (_logger)
+            _logger->error("Failed to prepare passenger search index: " + prepared.error().message);
+        return timer.complete(Result<size_t>(Failure<size_t>(prepared.error())));
+    }
+
+    // Gõ số hộ chiếu thì khớp hộ chiếu là kết quả mong đợi nhất nên đứng trước
+    std::vector<int> ids;
+    index->find(SearchField::PASSPORT_NUMBER, text, limit, ids);
+    index->find(SearchField::PASSENGER_NAME, text, limit, ids);
+    if (ids.empty())
+        return timer.complete(Result<size_t>(Success(size_t(0))));
+
+    auto loaded = _passengerRepository->findListRowsByIds(ids, rows);
+    if (!loaded)
+        return timer.complete(loaded);
+    orderByIds(rows, ids);
+    return timer.complete(Result<size_t>(Success(rows.size())));
+}
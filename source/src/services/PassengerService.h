@@ -13,6 +13,7 @@
 #include "../repositories/MySQLRepository/TicketRepository.h"
 #include "../repositories/MySQLRepository/FlightRepository.h"
 #include "../utils/Logger.h"
+#include "TypeAheadIndex.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -31,14 +32,8 @@ private:
     std::shared_ptr<TicketRepository> _ticketRepository;        ///< Repository để truy cập dữ liệu vé
     std::shared_ptr<FlightRepository> _flightRepository;        ///< Repository để truy cập dữ liệu chuyến bay
     std::shared_ptr<Logger> _logger;                            ///< Logger để ghi log hệ thống
+    std::shared_ptr<TypeAheadIndex> _searchIndex;               ///< Chỉ mục tìm kiếm; null thì dùng chỉ mục dùng chung
 
-    /**
-     * @brief Lấy thông tin hành khách theo ID
-     * @param id ID của hành khách
-     * @return Result<Passenger> Kết quả chứa thông tin hành khách hoặc lỗi
-     */
-    Result<Passenger> getPassengerById(int id);
-    
     /**
      * @brief Kiểm tra hành khách có tồn tại theo ID
      * @param id ID của hành khách cần kiểm tra
@@ -76,6 +71,13 @@ public:
     }
 
     // Core CRUD operations
+    /**
+     * @brief Lấy thông tin hành khách theo ID
+     * @param id ID của hành khách
+     * @return Result<Passenger> Kết quả chứa thông tin hành khách hoặc lỗi NOT_FOUND
+     */
+    Result<Passenger> getPassengerById(int id);
+
     /**
      * @brief Lấy thông tin hành khách theo số hộ chiếu
      * @param passport Số hộ chiếu của hành khách
@@ -89,6 +91,28 @@ public:
      */
     Result<std::vector<Passenger>> getAllPassengers();
     
+    /**
+     * @brief Nạp danh sách hành khách dạng phẳng cho màn hình danh sách
+     * @param rows Vector đích, được tái sử dụng giữa các lần làm mới
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getPassengerListRows(std::vector<PassengerListRow>& rows);
+
+    /**
+     * @brief Đếm tổng số hành khách (số hàng của danh sách ảo)
+     * @return Result<size_t> Số hành khách hoặc lỗi
+     */
+    Result<size_t> countPassengers();
+
+    /**
+     * @brief Nạp một trang hành khách dạng phẳng cho danh sách ảo, theo thứ tự id
+     * @param offset Chỉ số hàng đầu tiên của trang
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getPassengerListPage(size_t offset, size_t limit, std::vector<PassengerListRow>& rows);
+    
     /**
      * @brief Kiểm tra hành khách có tồn tại theo số hộ chiếu
      * @param passport Số hộ chiếu của hành khách
@@ -138,6 +162,34 @@ public:
      * @return Result<int> Tổng số chuyến bay hoặc lỗi
      */
     Result<int> getTotalFlightCount(const PassportNumber& passport);
+
+    /**
+     * @brief Thống kê toàn bộ hành khách bằng hai truy vấn gộp
+     * @return Result<PassengerStatistics> Số hành khách, số hành khách có đặt chỗ đang hoạt động
+     *         và tổng số vé đang hoạt động, hoặc lỗi
+     * @note Cho cùng kết quả như gọi hasActiveBookings và getTotalFlightCount cho từng hành khách
+     */
+    Result<PassengerStatistics> getStatistics();
+
+    /**
+     * @brief Tìm khi đang gõ: hành khách có số hộ chiếu hoặc một từ trong họ tên bắt đầu bằng text
+     *
+     * Tra trên TypeAheadIndex, không quét bảng; chỉ các hàng khớp được nạp bằng một truy vấn theo id.
+     * Lần gọi đầu tiên nạp chỉ mục từ cả bảng hành khách.
+     *
+     * @param text Văn bản đã gõ, không phân biệt hoa thường và dấu
+     * @param limit Số hàng tối đa
+     * @param rows Vector đích: khớp hộ chiếu trước, rồi khớp họ tên, mỗi nhóm theo thứ tự chữ cái
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> suggestPassengers(const std::string& text, size_t limit, std::vector<PassengerListRow>& rows);
+
+    /**
+     * @brief Dùng chỉ mục tìm kiếm riêng thay cho TypeAheadIndex::getInstance()
+     * @param index Chỉ mục; nullptr để quay về chỉ mục dùng chung
+     * @note Dùng trong test để mỗi cơ sở dữ liệu có chỉ mục của nó
+     */
+    void useSearchIndex(std::shared_ptr<TypeAheadIndex> index) { _searchIndex = std::move(index); }
 };
 
 #endif // PASSENGER_SERVICE_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ * @file RequestContext.h
+ * @brief Bộ nhớ đệm theo phạm vi một thao tác service
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Một thao tác như đặt vé gọi nhiều bước kiểm tra, mỗi bước lại tự đọc hành khách
+ * và chuyến bay từ repository. RequestContext ghi nhớ kết quả đọc (kể cả lỗi) theo
+ * khóa nghiệp vụ để mỗi thực thể chỉ được đọc tối đa một lần trong một thao tác.
+ * Đối tượng được tạo trên stack ở đầu thao tác và bị hủy khi thao tác kết thúc,
+ * nên không có dữ liệu cũ nào sống sót sang thao tác khác.
+ */
+
+#ifndef REQUEST_CONTEXT_H
+#define REQUEST_CONTEXT_H
+
+#include "../repositories/MySQLRepository/PassengerRepository.h"
+#include "../repositories/MySQLRepository/FlightRepository.h"
+#include "../repositories/MySQLRepository/TicketRepository.h"
+#include "../core/exceptions/Result.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class RequestContext {
+private:
+    std::shared_ptr<PassengerRepository> _passengerRepository;
+    std::shared_ptr<FlightRepository> _flightRepository;
+    std::shared_ptr<TicketRepository> _ticketRepository;
+
+    std::unordered_map<std::string, Result<Passenger>> _passengersByPassport;
+    std::unordered_map<std::string, Result<Flight>> _flightsByNumber;
+    std::unordered_map<int, Result<size_t>> _ticketCountsByFlight;
+    size_t _repositoryReads = 0;
+
+public:
+    /**
+     * @brief Constructor
+     * @param passengerRepository Repository hành khách
+     * @param flightRepository Repository chuyến bay
+     * @param ticketRepository Repository vé
+     */
+    RequestContext(std::shared_ptr<PassengerRepository> passengerRepository,
+                   std::shared_ptr<FlightRepository> flightRepository,
+                   std::shared_ptr<TicketRepository> ticketRepository)
+        : _passengerRepository(std::move(passengerRepository)),
+          _flightRepository(std::move(flightRepository)),
+          _ticketRepository(std::move(ticketRepository)) {}
+
+    RequestContext(const RequestContext&) = delete;
+    RequestContext& operator=(const RequestContext&) = delete;
+
+    /**
+     * @brief Lấy hành khách theo số hộ chiếu, chỉ đọc repository ở lần gọi đầu
+     * @param passport Số hộ chiếu
+     * @return Kết quả đã ghi nhớ
+     */
+    const Result<Passenger>& passengerByPassport(const PassportNumber& passport) {
+        auto key = passport.toString();
+        auto it = _passengersByPassport.find(key);
+        if (it == _passengersByPassport.end()) {
+            ++_repositoryReads;
+            it = _passengersByPassport.emplace(key, _passengerRepository->findByPassportNumber(passport)).first;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Lấy chuyến bay theo số hiệu, chỉ đọc repository ở lần gọi đầu
+     * @param flightNumber Số hiệu chuyến bay
+     * @return Kết quả đã ghi nhớ
+     */
+    const Result<Flight>& flightByNumber(const FlightNumber& flightNumber) {
+        auto key = flightNumber.toString();
+        auto it = _flightsByNumber.find(key);
+        if (it == _flightsByNumber.end()) {
+            ++_repositoryReads;
+            it = _flightsByNumber.emplace(key, _flightRepository->findByFlightNumber(flightNumber)).first;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Lấy số vé của chuyến bay, chỉ đếm ở lần gọi đầu
+     * @param flightId ID chuyến bay
+     * @return Kết quả đã ghi nhớ
+     */
+    const Result<size_t>& ticketCountForFlight(int flightId) {
+        auto it = _ticketCountsByFlight.find(flightId);
+        if (it == _ticketCountsByFlight.end()) {
+            ++_repositoryReads;
+            it = _ticketCountsByFlight.emplace(flightId, _ticketRepository->countByFlightId(flightId)).first;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Ghi nhớ một hành khách đã được đọc trước đó, ví dụ khi facade bất đồng bộ tra cứu
+     *        hành khách và chuyến bay song song rồi mới đặt vé
+     * @param passenger Hành khách đã đọc
+     */
+    void preload(const Passenger& passenger) {
+        _passengersByPassport.insert_or_assign(passenger.getPassport().toString(), Result<Passenger>(passenger));
+    }
+
+    /**
+     * @brief Ghi nhớ một chuyến bay đã được đọc trước đó
+     * @param flight Chuyến bay đã đọc
+     */
+    void preload(const Flight& flight) {
+        _flightsByNumber.insert_or_assign(flight.getFlightNumber().toString(), Result<Flight>(flight));
+    }
+
+    /**
+     * @brief Số lần thực sự gọi xuống repository trong thao tác này
+     * @return Số lần đọc
+     */
+    size_t getRepositoryReads() const {
+        return _repositoryReads;
+    }
+};
+
+#endif // REQUEST_CONTEXT_H
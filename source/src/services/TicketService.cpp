@@ -1,6 +1,10 @@
 #include "TicketService.h"
+#include "OptimisticRetry.h"
 #include "../core/exceptions/Result.h"
+#include "../utils/Metrics.h"
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <sstream>
 #include <iomanip>
 
@@ -251,6 +255,42 @@ Result<std::vector<Ticket>> TicketService::getAllTickets() {
     return _ticketRepository->findAll();
 }
 
+Result<size_t> TicketService::getTicketListRows(std::vector<TicketListRow>& rows) {
+    if (_logger) _logger->debug("Getting ticket list rows");
+    return _ticketRepository->findAllListRows(rows);
+}
+
+Result<size_t> TicketService::countTickets() {
+    return _ticketRepository->count();
+}
+
+Result<size_t> TicketService::getTicketListPage(size_t offset, size_t limit, std::vector<TicketListRow>& rows) {
+    return _ticketRepository->findListRowsPage(offset, limit, rows);
+}
+
+Result<size_t> TicketService::suggestTickets(const std::string& text, size_t limit, std::vector<TicketListRow>& rows) {
+    static const Metrics::OperationMetrics metrics("service", "ticket", "suggest");
+    Metrics::OperationTimer timer(metrics);
+
+    rows.clear();
+    auto index = _searchIndex ? _searchIndex : TypeAheadIndex::getInstance();
+    auto prepared = index->prepareTickets(*_ticketRepository);
+    if (!prepared) {
+        if (_logger) _logger->error("Failed to prepare ticket search index: " + prepared.error().message);
+        return timer.complete(Result<size_t>(Failure<size_t>(prepared.error())));
+    }
+
+    std::vector<int> ids;
+    if (index->find(SearchField::TICKET_NUMBER, text, limit, ids) == 0) {
+        return timer.complete(Result<size_t>(Success(size_t(0))));
+    }
+
+    auto loaded = _ticketRepository->findListRowsByIds(ids, rows);
+    if (!loaded) return timer.complete(loaded);
+    orderByIds(rows, ids);
+    return timer.complete(Result<size_t>(Success(rows.size())));
+}
+
 Result<bool> TicketService::ticketExists(const TicketNumber& ticketNumber) {
     if (_logger) _logger->debug("Checking if ticket exists: " + ticketNumber.toString());
     return _ticketRepository->existsTicket(ticketNumber);
@@ -334,25 +374,38 @@ Result<Ticket> TicketService::bookTicket(
     const FlightNumber& flightNumber,
     const std::string& seatClass,
     const Price& price) {
+    // Every lookup below goes through the context so each entity is read at most once
+    RequestContext context(_passengerRepository, _flightRepository, _ticketRepository);
+    return bookTicket(context, passport, flightNumber, seatClass, price);
+}
+
+Result<Ticket> TicketService::bookTicket(
+    RequestContext& context,
+    const PassportNumber& passport,
+    const FlightNumber& flightNumber,
+    const std::string& seatClass,
+    const Price& price) {
+    static const Metrics::OperationMetrics metrics("service", "ticket", "book");
+    Metrics::OperationTimer timer(metrics);
     
     if (_logger) _logger->debug("Booking ticket for passenger " + passport.toString() + " on flight " + flightNumber.toString());
 
     // Check if passenger exists
-    auto passengerResult = _passengerRepository->findByPassportNumber(passport);
+    const auto& passengerResult = context.passengerByPassport(passport);
     if (!passengerResult) {
         if (_logger) _logger->error("Failed to get passenger");
         return Failure<Ticket>(passengerResult.error());
     }
 
-    // Check if flight exists
-    auto flightResult = _flightRepository->findByFlightNumber(flightNumber);
+    // Check if flight exists; copied because reserveSeat mutates it
+    auto flightResult = context.flightByNumber(flightNumber);
     if (!flightResult) {
         if (_logger) _logger->error("Failed to get flight");
         return Failure<Ticket>(flightResult.error());
     }
 
     // Check if passenger can book flight
-    auto canBookResult = canBookFlight(passport, flightNumber);
+    auto canBookResult = canBookFlight(context, passport, flightNumber);
     if (!canBookResult) {
         if (_logger) _logger->error("Failed to check if passenger can book flight");
         return Failure<Ticket>(canBookResult.error());
@@ -364,14 +417,14 @@ Result<Ticket> TicketService::bookTicket(
 
     // Create ticket
     // Get current ticket count for this flight
-    auto flightTicketsResult = _ticketRepository->findByFlightId(flightResult.value().getId());
-    if (!flightTicketsResult) {
+    const auto& flightTicketCount = context.ticketCountForFlight(flightResult.value().getId());
+    if (!flightTicketCount) {
         if (_logger) _logger->error("Failed to get flight tickets");
-        return Failure<Ticket>(flightTicketsResult.error());
+        return Failure<Ticket>(flightTicketCount.error());
     }
     
     // Calculate next ticket number
-    int nextTicketNumber = flightTicketsResult.value().size() + 1;
+    int nextTicketNumber = flightTicketCount.value() + 1;
     // Lấy ngày hiện tại theo định dạng YYYYMMDD
     auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
@@ -462,162 +515,332 @@ Result<Ticket> TicketService::bookTicket(
     ticketResult.value().setStatus(TicketStatus::CONFIRMED);
 
     // Save ticket
-    return _ticketRepository->create(ticketResult.value());
+    return timer.complete(_ticketRepository->create(ticketResult.value()));
 }
 
-Result<bool> TicketService::cancelTicket(const TicketNumber& ticketNumber, const std::string& reason) {
-    if (_logger) _logger->debug("Cancelling ticket: " + ticketNumber.toString());
+Result<std::vector<Ticket>> TicketService::bookGroup(
+    const std::vector<PassportNumber>& passports,
+    const FlightNumber& flightNumber,
+    const std::string& seatClassCode,
+    const Price& price) {
+    static const Metrics::OperationMetrics metrics("service", "ticket", "book_group");
+    Metrics::OperationTimer timer(metrics);
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
-        if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
+    if (_logger) _logger->debug("Booking " + std::to_string(passports.size()) + " tickets on flight " + flightNumber.toString());
+
+    if (passports.empty() || seatClassCode.empty()) {
+        if (_logger) _logger->error("Group booking requires passengers and a seat class");
+        return Failure<std::vector<Ticket>>(CoreError("Group booking requires passengers and a seat class", "INVALID_GROUP"));
     }
 
-    // Check if ticket can be cancelled
-    auto canCancelResult = canCancelTicket(ticketNumber);
-    if (!canCancelResult) {
-        if (_logger) _logger->error("Failed to check if ticket can be cancelled");
-        return Failure<bool>(canCancelResult.error());
+    std::unordered_set<std::string> uniquePassports;
+    for (const auto& passport : passports) {
+        if (!uniquePassports.insert(passport.toString()).second) {
+            if (_logger) _logger->error("Duplicate passenger in group: " + passport.toString());
+            return Failure<std::vector<Ticket>>(CoreError("Duplicate passenger in group: " + passport.toString(), "DUPLICATE_PASSENGER"));
+        }
     }
-    if (!canCancelResult.value()) {
-        if (_logger) _logger->error("Ticket cannot be cancelled");
-        return Failure<bool>(CoreError("Ticket cannot be cancelled", "CANNOT_CANCEL_TICKET"));
+
+    RequestContext context(_passengerRepository, _flightRepository, _ticketRepository);
+
+    // Check if flight exists; copied because reserveSeat mutates it
+    auto flightResult = context.flightByNumber(flightNumber);
+    if (!flightResult) {
+        if (_logger) _logger->error("Failed to get flight");
+        return Failure<std::vector<Ticket>>(flightResult.error());
     }
+    auto& flight = flightResult.value();
 
-    // Update ticket status
-    auto ticket = ticketResult.value();
-    ticket.setStatus(TicketStatus::CANCELLED);
+    // Same booking rule as canBookFlight
+    if (!hasDeparted(flight.getSchedule().getDeparture())) {
+        if (_logger) _logger->error("Passengers cannot book flight");
+        return Failure<std::vector<Ticket>>(CoreError("Passenger cannot book flight", "CANNOT_BOOK_FLIGHT"));
+    }
 
-    auto updateResult = _ticketRepository->update(ticket);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update ticket status");
-        return Failure<bool>(updateResult.error());
+    // Validate every passenger with a single query
+    auto passengersResult = _passengerRepository->findByPassportNumbers(passports);
+    if (!passengersResult) {
+        if (_logger) _logger->error("Failed to get passengers");
+        return Failure<std::vector<Ticket>>(passengersResult.error());
+    }
+    std::unordered_map<std::string, std::shared_ptr<Passenger>> passengersByPassport;
+    for (const auto& passenger : passengersResult.value()) {
+        passengersByPassport.emplace(passenger.getPassport().toString(), std::make_shared<Passenger>(passenger));
+    }
+    for (const auto& passport : passports) {
+        if (passengersByPassport.find(passport.toString()) == passengersByPassport.end()) {
+            if (_logger) _logger->error("Passenger not found with passport number: " + passport.toString());
+            return Failure<std::vector<Ticket>>(CoreError("Passenger not found with passport number: " + passport.toString(), "NOT_FOUND"));
+        }
     }
 
-    return Success(true);
+    // Pick seats from the flight's seat map, adjacent when possible
+    auto seats = pickGroupSeats(flight, seatClassCode[0], passports.size());
+    if (seats.empty()) {
+        if (_logger) _logger->error("Not enough available seats in class " + seatClassCode.substr(0, 1));
+        return Failure<std::vector<Ticket>>(CoreError("Not enough available seats", "SEAT_NOT_AVAILABLE"));
+    }
+    for (const auto& seat : seats) {
+        flight.reserveSeat(seat.toString());
+    }
+
+    // Allocate a contiguous block of ticket numbers
+    const auto& flightTicketCount = context.ticketCountForFlight(flight.getId());
+    if (!flightTicketCount) {
+        if (_logger) _logger->error("Failed to get flight tickets");
+        return Failure<std::vector<Ticket>>(flightTicketCount.error());
+    }
+
+    auto now = std::chrono::system_clock::now();
+    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    std::tm tm_now;
+    #if defined(_WIN32) || defined(_WIN64)
+        localtime_s(&tm_now, &now_c);
+    #else
+        localtime_r(&now_c, &tm_now);
+    #endif
+    std::stringstream date_ss;
+    date_ss << std::put_time(&tm_now, "%Y%m%d");
+    const std::string ticketPrefix = flight.getFlightNumber().toString() + "-" + date_ss.str() + "-";
+
+    auto sharedFlight = std::make_shared<Flight>(flight);
+    std::vector<Ticket> tickets;
+    tickets.reserve(passports.size());
+    for (size_t i = 0; i < passports.size(); ++i) {
+        std::stringstream sequence;
+        sequence << std::setfill('0') << std::setw(4) << (flightTicketCount.value() + i + 1);
+        auto ticketNumberResult = TicketNumber::create(ticketPrefix + sequence.str());
+        if (!ticketNumberResult) {
+            if (_logger) _logger->error("Failed to create ticket number");
+            return Failure<std::vector<Ticket>>(ticketNumberResult.error());
+        }
+
+        auto ticketResult = Ticket::create(
+            ticketNumberResult.value(),
+            passengersByPassport.at(passports[i].toString()),
+            sharedFlight,
+            seats[i],
+            price
+        );
+        if (!ticketResult) {
+            if (_logger) _logger->error("Failed to create ticket");
+            return Failure<std::vector<Ticket>>(ticketResult.error());
+        }
+        ticketResult.value().setStatus(TicketStatus::CONFIRMED);
+        tickets.push_back(std::move(ticketResult.value()));
+    }
+
+    // Reserve the seats and insert all tickets in one transaction
+    return timer.complete(_ticketRepository->createBatch(tickets));
+}
+
+std::vector<SeatNumber> TicketService::pickGroupSeats(const Flight& flight, char classCode, size_t count) {
+    std::vector<SeatNumber> available;
+    for (const auto& [seat, isAvailable] : flight.getSeatAvailability()) {
+        if (isAvailable && seat.getClassCode() == classCode) {
+            available.push_back(seat);
+        }
+    }
+    if (available.size() < count) {
+        return {};
+    }
+
+    std::sort(available.begin(), available.end(), [](const SeatNumber& a, const SeatNumber& b) {
+        return a.getSequenceNumber() < b.getSequenceNumber();
+    });
+
+    // First run of count consecutive sequence numbers
+    size_t runStart = 0;
+    for (size_t i = 1; i <= available.size(); ++i) {
+        if (i - runStart == count) {
+            return std::vector<SeatNumber>(available.begin() + runStart, available.begin() + i);
+        }
+        if (i < available.size() && available[i].getSequenceNumber() != available[i - 1].getSequenceNumber() + 1) {
+            runStart = i;
+        }
+    }
+
+    // No adjacent block: take the lowest-numbered free seats
+    return std::vector<SeatNumber>(available.begin(), available.begin() + count);
+}
+
+Result<bool> TicketService::cancelTicket(const TicketNumber& ticketNumber, const std::string& reason) {
+    static const Metrics::OperationMetrics metrics("service", "ticket", "cancel");
+    Metrics::OperationTimer timer(metrics);
+
+    if (_logger) _logger->debug("Cancelling ticket: " + ticketNumber.toString());
+
+    // Re-read the status row and retry when another session updated the ticket in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Load only the status row (id, status, departure) instead of the full ticket graph
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
+
+        // Check if ticket can be cancelled
+        if (!hasDeparted(rowResult.value().departureTime)) {
+            if (_logger) _logger->error("Ticket cannot be cancelled");
+            return Failure<bool>(CoreError("Ticket cannot be cancelled", "CANNOT_CANCEL_TICKET"));
+        }
+
+        // Update ticket status
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, TicketStatus::CANCELLED, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
+
+        return Success(true);
+    }));
 }
 
 // Status management
 Result<bool> TicketService::updateTicketStatus(const TicketNumber& ticketNumber, TicketStatus status) {
     if (_logger) _logger->debug("Updating ticket status: " + ticketNumber.toString());
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
-        if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
+    // Re-read the status row and retry when another session updated the ticket in between
+    return OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Check if ticket exists
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Update ticket status
-    auto ticket = ticketResult.value();
-    ticket.setStatus(status);
+        // Update ticket status
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, status, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    auto updateResult = _ticketRepository->update(ticket);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update ticket status");
-        return Failure<bool>(updateResult.error());
-    }
+        return Success(true);
+    });
+}
+
+Result<bool> TicketService::updateTicketStatus(const TicketNumber& ticketNumber, TicketStatus status, TicketStatus expectedStatus) {
+    if (_logger) _logger->debug("Updating ticket status: " + ticketNumber.toString());
+
+    // The version check makes the write conditional on the status read here; a retry re-checks it
+    return OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
+
+        // Another session changed the status since the caller looked at it
+        if (rowResult.value().status != expectedStatus) {
+            if (_logger) _logger->debug("Ticket status changed concurrently, skipping: " + ticketNumber.toString());
+            return Success(false);
+        }
 
-    return Success(true);
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, status, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
+
+        return Success(true);
+    });
 }
 
 Result<bool> TicketService::checkInTicket(const TicketNumber& ticketNumber) {
-    if (_logger) _logger->debug("Checking in ticket: " + ticketNumber.toString());
+    static const Metrics::OperationMetrics metrics("service", "ticket", "check_in");
+    Metrics::OperationTimer timer(metrics);
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
-        if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
+    if (_logger) _logger->debug("Checking in ticket: " + ticketNumber.toString());
 
-    // Check if ticket can be checked in
-    auto canCheckInResult = canCheckIn(ticketNumber);
-    if (!canCheckInResult) {
-        if (_logger) _logger->error("Failed to check if ticket can be checked in");
-        return Failure<bool>(canCheckInResult.error());
-    }
-    if (!canCheckInResult.value()) {
-        if (_logger) _logger->error("Ticket cannot be checked in");
-        return Failure<bool>(CoreError("Ticket cannot be checked in", "CANNOT_CHECK_IN"));
-    }
+    // Re-read the status row and retry when another session updated the ticket in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Check if ticket exists
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Update ticket status
-    auto ticket = ticketResult.value();
-    ticket.setStatus(TicketStatus::CHECKED_IN);
+        // Check if ticket can be checked in
+        if (!hasDeparted(rowResult.value().departureTime)) {
+            if (_logger) _logger->error("Ticket cannot be checked in");
+            return Failure<bool>(CoreError("Ticket cannot be checked in", "CANNOT_CHECK_IN"));
+        }
 
-    auto updateResult = _ticketRepository->update(ticket);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update ticket status");
-        return Failure<bool>(updateResult.error());
-    }
+        // Update ticket status
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, TicketStatus::CHECKED_IN, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    return Success(true);
+        return Success(true);
+    }));
 }
 
 Result<bool> TicketService::boardPassenger(const TicketNumber& ticketNumber) {
-    if (_logger) _logger->debug("Boarding passenger with ticket: " + ticketNumber.toString());
+    static const Metrics::OperationMetrics metrics("service", "ticket", "board");
+    Metrics::OperationTimer timer(metrics);
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
-        if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
+    if (_logger) _logger->debug("Boarding passenger with ticket: " + ticketNumber.toString());
 
-    // Check if ticket is checked in
-    auto ticket = ticketResult.value();
-    if (ticket.getStatus() != TicketStatus::CHECKED_IN) {
-        if (_logger) _logger->error("Ticket is not checked in");
-        return Failure<bool>(CoreError("Ticket is not checked in", "NOT_CHECKED_IN"));
-    }
+    // Re-read the status row and retry when another session updated the ticket in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Check if ticket exists
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Update ticket status
-    ticket.setStatus(TicketStatus::BOARDED);
+        // Check if ticket is checked in
+        if (rowResult.value().status != TicketStatus::CHECKED_IN) {
+            if (_logger) _logger->error("Ticket is not checked in");
+            return Failure<bool>(CoreError("Ticket is not checked in", "NOT_CHECKED_IN"));
+        }
 
-    auto updateResult = _ticketRepository->update(ticket);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update ticket status");
-        return Failure<bool>(updateResult.error());
-    }
+        // Update ticket status
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, TicketStatus::BOARDED, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    return Success(true);
+        return Success(true);
+    }));
 }
 
 Result<bool> TicketService::refundTicket(const TicketNumber& ticketNumber, const std::string& reason) {
-    if (_logger) _logger->debug("Refunding ticket: " + ticketNumber.toString());
+    static const Metrics::OperationMetrics metrics("service", "ticket", "refund");
+    Metrics::OperationTimer timer(metrics);
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
-        if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
+    if (_logger) _logger->debug("Refunding ticket: " + ticketNumber.toString());
 
-    // Check if ticket can be refunded
-    auto canRefundResult = canRefund(ticketNumber);
-    if (!canRefundResult) {
-        if (_logger) _logger->error("Failed to check if ticket can be refunded");
-        return Failure<bool>(canRefundResult.error());
-    }
-    if (!canRefundResult.value()) {
-        if (_logger) _logger->error("Ticket cannot be refunded");
-        return Failure<bool>(CoreError("Ticket cannot be refunded", "CANNOT_REFUND_TICKET"));
-    }
+    // Re-read the status row and retry when another session updated the ticket in between
+    return timer.complete(OptimisticRetry::retryOnConflict([&]() -> Result<bool> {
+        // Check if ticket exists
+        auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+        if (!rowResult) {
+            if (_logger) _logger->error("Failed to get ticket");
+            return Failure<bool>(rowResult.error());
+        }
 
-    // Update ticket status
-    auto ticket = ticketResult.value();
-    ticket.setStatus(TicketStatus::REFUNDED);
+        // Check if ticket can be refunded
+        if (!hasDeparted(rowResult.value().departureTime)) {
+            if (_logger) _logger->error("Ticket cannot be refunded");
+            return Failure<bool>(CoreError("Ticket cannot be refunded", "CANNOT_REFUND_TICKET"));
+        }
 
-    auto updateResult = _ticketRepository->update(ticket);
-    if (!updateResult) {
-        if (_logger) _logger->error("Failed to update ticket status");
-        return Failure<bool>(updateResult.error());
-    }
+        // Update ticket status
+        auto updateResult = _ticketRepository->updateStatus(rowResult.value().id, TicketStatus::REFUNDED, rowResult.value().version);
+        if (!updateResult) {
+            if (_logger) _logger->error("Failed to update ticket status");
+            return Failure<bool>(updateResult.error());
+        }
 
-    return Success(true);
+        return Success(true);
+    }));
 }
 
 // Search operations
@@ -669,124 +892,92 @@ TicketSearchBuilder TicketService::createSearchBuilder() {
 Result<bool> TicketService::canCancelTicket(const TicketNumber& ticketNumber) {
     if (_logger) _logger->debug("Checking if ticket can be cancelled: " + ticketNumber.toString());
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
+    // Check if ticket exists; the status row already carries the flight departure time
+    auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+    if (!rowResult) {
         if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
-
-    // Get flight
-    auto flightResult = _flightRepository->findById(ticketResult.value().getFlight()->getId());
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
+        return Failure<bool>(rowResult.error());
     }
 
     // Check if flight has departed
-    auto flight = flightResult.value();
-    auto departureTime = flight.getSchedule().getDeparture();
-    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&departureTime)));
-    return Success(departureTimePoint < std::chrono::system_clock::now());
+    return Success(hasDeparted(rowResult.value().departureTime));
 }
 
 Result<bool> TicketService::canCheckIn(const TicketNumber& ticketNumber) {
     if (_logger) _logger->debug("Checking if ticket can be checked in: " + ticketNumber.toString());
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
+    // Check if ticket exists; the status row already carries the flight departure time
+    auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+    if (!rowResult) {
         if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
-
-    // Get flight
-    auto flightResult = _flightRepository->findById(ticketResult.value().getFlight()->getId());
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
+        return Failure<bool>(rowResult.error());
     }
 
     // Check if flight has departed
-    auto flight = flightResult.value();
-    auto departureTime = flight.getSchedule().getDeparture();
-    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&departureTime)));
-    return Success(departureTimePoint < std::chrono::system_clock::now());
+    return Success(hasDeparted(rowResult.value().departureTime));
 }
 
 Result<bool> TicketService::canRefund(const TicketNumber& ticketNumber) {
     if (_logger) _logger->debug("Checking if ticket can be refunded: " + ticketNumber.toString());
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
+    // Check if ticket exists; the status row already carries the flight departure time
+    auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+    if (!rowResult) {
         if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
-
-    // Get flight
-    auto flightResult = _flightRepository->findById(ticketResult.value().getFlight()->getId());
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
+        return Failure<bool>(rowResult.error());
     }
 
     // Check if flight has departed
-    auto flight = flightResult.value();
-    auto departureTime = flight.getSchedule().getDeparture();
-    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&departureTime)));
-    return Success(departureTimePoint < std::chrono::system_clock::now());
+    return Success(hasDeparted(rowResult.value().departureTime));
 }
 
 Result<bool> TicketService::isTicketExpired(const TicketNumber& ticketNumber) {
     if (_logger) _logger->debug("Checking if ticket is expired: " + ticketNumber.toString());
 
-    // Check if ticket exists
-    auto ticketResult = _ticketRepository->findByTicketNumber(ticketNumber);
-    if (!ticketResult) {
+    // Check if ticket exists; the status row already carries the flight departure time
+    auto rowResult = _ticketRepository->findStatusRow(ticketNumber);
+    if (!rowResult) {
         if (_logger) _logger->error("Failed to get ticket");
-        return Failure<bool>(ticketResult.error());
-    }
-
-    // Get flight
-    auto flightResult = _flightRepository->findById(ticketResult.value().getFlight()->getId());
-    if (!flightResult) {
-        if (_logger) _logger->error("Failed to get flight");
-        return Failure<bool>(flightResult.error());
+        return Failure<bool>(rowResult.error());
     }
 
     // Check if flight has departed
-    auto flight = flightResult.value();
-    auto departureTime = flight.getSchedule().getDeparture();
-    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&departureTime)));
-    return Success(departureTimePoint < std::chrono::system_clock::now());
+    return Success(hasDeparted(rowResult.value().departureTime));
 }
 
 Result<bool> TicketService::canBookFlight(const PassportNumber& passport, const FlightNumber& flightNumber) {
+    RequestContext context(_passengerRepository, _flightRepository, _ticketRepository);
+    return canBookFlight(context, passport, flightNumber);
+}
+
+Result<bool> TicketService::canBookFlight(RequestContext& context, const PassportNumber& passport, const FlightNumber& flightNumber) {
     if (_logger) _logger->debug("Checking if passenger can book flight: " + passport.toString() + " - " + flightNumber.toString());
 
     // Check if passenger exists
-    auto passengerResult = _passengerRepository->findByPassportNumber(passport);
+    const auto& passengerResult = context.passengerByPassport(passport);
     if (!passengerResult) {
         if (_logger) _logger->error("Failed to get passenger");
         return Failure<bool>(passengerResult.error());
     }
 
     // Check if flight exists
-    auto flightResult = _flightRepository->findByFlightNumber(flightNumber);
+    const auto& flightResult = context.flightByNumber(flightNumber);
     if (!flightResult) {
         if (_logger) _logger->error("Failed to get flight");
         return Failure<bool>(flightResult.error());
     }
 
     // Check if flight has departed
-    auto flight = flightResult.value();
-    auto departureTime = flight.getSchedule().getDeparture();
-    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(const_cast<std::tm*>(&departureTime)));
-    return Success(departureTimePoint < std::chrono::system_clock::now());
+    return Success(hasDeparted(flightResult.value().getSchedule().getDeparture()));
 }
 
 // Utility methods
+bool TicketService::hasDeparted(const std::tm& departureTime) {
+    auto departure = departureTime;
+    auto departureTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&departure));
+    return departureTimePoint < std::chrono::system_clock::now();
+}
+
 Result<bool> TicketService::hasActiveTickets(const PassportNumber& passport) {
     if (_logger) _logger->debug("Checking if passenger has active tickets: " + passport.toString());
 
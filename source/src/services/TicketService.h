@@ -13,6 +13,8 @@
 #include "../repositories/MySQLRepository/PassengerRepository.h"
 #include "../repositories/MySQLRepository/FlightRepository.h"
 #include "../repositories/MySQLRepository/AircraftRepository.h"
+#include "RequestContext.h"
+#include "TypeAheadIndex.h"
 #include "../core/exceptions/Result.h"
 #include "../utils/Logger.h"
 #include <memory>
@@ -321,6 +323,7 @@ private:
     std::shared_ptr<AircraftRepository> _aircraftRepository;    ///< Repository để truy cập dữ liệu máy bay
     std::shared_ptr<Logger> _logger;                            ///< Logger để ghi log hệ thống
     std::unique_ptr<ITicketSearchStrategyFactory> _searchFactory; ///< Factory để tạo chiến lược tìm kiếm
+    std::shared_ptr<TypeAheadIndex> _searchIndex;               ///< Chỉ mục tìm kiếm; null thì dùng chỉ mục dùng chung
 
     /**
      * @brief Lấy thông tin vé theo ID
@@ -343,6 +346,31 @@ private:
      */
     Result<bool> deleteById(const int& id);
 
+    /**
+     * @brief So sánh thời gian khởi hành với thời điểm hiện tại
+     * @param departureTime Thời gian khởi hành của chuyến bay
+     * @return true nếu thời gian khởi hành đã qua
+     */
+    static bool hasDeparted(const std::tm& departureTime);
+
+    /**
+     * @brief Kiểm tra có thể đặt vé, dùng lại các lần đọc đã ghi nhớ trong thao tác
+     * @param context Bộ nhớ đệm của thao tác hiện tại
+     * @param passport Số hộ chiếu hành khách
+     * @param flightNumber Số hiệu chuyến bay
+     * @return Result<bool> true nếu có thể đặt, false nếu không thể
+     */
+    Result<bool> canBookFlight(RequestContext& context, const PassportNumber& passport, const FlightNumber& flightNumber);
+
+    /**
+     * @brief Chọn ghế còn trống cho một nhóm, ưu tiên một dãy ghế liền nhau
+     * @param flight Chuyến bay đã nạp bản đồ ghế
+     * @param classCode Mã hạng ghế
+     * @param count Số ghế cần chọn
+     * @return Các ghế đã chọn theo thứ tự số ghế; rỗng nếu không đủ ghế trống
+     */
+    static std::vector<SeatNumber> pickGroupSeats(const Flight& flight, char classCode, size_t count);
+
 public:
     /**
      * @brief Constructor khởi tạo TicketService với các dependency
@@ -378,6 +406,45 @@ public:
      */
     Result<std::vector<Ticket>> getAllTickets();
     
+    /**
+     * @brief Nạp danh sách vé dạng phẳng cho màn hình danh sách
+     * @param rows Vector đích, được tái sử dụng giữa các lần làm mới
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getTicketListRows(std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Đếm tổng số vé (số hàng của danh sách ảo)
+     * @return Result<size_t> Số vé hoặc lỗi
+     */
+    Result<size_t> countTickets();
+
+    /**
+     * @brief Nạp một trang vé dạng phẳng cho danh sách ảo, theo thứ tự id
+     * @param offset Chỉ số hàng đầu tiên của trang
+     * @param limit Số hàng tối đa của trang
+     * @param rows Vector đích
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     */
+    Result<size_t> getTicketListPage(size_t offset, size_t limit, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Tìm khi đang gõ: vé có số vé bắt đầu bằng text, theo thứ tự số vé
+     * @param text Văn bản đã gõ, không phân biệt hoa thường
+     * @param limit Số hàng tối đa
+     * @param rows Vector đích
+     * @return Result<size_t> Số hàng đã nạp hoặc lỗi
+     * @note Tra trên TypeAheadIndex; lần gọi đầu tiên nạp chỉ mục từ cả bảng vé
+     */
+    Result<size_t> suggestTickets(const std::string& text, size_t limit, std::vector<TicketListRow>& rows);
+
+    /**
+     * @brief Dùng chỉ mục tìm kiếm riêng thay cho TypeAheadIndex::getInstance()
+     * @param index Chỉ mục; nullptr để quay về chỉ mục dùng chung
+     * @note Dùng trong test để mỗi cơ sở dữ liệu có chỉ mục của nó
+     */
+    void useSearchIndex(std::shared_ptr<TypeAheadIndex> index) { _searchIndex = std::move(index); }
+    
     /**
      * @brief Kiểm tra vé có tồn tại theo số vé
      * @param ticketNumber Số vé
@@ -407,7 +474,7 @@ public:
     Result<bool> deleteTicket(const TicketNumber& ticketNumber);
 
     // =============================================================================
-    // BOOKING OPERATIONS (2 methods) - Interface Segregation
+    // BOOKING OPERATIONS (3 methods) - Interface Segregation
     // =============================================================================
     /**
      * @brief Đặt vé cho hành khách
@@ -421,6 +488,37 @@ public:
                              const FlightNumber& flightNumber, 
                              const std::string& seatClass,
                              const Price& price);
+
+    /**
+     * @brief Đặt vé, dùng các lần đọc đã có sẵn trong context thay vì đọc lại
+     * @param context Bộ nhớ đệm của thao tác, có thể đã preload hành khách và chuyến bay
+     * @param passport Số hộ chiếu hành khách
+     * @param flightNumber Số hiệu chuyến bay
+     * @param seatClass Hạng ghế
+     * @param price Giá vé
+     * @return Result<Ticket> Vé đã được đặt hoặc lỗi
+     */
+    Result<Ticket> bookTicket(RequestContext& context,
+                             const PassportNumber& passport,
+                             const FlightNumber& flightNumber,
+                             const std::string& seatClass,
+                             const Price& price);
+
+    /**
+     * @brief Đặt vé cho một nhóm hành khách trên cùng một chuyến bay
+     * @param passports Số hộ chiếu của các hành khách trong nhóm (không trùng lặp)
+     * @param flightNumber Số hiệu chuyến bay
+     * @param seatClassCode Mã hạng ghế (ví dụ: "E", "B", "F")
+     * @param price Giá vé cho mỗi hành khách
+     * @return Result<std::vector<Ticket>> Các vé đã đặt theo thứ tự của passports, hoặc lỗi
+     * @note Số lượt truy vấn không phụ thuộc kích thước nhóm: hành khách được kiểm tra bằng một
+     *       truy vấn, ghế liền kề được ưu tiên chọn từ bản đồ ghế của chuyến bay, còn việc giữ ghế
+     *       và chèn vé diễn ra trong một transaction. Nhóm thất bại thì không vé nào được tạo.
+     */
+    Result<std::vector<Ticket>> bookGroup(const std::vector<PassportNumber>& passports,
+                                          const FlightNumber& flightNumber,
+                                          const std::string& seatClassCode,
+                                          const Price& price);
     
     /**
      * @brief Hủy vé
@@ -440,6 +538,15 @@ public:
      * @return Result<bool> true nếu cập nhật thành công, false nếu thất bại
      */
     Result<bool> updateTicketStatus(const TicketNumber& ticketNumber, TicketStatus status);
+
+    /**
+     * @brief Cập nhật trạng thái vé chỉ khi trạng thái hiện tại vẫn là expectedStatus
+     * @param ticketNumber Số vé
+     * @param status Trạng thái mới
+     * @param expectedStatus Trạng thái mà người gọi đã thấy
+     * @return Result<bool> true nếu đã cập nhật, false nếu bỏ qua vì phiên khác đã đổi trạng thái
+     */
+    Result<bool> updateTicketStatus(const TicketNumber& ticketNumber, TicketStatus status, TicketStatus expectedStatus);
     
     /**
      * @brief Check-in vé
@@ -0,0 +1,167 @@
+#include "TypeAheadIndex.h"
+#include <algorithm>
+
+std::shared_ptr<TypeAheadIndex> TypeAheadIndex::_instance;
+std::mutex TypeAheadIndex::_instanceMutex;
+
+TypeAheadIndex::TypeAheadIndex(std::shared_ptr<Changes::Feed> feed, size_t batchSize)
+    : _batchSize(std::max<size_t>(batchSize, 1)) {
+    if (feed) {
+        _subscription = feed->subscribe([this](const Changes::Event& event) { onChange(event); });
+    }
+}
+
+std::shared_ptr<TypeAheadIndex> TypeAheadIndex::getInstance() {
+    std::lock_guard<std::mutex> lock(_instanceMutex);
+    if (!_instance) {
+        _instance = std::make_shared<TypeAheadIndex>();
+    }
+    return _instance;
+}
+
+TypeAheadIndex::Section* TypeAheadIndex::sectionOf(Changes::Entity entity) {
+    switch (entity) {
+        case Changes::Entity::PASSENGER: return &_passengers;
+        case Changes::Entity::TICKET:    return &_tickets;
+        case Changes::Entity::FLIGHT:    return &_flights;
+        default:                         return nullptr;
+    }
+}
+
+void TypeAheadIndex::onChange(const Changes::Event& event) {
+    // Chạy bên trong lệnh ghi của repository: chỉ ghi lại id, việc nạp lại để lần tìm sau làm
+    Section* section = sectionOf(event.entity);
+    if (!section || !section->tracking.load()) return;
+    std::lock_guard<std::mutex> lock(section->pendingMutex);
+    section->pending.insert(event.id);
+}
+
+template <typename Row, typename LoadAfter, typename LoadByIds, typename KeyOf>
+Result<size_t> TypeAheadIndex::prepare(Section& section, const std::vector<PrefixIndex*>& fields,
+                                       LoadAfter loadAfter, LoadByIds loadByIds, KeyOf keyOf) {
+    std::lock_guard<std::mutex> loading(section.loadMutex);
+    std::vector<Row> rows;
+
+    if (!section.loaded) {
+        // Bắt đầu ghi lại thay đổi trước khi đọc trang đầu: hàng đổi trong lúc đọc sẽ được nạp lại ở dưới
+        section.tracking = true;
+        {
+            std::lock_guard<std::mutex> lock(section.pendingMutex);
+            section.pending.clear();
+        }
+
+        // Dựng ngoài khóa để lần tìm trên nhóm khác không phải chờ
+        std::vector<PrefixIndex> built;
+        built.reserve(fields.size());
+        for (const PrefixIndex* field : fields) {
+            built.push_back(*field);
+            built.back().clear();
+        }
+
+        int afterId = 0;
+        do {
+            auto page = loadAfter(afterId, _batchSize, rows);
+            if (!page) return Failure<size_t>(page.error());
+            for (const auto& row : rows) {
+                for (size_t i = 0; i < built.size(); ++i) built[i].append(row.id, keyOf(row, i));
+            }
+            if (!rows.empty()) afterId = rows.back().id;
+        } while (rows.size() == _batchSize);
+
+        for (auto& index : built) index.seal();
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            for (size_t i = 0; i < fields.size(); ++i) *fields[i] = std::move(built[i]);
+        }
+        section.loaded = true;
+    }
+
+    std::vector<int> changed;
+    {
+        std::lock_guard<std::mutex> lock(section.pendingMutex);
+        changed.assign(section.pending.begin(), section.pending.end());
+        section.pending.clear();
+    }
+    std::sort(changed.begin(), changed.end());
+
+    for (size_t first = 0; first < changed.size(); first += SYNC_CHUNK) {
+        std::vector<int> ids(changed.begin() + first, changed.begin() + std::min(changed.size(), first + SYNC_CHUNK));
+        auto loaded = loadByIds(ids, rows);
+        if (!loaded) {
+            // Giữ lại các thay đổi chưa áp dụng cho lần sau
+            std::lock_guard<std::mutex> lock(section.pendingMutex);
+            section.pending.insert(changed.begin() + first, changed.end());
+            return Failure<size_t>(loaded.error());
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        std::unordered_set<int> present;
+        for (const auto& row : rows) {
+            present.insert(row.id);
+            for (size_t i = 0; i < fields.size(); ++i) fields[i]->set(row.id, keyOf(row, i));
+        }
+        // Hàng không còn trong bảng là hàng đã bị xóa
+        for (int id : ids) {
+            if (present.contains(id)) continue;
+            for (PrefixIndex* field : fields) field->remove(id);
+        }
+    }
+    return Success(changed.size());
+}
+
+Result<size_t> TypeAheadIndex::preparePassengers(PassengerRepository& repository) {
+    return prepare<PassengerListRow>(
+        _passengers, {&_passengerNames, &_passports},
+        [&repository](int afterId, size_t limit, std::vector<PassengerListRow>& rows) {
+            return repository.findListRowsAfter(afterId, limit, rows);
+        },
+        [&repository](const std::vector<int>& ids, std::vector<PassengerListRow>& rows) {
+            return repository.findListRowsByIds(ids, rows);
+        },
+        [](const PassengerListRow& row, size_t field) -> std::string_view {
+            return field == 0 ? row.name : row.passportNumber;
+        });
+}
+
+Result<size_t> TypeAheadIndex::prepareTickets(TicketRepository& repository) {
+    return prepare<TicketListRow>(
+        _tickets, {&_ticketNumbers},
+        [&repository](int afterId, size_t limit, std::vector<TicketListRow>& rows) {
+            return repository.findListRowsAfter(afterId, limit, rows);
+        },
+        [&repository](const std::vector<int>& ids, std::vector<TicketListRow>& rows) {
+            return repository.findListRowsByIds(ids, rows);
+        },
+        [](const TicketListRow& row, size_t) -> std::string_view { return row.ticketNumber; });
+}
+
+Result<size_t> TypeAheadIndex::prepareFlights(FlightRepository& repository) {
+    return prepare<FlightSummaryRow>(
+        _flights, {&_flightNumbers},
+        [&repository](int afterId, size_t limit, std::vector<FlightSummaryRow>& rows) {
+            return repository.findSummariesAfter(afterId, limit, rows);
+        },
+        [&repository](const std::vector<int>& ids, std::vector<FlightSummaryRow>& rows) {
+            return repository.findSummariesByIds(ids, rows);
+        },
+        [](const FlightSummaryRow& row, size_t) -> std::string_view { return row.flightNumber; });
+}
+
+size_t TypeAheadIndex::find(SearchField field, std::string_view text, size_t limit, std::vector<int>& ids) const {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    switch (field) {
+        case SearchField::PASSENGER_NAME:  return _passengerNames.find(text, limit, ids);
+        case SearchField::PASSPORT_NUMBER: return _passports.find(text, limit, ids);
+        case SearchField::TICKET_NUMBER:   return _ticketNumbers.find(text, limit, ids);
+        case SearchField::FLIGHT_NUMBER:   return _flightNumbers.find(text, limit, ids);
+    }
+    return 0;
+}
+
+size_t TypeAheadIndex::pendingChanges(SearchField field) {
+    Section& section = field == SearchField::TICKET_NUMBER ? _tickets
+                     : field == SearchField::FLIGHT_NUMBER ? _flights
+                     : _passengers;
+    std::lock_guard<std::mutex> lock(section.pendingMutex);
+    return section.pending.size();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file TypeAheadIndex.h
+ * @brief Chỉ mục tiền tố dùng chung cho tìm kiếm khi đang gõ trên tên, hộ chiếu, số vé và số hiệu chuyến bay
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Tìm hành khách theo ID từng phải nạp cả bảng hành khách rồi quét trên máy khách; tìm vé và
+ * hộ chiếu thì phải gõ đúng toàn bộ giá trị. TypeAheadIndex giữ các khóa tìm kiếm trong bộ nhớ
+ * (PrefixIndex) nên mỗi lần gõ chỉ là một lần tìm nhị phân, không chạm cơ sở dữ liệu.
+ *
+ * Mỗi nhóm thực thể (hành khách, vé, chuyến bay) được nạp một lần khi lần đầu được tìm, đi qua
+ * bảng theo khóa id. Sau đó chỉ mục được giữ khớp với bảng nhờ Changes::Feed: handler chỉ ghi lại
+ * id bị thay đổi, và lần tìm kế tiếp nạp lại đúng các hàng đó bằng một truy vấn IN trên kết nối
+ * của lần tìm (handler chạy bên trong lệnh ghi của repository nên không được truy vấn).
+ *
+ * Dùng chung cho mọi ApplicationContext trong tiến trình, giống Changes::Feed.
+ */
+
+#ifndef TYPE_AHEAD_INDEX_H
+#define TYPE_AHEAD_INDEX_H
+
+#include "../repositories/MySQLRepository/FlightRepository.h"
+#include "../repositories/MySQLRepository/PassengerRepository.h"
+#include "../repositories/MySQLRepository/TicketRepository.h"
+#include "../utils/ChangeFeed.h"
+#include "../utils/PrefixIndex.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Trường có thể tìm theo tiền tố
+ */
+enum class SearchField {
+    PASSENGER_NAME,     ///< Họ tên hành khách, khớp cả tiền tố của từng từ
+    PASSPORT_NUMBER,    ///< Số hộ chiếu
+    TICKET_NUMBER,      ///< Số vé
+    FLIGHT_NUMBER       ///< Số hiệu chuyến bay
+};
+
+class TypeAheadIndex {
+private:
+    /// Trạng thái nạp của một nhóm thực thể
+    struct Section {
+        std::mutex loadMutex;                   ///< Chỉ một luồng nạp hoặc đồng bộ nhóm này tại một thời điểm
+        std::atomic<bool> tracking{false};      ///< Đã bắt đầu nạp: từ đây mọi thay đổi phải được ghi lại
+        bool loaded = false;                    ///< Đã nạp xong; chỉ đọc/ghi khi giữ loadMutex
+        std::mutex pendingMutex;
+        std::unordered_set<int> pending;        ///< Id đã thay đổi chưa được áp dụng
+    };
+
+    static std::shared_ptr<TypeAheadIndex> _instance;
+    static std::mutex _instanceMutex;
+
+    mutable std::shared_mutex _mutex;           ///< Bảo vệ các PrefixIndex: tìm giữ chung, áp dụng thay đổi giữ riêng
+    PrefixIndex _passengerNames{true};
+    PrefixIndex _passports;
+    PrefixIndex _ticketNumbers;
+    PrefixIndex _flightNumbers;
+
+    Section _passengers;
+    Section _tickets;
+    Section _flights;
+    size_t _batchSize;
+    Changes::Subscription _subscription;        ///< Khai báo cuối để bị hủy trước các chỉ mục
+
+    Section* sectionOf(Changes::Entity entity);
+    void onChange(const Changes::Event& event);
+
+    /**
+     * @brief Nạp nhóm nếu chưa nạp, rồi áp dụng các thay đổi đang chờ
+     * @param loadAfter (afterId, limit, rows) -> Result<size_t>, nạp trang tiếp theo theo khóa
+     * @param loadByIds (ids, rows) -> Result<size_t>, nạp các hàng theo id
+     * @param keyOf (row, i) -> string_view, văn bản của hàng cho chỉ mục thứ i trong fields
+     * @param fields Các chỉ mục của nhóm
+     */
+    template <typename Row, typename LoadAfter, typename LoadByIds, typename KeyOf>
+    Result<size_t> prepare(Section& section, const std::vector<PrefixIndex*>& fields,
+                           LoadAfter loadAfter, LoadByIds loadByIds, KeyOf keyOf);
+
+public:
+    /// Số hàng của mỗi truy vấn khi nạp một nhóm
+    static constexpr size_t DEFAULT_BATCH_SIZE = 50000;
+    /// Số id tối đa của một truy vấn IN khi áp dụng thay đổi
+    static constexpr size_t SYNC_CHUNK = 500;
+
+    /**
+     * @param feed Nguồn sự kiện thay đổi; null để không theo dõi thay đổi (chỉ dùng trong test)
+     * @param batchSize Số hàng mỗi truy vấn khi nạp
+     */
+    explicit TypeAheadIndex(std::shared_ptr<Changes::Feed> feed = Changes::Feed::getInstance(),
+                            size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    TypeAheadIndex(const TypeAheadIndex&) = delete;
+    TypeAheadIndex& operator=(const TypeAheadIndex&) = delete;
+
+    static std::shared_ptr<TypeAheadIndex> getInstance();
+
+    /**
+     * @brief Đảm bảo chỉ mục tên và hộ chiếu đã nạp và khớp với bảng hành khách
+     * @return Số thay đổi vừa áp dụng, hoặc lỗi truy vấn (chỉ mục giữ nguyên, thay đổi vẫn đang chờ)
+     * @note Lần đầu đi qua cả bảng nên có thể lâu; gọi trên worker
+     */
+    Result<size_t> preparePassengers(PassengerRepository& repository);
+
+    /// Như preparePassengers, cho số vé
+    Result<size_t> prepareTickets(TicketRepository& repository);
+
+    /// Như preparePassengers, cho số hiệu chuyến bay
+    Result<size_t> prepareFlights(FlightRepository& repository);
+
+    /**
+     * @brief Tìm các id có trường bắt đầu bằng văn bản đã gõ, theo thứ tự khóa
+     * @param field Trường cần tìm; nhóm của nó phải đã được prepare
+     * @param text Văn bản đã gõ, so khớp không phân biệt hoa thường và dấu
+     * @param limit Số id tối đa của ids sau khi thêm
+     * @param ids Vector đích; id đã có không được thêm lại
+     * @return Số id đã thêm
+     */
+    size_t find(SearchField field, std::string_view text, size_t limit, std::vector<int>& ids) const;
+
+    /// Số thay đổi đang chờ áp dụng của nhóm chứa trường
+    size_t pendingChanges(SearchField field);
+};
+
+/**
+ * @brief Sắp các hàng nạp theo id (thứ tự id) về đúng thứ tự của kết quả tìm kiếm
+ * @param rows Hàng có trường id
+ * @param ids Thứ tự mong muốn; hàng có id không nằm trong ids bị bỏ
+ */
+template <typename Row>
+void orderByIds(std::vector<Row>& rows, const std::vector<int>& ids) {
+    std::unordered_map<int, size_t> position;
+    position.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) position.emplace(rows[i].id, i);
+
+    std::vector<Row> ordered;
+    ordered.reserve(rows.size());
+    for (int id : ids) {
+        auto it = position.find(id);
+        if (it != position.end()) ordered.push_back(std::move(rows[it->second]));
+    }
+    rows = std::move(ordered);
+}
+
+#endif // TYPE_AHEAD_INDEX_H
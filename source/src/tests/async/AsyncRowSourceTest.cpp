@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+#include "../../async/AsyncRowSource.h"
+#include "../../async/AsyncServices.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include <map>
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Async;
+using namespace std::chrono_literals;
+
+namespace {
+    /// Vòng lặp sự kiện giả: kết quả chỉ được áp dụng khi test gọi pump(), như CallAfter của wx
+    struct FakeUiLoop {
+        std::mutex mutex;
+        std::vector<std::function<void()>> posted;
+
+        AsyncRowSource<int>::Dispatcher dispatcher() {
+            return [this](std::function<void()> task) {
+                std::lock_guard<std::mutex> lock(mutex);
+                posted.push_back(std::move(task));
+            };
+        }
+
+        size_t pump() {
+            std::vector<std::function<void()>> tasks;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.swap(posted);
+            }
+            for (auto& task : tasks) task();
+            return tasks.size();
+        }
+    };
+
+    /// Nguồn điều khiển bằng tay: mỗi lời gọi trả về một Promise để test tự quyết định khi nào xong
+    struct ManualBackend {
+        std::optional<Promise<size_t>> count;
+        std::map<size_t, Promise<std::vector<int>>> pages;   ///< Theo offset
+        std::vector<size_t> requested;
+
+        AsyncRowSource<int>::CountLoader countLoader() {
+            return [this](const CallContext&) {
+                count.emplace();
+                return count->future();
+            };
+        }
+
+        AsyncRowSource<int>::PageLoader pageLoader() {
+            return [this](const CallContext&, size_t offset, size_t) {
+                requested.push_back(offset);
+                pages[offset] = Promise<std::vector<int>>();
+                return pages[offset].future();
+            };
+        }
+
+        void completePage(size_t offset, size_t rows) {
+            std::vector<int> values;
+            for (size_t i = 0; i < rows; ++i) values.push_back(static_cast<int>(offset + i));
+            pages.at(offset).set(Success(std::move(values)));
+        }
+    };
+}
+
+TEST(AsyncRowSourceTest, CountShowsRowsFirstAndPagesFillInAsTheyArrive) {
+    FakeUiLoop ui;
+    ManualBackend backend;
+    AsyncRowSource<int> source(backend.countLoader(), backend.pageLoader(), ui.dispatcher(), 10, 4, 2);
+
+    std::vector<std::pair<size_t, size_t>> ready;
+    std::vector<bool> loading;
+    source.setListener({
+        .rowsReady = [&](size_t first, size_t last) { ready.emplace_back(first, last); },
+        .loadingChanged = [&](bool value) { loading.push_back(value); },
+    });
+
+    source.refresh();
+    EXPECT_TRUE(source.loading());
+    EXPECT_EQ(source.size(), 0u);
+
+    // Kết quả về trên "worker" nhưng chỉ có hiệu lực khi vòng lặp giao diện chạy
+    backend.count->set(Success<size_t>(35));
+    EXPECT_EQ(source.size(), 0u);
+    ui.pump();
+    EXPECT_EQ(source.size(), 35u);
+    EXPECT_FALSE(source.loading());
+
+    // Cùng một trang được hỏi nhiều lần chỉ nạp một lần
+    EXPECT_EQ(source.row(0), nullptr);
+    EXPECT_EQ(source.row(5), nullptr);
+    EXPECT_EQ(source.row(12), nullptr);
+    EXPECT_EQ(backend.requested, (std::vector<size_t>{0, 10}));
+    EXPECT_EQ(source.pagesInFlight(), 2u);
+
+    backend.completePage(10, 10);
+    ui.pump();
+    ASSERT_NE(source.row(12), nullptr);
+    EXPECT_EQ(*source.row(12), 12);
+    EXPECT_EQ(source.row(0), nullptr);
+    EXPECT_EQ(ready, (std::vector<std::pair<size_t, size_t>>{{10, 19}}));
+
+    backend.completePage(0, 10);
+    ui.pump();
+    EXPECT_EQ(*source.row(0), 0);
+    EXPECT_FALSE(source.loading());
+    EXPECT_EQ(loading, (std::vector<bool>{true, false, true, false}));
+}
+
+TEST(AsyncRowSourceTest, InFlightLoadsAreBoundedAndNewestWaitingPageGoesFirst) {
+    FakeUiLoop ui;
+    ManualBackend backend;
+    AsyncRowSource<int> source(backend.countLoader(), backend.pageLoader(), ui.dispatcher(), 10, 3, 1);
+    source.refresh();
+    backend.count->set(Success<size_t>(1000));
+    ui.pump();
+
+    // Cuộn nhanh qua nhiều trang: một trang đang nạp, chỉ maxPages trang mới nhất còn chờ
+    for (size_t row = 0; row < 100; row += 10) source.row(row);
+    EXPECT_EQ(backend.requested, (std::vector<size_t>{0}));
+
+    backend.completePage(0, 10);
+    ui.pump();
+    EXPECT_EQ(backend.requested, (std::vector<size_t>{0, 90}));
+    backend.completePage(90, 10);
+    ui.pump();
+    backend.completePage(80, 10);
+    ui.pump();
+    backend.completePage(70, 10);
+    ui.pump();
+    EXPECT_EQ(backend.requested, (std::vector<size_t>{0, 90, 80, 70}));
+    EXPECT_FALSE(source.loading());
+
+    // Gợi ý vùng hiển thị xếp trang đầu vùng lên trước
+    source.prefetch(500, 525);
+    EXPECT_EQ(backend.requested.back(), 500u);
+    backend.completePage(500, 10);
+    ui.pump();
+    EXPECT_EQ(backend.requested.back(), 510u);
+}
+
+TEST(AsyncRowSourceTest, CancelDropsLateResultsAndStopsUntilRefresh) {
+    FakeUiLoop ui;
+    ManualBackend backend;
+    AsyncRowSource<int> source(backend.countLoader(), backend.pageLoader(), ui.dispatcher(), 10, 4, 2);
+    std::optional<CoreError> failure;
+    source.setListener({.failed = [&](const CoreError& error) { failure = error; }});
+
+    source.refresh();
+    backend.count->set(Success<size_t>(50));
+    ui.pump();
+    source.row(0);
+    source.cancel();
+    EXPECT_FALSE(source.loading());
+    EXPECT_TRUE(source.stopped());
+
+    // Trang của lượt đã hủy về muộn thì bị bỏ, và không trang nào được nạp thêm
+    backend.completePage(0, 10);
+    ui.pump();
+    EXPECT_EQ(source.row(0), nullptr);
+    EXPECT_EQ(source.row(20), nullptr);
+    EXPECT_EQ(backend.requested.size(), 1u);
+
+    // Lượt mới: lỗi dừng việc nạp đến lần refresh() sau
+    source.refresh();
+    backend.count->set(Success<size_t>(50));
+    ui.pump();
+    backend.requested.clear();
+    source.row(30);
+    backend.pages.at(30).set(Failure<std::vector<int>>(CoreError("connection lost", "QUERY_FAILED")));
+    ui.pump();
+    ASSERT_TRUE(failure.has_value());
+    EXPECT_EQ(failure->code, "QUERY_FAILED");
+    source.row(40);
+    EXPECT_EQ(backend.requested, (std::vector<size_t>{30}));
+
+    // Hủy đối tượng trong khi còn kết quả trên đường về: kết quả bị bỏ, không chạm đối tượng đã hủy
+    auto late = std::make_unique<AsyncRowSource<int>>(backend.countLoader(), backend.pageLoader(), ui.dispatcher());
+    late->refresh();
+    late.reset();
+    backend.count->set(Success<size_t>(5));
+    EXPECT_EQ(ui.pump(), 1u);
+}
+
+TEST(AsyncRowSourceTest, ChangesReloadOneRowOrShiftTheCountInPlace) {
+    struct IdRow {
+        int id = 0;
+        std::string value;
+    };
+    FakeUiLoop ui;
+    std::vector<IdRow> table;
+    for (int i = 1; i <= 30; ++i) table.push_back({i, "v" + std::to_string(i)});
+    size_t counts = 0;
+    std::vector<std::pair<size_t, size_t>> requested;   ///< (offset, limit)
+    AsyncRowSource<IdRow> source(
+        [&](const CallContext&) {
+            ++counts;
+            return makeReadyFuture(Result<size_t>(table.size()));
+        },
+        [&](const CallContext&, size_t offset, size_t limit) {
+            requested.emplace_back(offset, limit);
+            std::vector<IdRow> rows;
+            for (size_t i = offset; i < table.size() && i < offset + limit; ++i) rows.push_back(table[i]);
+            return makeReadyFuture(Result<std::vector<IdRow>>(std::move(rows)));
+        },
+        ui.dispatcher(), 10, 4, 2);
+    std::vector<std::pair<size_t, size_t>> ready;
+    std::vector<std::pair<size_t, size_t>> resized;
+    source.setListener({
+        .rowsReady = [&](size_t first, size_t last) { ready.emplace_back(first, last); },
+        .countChanged = [&](size_t count, size_t first) { resized.emplace_back(count, first); },
+    });
+
+    // Sự kiện tới trước khi có số hàng thì bị bỏ qua
+    source.apply(Changes::Kind::UPDATED, 5);
+    source.refresh();
+    ui.pump();
+    source.prefetch(0, 29);
+    while (ui.pump() > 0) {}
+    ASSERT_EQ(requested.size(), 3u);
+    requested.clear();
+    ready.clear();
+
+    // Sửa một hàng: chỉ hàng đó được nạp lại
+    table[14].value = "edited";
+    source.apply(Changes::Kind::UPDATED, 15);
+    EXPECT_TRUE(source.loading());
+    ui.pump();
+    EXPECT_EQ(requested, (std::vector<std::pair<size_t, size_t>>{{14, 1}}));
+    EXPECT_EQ(ready, (std::vector<std::pair<size_t, size_t>>{{14, 14}}));
+    EXPECT_EQ(source.row(14)->value, "edited");
+    EXPECT_FALSE(source.loading());
+    requested.clear();
+
+    // Xóa: số hàng giảm, chỉ các trang từ vị trí của hàng bị xóa được nạp lại khi vẽ
+    table.erase(table.begin() + 24);
+    source.apply(Changes::Kind::DELETED, 25);
+    EXPECT_EQ(resized, (std::vector<std::pair<size_t, size_t>>{{29, 24}}));
+    EXPECT_EQ(source.size(), 29u);
+    EXPECT_NE(source.row(0), nullptr);
+    EXPECT_EQ(source.row(24), nullptr);
+    ui.pump();
+    EXPECT_EQ(source.row(24)->id, 26);
+    EXPECT_EQ(requested, (std::vector<std::pair<size_t, size_t>>{{20, 10}}));
+
+    // Thêm: hàng mới ở cuối
+    table.push_back({31, "new"});
+    source.apply(Changes::Kind::CREATED, 31);
+    EXPECT_EQ(resized.back(), (std::pair<size_t, size_t>{30, 29}));
+    source.row(29);
+    ui.pump();
+    EXPECT_EQ(source.row(29)->id, 31);
+    EXPECT_EQ(counts, 1u);
+
+    // Lượt đếm đang chạy có thể đã bỏ lỡ thay đổi: thêm hoặc xóa lúc đó thì đếm lại
+    source.refresh();
+    source.apply(Changes::Kind::CREATED, 32);
+    EXPECT_EQ(counts, 3u);
+    ui.pump();
+    EXPECT_EQ(source.size(), 30u);
+}
+
+TEST(AsyncRowSourceTest, CallServiceRunsOnPoolOrFallsBackToTheLocalService) {
+    auto db = std::make_shared<InMemoryConnection>();
+    ApplicationContext context(db, nullptr);
+    std::istringstream passengers("name,passport,email,phone,address\n"
+                                  "Nguyen Van A,VN:123456789,a@example.com,0901234567,Ha Noi\n");
+    ASSERT_RESULT(Cli::importTable(context, "passengers", passengers));
+
+    auto count = [](PassengerService& service) { return service.countPassengers(); };
+
+    // Không có pool: chạy ngay trên service đồng bộ
+    auto local = callService<PassengerService>(nullptr, context.passengerService(), &ApplicationContext::passengerService,
+                                               CallContext{}, count);
+    ASSERT_TRUE(local.isReady());
+    EXPECT_EQ(local.get().value(), 1u);
+
+    CancellationSource cancelled;
+    cancelled.cancel();
+    auto skipped = callService<PassengerService>(nullptr, context.passengerService(), &ApplicationContext::passengerService,
+                                                 CallContext::create(1s, cancelled.token()), count);
+    EXPECT_EQ(skipped.get().error().code, "CANCELLED");
+
+    // Có pool: chạy trên worker với service của kết nối mượn
+    auto pool = ConnectionPool::create([db]() -> Result<std::shared_ptr<IDatabaseConnection>> {
+        return Success(std::shared_ptr<IDatabaseConnection>(db));
+    }, 1);
+    ASSERT_RESULT(pool);
+    AsyncServices services(pool.value(), nullptr, 2);
+    auto pooled = callService<PassengerService>(&services, context.passengerService(), &ApplicationContext::passengerService,
+                                                CallContext::create(5s), count);
+    auto result = pooled.get();
+    ASSERT_RESULT(result);
+    EXPECT_EQ(result.value(), 1u);
+}
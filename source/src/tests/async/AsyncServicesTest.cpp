@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "../../async/AsyncServices.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../utils/Tracing.h"
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Async;
+using namespace std::chrono_literals;
+
+TEST(ExecutorTest, RunsTasksOnSeveralWorkersAndDrainsOnDestruction) {
+    std::atomic<int> done{0};
+    std::mutex idsMutex;
+    std::set<std::thread::id> ids;
+    {
+        Executor executor(4);
+        EXPECT_EQ(executor.threadCount(), 4u);
+        for (int i = 0; i < 200; ++i) {
+            executor.submit([&] {
+                std::this_thread::sleep_for(100us);
+                {
+                    std::lock_guard<std::mutex> lock(idsMutex);
+                    ids.insert(std::this_thread::get_id());
+                }
+                ++done;
+            });
+        }
+    }
+    EXPECT_EQ(done.load(), 200);
+    EXPECT_GT(ids.size(), 1u);
+}
+
+TEST(ExecutorTest, WorkerWaitingOnChildFutureHelpsInsteadOfDeadlocking) {
+    // Một worker duy nhất: tác vụ cha chờ tác vụ con nằm trong chính hàng đợi của nó
+    Executor executor(1);
+    auto parent = spawn(executor, CallContext{}, [&executor]() -> Result<int> {
+        auto child = spawn(executor, CallContext{}, []() -> Result<int> { return Success(20); });
+        auto value = child.get();
+        if (!value) return Failure<int>(value.error());
+        return Success(value.value() + 1);
+    });
+    auto result = parent.get();
+    ASSERT_RESULT(result);
+    EXPECT_EQ(result.value(), 21);
+    EXPECT_EQ(Executor::current(), nullptr);
+}
+
+TEST(ExecutorTest, SpansInSubmittedTasksNestUnderTheSubmittingSpan) {
+    auto tracer = Tracing::Tracer::getInstance();
+    tracer->enable();
+    Executor executor(2);
+    uint64_t refreshId = 0;
+    Future<uint64_t> child;
+    {
+        // Span của luồng giao diện kết thúc ngay sau khi xếp việc, trước khi worker chạy
+        Tracing::Span refresh("refresh", "test");
+        refreshId = refresh.id();
+        child = spawn(executor, CallContext{}, []() -> Result<uint64_t> {
+            Tracing::Span query("query", "test");
+            return Success(query.parentId());
+        });
+    }
+    auto parentOfQuery = child.get();
+    ASSERT_RESULT(parentOfQuery);
+    EXPECT_EQ(parentOfQuery.value(), refreshId);
+
+    // Worker trả lại span hiện tại sau tác vụ; tác vụ gửi ngoài span không nhận cha cũ
+    auto orphan = spawn(executor, CallContext{}, []() -> Result<uint64_t> { return Success(Tracing::currentSpan()); });
+    EXPECT_EQ(orphan.get().value(), 0u);
+    tracer->disable();
+    tracer->clear();
+}
+
+TEST(FutureTest, ThenAndWhenAllPropagateValuesAndFirstError) {
+    Executor executor(2);
+    auto doubled = spawn(executor, CallContext{}, []() -> Result<int> { return Success(21); })
+                       .then(executor, CallContext{}, [](int value) -> Result<std::string> { return Success(std::to_string(value * 2)); });
+    auto text = doubled.get();
+    ASSERT_RESULT(text);
+    EXPECT_EQ(text.value(), "42");
+
+    auto both = whenAll(makeReadyFuture(Result<int>(1)), spawn(executor, CallContext{}, []() -> Result<std::string> { return Success(std::string("b")); }));
+    auto pair = both.get();
+    ASSERT_RESULT(pair);
+    EXPECT_EQ(pair.value().first, 1);
+    EXPECT_EQ(pair.value().second, "b");
+
+    // Lỗi đến trước kết thúc ngay, không chờ tác vụ còn lại
+    Promise<int> never;
+    auto failing = whenAll(never.future(), makeReadyFuture(Result<int>(Failure<int>(CoreError("boom", "BOOM")))));
+    ASSERT_TRUE(failing.waitFor(1s));
+    auto failed = failing.get();
+    ASSERT_FALSE(failed.has_value());
+    EXPECT_EQ(failed.error().code, "BOOM");
+    never.set(Success(1));
+
+    bool ran = false;
+    auto skipped = makeReadyFuture(Result<int>(Failure<int>(CoreError("first", "FIRST"))))
+                       .then(executor, CallContext{}, [&ran](int) -> Result<int> { ran = true; return Success(0); });
+    EXPECT_EQ(skipped.get().error().code, "FIRST");
+    EXPECT_FALSE(ran);
+
+    auto thrown = spawn(executor, CallContext{}, []() -> Result<int> { throw std::runtime_error("bad"); });
+    EXPECT_EQ(thrown.get().error().code, "TASK_FAILED");
+}
+
+TEST(CallContextTest, CancellationAndDeadlinesStopTasksBeforeTheyRun) {
+    Executor executor(1);
+    std::atomic<bool> ran{false};
+
+    CancellationSource source;
+    auto context = CallContext::create(10s, source.token());
+    source.cancel();
+    auto cancelled = spawn(executor, context, [&]() -> Result<int> { ran = true; return Success(1); });
+    EXPECT_EQ(cancelled.get().error().code, "CANCELLED");
+
+    auto expired = spawn(executor, CallContext::create(0ms), [&]() -> Result<int> { ran = true; return Success(1); });
+    EXPECT_EQ(expired.get().error().code, "DEADLINE_EXCEEDED");
+    EXPECT_FALSE(ran.load());
+
+    // Ngữ cảnh con chỉ rút ngắn được deadline của cha
+    auto parent = CallContext::create(50ms);
+    EXPECT_EQ(parent.withTimeout(10s).deadline, parent.deadline);
+    EXPECT_LT(parent.withTimeout(1ms).deadline, parent.deadline);
+    EXPECT_LE(parent.remaining(5000ms), 50ms);
+    EXPECT_EQ(CallContext{}.remaining(5000ms), 5000ms);
+    EXPECT_TRUE(CallContext{}.check().has_value());
+
+    // Timeout quá lớn bão hòa thành "không giới hạn" thay vì tràn thành một deadline trong quá khứ
+    auto forever = CallContext::create(std::chrono::milliseconds::max());
+    EXPECT_FALSE(forever.hasDeadline());
+    EXPECT_TRUE(forever.check().has_value());
+    EXPECT_EQ(parent.withTimeout(std::chrono::milliseconds::max()).deadline, parent.deadline);
+}
+
+class AsyncServicesTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+    std::shared_ptr<ConnectionPool> pool;
+    std::unique_ptr<AsyncServices> services;
+
+    void SetUp() override {
+        db = std::make_shared<InMemoryConnection>();
+        ApplicationContext context(db, nullptr);
+        std::istringstream aircraft("serial,model,seat_layout\nVN100,Airbus A321,\"E:150,B:20\"\n");
+        std::istringstream passengers("name,passport,email,phone,address\n"
+                                      "Nguyen Van A,VN:123456789,a@example.com,0901234567,Ha Noi\n");
+        // TicketService::canBookFlight chỉ cho đặt khi hasDeparted() đúng, nên lịch bay nằm trong quá khứ
+        std::istringstream flights("flight_number,route,schedule,aircraft_serial,status\n"
+                                   "VN123,Ha Noi(HAN)-Ho Chi Minh(SGN),2020-01-10 08:00|2020-01-10 10:00,VN100,\n");
+        ASSERT_RESULT(Cli::importTable(context, "aircraft", aircraft));
+        ASSERT_RESULT(Cli::importTable(context, "passengers", passengers));
+        ASSERT_RESULT(Cli::importTable(context, "flights", flights));
+
+        // Database trong bộ nhớ không an toàn khi nhiều kết nối dùng chung: pool một session
+        auto created = ConnectionPool::create([this]() -> Result<std::shared_ptr<IDatabaseConnection>> {
+            return Success(std::shared_ptr<IDatabaseConnection>(db));
+        }, 1);
+        ASSERT_RESULT(created);
+        pool = created.value();
+        services = std::make_unique<AsyncServices>(pool, nullptr, 3);
+    }
+};
+
+TEST_F(AsyncServicesTest, ListsAndBookingRunOffTheCallingThread) {
+    auto context = CallContext::create(5s);
+    auto lists = whenAll(services->getFlightSummaries(context), services->getPassengerListRows(context)).get();
+    ASSERT_RESULT(lists);
+    ASSERT_EQ(lists.value().first.size(), 1u);
+    EXPECT_EQ(lists.value().first[0].flightNumber, "VN123");
+    EXPECT_EQ(lists.value().second.size(), 1u);
+
+    auto passport = PassportNumber::create("VN:123456789").value();
+    auto flightNumber = FlightNumber::create("VN123").value();
+    auto price = Price::create("1500000 VND").value();
+    auto ticket = services->bookTicket(context, passport, flightNumber, "E05", price).get();
+    ASSERT_RESULT(ticket) << ticket.error().message;
+    EXPECT_EQ(ticket.value().getSeatNumber().toString(), "E005");
+
+    // Số ghế đã đặt đến từ truy vấn gộp, không từ danh sách vé
+    auto occupancy = services->getFlightSummariesWithOccupancy(context).get();
+    ASSERT_RESULT(occupancy);
+    ASSERT_EQ(occupancy.value().size(), 1u);
+    EXPECT_EQ(occupancy.value()[0].bookedEconomy, 1);
+    EXPECT_EQ(occupancy.value()[0].bookedBusiness, 0);
+    EXPECT_EQ(occupancy.value()[0].availableSeats(), 169);
+
+    // Trang tóm tắt cho danh sách ảo mang cùng số ghế đã đặt
+    auto page = services->run(context, [](const ApplicationContext& services) -> Result<std::vector<FlightSummaryRow>> {
+        std::vector<FlightSummaryRow> rows;
+        auto loaded = services.flightService()->getFlightSummariesPage(0, 10, rows);
+        if (!loaded) return Failure<std::vector<FlightSummaryRow>>(loaded.error());
+        return Success(std::move(rows));
+    }).get();
+    ASSERT_RESULT(page);
+    ASSERT_EQ(page.value().size(), 1u);
+    EXPECT_EQ(page.value()[0].bookedEconomy, 1);
+
+    auto tickets = services->searchTicketsByPassenger(context, passport).get();
+    ASSERT_RESULT(tickets);
+    EXPECT_EQ(tickets.value().size(), 1u);
+
+    // Một trong hai tra cứu thất bại thì không bước đặt vé nào chạy
+    auto unknown = services->bookTicket(context, PassportNumber::create("VN:987654321").value(), flightNumber, "E06", price).get();
+    ASSERT_FALSE(unknown.has_value());
+    EXPECT_EQ(services->getTicketListRows(context).get().value().size(), 1u);
+
+    auto cancelled = services->cancelTicket(context, ticket.value().getTicketNumber(), "changed plans").get();
+    ASSERT_RESULT(cancelled);
+    EXPECT_TRUE(cancelled.value());
+}
+
+TEST_F(AsyncServicesTest, DeadlineBoundsTheWaitForAPooledConnection) {
+    auto held = pool->acquire();
+    ASSERT_RESULT(held);
+
+    auto start = std::chrono::steady_clock::now();
+    auto flight = services->getFlight(CallContext::create(50ms), FlightNumber::create("VN123").value()).get();
+    ASSERT_FALSE(flight.has_value());
+    EXPECT_EQ(flight.error().code, "DEADLINE_EXCEEDED");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+
+    CancellationSource source;
+    auto pending = services->run(CallContext::create(5s, source.token()), [](const ApplicationContext& context) {
+        return context.flightService()->getFlight(FlightNumber::create("VN123").value());
+    });
+    source.cancel();
+    held = Failure<ConnectionPool::Lease>(CoreError("released"));
+    EXPECT_EQ(pending.get().error().code, "CANCELLED");
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include "../../cli/BatchJobs.h"
+#include "../../cli/CliApplication.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../loadgen/DataGenerator.h"
+#include "../../utils/ChangeFeed.h"
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Cli;
+
+class BatchJobsTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+    std::unique_ptr<ApplicationContext> context;
+
+    void SetUp() override {
+        db = std::make_shared<InMemoryConnection>();
+        context = std::make_unique<ApplicationContext>(db, nullptr);
+    }
+
+    static std::string exportText(const ApplicationContext& source, const std::string& table) {
+        std::ostringstream out;
+        auto written = exportTable(source, table, out);
+        return written ? out.str() : "";
+    }
+
+    void importFleet() {
+        std::istringstream aircraft(
+            "serial,model,seat_layout\n"
+            "VN100,Airbus A321,\"ECONOMY:150,BUSINESS:20\"\n"
+            "VN200,Boeing 787,\"ECONOMY:200,BUSINESS:30,FIRST:8\"\n");
+        auto report = importTable(*context, "aircraft", aircraft);
+        ASSERT_RESULT(report);
+        ASSERT_EQ(report.value().imported, 2u);
+    }
+};
+
+TEST_F(BatchJobsTest, CsvFieldsRoundTrip) {
+    EXPECT_EQ(csvField("plain"), "plain");
+    EXPECT_EQ(csvField("a,b"), "\"a,b\"");
+    EXPECT_EQ(csvField("say \"hi\""), "\"say \"\"hi\"\"\"");
+
+    auto fields = parseCsvLine("a,\"b,c\",\"say \"\"hi\"\"\",");
+    ASSERT_RESULT(fields);
+    EXPECT_EQ(fields.value(), (std::vector<std::string>{"a", "b,c", "say \"hi\"", ""}));
+    EXPECT_FALSE(parseCsvLine("a,\"open").has_value());
+}
+
+TEST_F(BatchJobsTest, ImportReportsRowErrorsAndExportRoundTrips) {
+    importFleet();
+
+    // Cột theo thứ tự khác tiêu đề chuẩn; dòng 3 sai hộ chiếu, dòng 4 trùng hộ chiếu
+    std::istringstream passengers(
+        "name,passport,email,phone,address\n"
+        "Nguyen Van A,VN:123456789,a@example.com,0901234567,\"12 Le Loi, Q1\"\n"
+        "Tran Thi B,not-a-passport,b@example.com,0907654321,Ha Noi\n"
+        "Nguyen Van A,VN:123456789,a@example.com,0901234567,Hue\n");
+    auto passengerReport = importTable(*context, "passengers", passengers);
+    ASSERT_RESULT(passengerReport);
+    EXPECT_EQ(passengerReport.value().imported, 1u);
+    ASSERT_EQ(passengerReport.value().errors.size(), 2u);
+    EXPECT_EQ(passengerReport.value().errors[0].line, 3u);
+    EXPECT_EQ(passengerReport.value().errors[1].line, 4u);
+
+    std::istringstream flights(
+        "flight_number,route,schedule,aircraft_serial,status\n"
+        "VN123,Ha Noi(HAN)-Ho Chi Minh(SGN),2030-01-10 08:00|2030-01-10 10:00,VN100,\n"
+        "VN456,Ho Chi Minh(SGN)-Da Nang(DAD),2030-01-11 09:00|2030-01-11 10:15,VN200,DELAYED\n"
+        "VN789,Ha Noi(HAN)-Da Nang(DAD),2030-01-12 09:00|2030-01-12 10:15,XX999,\n");
+    auto flightReport = importTable(*context, "flights", flights);
+    ASSERT_RESULT(flightReport);
+    EXPECT_EQ(flightReport.value().imported, 2u);
+    ASSERT_EQ(flightReport.value().errors.size(), 1u);
+    EXPECT_EQ(flightReport.value().errors[0].line, 4u);
+
+    std::istringstream missingColumn("flight_number,route\nVN1,x\n");
+    auto rejected = importTable(*context, "flights", missingColumn);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, "INVALID_CSV_HEADER");
+
+    // Xuất rồi nhập lại vào cơ sở dữ liệu trống phải cho cùng nội dung
+    ApplicationContext copy(std::make_shared<InMemoryConnection>(), nullptr);
+    for (const std::string table : {"aircraft", "passengers", "flights"}) {
+        std::string exported = exportText(*context, table);
+        ASSERT_FALSE(exported.empty()) << table;
+        std::istringstream in(exported);
+        auto report = importTable(copy, table, in);
+        ASSERT_RESULT(report);
+        EXPECT_TRUE(report.value().errors.empty()) << table << ": " << report.value().errors.front().message;
+        EXPECT_EQ(exportText(copy, table), exported) << table;
+    }
+    EXPECT_NE(exportText(*context, "flights").find("DELAYED"), std::string::npos);
+
+    std::ostringstream out;
+    EXPECT_FALSE(exportTable(*context, "crew", out).has_value());
+}
+
+TEST_F(BatchJobsTest, SweepAdvancesFlightsAndTickets) {
+    LoadGen::GeneratorConfig config;
+    config.aircraftCount = 4;
+    config.flightCount = 40;
+    config.passengerCount = 100;
+    config.ticketCount = 600;
+    config.startDate = "2024-01-01";
+    config.days = 5;
+    auto dataset = LoadGen::SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+    LoadGen::ConnectionSink sink(db);
+    ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+    auto before = buildOperationsReport(*context);
+    ASSERT_RESULT(before);
+    size_t checkedIn = before.value().ticketsByStatus[TicketStatus::CHECKED_IN];
+    size_t cancelledFlights = before.value().flightsByStatus[FlightStatus::CANCELLED];
+    ASSERT_GT(checkedIn, 0u);
+
+    std::tm later{};
+    later.tm_year = 2030 - 1900;
+    later.tm_mday = 1;
+    later.tm_isdst = -1;
+    std::time_t now = std::mktime(&later);
+
+    auto dryRun = sweepStatuses(*context, now, true);
+    ASSERT_RESULT(dryRun);
+    EXPECT_EQ(dryRun.value().ticketsCompleted, checkedIn);
+    EXPECT_EQ(exportText(*context, "tickets").find("COMPLETED"), std::string::npos);
+
+    auto sweep = sweepStatuses(*context, now, false);
+    ASSERT_RESULT(sweep);
+    EXPECT_TRUE(sweep.value().errors.empty());
+    EXPECT_EQ(sweep.value().flightsLanded + cancelledFlights, 40u);
+    EXPECT_EQ(sweep.value().ticketsCompleted, checkedIn);
+
+    auto after = buildOperationsReport(*context);
+    ASSERT_RESULT(after);
+    EXPECT_EQ(after.value().flightsByStatus[FlightStatus::LANDED], 40u - cancelledFlights);
+    EXPECT_EQ(after.value().ticketsByStatus[TicketStatus::COMPLETED], checkedIn);
+    EXPECT_EQ(after.value().ticketsByStatus.count(TicketStatus::CHECKED_IN), 0u);
+    EXPECT_GT(after.value().loadFactor(), 0.0);
+
+    // Lần quét thứ hai không còn gì để đổi
+    auto again = sweepStatuses(*context, now, false);
+    ASSERT_RESULT(again);
+    EXPECT_EQ(again.value().flightsLanded + again.value().ticketsCompleted, 0u);
+
+    std::ostringstream printed;
+    after.value().print(printed);
+    EXPECT_NE(printed.str().find("Load factor"), std::string::npos);
+}
+
+TEST_F(BatchJobsTest, SweepSkipsRowsChangedConcurrently) {
+    LoadGen::GeneratorConfig config;
+    config.aircraftCount = 4;
+    config.flightCount = 40;
+    config.passengerCount = 100;
+    config.ticketCount = 600;
+    config.startDate = "2024-01-01";
+    config.days = 5;
+    auto dataset = LoadGen::SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+    LoadGen::ConnectionSink sink(db);
+    ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+    std::tm later{};
+    later.tm_year = 2030 - 1900;
+    later.tm_mday = 1;
+    later.tm_isdst = -1;
+    std::time_t now = std::mktime(&later);
+
+    auto planned = sweepStatuses(*context, now, true);
+    ASSERT_RESULT(planned);
+    size_t flightsToUpdate = planned.value().flightsLanded + planned.value().flightsInFlight;
+    ASSERT_GT(flightsToUpdate, 1u);
+    auto before = buildOperationsReport(*context);
+    ASSERT_RESULT(before);
+
+    // Ngay sau lệnh ghi đầu tiên của lần quét, một phiên khác hủy mọi chuyến còn lại và
+    // hoàn tiền vé của chính chuyến vừa cập nhật; lần quét đang giữ ảnh chụp cũ của cả hai
+    bool fired = false;
+    int firstFlight = 0;
+    auto subscription = Changes::Feed::getInstance()->subscribe([&](const Changes::Event& event) {
+        if (fired || event.entity != Changes::Entity::FLIGHT) return;
+        fired = true;
+        firstFlight = event.id;
+        auto id = std::to_string(event.id);
+        db->execute("UPDATE flight SET status = 'CANCELLED', version = version + 1 "
+                    "WHERE id <> " + id + " AND status <> 'CANCELLED'");
+        db->execute("UPDATE ticket SET status = 'REFUNDED', version = version + 1 "
+                    "WHERE flight_id = " + id + " AND status IN ('PENDING', 'CHECKED_IN', 'BOARDED')");
+    });
+
+    auto sweep = sweepStatuses(*context, now, false);
+    subscription.reset();
+    ASSERT_RESULT(sweep);
+    ASSERT_TRUE(fired);
+    EXPECT_TRUE(sweep.value().errors.empty());
+    EXPECT_EQ(sweep.value().flightsLanded + sweep.value().flightsInFlight, 1u);
+    EXPECT_EQ(sweep.value().ticketsCompleted + sweep.value().ticketsExpired, 0u);
+    EXPECT_GE(sweep.value().skipped, flightsToUpdate - 1);
+
+    // Các chuyến bị hủy đồng thời không bị ghi đè thành LANDED, không vé nào bị hoàn tất
+    auto after = buildOperationsReport(*context);
+    ASSERT_RESULT(after);
+    EXPECT_EQ(after.value().flightsByStatus[FlightStatus::CANCELLED], 39u);
+    EXPECT_EQ(after.value().flightsByStatus[FlightStatus::LANDED] +
+              after.value().flightsByStatus[FlightStatus::IN_FLIGHT], 1u);
+    EXPECT_EQ(after.value().ticketsByStatus[TicketStatus::COMPLETED],
+              before.value().ticketsByStatus[TicketStatus::COMPLETED]);
+    EXPECT_GT(firstFlight, 0);
+}
+
+TEST_F(BatchJobsTest, CommandDispatchUsesExitCodes) {
+    importFleet();
+    auto connect = [this]() { return Success(std::shared_ptr<IDatabaseConnection>(db)); };
+
+    auto parse = [](std::vector<const char*> argv) {
+        argv.insert(argv.begin(), "airlines_cli");
+        return CommandLine::parse(static_cast<int>(argv.size()), argv.data()).value();
+    };
+
+    std::ostringstream out, err;
+    EXPECT_EQ(run(parse({"export", "aircraft"}), connect, nullptr, out, err), 0);
+    EXPECT_NE(out.str().find("VN200,Boeing 787"), std::string::npos);
+
+    EXPECT_EQ(run(parse({"report"}), connect, nullptr, out, err), 0);
+    EXPECT_EQ(run(parse({"report", "--from", "2024-01-01", "--to", "2024-12-31", "--threads", "2"}), connect, nullptr, out, err), 0);
+    EXPECT_NE(out.str().find("Sales report"), std::string::npos);
+    EXPECT_EQ(run(parse({"sweep", "--dry-run", "--now", "2030-01-01 00:00"}), connect, nullptr, out, err), 0);
+    EXPECT_NE(out.str().find("[dry run]"), std::string::npos);
+
+    EXPECT_EQ(run(parse({"export", "crew"}), connect, nullptr, out, err), 2);
+    EXPECT_EQ(run(parse({"sweep", "--now", "tomorrow"}), connect, nullptr, out, err), 2);
+    EXPECT_EQ(run(parse({"fly"}), connect, nullptr, out, err), 2);
+    EXPECT_EQ(run(parse({"report", "--from", "2024-02-30"}), connect, nullptr, out, err), 2);
+    EXPECT_EQ(run(parse({"import", "flights", "/nonexistent/flights.csv"}), connect, nullptr, out, err), 1);
+
+    auto failing = []() {
+        return Failure<std::shared_ptr<IDatabaseConnection>>(CoreError("no database", "DB_CONNECTION_FAILED"));
+    };
+    EXPECT_EQ(run(parse({"report"}), failing, nullptr, out, err), 1);
+    EXPECT_NE(err.str().find("no database"), std::string::npos);
+}
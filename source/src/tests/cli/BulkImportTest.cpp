@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "../../cli/BulkImport.h"
+#include "../../database/InMemoryConnection.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Cli;
+
+class BulkImportTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+    std::unique_ptr<ApplicationContext> context;
+
+    void SetUp() override {
+        db = std::make_shared<InMemoryConnection>();
+        context = std::make_unique<ApplicationContext>(db, nullptr);
+        // Ghi thẳng số ghế từng hạng để chuyến bay nhập vào có sơ đồ ghế
+        ASSERT_RESULT(db->execute(
+            "INSERT INTO aircraft (serial_number, model, economy_seats, business_seats, first_seats) VALUES "
+            "('VN100', 'Airbus A321', 150, 20, 0), ('VN200', 'Boeing 787', 200, 30, 8)"));
+    }
+
+    int countRows(const std::string& query) {
+        auto result = db->executeQuery(query);
+        if (!result || !result.value()->next().value_or(false)) return -1;
+        return result.value()->getInt(0).value_or(-1);
+    }
+
+    static std::vector<size_t> errorLines(const ImportReport& report) {
+        std::vector<size_t> lines;
+        for (const auto& error : report.errors) lines.push_back(error.line);
+        return lines;
+    }
+
+    static BulkImportOptions smallBatches(size_t batchSize) {
+        BulkImportOptions options;
+        options.batchSize = batchSize;
+        options.threads = 3;
+        return options;
+    }
+};
+
+TEST_F(BulkImportTest, TokenizerHandlesQuotesLineEndingsAndBom) {
+    CsvTokenizer tokenizer("\xEF\xBB\xBF" "a,b\r\n\r\n\"x,\"\"y\"\"\",\"multi\nline\"\nlast,\"cr\rinside\",\n"
+                           "\"open,\nnever closed");
+    std::vector<std::string> fields;
+    size_t line = 0;
+
+    ASSERT_TRUE(tokenizer.next(fields, line).value());
+    EXPECT_EQ(fields, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(line, 1u);
+
+    ASSERT_TRUE(tokenizer.next(fields, line).value());
+    EXPECT_EQ(fields, (std::vector<std::string>{"x,\"y\"", "multi\nline"}));
+    EXPECT_EQ(line, 3u);
+
+    // Bản ghi sau trường nhiều dòng mang đúng số dòng; dấu phẩy cuối cho trường rỗng
+    ASSERT_TRUE(tokenizer.next(fields, line).value());
+    EXPECT_EQ(fields, (std::vector<std::string>{"last", "cr\rinside", ""}));
+    EXPECT_EQ(line, 5u);
+
+    auto unterminated = tokenizer.next(fields, line);
+    ASSERT_FALSE(unterminated.has_value());
+    EXPECT_EQ(unterminated.error().code, "INVALID_CSV");
+    EXPECT_EQ(line, 6u);
+    EXPECT_FALSE(tokenizer.next(fields, line).value());
+}
+
+TEST_F(BulkImportTest, FlightsAreCheckedAgainstExistingSchedulesAndEarlierRows) {
+    auto existing = importCsv(*context, "flights",
+        "flight_number,route,schedule,aircraft_serial\n"
+        "VN101,Ha Noi(HAN)-Ho Chi Minh(SGN),2030-01-10 08:00|2030-01-10 10:00,VN100\n");
+    ASSERT_RESULT(existing);
+    ASSERT_EQ(existing.value().imported, 1u);
+
+    auto report = importCsv(*context, "flights",
+        "flight_number,route,schedule,aircraft_serial,status\n"
+        // 2: chồng lịch chuyến bay đã có
+        "VN102,Ho Chi Minh(SGN)-Da Nang(DAD),2030-01-10 09:30|2030-01-10 11:00,VN100,\n"
+        // 3: chạm đúng giờ đến của chuyến bay đã có cũng là chồng lịch
+        "VN103,Ho Chi Minh(SGN)-Da Nang(DAD),2030-01-10 10:00|2030-01-10 11:00,VN100,\n"
+        // 4: hợp lệ, máy bay khác cùng giờ
+        "VN104,Ho Chi Minh(SGN)-Da Nang(DAD),2030-01-10 09:30|2030-01-10 11:00,VN200,DELAYED\n"
+        // 5: chồng lịch dòng 4 trong cùng tệp
+        "VN105,Da Nang(DAD)-Ha Noi(HAN),2030-01-10 10:45|2030-01-10 12:00,VN200,\n"
+        // 6: trùng số hiệu đã có
+        "VN101,Da Nang(DAD)-Ha Noi(HAN),2030-01-12 10:45|2030-01-12 12:00,VN200,\n"
+        // 7: trùng số hiệu dòng 4
+        "VN104,Da Nang(DAD)-Ha Noi(HAN),2030-01-13 10:45|2030-01-13 12:00,VN200,\n"
+        // 8, 9, 10, 11: máy bay, trạng thái, tuyến và lịch trình sai
+        "VN108,Da Nang(DAD)-Ha Noi(HAN),2030-01-14 10:45|2030-01-14 12:00,XX999,\n"
+        "VN109,Da Nang(DAD)-Ha Noi(HAN),2030-01-14 10:45|2030-01-14 12:00,VN200,LOST\n"
+        "VN110,Da Nang,2030-01-15 10:45|2030-01-15 12:00,VN200,\n"
+        "VN111,Da Nang(DAD)-Ha Noi(HAN),2030-01-16 12:45|2030-01-16 12:00,VN200,\n"
+        // 12: hợp lệ, ngay sau chuyến bay đã có
+        "VN112,Ho Chi Minh(SGN)-Ha Noi(HAN),2030-01-10 10:01|2030-01-10 12:00,VN100,\n",
+        smallBatches(2));
+    ASSERT_RESULT(report);
+    EXPECT_EQ(report.value().imported, 2u);
+    ASSERT_EQ(errorLines(report.value()), (std::vector<size_t>{2, 3, 5, 6, 7, 8, 9, 10, 11}));
+    const auto& errors = report.value().errors;
+    EXPECT_EQ(errors[0].code, "SCHEDULE_CONFLICT");
+    EXPECT_NE(errors[0].message.find("VN101"), std::string::npos);
+    EXPECT_EQ(errors[1].code, "SCHEDULE_CONFLICT");
+    EXPECT_EQ(errors[2].code, "SCHEDULE_CONFLICT");
+    EXPECT_NE(errors[2].message.find("VN104"), std::string::npos);
+    EXPECT_EQ(errors[3].code, "DUPLICATE_FLIGHT_NUMBER");
+    EXPECT_EQ(errors[4].code, "DUPLICATE_FLIGHT_NUMBER");
+    EXPECT_EQ(errors[5].code, "NOT_FOUND");
+    EXPECT_EQ(errors[6].code, "INVALID_FLIGHT_STATUS");
+    EXPECT_EQ(errors[7].code, "INVALID_ROUTE");
+    EXPECT_EQ(errors[8].code, "INVALID_SCHEDULE");
+
+    // Chuyến bay chèn theo lô có đủ ghế trống và trạng thái trong tệp
+    auto delayed = context->flightService()->getFlight(FlightNumber::create("VN104").value());
+    ASSERT_RESULT(delayed);
+    EXPECT_EQ(delayed.value().getStatus(), FlightStatus::DELAYED);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM flight_seat_availability WHERE flight_id = " +
+                        std::to_string(delayed.value().getId())), 238);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM flight_seat_availability"), 170 + 238 + 170);
+}
+
+TEST_F(BulkImportTest, ManyBatchesKeepFileOrderAndLineNumbers) {
+    std::ostringstream flights;
+    flights << "flight_number,route,schedule,aircraft_serial\n";
+    for (int i = 0; i < 300; ++i) {
+        char buffer[128];
+        // Mỗi ngày một chuyến cho mỗi máy bay; mỗi chuyến thứ 50 lặp lại ngày trước nên chồng lịch
+        int day = (i % 50 == 49) ? i / 2 - 1 : i / 2;
+        std::snprintf(buffer, sizeof(buffer), "VN%d,Ha Noi(HAN)-Hue(HUI),2031-%02d-%02d 08:00|2031-%02d-%02d 09:00,%s\n",
+                      i + 1, day / 28 + 1, day % 28 + 1, day / 28 + 1, day % 28 + 1, i % 2 ? "VN200" : "VN100");
+        flights << buffer;
+    }
+    auto report = importCsv(*context, "flights", flights.str(), smallBatches(7));
+    ASSERT_RESULT(report);
+    EXPECT_EQ(report.value().imported, 294u);
+    EXPECT_EQ(errorLines(report.value()), (std::vector<size_t>{51, 101, 151, 201, 251, 301}));
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM flight"), 294);
+
+    // ID theo thứ tự dòng trong tệp
+    auto first = context->flightService()->getFlight(FlightNumber::create("VN1").value());
+    auto last = context->flightService()->getFlight(FlightNumber::create("VN299").value());
+    ASSERT_RESULT(first);
+    ASSERT_RESULT(last);
+    EXPECT_EQ(last.value().getId() - first.value().getId(), 293);
+}
+
+TEST_F(BulkImportTest, PassengersRejectDuplicatesInFileAndDatabase) {
+    auto existing = importCsv(*context, "passengers",
+        "passport,name,email,phone,address\n"
+        "VN:100000001,Nguyen Van A,a@example.com,0901234567,Ha Noi\n");
+    ASSERT_RESULT(existing);
+    ASSERT_EQ(existing.value().imported, 1u);
+
+    std::ostringstream passengers;
+    passengers << "passport,name,email,phone,address\n";
+    for (int i = 2; i <= 40; ++i) {
+        passengers << "VN:1000000" << (i < 10 ? "0" : "") << i << ",Passenger " << char('A' + i % 26)
+                   << ",p" << i << "@example.com,09012345" << (i < 10 ? "0" : "") << i << ",\"Hue, Viet Nam\"\n";
+    }
+    passengers << "VN:100000001,Duplicate,d@example.com,0901234599,Hue\n"    // dòng 41: trùng CSDL
+               << "VN:100000020,Duplicate,d@example.com,0901234599,Hue\n"    // dòng 42: trùng dòng 20
+               << "bad,Invalid,d@example.com,0901234599,Hue\n";              // dòng 43: sai hộ chiếu
+
+    auto report = importCsv(*context, "passengers", passengers.str(), smallBatches(5));
+    ASSERT_RESULT(report);
+    EXPECT_EQ(report.value().imported, 39u);
+    ASSERT_EQ(errorLines(report.value()), (std::vector<size_t>{41, 42, 43}));
+    EXPECT_EQ(report.value().errors[0].code, "DUPLICATE_PASSPORT");
+    EXPECT_EQ(report.value().errors[1].code, "DUPLICATE_PASSPORT");
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM passenger"), 40);
+
+    auto stored = context->passengerService()->getPassenger(PassportNumber::create("VN:100000020").value());
+    ASSERT_RESULT(stored);
+    EXPECT_EQ(stored.value().getContactInfo().getAddress(), "Hue, Viet Nam");
+}
+
+TEST_F(BulkImportTest, ImportsFromMappedFile) {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("bulk_import_" + std::to_string(::getpid()) + ".csv")).string();
+    {
+        std::ofstream file(path);
+        file << "passport,name,email,phone,address\r\n"
+                "VN:200000001,Le Van C,c@example.com,0901111111,Da Nang\r\n";
+    }
+    auto report = importFile(*context, "passengers", path);
+    std::filesystem::remove(path);
+    ASSERT_RESULT(report);
+    EXPECT_EQ(report.value().imported, 1u);
+    EXPECT_TRUE(report.value().errors.empty());
+
+    auto missing = importFile(*context, "passengers", path);
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, "IMPORT_IO");
+    EXPECT_EQ(importFile(*context, "crew", path).error().code, "UNKNOWN_TABLE");
+
+    auto empty = importCsv(*context, "flights", "");
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, "INVALID_CSV_HEADER");
+}
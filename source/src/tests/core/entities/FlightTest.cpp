@@ -198,4 +198,28 @@ TEST_F(FlightTest, DifferentSeatLayouts) {
     EXPECT_FALSE(flight.isSeatAvailable("F01"));  // First class not available in this layout
     EXPECT_FALSE(flight.isSeatAvailable("E51")); // Economy seats beyond 50 not available
     EXPECT_FALSE(flight.isSeatAvailable("B111"));  // Business seats beyond 10 not available
-} 
\ No newline at end of file
+} 
+// Test dirty field tracking
+TEST_F(FlightTest, DirtyFieldTracking) {
+    auto result = createFlight();
+    ASSERT_TRUE(result.has_value());
+    Flight flight = *result;
+
+    // A freshly created flight has not been synced with the database yet
+    EXPECT_TRUE(flight.isDirty());
+    EXPECT_FALSE(flight.hasPartialChanges());
+
+    // After a load/save the repository clears the flags
+    flight.clearDirty();
+    EXPECT_FALSE(flight.isDirty());
+
+    flight.setStatus(FlightStatus::DELAYED);
+    EXPECT_TRUE(flight.hasPartialChanges());
+    EXPECT_TRUE(flight.isFieldDirty(Flight::FIELD_STATUS));
+    EXPECT_FALSE(flight.isFieldDirty(Flight::FIELD_SCHEDULE));
+
+    auto scheduleResult = Schedule::create("2024-03-20 11:00|2024-03-20 13:00");
+    ASSERT_TRUE(scheduleResult.has_value());
+    flight.setSchedule(*scheduleResult);
+    EXPECT_EQ(flight.getDirtyFields(), Flight::FIELD_STATUS | Flight::FIELD_SCHEDULE);
+}
@@ -0,0 +1,375 @@
+#include <gtest/gtest.h>
+#include "../../database/InMemoryConnection.h"
+#include "../../repositories/MySQLRepository/AircraftRepository.h"
+#include "../../repositories/MySQLRepository/FlightRepository.h"
+#include "../../repositories/MySQLRepository/PassengerRepository.h"
+#include "../../repositories/MySQLRepository/TicketRepository.h"
+#include "../../services/PassengerService.h"
+#include "../../services/TicketService.h"
+#include "../../utils/TableConstants.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+#define EXPECT_RESULT(result) EXPECT_TRUE(result.has_value())
+
+class InMemoryConnectionTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+
+    void SetUp() override {
+        db = std::make_shared<InMemoryConnection>();
+    }
+
+    int countRows(const std::string& query) {
+        auto result = db->executeQuery(query);
+        if (!result || !result.value()->next().value()) return -1;
+        return result.value()->getInt(0).value();
+    }
+};
+
+// Thực thi trực tiếp, tham số và chỉ mục
+TEST_F(InMemoryConnectionTest, BasicQueryTest) {
+    auto insertResult = db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'TEST')");
+    ASSERT_RESULT(insertResult) << insertResult.error().message;
+
+    auto queryResult = db->executeQuery("SELECT * FROM seat_class WHERE code = 'T'");
+    ASSERT_RESULT(queryResult);
+    auto& rows = queryResult.value();
+    ASSERT_TRUE(rows->next().value());
+    EXPECT_EQ(rows->getString("name").value(), "TEST");
+    EXPECT_EQ(rows->getInt("id").value(), 4);
+    EXPECT_FALSE(rows->next().value());
+
+    auto duplicateResult = db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'AGAIN')");
+    ASSERT_FALSE(duplicateResult.has_value());
+    EXPECT_EQ(duplicateResult.error().code, "DUPLICATE_ENTRY");
+}
+
+TEST_F(InMemoryConnectionTest, PreparedStatementTest) {
+    auto stmt = db->prepareStatement("INSERT INTO passenger (passport_number, name, email, phone, address) VALUES (?, ?, ?, ?, ?)");
+    ASSERT_RESULT(stmt);
+    for (int i = 0; i < 3; ++i) {
+        db->setString(stmt.value(), 1, "VN:100000" + std::to_string(i));
+        db->setString(stmt.value(), 2, "Passenger " + std::to_string(i));
+        db->setString(stmt.value(), 3, "p@example.com");
+        db->setString(stmt.value(), 4, "+84123456789");
+        db->setString(stmt.value(), 5, "Street");
+        ASSERT_RESULT(db->executeStatement(stmt.value()));
+        EXPECT_EQ(db->getLastInsertId().value(), i + 1);
+    }
+    db->freeStatement(stmt.value());
+    EXPECT_FALSE(db->setString(stmt.value(), 1, "x").has_value());
+
+    auto update = db->prepareStatement("UPDATE passenger SET name = ?, version = version + 1 WHERE id = ? AND version = ?");
+    ASSERT_RESULT(update);
+    db->setString(update.value(), 1, "Renamed");
+    db->setInt(update.value(), 2, 2);
+    db->setInt(update.value(), 3, 0);
+    auto updated = db->executeUpdate(update.value());
+    ASSERT_RESULT(updated);
+    EXPECT_EQ(updated.value(), 1);
+    auto stale = db->executeUpdate(update.value());
+    ASSERT_RESULT(stale);
+    EXPECT_EQ(stale.value(), 0);
+
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM passenger WHERE version > 0"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM passenger WHERE id IN (1, 3)"), 2);
+
+    auto ordered = db->executeQuery("SELECT id, name FROM passenger ORDER BY id DESC LIMIT 2");
+    ASSERT_RESULT(ordered);
+    ASSERT_TRUE(ordered.value()->next().value());
+    EXPECT_EQ(ordered.value()->getInt(0).value(), 3);
+    ASSERT_TRUE(ordered.value()->next().value());
+    EXPECT_EQ(ordered.value()->getString("name").value(), "Renamed");
+    EXPECT_FALSE(ordered.value()->next().value());
+}
+
+TEST_F(InMemoryConnectionTest, GroupByCountsPerKey) {
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO ticket (ticket_number, flight_id, passenger_id, seat_number, price, currency) VALUES "
+        "('T1', 1, 1, 'E001', 10, 'VND'), ('T2', 1, 2, 'E002', 10, 'VND'), ('T3', 1, 3, 'B01', 10, 'VND'), "
+        "('T4', 2, 1, 'E001', 10, 'VND')"));
+
+    auto grouped = db->executeQuery(Tables::Ticket::SEAT_OCCUPANCY_QUERY);
+    ASSERT_RESULT(grouped) << grouped.error().message;
+    auto& rows = grouped.value();
+    // Nhóm theo thứ tự khóa: (1, B), (1, E), (2, E)
+    const std::vector<std::tuple<int, std::string, int>> expected = {{1, "B", 1}, {1, "E", 2}, {2, "E", 1}};
+    for (const auto& [flightId, seatClass, booked] : expected) {
+        ASSERT_TRUE(rows->next().value());
+        EXPECT_EQ(rows->getInt(0).value(), flightId);
+        EXPECT_EQ(rows->getString(1).value(), seatClass);
+        EXPECT_EQ(rows->getInt(2).value(), booked);
+    }
+    EXPECT_FALSE(rows->next().value());
+
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM ticket WHERE flight_id = 1 GROUP BY flight_id"), 3);
+    auto ordered = db->executeQuery("SELECT flight_id, COUNT(*) FROM ticket GROUP BY flight_id ORDER BY flight_id");
+    ASSERT_FALSE(ordered.has_value());
+    EXPECT_EQ(ordered.error().code, "UNSUPPORTED_SQL");
+}
+
+TEST_F(InMemoryConnectionTest, HighWaterMarkAggregates) {
+    // Bảng rỗng: COUNT là 0, MAX/SUM là NULL
+    auto empty = db->executeQuery("SELECT COUNT(*), MAX(id), SUM(version) FROM ticket");
+    ASSERT_RESULT(empty) << empty.error().message;
+    ASSERT_TRUE(empty.value()->next().value());
+    EXPECT_EQ(empty.value()->getInt(0).value(), 0);
+    EXPECT_EQ(empty.value()->getString(1).value(), "");
+
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO ticket (ticket_number, flight_id, passenger_id, seat_number, price, currency) VALUES "
+        "('T1', 1, 1, 'E001', 10, 'VND'), ('T2', 1, 2, 'E002', 10, 'VND'), ('T3', 2, 3, 'B01', 10, 'VND')"));
+    ASSERT_RESULT(db->execute("UPDATE ticket SET version = version + 1 WHERE id = 2"));
+
+    auto mark = db->executeQuery("SELECT COUNT(*), MAX(id), SUM(version) FROM ticket WHERE flight_id = 1");
+    ASSERT_RESULT(mark) << mark.error().message;
+    auto& rows = mark.value();
+    ASSERT_TRUE(rows->next().value());
+    EXPECT_EQ(rows->getInt(0).value(), 2);
+    EXPECT_EQ(rows->getInt(1).value(), 2);
+    EXPECT_EQ(rows->getInt(2).value(), 1);   // version mặc định 0, T2 đã sửa một lần
+    EXPECT_FALSE(rows->next().value());
+
+    auto grouped = db->executeQuery("SELECT flight_id, MAX(id) FROM ticket GROUP BY flight_id");
+    ASSERT_FALSE(grouped.has_value());
+    EXPECT_EQ(grouped.error().code, "UNSUPPORTED_SQL");
+}
+
+TEST_F(InMemoryConnectionTest, CountDistinctWithNotIn) {
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO ticket (ticket_number, flight_id, passenger_id, seat_number, price, currency, status) VALUES "
+        "('T1', 1, 1, 'E001', 10, 'VND', 'CONFIRMED'), ('T2', 2, 1, 'E001', 10, 'VND', 'PENDING'), "
+        "('T3', 1, 2, 'E002', 10, 'VND', 'CANCELLED'), ('T4', 1, 3, 'E003', 10, 'VND', 'REFUNDED')"));
+
+    auto counts = db->executeQuery(
+        "SELECT COUNT(DISTINCT passenger_id), COUNT(*) FROM ticket WHERE status NOT IN ('CANCELLED', 'REFUNDED')");
+    ASSERT_RESULT(counts) << counts.error().message;
+    auto& rows = counts.value();
+    ASSERT_TRUE(rows->next().value());
+    EXPECT_EQ(rows->getInt(0).value(), 1);
+    EXPECT_EQ(rows->getInt(1).value(), 2);
+    EXPECT_FALSE(rows->next().value());
+
+    EXPECT_EQ(countRows("SELECT COUNT(DISTINCT flight_id) FROM ticket"), 2);
+    EXPECT_EQ(countRows("SELECT COUNT(DISTINCT passenger_id) FROM ticket WHERE status NOT IN ('CONFIRMED')"), 3);
+
+    auto grouped = db->executeQuery("SELECT flight_id, COUNT(DISTINCT passenger_id) FROM ticket GROUP BY flight_id");
+    ASSERT_FALSE(grouped.has_value());
+    EXPECT_EQ(grouped.error().code, "UNSUPPORTED_SQL");
+}
+
+TEST_F(InMemoryConnectionTest, PassengerStatisticsFromGroupedQueries) {
+    auto passengerRepository = std::make_shared<PassengerRepository>(db, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(db, nullptr);
+    auto ticketRepository = std::make_shared<TicketRepository>(db, passengerRepository, flightRepository, nullptr);
+    PassengerService service(passengerRepository, ticketRepository, flightRepository, nullptr);
+
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO passenger (passport_number, name, email, phone, address) VALUES "
+        "('VN:1000001', 'A', 'a@example.com', '0901234567', 'Ha Noi'), "
+        "('VN:1000002', 'B', 'b@example.com', '0901234567', 'Ha Noi'), "
+        "('VN:1000003', 'C', 'c@example.com', '0901234567', 'Ha Noi'), "
+        "('VN:1000004', 'D', 'd@example.com', '0901234567', 'Ha Noi')"));
+    // Hành khách 1: hai vé đang hoạt động; 2: một vé hoạt động, một vé đã hủy; 3: chỉ có vé đã hoàn tiền
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO ticket (ticket_number, flight_id, passenger_id, seat_number, price, currency, status) VALUES "
+        "('T1', 1, 1, 'E001', 10, 'VND', 'CONFIRMED'), ('T2', 2, 1, 'E001', 10, 'VND', 'PENDING'), "
+        "('T3', 1, 2, 'E002', 10, 'VND', 'CHECKED_IN'), ('T4', 2, 2, 'E002', 10, 'VND', 'CANCELLED'), "
+        "('T5', 1, 3, 'E003', 10, 'VND', 'REFUNDED')"));
+
+    auto statistics = service.getStatistics();
+    ASSERT_RESULT(statistics) << statistics.error().message;
+    EXPECT_EQ(statistics.value().totalPassengers, 4u);
+    EXPECT_EQ(statistics.value().passengersWithActiveBookings, 2u);
+    EXPECT_EQ(statistics.value().activeTickets, 3u);
+    EXPECT_DOUBLE_EQ(statistics.value().averageFlightsPerPassenger(), 0.75);
+    EXPECT_DOUBLE_EQ(statistics.value().activeBookingPercentage(), 50.0);
+}
+
+TEST_F(InMemoryConnectionTest, TransactionRollbackRestoresData) {
+    ASSERT_RESULT(db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'TEST')"));
+    ASSERT_RESULT(db->beginTransaction());
+    ASSERT_RESULT(db->execute("DELETE FROM seat_class WHERE code = 'T'"));
+    ASSERT_RESULT(db->execute("INSERT INTO seat_class (code, name) VALUES ('U', 'OTHER')"));
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class"), 4);
+    ASSERT_RESULT(db->rollbackTransaction());
+
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'T'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'U'"), 0);
+    EXPECT_FALSE(db->commitTransaction().has_value());
+}
+
+TEST_F(InMemoryConnectionTest, OtherConnectionsWaitForOpenTransaction) {
+    InMemoryConnection other(db->getDatabase());
+    db->getDatabase()->setLockWaitTimeout(std::chrono::milliseconds(20));
+    ASSERT_RESULT(db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'TEST')"));
+
+    ASSERT_RESULT(db->beginTransaction());
+    ASSERT_RESULT(db->execute("UPDATE seat_class SET name = 'CHANGED' WHERE code = 'T'"));
+
+    // Không đọc được thay đổi chưa commit, không ghi xen được, không mở transaction thứ hai
+    auto read = other.executeQuery("SELECT COUNT(*) FROM seat_class WHERE name = 'CHANGED'");
+    ASSERT_FALSE(read.has_value());
+    EXPECT_EQ(read.error().code, "LOCK_WAIT_TIMEOUT");
+    EXPECT_FALSE(other.execute("UPDATE seat_class SET name = 'BIZ' WHERE code = 'B'").has_value());
+    EXPECT_FALSE(other.beginTransaction().has_value());
+
+    ASSERT_RESULT(db->rollbackTransaction());
+    ASSERT_RESULT(other.execute("UPDATE seat_class SET name = 'BIZ' WHERE code = 'B'"));
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'TEST'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'BIZ'"), 1);
+}
+
+TEST_F(InMemoryConnectionTest, BlockedWriterRunsAfterRollback) {
+    ASSERT_RESULT(db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'TEST')"));
+    ASSERT_RESULT(db->beginTransaction());
+    ASSERT_RESULT(db->execute("UPDATE seat_class SET name = 'CHANGED' WHERE code = 'T'"));
+    ASSERT_RESULT(db->execute("DELETE FROM seat_class WHERE code = 'E'"));
+
+    std::atomic<bool> written{false};
+    std::thread writer([database = db->getDatabase(), &written] {
+        InMemoryConnection other(database);
+        other.execute("INSERT INTO seat_class (code, name) VALUES ('O', 'OTHER')");
+        other.execute("UPDATE seat_class SET name = 'BIZ' WHERE code = 'B'");
+        written = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(written.load());
+
+    ASSERT_RESULT(db->rollbackTransaction());
+    writer.join();
+    EXPECT_TRUE(written.load());
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'TEST'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'E'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'O'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'BIZ'"), 1);
+}
+
+TEST_F(InMemoryConnectionTest, RollbackDoesNotRestoreTakenUniqueKey) {
+    ASSERT_RESULT(db->beginTransaction());
+    ASSERT_RESULT(db->execute("DELETE FROM seat_class WHERE code = 'E'"));
+
+    // Ghi trực tiếp bỏ qua transaction lấy lại khóa 'E' trước khi rollback
+    {
+        auto database = db->getDatabase();
+        auto lock = database->lock();
+        auto* table = database->findTable("seat_class");
+        ASSERT_NE(table, nullptr);
+        ASSERT_RESULT(table->insert({InMemory::Value{}, std::string("E"), std::string("DIRECT")}));
+    }
+
+    auto rolledBack = db->rollbackTransaction();
+    ASSERT_FALSE(rolledBack.has_value());
+    EXPECT_EQ(rolledBack.error().code, "DUPLICATE_ENTRY");
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'E'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'DIRECT'"), 1);
+    // Transaction vẫn kết thúc dù rollback báo lỗi
+    EXPECT_RESULT(db->beginTransaction());
+}
+
+TEST_F(InMemoryConnectionTest, FailedStatementLeavesNoPartialChanges) {
+    // Hàng đầu tiên đổi được mã, hàng thứ hai trùng khóa duy nhất nên cả câu lệnh bị hoàn tác
+    EXPECT_FALSE(db->execute("UPDATE seat_class SET code = 'Z'").has_value());
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'Z'"), 0);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code IN ('E', 'B', 'F')"), 3);
+
+    ASSERT_RESULT(db->beginTransaction());
+    ASSERT_RESULT(db->execute("INSERT INTO seat_class (code, name) VALUES ('T', 'TEST')"));
+    EXPECT_FALSE(db->execute("INSERT INTO seat_class (code, name) VALUES ('U', 'ONE'), ('U', 'TWO')").has_value());
+    ASSERT_RESULT(db->commitTransaction());
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'T'"), 1);
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE code = 'U'"), 0);
+}
+
+TEST_F(InMemoryConnectionTest, ConnectionsSharingDatabaseRunConcurrently) {
+    constexpr int threadCount = 4;
+    constexpr int insertsPerThread = 250;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([database = db->getDatabase(), t] {
+            InMemoryConnection connection(database);
+            for (int i = 0; i < insertsPerThread; ++i) {
+                auto code = "C" + std::to_string(t) + "_" + std::to_string(i);
+                connection.beginTransaction();
+                connection.execute("INSERT INTO seat_class (code, name) VALUES ('" + code + "', 'LOAD')");
+                if (i % 2) connection.rollbackTransaction(); else connection.commitTransaction();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(countRows("SELECT COUNT(*) FROM seat_class WHERE name = 'LOAD'"), threadCount * insertsPerThread / 2);
+}
+
+TEST_F(InMemoryConnectionTest, UnsupportedSqlFails) {
+    auto result = db->executeQuery("SELECT * FROM passenger WHERE id = 1 OR id = 2");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, "UNSUPPORTED_SQL");
+
+    auto unknown = db->executeQuery("SELECT * FROM missing_table");
+    ASSERT_FALSE(unknown.has_value());
+    EXPECT_EQ(unknown.error().code, "UNKNOWN_TABLE");
+}
+
+// Repository và service thật chạy trên InMemoryConnection
+TEST_F(InMemoryConnectionTest, RepositoriesRoundTrip) {
+    auto passengerRepository = std::make_shared<PassengerRepository>(db, nullptr);
+    auto aircraftRepository = std::make_shared<AircraftRepository>(db, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(db, nullptr);
+    auto ticketRepository = std::make_shared<TicketRepository>(db, passengerRepository, flightRepository, nullptr);
+    TicketService service(ticketRepository, passengerRepository, flightRepository, aircraftRepository, nullptr);
+
+    auto passenger = Passenger::create("John Doe", "user@example.com|+84123456789|123 Street", "VN:1232323");
+    ASSERT_RESULT(passenger);
+    auto createdPassenger = passengerRepository->create(passenger.value());
+    ASSERT_RESULT(createdPassenger) << createdPassenger.error().message;
+
+    auto aircraft = Aircraft::create(AircraftSerial::create("HK191").value(), "Boeing 737",
+                                     SeatClassMap::create("E:10,B:5,F:2").value());
+    ASSERT_RESULT(aircraft);
+    auto createdAircraft = aircraftRepository->create(aircraft.value());
+    ASSERT_RESULT(createdAircraft) << createdAircraft.error().message;
+
+    auto flight = Flight::create(FlightNumber::create("HK191").value(),
+                                 Route::create("Sai Gon(SGN)-Ha Noi(HAN)").value(),
+                                 Schedule::create("2024-03-15 10:00|2024-03-15 12:00").value(),
+                                 std::make_shared<Aircraft>(createdAircraft.value()));
+    ASSERT_RESULT(flight);
+    auto createdFlight = flightRepository->create(flight.value());
+    ASSERT_RESULT(createdFlight) << createdFlight.error().message;
+
+    auto found = flightRepository->findByFlightNumber(FlightNumber::create("HK191").value());
+    ASSERT_RESULT(found) << found.error().message;
+    EXPECT_EQ(found.value().getId(), createdFlight.value().getId());
+    EXPECT_EQ(found.value().getAircraft()->getSerial().toString(), "HK191");
+
+    auto ticket = service.bookTicket(createdPassenger.value().getPassport(), found.value().getFlightNumber(),
+                                     "E01", Price::create("100000 VND").value());
+    ASSERT_RESULT(ticket) << ticket.error().message;
+
+    auto count = ticketRepository->countByFlightId(createdFlight.value().getId());
+    ASSERT_RESULT(count);
+    EXPECT_EQ(count.value(), 1u);
+
+    auto reloaded = ticketRepository->findByTicketNumber(ticket.value().getTicketNumber());
+    ASSERT_RESULT(reloaded) << reloaded.error().message;
+    EXPECT_EQ(reloaded.value().getSeatNumber().toString(), "E01");
+    EXPECT_EQ(reloaded.value().getPassenger()->getId(), createdPassenger.value().getId());
+
+    auto second = Passenger::create("Jane Smith", "jane@example.com|+84987654321|456 Avenue", "VN:9876543");
+    ASSERT_RESULT(second);
+    auto createdSecond = passengerRepository->create(second.value());
+    ASSERT_RESULT(createdSecond) << createdSecond.error().message;
+
+    std::vector<PassportNumber> passports{createdPassenger.value().getPassport(), createdSecond.value().getPassport()};
+    auto group = service.bookGroup(passports, found.value().getFlightNumber(), "B", Price::create("200000 VND").value());
+    ASSERT_RESULT(group) << group.error().message;
+    ASSERT_EQ(group.value().size(), 2u);
+    EXPECT_EQ(ticketRepository->countByFlightId(createdFlight.value().getId()).value(), 3u);
+}
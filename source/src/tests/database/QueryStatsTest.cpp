@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../../database/QueryStats.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+    class CapturingLogHandler : public ILogHandler {
+    public:
+        std::vector<std::string> messages;
+
+        void write(LogLevel, const std::string&, const std::string& message) override {
+            messages.push_back(message);
+        }
+    };
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1000u);
+    EXPECT_EQ(histogram.max(), 10000000u);
+
+    for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+        double expected = percentile / 100.0 * 10000000.0;
+        double actual = static_cast<double>(histogram.valueAtPercentile(percentile));
+        EXPECT_NEAR(actual, expected, expected / 32.0) << "p" << percentile;
+    }
+    EXPECT_EQ(histogram.valueAtPercentile(100), histogram.max());
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExactAndMergeAddsCounts) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(3);
+    a.record(3);
+    b.record(7);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 3u);
+    EXPECT_EQ(a.valueAtPercentile(50), 3u);
+    EXPECT_EQ(a.valueAtPercentile(100), 7u);
+    EXPECT_EQ(a.sum(), 13u);
+}
+
+TEST(QueryStatsTest, NormalizeGroupsLiteralsAndInLists) {
+    EXPECT_EQ(QueryStats::normalize("SELECT * FROM passenger WHERE passport_number = 'VN:123'"),
+              "SELECT * FROM passenger WHERE passport_number = ?");
+    EXPECT_EQ(QueryStats::normalize("UPDATE flight  SET version = version + 1\n WHERE id = 42;"),
+              "UPDATE flight SET version = version + ? WHERE id = ?");
+    EXPECT_EQ(QueryStats::normalize("SELECT * FROM ticket WHERE id IN (1, 2, 3)"),
+              QueryStats::normalize("SELECT * FROM ticket WHERE id IN ('4','5')"));
+    EXPECT_EQ(QueryStats::normalize("SELECT * FROM t2 WHERE name = 'it''s'"),
+              "SELECT * FROM t2 WHERE name = ?");
+}
+
+TEST(QueryStatsTest, TopByTotalTimeOrdersStatements) {
+    QueryStats stats;
+    stats.record("SELECT * FROM flight WHERE id = 1", 2ms, 1, 0ns);
+    stats.record("SELECT * FROM flight WHERE id = 2", 3ms, 1, 10us);
+    stats.record("SELECT * FROM passenger", 1ms, 50, 0ns);
+    stats.record("DELETE FROM ticket WHERE id = 9", 1ms, 0, 0ns, false);
+
+    auto top = stats.topByTotalTime(2);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0].statement, "SELECT * FROM flight WHERE id = ?");
+    EXPECT_EQ(top[0].latencyNanos.count(), 2u);
+    EXPECT_EQ(top[0].lockWaitNanos.max(), 10000u);
+
+    auto all = stats.topByTotalTime(10);
+    ASSERT_EQ(all.size(), 3u);
+    EXPECT_EQ(all[2].errors + all[1].errors, 1u);
+
+    auto report = stats.dump(5);
+    EXPECT_NE(report.find("SELECT * FROM flight WHERE id = ?"), std::string::npos);
+    EXPECT_EQ(stats.totalLockWait().count(), 4u);
+}
+
+TEST(QueryStatsTest, SlowQueriesGoToSeparateSink) {
+    QueryStats stats;
+    auto sink = std::make_shared<CapturingLogHandler>();
+    stats.setSlowQueryLog(5ms, sink);
+
+    stats.record("SELECT * FROM flight", 1ms, 10, 0ns);
+    stats.record("SELECT * FROM ticket WHERE price > 100", 8ms, 1000, 0ns);
+    stats.record("SELECT * FROM passenger WHERE passport_number = 'VN:123456789'", 9ms, 1, 0ns);
+
+    // Chỉ câu đã chuẩn hóa: giá trị tham số không rơi vào nhật ký
+    ASSERT_EQ(sink->messages.size(), 2u);
+    EXPECT_NE(sink->messages[0].find("price > ?"), std::string::npos);
+    EXPECT_EQ(sink->messages[0].find("> 100"), std::string::npos);
+    EXPECT_NE(sink->messages[1].find("passport_number = ?"), std::string::npos);
+    EXPECT_EQ(sink->messages[1].find("VN:123456789"), std::string::npos);
+    EXPECT_EQ(stats.topByTotalTime(1)[0].slowQueries, 1u);
+
+    stats.setSlowQueryLog(0ms, nullptr);
+    stats.record("SELECT * FROM ticket WHERE price > 100", 8ms, 1000, 0ns);
+    EXPECT_EQ(sink->messages.size(), 2u);
+}
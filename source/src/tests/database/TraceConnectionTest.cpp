@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "../../database/TraceConnection.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../repositories/MySQLRepository/PassengerRepository.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+#define EXPECT_RESULT(result) EXPECT_TRUE(result.has_value())
+
+class TraceConnectionTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> backend;
+    std::shared_ptr<TraceConnection> recorder;
+    std::string tracePath = "trace_connection_test.trace";
+
+    void SetUp() override {
+        backend = std::make_shared<InMemoryConnection>();
+        recorder = std::make_shared<TraceConnection>(std::static_pointer_cast<IDatabaseConnection>(backend));
+    }
+
+    void TearDown() override {
+        std::remove(tracePath.c_str());
+    }
+
+    // Chạy một phiên làm việc thật của repository qua kết nối đang ghi
+    void recordSession() {
+        PassengerRepository repository(recorder, nullptr);
+
+        recorder->mark("createPassenger");
+        auto passenger = Passenger::create("John Doe", "user@example.com|+84123456789|123 Street", "VN:1232323");
+        ASSERT_RESULT(passenger);
+        auto created = repository.create(passenger.value());
+        ASSERT_RESULT(created) << created.error().message;
+
+        recorder->mark("findPassenger");
+        auto found = repository.findByPassportNumber(PassportNumber::create("VN:1232323").value());
+        ASSERT_RESULT(found) << found.error().message;
+        EXPECT_EQ(found.value().getName(), "John Doe");
+    }
+};
+
+TEST_F(TraceConnectionTest, ReplayServesRecordedResults) {
+    recordSession();
+    ASSERT_RESULT(recorder->saveTrace(tracePath));
+
+    auto trace = Trace::load(tracePath);
+    ASSERT_RESULT(trace) << trace.error().message;
+    EXPECT_EQ(trace.value().events.size(), recorder->getTrace().events.size());
+
+    auto replay = std::make_shared<TraceConnection>(std::move(trace.value()));
+    PassengerRepository repository(replay, nullptr);
+
+    replay->mark("createPassenger");
+    auto passenger = Passenger::create("John Doe", "user@example.com|+84123456789|123 Street", "VN:1232323");
+    auto created = repository.create(passenger.value());
+    ASSERT_RESULT(created) << created.error().message;
+
+    replay->mark("findPassenger");
+    auto found = repository.findByPassportNumber(PassportNumber::create("VN:1232323").value());
+    ASSERT_RESULT(found) << found.error().message;
+    EXPECT_EQ(found.value().getName(), "John Doe");
+    EXPECT_EQ(found.value().getId(), created.value().getId());
+    EXPECT_EQ(replay->remainingEvents(), 0u);
+}
+
+TEST_F(TraceConnectionTest, SummarizeCountsRoundTripsPerAction) {
+    recordSession();
+    auto actions = recorder->getTrace().summarizeActions();
+    ASSERT_EQ(actions.size(), 2u);
+    EXPECT_EQ(actions[0].label, "createPassenger");
+    EXPECT_EQ(actions[1].label, "findPassenger");
+    EXPECT_GE(actions[0].roundTrips, 1u);
+    EXPECT_EQ(actions[1].roundTrips, 1u);
+    EXPECT_EQ(actions[1].rowsRead, 1u);
+}
+
+TEST_F(TraceConnectionTest, ReplayDetectsDivergence) {
+    recordSession();
+    auto replay = std::make_shared<TraceConnection>(recorder->getTrace());
+
+    auto result = replay->executeQuery("SELECT * FROM passenger");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, "REPLAY_DIVERGED");
+}
+
+TEST_F(TraceConnectionTest, LoadRejectsCorruptedFile) {
+    recordSession();
+    ASSERT_RESULT(recorder->saveTrace(tracePath));
+
+    // Cắt cụt file
+    std::FILE* file = std::fopen(tracePath.c_str(), "rb+");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    std::string data(static_cast<size_t>(size / 2), '\0');
+    file = std::fopen(tracePath.c_str(), "rb");
+    std::fread(data.data(), 1, data.size(), file);
+    std::fclose(file);
+    file = std::fopen(tracePath.c_str(), "wb");
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+
+    auto trace = Trace::load(tracePath);
+    ASSERT_FALSE(trace.has_value());
+    EXPECT_EQ(trace.error().code, "TRACE_FORMAT");
+}
+
+TEST_F(TraceConnectionTest, LoadRejectsUnknownOperationsAndCellFlags) {
+    auto writeTrace = [this](const std::string& body) {
+        std::string data = std::string("ATRC") + '\x02' + body;
+        FILE* file = std::fopen(tracePath.c_str(), "wb");
+        std::fwrite(data.data(), 1, data.size(), file);
+        std::fclose(file);
+    };
+
+    // Một sự kiện với op 200 (ngoài TraceOp)
+    writeTrace(std::string("\x01\xC8\x01", 3) + std::string(5, '\0'));
+    auto badOp = Trace::load(tracePath);
+    ASSERT_FALSE(badOp.has_value());
+    EXPECT_EQ(badOp.error().code, "INVALID_TRACE");
+
+    // EXECUTE_QUERY có tập kết quả một ô mang bit cờ chưa định nghĩa
+    writeTrace(std::string("\x01\x03\x03", 3) + std::string(5, '\0') + "\x01\x01" + '\x30' + std::string(4, '\0'));
+    auto badCell = Trace::load(tracePath);
+    ASSERT_FALSE(badCell.has_value());
+    EXPECT_EQ(badCell.error().code, "INVALID_TRACE");
+
+    // Cùng bản ghi với cờ ô hợp lệ thì nạp được
+    writeTrace(std::string("\x01\x03\x03", 3) + std::string(5, '\0') + "\x01\x01" + '\x09' + std::string(4, '\0'));
+    auto valid = Trace::load(tracePath);
+    ASSERT_RESULT(valid) << valid.error().message;
+    ASSERT_EQ(valid.value().events.size(), 1u);
+    EXPECT_EQ(valid.value().events[0].resultSet->rows[0][0].kind, TraceCell::Kind::INT);
+}
+
+TEST_F(TraceConnectionTest, SequentialPagesSeekByKeyAndJumpsUseOffset) {
+    std::string values;
+    for (int i = 1; i <= 25; ++i) {
+        if (i > 1) values += ", ";
+        values += "('VN:" + std::to_string(100000000 + i) + "', 'P" + std::to_string(i) +
+                  "', 'p@example.com', '0901234567', 'Ha Noi')";
+    }
+    ASSERT_RESULT(backend->execute("INSERT INTO passenger (passport_number, name, email, phone, address) VALUES " + values));
+    PassengerRepository repository(recorder, nullptr);
+
+    // Câu SQL đã chuẩn bị cho mỗi lần nạp trang, cùng id của hàng đầu và số hàng
+    auto loadPage = [&](size_t offset, std::string& sql) {
+        std::vector<PassengerListRow> rows;
+        size_t before = recorder->getTrace().events.size();
+        EXPECT_RESULT(repository.findListRowsPage(offset, 10, rows));
+        const auto& events = recorder->getTrace().events;
+        for (size_t i = before; i < events.size(); ++i) {
+            if (events[i].op == TraceOp::PREPARE) sql = events[i].text;
+        }
+        return std::make_pair(rows.empty() ? 0 : rows.front().id, rows.size());
+    };
+    auto byKey = [](const std::string& sql) { return sql.find(" > ?") != std::string::npos; };
+
+    ASSERT_RESULT(repository.count());
+    std::string sql;
+    EXPECT_EQ(loadPage(0, sql), std::make_pair(1, size_t{10}));
+    EXPECT_TRUE(byKey(sql)) << sql;
+    EXPECT_EQ(loadPage(10, sql), std::make_pair(11, size_t{10}));
+    EXPECT_TRUE(byKey(sql)) << sql;
+    EXPECT_EQ(loadPage(20, sql), std::make_pair(21, size_t{5}));
+    EXPECT_TRUE(byKey(sql)) << sql;
+
+    // Nhảy tới vị trí chưa có mốc
+    EXPECT_EQ(loadPage(5, sql), std::make_pair(6, size_t{10}));
+    EXPECT_FALSE(byKey(sql)) << sql;
+
+    // Xóa một hàng phía trước làm lệch mốc: trang sau đó quay về OFFSET và vẫn đúng vị trí
+    ASSERT_RESULT(repository.deleteById(3));
+    EXPECT_EQ(loadPage(10, sql), std::make_pair(12, size_t{10}));
+    EXPECT_FALSE(byKey(sql)) << sql;
+    EXPECT_EQ(loadPage(20, sql), std::make_pair(22, size_t{4}));
+    EXPECT_TRUE(byKey(sql)) << sql;
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "../../loadgen/DataGenerator.h"
+#include "../../loadgen/LoadDriver.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../repositories/MySQLRepository/AircraftRepository.h"
+#include "../../repositories/MySQLRepository/FlightRepository.h"
+#include "../../repositories/MySQLRepository/PassengerRepository.h"
+#include "../../repositories/MySQLRepository/TicketRepository.h"
+#include <algorithm>
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace LoadGen;
+
+class LoadGeneratorTest : public ::testing::Test {
+protected:
+    static GeneratorConfig smallConfig() {
+        GeneratorConfig config;
+        config.aircraftCount = 6;
+        config.flightCount = 80;
+        config.passengerCount = 300;
+        config.ticketCount = 2000;
+        config.days = 10;
+        return config;
+    }
+
+    static int64_t count(const std::shared_ptr<IDatabaseConnection>& db, const std::string& table) {
+        auto result = db->executeQuery("SELECT COUNT(*) FROM " + table);
+        if (!result || !result.value()->next()) return -1;
+        return result.value()->getInt(0).value();
+    }
+};
+
+TEST_F(LoadGeneratorTest, DatasetIsDeterministicAndSkewed) {
+    auto first = SyntheticDataset::create(smallConfig());
+    auto second = SyntheticDataset::create(smallConfig());
+    ASSERT_RESULT(first);
+    ASSERT_RESULT(second);
+
+    EXPECT_EQ(first.value().plannedTickets(), 2000u);
+    EXPECT_EQ(first.value().plannedTickets(), second.value().plannedTickets());
+    for (size_t i = 0; i < first.value().flights().size(); ++i) {
+        EXPECT_EQ(first.value().flights()[i].route, second.value().flights()[i].route);
+        EXPECT_EQ(first.value().ticketNumber(i, 1), second.value().ticketNumber(i, 1));
+    }
+
+    // Tuyến hạng nhất có trọng số lớn hơn hẳn tuyến ở giữa bảng xếp hạng
+    const auto& routes = first.value().routes();
+    EXPECT_GT(routes.front().weight, 50 * routes[routes.size() / 2].weight);
+
+    // Vé không vượt sức chứa và khóa nghiệp vụ đúng định dạng value object
+    for (size_t i = 0; i < first.value().flights().size(); ++i) {
+        const auto& model = first.value().aircraftModelOf(first.value().flights()[i].aircraft);
+        EXPECT_LE(first.value().flights()[i].ticketCount, model.economySeats + model.businessSeats + model.firstSeats);
+        EXPECT_TRUE(FlightNumber::create(first.value().flightNumber(i)).has_value()) << first.value().flightNumber(i);
+    }
+    EXPECT_TRUE(FlightNumber::create(first.value().flightNumber(9999)).has_value());
+    EXPECT_TRUE(PassportNumber::create(first.value().passportNumber(7)).has_value());
+    EXPECT_TRUE(TicketNumber::create(first.value().ticketNumber(0, 12)).has_value());
+    EXPECT_TRUE(AircraftSerial::create(first.value().aircraftSerial(5)).has_value());
+
+    auto invalid = smallConfig();
+    invalid.startDate = "2024-02-30";
+    EXPECT_FALSE(SyntheticDataset::create(invalid).has_value());
+}
+
+TEST_F(LoadGeneratorTest, ScriptSinkBatchesRows) {
+    auto config = smallConfig();
+    auto dataset = SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+
+    std::ostringstream script;
+    SqlScriptSink sink(script, 5);
+    DataGenerator generator(dataset.value(), 100);
+    auto summary = generator.generate(sink);
+    ASSERT_RESULT(summary);
+
+    std::string text = script.str();
+    size_t statements = 0;
+    for (size_t pos = text.find("INSERT INTO ticket "); pos != std::string::npos; pos = text.find("INSERT INTO ticket ", pos + 1)) {
+        ++statements;
+    }
+    EXPECT_EQ(statements, 20u);   // 2000 vé, 100 hàng mỗi câu
+    EXPECT_EQ(text.rfind("SET autocommit = 0;", 0), 0u);
+    EXPECT_NE(text.find("SET foreign_key_checks = 1;"), std::string::npos);
+}
+
+TEST_F(LoadGeneratorTest, GeneratedDataLoadsThroughRepositories) {
+    auto dataset = SyntheticDataset::create(smallConfig());
+    ASSERT_RESULT(dataset);
+
+    auto db = std::make_shared<InMemoryConnection>();
+    ConnectionSink sink(db);
+    DataGenerator generator(dataset.value(), 64);
+    auto summary = generator.generate(sink);
+    ASSERT_RESULT(summary) << summary.error().message;
+
+    EXPECT_EQ(count(db, "aircraft"), 6);
+    EXPECT_EQ(count(db, "passenger"), 300);
+    EXPECT_EQ(count(db, "flight"), 80);
+    EXPECT_EQ(count(db, "ticket"), 2000);
+    EXPECT_EQ(count(db, "flight_seat_availability"), static_cast<int64_t>(summary.value().seatAvailability));
+
+    auto passengerRepository = std::make_shared<PassengerRepository>(db, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(db, nullptr);
+    TicketRepository ticketRepository(db, passengerRepository, flightRepository, nullptr);
+
+    // Chuyến bay phổ biến nhất có nhiều vé nhất trong dữ liệu được nạp
+    const auto& flights = dataset.value().flights();
+    size_t busiest = std::max_element(flights.begin(), flights.end(), [](const auto& a, const auto& b) {
+        return a.ticketCount < b.ticketCount;
+    }) - flights.begin();
+    auto flight = flightRepository->findByFlightNumber(FlightNumber::create(dataset.value().flightNumber(busiest)).value());
+    ASSERT_RESULT(flight);
+    auto ticket = ticketRepository.findByTicketNumber(
+        TicketNumber::create(dataset.value().ticketNumber(busiest, 1)).value());
+    ASSERT_RESULT(ticket) << ticket.error().message;
+    EXPECT_EQ(ticket.value().getFlight()->getId(), flight.value().getId());
+}
+
+TEST_F(LoadGeneratorTest, DriverRunsMixedWorkload) {
+    auto dataset = SyntheticDataset::create(smallConfig());
+    ASSERT_RESULT(dataset);
+    auto db = std::make_shared<InMemoryConnection>();
+    ConnectionSink sink(db);
+    ASSERT_RESULT(DataGenerator(dataset.value()).generate(sink));
+
+    auto factory = [db]() {
+        auto passengerRepository = std::make_shared<PassengerRepository>(db, nullptr);
+        auto aircraftRepository = std::make_shared<AircraftRepository>(db, nullptr);
+        auto flightRepository = std::make_shared<FlightRepository>(db, nullptr);
+        auto ticketRepository = std::make_shared<TicketRepository>(db, passengerRepository, flightRepository, nullptr);
+        return DriverServices{
+            std::make_shared<TicketService>(ticketRepository, passengerRepository, flightRepository, aircraftRepository, nullptr),
+            std::make_shared<FlightService>(flightRepository, aircraftRepository, ticketRepository, nullptr)
+        };
+    };
+
+    LoadDriverConfig config;
+    config.threads = 3;
+    config.operationsPerThread = 40;
+    auto mix = WorkloadMix::parse("book=40,cancel=20,search=20,checkin=20");
+    ASSERT_RESULT(mix);
+    config.mix = mix.value();
+
+    auto report = LoadDriver(dataset.value(), factory, config).run();
+    ASSERT_RESULT(report);
+    EXPECT_EQ(report.value().totalOperations(), 120u);
+    EXPECT_GT(report.value().throughput(), 0.0);
+    for (const auto& operation : report.value().operations) {
+        EXPECT_EQ(operation.latencyNanos.count(), operation.total());
+    }
+    EXPECT_GT(report.value().operations[static_cast<size_t>(Operation::BOOK)].succeeded, 0u);
+    EXPECT_GT(report.value().operations[static_cast<size_t>(Operation::SEARCH)].succeeded, 0u);
+
+    std::ostringstream out;
+    report.value().print(out);
+    EXPECT_NE(out.str().find("p99.9"), std::string::npos);
+
+    EXPECT_FALSE(WorkloadMix::parse("book=1,fly=2").has_value());
+}
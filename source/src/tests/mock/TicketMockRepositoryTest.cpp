@@ -245,3 +245,35 @@ TEST_F(TicketMockRepositoryTest, FindBySerialNumber)
         EXPECT_EQ(t.getFlight()->getAircraft()->getSerial(), serial);
     }
 }
+
+TEST_F(TicketMockRepositoryTest, CountActiveBookingsInParallel)
+{
+    // Hành khách 1: hai vé đang hoạt động; 2: một vé hoạt động, một vé đã hủy; 3: chỉ có vé đã hoàn tiền
+    std::vector<std::pair<int, TicketStatus>> bookings = {
+        {1, TicketStatus::CONFIRMED}, {1, TicketStatus::PENDING},
+        {2, TicketStatus::CHECKED_IN}, {2, TicketStatus::CANCELLED},
+        {3, TicketStatus::REFUNDED}};
+    for (const auto &[passengerId, status] : bookings)
+    {
+        auto owner = std::make_shared<Passenger>(*passenger);
+        owner->setId(passengerId);
+        auto ticketResult = Ticket::create(ticketNumber, owner, flight, seatNumber, price);
+        ASSERT_TRUE(ticketResult.has_value());
+        auto createResult = repository->create(ticketResult.value());
+        ASSERT_TRUE(createResult.has_value());
+        repository->getTickets().at(createResult.value().getId())->setStatus(status);
+    }
+
+    // Hành khách có nhiều vé đang hoạt động chỉ được đếm một lần
+    PassengerStatistics statistics;
+    auto countResult = repository->countActiveBookings(statistics);
+    ASSERT_TRUE(countResult.has_value());
+    EXPECT_EQ(countResult.value(), 2u);
+    EXPECT_EQ(statistics.passengersWithActiveBookings, 2u);
+    EXPECT_EQ(statistics.activeTickets, 3u);
+
+    repository->clear();
+    PassengerStatistics empty;
+    EXPECT_EQ(repository->countActiveBookings(empty).value(), 0u);
+    EXPECT_EQ(empty.activeTickets, 0u);
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+#include "../../reporting/ReferenceSnapshot.h"
+#include "../../app/ApplicationContext.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../loadgen/DataGenerator.h"
+#include "../../reporting/SalesReport.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Reporting;
+
+namespace {
+    class ReferenceSnapshotTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            db = std::make_shared<InMemoryConnection>();
+            context = std::make_unique<ApplicationContext>(db, nullptr);
+            LoadGen::GeneratorConfig config;
+            config.aircraftCount = 3;
+            config.flightCount = 40;
+            config.passengerCount = 100;
+            config.ticketCount = 600;
+            config.startDate = "2024-01-01";
+            config.days = 4;
+            auto dataset = LoadGen::SyntheticDataset::create(config);
+            ASSERT_RESULT(dataset);
+            LoadGen::ConnectionSink sink(db);
+            ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+            path = (std::filesystem::temp_directory_path() /
+                    ("reference_" + std::to_string(::getpid()) + ".snapshot")).string();
+            std::filesystem::remove(path);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove(path);
+        }
+
+        Result<ReferenceData> open(TopUpStats& stats) {
+            // Lô nhỏ để nạp phải đi qua nhiều trang
+            return openReferenceData(path, *context->aircraftRepository(), *context->flightRepository(),
+                                     *context->ticketRepository(), &stats, 7);
+        }
+
+        Result<ReferenceData> loadFresh() {
+            return ReferenceData::load(*context->aircraftRepository(), *context->flightRepository(),
+                                       *context->ticketRepository(), 1000);
+        }
+
+        void expectSame(const ReferenceData& actual, const ReferenceData& expected) {
+            EXPECT_TRUE(actual.marks == expected.marks);
+            EXPECT_EQ(actual.flightVersions, expected.flightVersions);
+            ASSERT_EQ(actual.aircraft.size(), expected.aircraft.size());
+            for (size_t i = 0; i < expected.aircraft.size(); ++i) {
+                EXPECT_EQ(actual.aircraft[i].id, expected.aircraft[i].id);
+                EXPECT_EQ(actual.aircraft[i].serial, expected.aircraft[i].serial);
+                EXPECT_EQ(actual.aircraft[i].model, expected.aircraft[i].model);
+                EXPECT_EQ(actual.aircraft[i].totalSeats(), expected.aircraft[i].totalSeats());
+            }
+            ASSERT_EQ(actual.flights.size(), expected.flights.size());
+            for (size_t i = 0; i < expected.flights.size(); ++i) {
+                const auto& a = actual.flights[i];
+                const auto& e = expected.flights[i];
+                EXPECT_EQ(a.id, e.id);
+                EXPECT_EQ(a.flightNumber, e.flightNumber) << e.id;
+                EXPECT_EQ(a.departureCode, e.departureCode) << e.id;
+                EXPECT_EQ(a.departureName, e.departureName) << e.id;
+                EXPECT_EQ(a.arrivalCode, e.arrivalCode) << e.id;
+                EXPECT_EQ(a.arrivalName, e.arrivalName) << e.id;
+                EXPECT_EQ(civilSeconds(a.departureTime), civilSeconds(e.departureTime)) << e.id;
+                EXPECT_EQ(civilSeconds(a.arrivalTime), civilSeconds(e.arrivalTime)) << e.id;
+                EXPECT_EQ(a.status, e.status) << e.id;
+                EXPECT_EQ(a.aircraftSerial, e.aircraftSerial) << e.id;
+                EXPECT_EQ(a.economySeats, e.economySeats) << e.id;
+                EXPECT_EQ(a.businessSeats, e.businessSeats) << e.id;
+                EXPECT_EQ(a.firstSeats, e.firstSeats) << e.id;
+                EXPECT_EQ(a.bookedEconomy, e.bookedEconomy) << e.id;
+                EXPECT_EQ(a.bookedBusiness, e.bookedBusiness) << e.id;
+                EXPECT_EQ(a.bookedFirst, e.bookedFirst) << e.id;
+            }
+        }
+
+        void overwriteByte(size_t offset, char value) {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.put(value);
+        }
+
+        std::shared_ptr<InMemoryConnection> db;
+        std::unique_ptr<ApplicationContext> context;
+        std::string path;
+    };
+}
+
+TEST_F(ReferenceSnapshotTest, RoundTripsThroughFileAndSkipsUnchangedTables) {
+    TopUpStats stats;
+    auto first = open(stats);
+    ASSERT_RESULT(first);
+    EXPECT_TRUE(stats.fullLoad);
+    EXPECT_EQ(first.value().flights.size(), 40u);
+    EXPECT_EQ(first.value().marks.tickets.count, 600);
+    ASSERT_TRUE(std::filesystem::exists(path));
+
+    auto fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    expectSame(first.value(), fresh.value());
+
+    auto read = ReferenceData::read(path);
+    ASSERT_RESULT(read);
+    expectSame(read.value(), fresh.value());
+    ASSERT_NE(read.value().findFlight(fresh.value().flights[5].id), nullptr);
+    EXPECT_EQ(read.value().findFlight(fresh.value().flights[5].id)->flightNumber, fresh.value().flights[5].flightNumber);
+    EXPECT_EQ(read.value().findFlight(-1), nullptr);
+
+    // Không có gì đổi: không nạp lại hàng nào, không ghi lại tệp
+    auto before = std::filesystem::last_write_time(path);
+    auto again = open(stats);
+    ASSERT_RESULT(again);
+    EXPECT_FALSE(stats.changed());
+    EXPECT_FALSE(stats.aircraftChanged);
+    EXPECT_EQ(stats.flightsLoaded, 0u);
+    EXPECT_EQ(stats.occupancyFlights, 0u);
+    EXPECT_EQ(std::filesystem::last_write_time(path), before);
+    expectSame(again.value(), fresh.value());
+}
+
+TEST_F(ReferenceSnapshotTest, TopUpMatchesFreshLoadAfterEachKindOfChange) {
+    TopUpStats stats;
+    ASSERT_RESULT(open(stats));
+    auto original = loadFresh();
+    ASSERT_RESULT(original);
+    const FlightSummaryRow target = original.value().flights[3];
+
+    // Chỉ thêm hàng: nạp chuyến bay mới, đếm lại ghế của chuyến bay có vé mới
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO flight (flight_number, departure_code, departure_name, arrival_code, arrival_name, aircraft_id, "
+        "departure_time, arrival_time) VALUES ('VN9999', 'HAN', 'Noi Bai', 'SGN', 'Tan Son Nhat', 1, "
+        "'2024-02-01 08:00:00', '2024-02-01 10:00:00')"));
+    ASSERT_RESULT(db->execute(
+        "INSERT INTO ticket (ticket_number, flight_id, passenger_id, seat_number, price, currency) VALUES "
+        "('ZZ-APPENDED-1', " + std::to_string(target.id) + ", 1, 'B9', 100.0, 'VND')"));
+    auto appended = open(stats);
+    ASSERT_RESULT(appended);
+    EXPECT_FALSE(stats.fullLoad);
+    EXPECT_TRUE(stats.marksChanged);
+    EXPECT_EQ(stats.flightsLoaded, 1u);
+    EXPECT_EQ(stats.occupancyFlights, 2u);
+    auto fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    expectSame(appended.value(), fresh.value());
+    EXPECT_EQ(appended.value().findFlight(target.id)->bookedBusiness, target.bookedBusiness + 1);
+    EXPECT_EQ(appended.value().flights.back().flightNumber, "VN9999");
+
+    // Sửa tại chỗ và xóa vé: so version để tìm chuyến bay đã sửa, đếm lại ghế của cả bảng
+    ASSERT_RESULT(db->execute("UPDATE flight SET status = 'DELAYED', version = version + 1 WHERE id = " +
+                              std::to_string(target.id)));
+    ASSERT_RESULT(db->execute("DELETE FROM ticket WHERE ticket_number = 'ZZ-APPENDED-1'"));
+    auto modified = open(stats);
+    ASSERT_RESULT(modified);
+    EXPECT_FALSE(stats.fullLoad);
+    EXPECT_EQ(stats.flightsLoaded, 1u);
+    EXPECT_EQ(stats.occupancyFlights, 41u);
+    fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    expectSame(modified.value(), fresh.value());
+    EXPECT_EQ(modified.value().findFlight(target.id)->status, FlightStatus::DELAYED);
+
+    // Xóa chuyến bay
+    ASSERT_RESULT(db->execute("DELETE FROM flight WHERE flight_number = 'VN9999'"));
+    auto removed = open(stats);
+    ASSERT_RESULT(removed);
+    EXPECT_EQ(stats.flightsRemoved, 1u);
+    EXPECT_EQ(stats.flightsLoaded, 0u);
+    fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    expectSame(removed.value(), fresh.value());
+
+    // Bảng máy bay không có cột version: đổi nội dung thì nạp lại mọi chuyến bay
+    ASSERT_RESULT(db->execute("UPDATE aircraft SET model = 'Airbus A321neo' WHERE id = 1"));
+    auto aircraft = open(stats);
+    ASSERT_RESULT(aircraft);
+    EXPECT_TRUE(stats.aircraftChanged);
+    EXPECT_EQ(stats.flightsLoaded, 40u);
+    fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    expectSame(aircraft.value(), fresh.value());
+
+    // Tệp đã ghi lại khớp với lần nạp mới
+    auto read = ReferenceData::read(path);
+    ASSERT_RESULT(read);
+    expectSame(read.value(), fresh.value());
+}
+
+TEST_F(ReferenceSnapshotTest, DamagedFilesAreRejectedAndRebuilt) {
+    TopUpStats stats;
+    ASSERT_RESULT(open(stats));
+    auto fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+    const auto size = std::filesystem::file_size(path);
+
+    auto missing = ReferenceData::read(path + ".missing");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, "SNAPSHOT_IO");
+
+    // Một byte giữa phần dữ liệu bị đổi: sai tổng kiểm tra
+    overwriteByte(size / 2, '\x5a');
+    overwriteByte(size / 2 + 1, '\xa5');
+    auto corrupt = ReferenceData::read(path);
+    ASSERT_FALSE(corrupt.has_value());
+    EXPECT_EQ(corrupt.error().code, "SNAPSHOT_CORRUPT");
+
+    auto rebuilt = open(stats);
+    ASSERT_RESULT(rebuilt);
+    EXPECT_TRUE(stats.fullLoad);
+    expectSame(rebuilt.value(), fresh.value());
+    ASSERT_RESULT(ReferenceData::read(path));
+
+    // Phiên bản định dạng nằm ngay sau mã nhận dạng 8 byte
+    overwriteByte(8, static_cast<char>(ReferenceData::FORMAT_VERSION + 1));
+    auto version = ReferenceData::read(path);
+    ASSERT_FALSE(version.has_value());
+    EXPECT_EQ(version.error().code, "SNAPSHOT_VERSION");
+
+    overwriteByte(8, static_cast<char>(ReferenceData::FORMAT_VERSION));
+    ASSERT_RESULT(ReferenceData::read(path));
+    std::filesystem::resize_file(path, size - 3);
+    auto truncated = ReferenceData::read(path);
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(truncated.error().code, "SNAPSHOT_CORRUPT");
+
+    rebuilt = open(stats);
+    ASSERT_RESULT(rebuilt);
+    EXPECT_TRUE(stats.fullLoad);
+    EXPECT_EQ(std::filesystem::file_size(path), size);
+}
+
+TEST_F(ReferenceSnapshotTest, ConcurrentSavesLeaveOneCompleteFile) {
+    auto fresh = loadFresh();
+    ASSERT_RESULT(fresh);
+
+    std::vector<std::thread> writers;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 5; ++i) {
+                if (!fresh.value().save(path)) ++failures;
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    EXPECT_EQ(failures.load(), 0);
+
+    auto read = ReferenceData::read(path);
+    ASSERT_RESULT(read);
+    expectSame(read.value(), fresh.value());
+
+    // Không còn tệp tạm nào cạnh ảnh chụp
+    auto target = std::filesystem::path(path);
+    for (const auto& entry : std::filesystem::directory_iterator(target.parent_path())) {
+        auto name = entry.path().filename().string();
+        EXPECT_FALSE(name != target.filename().string() && name.starts_with(target.filename().string())) << name;
+    }
+
+    // Cùng dữ liệu cho cùng từng byte: đầu tệp không mang byte rác
+    auto copy = path + ".copy";
+    ASSERT_RESULT(fresh.value().save(copy));
+    auto bytes = [](const std::string& file) {
+        std::ifstream in(file, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    };
+    EXPECT_EQ(bytes(copy), bytes(path));
+    std::filesystem::remove(copy);
+}
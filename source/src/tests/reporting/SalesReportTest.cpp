@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "../../reporting/SalesReport.h"
+#include "../../app/ApplicationContext.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../loadgen/DataGenerator.h"
+#include <cmath>
+#include <map>
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Reporting;
+
+namespace {
+    bool sameLine(const RevenueLine& a, const RevenueLine& b) {
+        return a.key == b.key && a.revenue == b.revenue && a.ticketsSold == b.ticketsSold &&
+               a.cancelled == b.cancelled && a.refunded == b.refunded && a.seats == b.seats &&
+               a.bookedSeats == b.bookedSeats;
+    }
+}
+
+TEST(SalesReportTest, CivilDaysRoundTrip) {
+    EXPECT_EQ(civilDay(1970, 1, 1), 0);
+    EXPECT_EQ(civilDay(2000, 3, 1), 11017);
+    EXPECT_EQ(civilDay(1969, 12, 31), -1);
+    EXPECT_EQ(formatDay(civilDay(2024, 2, 29)), "2024-02-29");
+    EXPECT_EQ(civilDay(2024, 3, 1) - civilDay(2024, 2, 28), 2);
+    // Năm ngoài bốn chữ số không bị cắt cụt
+    EXPECT_EQ(formatDay(civilDay(45, 1, 2)), "0045-01-02");
+    EXPECT_EQ(formatDay(civilDay(5000000, 6, 1)), "5000000-06-01");
+
+    std::tm time{};
+    time.tm_year = 2024 - 1900;
+    time.tm_mon = 11;
+    time.tm_mday = 31;
+    time.tm_hour = 23;
+    EXPECT_EQ(formatDay(civilDay(time)), "2024-12-31");
+
+    ASSERT_RESULT(parseDay("2025-06-01"));
+    EXPECT_EQ(parseDay("2025-06-01").value(), civilDay(2025, 6, 1));
+    EXPECT_FALSE(parseDay("2023-02-29").has_value());
+    EXPECT_FALSE(parseDay("2025-6-1").has_value());
+    EXPECT_FALSE(parseDay("2025-06-01x").has_value());
+}
+
+TEST(SalesReportTest, AggregatesMatchRowByRowTotals) {
+    auto db = std::make_shared<InMemoryConnection>();
+    ApplicationContext context(db, nullptr);
+    LoadGen::GeneratorConfig config;
+    config.aircraftCount = 4;
+    config.flightCount = 40;
+    config.passengerCount = 200;
+    config.ticketCount = 2000;
+    config.startDate = "2024-01-01";
+    config.days = 5;
+    auto dataset = LoadGen::SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+    LoadGen::ConnectionSink sink(db);
+    ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+    // Lô nhỏ để nạp phải đi qua nhiều trang
+    auto columns = ReportColumns::load(*context.flightRepository(), *context.ticketRepository(), 7);
+    ASSERT_RESULT(columns);
+
+    std::vector<FlightSummaryRow> flights;
+    ASSERT_RESULT(context.flightService()->getFlightSummaries(flights));
+    std::vector<TicketListRow> tickets;
+    ASSERT_RESULT(context.ticketService()->getTicketListRows(tickets));
+    ASSERT_EQ(columns.value().flights.size(), flights.size());
+    ASSERT_EQ(columns.value().tickets.size(), tickets.size());
+
+    // Cách tính trực tiếp trên read model, chỉ lấy chuyến bay khởi hành trong hai ngày đầu
+    const int32_t from = civilDay(2024, 1, 1);
+    const int32_t to = civilDay(2024, 1, 2);
+    std::map<int, const FlightSummaryRow*> inPeriod;
+    uint64_t seats = 0;
+    for (const auto& flight : flights) {
+        int32_t day = civilDay(flight.departureTime);
+        if (day < from || day > to) continue;
+        inPeriod[flight.id] = &flight;
+        if (flight.status != FlightStatus::CANCELLED) seats += flight.totalSeats();
+    }
+    ASSERT_FALSE(inPeriod.empty());
+    ASSERT_LT(inPeriod.size(), flights.size());
+
+    std::map<std::string, double> revenue;
+    std::map<int, uint64_t> soldByFlight;
+    uint64_t sold = 0, cancelled = 0, refunded = 0, booked = 0;
+    for (const auto& ticket : tickets) {
+        auto flight = inPeriod.find(ticket.flightId);
+        if (flight == inPeriod.end()) continue;
+        if (ticket.status == TicketStatus::CANCELLED) { ++cancelled; continue; }
+        if (ticket.status == TicketStatus::REFUNDED) { ++refunded; continue; }
+        ++sold;
+        ++soldByFlight[ticket.flightId];
+        revenue[ticket.currency] += ticket.price;
+        if (flight->second->status != FlightStatus::CANCELLED) ++booked;
+    }
+
+    ReportOptions options;
+    options.fromDay = from;
+    options.toDay = to;
+    SalesReport report = buildSalesReport(columns.value(), options);
+
+    EXPECT_EQ(report.flights.size(), inPeriod.size());
+    EXPECT_EQ(report.fromDay, from);
+    EXPECT_EQ(report.toDay, to);
+    EXPECT_EQ(report.days.size(), 2u);
+    EXPECT_EQ(report.total.ticketsSold, sold);
+    EXPECT_EQ(report.total.cancelled, cancelled);
+    EXPECT_EQ(report.total.refunded, refunded);
+    EXPECT_EQ(report.total.seats, seats);
+    EXPECT_EQ(report.total.bookedSeats, booked);
+    for (const auto& [currency, amount] : revenue) {
+        EXPECT_NEAR(report.revenueOf(report.total, currency), amount, 0.01) << currency;
+    }
+    for (const auto& line : report.flights) {
+        auto flight = std::find_if(flights.begin(), flights.end(),
+                                   [&](const FlightSummaryRow& row) { return row.flightNumber == line.key; });
+        ASSERT_NE(flight, flights.end());
+        EXPECT_EQ(line.ticketsSold, soldByFlight[flight->id]) << line.key;
+    }
+
+    // Các cuộn lên cộng lại đúng bằng tổng
+    RevenueLine byRoute, byDay;
+    for (const auto& line : report.routes) byRoute.add(line);
+    for (const auto& line : report.days) byDay.add(line);
+    EXPECT_EQ(byRoute.revenue, report.total.revenue);
+    EXPECT_EQ(byDay.ticketsSold, report.total.ticketsSold);
+    EXPECT_EQ(byDay.seats, report.total.seats);
+    uint64_t classSeats = 0, classBooked = 0;
+    for (const auto& load : report.seatClasses) {
+        classSeats += load.seats;
+        classBooked += load.bookedSeats;
+    }
+    EXPECT_EQ(classSeats, report.total.seats);
+    EXPECT_EQ(classBooked, report.total.bookedSeats);
+    EXPECT_GT(report.total.loadFactor(), 0.0);
+
+    std::ostringstream printed;
+    report.print(printed, 3);
+    EXPECT_NE(printed.str().find("Load factor"), std::string::npos);
+    EXPECT_NE(printed.str().find("Top 3 flights"), std::string::npos);
+
+    options.fromDay = civilDay(2030, 1, 1);
+    options.toDay = civilDay(2030, 1, 31);
+    SalesReport empty = buildSalesReport(columns.value(), options);
+    EXPECT_TRUE(empty.flights.empty());
+    EXPECT_EQ(empty.total.tickets(), 0u);
+}
+
+TEST(SalesReportTest, ThreadCountDoesNotChangeResults) {
+    ReportColumns columns;
+    const char* codes[] = {"HAN", "SGN", "DAD", "PQC"};
+    for (int id = 1; id <= 500; ++id) {
+        FlightSummaryRow flight;
+        flight.id = id * 3;     // id thưa vẫn tra được hàng
+        flight.flightNumber = "VN" + std::to_string(id);
+        flight.departureCode = codes[id % 4];
+        flight.arrivalCode = codes[(id + 1) % 4];
+        flight.departureTime.tm_year = 2025 - 1900;
+        flight.departureTime.tm_mon = 4;
+        flight.departureTime.tm_mday = 1 + id % 31;
+        flight.status = id % 50 == 0 ? FlightStatus::CANCELLED : FlightStatus::SCHEDULED;
+        flight.economySeats = 180;
+        flight.businessSeats = 20;
+        flight.firstSeats = id % 2 ? 8 : 0;
+        ASSERT_RESULT(columns.upsertFlight(flight));
+    }
+
+    const char* seatClasses = "EEEEBFX";
+    const char* currencies[] = {"VND", "USD"};
+    for (int id = 1; id <= 400000; ++id) {
+        TicketFactRow ticket;
+        ticket.id = id;
+        ticket.flightId = (id % 503 + 1) * 3;      // vài vé trỏ tới chuyến bay không có
+        ticket.seatClass = seatClasses[id % 7];
+        ticket.price = 100.0 + (id % 977) * 0.37;
+        ticket.currency = currencies[id % 9 == 0];
+        ticket.status = static_cast<TicketStatus>(id % 7);
+        ASSERT_RESULT(columns.upsertTicket(ticket));
+    }
+    EXPECT_EQ(columns.tickets.flightRow[500], NO_FLIGHT);
+
+    ReportOptions options;
+    options.threads = 1;
+    SalesReport single = buildSalesReport(columns, options);
+    for (size_t threads : {2u, 3u, 6u}) {
+        options.threads = threads;
+        SalesReport parallel = buildSalesReport(columns, options);
+        EXPECT_TRUE(sameLine(parallel.total, single.total)) << threads;
+        ASSERT_EQ(parallel.flights.size(), single.flights.size());
+        for (size_t i = 0; i < single.flights.size(); ++i) {
+            EXPECT_TRUE(sameLine(parallel.flights[i], single.flights[i])) << threads << " " << single.flights[i].key;
+        }
+        EXPECT_EQ(parallel.ticketsByStatus, single.ticketsByStatus);
+    }
+
+    // Mỗi trạng thái chiếm 1/7 số vé; vé trỏ tới chuyến bay không có bị loại
+    uint64_t counted = single.total.tickets();
+    EXPECT_LT(counted, 400000u);
+    EXPECT_NEAR(single.total.cancellationRate(), 1.0 / 7, 0.01);
+    EXPECT_NEAR(single.total.refundRate(), 1.0 / 7, 0.01);
+    EXPECT_EQ(single.routes.size(), 4u);
+    EXPECT_EQ(single.days.size(), 31u);
+    EXPECT_GT(single.seatClasses[2].seats, 0u);
+}
@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include "../../reporting/Snapshot.h"
+#include "../../app/ApplicationContext.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../loadgen/DataGenerator.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Reporting;
+
+namespace {
+    FlightSummaryRow flightRow(int id, const char* from, const char* to, int day) {
+        FlightSummaryRow row;
+        row.id = id;
+        row.flightNumber = "VN" + std::to_string(id);
+        row.departureCode = from;
+        row.arrivalCode = to;
+        row.departureTime.tm_year = 2025 - 1900;
+        row.departureTime.tm_mday = day;
+        row.departureTime.tm_hour = 8;
+        row.arrivalTime = row.departureTime;
+        row.arrivalTime.tm_hour = 10;
+        row.economySeats = 100;
+        return row;
+    }
+
+    TicketFactRow ticketRow(int id, int flightId, double price) {
+        TicketFactRow row;
+        row.id = id;
+        row.passengerId = id % 2 + 1;
+        row.flightId = flightId;
+        row.seatClass = 'E';
+        row.price = price;
+        row.currency = "VND";
+        row.status = TicketStatus::CONFIRMED;
+        return row;
+    }
+}
+
+TEST(SnapshotTest, RowIndexStaysCorrectAcrossDenseAndSparseIds) {
+    RowIndex index;
+    for (int id = 1; id <= 100; ++id) index.set(id, static_cast<uint32_t>(id - 1));
+    EXPECT_EQ(index.find(42), 41u);
+    EXPECT_EQ(index.find(0), NO_ROW);
+    EXPECT_EQ(index.find(1000), NO_ROW);
+
+    index.erase(42);
+    EXPECT_EQ(index.find(42), NO_ROW);
+    EXPECT_EQ(index.size(), 99u);
+
+    // Id quá xa làm chỉ mục chuyển sang bảng băm mà không mất hàng cũ
+    index.set(2000000000, 7);
+    index.set(-5, 8);
+    EXPECT_EQ(index.find(2000000000), 7u);
+    EXPECT_EQ(index.find(-5), 8u);
+    EXPECT_EQ(index.find(100), 99u);
+    EXPECT_EQ(index.size(), 101u);
+}
+
+TEST(SnapshotTest, UpsertAndRemoveKeepColumnsConsistent) {
+    ReportColumns columns;
+    ASSERT_RESULT(columns.upsertFlight(flightRow(1, "HAN", "SGN", 1)));
+    ASSERT_RESULT(columns.upsertFlight(flightRow(2, "SGN", "HAN", 2)));
+    ASSERT_RESULT(columns.upsertFlight(flightRow(3, "HAN", "DAD", 3)));
+    for (int id = 1; id <= 6; ++id) ASSERT_RESULT(columns.upsertTicket(ticketRow(id, (id - 1) % 3 + 1, 10.0 * id)));
+
+    EXPECT_EQ(columns.flights.airports.size(), 3u);
+    EXPECT_EQ(columns.flights.departureTime[0], civilSeconds(flightRow(1, "HAN", "SGN", 1).departureTime));
+    EXPECT_EQ(columns.flights.departureDay[0], civilDay(2025, 1, 1));
+    EXPECT_EQ(columns.flights.arrivalTime[0] - columns.flights.departureTime[0], 2 * 3600);
+
+    // Ghi đè tại chỗ
+    auto moved = ticketRow(2, 3, 99.5);
+    moved.status = TicketStatus::REFUNDED;
+    auto updated = columns.upsertTicket(moved);
+    ASSERT_RESULT(updated);
+    EXPECT_FALSE(updated.value());
+    EXPECT_EQ(columns.tickets.size(), 6u);
+    uint32_t row = columns.tickets.rowOf(2);
+    EXPECT_EQ(columns.tickets.flightRow[row], columns.flights.rowOf(3));
+    EXPECT_EQ(columns.tickets.price[row], 9950);
+
+    // Xóa chuyến bay 1: chuyến bay 3 (cuối bảng) chuyển vào hàng của nó, vé được chỉnh theo
+    EXPECT_TRUE(columns.removeFlight(1));
+    EXPECT_FALSE(columns.removeFlight(1));
+    EXPECT_EQ(columns.flights.size(), 2u);
+    EXPECT_EQ(columns.flights.rowOf(3), 0u);
+    EXPECT_EQ(columns.flights.flightNumber[0], "VN3");
+    for (int id : {1, 4}) EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(id)], NO_FLIGHT) << id;
+    for (int id : {2, 3, 6}) EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(id)], 0u) << id;
+    EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(5)], columns.flights.rowOf(2));
+
+    EXPECT_TRUE(columns.removeTicket(1));
+    EXPECT_EQ(columns.tickets.size(), 5u);
+    EXPECT_EQ(columns.tickets.rowOf(1), NO_ROW);
+    EXPECT_EQ(columns.tickets.id[columns.tickets.rowOf(6)], 6);
+    EXPECT_EQ(columns.tickets.id.size(), columns.tickets.currency.size());
+}
+
+TEST(SnapshotTest, UnlinkedTicketsAreRelinkedWhenTheirFlightAppears) {
+    ReportColumns columns;
+    ASSERT_RESULT(columns.upsertFlight(flightRow(1, "HAN", "SGN", 1)));
+    // Vé 2..5 nạp trước chuyến bay 7 của chúng (chuyến bay tạo giữa lượt nạp chuyến bay và lượt nạp vé)
+    ASSERT_RESULT(columns.upsertTicket(ticketRow(1, 1, 10.0)));
+    for (int id = 2; id <= 5; ++id) ASSERT_RESULT(columns.upsertTicket(ticketRow(id, 7, 10.0)));
+    for (int id = 2; id <= 5; ++id) EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(id)], NO_FLIGHT) << id;
+
+    // Xóa vé 2 (vé 5 cuối bảng chuyển vào hàng của nó), vé 3 chuyển sang chuyến bay đã có
+    EXPECT_TRUE(columns.removeTicket(2));
+    ASSERT_RESULT(columns.upsertTicket(ticketRow(3, 1, 10.0)));
+    ASSERT_EQ(columns.tickets.unlinked.size(), 1u);
+    EXPECT_EQ(columns.tickets.unlinked.at(7).size(), 2u);
+
+    ASSERT_RESULT(columns.upsertFlight(flightRow(7, "HAN", "DAD", 2)));
+    uint32_t flight = columns.flights.rowOf(7);
+    for (int id : {4, 5}) EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(id)], flight) << id;
+    EXPECT_EQ(columns.flights.ticketRows[flight].size(), 2u);
+    EXPECT_EQ(columns.flights.ticketRows[columns.flights.rowOf(1)].size(), 2u);
+    EXPECT_TRUE(columns.tickets.unlinked.empty());
+
+    // Chuyến bay bị xóa rồi xuất hiện lại với cùng id: vé của nó được gắn lại
+    EXPECT_TRUE(columns.removeFlight(7));
+    EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(4)], NO_FLIGHT);
+    ASSERT_RESULT(columns.upsertFlight(flightRow(7, "HAN", "DAD", 2)));
+    flight = columns.flights.rowOf(7);
+    for (int id : {4, 5}) EXPECT_EQ(columns.tickets.flightRow[columns.tickets.rowOf(id)], flight) << id;
+    EXPECT_TRUE(columns.tickets.unlinked.empty());
+    EXPECT_EQ(buildSalesReport(columns).total.bookedSeats, 4u);
+}
+
+TEST(SnapshotTest, FlightRemovalTouchesOnlyItsTickets) {
+    ReportColumns columns;
+    for (int id = 1; id <= 50; ++id) ASSERT_RESULT(columns.upsertFlight(flightRow(id, "HAN", "SGN", id % 28 + 1)));
+    std::map<int, int> flightOfTicket;
+    for (int id = 1; id <= 2000; ++id) {
+        int flightId = id % 50 + 1;
+        ASSERT_RESULT(columns.upsertTicket(ticketRow(id, flightId, 10.0)));
+        flightOfTicket[id] = flightId;
+    }
+
+    // Trộn lẫn chuyển vé sang chuyến bay khác, xóa vé và xóa chuyến bay
+    std::set<int> removedFlights;
+    for (int step = 1; step <= 600; ++step) {
+        int ticketId = step * 7 % 2000 + 1;
+        if (step % 3 == 0) {
+            if (columns.removeTicket(ticketId)) flightOfTicket.erase(ticketId);
+        } else if (flightOfTicket.contains(ticketId)) {
+            int flightId = step * 13 % 50 + 1;
+            ASSERT_RESULT(columns.upsertTicket(ticketRow(ticketId, flightId, 10.0)));
+            flightOfTicket[ticketId] = removedFlights.contains(flightId) ? 0 : flightId;
+        }
+        if (step % 20 == 0) {
+            int flightId = step / 20 * 11 % 50 + 1;
+            if (columns.removeFlight(flightId)) removedFlights.insert(flightId);
+            for (auto& [ticket, flight] : flightOfTicket) {
+                if (flight == flightId) flight = 0;
+            }
+        }
+    }
+
+    ASSERT_EQ(columns.tickets.size(), flightOfTicket.size());
+    ASSERT_EQ(columns.flights.ticketRows.size(), columns.flights.size());
+    for (const auto& [ticketId, flightId] : flightOfTicket) {
+        uint32_t row = columns.tickets.rowOf(ticketId);
+        ASSERT_NE(row, NO_ROW) << ticketId;
+        uint32_t flight = columns.tickets.flightRow[row];
+        if (flightId == 0) {
+            EXPECT_EQ(flight, NO_FLIGHT) << ticketId;
+            continue;
+        }
+        ASSERT_NE(flight, NO_FLIGHT) << ticketId;
+        EXPECT_EQ(columns.flights.id[flight], flightId) << ticketId;
+        const auto& rows = columns.flights.ticketRows[flight];
+        EXPECT_EQ(std::count(rows.begin(), rows.end(), row), 1) << ticketId;
+    }
+    size_t linked = 0;
+    for (const auto& rows : columns.flights.ticketRows) linked += rows.size();
+    EXPECT_EQ(linked, static_cast<size_t>(std::count_if(flightOfTicket.begin(), flightOfTicket.end(),
+                                                        [](const auto& entry) { return entry.second != 0; })));
+    // Mọi vé NO_FLIGHT chờ đúng một lần trong danh sách của chuyến bay của nó
+    size_t waiting = 0;
+    for (const auto& [flightId, rows] : columns.tickets.unlinked) {
+        for (uint32_t row : rows) EXPECT_EQ(columns.tickets.flightId[row], flightId);
+        waiting += rows.size();
+    }
+    EXPECT_EQ(waiting, flightOfTicket.size() - linked);
+}
+
+TEST(SnapshotTest, FollowsRepositoryWritesThroughChangeFeed) {
+    auto db = std::make_shared<InMemoryConnection>();
+    ApplicationContext context(db, nullptr);
+    LoadGen::GeneratorConfig config;
+    config.aircraftCount = 3;
+    config.flightCount = 30;
+    config.passengerCount = 80;
+    config.ticketCount = 500;
+    config.startDate = "2024-01-01";
+    config.days = 4;
+    auto dataset = LoadGen::SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+    LoadGen::ConnectionSink sink(db);
+    ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+    auto& flights = *context.flightRepository();
+    auto& tickets = *context.ticketRepository();
+    auto& passengers = *context.passengerRepository();
+
+    // Lô nhỏ để lần nạp đầu phải đi qua nhiều trang
+    Snapshot snapshot(Changes::Feed::getInstance(), 7);
+    auto loaded = snapshot.refresh(flights, tickets, passengers);
+    ASSERT_RESULT(loaded);
+    size_t ticketCount = snapshot.read([](const ReportColumns& columns) { return columns.tickets.size(); });
+    EXPECT_EQ(loaded.value(), 30u + 80u + ticketCount);
+    EXPECT_EQ(snapshot.pendingChanges(), 0u);
+
+    // Ghi qua service: xóa một vé, quét trạng thái (sửa nhiều chuyến bay và vé), thêm hành khách
+    std::vector<TicketListRow> listRows;
+    ASSERT_RESULT(context.ticketService()->getTicketListRows(listRows));
+    ASSERT_RESULT(context.ticketService()->deleteTicket(TicketNumber::create(listRows.front().ticketNumber).value()));
+
+    std::tm later{};
+    later.tm_year = 2030 - 1900;
+    later.tm_mday = 1;
+    later.tm_isdst = -1;
+    auto sweep = Cli::sweepStatuses(context, std::mktime(&later), false);
+    ASSERT_RESULT(sweep);
+    ASSERT_GT(sweep.value().ticketsCompleted, 0u);
+
+    std::istringstream more("name,passport,email,phone,address\n"
+                            "Nguyen Minh Duc,VN:111222333,e@example.com,0901234567,Hue\n");
+    ASSERT_RESULT(Cli::importTable(context, "passengers", more));
+    EXPECT_GT(snapshot.pendingChanges(), 0u);
+
+    // Trước refresh ảnh chụp vẫn là trạng thái cũ
+    EXPECT_EQ(snapshot.salesReport().ticketsByStatus[static_cast<size_t>(TicketStatus::COMPLETED)], 0u);
+
+    ASSERT_RESULT(snapshot.refresh(flights, tickets, passengers));
+    EXPECT_EQ(snapshot.pendingChanges(), 0u);
+
+    // Ảnh chụp sau khi áp dụng thay đổi giống hệt một lần nạp mới
+    auto fresh = ReportColumns::load(flights, tickets, 1000);
+    ASSERT_RESULT(fresh);
+    ASSERT_RESULT(fresh.value().loadPassengers(passengers));
+    ReportOptions options;
+    options.threads = 1;
+    SalesReport expected = buildSalesReport(fresh.value(), options);
+    SalesReport actual = snapshot.salesReport(options);
+    EXPECT_EQ(actual.ticketsByStatus, expected.ticketsByStatus);
+    EXPECT_EQ(actual.total.revenue, expected.total.revenue);
+    EXPECT_EQ(actual.total.ticketsSold, expected.total.ticketsSold);
+    EXPECT_EQ(actual.total.bookedSeats, expected.total.bookedSeats);
+    EXPECT_EQ(actual.ticketsByStatus[static_cast<size_t>(TicketStatus::COMPLETED)], sweep.value().ticketsCompleted);
+    snapshot.read([&](const ReportColumns& columns) {
+        EXPECT_EQ(columns.tickets.size(), fresh.value().tickets.size());
+        EXPECT_EQ(columns.tickets.rowOf(listRows.front().id), NO_ROW);
+        EXPECT_EQ(columns.passengers.size(), 81u);
+        EXPECT_EQ(columns.passengers.name.back(), "Nguyen Minh Duc");
+        return 0;
+    });
+
+    // Tìm kiếm trên ảnh chụp khớp với read model
+    const TicketListRow& sample = listRows.back();
+    auto passenger = context.passengerService()->getPassenger(PassportNumber::create(sample.passportNumber).value());
+    ASSERT_RESULT(passenger);
+    auto ticketIds = snapshot.findTicketsOfPassenger(passenger.value().getId());
+    size_t expectedTickets = std::count_if(listRows.begin() + 1, listRows.end(), [&](const TicketListRow& row) {
+        return row.passportNumber == sample.passportNumber;
+    });
+    EXPECT_EQ(ticketIds.size(), expectedTickets);
+    EXPECT_TRUE(std::is_sorted(ticketIds.begin(), ticketIds.end()));
+
+    std::vector<FlightSummaryRow> summaries;
+    ASSERT_RESULT(context.flightService()->getFlightSummaries(summaries));
+    FlightQuery query;
+    query.departureCode = summaries.front().departureCode;
+    query.includeCancelled = true;
+    auto flightIds = snapshot.findFlights(query);
+    size_t fromAirport = std::count_if(summaries.begin(), summaries.end(), [&](const FlightSummaryRow& row) {
+        return row.departureCode == query.departureCode;
+    });
+    EXPECT_EQ(flightIds.size(), fromAirport);
+    query.departureCode = "XXX";
+    EXPECT_TRUE(snapshot.findFlights(query).empty());
+}
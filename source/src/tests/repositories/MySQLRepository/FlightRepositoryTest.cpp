@@ -163,6 +163,45 @@ TEST_F(FlightRepositoryTest, FindAllFlights) {
     EXPECT_TRUE(found) << "Test flight not found in findAll results";
 }
 
+// Test findAllSummaries projection
+TEST_F(FlightRepositoryTest, FindAllSummaries) {
+    // Create and save test flight
+    auto flightResult = createTestFlight();
+    ASSERT_TRUE(flightResult.has_value());
+    auto createResult = repository->create(*flightResult);
+    ASSERT_TRUE(createResult.has_value());
+
+    // Load summaries into a reusable buffer
+    std::vector<FlightSummaryRow> rows;
+    auto result = repository->findAllSummaries(rows);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, rows.size());
+
+    auto countResult = repository->count();
+    ASSERT_TRUE(countResult.has_value());
+    EXPECT_EQ(rows.size(), *countResult);
+
+    bool found = false;
+    for (const auto& row : rows) {
+        if (row.flightNumber == _flightNumber.toString()) {
+            found = true;
+            EXPECT_EQ(row.id, createResult->getId());
+            EXPECT_EQ(row.departureCode, "SGN");
+            EXPECT_EQ(row.arrivalCode, "HAN");
+            EXPECT_EQ(row.aircraftSerial, _aircraft->getSerial().toString());
+            EXPECT_EQ(row.totalSeats(), 130);
+            EXPECT_EQ(row.availableSeats(), 130);
+            break;
+        }
+    }
+    EXPECT_TRUE(found) << "Test flight not found in findAllSummaries results";
+
+    // Reloading keeps the buffer capacity
+    auto capacity = rows.capacity();
+    ASSERT_TRUE(repository->findAllSummaries(rows).has_value());
+    EXPECT_EQ(rows.capacity(), capacity);
+}
+
 // Test exists operation
 TEST_F(FlightRepositoryTest, ExistsFlight) {
     // Create and save test flight
@@ -231,6 +270,36 @@ TEST_F(FlightRepositoryTest, UpdateFlight) {
     EXPECT_EQ(updatedFlight.getAircraft()->getSerial().toString(), _aircraft->getSerial().toString());
 }
 
+// Test update with a stale version is rejected
+TEST_F(FlightRepositoryTest, UpdateFlightWithStaleVersion) {
+    // Create and save test flight
+    auto flightResult = createTestFlight();
+    ASSERT_TRUE(flightResult.has_value());
+    auto createResult = repository->create(*flightResult);
+    ASSERT_TRUE(createResult.has_value());
+    Flight flight = *createResult;
+
+    // First writer succeeds and bumps the version
+    Flight firstCopy = flight;
+    firstCopy.setStatus(FlightStatus::DELAYED);
+    auto firstResult = repository->update(firstCopy);
+    ASSERT_TRUE(firstResult.has_value());
+    EXPECT_EQ(firstResult->getVersion(), flight.getVersion() + 1);
+
+    // Second writer still holds the old version
+    Flight secondCopy = flight;
+    secondCopy.setStatus(FlightStatus::CANCELLED);
+    auto secondResult = repository->update(secondCopy);
+    ASSERT_FALSE(secondResult.has_value());
+    EXPECT_EQ(secondResult.error().code, "VERSION_CONFLICT");
+
+    // The first write is kept
+    auto foundResult = repository->findById(flight.getId());
+    ASSERT_TRUE(foundResult.has_value());
+    EXPECT_EQ(foundResult->getStatus(), FlightStatus::DELAYED);
+    EXPECT_EQ(foundResult->getVersion(), firstResult->getVersion());
+}
+
 // Test deleteById operation
 TEST_F(FlightRepositoryTest, DeleteFlightById) {
     // Create and save test flight
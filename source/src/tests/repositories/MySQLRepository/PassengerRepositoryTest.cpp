@@ -131,6 +131,34 @@ TEST_F(PassengerRepositoryTest, FindAllPassengers) {
     EXPECT_TRUE(found) << "Test passenger not found in findAll results";
 }
 
+// Test findAllListRows projection
+TEST_F(PassengerRepositoryTest, FindAllListRows) {
+    // Create and save test passenger
+    auto passengerResult = createTestPassenger();
+    ASSERT_TRUE(passengerResult.has_value());
+    auto createResult = repository->create(*passengerResult);
+    ASSERT_TRUE(createResult.has_value());
+
+    std::vector<PassengerListRow> rows;
+    auto result = repository->findAllListRows(rows);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, rows.size());
+
+    bool found = false;
+    for (const auto& row : rows) {
+        if (row.passportNumber == _passport.toString()) {
+            found = true;
+            EXPECT_EQ(row.id, createResult->getId());
+            EXPECT_EQ(row.name, _name);
+            EXPECT_EQ(row.email, _contactInfo.getEmail());
+            EXPECT_EQ(row.phone, _contactInfo.getPhone());
+            EXPECT_EQ(row.address, _contactInfo.getAddress());
+            break;
+        }
+    }
+    EXPECT_TRUE(found) << "Test passenger not found in findAllListRows results";
+}
+
 // Test exists operation
 TEST_F(PassengerRepositoryTest, ExistsPassenger) {
     // Create and save test passenger
@@ -0,0 +1,389 @@
+#include <gtest/gtest.h>
+#include "../../server/BookingServer.h"
+#include "../../server/Json.h"
+#include "../../server/Protocol.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include <arpa/inet.h>
+#include <map>
+#include <netinet/in.h>
+#include <set>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Server;
+
+namespace {
+    /// Client TCP chặn tối giản: gửi khung, đọc khung, ghép phản hồi theo id
+    class TestClient {
+    private:
+        int _fd = -1;
+        FrameDecoder _decoder;
+
+    public:
+        explicit TestClient(uint16_t port) {
+            _fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (::connect(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                ::close(_fd);
+                _fd = -1;
+            }
+        }
+
+        ~TestClient() {
+            if (_fd >= 0) ::close(_fd);
+        }
+
+        bool connected() const { return _fd >= 0; }
+
+        bool sendRaw(const std::string& bytes) {
+            size_t sent = 0;
+            while (sent < bytes.size()) {
+                ssize_t n = ::send(_fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) return false;
+                sent += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool send(const std::string& payload) { return sendRaw(encodeFrame(payload)); }
+
+        std::optional<Json> receive() {
+            char buffer[4096];
+            while (true) {
+                auto frame = _decoder.next();
+                if (!frame) return std::nullopt;
+                if (frame.value()) {
+                    auto json = Json::parse(*frame.value());
+                    if (!json) return std::nullopt;
+                    return json.value();
+                }
+                ssize_t n = ::recv(_fd, buffer, sizeof(buffer), 0);
+                if (n <= 0) return std::nullopt;
+                _decoder.append(buffer, static_cast<size_t>(n));
+            }
+        }
+
+        /// Đọc count phản hồi, đánh chỉ mục theo id số
+        std::map<int, Json> receiveAll(size_t count) {
+            std::map<int, Json> responses;
+            for (size_t i = 0; i < count; ++i) {
+                auto response = receive();
+                if (!response) break;
+                const Json* id = response->find("id");
+                responses[id && id->isNumber() ? static_cast<int>(id->asNumber()) : -1] = *response;
+            }
+            return responses;
+        }
+    };
+
+    std::string errorCode(const Json& response) {
+        const Json* error = response.find("error");
+        const Json* code = error ? error->find("code") : nullptr;
+        return code && code->isString() ? code->asString() : "";
+    }
+}
+
+TEST(JsonTest, ParseAndDumpRoundTrip) {
+    auto parsed = Json::parse(R"( {"name":"Nguy\u1ec5n \"A\"","seats":[1,2.5,-3e2],"ok":true,"none":null} )");
+    ASSERT_RESULT(parsed);
+    const Json& json = parsed.value();
+    ASSERT_TRUE(json.isObject());
+    EXPECT_EQ(json.find("name")->asString(), "Nguyễn \"A\"");
+    ASSERT_EQ(json.find("seats")->asArray().size(), 3u);
+    EXPECT_DOUBLE_EQ(json.find("seats")->asArray()[2].asNumber(), -300.0);
+    EXPECT_TRUE(json.find("ok")->asBool());
+    EXPECT_TRUE(json.find("none")->isNull());
+    EXPECT_EQ(json.find("missing"), nullptr);
+
+    std::string dumped = json.dump();
+    EXPECT_NE(dumped.find("\"seats\":[1,2.5,-300]"), std::string::npos);
+    auto reparsed = Json::parse(dumped);
+    ASSERT_RESULT(reparsed);
+    EXPECT_EQ(reparsed.value().dump(), dumped);
+
+    auto surrogate = Json::parse(R"("\ud83d\ude00")");
+    ASSERT_RESULT(surrogate);
+    EXPECT_EQ(surrogate.value().asString(), "\xF0\x9F\x98\x80");
+
+    for (const std::string bad : {"", "{", "[1,]", "{\"a\" 1}", "tru", "\"open", "1 2", "\"\\ud83d\""}) {
+        auto rejected = Json::parse(bad);
+        ASSERT_FALSE(rejected.has_value()) << bad;
+        EXPECT_EQ(rejected.error().code, "INVALID_JSON");
+    }
+    EXPECT_FALSE(Json::parse(std::string(100, '[') + std::string(100, ']')).has_value());
+}
+
+TEST(ProtocolTest, DecoderReassemblesSplitFramesAndRejectsOversize) {
+    std::string stream = encodeFrame("{\"a\":1}") + encodeFrame("") + encodeFrame("second");
+    FrameDecoder decoder;
+    std::vector<std::string> frames;
+    for (char byte : stream) {
+        decoder.append(&byte, 1);
+        while (true) {
+            auto frame = decoder.next();
+            ASSERT_RESULT(frame);
+            if (!frame.value()) break;
+            frames.push_back(*frame.value());
+        }
+    }
+    EXPECT_EQ(frames, (std::vector<std::string>{"{\"a\":1}", "", "second"}));
+    EXPECT_EQ(decoder.buffered(), 0u);
+
+    const char oversize[] = {'\x7f', '\x00', '\x00', '\x00'};
+    FrameDecoder rejecting;
+    rejecting.append(oversize, sizeof(oversize));
+    auto frame = rejecting.next();
+    ASSERT_FALSE(frame.has_value());
+    EXPECT_EQ(frame.error().code, "FRAME_TOO_LARGE");
+}
+
+TEST(ConnectionPoolTest, LeasesAreBoundedAndDroppedConnectionsReplaced) {
+    size_t opened = 0;
+    auto pool = ConnectionPool::create([&opened]() -> Result<std::shared_ptr<IDatabaseConnection>> {
+        ++opened;
+        return Success(std::shared_ptr<IDatabaseConnection>(std::make_shared<InMemoryConnection>()));
+    }, 2);
+    ASSERT_RESULT(pool);
+    EXPECT_EQ(opened, 2u);
+    EXPECT_FALSE(ConnectionPool::create(nullptr, 0).has_value());
+
+    {
+        auto first = pool.value()->acquire();
+        auto second = pool.value()->acquire();
+        ASSERT_RESULT(first);
+        ASSERT_RESULT(second);
+        EXPECT_EQ(pool.value()->idle(), 0u);
+
+        auto timedOut = pool.value()->acquire(std::chrono::milliseconds(20));
+        ASSERT_FALSE(timedOut.has_value());
+        EXPECT_EQ(timedOut.error().code, "POOL_TIMEOUT");
+
+        // Kết nối bị ngắt khi đang mượn không quay lại pool
+        ASSERT_RESULT(first.value()->disconnect());
+    }
+    EXPECT_EQ(pool.value()->idle(), 1u);
+
+    auto a = pool.value()->acquire();
+    auto b = pool.value()->acquire();
+    ASSERT_RESULT(a);
+    ASSERT_RESULT(b);
+    EXPECT_EQ(opened, 3u);
+    EXPECT_TRUE(b.value()->isConnected().value());
+}
+
+class BookingServerTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+    std::shared_ptr<ConnectionPool> pool;
+    std::unique_ptr<BookingServer> server;
+
+    static std::string passport(int index) { return "VN:10000000" + std::to_string(index); }
+
+    void SetUp() override {
+        // Một kết nối duy nhất trong pool: Database trong bộ nhớ không an toàn khi nhiều
+        // kết nối dùng chung, nên mọi worker lần lượt mượn cùng một session
+        db = std::make_shared<InMemoryConnection>();
+        ApplicationContext context(db, nullptr);
+        std::istringstream aircraft("serial,model,seat_layout\nVN100,Airbus A321,\"E:150,B:20\"\n");
+        std::string passengerCsv = "name,passport,email,phone,address\n";
+        for (int i = 0; i < 8; ++i) {
+            passengerCsv += "Hanh Khach " + std::to_string(i) + "," + passport(i) + ",p" + std::to_string(i) +
+                            "@example.com,090123456" + std::to_string(i) + ",Ha Noi\n";
+        }
+        std::istringstream passengers(passengerCsv);
+        // TicketService::canBookFlight chỉ cho đặt khi hasDeparted() đúng, nên lịch bay nằm trong quá khứ
+        std::istringstream flights("flight_number,route,schedule,aircraft_serial,status\n"
+                                   "VN123,Ha Noi(HAN)-Ho Chi Minh(SGN),2020-01-10 08:00|2020-01-10 10:00,VN100,\n");
+        ASSERT_RESULT(Cli::importTable(context, "aircraft", aircraft));
+        ASSERT_RESULT(Cli::importTable(context, "passengers", passengers));
+        ASSERT_RESULT(Cli::importTable(context, "flights", flights));
+
+        auto created = ConnectionPool::create([this]() -> Result<std::shared_ptr<IDatabaseConnection>> {
+            return Success(std::shared_ptr<IDatabaseConnection>(db));
+        }, 1);
+        ASSERT_RESULT(created);
+        pool = created.value();
+
+        ServerConfig config;
+        config.workers = 3;
+        restart(config);
+    }
+
+    /// Chạy lại server trên cùng pool với cấu hình khác; cổng luôn do hệ điều hành chọn
+    void restart(ServerConfig config) {
+        if (server) server->stop();
+        config.port = 0;
+        server = std::make_unique<BookingServer>(pool, nullptr, config);
+        ASSERT_RESULT(server->start());
+        ASSERT_NE(server->port(), 0);
+    }
+
+    void TearDown() override {
+        if (server) server->stop();
+    }
+};
+
+TEST_F(BookingServerTest, ServesPipelinedRequestsMatchedById) {
+    TestClient client(server->port());
+    ASSERT_TRUE(client.connected());
+
+    ASSERT_TRUE(client.send(R"({"id":1,"method":"ping"})"));
+    ASSERT_TRUE(client.send(R"({"id":2,"method":"flight.get","params":{"flightNumber":"VN123"}})"));
+    ASSERT_TRUE(client.send(R"({"id":3,"method":"flight.teleport"})"));
+    ASSERT_TRUE(client.send(R"({"id":4,"method":"flight.get","params":{"flightNumber":42}})"));
+    ASSERT_TRUE(client.send("{not json"));
+    auto responses = client.receiveAll(5);
+    ASSERT_EQ(responses.size(), 5u);
+
+    EXPECT_TRUE(responses[1].find("ok")->asBool());
+    EXPECT_TRUE(responses[1].find("result")->find("pong")->asBool());
+
+    ASSERT_TRUE(responses[2].find("ok")->asBool());
+    const Json* flight = responses[2].find("result");
+    EXPECT_EQ(flight->find("originCode")->asString(), "HAN");
+    EXPECT_EQ(flight->find("aircraftSerial")->asString(), "VN100");
+
+    EXPECT_EQ(errorCode(responses[3]), "UNKNOWN_METHOD");
+    EXPECT_EQ(errorCode(responses[4]), "INVALID_PARAMS");
+    EXPECT_EQ(errorCode(responses[-1]), "INVALID_JSON");
+    EXPECT_TRUE(responses[-1].find("id")->isNull());
+}
+
+TEST_F(BookingServerTest, BookingsFromSeveralClientsAreSerialisedThroughThePool) {
+    constexpr int clientCount = 4;
+    std::vector<std::unique_ptr<TestClient>> clients;
+    for (int i = 0; i < clientCount; ++i) {
+        clients.push_back(std::make_unique<TestClient>(server->port()));
+        ASSERT_TRUE(clients.back()->connected());
+    }
+
+    // Số vé được tính từ số vé hiện có của chuyến bay; lượt đặt đi tuần tự qua pool nên không trùng.
+    // Một hành khách chỉ được đặt một vé mỗi chuyến nên mỗi lượt dùng hộ chiếu khác nhau
+    for (int i = 0; i < clientCount; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            int passenger = 2 * i + j;
+            ASSERT_TRUE(clients[i]->send(R"({"id":)" + std::to_string(passenger) + R"(,"method":"ticket.book","params":{"passport":")" +
+                                         passport(passenger) + R"(","flightNumber":"VN123","seat":"E)" +
+                                         std::to_string(10 + passenger) + R"(","price":1500000,"currency":"VND"}})"));
+        }
+    }
+
+    std::set<std::string> ticketNumbers;
+    for (int i = 0; i < clientCount; ++i) {
+        auto responses = clients[i]->receiveAll(2);
+        ASSERT_EQ(responses.size(), 2u);
+        for (const auto& [id, response] : responses) {
+            ASSERT_TRUE(response.find("ok")->asBool()) << response.dump();
+            const Json* ticket = response.find("result");
+            EXPECT_EQ(ticket->find("passport")->asString(), passport(id));
+            EXPECT_EQ(ticket->find("status")->asString(), "CONFIRMED");
+            ticketNumbers.insert(ticket->find("ticketNumber")->asString());
+        }
+    }
+    EXPECT_EQ(ticketNumbers.size(), 2u * clientCount);
+
+    TestClient reader(server->port());
+    ASSERT_TRUE(reader.send(R"({"id":"tickets","method":"ticket.byFlight","params":{"flightNumber":"VN123"}})"));
+    auto listed = reader.receive();
+    ASSERT_TRUE(listed.has_value());
+    EXPECT_EQ(listed->find("id")->asString(), "tickets");
+    EXPECT_EQ(listed->find("result")->asArray().size(), 2u * clientCount);
+}
+
+TEST_F(BookingServerTest, FlightSearchAndRouteReportFollowWritesThroughTheSnapshot) {
+    TestClient client(server->port());
+    ASSERT_TRUE(client.connected());
+
+    ASSERT_TRUE(client.send(R"({"id":1,"method":"flight.search","params":{"originCode":"HAN","destinationCode":"SGN"}})"));
+    ASSERT_TRUE(client.send(R"({"id":2,"method":"flight.search","params":{"originCode":"HAN","from":"2020-01-11"}})"));
+    ASSERT_TRUE(client.send(R"({"id":3,"method":"flight.search","params":{"destinationCode":"DAD"}})"));
+    ASSERT_TRUE(client.send(R"({"id":4,"method":"flight.search","params":{"from":"2020-02-30"}})"));
+    ASSERT_TRUE(client.send(R"({"id":5,"method":"report.routes"})"));
+    auto responses = client.receiveAll(5);
+    ASSERT_EQ(responses.size(), 5u);
+
+    ASSERT_TRUE(responses[1].find("ok")->asBool()) << responses[1].dump();
+    const auto& found = responses[1].find("result")->asArray();
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].find("flightNumber")->asString(), "VN123");
+    EXPECT_EQ(found[0].find("availableSeats")->asNumber(), 170);
+    EXPECT_TRUE(responses[2].find("result")->asArray().empty());
+    EXPECT_TRUE(responses[3].find("result")->asArray().empty());
+    EXPECT_EQ(errorCode(responses[4]), "INVALID_PARAMS");
+    const auto& routes = responses[5].find("result")->asArray();
+    ASSERT_EQ(routes.size(), 1u);
+    EXPECT_EQ(routes[0].find("route")->asString(), "HAN-SGN");
+    EXPECT_EQ(routes[0].find("ticketsSold")->asNumber(), 0);
+
+    // Vé đặt qua server đi qua Changes::Feed tới ảnh chụp; lần đọc sau chỉ nạp lại vé đó
+    ASSERT_TRUE(client.send(R"({"id":6,"method":"ticket.book","params":{"passport":")" + passport(0) +
+                            R"(","flightNumber":"VN123","seat":"E10","price":1500000,"currency":"VND"}})"));
+    auto booked = client.receive();
+    ASSERT_TRUE(booked.has_value());
+    ASSERT_TRUE(booked->find("ok")->asBool()) << booked->dump();
+
+    ASSERT_TRUE(client.send(R"({"id":7,"method":"report.routes","params":{"from":"2020-01-01","to":"2020-01-31"}})"));
+    auto report = client.receive();
+    ASSERT_TRUE(report.has_value());
+    const auto& updated = report->find("result")->asArray();
+    ASSERT_EQ(updated.size(), 1u);
+    EXPECT_EQ(updated[0].find("ticketsSold")->asNumber(), 1);
+    EXPECT_EQ(updated[0].find("revenue")->find("VND")->asNumber(), 1500000);
+}
+
+TEST_F(BookingServerTest, PausesReadingAClientWithTooManyRequestsInFlight) {
+    ServerConfig config;
+    config.workers = 2;
+    config.maxClientQueuedRequests = 2;
+    config.maxClientOutputBytes = 64;
+    restart(config);
+
+    // Gửi dồn nhiều yêu cầu mà chưa đọc phản hồi: server ngừng đọc rồi đọc tiếp khi xả bớt, không từ chối yêu cầu nào
+    constexpr int requestCount = 200;
+    TestClient client(server->port());
+    ASSERT_TRUE(client.connected());
+    std::string burst;
+    for (int i = 0; i < requestCount; ++i) {
+        burst += encodeFrame(R"({"id":)" + std::to_string(i) + R"(,"method":"ping"})");
+    }
+    ASSERT_TRUE(client.sendRaw(burst));
+
+    auto responses = client.receiveAll(requestCount);
+    ASSERT_EQ(responses.size(), static_cast<size_t>(requestCount));
+    for (const auto& [id, response] : responses) {
+        EXPECT_TRUE(response.find("ok")->asBool()) << id << ": " << response.dump();
+    }
+}
+
+TEST_F(BookingServerTest, ClosesClientsThatExceedTheInputLimit) {
+    ServerConfig config;
+    config.maxClientInputBytes = 1024;
+    restart(config);
+
+    // Khung dở dang lớn hơn giới hạn: đóng kết nối mà không chờ nhận hết khung
+    TestClient partial(server->port());
+    ASSERT_TRUE(partial.connected());
+    std::string frame = encodeFrame(R"({"id":1,"method":"ping","pad":")" + std::string(4096, 'x') + R"("})");
+    ASSERT_TRUE(partial.sendRaw(frame.substr(0, 2048)));
+    EXPECT_FALSE(partial.receive().has_value());
+
+    // Header vượt MAX_FRAME_SIZE bị từ chối ngay cả khi phía sau còn dữ liệu
+    TestClient oversized(server->port());
+    ASSERT_TRUE(oversized.connected());
+    ASSERT_TRUE(oversized.sendRaw(std::string("\x7f\xff\xff\xff", 4) + std::string(100, 'x')));
+    EXPECT_FALSE(oversized.receive().has_value());
+
+    // Client khác vẫn được phục vụ
+    TestClient healthy(server->port());
+    ASSERT_TRUE(healthy.send(R"({"id":7,"method":"ping"})"));
+    auto response = healthy.receive();
+    ASSERT_TRUE(response.has_value());
+    EXPECT_TRUE(response->find("ok")->asBool());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../../app/ApplicationContext.h"
+#include "../../cli/BulkImport.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../database/TraceConnection.h"
+#include "../../services/RequestContext.h"
+#include <map>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+/**
+ * Đặt vé qua kết nối ghi vết để đếm số lần mỗi câu SELECT thực sự chạy
+ */
+class TicketServiceReadsTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> backend;
+    std::shared_ptr<TraceConnection> recorder;
+    std::unique_ptr<ApplicationContext> context;
+
+    void SetUp() override {
+        backend = std::make_shared<InMemoryConnection>();
+        recorder = std::make_shared<TraceConnection>(std::static_pointer_cast<IDatabaseConnection>(backend));
+        context = std::make_unique<ApplicationContext>(recorder, nullptr);
+
+        ASSERT_RESULT(backend->execute(
+            "INSERT INTO aircraft (serial_number, model, economy_seats, business_seats, first_seats) VALUES "
+            "('VN100', 'Airbus A321', 150, 20, 0)"));
+        // canBookFlight chỉ cho đặt chuyến bay đã khởi hành
+        auto flights = Cli::importCsv(*context, "flights",
+            "flight_number,route,schedule,aircraft_serial\n"
+            "VN123,Ha Noi(HAN)-Ho Chi Minh(SGN),2020-01-10 08:00|2020-01-10 10:00,VN100\n");
+        ASSERT_RESULT(flights);
+        ASSERT_EQ(flights.value().imported, 1u);
+        auto passengers = Cli::importCsv(*context, "passengers",
+            "passport,name,email,phone,address\n"
+            "VN:123456789,Nguyen Van A,a@example.com,0901234567,Ha Noi\n");
+        ASSERT_RESULT(passengers);
+        ASSERT_EQ(passengers.value().imported, 1u);
+    }
+
+    /// Số lần chạy của từng câu SELECT kể từ lần mark gần nhất
+    std::map<std::string, size_t> selectsSinceLastMark() const {
+        const auto& events = recorder->getTrace().events;
+        size_t begin = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (events[i].op == TraceOp::MARK) begin = i + 1;
+        }
+        std::map<int, std::string> prepared;
+        std::map<std::string, size_t> selects;
+        for (size_t i = 0; i < events.size(); ++i) {
+            const auto& event = events[i];
+            if (event.op == TraceOp::PREPARE) prepared[static_cast<int>(event.value)] = event.text;
+            if (i < begin) continue;
+            if (event.op == TraceOp::EXECUTE_QUERY) ++selects[event.text];
+            if (event.op == TraceOp::EXECUTE_QUERY_STATEMENT) ++selects[prepared[event.statementId]];
+        }
+        return selects;
+    }
+};
+
+TEST_F(TicketServiceReadsTest, BookingReadsEachEntityOnce) {
+    RequestContext request(context->passengerRepository(), context->flightRepository(), context->ticketRepository());
+    recorder->mark("book");
+    auto ticket = context->ticketService()->bookTicket(request, PassportNumber::create("VN:123456789").value(),
+                                                       FlightNumber::create("VN123").value(), "E001",
+                                                       Price::create(100.0, "USD").value());
+    ASSERT_RESULT(ticket) << ticket.error().message;
+
+    // Hành khách, chuyến bay và số vé của chuyến bay: mỗi thứ một lần
+    EXPECT_EQ(request.getRepositoryReads(), 3u);
+    auto selects = selectsSinceLastMark();
+    ASSERT_FALSE(selects.empty());
+    for (const auto& [sql, count] : selects) {
+        EXPECT_EQ(count, 1u) << sql;
+    }
+
+    // Overload không nhận RequestContext tự tạo context riêng cho mỗi lần đặt
+    recorder->mark("book without context");
+    auto second = context->ticketService()->bookTicket(PassportNumber::create("VN:123456789").value(),
+                                                       FlightNumber::create("VN123").value(), "E002",
+                                                       Price::create(100.0, "USD").value());
+    ASSERT_RESULT(second) << second.error().message;
+    for (const auto& [sql, count] : selectsSinceLastMark()) {
+        EXPECT_EQ(count, 1u) << sql;
+    }
+}
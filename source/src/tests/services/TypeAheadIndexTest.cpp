@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "../../services/TypeAheadIndex.h"
+#include "../../app/ApplicationContext.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../loadgen/DataGenerator.h"
+#include <algorithm>
+#include <sstream>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+class TypeAheadIndexTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryConnection> db;
+    std::unique_ptr<ApplicationContext> context;
+    std::shared_ptr<TypeAheadIndex> index;
+
+    void SetUp() override {
+        db = std::make_shared<InMemoryConnection>();
+        context = std::make_unique<ApplicationContext>(db, nullptr);
+        // Lô nhỏ để lần nạp đầu phải đi qua nhiều trang
+        index = std::make_shared<TypeAheadIndex>(Changes::Feed::getInstance(), 2);
+        context->passengerService()->useSearchIndex(index);
+        context->ticketService()->useSearchIndex(index);
+        context->flightService()->useSearchIndex(index);
+    }
+
+    std::vector<std::string> suggestNames(const std::string& text, size_t limit = 10) {
+        std::vector<PassengerListRow> rows;
+        auto found = context->passengerService()->suggestPassengers(text, limit, rows);
+        EXPECT_TRUE(found.has_value());
+        std::vector<std::string> names;
+        for (const auto& row : rows) names.push_back(row.name);
+        return names;
+    }
+};
+
+TEST_F(TypeAheadIndexTest, PassengerSuggestionsFollowRepositoryWrites) {
+    std::istringstream passengers("name,passport,email,phone,address\n"
+                                  "Nguyen Van Binh,AN:123456789,a@example.com,0901234567,Ha Noi\n"
+                                  "An Thi Hoa,VN:987654321,b@example.com,0901234567,Hue\n"
+                                  "Nguyễn Thị Vân,VN:123123123,c@example.com,0901234567,Da Nang\n"
+                                  "Tran Van Nam,VN:555666777,d@example.com,0901234567,Can Tho\n");
+    ASSERT_RESULT(Cli::importTable(*context, "passengers", passengers));
+
+    EXPECT_EQ(suggestNames("nguy"), (std::vector<std::string>{"Nguyễn Thị Vân", "Nguyen Van Binh"}));
+    EXPECT_EQ(suggestNames("VAN"), (std::vector<std::string>{"Nguyễn Thị Vân", "Nguyen Van Binh", "Tran Van Nam"}));
+    EXPECT_EQ(suggestNames("van", 2).size(), 2u);
+    EXPECT_TRUE(suggestNames("xyz").empty());
+    EXPECT_TRUE(suggestNames("  ").empty());
+
+    // Khớp hộ chiếu đứng trước khớp tên
+    EXPECT_EQ(suggestNames("an"), (std::vector<std::string>{"Nguyen Van Binh", "An Thi Hoa"}));
+    EXPECT_EQ(suggestNames("vn:12"), (std::vector<std::string>{"Nguyễn Thị Vân"}));
+
+    // Ghi sau khi nạp chỉ đánh dấu id; lần gợi ý kế tiếp áp dụng chúng
+    std::istringstream more("name,passport,email,phone,address\n"
+                            "Nguyen Minh Duc,VN:111222333,e@example.com,0901234567,Hue\n");
+    ASSERT_RESULT(Cli::importTable(*context, "passengers", more));
+    EXPECT_EQ(index->pendingChanges(SearchField::PASSENGER_NAME), 1u);
+    EXPECT_EQ(suggestNames("nguyen m"), (std::vector<std::string>{"Nguyen Minh Duc"}));
+    EXPECT_EQ(index->pendingChanges(SearchField::PASSENGER_NAME), 0u);
+
+    auto& service = *context->passengerService();
+    auto passport = PassportNumber::create("VN:555666777").value();
+    ASSERT_RESULT(service.deletePassenger(passport));
+    EXPECT_EQ(suggestNames("tran"), std::vector<std::string>{});
+    EXPECT_EQ(suggestNames("van"), (std::vector<std::string>{"Nguyễn Thị Vân", "Nguyen Van Binh"}));
+
+    // Chỉ mục riêng khác nạp lại từ bảng và cho cùng kết quả
+    auto fresh = std::make_shared<TypeAheadIndex>(nullptr);
+    service.useSearchIndex(fresh);
+    EXPECT_EQ(suggestNames("nguyen"), (std::vector<std::string>{"Nguyen Minh Duc", "Nguyễn Thị Vân", "Nguyen Van Binh"}));
+}
+
+TEST_F(TypeAheadIndexTest, TicketAndFlightSuggestionsMatchNumberPrefixes) {
+    LoadGen::GeneratorConfig config;
+    config.aircraftCount = 2;
+    config.flightCount = 6;
+    config.passengerCount = 20;
+    config.ticketCount = 40;
+    config.days = 3;
+    auto dataset = LoadGen::SyntheticDataset::create(config);
+    ASSERT_RESULT(dataset);
+    LoadGen::ConnectionSink sink(db);
+    ASSERT_RESULT(LoadGen::DataGenerator(dataset.value()).generate(sink));
+
+    std::vector<TicketListRow> tickets;
+    ASSERT_RESULT(context->ticketService()->getTicketListRows(tickets));
+    ASSERT_FALSE(tickets.empty());
+    const TicketListRow& wanted = tickets.back();
+
+    std::vector<TicketListRow> ticketRows;
+    auto foundTickets = context->ticketService()->suggestTickets(wanted.ticketNumber, 5, ticketRows);
+    ASSERT_RESULT(foundTickets);
+    ASSERT_EQ(ticketRows.size(), 1u);
+    EXPECT_EQ(ticketRows[0].id, wanted.id);
+    EXPECT_EQ(ticketRows[0].passportNumber, wanted.passportNumber);
+
+    // Tiền tố là số hiệu chuyến bay: mọi vé của chuyến, theo thứ tự số vé
+    ASSERT_RESULT(context->ticketService()->suggestTickets(wanted.flightNumber + "-", 1000, ticketRows));
+    size_t onFlight = std::count_if(tickets.begin(), tickets.end(),
+                                    [&](const TicketListRow& row) { return row.flightNumber == wanted.flightNumber; });
+    EXPECT_EQ(ticketRows.size(), onFlight);
+    EXPECT_TRUE(std::is_sorted(ticketRows.begin(), ticketRows.end(), [](const auto& a, const auto& b) {
+        return a.ticketNumber < b.ticketNumber;
+    }));
+
+    std::vector<FlightSummaryRow> flights;
+    std::string flightNumber = dataset.value().flightNumber(3);
+    auto foundFlights = context->flightService()->suggestFlights(flightNumber, 5, flights);
+    ASSERT_RESULT(foundFlights);
+    ASSERT_EQ(flights.size(), 1u);
+    EXPECT_EQ(flights[0].flightNumber, flightNumber);
+    // Số ghế đã đặt giống danh sách đầy đủ
+    std::vector<FlightSummaryRow> all;
+    ASSERT_RESULT(context->flightService()->getFlightSummariesWithOccupancy(all));
+    auto same = std::find_if(all.begin(), all.end(), [&](const FlightSummaryRow& row) { return row.id == flights[0].id; });
+    ASSERT_NE(same, all.end());
+    EXPECT_EQ(flights[0].availableSeats(), same->availableSeats());
+    EXPECT_EQ(flights[0].bookedEconomy, same->bookedEconomy);
+}
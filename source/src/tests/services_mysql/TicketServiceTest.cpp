@@ -741,3 +741,42 @@ TEST_F(TicketServiceTest, SearchBuilderComplexScenario)
     // Cleanup second passenger
     _passengerRepository->deleteById(passenger2->getId());
 }
+
+// Test bookGroup
+TEST_F(TicketServiceTest, BookGroupReservesAdjacentSeats)
+{
+    auto passenger2Result = createSecondTestPassenger();
+    ASSERT_TRUE(passenger2Result.has_value());
+    auto passenger2 = std::make_shared<Passenger>(passenger2Result.value());
+
+    std::vector<PassportNumber> passports{_passenger->getPassport(), passenger2->getPassport()};
+    auto result = _service->bookGroup(passports, _flight->getFlightNumber(), "E", _price);
+
+    ASSERT_TRUE(result.has_value()) << result.error().message;
+    ASSERT_EQ(result.value().size(), 2);
+    EXPECT_EQ(result.value()[0].getPassenger()->getId(), _passenger->getId());
+    EXPECT_EQ(result.value()[1].getPassenger()->getId(), passenger2->getId());
+    EXPECT_EQ(result.value()[1].getSeatNumber().getSequenceNumber(),
+              result.value()[0].getSeatNumber().getSequenceNumber() + 1);
+    EXPECT_NE(result.value()[0].getTicketNumber().toString(), result.value()[1].getTicketNumber().toString());
+
+    auto seatResult = SeatNumber::create(result.value()[0].getSeatNumber().toString(), _aircraft->getSeatLayout());
+    ASSERT_TRUE(seatResult.has_value());
+    auto availableResult = _flightRepository->isSeatAvailable(*_flight, *seatResult);
+    ASSERT_TRUE(availableResult.has_value());
+    EXPECT_FALSE(availableResult.value());
+
+    for (const auto& ticket : result.value()) {
+        _ticketRepository->deleteById(ticket.getId());
+    }
+    _passengerRepository->deleteById(passenger2->getId());
+}
+
+TEST_F(TicketServiceTest, BookGroupRejectsDuplicatePassenger)
+{
+    std::vector<PassportNumber> passports{_passenger->getPassport(), _passenger->getPassport()};
+    auto result = _service->bookGroup(passports, _flight->getFlightNumber(), "E", _price);
+
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, "DUPLICATE_PASSENGER");
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../../utils/ChangeFeed.h"
+#include "../../app/ApplicationContext.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Changes;
+using namespace std::chrono_literals;
+
+TEST(ChangeFeedTest, SubscribersReceiveEventsUntilReset) {
+    auto feed = std::make_shared<Feed>();
+    std::vector<Event> first;
+    std::vector<Event> second;
+    auto a = feed->subscribe([&](const Event& event) { first.push_back(event); });
+    auto b = feed->subscribe([&](const Event& event) { second.push_back(event); });
+    EXPECT_EQ(feed->subscriberCount(), 2u);
+
+    feed->publish(Entity::TICKET, Kind::UPDATED, 7);
+    b.reset();
+    feed->publish(Entity::FLIGHT, Kind::DELETED, 3);
+    EXPECT_FALSE(b.isActive());
+    EXPECT_EQ(feed->subscriberCount(), 1u);
+
+    EXPECT_EQ(first, (std::vector<Event>{{Entity::TICKET, Kind::UPDATED, 7}, {Entity::FLIGHT, Kind::DELETED, 3}}));
+    EXPECT_EQ(second, (std::vector<Event>{{Entity::TICKET, Kind::UPDATED, 7}}));
+
+    // Đăng ký được chuyển giao mà không bị hủy hai lần; hủy feed trước đăng ký cũng an toàn
+    Subscription moved = std::move(a);
+    EXPECT_TRUE(moved.isActive());
+    EXPECT_FALSE(a.isActive());
+    feed.reset();
+    moved.reset();
+
+    // Handler ném ngoại lệ không chặn handler sau và không lan ra lệnh ghi
+    auto throwing = std::make_shared<Feed>();
+    int delivered = 0;
+    auto bad = throwing->subscribe([](const Event&) { throw std::runtime_error("bad"); });
+    auto good = throwing->subscribe([&](const Event&) { ++delivered; });
+    EXPECT_NO_THROW(throwing->publish(Entity::AIRCRAFT, Kind::CREATED, 1));
+    EXPECT_EQ(delivered, 1);
+    EXPECT_EQ(throwing->publishedCount(), 1u);
+}
+
+TEST(ChangeFeedTest, ResetWaitsForHandlersRunningOnOtherThreads) {
+    auto feed = std::make_shared<Feed>();
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+    auto subscription = feed->subscribe([&](const Event&) {
+        entered = true;
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    });
+
+    std::thread publisher([&] { feed->publish(Entity::TICKET, Kind::CREATED, 1); });
+    while (!entered) std::this_thread::yield();
+    subscription.reset();
+    // Sau reset(), handler đã chạy xong: đối tượng sở hữu có thể bị hủy an toàn
+    EXPECT_TRUE(finished.load());
+    publisher.join();
+
+    std::atomic<int> received{0};
+    auto counter = feed->subscribe([&](const Event&) { ++received; });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 250; ++i) feed->publish(Entity::PASSENGER, Kind::UPDATED, t * 1000 + i);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    EXPECT_EQ(received.load(), 1000);
+}
+
+TEST(ChangeFeedTest, RepositoriesPublishCommittedWrites) {
+    auto db = std::make_shared<InMemoryConnection>();
+    ApplicationContext context(db, nullptr);
+
+    std::mutex mutex;
+    std::vector<Event> events;
+    auto subscription = Feed::getInstance()->subscribe([&](const Event& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(event);
+    });
+
+    std::istringstream passengers("name,passport,email,phone,address\n"
+                                  "Nguyen Van A,VN:123456789,a@example.com,0901234567,Ha Noi\n"
+                                  "Tran Thi B,VN:987654321,b@example.com,0901234567,Hue\n");
+    ASSERT_RESULT(Cli::importTable(context, "passengers", passengers));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].entity, Entity::PASSENGER);
+    EXPECT_EQ(events[0].kind, Kind::CREATED);
+    EXPECT_NE(events[0].id, events[1].id);
+    events.clear();
+
+    auto& service = *context.passengerService();
+    auto passport = PassportNumber::create("VN:123456789").value();
+    auto passenger = service.getPassenger(passport);
+    ASSERT_RESULT(passenger);
+    auto updated = service.updatePassenger(passenger.value());
+    ASSERT_RESULT(updated) << updated.error().message;
+    EXPECT_EQ(events, (std::vector<Event>{{Entity::PASSENGER, Kind::UPDATED, passenger.value().getId()}}));
+
+    // Lệnh ghi thất bại không phát gì
+    events.clear();
+    auto stale = service.updatePassenger(passenger.value());
+    ASSERT_FALSE(stale.has_value());
+    EXPECT_TRUE(events.empty());
+
+    // Xóa theo số hộ chiếu vẫn báo id của hàng đã xóa
+    ASSERT_RESULT(service.deletePassenger(passport));
+    EXPECT_EQ(events, (std::vector<Event>{{Entity::PASSENGER, Kind::DELETED, passenger.value().getId()}}));
+    EXPECT_FALSE(service.deletePassenger(passport).has_value());
+    EXPECT_EQ(events.size(), 1u);
+}
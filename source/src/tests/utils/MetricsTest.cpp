@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "../../utils/Metrics.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../repositories/MySQLRepository/FlightRepository.h"
+#include "../../repositories/MySQLRepository/PassengerRepository.h"
+#include "../../repositories/MySQLRepository/TicketRepository.h"
+#include "../../services/PassengerService.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace Metrics;
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+namespace {
+    bool contains(const std::string& text, const std::string& needle) {
+        return text.find(needle) != std::string::npos;
+    }
+}
+
+TEST(MetricsTest, ShardedCounterSumsAcrossThreads) {
+    MetricsRegistry registry;
+    auto& counter = registry.counter("test_events_total", "Events");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 10000; ++i) counter.inc();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(counter.value(), 80000u);
+    // Cùng tên và nhãn trả về cùng một counter
+    EXPECT_EQ(&registry.counter("test_events_total", "Events"), &counter);
+    EXPECT_THROW(registry.gauge("test_events_total", "Events"), std::logic_error);
+}
+
+TEST(MetricsTest, PrometheusTextFormat) {
+    MetricsRegistry registry;
+    registry.counter("test_requests_total", "Requests", {{"path", "a\"b"}}).inc(3);
+    registry.gauge("test_queue_depth", "Queue depth").set(-2);
+    auto& histogram = registry.histogram("test_duration_seconds", "Duration", {{"op", "x"}}, {0.1, 1});
+    histogram.observe(0.05);
+    histogram.observe(0.1);
+    histogram.observe(0.5);
+    histogram.observe(3.0);
+
+    auto text = registry.exportPrometheus();
+    EXPECT_TRUE(contains(text, "# TYPE test_requests_total counter\n"));
+    EXPECT_TRUE(contains(text, "test_requests_total{path=\"a\\\"b\"} 3\n"));
+    EXPECT_TRUE(contains(text, "# TYPE test_queue_depth gauge\ntest_queue_depth -2\n"));
+    EXPECT_TRUE(contains(text, "test_duration_seconds_bucket{op=\"x\",le=\"0.1\"} 2\n"));
+    EXPECT_TRUE(contains(text, "test_duration_seconds_bucket{op=\"x\",le=\"1\"} 3\n"));
+    EXPECT_TRUE(contains(text, "test_duration_seconds_bucket{op=\"x\",le=\"+Inf\"} 4\n"));
+    EXPECT_TRUE(contains(text, "test_duration_seconds_sum{op=\"x\"} 3.65\n"));
+    EXPECT_TRUE(contains(text, "test_duration_seconds_count{op=\"x\"} 4\n"));
+}
+
+TEST(MetricsTest, OperationTimerCountsEarlyReturnsAsFailures) {
+    MetricsRegistry registry;
+    OperationMetrics metrics("service", "test", "op", registry);
+
+    auto run = [&](bool fail) -> Result<int> {
+        OperationTimer timer(metrics);
+        EXPECT_EQ(registry.gauge("airlines_service_operations_in_flight", "", {{"component", "test"}, {"operation", "op"}}).value(), 1);
+        if (fail) {
+            return Failure<int>(CoreError("boom", "TEST"));
+        }
+        return timer.complete(Success(42));
+    };
+    EXPECT_EQ(run(false).value(), 42);
+    EXPECT_FALSE(run(true).has_value());
+    EXPECT_EQ(run(false).value(), 42);
+
+    const Labels base = {{"component", "test"}, {"operation", "op"}};
+    auto labelsWith = [&](const std::string& result) {
+        auto labels = base;
+        labels.emplace_back("result", result);
+        return labels;
+    };
+    EXPECT_EQ(registry.counter("airlines_service_operations_total", "", labelsWith("success")).value(), 2u);
+    EXPECT_EQ(registry.counter("airlines_service_operations_total", "", labelsWith("failure")).value(), 1u);
+    EXPECT_EQ(registry.histogram("airlines_service_operation_duration_seconds", "", base).count(), 3u);
+    EXPECT_EQ(registry.gauge("airlines_service_operations_in_flight", "", base).value(), 0);
+}
+
+TEST(MetricsTest, WritesSnapshotFile) {
+    MetricsRegistry registry;
+    registry.counter("test_written_total", "Written").inc();
+    const std::string path = "metrics_test.prom";
+
+    ASSERT_RESULT(registry.writePrometheusFile(path));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), registry.exportPrometheus());
+    std::remove(path.c_str());
+
+    auto missing = registry.writePrometheusFile("no_such_dir/metrics.prom");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, "METRICS_IO");
+}
+
+// Service và repository ghi vào registry dùng chung
+TEST(MetricsTest, ServicesAndRepositoriesReportToSharedRegistry) {
+    auto connection = std::make_shared<InMemoryConnection>();
+    auto passengerRepository = std::make_shared<PassengerRepository>(connection, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(connection, nullptr);
+    auto ticketRepository = std::make_shared<TicketRepository>(connection, passengerRepository, flightRepository, nullptr);
+    PassengerService service(passengerRepository, ticketRepository, flightRepository);
+
+    auto& registry = *MetricsRegistry::getInstance();
+    auto& serviceSuccess = registry.counter("airlines_service_operations_total", "",
+                                            {{"component", "passenger"}, {"operation", "create"}, {"result", "success"}});
+    auto& serviceFailure = registry.counter("airlines_service_operations_total", "",
+                                            {{"component", "passenger"}, {"operation", "create"}, {"result", "failure"}});
+    auto& repositoryCreates = registry.counter("airlines_repository_operations_total", "",
+                                               {{"component", "passenger"}, {"operation", "create"}, {"result", "success"}});
+    uint64_t successBefore = serviceSuccess.value();
+    uint64_t failureBefore = serviceFailure.value();
+    uint64_t repositoryBefore = repositoryCreates.value();
+
+    auto passenger = Passenger::create("John Doe", "user@example.com|+84123456789|123 Street", "VN:1232323");
+    ASSERT_RESULT(passenger);
+    ASSERT_RESULT(service.createPassenger(passenger.value()));
+    // Trùng hộ chiếu: bị từ chối ở service trước khi tới repository
+    EXPECT_FALSE(service.createPassenger(passenger.value()).has_value());
+
+    EXPECT_EQ(serviceSuccess.value() - successBefore, 1u);
+    EXPECT_EQ(serviceFailure.value() - failureBefore, 1u);
+    EXPECT_EQ(repositoryCreates.value() - repositoryBefore, 1u);
+    EXPECT_TRUE(contains(registry.exportPrometheus(),
+                         "airlines_service_operation_duration_seconds_count{component=\"passenger\",operation=\"create\"}"));
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "../../utils/PagedRowCache.h"
+#include "../../app/ApplicationContext.h"
+#include "../../cli/BatchJobs.h"
+#include "../../database/InMemoryConnection.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+namespace {
+    /// Nguồn giả lập một bảng rất lớn: hàng thứ i có giá trị i
+    PagedRowCache<size_t>::PageLoader syntheticTable(size_t rows, std::vector<size_t>* offsets = nullptr) {
+        return [rows, offsets](size_t offset, size_t limit, std::vector<size_t>& out) -> Result<size_t> {
+            if (offsets) offsets->push_back(offset);
+            for (size_t i = offset; i < rows && i < offset + limit; ++i) out.push_back(i);
+            return Success(out.size());
+        };
+    }
+}
+
+TEST(PagedRowCacheTest, LoadsOnlyThePagesThatAreRead) {
+    std::vector<size_t> offsets;
+    PagedRowCache<size_t> cache(syntheticTable(1'000'000, &offsets), 100, 4);
+    cache.reset(1'000'000);
+
+    ASSERT_NE(cache.row(0), nullptr);
+    EXPECT_EQ(*cache.row(99), 99u);
+    EXPECT_EQ(*cache.row(999'999), 999'999u);
+    EXPECT_EQ(cache.row(1'000'000), nullptr);
+    EXPECT_EQ(offsets, (std::vector<size_t>{0, 999'900}));
+    EXPECT_EQ(cache.cachedPages(), 2u);
+}
+
+TEST(PagedRowCacheTest, EvictsLeastRecentlyUsedPageWhenFull) {
+    std::vector<size_t> offsets;
+    PagedRowCache<size_t> cache(syntheticTable(10'000, &offsets), 10, 3);
+    cache.reset(10'000);
+
+    cache.row(0);
+    cache.row(10);
+    cache.row(20);
+    cache.row(0);      // Trang 0 vừa được dùng lại nên trang 1 là cũ nhất
+    cache.row(30);
+    EXPECT_EQ(cache.cachedPages(), 3u);
+    EXPECT_EQ(cache.pageLoads(), 4u);
+
+    cache.row(0);
+    cache.row(20);
+    EXPECT_EQ(cache.pageLoads(), 4u);
+    EXPECT_EQ(*cache.row(15), 15u);
+    EXPECT_EQ(cache.pageLoads(), 5u);
+
+    // Cuộn qua toàn bộ bảng không làm bộ đệm vượt quá giới hạn
+    for (size_t i = 0; i < cache.size(); ++i) ASSERT_EQ(*cache.row(i), i);
+    EXPECT_EQ(cache.cachedPages(), 3u);
+}
+
+TEST(PagedRowCacheTest, PrefetchIsBoundedAndErrorsStopFurtherLoads) {
+    std::vector<size_t> offsets;
+    PagedRowCache<size_t> cache(syntheticTable(1'000, &offsets), 10, 2);
+    cache.reset(1'000);
+    cache.prefetch(5, 500);
+    EXPECT_EQ(offsets, (std::vector<size_t>{0, 10}));
+    cache.prefetch(995, 5'000);
+    EXPECT_EQ(offsets.back(), 990u);
+
+    size_t calls = 0;
+    PagedRowCache<size_t> failing([&calls](size_t, size_t, std::vector<size_t>&) -> Result<size_t> {
+        ++calls;
+        return Failure<size_t>(CoreError("connection lost", "QUERY_FAILED"));
+    }, 10, 2);
+    failing.reset(100);
+    EXPECT_EQ(failing.row(0), nullptr);
+    EXPECT_EQ(failing.row(50), nullptr);
+    EXPECT_EQ(calls, 1u);
+    ASSERT_TRUE(failing.lastError().has_value());
+    EXPECT_EQ(failing.lastError()->code, "QUERY_FAILED");
+    EXPECT_EQ(failing.cachedPages(), 0u);
+
+    failing.reset(100);
+    EXPECT_FALSE(failing.lastError().has_value());
+    failing.row(0);
+    EXPECT_EQ(calls, 2u);
+
+    // Trang đặt sẵn không gọi hàm nạp
+    failing.reset(100);
+    failing.insertPage(0, std::vector<size_t>{7, 8, 9});
+    ASSERT_NE(failing.row(1), nullptr);
+    EXPECT_EQ(*failing.row(1), 8u);
+    EXPECT_EQ(failing.row(5), nullptr);
+    EXPECT_EQ(calls, 2u);
+}
+
+TEST(PagedRowCacheTest, PagesPassengerListThroughLimitOffsetQueries) {
+    auto db = std::make_shared<InMemoryConnection>();
+    ApplicationContext context(db, nullptr);
+    std::ostringstream csv;
+    csv << "name,passport,email,phone,address\n";
+    for (int i = 0; i < 25; ++i) {
+        csv << "Passenger " << i << ",VN:" << 100000000 + i << ",p" << i << "@example.com,0901234567,Ha Noi\n";
+    }
+    std::istringstream input(csv.str());
+    ASSERT_RESULT(Cli::importTable(context, "passengers", input));
+    auto& service = *context.passengerService();
+
+    auto count = service.countPassengers();
+    ASSERT_RESULT(count);
+    ASSERT_EQ(count.value(), 25u);
+
+    PagedRowCache<PassengerListRow> cache([&service](size_t offset, size_t limit, std::vector<PassengerListRow>& rows) {
+        return service.getPassengerListPage(offset, limit, rows);
+    }, 10, 2);
+    cache.reset(count.value());
+
+    std::vector<int> ids;
+    for (size_t i = 0; i < cache.size(); ++i) {
+        const PassengerListRow* row = cache.row(i);
+        ASSERT_NE(row, nullptr) << i;
+        ids.push_back(row->id);
+    }
+    ASSERT_EQ(ids.size(), 25u);
+    for (size_t i = 1; i < ids.size(); ++i) EXPECT_LT(ids[i - 1], ids[i]);
+    EXPECT_EQ(cache.row(24)->passportNumber, "VN:100000024");
+    EXPECT_EQ(cache.pageLoads(), 3u);
+    EXPECT_EQ(cache.cachedPages(), 2u);
+}
+
+TEST(PagedRowCacheTest, AppliesSingleRowChangesWithoutReset) {
+    struct IdRow {
+        int id = 0;
+        std::string value;
+    };
+    // Bảng sắp theo id: 10, 20, ..., 250
+    std::vector<IdRow> table;
+    for (int i = 1; i <= 25; ++i) table.push_back({i * 10, "v" + std::to_string(i)});
+    size_t loads = 0;
+    PagedRowCache<IdRow> cache([&](size_t offset, size_t limit, std::vector<IdRow>& rows) -> Result<size_t> {
+        ++loads;
+        for (size_t i = offset; i < table.size() && i < offset + limit; ++i) rows.push_back(table[i]);
+        return Success(rows.size());
+    }, 10, 4);
+    cache.reset(table.size());
+    cache.prefetch(0, 24);
+    ASSERT_EQ(loads, 3u);
+
+    EXPECT_EQ(cache.indexOf(130), 12u);
+    EXPECT_FALSE(cache.indexOf(135).has_value());
+    ASSERT_TRUE(cache.replaceRow(12, {130, "edited"}));
+    EXPECT_EQ(cache.row(12)->value, "edited");
+    EXPECT_EQ(loads, 3u);
+
+    // Xóa id 130: trang 0 giữ nguyên, trang chứa nó và trang sau bị bỏ
+    table.erase(table.begin() + 12);
+    EXPECT_EQ(cache.removeById(130), 12u);
+    EXPECT_EQ(cache.size(), 24u);
+    EXPECT_TRUE(cache.hasPage(0));
+    EXPECT_FALSE(cache.hasPage(1));
+    EXPECT_FALSE(cache.hasPage(2));
+    EXPECT_EQ(cache.row(12)->id, 140);
+    EXPECT_EQ(loads, 4u);
+
+    // Thêm id lớn nhất: chỉ trang cuối bị bỏ
+    cache.prefetch(20, 23);
+    table.push_back({260, "new"});
+    EXPECT_EQ(cache.insertById(260), 24u);
+    EXPECT_EQ(cache.size(), 25u);
+    EXPECT_TRUE(cache.hasPage(0));
+    EXPECT_TRUE(cache.hasPage(1));
+    EXPECT_FALSE(cache.hasPage(2));
+    EXPECT_EQ(cache.row(24)->id, 260);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "../../utils/PrefixIndex.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+TEST(PrefixIndexTest, NormalizesCaseDiacriticsAndWhitespace) {
+    EXPECT_EQ(PrefixIndex::normalize("  Nguyễn   Văn\tAn "), "nguyen van an");
+    EXPECT_EQ(PrefixIndex::normalize("ĐẶNG THỊ Ánh"), "dang thi anh");
+    EXPECT_EQ(PrefixIndex::normalize("VN:123456789"), "vn:123456789");
+    EXPECT_EQ(PrefixIndex::normalize("Trương Ưng Ỷ"), "truong ung y");
+    // Ký tự ngoài bảng bỏ dấu được giữ nguyên
+    EXPECT_EQ(PrefixIndex::normalize("Zoë 東京"), "zoë 東京");
+    EXPECT_EQ(PrefixIndex::normalize("   "), "");
+}
+
+TEST(PrefixIndexTest, FindsWholeValueAndWordPrefixesInKeyOrder) {
+    PrefixIndex names(true);
+    names.append(1, "Nguyễn Văn An");
+    names.append(2, "Trần Thị Bình");
+    names.append(3, "Nguyễn Thị Vân");
+    names.append(4, "Lê Văn Nguyên");
+    names.seal();
+
+    std::vector<int> ids;
+    EXPECT_EQ(names.find("nguy", 10, ids), 3u);
+    // "nguyen" (từ cuối của id 4) < "nguyen thi van" < "nguyen van an"
+    EXPECT_EQ(ids, (std::vector<int>{4, 3, 1}));
+
+    ids.clear();
+    names.find("VĂN", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{3, 1, 4}));
+
+    ids.clear();
+    names.find("thi b", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{2}));
+
+    // Giới hạn tính cả id đã có sẵn; id đã có không bị thêm lại
+    ids = {1};
+    EXPECT_EQ(names.find("nguyen", 2, ids), 1u);
+    EXPECT_EQ(ids, (std::vector<int>{1, 4}));
+
+    ids.clear();
+    EXPECT_EQ(names.find("", 10, ids), 0u);
+    EXPECT_EQ(names.find("x", 10, ids), 0u);
+
+    // Không theo từ: chỉ khớp từ đầu chuỗi
+    PrefixIndex passports;
+    passports.append(1, "VN:123456789");
+    passports.append(2, "US:123456789");
+    passports.seal();
+    ids.clear();
+    passports.find("123", 10, ids);
+    EXPECT_TRUE(ids.empty());
+    passports.find("vn:12", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{1}));
+}
+
+TEST(PrefixIndexTest, SetAndRemoveApplyWithoutRebuildAndSurviveCompaction) {
+    PrefixIndex numbers;
+    for (int id = 1; id <= 100; ++id) numbers.append(id, "TK" + std::to_string(1000 + id));
+    numbers.seal();
+
+    numbers.set(5, "TK9005");           // sửa
+    numbers.remove(6);                  // xóa
+    numbers.set(101, "TK1005");         // thêm, trùng khóa cũ của id 5
+
+    std::vector<int> ids;
+    numbers.find("tk1005", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{101}));
+    ids.clear();
+    numbers.find("tk9", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{5}));
+    ids.clear();
+    numbers.find("tk1006", 10, ids);
+    EXPECT_TRUE(ids.empty());
+
+    // Trộn: đủ nhiều thay đổi để mảng phụ được gộp vào mảng chính
+    for (int id = 200; id < 200 + static_cast<int>(PrefixIndex::MIN_DELTA_BEFORE_COMPACT) + 1; ++id) {
+        numbers.set(id, "TX" + std::to_string(id));
+    }
+    EXPECT_LT(numbers.keyCount(), 100u + PrefixIndex::MIN_DELTA_BEFORE_COMPACT + 10u);
+
+    ids.clear();
+    numbers.find("tk100", 20, ids);
+    EXPECT_EQ(ids, (std::vector<int>{1, 2, 3, 4, 101, 7, 8, 9}));
+    ids.clear();
+    numbers.find("tx1000", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{1000}));
+
+    // Xóa rồi thêm lại cùng id sau khi trộn
+    numbers.remove(5);
+    numbers.set(5, "TK1005");
+    ids.clear();
+    numbers.find("tk1005", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{5, 101}));
+}
+
+TEST(PrefixIndexTest, CompactionReclaimsTextOfReplacedKeys) {
+    PrefixIndex names(true);
+    for (int id = 1; id <= 10; ++id) names.append(id, "Nguyễn Văn Tên" + std::to_string(id));
+    names.seal();
+
+    // Sửa đi sửa lại cùng mười tên: mảng phụ luôn nhỏ nhưng văn bản cũ vẫn phải được thu hồi
+    for (int round = 0; round < 50000; ++round) {
+        int id = round % 10 + 1;
+        names.set(id, (round % 2 ? "Trần Thị Tên" : "Lê Hữu Tên") + std::to_string(id));
+        ASSERT_LE(names.textBytes(), 2 * PrefixIndex::MIN_TEXT_GROWTH_BEFORE_COMPACT);
+    }
+    names.remove(4);
+    names.set(11, std::string(2 * PrefixIndex::MIN_TEXT_GROWTH_BEFORE_COMPACT, 'x'));
+    names.remove(11);
+    // Văn bản đã gỡ được thu hồi ở lần trộn kế tiếp, khi văn bản ghi thêm vượt phần đã có
+    for (int round = 0; round < 10000; ++round) names.set(3, "Phạm Minh Tên3");
+    EXPECT_LT(names.textBytes(), 2 * PrefixIndex::MIN_TEXT_GROWTH_BEFORE_COMPACT);
+    EXPECT_LT(names.keyCount(), 40u);
+
+    // Khóa theo từ vẫn trỏ đúng vào văn bản đã chép lại
+    std::vector<int> ids;
+    names.find("minh ten3", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{3}));
+    ids.clear();
+    names.find("ten1", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{1, 10}));
+    ids.clear();
+    names.find("thi ten", 10, ids);
+    EXPECT_EQ(ids, (std::vector<int>{10, 2, 6, 8}));
+    ids.clear();
+    names.find("nguyen", 10, ids);
+    names.find("ten4", 10, ids);
+    EXPECT_TRUE(ids.empty());
+}
+
+TEST(PrefixIndexTest, LookupStaysFastOnLargeIndex) {
+    // Một triệu tên ba từ: ba triệu khóa
+    const char* family[] = {"Nguyễn", "Trần", "Lê", "Phạm", "Hoàng", "Huỳnh", "Phan", "Vũ", "Võ", "Đặng"};
+    const char* middle[] = {"Văn", "Thị", "Hữu", "Minh", "Ngọc", "Đức", "Thanh", "Quốc"};
+    PrefixIndex names(true);
+    for (int id = 1; id <= 1000000; ++id) {
+        std::string name = std::string(family[id % 10]) + " " + middle[(id / 10) % 8] + " " + "Ten" + std::to_string(id);
+        names.append(id, name);
+    }
+    names.seal();
+    EXPECT_EQ(names.keyCount(), 3000000u);
+
+    std::vector<int> exact;
+    names.find("ten12345", 20, exact);
+    EXPECT_EQ(exact.size(), 11u);   // ten12345 và ten123450..ten123459
+
+    std::vector<int> ids;
+    auto start = std::chrono::steady_clock::now();
+    const int lookups = 1000;
+    for (int i = 0; i < lookups; ++i) {
+        ids.clear();
+        names.find(i % 2 ? "ten12345" : "nguyen van", 20, ids);
+    }
+    auto perLookup = (std::chrono::steady_clock::now() - start) / lookups;
+    EXPECT_LT(perLookup, std::chrono::milliseconds(1));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "../../utils/Tracing.h"
+#include "../../database/InMemoryConnection.h"
+#include "../../repositories/MySQLRepository/AircraftRepository.h"
+#include "../../repositories/MySQLRepository/FlightRepository.h"
+#include "../../repositories/MySQLRepository/PassengerRepository.h"
+#include "../../repositories/MySQLRepository/TicketRepository.h"
+#include "../../services/TicketService.h"
+#include <map>
+#include <memory>
+#include <string>
+
+#define ASSERT_RESULT(result) ASSERT_TRUE(result.has_value())
+
+using namespace Tracing;
+
+class TracingTest : public ::testing::Test {
+protected:
+    std::shared_ptr<Tracer> tracer = Tracer::getInstance();
+
+    void SetUp() override {
+        tracer->enable();
+    }
+
+    void TearDown() override {
+        tracer->disable();
+        tracer->clear();
+    }
+
+    static const SpanEvent* findByName(const std::vector<SpanEvent>& events, const std::string& name) {
+        for (const auto& event : events) {
+            if (event.name == name) return &event;
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(TracingTest, NestedSpansLinkToParent) {
+    {
+        Span outer("outer", "test");
+        {
+            Span inner("inner", "test");
+            inner.setArg("key", "value");
+        }
+        Span early("early", "test");
+        early.end();
+        EXPECT_FALSE(early.isActive());
+        // Sau end() sớm, span tiếp theo lại nhận outer làm cha
+        Span sibling("sibling", "test");
+        EXPECT_EQ(sibling.parentId(), outer.id());
+    }
+
+    auto events = tracer->snapshot();
+    ASSERT_EQ(events.size(), 4u);
+    auto outer = findByName(events, "outer");
+    auto inner = findByName(events, "inner");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(outer->parentId, 0u);
+    EXPECT_EQ(inner->parentId, outer->id);
+    EXPECT_EQ(findByName(events, "early")->parentId, outer->id);
+    EXPECT_GE(outer->durationNanos, inner->durationNanos);
+    ASSERT_EQ(inner->args.size(), 1u);
+    EXPECT_EQ(inner->args[0].second, "value");
+
+    tracer->disable();
+    Span ignored("ignored", "test");
+    EXPECT_FALSE(ignored.isActive());
+    ignored.end();
+    EXPECT_EQ(tracer->snapshot().size(), 4u);
+}
+
+TEST_F(TracingTest, RingBufferKeepsNewestEvents) {
+    tracer->enable(8);
+    for (int i = 0; i < 20; ++i) {
+        Span span("span", "test");
+        span.setArg("i", std::to_string(i));
+    }
+
+    auto events = tracer->snapshot();
+    ASSERT_EQ(events.size(), 8u);
+    EXPECT_EQ(events.front().args[0].second, "12");
+    EXPECT_EQ(events.back().args[0].second, "19");
+    EXPECT_EQ(tracer->droppedEvents(), 12u);
+}
+
+TEST_F(TracingTest, ChromeTraceEscapesStrings) {
+    {
+        Span span("quote\"name", "test");
+        span.setArg("sql", "SELECT 'a\\b'\n");
+    }
+    auto json = tracer->exportChromeTrace();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"quote\\\"name\""), std::string::npos);
+    EXPECT_NE(json.find("\"sql\":\"SELECT 'a\\\\b'\\n\""), std::string::npos);
+}
+
+// Một lần đặt vé: span service -> repository -> SQL
+TEST_F(TracingTest, BookingTraceReachesSql) {
+    auto db = std::make_shared<InMemoryConnection>();
+    auto passengerRepository = std::make_shared<PassengerRepository>(db, nullptr);
+    auto aircraftRepository = std::make_shared<AircraftRepository>(db, nullptr);
+    auto flightRepository = std::make_shared<FlightRepository>(db, nullptr);
+    auto ticketRepository = std::make_shared<TicketRepository>(db, passengerRepository, flightRepository, nullptr);
+    TicketService service(ticketRepository, passengerRepository, flightRepository, aircraftRepository, nullptr);
+
+    auto passenger = passengerRepository->create(
+        Passenger::create("John Doe", "user@example.com|+84123456789|123 Street", "VN:1232323").value());
+    ASSERT_RESULT(passenger);
+    auto aircraft = aircraftRepository->create(
+        Aircraft::create(AircraftSerial::create("HK191").value(), "Boeing 737",
+                         SeatClassMap::create("E:10,B:5,F:2").value()).value());
+    ASSERT_RESULT(aircraft);
+    auto flight = flightRepository->create(
+        Flight::create(FlightNumber::create("HK191").value(),
+                       Route::create("Sai Gon(SGN)-Ha Noi(HAN)").value(),
+                       Schedule::create("2024-03-15 10:00|2024-03-15 12:00").value(),
+                       std::make_shared<Aircraft>(aircraft.value())).value());
+    ASSERT_RESULT(flight);
+
+    tracer->clear();
+    auto ticket = service.bookTicket(passenger.value().getPassport(), flight.value().getFlightNumber(),
+                                     "E01", Price::create("100000 VND").value());
+    ASSERT_RESULT(ticket) << ticket.error().message;
+
+    auto events = tracer->snapshot();
+    std::map<uint64_t, const SpanEvent*> byId;
+    for (const auto& event : events) byId[event.id] = &event;
+
+    auto book = findByName(events, "ticket.book");
+    ASSERT_NE(book, nullptr);
+    EXPECT_EQ(book->category, "service");
+    EXPECT_EQ(book->parentId, 0u);
+
+    // Mọi span khác đều có book là tổ tiên; có ít nhất một lượt SQL nằm dưới repository.create
+    size_t sqlUnderCreate = 0;
+    for (const auto& event : events) {
+        if (event.id == book->id) continue;
+        bool underCreate = false;
+        const SpanEvent* current = &event;
+        while (current->parentId != 0) {
+            ASSERT_TRUE(byId.count(current->parentId)) << event.name;
+            current = byId[current->parentId];
+            if (current->name == "ticket.create" && current->category == "repository") underCreate = true;
+        }
+        EXPECT_EQ(current->id, book->id) << event.name;
+        if (event.category == "sql" && underCreate) {
+            ++sqlUnderCreate;
+            ASSERT_FALSE(event.args.empty());
+            EXPECT_EQ(event.args[0].first, "sql");
+        }
+    }
+    EXPECT_GE(sqlUnderCreate, 1u);
+}
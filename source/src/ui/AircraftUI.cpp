@@ -1,7 +1,42 @@
 #include "AircraftUI.h"
+#include "UiDispatch.h"
 #include <iomanip>
 #include <sstream>
 
+namespace
+{
+    /// Kích thước trang và số trang tối đa giữ trong bộ đệm của danh sách máy bay
+    constexpr size_t AIRCRAFT_PAGE_SIZE = 200;
+    constexpr size_t AIRCRAFT_CACHED_PAGES = 4;
+    /// Thời gian tối đa của một lượt tìm kiếm
+    constexpr std::chrono::seconds SEARCH_TIMEOUT(30);
+
+    wxString AircraftCell(const AircraftListRow &row, long column)
+    {
+        switch (column)
+        {
+        case 0:
+            return wxString::Format("%d", row.id);
+        case 1:
+            return wxString::FromUTF8(row.serial.c_str());
+        case 2:
+            return wxString::FromUTF8(row.model.c_str());
+        case 3:
+            return wxString::Format("%d", row.economySeats);
+        case 4:
+            return wxString::Format("%d", row.businessSeats);
+        case 5:
+            return wxString::Format("%d", row.firstSeats);
+        case 6:
+            return wxString::Format("%d", row.totalSeats());
+        case 7:
+            return "A"; // Default status
+        default:
+            return wxString();
+        }
+    }
+}
+
 /**
  * @brief Enum định nghĩa các ID cho các thành phần UI
  */
@@ -18,7 +53,8 @@ enum
     ID_VIEW_SEAT_CLASSES = 9,      ///< ID nút xem hạng ghế
     ID_VIEW_AVAILABLE_SEATS = 10,  ///< ID nút xem ghế trống
     ID_CHECK_SEAT_AVAILABILITY = 11, ///< ID nút kiểm tra ghế
-    ID_CHECK_AIRCRAFT_EXISTS = 12  ///< ID nút kiểm tra tồn tại
+    ID_CHECK_AIRCRAFT_EXISTS = 12, ///< ID nút kiểm tra tồn tại
+    ID_CANCEL_LOAD = 13            ///< ID nút hủy tải
 };
 
 /**
@@ -33,6 +69,7 @@ EVT_BUTTON(ID_DELETE, AircraftWindow::OnDeleteAircraft)
 EVT_BUTTON(ID_SEARCH_ID, AircraftWindow::OnSearchById)
 EVT_BUTTON(ID_SEARCH_REGISTRATION, AircraftWindow::OnSearchByRegistration)
 EVT_BUTTON(ID_CHECK_AIRCRAFT_EXISTS, AircraftWindow::OnCheckAircraftExists)
+EVT_BUTTON(ID_CANCEL_LOAD, AircraftWindow::OnCancelLoad)
 EVT_LIST_ITEM_SELECTED(ID_AIRCRAFT_LIST, AircraftWindow::OnListItemSelected)
 END_EVENT_TABLE()
 
@@ -45,7 +82,28 @@ END_EVENT_TABLE()
  * @param aircraftService Service quản lý máy bay
  */
 AircraftWindow::AircraftWindow(const wxString &title, std::shared_ptr<AircraftService> aircraftService)
-    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(1000, 600)), aircraftService(aircraftService)
+    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(1000, 600)), aircraftService(aircraftService),
+      asyncServices(MainWindow::getAsyncServices()),
+      aircraftSource(
+          [this](const Async::CallContext &context)
+          {
+              return Async::callService(asyncServices.get(), this->aircraftService, &ApplicationContext::aircraftService, context,
+                                        [](AircraftService &service)
+                                        { return service.countAircraft(); });
+          },
+          [this](const Async::CallContext &context, size_t offset, size_t limit)
+          {
+              return Async::callService(asyncServices.get(), this->aircraftService, &ApplicationContext::aircraftService, context,
+                                        [offset, limit](AircraftService &service) -> Result<std::vector<AircraftListRow>>
+                                        {
+                                            std::vector<AircraftListRow> rows;
+                                            auto loaded = service.getAircraftListPage(offset, limit, rows);
+                                            if (!loaded)
+                                                return Failure<std::vector<AircraftListRow>>(loaded.error());
+                                            return Success(std::move(rows));
+                                        });
+          },
+          PostToUiThread, AIRCRAFT_PAGE_SIZE, AIRCRAFT_CACHED_PAGES)
 {
     // Khởi tạo panel chính
     panel = new wxPanel(this, wxID_ANY);
@@ -69,8 +127,7 @@ AircraftWindow::AircraftWindow(const wxString &title, std::shared_ptr<AircraftSe
     checkAircraftExistsButton = new wxButton(panel, ID_CHECK_AIRCRAFT_EXISTS, "Kiểm tra tồn tại", wxDefaultPosition, wxSize(250, 50));
 
     // Tạo danh sách máy bay
-    aircraftList = new wxListCtrl(panel, ID_AIRCRAFT_LIST, wxDefaultPosition, wxSize(900, 300),
-                                  wxLC_REPORT | wxLC_SINGLE_SEL);
+    aircraftList = new VirtualListCtrl(panel, ID_AIRCRAFT_LIST, wxSize(900, 300), wxLC_SINGLE_SEL);
     aircraftList->InsertColumn(0, "ID");
     aircraftList->InsertColumn(1, "Số đăng ký");
     aircraftList->InsertColumn(2, "Loại máy bay");
@@ -105,8 +162,13 @@ AircraftWindow::AircraftWindow(const wxString &title, std::shared_ptr<AircraftSe
     row2->Add(searchByIdButton, 0, wxALL, 10);
     row2->Add(searchByRegistrationButton, 0, wxALL, 10);
 
+    // Nút hủy lượt tải, chỉ bật khi có lượt đang chạy
+    cancelLoadButton = new wxButton(panel, ID_CANCEL_LOAD, "Hủy tải", wxDefaultPosition, wxSize(250, 50));
+    cancelLoadButton->Disable();
+
     wxBoxSizer *row4 = new wxBoxSizer(wxHORIZONTAL);
     row4->Add(checkAircraftExistsButton, 0, wxALL, 10);
+    row4->Add(cancelLoadButton, 0, wxALL, 10);
 
     contentSizer->Add(row1, 0, wxALIGN_CENTER);
     contentSizer->Add(row2, 0, wxALIGN_CENTER);
@@ -119,7 +181,42 @@ AircraftWindow::AircraftWindow(const wxString &title, std::shared_ptr<AircraftSe
     mainSizer->Add(contentSizer, 1, wxEXPAND);
 
     panel->SetSizer(mainSizer);
+    CreateStatusBar();
     Centre();
+
+    aircraftSource.setListener({
+        .countReady = [this](size_t count)
+        { ShowAircraftList(count); },
+        .rowsReady = [this](size_t first, size_t last)
+        {
+            // Trang về muộn khi danh sách đang hiện kết quả tìm kiếm thì chỉ nằm trong bộ đệm
+            if (searchRows.empty())
+                aircraftList->RefreshRows(static_cast<long>(first), static_cast<long>(last));
+        },
+        .failed = [](const CoreError &error)
+        { wxMessageBox("Không thể lấy danh sách máy bay: " + error.message, "Lỗi", wxOK | wxICON_ERROR); },
+        // Có thể được gọi trong lúc danh sách đang vẽ nên cập nhật trạng thái ở lượt sự kiện sau
+        .loadingChanged = [this](bool)
+        { CallAfter(&AircraftWindow::UpdateLoadStatus); },
+        .countChanged = [this](size_t count, size_t first)
+        {
+            if (!searchRows.empty())
+                return;
+            aircraftList->ResizeRows(static_cast<long>(count), static_cast<long>(first));
+            UpdateLoadStatus();
+        },
+    });
+    changeSubscription = SubscribeOnUiThread(this, Changes::Entity::AIRCRAFT, [this](Changes::Kind kind, int id)
+                                             { aircraftSource.apply(kind, id); });
+}
+
+/**
+ * @brief Destructor, hủy lượt tìm kiếm còn đang chạy để kết quả về muộn bị bỏ qua
+ */
+AircraftWindow::~AircraftWindow()
+{
+    changeSubscription.reset();
+    searchCancellation.cancel();
 }
 
 void AircraftWindow::setServices(std::shared_ptr<AircraftService> aircraft,
@@ -260,7 +357,6 @@ void AircraftWindow::OnAddAircraft(wxCommandEvent &event)
 
         // Show success message
         wxMessageBox("Đã thêm máy bay thành công!", "Thành công", wxOK | wxICON_INFORMATION);
-        RefreshAircraftList();
     }
 
     dialog->Destroy();
@@ -396,7 +492,6 @@ void AircraftWindow::OnEditAircraft(wxCommandEvent &event)
 
         // Show success message
         wxMessageBox("Đã cập nhật thông tin máy bay thành công!", "Thành công", wxOK | wxICON_INFORMATION);
-        RefreshAircraftList();
     }
 
     dialog->Destroy();
@@ -453,7 +548,6 @@ void AircraftWindow::OnDeleteAircraft(wxCommandEvent &event)
 
         // Show success message
         wxMessageBox("Đã xóa máy bay thành công!", "Thành công", wxOK | wxICON_INFORMATION);
-        RefreshAircraftList();
     }
 }
 
@@ -473,38 +567,91 @@ void AircraftWindow::OnListItemSelected(wxListEvent &event)
 /**
  * @brief Làm mới danh sách máy bay
  * 
- * Xóa tất cả các mục trong danh sách và thêm lại từ dịch vụ quản lý máy bay
+ * Đếm lại số máy bay trên worker; danh sách ảo đổi khi có số máy bay và các trang về dần khi cuộn tới
  */
 void AircraftWindow::RefreshAircraftList()
 {
-    aircraftList->DeleteAllItems();
-    auto aircraftsResult = aircraftService->getAllAircraft();
-    if (!aircraftsResult)
-    {
-        wxMessageBox("Không thể lấy danh sách máy bay: " + aircraftsResult.error().message, "Lỗi", wxOK | wxICON_ERROR);
-        return;
-    }
+    aircraftSource.refresh();
+}
 
-    const auto &aircrafts = *aircraftsResult;
-    for (const auto &a : aircrafts)
-    {
-        long index = aircraftList->GetItemCount();
-        aircraftList->InsertItem(index, wxString::Format("%d", a.getId()));
-        aircraftList->SetItem(index, 1, wxString::FromUTF8(a.getSerial().toString().c_str()));
-        aircraftList->SetItem(index, 2, wxString::FromUTF8(a.getModel().c_str()));
-
-        // Display seat counts for each class
-        int economySeats = a.getSeatCount("E");
-        int businessSeats = a.getSeatCount("B");
-        int firstSeats = a.getSeatCount("F");
-        int totalSeats = economySeats + businessSeats + firstSeats;
-
-        aircraftList->SetItem(index, 3, wxString::Format("%d", economySeats));
-        aircraftList->SetItem(index, 4, wxString::Format("%d", businessSeats));
-        aircraftList->SetItem(index, 5, wxString::Format("%d", firstSeats));
-        aircraftList->SetItem(index, 6, wxString::Format("%d", totalSeats));
-        aircraftList->SetItem(index, 7, "A"); // Default status
-    }
+/**
+ * @brief Hiển thị danh sách đầy đủ; hàng chưa có trang hiện "Đang tải..." đến khi trang về
+ *
+ * @param count Tổng số máy bay
+ */
+void AircraftWindow::ShowAircraftList(size_t count)
+{
+    searchRows.clear();
+    aircraftList->ShowRows(
+        static_cast<long>(count),
+        [this](long item, long column)
+        {
+            const AircraftListRow *row = aircraftSource.row(static_cast<size_t>(item));
+            if (row)
+                return AircraftCell(*row, column);
+            return column == 0 ? wxString("Đang tải...") : wxString();
+        },
+        [this](long from, long to)
+        { aircraftSource.prefetch(static_cast<size_t>(from), static_cast<size_t>(to)); });
+    UpdateLoadStatus();
+}
+
+/**
+ * @brief Bật nút hủy khi còn lượt tải đang chạy và ghi trạng thái lên thanh trạng thái
+ */
+void AircraftWindow::UpdateLoadStatus()
+{
+    bool loading = searching || aircraftSource.loading();
+    cancelLoadButton->Enable(loading);
+    if (loading)
+        SetStatusText("Đang tải...");
+    else if (!searchRows.empty())
+        SetStatusText(wxString::Format("Tìm thấy %zu máy bay", searchRows.size()));
+    else if (aircraftSource.stopped())
+        SetStatusText("Đã hủy tải");
+    else
+        SetStatusText(wxString::Format("%zu máy bay", aircraftSource.size()));
+}
+
+/**
+ * @brief Bắt đầu lượt tìm kiếm mới; lượt trước còn chạy bị hủy và kết quả của nó bị bỏ qua
+ *
+ * @return Ngữ cảnh mang token hủy và deadline của lượt tìm kiếm
+ */
+Async::CallContext AircraftWindow::BeginSearch()
+{
+    searchCancellation.cancel();
+    searchCancellation = Async::CancellationSource();
+    searching = true;
+    UpdateLoadStatus();
+    return Async::CallContext::create(SEARCH_TIMEOUT, searchCancellation.token());
+}
+
+void AircraftWindow::EndSearch()
+{
+    searching = false;
+    UpdateLoadStatus();
+}
+
+/**
+ * @brief Hiển thị một máy bay tìm được trong danh sách ảo
+ *
+ * @param aircraft Máy bay tìm được
+ */
+void AircraftWindow::ShowSearchResult(const Aircraft &aircraft)
+{
+    AircraftListRow row;
+    row.id = aircraft.getId();
+    row.serial = aircraft.getSerial().toString();
+    row.model = aircraft.getModel();
+    // Display seat counts for each class
+    row.economySeats = aircraft.getSeatCount("E");
+    row.businessSeats = aircraft.getSeatCount("B");
+    row.firstSeats = aircraft.getSeatCount("F");
+
+    searchRows.assign(1, std::move(row));
+    aircraftList->ShowRows(1, [this](long item, long column)
+                           { return AircraftCell(searchRows[static_cast<size_t>(item)], column); });
 }
 
 /**
@@ -528,48 +675,39 @@ void AircraftWindow::OnSearchById(wxCommandEvent &event)
     }
 
     // Since getAircraftById is private, we need to get all aircraft and find the one with matching ID
-    auto aircraftsResult = aircraftService->getAllAircraft();
-    if (!aircraftsResult)
-    {
-        wxMessageBox("Không thể lấy danh sách máy bay: " + aircraftsResult.error().message, "Lỗi", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    const auto &aircrafts = *aircraftsResult;
-    Aircraft *foundAircraft = nullptr;
-
-    for (const auto &aircraft : aircrafts)
-    {
-        if (aircraft.getId() == searchId)
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), aircraftService, &ApplicationContext::aircraftService, context,
+                           [searchId](AircraftService &service) -> Result<std::optional<Aircraft>>
+                           {
+                               auto aircraftsResult = service.getAllAircraft();
+                               if (!aircraftsResult)
+                                   return Failure<std::optional<Aircraft>>(aircraftsResult.error());
+                               for (const auto &aircraft : *aircraftsResult)
+                               {
+                                   if (aircraft.getId() == searchId)
+                                       return Success(std::optional<Aircraft>(aircraft));
+                               }
+                               return Success(std::optional<Aircraft>());
+                           }),
+        context.cancellation,
+        [this, searchId](Result<std::optional<Aircraft>> result)
         {
-            foundAircraft = const_cast<Aircraft *>(&aircraft);
-            break;
-        }
-    }
-
-    if (!foundAircraft)
-    {
-        wxMessageBox("Không thể tìm thấy máy bay với ID: " + std::to_string(searchId), "Lỗi", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    const Aircraft &a = *foundAircraft;
-    aircraftList->DeleteAllItems();
-    aircraftList->InsertItem(0, wxString::Format("%d", a.getId()));
-    aircraftList->SetItem(0, 1, wxString::FromUTF8(a.getSerial().toString().c_str()));
-    aircraftList->SetItem(0, 2, wxString::FromUTF8(a.getModel().c_str()));
-
-    // Display seat counts for each class
-    int economySeats = a.getSeatCount("E");
-    int businessSeats = a.getSeatCount("B");
-    int firstSeats = a.getSeatCount("F");
-    int totalSeats = economySeats + businessSeats + firstSeats;
-
-    aircraftList->SetItem(0, 3, wxString::Format("%d", economySeats));
-    aircraftList->SetItem(0, 4, wxString::Format("%d", businessSeats));
-    aircraftList->SetItem(0, 5, wxString::Format("%d", firstSeats));
-    aircraftList->SetItem(0, 6, wxString::Format("%d", totalSeats));
-    aircraftList->SetItem(0, 7, "A"); // Default status
+            EndSearch();
+            if (!result)
+            {
+                wxMessageBox("Không thể lấy danh sách máy bay: " + result.error().message, "Lỗi", wxOK | wxICON_ERROR);
+                return;
+            }
+            if (!result.value())
+            {
+                wxMessageBox("Không thể tìm thấy máy bay với ID: " + std::to_string(searchId), "Lỗi", wxOK | wxICON_ERROR);
+                return;
+            }
+
+            ShowSearchResult(*result.value());
+            UpdateLoadStatus();
+        });
 }
 
 /**
@@ -585,30 +723,24 @@ void AircraftWindow::OnSearchByRegistration(wxCommandEvent &event)
     if (registration.IsEmpty())
         return;
 
-    auto aircraftResult = aircraftService->getAircraft(AircraftSerial::create(registration.ToStdString()).value());
-    if (!aircraftResult)
-    {
-        wxMessageBox("Không thể tìm thấy máy bay: " + aircraftResult.error().message, "Lỗi", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    const Aircraft &a = *aircraftResult;
-    aircraftList->DeleteAllItems();
-    aircraftList->InsertItem(0, wxString::Format("%d", a.getId()));
-    aircraftList->SetItem(0, 1, wxString::FromUTF8(a.getSerial().toString().c_str()));
-    aircraftList->SetItem(0, 2, wxString::FromUTF8(a.getModel().c_str()));
-
-    // Display seat counts for each class
-    int economySeats = a.getSeatCount("E");
-    int businessSeats = a.getSeatCount("B");
-    int firstSeats = a.getSeatCount("F");
-    int totalSeats = economySeats + businessSeats + firstSeats;
-
-    aircraftList->SetItem(0, 3, wxString::Format("%d", economySeats));
-    aircraftList->SetItem(0, 4, wxString::Format("%d", businessSeats));
-    aircraftList->SetItem(0, 5, wxString::Format("%d", firstSeats));
-    aircraftList->SetItem(0, 6, wxString::Format("%d", totalSeats));
-    aircraftList->SetItem(0, 7, "A"); // Default status
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), aircraftService, &ApplicationContext::aircraftService, context,
+                           [serial = AircraftSerial::create(registration.ToStdString()).value()](AircraftService &service)
+                           { return service.getAircraft(serial); }),
+        context.cancellation,
+        [this](Result<Aircraft> aircraftResult)
+        {
+            EndSearch();
+            if (!aircraftResult)
+            {
+                wxMessageBox("Không thể tìm thấy máy bay: " + aircraftResult.error().message, "Lỗi", wxOK | wxICON_ERROR);
+                return;
+            }
+
+            ShowSearchResult(*aircraftResult);
+            UpdateLoadStatus();
+        });
 }
 
 /**
@@ -648,4 +780,18 @@ void AircraftWindow::OnCheckAircraftExists(wxCommandEvent &event)
         exists ? "✅ TỒN TẠI trong hệ thống" : "❌ KHÔNG TỒN TẠI trong hệ thống");
 
     wxMessageBox(message, "Kết quả kiểm tra", wxOK | wxICON_INFORMATION);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Sự kiện nhấn nút hủy tải
+ * 
+ * Hủy lượt tìm kiếm và lượt nạp danh sách đang chạy; các trang đã nạp được giữ lại
+ * 
+ * @param event Sự kiện nút bấm
+ */
+void AircraftWindow::OnCancelLoad(wxCommandEvent &event)
+{
+    searchCancellation.cancel();
+    aircraftSource.cancel();
+    EndSearch();
+}
@@ -4,8 +4,10 @@
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include "MainUI.h"
+#include "VirtualListCtrl.h"
 #include "core/entities/Aircraft.h"
 #include "services/AircraftService.h"
+#include "async/AsyncRowSource.h"
 
 /**
  * @brief Cửa sổ quản lý máy bay
@@ -23,6 +25,11 @@ public:
      */
     AircraftWindow(const wxString &title, std::shared_ptr<AircraftService> aircraftService);
 
+    /**
+     * @brief Destructor, hủy các lượt tải còn đang chạy
+     */
+    ~AircraftWindow();
+
     /**
      * @brief Thiết lập các service cần thiết cho việc điều hướng
      * @param aircraft Service quản lý máy bay
@@ -91,10 +98,44 @@ private:
     void OnListItemSelected(wxListEvent &event);
 
     /**
-     * @brief Làm mới danh sách máy bay
+     * @brief Xử lý sự kiện hủy lượt tải đang chạy
+     * @param event Sự kiện nút bấm
+     */
+    void OnCancelLoad(wxCommandEvent &event);
+
+    /**
+     * @brief Làm mới danh sách máy bay: đếm lại số máy bay trên worker, các trang được nạp dần khi cuộn tới
      */
     void RefreshAircraftList();
 
+    /**
+     * @brief Hiển thị danh sách đầy đủ với số máy bay vừa đếm được
+     * @param count Tổng số máy bay
+     */
+    void ShowAircraftList(size_t count);
+
+    /**
+     * @brief Cập nhật nút hủy và thanh trạng thái theo các lượt tải đang chạy
+     */
+    void UpdateLoadStatus();
+
+    /**
+     * @brief Bắt đầu một lượt tìm kiếm mới, hủy lượt trước nếu còn chạy
+     * @return Ngữ cảnh của lượt tìm kiếm
+     */
+    Async::CallContext BeginSearch();
+
+    /**
+     * @brief Kết thúc lượt tìm kiếm đang chạy khi kết quả đã về luồng giao diện
+     */
+    void EndSearch();
+
+    /**
+     * @brief Hiển thị một máy bay tìm được trong danh sách ảo
+     * @param aircraft Máy bay tìm được
+     */
+    void ShowSearchResult(const Aircraft &aircraft);
+
     /// Panel chính chứa các thành phần giao diện
     wxPanel *panel;
     /// Sizer chính để quản lý layout
@@ -115,8 +156,10 @@ private:
     wxButton *searchByRegistrationButton;
     /// Nút kiểm tra sự tồn tại của máy bay
     wxButton *checkAircraftExistsButton;
-    /// Danh sách hiển thị thông tin máy bay
-    wxListCtrl *aircraftList;
+    /// Nút hủy lượt tải đang chạy
+    wxButton *cancelLoadButton;
+    /// Danh sách ảo hiển thị thông tin máy bay
+    VirtualListCtrl *aircraftList;
     /// Label hiển thị thông tin bổ sung
     wxStaticText *infoLabel;
 
@@ -129,6 +172,19 @@ private:
     /// Service quản lý vé máy bay
     std::shared_ptr<TicketService> ticketService;
 
+    /// Facade bất đồng bộ; null thì service được gọi đồng bộ trên luồng giao diện
+    std::shared_ptr<Async::AsyncServices> asyncServices;
+    /// Số máy bay và các trang hàng máy bay của danh sách đầy đủ, nạp trên worker theo vùng đang cuộn tới
+    Async::AsyncRowSource<AircraftListRow> aircraftSource;
+    /// Kết quả tìm kiếm đang hiển thị
+    std::vector<AircraftListRow> searchRows;
+    /// Hủy lượt tìm kiếm đang chạy khi có lượt mới, khi bấm hủy hoặc khi đóng cửa sổ
+    Async::CancellationSource searchCancellation;
+    /// Có lượt tìm kiếm đang chạy
+    bool searching = false;
+    /// Thay đổi máy bay từ repository, áp dụng vào danh sách tại chỗ thay cho nạp lại toàn bộ
+    Changes::Subscription changeSubscription;
+
     DECLARE_EVENT_TABLE()
 };
 
@@ -1,5 +1,7 @@
 #include "FlightUI.h"
+#include "UiDispatch.h"
 #include "utils/utils.h"
+#include "utils/Tracing.h"
 #include "../core/value_objects/flight_number/FlightNumber.h"
 #include "../core/value_objects/route/Route.h"
 #include "../core/value_objects/schedule/Schedule.h"
@@ -25,9 +27,21 @@ enum
     ID_SEARCH_ID = 7,
     ID_SEARCH_FLIGHT_NUMBER = 8,
     ID_VIEW_AVAILABLE_SEATS = 9,
-    ID_CHECK_SEAT_AVAILABILITY = 10
+    ID_CHECK_SEAT_AVAILABILITY = 10,
+    ID_CANCEL_LOAD = 11,
+    ID_QUICK_SEARCH = 12,
+    ID_QUICK_SEARCH_TIMER = 13
 };
 
+/// Kích thước trang và số trang tối đa giữ trong bộ đệm của danh sách chuyến bay
+static constexpr size_t FLIGHT_PAGE_SIZE = 200;
+static constexpr size_t FLIGHT_CACHED_PAGES = 4;
+/// Thời gian tối đa của một lượt tìm kiếm
+static constexpr std::chrono::seconds SEARCH_TIMEOUT(30);
+/// Thời gian chờ sau lần gõ cuối trước khi tìm nhanh, và số gợi ý tối đa
+static constexpr int QUICK_SEARCH_DELAY_MS = 200;
+static constexpr size_t QUICK_SEARCH_LIMIT = 100;
+
 wxBEGIN_EVENT_TABLE(FlightWindow, wxFrame)
     EVT_BUTTON(ID_BACK, FlightWindow::OnBack)
         EVT_BUTTON(ID_SHOW, FlightWindow::OnShowFlight)
@@ -39,10 +53,48 @@ wxBEGIN_EVENT_TABLE(FlightWindow, wxFrame)
                                 EVT_BUTTON(ID_VIEW_AVAILABLE_SEATS, FlightWindow::OnViewAvailableSeats)
                                     EVT_BUTTON(ID_CHECK_SEAT_AVAILABILITY, FlightWindow::OnCheckSeatAvailability)
                                         EVT_LIST_ITEM_SELECTED(ID_FLIGHT_LIST, FlightWindow::OnListItemSelected)
+                                            EVT_BUTTON(ID_CANCEL_LOAD, FlightWindow::OnCancelLoad)
+                                                EVT_TEXT(ID_QUICK_SEARCH, FlightWindow::OnQuickSearchText)
+                                                    EVT_TIMER(ID_QUICK_SEARCH_TIMER, FlightWindow::OnQuickSearchTimer)
                                             wxEND_EVENT_TABLE()
 
                                                 FlightWindow::FlightWindow(const wxString &title, std::shared_ptr<FlightService> flightService)
-    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(1400, 700)), flightService(flightService)
+    : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(1400, 700)), flightService(flightService),
+      asyncServices(MainWindow::getAsyncServices()),
+      referenceData(MainWindow::getReferenceData()),
+      flightSource(
+          [this](const Async::CallContext &context)
+          {
+              // Lần hiện đầu tiên lấy từ ảnh chụp nạp lúc khởi động, không chờ cơ sở dữ liệu
+              if (referenceData)
+                  return Async::makeReadyFuture(Result<size_t>(Success(referenceData->flights.size())));
+              return Async::callService(asyncServices.get(), this->flightService, &ApplicationContext::flightService, context,
+                                        [](FlightService &service)
+                                        { return service.countFlights(); });
+          },
+          [this](const Async::CallContext &context, size_t offset, size_t limit)
+          {
+              if (referenceData)
+              {
+                  // Ảnh chụp cùng thứ tự id với truy vấn trang nên vị trí hàng khớp nhau
+                  const auto &flights = referenceData->flights;
+                  size_t first = std::min(offset, flights.size());
+                  size_t last = std::min(first + limit, flights.size());
+                  return Async::makeReadyFuture(Result<std::vector<FlightSummaryRow>>(
+                      Success(std::vector<FlightSummaryRow>(flights.begin() + first, flights.begin() + last))));
+              }
+              // Mỗi trang kèm số ghế đã đặt theo hạng từ truy vấn gộp trên khoảng ID của trang
+              return Async::callService(asyncServices.get(), this->flightService, &ApplicationContext::flightService, context,
+                                        [offset, limit](FlightService &service) -> Result<std::vector<FlightSummaryRow>>
+                                        {
+                                            std::vector<FlightSummaryRow> rows;
+                                            auto loaded = service.getFlightSummariesPage(offset, limit, rows);
+                                            if (!loaded)
+                                                return Failure<std::vector<FlightSummaryRow>>(loaded.error());
+                                            return Success(std::move(rows));
+                                        });
+          },
+          PostToUiThread, FLIGHT_PAGE_SIZE, FLIGHT_CACHED_PAGES)
 {
     panel = new wxPanel(this, wxID_ANY);
     mainSizer = new wxBoxSizer(wxVERTICAL);
@@ -83,12 +135,23 @@ wxBEGIN_EVENT_TABLE(FlightWindow, wxFrame)
     buttonRow2->Add(viewAvailableSeatsButton, 0, wxALL, 10);
     buttonRow2->Add(checkSeatAvailabilityButton, 0, wxALL, 10);
 
+    cancelLoadButton = new wxButton(panel, ID_CANCEL_LOAD, "Hủy tải", wxDefaultPosition, wxSize(120, 50));
+    cancelLoadButton->Disable();
+    buttonRow2->Add(cancelLoadButton, 0, wxALL, 10);
+
+    wxBoxSizer *quickSearchRow = new wxBoxSizer(wxHORIZONTAL);
+    quickSearchCtrl = new wxTextCtrl(panel, ID_QUICK_SEARCH, wxEmptyString, wxDefaultPosition, wxSize(300, 30));
+    quickSearchCtrl->SetHint("Số hiệu chuyến bay...");
+    quickSearchTimer.SetOwner(this, ID_QUICK_SEARCH_TIMER);
+    quickSearchRow->Add(new wxStaticText(panel, wxID_ANY, "Tìm nhanh:"), 0, wxALL | wxALIGN_CENTER_VERTICAL, 10);
+    quickSearchRow->Add(quickSearchCtrl, 0, wxALL | wxALIGN_CENTER_VERTICAL, 10);
+
     mainSizer->Add(buttonRow1, 0, wxALIGN_CENTER);
     mainSizer->Add(buttonRow2, 0, wxALIGN_CENTER);
+    mainSizer->Add(quickSearchRow, 0, wxALIGN_CENTER);
 
     // Flight list
-    flightList = new wxListCtrl(panel, ID_FLIGHT_LIST, wxDefaultPosition, wxSize(1300, 400),
-                                wxLC_REPORT | wxLC_SINGLE_SEL | wxBORDER_SUNKEN);
+    flightList = new VirtualListCtrl(panel, ID_FLIGHT_LIST, wxSize(1300, 400), wxLC_SINGLE_SEL | wxBORDER_SUNKEN);
     flightList->InsertColumn(0, "ID", wxLIST_FORMAT_LEFT, 60);
     flightList->InsertColumn(1, "Số hiệu", wxLIST_FORMAT_LEFT, 120);
     flightList->InsertColumn(2, "Điểm đi", wxLIST_FORMAT_LEFT, 140);
@@ -103,11 +166,47 @@ wxBEGIN_EVENT_TABLE(FlightWindow, wxFrame)
     mainSizer->Add(flightList, 1, wxEXPAND | wxALL, 20);
 
     panel->SetSizer(mainSizer);
+    CreateStatusBar();
     Centre();
 
     // Đăng ký sự kiện
     viewAvailableSeatsButton->Bind(wxEVT_BUTTON, &FlightWindow::OnViewAvailableSeats, this);
     checkSeatAvailabilityButton->Bind(wxEVT_BUTTON, &FlightWindow::OnCheckSeatAvailability, this);
+
+    flightSource.setListener({
+        .countReady = [this](size_t count)
+        { populateFlightList(count); },
+        .rowsReady = [this](size_t first, size_t last)
+        {
+            // Trang về muộn khi danh sách đang hiện kết quả tìm kiếm thì chỉ nằm trong bộ đệm
+            if (searchRows.empty())
+                flightList->RefreshRows(static_cast<long>(first), static_cast<long>(last));
+        },
+        .failed = [this](const CoreError &)
+        {
+            flightList->ClearRows();
+            SetStatusText("Không thể tải danh sách chuyến bay");
+        },
+        // Có thể được gọi trong lúc danh sách đang vẽ nên cập nhật trạng thái ở lượt sự kiện sau
+        .loadingChanged = [this](bool)
+        { CallAfter(&FlightWindow::UpdateLoadStatus); },
+        .countChanged = [this](size_t count, size_t first)
+        {
+            if (!searchRows.empty())
+                return;
+            flightList->ResizeRows(static_cast<long>(count), static_cast<long>(first));
+            UpdateLoadStatus();
+        },
+    });
+    changeSubscription = SubscribeOnUiThread(this, Changes::Entity::FLIGHT, [this](Changes::Kind kind, int id)
+                                             {
+                                                 // Hàng nạp lại phải đến từ cơ sở dữ liệu
+                                                 referenceData.reset();
+                                                 flightSource.apply(kind, id); });
+
+    // Có ảnh chụp còn đúng thì hiện danh sách ngay, không tốn truy vấn nào
+    if (referenceData)
+        RefreshFlightList();
 }
 
 void FlightWindow::setServices(std::shared_ptr<AircraftService> aircraft,
@@ -121,6 +220,13 @@ void FlightWindow::setServices(std::shared_ptr<AircraftService> aircraft,
     this->ticketService = ticket;
 }
 
+FlightWindow::~FlightWindow()
+{
+    changeSubscription.reset();
+    quickSearchTimer.Stop();
+    searchCancellation.cancel();
+}
+
 void FlightWindow::OnBack(wxCommandEvent &event)
 {
     this->Hide();
@@ -135,6 +241,8 @@ void FlightWindow::OnBack(wxCommandEvent &event)
 
 void FlightWindow::OnShowFlight(wxCommandEvent &event)
 {
+    // Người dùng yêu cầu làm mới: đọc cơ sở dữ liệu thay cho ảnh chụp lúc khởi động
+    referenceData.reset();
     RefreshFlightList();
 }
 
@@ -290,7 +398,9 @@ void FlightWindow::OnAddFlight(wxCommandEvent &event)
         }
 
         // Lưu chuyến bay vào database
+        Tracing::Span span("FlightWindow.add_flight", "ui");
         auto createResult = flightService->createFlight(flightResult.value());
+        span.end();
         if (!createResult)
         {
             wxMessageBox("Lỗi khi thêm chuyến bay: " + createResult.error().message, "Lỗi", wxOK | wxICON_ERROR);
@@ -298,29 +408,8 @@ void FlightWindow::OnAddFlight(wxCommandEvent &event)
             return;
         }
 
-        // Kiểm tra lại danh sách chuyến bay vừa lấy về
-        bool found = false;
-        auto allFlightsResult = flightService->getAllFlights();
-        if (allFlightsResult)
-        {
-            for (const auto &f : allFlightsResult.value())
-            {
-                if (f.getFlightNumber().toString() == flightNumber)
-                {
-                    found = true;
-                    break;
-                }
-            }
-        }
-        if (!found)
-        {
-            wxMessageBox("Đã thêm chuyến bay nhưng không thấy trong danh sách! Có thể database hoặc service đang lỗi. Vui lòng kiểm tra lại.", "Cảnh báo", wxOK | wxICON_WARNING);
-        }
-        else
-        {
-            wxMessageBox("Thêm chuyến bay thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
-        }
-        RefreshFlightList();
+        // Danh sách tự thêm hàng mới qua sự kiện thay đổi của repository
+        wxMessageBox("Thêm chuyến bay thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
     }
     dialog->Destroy();
 }
@@ -505,6 +594,7 @@ void FlightWindow::OnEditFlight(wxCommandEvent &event)
 
             // Get the flight ID from the existing flight
             int existingFlightId = existingFlightResult.value().getId();
+            int existingFlightVersion = existingFlightResult.value().getVersion();
 
             // Create FlightNumber value object
             auto flightNumberResult = FlightNumber::create(flightNumber);
@@ -590,10 +680,13 @@ void FlightWindow::OnEditFlight(wxCommandEvent &event)
             // Set the ID and status for the updated flight
             auto updatedFlight = updatedFlightResult.value();
             updatedFlight.setId(existingFlightId);
+            updatedFlight.setVersion(existingFlightVersion);
             updatedFlight.setStatus(flightStatus);
 
             // Update the flight in the database
+            Tracing::Span span("FlightWindow.edit_flight", "ui");
             auto updateResult = flightService->updateFlight(updatedFlight);
+            span.end();
             if (!updateResult)
             {
                 wxMessageBox("Lỗi khi cập nhật chuyến bay: " + updateResult.error().message,
@@ -603,7 +696,6 @@ void FlightWindow::OnEditFlight(wxCommandEvent &event)
             }
 
             wxMessageBox("Cập nhật chuyến bay thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
-            RefreshFlightList();
         }
         catch (const std::exception &e)
         {
@@ -640,6 +732,7 @@ void FlightWindow::OnDeleteFlight(wxCommandEvent &event)
             wxMessageBox("Số hiệu chuyến bay không hợp lệ!", "Lỗi", wxOK | wxICON_ERROR);
             return;
         }
+        Tracing::Span span("FlightWindow.delete_flight", "ui");
         // Lấy flight để log ID
         auto flightResult = flightService->getFlight(flightNumberResult.value());
         int flightId = -1;
@@ -649,6 +742,7 @@ void FlightWindow::OnDeleteFlight(wxCommandEvent &event)
         }
         // wxLogMessage("[DEBUG] Đang xóa chuyến bay: %s, ID: %d", flightNumber, flightId);
         auto result = flightService->deleteFlight(flightNumberResult.value());
+        span.end();
         if (!result)
         {
             wxString errMsg = result.error().message;
@@ -670,7 +764,6 @@ void FlightWindow::OnDeleteFlight(wxCommandEvent &event)
             }
             return;
         }
-        RefreshFlightList();
     }
 }
 
@@ -687,69 +780,47 @@ void FlightWindow::OnSearchById(wxCommandEvent &event)
             return;
         }
 
-        // Clear current list
-        flightList->DeleteAllItems();
-
         // Search through all flights to find the one with matching ID
-        auto result = flightService->getAllFlights();
-        if (result.has_value())
-        {
-            const auto &flights = result.value();
-            bool found = false;
-            for (const auto &flight : flights)
+        auto context = BeginSearch();
+        DeliverOnUiThread(
+            Async::callService(asyncServices.get(), flightService, &ApplicationContext::flightService, context,
+                               [id](FlightService &service) -> Result<std::optional<Flight>>
+                               {
+                                   auto result = service.getAllFlights();
+                                   if (!result)
+                                       return Failure<std::optional<Flight>>(result.error());
+                                   for (const auto &flight : result.value())
+                                   {
+                                       if (flight.getId() == id)
+                                           return Success(std::optional<Flight>(flight));
+                                   }
+                                   return Success(std::optional<Flight>());
+                               }),
+            context.cancellation,
+            [this, id](Result<std::optional<Flight>> result)
             {
-                if (flight.getId() == id)
+                EndSearch();
+                if (!result.has_value())
                 {
-                    long index = flightList->InsertItem(0, wxString::Format("%d", flight.getId()));
-                    flightList->SetItem(index, 1, flight.getFlightNumber().toString());
-                    flightList->SetItem(index, 2, flight.getRoute().getOrigin());
-                    flightList->SetItem(index, 3, flight.getRoute().getDestination());
-
-                    // Parse schedule information properly
-                    const auto &schedule = flight.getSchedule();
-                    const std::tm &departure = schedule.getDeparture();
-                    const std::tm &arrival = schedule.getArrival();
-
-                    // Set departure date and time using utils function
-                    std::string departureDateTime = convertTimeToString(departure);
-                    flightList->SetItem(index, 4, departureDateTime.substr(0, 10)); // Date: YYYY-MM-DD
-                    flightList->SetItem(index, 5, departureDateTime.substr(11, 5)); // Time: HH:MM
-
-                    // Set arrival date and time using utils function
-                    std::string arrivalDateTime = convertTimeToString(arrival);
-                    flightList->SetItem(index, 6, arrivalDateTime.substr(0, 10)); // Date: YYYY-MM-DD
-                    flightList->SetItem(index, 7, arrivalDateTime.substr(11, 5)); // Time: HH:MM
-
-                    // Aircraft info
-                    if (flight.getAircraft())
-                    {
-                        flightList->SetItem(index, 8, flight.getAircraft()->getSerial().toString());
-                    }
-                    else
-                    {
-                        flightList->SetItem(index, 8, "N/A");
-                    }
-
-                    // Status
-                    flightList->SetItem(index, 9, "SCHEDULED");
-                    found = true;
-                    break;
+                    searchRows.clear();
+                    flightList->ClearRows();
+                    wxMessageBox("Không thể tải danh sách chuyến bay", "Lỗi", wxOK | wxICON_ERROR);
+                    return;
                 }
-            }
 
-            if (found)
-            {
-                // infoLabel->SetLabel(wxString::Format("Tìm thấy chuyến bay có ID: %ld", id));
-            }
-            else
-            {
-                // infoLabel->SetLabel(wxString::Format("Không tìm thấy chuyến bay có ID: %ld", id));
-            }
-        }
-        else
-        {
-            wxMessageBox("Không thể tải danh sách chuyến bay", "Lỗi", wxOK | wxICON_ERROR);
-        }
+                if (result.value())
+                {
+                    ShowSearchResult(*result.value());
+                    UpdateLoadStatus();
+                }
+                else
+                {
+                    // Clear current list
+                    searchRows.clear();
+                    flightList->ClearRows();
+                    SetStatusText(wxString::Format("Không tìm thấy chuyến bay có ID: %ld", id));
+                }
+            });
     }
 }
 
@@ -765,64 +836,101 @@ void FlightWindow::OnSearchByFlightNumber(wxCommandEvent &event)
             return;
         }
 
-        // Clear current list
-        flightList->DeleteAllItems();
-
         // Create FlightNumber object and search
         auto flightNumberResult = FlightNumber::create(flightNumber.ToStdString());
         if (flightNumberResult.has_value())
         {
-            auto result = flightService->getFlight(flightNumberResult.value());
-            if (result.has_value())
-            {
-                const auto &flight = result.value();
-                long index = flightList->InsertItem(0, wxString::Format("%d", flight.getId()));
-                flightList->SetItem(index, 1, flight.getFlightNumber().toString());
-                flightList->SetItem(index, 2, flight.getRoute().getOrigin());
-                flightList->SetItem(index, 3, flight.getRoute().getDestination());
-
-                // Parse schedule information properly
-                const auto &schedule = flight.getSchedule();
-                const std::tm &departure = schedule.getDeparture();
-                const std::tm &arrival = schedule.getArrival();
-
-                // Set departure date and time using utils function
-                std::string departureDateTime = convertTimeToString(departure);
-                flightList->SetItem(index, 4, departureDateTime.substr(0, 10)); // Date: YYYY-MM-DD
-                flightList->SetItem(index, 5, departureDateTime.substr(11, 5)); // Time: HH:MM
-
-                // Set arrival date and time using utils function
-                std::string arrivalDateTime = convertTimeToString(arrival);
-                flightList->SetItem(index, 6, arrivalDateTime.substr(0, 10)); // Date: YYYY-MM-DD
-                flightList->SetItem(index, 7, arrivalDateTime.substr(11, 5)); // Time: HH:MM
-
-                // Aircraft info
-                if (flight.getAircraft())
-                {
-                    flightList->SetItem(index, 8, flight.getAircraft()->getSerial().toString());
-                }
-                else
+            auto context = BeginSearch();
+            DeliverOnUiThread(
+                Async::callService(asyncServices.get(), flightService, &ApplicationContext::flightService, context,
+                                   [number = flightNumberResult.value()](FlightService &service)
+                                   { return service.getFlight(number); }),
+                context.cancellation,
+                [this, flightNumber](Result<Flight> result)
                 {
-                    flightList->SetItem(index, 8, "N/A");
-                }
-
-                // Status
-                flightList->SetItem(index, 9, "SCHEDULED");
-
-                // infoLabel->SetLabel(wxString::Format("Tìm thấy chuyến bay: %s", flightNumber));
-            }
-            else
-            {
-                // infoLabel->SetLabel(wxString::Format("Không tìm thấy chuyến bay: %s", flightNumber));
-            }
+                    EndSearch();
+                    if (result.has_value())
+                    {
+                        ShowSearchResult(result.value());
+                        UpdateLoadStatus();
+                    }
+                    else
+                    {
+                        // Clear current list
+                        searchRows.clear();
+                        flightList->ClearRows();
+                        SetStatusText(wxString::Format("Không tìm thấy chuyến bay: %s", flightNumber));
+                    }
+                });
         }
         else
         {
+            flightList->ClearRows();
             wxMessageBox("Số hiệu chuyến bay không hợp lệ", "Lỗi", wxOK | wxICON_ERROR);
         }
     }
 }
 
+void FlightWindow::OnCancelLoad(wxCommandEvent &event)
+{
+    searchCancellation.cancel();
+    flightSource.cancel();
+    EndSearch();
+}
+
+void FlightWindow::OnQuickSearchText(wxCommandEvent &event)
+{
+    // Mỗi lần gõ hẹn lại từ đầu nên chỉ lần gõ cuối trong một chuỗi gõ nhanh mới gây ra tìm kiếm
+    quickSearchTimer.StartOnce(QUICK_SEARCH_DELAY_MS);
+}
+
+void FlightWindow::OnQuickSearchTimer(wxTimerEvent &event)
+{
+    std::string text = quickSearchCtrl->GetValue().utf8_string();
+    if (text.find_first_not_of(" \t") == std::string::npos)
+    {
+        // Ô tìm trống: trở lại danh sách đầy đủ đang có trong bộ đệm
+        searchCancellation.cancel();
+        EndSearch();
+        populateFlightList(flightSource.size());
+        return;
+    }
+
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), flightService, &ApplicationContext::flightService, context,
+                           [text](FlightService &service) -> Result<std::vector<FlightSummaryRow>>
+                           {
+                               std::vector<FlightSummaryRow> rows;
+                               auto found = service.suggestFlights(text, QUICK_SEARCH_LIMIT, rows);
+                               if (!found)
+                                   return Failure<std::vector<FlightSummaryRow>>(found.error());
+                               return Success(std::move(rows));
+                           }),
+        context.cancellation,
+        [this](Result<std::vector<FlightSummaryRow>> rowsResult)
+        {
+            EndSearch();
+            if (!rowsResult)
+            {
+                SetStatusText(wxString::Format("Lỗi tìm nhanh: %s", rowsResult.error().message.c_str()));
+                return;
+            }
+
+            searchRows = std::move(*rowsResult);
+            if (searchRows.empty())
+            {
+                flightList->ClearRows();
+                SetStatusText("Không tìm thấy chuyến bay");
+                return;
+            }
+            // Gợi ý đã kèm số ghế đã đặt nên hiện đủ mọi cột
+            flightList->ShowRows(static_cast<long>(searchRows.size()), [this](long item, long column)
+                                 { return FlightCell(searchRows[static_cast<size_t>(item)], column); });
+            UpdateLoadStatus();
+        });
+}
+
 void FlightWindow::OnListItemSelected(wxListEvent &event)
 {
     long item = event.GetIndex();
@@ -832,37 +940,16 @@ void FlightWindow::OnListItemSelected(wxListEvent &event)
     }
 }
 
-std::string FlightWindow::getSeatInfo(const Flight &flight)
+std::string FlightWindow::getSeatInfo(const FlightSummaryRow &row)
 {
-    if (!flight.getAircraft())
-    {
-        return "N/A";
-    }
-
-    const auto &seatLayout = flight.getAircraft()->getSeatLayout();
     std::stringstream ss;
 
-    // Get total seats and available seats
-    int totalSeats = seatLayout.getTotalSeatCount();
-    int availableSeats = seatLayout.getTotalAvailableSeatCount();
-
-    // Get seats by class
-    int economySeats = 0;
-    int businessSeats = 0;
-    int firstSeats = 0;
-
-    for (const auto &[seatClass, count] : seatLayout.getSeatCounts())
-    {
-        if (seatClass.getCode() == "E")
-            economySeats = seatLayout.getAvailableSeatCount("E");
-        else if (seatClass.getCode() == "B")
-            businessSeats = seatLayout.getAvailableSeatCount("B");
-        else if (seatClass.getCode() == "F")
-            firstSeats = seatLayout.getAvailableSeatCount("F");
-    }
+    int economySeats = row.economySeats - row.bookedEconomy;
+    int businessSeats = row.businessSeats - row.bookedBusiness;
+    int firstSeats = row.firstSeats - row.bookedFirst;
 
     // Format seat information
-    ss << "Tổng: " << totalSeats << " ghế, Còn trống: " << availableSeats << " ghế (";
+    ss << "Tổng: " << row.totalSeats() << " ghế, Còn trống: " << row.availableSeats() << " ghế (";
     if (economySeats > 0)
         ss << "E:" << economySeats;
     if (businessSeats > 0)
@@ -874,163 +961,113 @@ std::string FlightWindow::getSeatInfo(const Flight &flight)
     return ss.str();
 }
 
-// Hàm đồng bộ số ghế đã đặt từ vé vào chuyến bay
-void syncBookedSeatsWithTickets(const std::vector<Ticket> &tickets, std::vector<Flight> &flights)
+void FlightWindow::RefreshFlightList()
 {
-    std::map<std::string, Flight *> flightMap;
-    for (auto &flight : flights)
-    {
-        flightMap[flight.getFlightNumber().toString()] = &flight;
-        if (flight.getAircraft())
-        {
-            auto aircraft = flight.getAircraft();
-            auto seatLayout = aircraft->getSeatLayout();
-            seatLayout.initializeBookedSeats();
-            aircraft->setSeatLayout(seatLayout);
-        }
-    }
-    for (const auto &ticket : tickets)
-    {
-        auto flightNum = ticket.getFlight()->getFlightNumber().toString();
-        auto seatNum = ticket.getSeatNumber().toString();
-        std::string seatClass = seatNum.substr(0, 1); // E/B/F
-        if (flightMap.count(flightNum) && flightMap[flightNum]->getAircraft())
-        {
-            auto aircraft = flightMap[flightNum]->getAircraft();
-            auto seatLayout = aircraft->getSeatLayout();
-            seatLayout.bookSeat(seatClass);
-            aircraft->setSeatLayout(seatLayout);
-        }
-    }
+    Tracing::Span span("FlightWindow.refresh", "ui");
+    // Chỉ xếp lượt đếm lên worker; danh sách cũ vẫn hiển thị cho đến khi có số chuyến bay
+    // Span kết thúc ngay, nhưng Executor gắn nó làm cha cho các span service và SQL trên worker
+    flightSource.refresh();
 }
 
-void FlightWindow::RefreshFlightList()
+void FlightWindow::populateFlightList(size_t count)
 {
-    flightList->DeleteAllItems();
-
-    // Lấy danh sách chuyến bay và vé
-    auto result = flightService->getAllFlights();
-    std::vector<Flight> flights;
-    if (result.has_value())
-        flights = result.value();
-    else
-    {
-        // infoLabel->SetLabel("Không thể tải danh sách chuyến bay");
-        return;
-    }
-    std::vector<Ticket> tickets;
-    if (ticketService)
-    {
-        auto ticketResult = ticketService->getAllTickets();
-        if (ticketResult.has_value())
-            tickets = ticketResult.value();
-    }
-    // Đồng bộ số ghế đã đặt
-    syncBookedSeatsWithTickets(tickets, flights);
-
-    // Cập nhật lại _seatAvailability cho từng chuyến bay dựa trên seatLayout đã cập nhật
-    for (auto &flight : flights)
-    {
-        if (!flight.getAircraft())
-            continue;
-        const auto &seatLayout = flight.getAircraft()->getSeatLayout();
-        std::unordered_map<SeatNumber, bool> seatAvailability;
-        // Duyệt tất cả các hạng ghế
-        for (const auto &[seatClass, count] : seatLayout.getSeatCounts())
-        {
-            std::string classCode = seatClass.getCode();
-            int total = seatLayout.getSeatCount(classCode);
-            int padding = total > 99 ? 3 : 2;
-            for (int i = 1; i <= total; ++i)
-            {
-                std::stringstream ss;
-                ss << classCode << std::setfill('0') << std::setw(padding) << i;
-                auto seatNumResult = SeatNumber::create(ss.str(), seatLayout);
-                if (seatNumResult)
-                {
-                    bool isAvailable = seatLayout.getAvailableSeatCount(classCode) > 0;
-                    // Đánh dấu ghế là available nếu chưa bị book hết
-                    // Nhưng phải kiểm tra đúng từng ghế, không chỉ tổng số
-                    // => Dùng bookedSeats để xác định
-                    // Đếm số ghế đã book cho từng class
-                    // Nhưng SeatClassMap không lưu từng ghế, chỉ tổng số
-                    // => Đánh dấu available nếu tổng số booked < tổng số
-                    // Nhưng để chính xác, cần lưu từng ghế đã book (nếu muốn cực chuẩn)
-                    // Ở đây, ta đánh dấu tất cả ghế của class là available nếu còn slot
-                    seatAvailability[*seatNumResult] = true;
-                }
-            }
-        }
-        // Đánh dấu các ghế đã book là false dựa trên vé
-        for (const auto &ticket : tickets)
+    searchRows.clear();
+    flightList->ShowRows(
+        static_cast<long>(count),
+        [this](long item, long column)
         {
-            if (ticket.getFlight()->getFlightNumber().toString() == flight.getFlightNumber().toString())
-            {
-                auto seatNum = ticket.getSeatNumber();
-                seatAvailability[seatNum] = false;
-            }
-        }
-        // Gán lại vào flight
-        flight.setSeatAvailability(seatAvailability);
-    }
+            const FlightSummaryRow *row = flightSource.row(static_cast<size_t>(item));
+            if (row)
+                return FlightCell(*row, column);
+            // Trang chứa hàng này đang được nạp trên worker
+            return column == 1 ? wxString("Đang tải...") : wxString();
+        },
+        [this](long from, long to)
+        { flightSource.prefetch(static_cast<size_t>(from), static_cast<size_t>(to)); });
+    UpdateLoadStatus();
+}
 
-    for (size_t i = 0; i < flights.size(); ++i)
-    {
-        const auto &flight = flights[i];
-        try
-        {
-            // Kiểm tra các trường quan trọng
-            if (!flight.getAircraft())
-            {
-                wxLogError("Flight %s thiếu thông tin máy bay!", flight.getFlightNumber().toString());
-                wxMessageBox(wxString::Format("Chuyến bay %s thiếu thông tin máy bay!", flight.getFlightNumber().toString()), "Lỗi dữ liệu", wxOK | wxICON_ERROR);
-                continue;
-            }
-            const auto &route = flight.getRoute();
-            if (route.getOrigin().empty() || route.getDestination().empty() || route.getOriginCode().empty() || route.getDestinationCode().empty())
-            {
-                wxLogError("Flight %s thiếu thông tin route!", flight.getFlightNumber().toString());
-                wxMessageBox(wxString::Format("Chuyến bay %s thiếu thông tin tuyến đường!", flight.getFlightNumber().toString()), "Lỗi dữ liệu", wxOK | wxICON_ERROR);
-                continue;
-            }
-            const auto &schedule = flight.getSchedule();
-            // Nếu schedule lỗi sẽ throw
-            const std::tm &departure = schedule.getDeparture();
-            const std::tm &arrival = schedule.getArrival();
+void FlightWindow::UpdateLoadStatus()
+{
+    bool loading = searching || flightSource.loading();
+    cancelLoadButton->Enable(loading);
+    if (loading)
+        SetStatusText("Đang tải...");
+    else if (!searchRows.empty())
+        SetStatusText(wxString::Format("Tìm thấy %zu chuyến bay", searchRows.size()));
+    else if (flightSource.stopped())
+        SetStatusText("Đã hủy tải");
+    else if (!flightSource.lastError())
+        SetStatusText(wxString::Format("Đã tải %zu chuyến bay", flightSource.size()));
+}
 
-            long index = flightList->InsertItem(i, wxString::Format("%d", flight.getId()));
-            flightList->SetItem(index, 1, flight.getFlightNumber().toString());
-            flightList->SetItem(index, 2, flight.getRoute().getOrigin());
-            flightList->SetItem(index, 3, flight.getRoute().getDestination());
+Async::CallContext FlightWindow::BeginSearch()
+{
+    searchCancellation.cancel();
+    searchCancellation = Async::CancellationSource();
+    searching = true;
+    UpdateLoadStatus();
+    return Async::CallContext::create(SEARCH_TIMEOUT, searchCancellation.token());
+}
 
-            std::string departureDateTime = convertTimeToString(departure);
-            flightList->SetItem(index, 4, departureDateTime.substr(0, 10));
-            flightList->SetItem(index, 5, departureDateTime.substr(11, 5));
+void FlightWindow::EndSearch()
+{
+    searching = false;
+    UpdateLoadStatus();
+}
 
-            std::string arrivalDateTime = convertTimeToString(arrival);
-            flightList->SetItem(index, 6, arrivalDateTime.substr(0, 10));
-            flightList->SetItem(index, 7, arrivalDateTime.substr(11, 5));
+void FlightWindow::ShowSearchResult(const Flight &flight)
+{
+    FlightSummaryRow row;
+    row.id = flight.getId();
+    row.flightNumber = flight.getFlightNumber().toString();
+    row.departureCode = flight.getRoute().getOriginCode();
+    row.departureName = flight.getRoute().getOrigin();
+    row.arrivalCode = flight.getRoute().getDestinationCode();
+    row.arrivalName = flight.getRoute().getDestination();
+    row.departureTime = flight.getSchedule().getDeparture();
+    row.arrivalTime = flight.getSchedule().getArrival();
+    row.status = flight.getStatus();
+    // Aircraft info
+    row.aircraftSerial = flight.getAircraft() ? flight.getAircraft()->getSerial().toString() : "N/A";
+
+    searchRows.assign(1, std::move(row));
+    flightList->ShowRows(1, [this](long item, long column)
+    {
+        // Kết quả tìm kiếm không kèm số ghế đã đặt nên bỏ trống cột thông tin ghế
+        return column == 10 ? wxString() : FlightCell(searchRows[static_cast<size_t>(item)], column);
+    });
+}
 
-            if (flight.getAircraft())
-            {
-                flightList->SetItem(index, 8, flight.getAircraft()->getSerial().toString());
-            }
-            else
-            {
-                flightList->SetItem(index, 8, "N/A");
-            }
-            flightList->SetItem(index, 9, "SCHEDULED");
-            flightList->SetItem(index, 10, getSeatInfo(flight));
-        }
-        catch (const std::exception &e)
-        {
-            wxLogError("Lỗi khi load chuyến bay %s: %s", flight.getFlightNumber().toString(), e.what());
-            wxMessageBox(wxString::Format("Lỗi khi load chuyến bay %s: %s", flight.getFlightNumber().toString(), e.what()), "Lỗi dữ liệu", wxOK | wxICON_ERROR);
-            continue;
-        }
+wxString FlightWindow::FlightCell(const FlightSummaryRow &row, long column)
+{
+    switch (column)
+    {
+    case 0:
+        return wxString::Format("%d", row.id);
+    case 1:
+        return row.flightNumber;
+    case 2:
+        return row.departureName;
+    case 3:
+        return row.arrivalName;
+    case 4:
+        return convertTimeToString(row.departureTime).substr(0, 10); // Date: YYYY-MM-DD
+    case 5:
+        return convertTimeToString(row.departureTime).substr(11, 5); // Time: HH:MM
+    case 6:
+        return convertTimeToString(row.arrivalTime).substr(0, 10);
+    case 7:
+        return convertTimeToString(row.arrivalTime).substr(11, 5);
+    case 8:
+        return row.aircraftSerial;
+    case 9:
+        return FlightStatusUtil::toString(row.status);
+    case 10:
+        return getSeatInfo(row);
+    default:
+        return wxString();
     }
-    // wxString statusMsg = wxString::Format("Đã tải %zu chuyến bay", flights.size());
-    // infoLabel->SetLabel(statusMsg);
 }
 
 void FlightWindow::OnViewAvailableSeats(wxCommandEvent &event)
@@ -1095,6 +1132,7 @@ void FlightWindow::OnViewAvailableSeats(wxCommandEvent &event)
         allSeats.push_back(ss.str());
     }
     // Lấy danh sách vé đã đặt cho chuyến bay này
+    Tracing::Span span("FlightWindow.load_booked_seats", "ui");
     std::vector<std::string> bookedSeats;
     if (ticketService)
     {
@@ -1112,6 +1150,7 @@ void FlightWindow::OnViewAvailableSeats(wxCommandEvent &event)
             }
         }
     }
+    span.end();
     // Lọc ra các ghế chưa được đặt
     std::vector<std::string> availableSeats;
     for (const auto &seat : allSeats)
@@ -1204,6 +1243,7 @@ void FlightWindow::OnCheckSeatAvailability(wxCommandEvent &event)
         return;
     }
     // Kiểm tra ghế đã được đặt chưa (dựa vào ticket)
+    Tracing::Span span("FlightWindow.check_seat", "ui");
     bool isBooked = false;
     if (ticketService)
     {
@@ -1221,6 +1261,7 @@ void FlightWindow::OnCheckSeatAvailability(wxCommandEvent &event)
             }
         }
     }
+    span.end();
     wxString message = wxString::Format(
         "Ghế %s trên chuyến bay %s:\n\n%s",
         seatNumber,
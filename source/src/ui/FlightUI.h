@@ -3,8 +3,11 @@
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include "MainUI.h"
+#include "VirtualListCtrl.h"
 #include "core/entities/Flight.h"
 #include "services/FlightService.h"
+#include "async/AsyncServices.h"
+#include "async/AsyncRowSource.h"
 
 /**
  * @brief Cửa sổ quản lý chuyến bay
@@ -34,6 +37,11 @@ public:
                      std::shared_ptr<PassengerService> passenger,
                      std::shared_ptr<TicketService> ticket);
 
+    /**
+     * @brief Hủy các lượt tải đang chạy để kết quả không quay về cửa sổ đã đóng
+     */
+    ~FlightWindow() override;
+
 private:
     /// Panel chính chứa các thành phần giao diện
     wxPanel *panel;
@@ -57,8 +65,14 @@ private:
     wxButton *viewAvailableSeatsButton;
     /// Nút kiểm tra tình trạng ghế
     wxButton *checkSeatAvailabilityButton;
-    /// Danh sách hiển thị thông tin chuyến bay
-    wxListCtrl *flightList;
+    /// Nút hủy lượt tải đang chạy
+    wxButton *cancelLoadButton;
+    /// Ô tìm nhanh theo số hiệu chuyến bay, tìm ngay khi đang gõ
+    wxTextCtrl *quickSearchCtrl;
+    /// Hẹn giờ một lần: chỉ tìm khi người dùng ngừng gõ một lúc
+    wxTimer quickSearchTimer;
+    /// Danh sách ảo hiển thị thông tin chuyến bay
+    VirtualListCtrl *flightList;
     /// Label hiển thị thông tin bổ sung
     wxStaticText *infoLabel;
 
@@ -71,6 +85,21 @@ private:
     /// Service quản lý vé máy bay
     std::shared_ptr<TicketService> ticketService;
 
+    /// Facade bất đồng bộ; null thì service được gọi đồng bộ trên luồng giao diện
+    std::shared_ptr<Async::AsyncServices> asyncServices;
+    /// Ảnh chụp dữ liệu tham chiếu lúc khởi động; chỉ dùng cho lần hiện đầu tiên, bỏ khi có thay đổi hoặc làm mới
+    std::shared_ptr<const Reporting::ReferenceData> referenceData;
+    /// Số chuyến bay và các trang hàng tóm tắt (kèm số ghế đã đặt), nạp trên worker theo vùng đang cuộn tới
+    Async::AsyncRowSource<FlightSummaryRow> flightSource;
+    /// Kết quả tìm kiếm đang hiển thị
+    std::vector<FlightSummaryRow> searchRows;
+    /// Hủy lượt tìm kiếm đang chạy khi có lượt mới, khi bấm hủy hoặc khi đóng cửa sổ
+    Async::CancellationSource searchCancellation;
+    /// Có lượt tìm kiếm đang chạy
+    bool searching = false;
+    /// Thay đổi chuyến bay từ repository, áp dụng vào danh sách tại chỗ thay cho nạp lại toàn bộ
+    Changes::Subscription changeSubscription;
+
     /**
      * @brief Xử lý sự kiện quay lại menu chính
      * @param event Sự kiện nút bấm
@@ -132,16 +161,69 @@ private:
     void OnListItemSelected(wxListEvent &event);
 
     /**
-     * @brief Làm mới danh sách chuyến bay
+     * @brief Xử lý sự kiện hủy lượt tải đang chạy
+     * @param event Sự kiện nút bấm
+     */
+    void OnCancelLoad(wxCommandEvent &event);
+
+    /**
+     * @brief Xử lý sự kiện gõ vào ô tìm nhanh: hẹn lại giờ tìm
+     * @param event Sự kiện thay đổi văn bản
+     */
+    void OnQuickSearchText(wxCommandEvent &event);
+
+    /**
+     * @brief Tìm các chuyến bay có số hiệu bắt đầu bằng văn bản đã gõ
+     * @param event Sự kiện hẹn giờ
+     */
+    void OnQuickSearchTimer(wxTimerEvent &event);
+
+    /**
+     * @brief Làm mới danh sách chuyến bay: đếm lại trên worker, các trang được nạp dần khi cuộn tới
      */
     void RefreshFlightList();
 
+    /**
+     * @brief Hiển thị danh sách đầy đủ từ flightSource với số hàng đã đếm
+     * @param count Tổng số chuyến bay
+     */
+    void populateFlightList(size_t count);
+
+    /**
+     * @brief Cập nhật nút hủy và thanh trạng thái theo các lượt tải đang chạy
+     */
+    void UpdateLoadStatus();
+
+    /**
+     * @brief Bắt đầu một lượt tìm kiếm mới, hủy lượt trước nếu còn chạy
+     * @return Ngữ cảnh của lượt tìm kiếm
+     */
+    Async::CallContext BeginSearch();
+
+    /**
+     * @brief Kết thúc lượt tìm kiếm đang chạy khi kết quả đã về luồng giao diện
+     */
+    void EndSearch();
+
+    /**
+     * @brief Hiển thị một chuyến bay tìm được trong danh sách ảo
+     * @param flight Chuyến bay tìm được
+     */
+    void ShowSearchResult(const Flight &flight);
+
+    /**
+     * @brief Nội dung một ô của danh sách chuyến bay
+     * @param row Hàng tóm tắt chuyến bay
+     * @param column Chỉ số cột
+     */
+    wxString FlightCell(const FlightSummaryRow &row, long column);
+
     /**
      * @brief Lấy thông tin ghế của chuyến bay
-     * @param flight Chuyến bay cần lấy thông tin ghế
+     * @param row Hàng tóm tắt chuyến bay đã có số ghế đã đặt theo hạng
      * @return Chuỗi mô tả thông tin ghế
      */
-    std::string getSeatInfo(const Flight &flight);
+    std::string getSeatInfo(const FlightSummaryRow &row);
 
     DECLARE_EVENT_TABLE()
 };
\ No newline at end of file
@@ -141,4 +141,31 @@ void MainWindow::OnTicketService(wxCommandEvent &event)
 void MainWindow::OnExit(wxCommandEvent &event)
 {
     Close(true);
-}
\ No newline at end of file
+}
+
+void MainWindow::setReferenceData(std::shared_ptr<const Reporting::ReferenceData> data)
+{
+    // Hủy đăng ký ngoài khóa: nó chờ handler đang chạy, mà handler cần khóa
+    referenceSubscription.reset();
+    {
+        std::lock_guard<std::mutex> lock(referenceMutex);
+        referenceData = std::move(data);
+        if (!referenceData)
+            return;
+    }
+    referenceSubscription = Changes::Feed::getInstance()->subscribe(
+        [](const Changes::Event &event)
+        {
+            // Hành khách không có trong ảnh chụp
+            if (event.entity == Changes::Entity::PASSENGER)
+                return;
+            std::lock_guard<std::mutex> lock(referenceMutex);
+            referenceData.reset();
+        });
+}
+
+std::shared_ptr<const Reporting::ReferenceData> MainWindow::getReferenceData()
+{
+    std::lock_guard<std::mutex> lock(referenceMutex);
+    return referenceData;
+}
@@ -7,6 +7,10 @@
 #include "services/FlightService.h"
 #include "services/PassengerService.h"
 #include "services/TicketService.h"
+#include "async/AsyncServices.h"
+#include "reporting/ReferenceSnapshot.h"
+#include "utils/ChangeFeed.h"
+#include <mutex>
 
 // Forward declarations
 class AircraftWindow;
@@ -115,6 +119,37 @@ public:
      */
     std::shared_ptr<TicketService> getTicketService() const { return ticketService; }
 
+    /**
+     * @brief Đặt facade bất đồng bộ dùng chung cho mọi cửa sổ được tạo sau đó
+     *
+     * Các cửa sổ con tạo lại MainWindow khi quay về menu nên facade được giữ ở mức lớp thay vì
+     * truyền qua từng constructor. Gọi với nullptr khi thoát để dừng executor trước khi đóng kết nối.
+     * @param services Facade bất đồng bộ, nullptr để mọi cửa sổ chạy đồng bộ
+     */
+    static void setAsyncServices(std::shared_ptr<Async::AsyncServices> services) { asyncServices = std::move(services); }
+
+    /**
+     * @brief Lấy facade bất đồng bộ dùng chung
+     * @return Shared pointer đến AsyncServices, có thể null
+     */
+    static std::shared_ptr<Async::AsyncServices> getAsyncServices() { return asyncServices; }
+
+    /**
+     * @brief Đặt ảnh chụp dữ liệu tham chiếu nạp lúc khởi động (xem Reporting::ReferenceData)
+     *
+     * Cửa sổ chuyến bay hiện danh sách từ ảnh chụp ngay khi mở, không chờ cơ sở dữ liệu. Ảnh chụp
+     * chỉ đúng đến lần ghi đầu tiên: thay đổi máy bay, chuyến bay hay vé sau đó làm nó bị bỏ và
+     * các cửa sổ quay về nạp từ cơ sở dữ liệu.
+     * @param data Ảnh chụp đã bổ sung tới hiện tại, nullptr để bỏ
+     */
+    static void setReferenceData(std::shared_ptr<const Reporting::ReferenceData> data);
+
+    /**
+     * @brief Lấy ảnh chụp dữ liệu tham chiếu nếu nó còn đúng
+     * @return Shared pointer đến ảnh chụp, có thể null
+     */
+    static std::shared_ptr<const Reporting::ReferenceData> getReferenceData();
+
 private:
     /**
      * @brief Xử lý sự kiện mở cửa sổ quản lý máy bay
@@ -173,6 +208,14 @@ private:
     /// Factory để tạo các cửa sổ UI
     std::unique_ptr<UIFactory> uiFactory;
 
+    /// Facade bất đồng bộ dùng chung (có thể null)
+    static inline std::shared_ptr<Async::AsyncServices> asyncServices;
+
+    /// Ảnh chụp dữ liệu tham chiếu; bị bỏ từ luồng ghi khi có thay đổi nên được giữ dưới khóa
+    static inline std::mutex referenceMutex;
+    static inline std::shared_ptr<const Reporting::ReferenceData> referenceData;
+    static inline Changes::Subscription referenceSubscription;
+
     DECLARE_EVENT_TABLE()
 };
 
@@ -1,4 +1,5 @@
 #include "PassengerUI.h"
+#include "UiDispatch.h"
 #include "services/PassengerService.h"
 #include "services/AircraftService.h"
 #include "services/FlightService.h"
@@ -7,6 +8,39 @@
 #include <wx/msgdlg.h>
 #include <wx/textdlg.h>
 
+namespace
+{
+    /// Kích thước trang và số trang tối đa giữ trong bộ đệm của danh sách hành khách
+    constexpr size_t PASSENGER_PAGE_SIZE = 200;
+    constexpr size_t PASSENGER_CACHED_PAGES = 8;
+    /// Thời gian tối đa của một lượt tìm kiếm
+    constexpr std::chrono::seconds SEARCH_TIMEOUT(30);
+    /// Thời gian chờ sau lần gõ cuối trước khi tìm nhanh, và số gợi ý tối đa
+    constexpr int QUICK_SEARCH_DELAY_MS = 200;
+    constexpr size_t QUICK_SEARCH_LIMIT = 100;
+
+    wxString PassengerCell(const PassengerListRow &row, long column)
+    {
+        switch (column)
+        {
+        case 0:
+            return wxString::Format(wxT("%d"), row.id);
+        case 1:
+            return wxString(row.name.c_str(), wxConvUTF8);
+        case 2:
+            return wxString(row.passportNumber.c_str(), wxConvUTF8);
+        case 3:
+            return wxString(row.email.c_str(), wxConvUTF8);
+        case 4:
+            return wxString(row.phone.c_str(), wxConvUTF8);
+        case 5:
+            return wxString(row.address.c_str(), wxConvUTF8);
+        default:
+            return wxString();
+        }
+    }
+}
+
 wxBEGIN_EVENT_TABLE(PassengerWindow, wxFrame)
     EVT_BUTTON(1001, PassengerWindow::OnBack)
         EVT_BUTTON(1002, PassengerWindow::OnShowPassenger)
@@ -18,15 +52,74 @@ wxBEGIN_EVENT_TABLE(PassengerWindow, wxFrame)
                                 EVT_BUTTON(1008, PassengerWindow::OnCheckBookings)
                                     EVT_BUTTON(1009, PassengerWindow::OnViewStats)
                                         EVT_LIST_ITEM_SELECTED(wxID_ANY, PassengerWindow::OnListItemSelected)
+                                            EVT_BUTTON(1010, PassengerWindow::OnCancelLoad)
+                                                EVT_TEXT(1011, PassengerWindow::OnQuickSearchText)
+                                                    EVT_TIMER(1012, PassengerWindow::OnQuickSearchTimer)
                                             wxEND_EVENT_TABLE()
 
                                                 PassengerWindow::PassengerWindow(const wxString &title, std::shared_ptr<PassengerService> passengerService)
-    : wxFrame(nullptr, wxID_ANY, title, wxDefaultPosition, wxSize(1300, 700)), passengerService(passengerService)
+    : wxFrame(nullptr, wxID_ANY, title, wxDefaultPosition, wxSize(1300, 700)), passengerService(passengerService),
+      asyncServices(MainWindow::getAsyncServices()),
+      passengerSource(
+          [this](const Async::CallContext &context)
+          {
+              return Async::callService(asyncServices.get(), this->passengerService, &ApplicationContext::passengerService, context,
+                                        [](PassengerService &service)
+                                        { return service.countPassengers(); });
+          },
+          [this](const Async::CallContext &context, size_t offset, size_t limit)
+          {
+              return Async::callService(asyncServices.get(), this->passengerService, &ApplicationContext::passengerService, context,
+                                        [offset, limit](PassengerService &service) -> Result<std::vector<PassengerListRow>>
+                                        {
+                                            std::vector<PassengerListRow> rows;
+                                            auto loaded = service.getPassengerListPage(offset, limit, rows);
+                                            if (!loaded)
+                                                return Failure<std::vector<PassengerListRow>>(loaded.error());
+                                            return Success(std::move(rows));
+                                        });
+          },
+          PostToUiThread, PASSENGER_PAGE_SIZE, PASSENGER_CACHED_PAGES)
 {
     CreateUI();
+    quickSearchTimer.SetOwner(this, 1012);
+    passengerSource.setListener({
+        .countReady = [this](size_t count)
+        { ShowPassengerList(count); },
+        .rowsReady = [this](size_t first, size_t last)
+        {
+            // Trang về muộn khi danh sách đang hiện kết quả tìm kiếm thì chỉ nằm trong bộ đệm
+            if (searchRows.empty())
+                passengerList->RefreshRows(static_cast<long>(first), static_cast<long>(last));
+        },
+        .failed = [](const CoreError &error)
+        {
+            wxMessageBox(wxString::Format(wxT("Lỗi tải danh sách hành khách: %s"), error.message.c_str()),
+                         wxT("Lỗi"), wxOK | wxICON_ERROR);
+        },
+        // Có thể được gọi trong lúc danh sách đang vẽ nên cập nhật trạng thái ở lượt sự kiện sau
+        .loadingChanged = [this](bool)
+        { CallAfter(&PassengerWindow::UpdateLoadStatus); },
+        .countChanged = [this](size_t count, size_t first)
+        {
+            if (!searchRows.empty())
+                return;
+            passengerList->ResizeRows(static_cast<long>(count), static_cast<long>(first));
+            UpdateLoadStatus();
+        },
+    });
+    changeSubscription = SubscribeOnUiThread(this, Changes::Entity::PASSENGER, [this](Changes::Kind kind, int id)
+                                             { passengerSource.apply(kind, id); });
     RefreshPassengerList();
 }
 
+PassengerWindow::~PassengerWindow()
+{
+    changeSubscription.reset();
+    quickSearchTimer.Stop();
+    searchCancellation.cancel();
+}
+
 void PassengerWindow::setServices(std::shared_ptr<AircraftService> aircraftService,
                                   std::shared_ptr<FlightService> flightService,
                                   std::shared_ptr<PassengerService> passengerService,
@@ -58,9 +151,13 @@ void PassengerWindow::CreateUI()
     searchByPassportButton = new wxButton(panel, 1007, wxT("Tìm theo hộ chiếu"), wxDefaultPosition, wxSize(200, 50));
     checkBookingsButton = new wxButton(panel, 1008, wxT("Kiểm tra đặt chỗ"), wxDefaultPosition, wxSize(200, 50));
     viewStatsButton = new wxButton(panel, 1009, wxT("Thống kê"), wxDefaultPosition, wxSize(200, 50));
+    cancelLoadButton = new wxButton(panel, 1010, wxT("Hủy tải"), wxDefaultPosition, wxSize(200, 50));
+    cancelLoadButton->Disable();
+    quickSearchCtrl = new wxTextCtrl(panel, 1011, wxEmptyString, wxDefaultPosition, wxSize(300, 30));
+    quickSearchCtrl->SetHint(wxT("Tên hoặc số hộ chiếu..."));
 
     // Create passenger list
-    passengerList = new wxListCtrl(panel, wxID_ANY, wxDefaultPosition, wxSize(1200, 350), wxLC_REPORT | wxLC_SINGLE_SEL);
+    passengerList = new VirtualListCtrl(panel, wxID_ANY, wxSize(1200, 350), wxLC_SINGLE_SEL);
     passengerList->AppendColumn(wxT("ID"), wxLIST_FORMAT_LEFT, 80);
     passengerList->AppendColumn(wxT("Họ tên"), wxLIST_FORMAT_LEFT, 220);
     passengerList->AppendColumn(wxT("Hộ chiếu"), wxLIST_FORMAT_LEFT, 160);
@@ -78,10 +175,13 @@ void PassengerWindow::CreateUI()
     wxBoxSizer *row2 = new wxBoxSizer(wxHORIZONTAL);
     row2->Add(searchByIdButton, 0, wxALL, 10);
     row2->Add(searchByPassportButton, 0, wxALL, 10);
+    row2->Add(new wxStaticText(panel, wxID_ANY, wxT("Tìm nhanh:")), 0, wxALL | wxALIGN_CENTER_VERTICAL, 10);
+    row2->Add(quickSearchCtrl, 0, wxALL | wxALIGN_CENTER_VERTICAL, 10);
 
     wxBoxSizer *row3 = new wxBoxSizer(wxHORIZONTAL);
     row3->Add(checkBookingsButton, 0, wxALL, 10);
     row3->Add(viewStatsButton, 0, wxALL, 10);
+    row3->Add(cancelLoadButton, 0, wxALL, 10);
 
     contentSizer->Add(row1, 0, wxALIGN_CENTER);
     contentSizer->Add(row2, 0, wxALIGN_CENTER);
@@ -93,6 +193,7 @@ void PassengerWindow::CreateUI()
     mainSizer->Add(contentSizer, 1, wxEXPAND);
 
     panel->SetSizer(mainSizer);
+    CreateStatusBar();
     Centre();
 }
 
@@ -101,28 +202,70 @@ void PassengerWindow::RefreshPassengerList()
     if (!passengerService)
         return;
 
-    passengerList->DeleteAllItems();
+    // Chỉ xếp lượt đếm lên worker; danh sách đổi khi có số hành khách, các trang về dần khi cuộn tới
+    passengerSource.refresh();
+}
 
-    auto passengersResult = passengerService->getAllPassengers();
-    if (!passengersResult)
-    {
-        wxMessageBox(wxString::Format(wxT("Lỗi tải danh sách hành khách: %s"),
-                                      passengersResult.error().message.c_str()),
-                     wxT("Lỗi"), wxOK | wxICON_ERROR);
-        return;
-    }
+void PassengerWindow::ShowPassengerList(size_t count)
+{
+    searchRows.clear();
+    passengerList->ShowRows(
+        static_cast<long>(count),
+        [this](long item, long column)
+        {
+            const PassengerListRow *row = passengerSource.row(static_cast<size_t>(item));
+            if (row)
+                return PassengerCell(*row, column);
+            // Trang chứa hàng này đang được nạp trên worker
+            return column == 0 ? wxString(wxT("Đang tải...")) : wxString();
+        },
+        [this](long from, long to)
+        { passengerSource.prefetch(static_cast<size_t>(from), static_cast<size_t>(to)); });
+    UpdateLoadStatus();
+}
 
-    const auto &passengers = *passengersResult;
-    for (size_t i = 0; i < passengers.size(); ++i)
-    {
-        const auto &passenger = passengers[i];
-        long index = passengerList->InsertItem(i, wxString::Format(wxT("%d"), passenger.getId()));
-        passengerList->SetItem(index, 1, wxString(passenger.getName().c_str(), wxConvUTF8));
-        passengerList->SetItem(index, 2, wxString(passenger.getPassport().toString().c_str(), wxConvUTF8));
-        passengerList->SetItem(index, 3, wxString(passenger.getContactInfo().getEmail().c_str(), wxConvUTF8));
-        passengerList->SetItem(index, 4, wxString(passenger.getContactInfo().getPhone().c_str(), wxConvUTF8));
-        passengerList->SetItem(index, 5, wxString(passenger.getContactInfo().getAddress().c_str(), wxConvUTF8));
-    }
+void PassengerWindow::UpdateLoadStatus()
+{
+    bool loading = searching || passengerSource.loading();
+    cancelLoadButton->Enable(loading);
+    if (loading)
+        SetStatusText(wxT("Đang tải..."));
+    else if (!searchRows.empty())
+        SetStatusText(wxString::Format(wxT("Tìm thấy %zu hành khách"), searchRows.size()));
+    else if (passengerSource.stopped())
+        SetStatusText(wxT("Đã hủy tải"));
+    else
+        SetStatusText(wxString::Format(wxT("%zu hành khách"), passengerSource.size()));
+}
+
+Async::CallContext PassengerWindow::BeginSearch()
+{
+    searchCancellation.cancel();
+    searchCancellation = Async::CancellationSource();
+    searching = true;
+    UpdateLoadStatus();
+    return Async::CallContext::create(SEARCH_TIMEOUT, searchCancellation.token());
+}
+
+void PassengerWindow::EndSearch()
+{
+    searching = false;
+    UpdateLoadStatus();
+}
+
+void PassengerWindow::ShowSearchResult(const Passenger &passenger)
+{
+    PassengerListRow row;
+    row.id = passenger.getId();
+    row.name = passenger.getName();
+    row.passportNumber = passenger.getPassport().toString();
+    row.email = passenger.getContactInfo().getEmail();
+    row.phone = passenger.getContactInfo().getPhone();
+    row.address = passenger.getContactInfo().getAddress();
+
+    searchRows.assign(1, std::move(row));
+    passengerList->ShowRows(1, [this](long item, long column)
+                            { return PassengerCell(searchRows[static_cast<size_t>(item)], column); });
 }
 
 void PassengerWindow::OnBack(wxCommandEvent &event)
@@ -264,7 +407,6 @@ void PassengerWindow::OnAddPassenger(wxCommandEvent &event)
     }
 
     wxMessageBox(wxT("Thêm hành khách thành công!"), wxT("Thành công"), wxOK | wxICON_INFORMATION);
-    RefreshPassengerList();
 }
 
 void PassengerWindow::OnEditPassenger(wxCommandEvent &event)
@@ -406,8 +548,9 @@ void PassengerWindow::OnEditPassenger(wxCommandEvent &event)
         return;
     }
 
-    // Preserve the original passenger ID for update
+    // Preserve the original passenger ID and version for update
     updatedPassengerResult->setId(currentPassenger.getId());
+    updatedPassengerResult->setVersion(currentPassenger.getVersion());
 
     auto updateResult = passengerService->updatePassenger(*updatedPassengerResult);
     if (!updateResult)
@@ -419,7 +562,6 @@ void PassengerWindow::OnEditPassenger(wxCommandEvent &event)
     }
 
     wxMessageBox(wxT("Cập nhật hành khách thành công!"), wxT("Thành công"), wxOK | wxICON_INFORMATION);
-    RefreshPassengerList();
 }
 
 void PassengerWindow::OnDeletePassenger(wxCommandEvent &event)
@@ -478,7 +620,6 @@ void PassengerWindow::OnDeletePassenger(wxCommandEvent &event)
         }
 
         wxMessageBox(wxT("Xóa hành khách thành công!"), wxT("Thành công"), wxOK | wxICON_INFORMATION);
-        RefreshPassengerList();
     }
 }
 
@@ -487,7 +628,6 @@ void PassengerWindow::OnSearchById(wxCommandEvent &event)
     if (event.GetId() != 1006)
         return;
 
-    // Since getPassengerById is private, we'll search through all passengers
     wxTextEntryDialog idDialog(this, wxT("Nhập ID hành khách:"), wxT("Tìm kiếm"));
     if (idDialog.ShowModal() != wxID_OK)
         return;
@@ -499,42 +639,43 @@ void PassengerWindow::OnSearchById(wxCommandEvent &event)
         return;
     }
 
-    auto passengersResult = passengerService->getAllPassengers();
-    if (!passengersResult)
-    {
-        wxMessageBox(wxT("Lỗi tải danh sách hành khách!"), wxT("Lỗi"), wxOK | wxICON_ERROR);
-        return;
-    }
-
-    // Search for passenger with matching ID
-    const auto &passengers = *passengersResult;
-    bool found = false;
-
-    passengerList->DeleteAllItems();
-
-    for (const auto &passenger : passengers)
-    {
-        if (passenger.getId() == searchId)
+    // Tìm theo khóa chính thay cho nạp cả bảng rồi quét
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), passengerService, &ApplicationContext::passengerService, context,
+                           [searchId](PassengerService &service) -> Result<std::optional<Passenger>>
+                           {
+                               auto passengerResult = service.getPassengerById(static_cast<int>(searchId));
+                               if (passengerResult)
+                                   return Success(std::optional<Passenger>(*passengerResult));
+                               if (passengerResult.error().code == "NOT_FOUND")
+                                   return Success(std::optional<Passenger>());
+                               return Failure<std::optional<Passenger>>(passengerResult.error());
+                           }),
+        context.cancellation,
+        [this](Result<std::optional<Passenger>> passengerResult)
         {
-            long index = passengerList->InsertItem(0, wxString::Format(wxT("%d"), passenger.getId()));
-            passengerList->SetItem(index, 1, wxString(passenger.getName().c_str(), wxConvUTF8));
-            passengerList->SetItem(index, 2, wxString(passenger.getPassport().toString().c_str(), wxConvUTF8));
-            passengerList->SetItem(index, 3, wxString(passenger.getContactInfo().getEmail().c_str(), wxConvUTF8));
-            passengerList->SetItem(index, 4, wxString(passenger.getContactInfo().getPhone().c_str(), wxConvUTF8));
-            passengerList->SetItem(index, 5, wxString(passenger.getContactInfo().getAddress().c_str(), wxConvUTF8));
-            found = true;
-            break;
-        }
-    }
-
-    if (found)
-    {
-        wxMessageBox(wxT("Tìm thấy hành khách có ID: "), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
-    }
-    else
-    {
-        wxMessageBox(wxT("Không tìm thấy hành khách!"), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
-    }
+            EndSearch();
+            if (!passengerResult)
+            {
+                wxMessageBox(wxT("Lỗi tải danh sách hành khách!"), wxT("Lỗi"), wxOK | wxICON_ERROR);
+                return;
+            }
+
+            if (passengerResult.value())
+            {
+                ShowSearchResult(*passengerResult.value());
+                UpdateLoadStatus();
+                wxMessageBox(wxT("Tìm thấy hành khách có ID: "), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
+            }
+            else
+            {
+                searchRows.clear();
+                passengerList->ClearRows();
+                UpdateLoadStatus();
+                wxMessageBox(wxT("Không tìm thấy hành khách!"), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
+            }
+        });
 }
 
 void PassengerWindow::OnSearchByPassport(wxCommandEvent &event)
@@ -553,25 +694,27 @@ void PassengerWindow::OnSearchByPassport(wxCommandEvent &event)
         return;
     }
 
-    auto passengerResult = passengerService->getPassenger(*passportResult);
-    if (!passengerResult)
-    {
-        wxMessageBox(wxT("Không tìm thấy hành khách!"), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
-        return;
-    }
-
-    // Clear list and show only found passenger
-    passengerList->DeleteAllItems();
-    const auto &passenger = *passengerResult;
-
-    long index = passengerList->InsertItem(0, wxString::Format(wxT("%d"), passenger.getId()));
-    passengerList->SetItem(index, 1, wxString(passenger.getName().c_str(), wxConvUTF8));
-    passengerList->SetItem(index, 2, wxString(passenger.getPassport().toString().c_str(), wxConvUTF8));
-    passengerList->SetItem(index, 3, wxString(passenger.getContactInfo().getEmail().c_str(), wxConvUTF8));
-    passengerList->SetItem(index, 4, wxString(passenger.getContactInfo().getPhone().c_str(), wxConvUTF8));
-    passengerList->SetItem(index, 5, wxString(passenger.getContactInfo().getAddress().c_str(), wxConvUTF8));
-
-    wxMessageBox(wxT("Tìm thấy hành khách: "), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), passengerService, &ApplicationContext::passengerService, context,
+                           [passport = *passportResult](PassengerService &service)
+                           { return service.getPassenger(passport); }),
+        context.cancellation,
+        [this](Result<Passenger> passengerResult)
+        {
+            EndSearch();
+            if (!passengerResult)
+            {
+                wxMessageBox(wxT("Không tìm thấy hành khách!"), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
+                return;
+            }
+
+            // Show only found passenger
+            ShowSearchResult(*passengerResult);
+            UpdateLoadStatus();
+
+            wxMessageBox(wxT("Tìm thấy hành khách: "), wxT("Thông báo"), wxOK | wxICON_INFORMATION);
+        });
 }
 
 void PassengerWindow::OnListItemSelected(wxListEvent &event)
@@ -580,6 +723,65 @@ void PassengerWindow::OnListItemSelected(wxListEvent &event)
     event.Skip();
 }
 
+void PassengerWindow::OnCancelLoad(wxCommandEvent &event)
+{
+    searchCancellation.cancel();
+    passengerSource.cancel();
+    EndSearch();
+}
+
+void PassengerWindow::OnQuickSearchText(wxCommandEvent &event)
+{
+    // Mỗi lần gõ hẹn lại từ đầu nên chỉ lần gõ cuối trong một chuỗi gõ nhanh mới gây ra tìm kiếm
+    quickSearchTimer.StartOnce(QUICK_SEARCH_DELAY_MS);
+}
+
+void PassengerWindow::OnQuickSearchTimer(wxTimerEvent &event)
+{
+    std::string text = quickSearchCtrl->GetValue().utf8_string();
+    if (text.find_first_not_of(" \t") == std::string::npos)
+    {
+        // Ô tìm trống: trở lại danh sách đầy đủ đang có trong bộ đệm
+        searchCancellation.cancel();
+        EndSearch();
+        ShowPassengerList(passengerSource.size());
+        return;
+    }
+
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), passengerService, &ApplicationContext::passengerService, context,
+                           [text](PassengerService &service) -> Result<std::vector<PassengerListRow>>
+                           {
+                               std::vector<PassengerListRow> rows;
+                               auto found = service.suggestPassengers(text, QUICK_SEARCH_LIMIT, rows);
+                               if (!found)
+                                   return Failure<std::vector<PassengerListRow>>(found.error());
+                               return Success(std::move(rows));
+                           }),
+        context.cancellation,
+        [this](Result<std::vector<PassengerListRow>> rowsResult)
+        {
+            EndSearch();
+            if (!rowsResult)
+            {
+                SetStatusText(wxString::Format(wxT("Lỗi tìm nhanh: %s"), rowsResult.error().message.c_str()));
+                return;
+            }
+
+            searchRows = std::move(*rowsResult);
+            if (searchRows.empty())
+            {
+                passengerList->ClearRows();
+                SetStatusText(wxT("Không tìm thấy hành khách"));
+                return;
+            }
+            passengerList->ShowRows(static_cast<long>(searchRows.size()), [this](long item, long column)
+                                    { return PassengerCell(searchRows[static_cast<size_t>(item)], column); });
+            UpdateLoadStatus();
+        });
+}
+
 void PassengerWindow::OnCheckBookings(wxCommandEvent &event)
 {
     if (event.GetId() != 1008)
@@ -638,48 +840,35 @@ void PassengerWindow::OnViewStats(wxCommandEvent &event)
     if (event.GetId() != 1009)
         return;
 
-    auto passengersResult = passengerService->getAllPassengers();
-    if (!passengersResult)
-    {
-        wxMessageBox(wxT("Lỗi tải danh sách hành khách!"), wxT("Lỗi"), wxOK | wxICON_ERROR);
-        return;
-    }
-
-    const auto &passengers = *passengersResult;
-    int totalPassengers = passengers.size();
-    int passengersWithBookings = 0;
-    int totalFlights = 0;
-
-    // Calculate statistics
-    for (const auto &passenger : passengers)
-    {
-        auto hasBookingsResult = passengerService->hasActiveBookings(passenger.getPassport());
-        if (hasBookingsResult && *hasBookingsResult)
+    // Hai truy vấn gộp trên worker thay cho hai lần tải vé của từng hành khách trên luồng giao diện
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), passengerService, &ApplicationContext::passengerService, context,
+                           [](PassengerService &service)
+                           { return service.getStatistics(); }),
+        context.cancellation,
+        [this](Result<PassengerStatistics> statisticsResult)
         {
-            passengersWithBookings++;
-        }
-
-        auto flightCountResult = passengerService->getTotalFlightCount(passenger.getPassport());
-        if (flightCountResult)
-        {
-            totalFlights += *flightCountResult;
-        }
-    }
-
-    double averageFlightsPerPassenger = totalPassengers > 0 ? (double)totalFlights / totalPassengers : 0.0;
-    double activeBookingPercentage = totalPassengers > 0 ? (double)passengersWithBookings * 100.0 / totalPassengers : 0.0;
-
-    wxString statsMessage = wxString::Format(
-        wxT("THỐNG KÊ HÀNH KHÁCH\n\n")
-            wxT("Tổng số hành khách: %d\n")
-                wxT("Hành khách có đặt chỗ đang hoạt động: %d (%.1f%%)\n")
-                    wxT("Tổng số chuyến bay đã đặt: %d\n")
-                        wxT("Trung bình chuyến bay/hành khách: %.1f"),
-        totalPassengers,
-        passengersWithBookings,
-        activeBookingPercentage,
-        totalFlights,
-        averageFlightsPerPassenger);
-
-    wxMessageBox(statsMessage, wxT("Thống kê hành khách"), wxOK | wxICON_INFORMATION);
+            EndSearch();
+            if (!statisticsResult)
+            {
+                wxMessageBox(wxT("Lỗi tải danh sách hành khách!"), wxT("Lỗi"), wxOK | wxICON_ERROR);
+                return;
+            }
+
+            const auto &statistics = *statisticsResult;
+            wxString statsMessage = wxString::Format(
+                wxT("THỐNG KÊ HÀNH KHÁCH\n\n")
+                    wxT("Tổng số hành khách: %zu\n")
+                        wxT("Hành khách có đặt chỗ đang hoạt động: %zu (%.1f%%)\n")
+                            wxT("Tổng số chuyến bay đã đặt: %zu\n")
+                                wxT("Trung bình chuyến bay/hành khách: %.1f"),
+                statistics.totalPassengers,
+                statistics.passengersWithActiveBookings,
+                statistics.activeBookingPercentage(),
+                statistics.activeTickets,
+                statistics.averageFlightsPerPassenger());
+
+            wxMessageBox(statsMessage, wxT("Thống kê hành khách"), wxOK | wxICON_INFORMATION);
+        });
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include "MainUI.h"
+#include "VirtualListCtrl.h"
 #include "core/entities/Passenger.h"
 #include "services/PassengerService.h"
+#include "async/AsyncRowSource.h"
 
 /**
  * @brief Cửa sổ quản lý hành khách
@@ -22,6 +24,11 @@ public:
      */
     PassengerWindow(const wxString &title, std::shared_ptr<PassengerService> passengerService);
 
+    /**
+     * @brief Destructor, hủy các lượt tải còn đang chạy
+     */
+    ~PassengerWindow();
+
     /**
      * @brief Thiết lập các service cần thiết cho việc điều hướng
      * @param aircraft Service quản lý máy bay
@@ -57,8 +64,14 @@ private:
     wxButton *checkBookingsButton;
     /// Nút xem thống kê hành khách
     wxButton *viewStatsButton;
-    /// Danh sách hiển thị thông tin hành khách
-    wxListCtrl *passengerList;
+    /// Nút hủy lượt tải đang chạy
+    wxButton *cancelLoadButton;
+    /// Ô tìm nhanh theo tên hoặc số hộ chiếu, tìm ngay khi đang gõ
+    wxTextCtrl *quickSearchCtrl;
+    /// Hẹn giờ một lần: chỉ tìm khi người dùng ngừng gõ một lúc
+    wxTimer quickSearchTimer;
+    /// Danh sách ảo hiển thị thông tin hành khách
+    VirtualListCtrl *passengerList;
     /// Label hiển thị thông tin bổ sung
     wxStaticText *infoLabel;
 
@@ -71,16 +84,57 @@ private:
     /// Service quản lý vé máy bay
     std::shared_ptr<TicketService> ticketService;
 
+    /// Facade bất đồng bộ; null thì service được gọi đồng bộ trên luồng giao diện
+    std::shared_ptr<Async::AsyncServices> asyncServices;
+    /// Số hành khách và các trang hàng hành khách của danh sách đầy đủ, nạp trên worker theo vùng đang cuộn tới
+    Async::AsyncRowSource<PassengerListRow> passengerSource;
+    /// Kết quả tìm kiếm đang hiển thị
+    std::vector<PassengerListRow> searchRows;
+    /// Hủy lượt tìm kiếm đang chạy khi có lượt mới, khi bấm hủy hoặc khi đóng cửa sổ
+    Async::CancellationSource searchCancellation;
+    /// Có lượt tìm kiếm đang chạy
+    bool searching = false;
+    /// Thay đổi hành khách từ repository, áp dụng vào danh sách tại chỗ thay cho nạp lại toàn bộ
+    Changes::Subscription changeSubscription;
+
     /**
      * @brief Khởi tạo giao diện người dùng
      */
     void CreateUI();
 
     /**
-     * @brief Làm mới danh sách hành khách
+     * @brief Làm mới danh sách hành khách: đếm lại số hành khách trên worker, các trang được nạp dần khi cuộn tới
      */
     void RefreshPassengerList();
 
+    /**
+     * @brief Hiển thị danh sách đầy đủ với số hành khách vừa đếm được
+     * @param count Tổng số hành khách
+     */
+    void ShowPassengerList(size_t count);
+
+    /**
+     * @brief Cập nhật nút hủy và thanh trạng thái theo các lượt tải đang chạy
+     */
+    void UpdateLoadStatus();
+
+    /**
+     * @brief Bắt đầu một lượt tìm kiếm mới, hủy lượt trước nếu còn chạy
+     * @return Ngữ cảnh của lượt tìm kiếm
+     */
+    Async::CallContext BeginSearch();
+
+    /**
+     * @brief Kết thúc lượt tìm kiếm đang chạy khi kết quả đã về luồng giao diện
+     */
+    void EndSearch();
+
+    /**
+     * @brief Hiển thị một hành khách tìm được trong danh sách ảo
+     * @param passenger Hành khách tìm được
+     */
+    void ShowSearchResult(const Passenger &passenger);
+
     /**
      * @brief Xử lý sự kiện quay lại menu chính
      * @param event Sự kiện nút bấm
@@ -141,5 +195,23 @@ private:
      */
     void OnListItemSelected(wxListEvent &event);
 
+    /**
+     * @brief Xử lý sự kiện hủy lượt tải đang chạy
+     * @param event Sự kiện nút bấm
+     */
+    void OnCancelLoad(wxCommandEvent &event);
+
+    /**
+     * @brief Xử lý sự kiện gõ vào ô tìm nhanh: hẹn lại giờ tìm
+     * @param event Sự kiện thay đổi văn bản
+     */
+    void OnQuickSearchText(wxCommandEvent &event);
+
+    /**
+     * @brief Tìm các hành khách có tên hoặc số hộ chiếu bắt đầu bằng văn bản đã gõ
+     * @param event Sự kiện hẹn giờ
+     */
+    void OnQuickSearchTimer(wxTimerEvent &event);
+
     DECLARE_EVENT_TABLE()
 };
\ No newline at end of file
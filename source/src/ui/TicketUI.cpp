@@ -1,9 +1,11 @@
 #include "TicketUI.h"
+#include "UiDispatch.h"
 #include "services/TicketService.h"
 #include "services/AircraftService.h"
 #include "services/FlightService.h"
 #include "services/PassengerService.h"
 #include "core/entities/Ticket.h"
+#include "utils/Tracing.h"
 #include <wx/msgdlg.h>
 #include <wx/textdlg.h>
 #include <wx/numdlg.h>
@@ -11,6 +13,65 @@
 #include <wx/dateevt.h>
 #include <sstream>
 #include <iomanip>
+#include <cmath>
+
+namespace
+{
+    /// Kích thước trang và số trang tối đa giữ trong bộ đệm của danh sách vé
+    constexpr size_t TICKET_PAGE_SIZE = 200;
+    constexpr size_t TICKET_CACHED_PAGES = 8;
+    /// Thời gian tối đa của một lượt tìm kiếm
+    constexpr std::chrono::seconds SEARCH_TIMEOUT(30);
+    /// Thời gian chờ sau lần gõ cuối trước khi tìm nhanh, và số gợi ý tối đa
+    constexpr int QUICK_SEARCH_DELAY_MS = 200;
+    constexpr size_t QUICK_SEARCH_LIMIT = 100;
+
+    wxString FormatPrice(double price)
+    {
+        // Format price with thousand separators
+        std::string priceStr = std::to_string(static_cast<long long>(std::llround(price)));
+        for (int i = priceStr.length() - 3; i > 0; i -= 3)
+        {
+            priceStr.insert(i, ".");
+        }
+        return priceStr;
+    }
+
+    wxString TicketCell(const TicketListRow &row, long column)
+    {
+        switch (column)
+        {
+        case 0:
+            return row.ticketNumber;
+        case 1:
+            return row.passportNumber;
+        case 2:
+            return row.flightNumber;
+        case 3:
+            return row.seatNumber;
+        case 4:
+            return FormatPrice(row.price);
+        case 5:
+            return TicketStatusUtil::toVietnamese(row.status);
+        default:
+            return wxString();
+        }
+    }
+
+    TicketListRow ToListRow(const Ticket &ticket)
+    {
+        TicketListRow row;
+        row.id = ticket.getId();
+        row.ticketNumber = ticket.getTicketNumber().toString();
+        row.passportNumber = ticket.getPassenger()->getPassport().toString();
+        row.flightNumber = ticket.getFlight()->getFlightNumber().toString();
+        row.seatNumber = ticket.getSeatNumber().toString();
+        row.price = ticket.getPrice().getAmount();
+        row.currency = ticket.getPrice().getCurrency();
+        row.status = ticket.getStatus();
+        return row;
+    }
+}
 
 enum
 {
@@ -20,7 +81,10 @@ enum
     ID_SHOW = 4,
     ID_SEARCH = 5,
     ID_BACK = 6,
-    ID_REFRESH = 7
+    ID_REFRESH = 7,
+    ID_CANCEL_LOAD = 8,
+    ID_QUICK_SEARCH = 9,
+    ID_QUICK_SEARCH_TIMER = 10
 };
 
 BEGIN_EVENT_TABLE(TicketWindow, wxFrame)
@@ -31,18 +95,41 @@ EVT_BUTTON(ID_SHOW, TicketWindow::OnShowTicket)
 EVT_BUTTON(ID_SEARCH, TicketWindow::OnSearchTicket)
 EVT_BUTTON(ID_BACK, TicketWindow::OnBack)
 EVT_BUTTON(ID_REFRESH, TicketWindow::OnRefresh)
+EVT_BUTTON(ID_CANCEL_LOAD, TicketWindow::OnCancelLoad)
+EVT_TEXT(ID_QUICK_SEARCH, TicketWindow::OnQuickSearchText)
+EVT_TIMER(ID_QUICK_SEARCH_TIMER, TicketWindow::OnQuickSearchTimer)
 END_EVENT_TABLE()
 
 TicketWindow::TicketWindow(const wxString &title, std::shared_ptr<TicketService> ticketService)
     : wxFrame(NULL, wxID_ANY, title, wxDefaultPosition, wxSize(800, 600)),
-      ticketService(ticketService)
+      ticketService(ticketService),
+      asyncServices(MainWindow::getAsyncServices()),
+      ticketSource(
+          [this](const Async::CallContext &context)
+          {
+              return Async::callService(asyncServices.get(), this->ticketService, &ApplicationContext::ticketService, context,
+                                        [](TicketService &service)
+                                        { return service.countTickets(); });
+          },
+          [this](const Async::CallContext &context, size_t offset, size_t limit)
+          {
+              return Async::callService(asyncServices.get(), this->ticketService, &ApplicationContext::ticketService, context,
+                                        [offset, limit](TicketService &service) -> Result<std::vector<TicketListRow>>
+                                        {
+                                            std::vector<TicketListRow> rows;
+                                            auto loaded = service.getTicketListPage(offset, limit, rows);
+                                            if (!loaded)
+                                                return Failure<std::vector<TicketListRow>>(loaded.error());
+                                            return Success(std::move(rows));
+                                        });
+          },
+          PostToUiThread, TICKET_PAGE_SIZE, TICKET_CACHED_PAGES)
 {
     panel = new wxPanel(this, wxID_ANY);
     mainSizer = new wxBoxSizer(wxVERTICAL);
 
     // Create list control
-    ticketList = new wxListCtrl(panel, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-                                wxLC_REPORT | wxLC_SINGLE_SEL);
+    ticketList = new VirtualListCtrl(panel, wxID_ANY, wxDefaultSize, wxLC_SINGLE_SEL);
     ticketList->InsertColumn(0, "Số vé", wxLIST_FORMAT_LEFT, 120);
     ticketList->InsertColumn(1, "Hành khách", wxLIST_FORMAT_LEFT, 100);
     ticketList->InsertColumn(2, "Chuyến bay", wxLIST_FORMAT_LEFT, 100);
@@ -59,6 +146,8 @@ TicketWindow::TicketWindow(const wxString &title, std::shared_ptr<TicketService>
     searchButton = new wxButton(panel, ID_SEARCH, "Tìm kiếm", wxDefaultPosition, wxSize(80, 30));
     backButton = new wxButton(panel, ID_BACK, "Quay lại", wxDefaultPosition, wxSize(80, 30));
     refreshButton = new wxButton(panel, ID_REFRESH, "Làm mới", wxDefaultPosition, wxSize(80, 30));
+    cancelLoadButton = new wxButton(panel, ID_CANCEL_LOAD, "Hủy tải", wxDefaultPosition, wxSize(80, 30));
+    cancelLoadButton->Disable();
 
     buttonSizer->Add(addButton, 0, wxALL, 5);
     buttonSizer->Add(editButton, 0, wxALL, 5);
@@ -67,16 +156,58 @@ TicketWindow::TicketWindow(const wxString &title, std::shared_ptr<TicketService>
     buttonSizer->Add(searchButton, 0, wxALL, 5);
     buttonSizer->Add(backButton, 0, wxALL, 5);
     buttonSizer->Add(refreshButton, 0, wxALL, 5);
+    buttonSizer->Add(cancelLoadButton, 0, wxALL, 5);
+
+    // Create quick search box
+    wxBoxSizer *quickSearchSizer = new wxBoxSizer(wxHORIZONTAL);
+    quickSearchCtrl = new wxTextCtrl(panel, ID_QUICK_SEARCH, wxEmptyString, wxDefaultPosition, wxSize(250, 30));
+    quickSearchCtrl->SetHint("Số vé hoặc số hiệu chuyến bay...");
+    quickSearchTimer.SetOwner(this, ID_QUICK_SEARCH_TIMER);
+    quickSearchSizer->Add(new wxStaticText(panel, wxID_ANY, "Tìm nhanh:"), 0, wxALL | wxALIGN_CENTER_VERTICAL, 5);
+    quickSearchSizer->Add(quickSearchCtrl, 1, wxALL, 5);
 
+    mainSizer->Add(quickSearchSizer, 0, wxEXPAND | wxLEFT | wxRIGHT | wxTOP, 10);
     mainSizer->Add(ticketList, 1, wxEXPAND | wxALL, 10);
     mainSizer->Add(buttonSizer, 0, wxALIGN_CENTER | wxALL, 10);
 
     panel->SetSizer(mainSizer);
+    CreateStatusBar();
     Centre();
 
+    ticketSource.setListener({
+        .countReady = [this](size_t count)
+        { ShowTicketList(count); },
+        .rowsReady = [this](size_t first, size_t last)
+        {
+            // Trang về muộn khi danh sách đang hiện kết quả tìm kiếm thì chỉ nằm trong bộ đệm
+            if (searchRows.empty())
+                ticketList->RefreshRows(static_cast<long>(first), static_cast<long>(last));
+        },
+        .failed = [](const CoreError &)
+        { wxMessageBox("Lỗi khi lấy danh sách vé", "Lỗi", wxOK | wxICON_ERROR); },
+        // Có thể được gọi trong lúc danh sách đang vẽ nên cập nhật trạng thái ở lượt sự kiện sau
+        .loadingChanged = [this](bool)
+        { CallAfter(&TicketWindow::UpdateLoadStatus); },
+        .countChanged = [this](size_t count, size_t first)
+        {
+            if (!searchRows.empty())
+                return;
+            ticketList->ResizeRows(static_cast<long>(count), static_cast<long>(first));
+            UpdateLoadStatus();
+        },
+    });
+    changeSubscription = SubscribeOnUiThread(this, Changes::Entity::TICKET, [this](Changes::Kind kind, int id)
+                                             { ticketSource.apply(kind, id); });
     RefreshTicketList();
 }
 
+TicketWindow::~TicketWindow()
+{
+    changeSubscription.reset();
+    quickSearchTimer.Stop();
+    searchCancellation.cancel();
+}
+
 void TicketWindow::setServices(
     std::shared_ptr<AircraftService> aircraftService,
     std::shared_ptr<FlightService> flightService,
@@ -91,36 +222,70 @@ void TicketWindow::setServices(
 
 void TicketWindow::RefreshTicketList()
 {
-    ticketList->DeleteAllItems();
-    auto tickets = ticketService->getAllTickets();
-    if (!tickets)
-    {
-        wxMessageBox("Lỗi khi lấy danh sách vé", "Lỗi", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    int index = 0;
-    for (const auto &ticket : tickets.value())
-    {
-        ticketList->InsertItem(index, ticket.getTicketNumber().toString());
-        ticketList->SetItem(index, 1, ticket.getPassenger()->getPassport().toString());
-        ticketList->SetItem(index, 2, ticket.getFlight()->getFlightNumber().toString());
-        ticketList->SetItem(index, 3, ticket.getSeatNumber().toString());
+    Tracing::Span span("TicketWindow.refresh", "ui");
+    // Chỉ xếp lượt đếm lên worker; danh sách đổi khi có số vé, các trang về dần khi cuộn tới
+    // Span kết thúc ngay, nhưng Executor gắn nó làm cha cho các span service và SQL trên worker
+    ticketSource.refresh();
+}
 
-        // Format price with thousand separators
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(0) << ticket.getPrice().getAmount();
-        std::string priceStr = ss.str();
-        // Add thousand separators
-        for (int i = priceStr.length() - 3; i > 0; i -= 3)
+void TicketWindow::ShowTicketList(size_t count)
+{
+    searchRows.clear();
+    ticketList->ShowRows(
+        static_cast<long>(count),
+        [this](long item, long column)
         {
-            priceStr.insert(i, ".");
-        }
-        ticketList->SetItem(index, 4, priceStr);
+            const TicketListRow *row = ticketSource.row(static_cast<size_t>(item));
+            if (row)
+                return TicketCell(*row, column);
+            // Trang chứa hàng này đang được nạp trên worker
+            return column == 0 ? wxString("Đang tải...") : wxString();
+        },
+        [this](long from, long to)
+        { ticketSource.prefetch(static_cast<size_t>(from), static_cast<size_t>(to)); });
+    UpdateLoadStatus();
+}
 
-        ticketList->SetItem(index, 5, ticket.getStatusVietnamese());
-        index++;
+void TicketWindow::UpdateLoadStatus()
+{
+    bool loading = searching || ticketSource.loading();
+    cancelLoadButton->Enable(loading);
+    if (loading)
+        SetStatusText("Đang tải...");
+    else if (!searchRows.empty())
+        SetStatusText(wxString::Format("Tìm thấy %zu vé", searchRows.size()));
+    else if (ticketSource.stopped())
+        SetStatusText("Đã hủy tải");
+    else
+        SetStatusText(wxString::Format("%zu vé", ticketSource.size()));
+}
+
+Async::CallContext TicketWindow::BeginSearch()
+{
+    searchCancellation.cancel();
+    searchCancellation = Async::CancellationSource();
+    searching = true;
+    UpdateLoadStatus();
+    return Async::CallContext::create(SEARCH_TIMEOUT, searchCancellation.token());
+}
+
+void TicketWindow::EndSearch()
+{
+    searching = false;
+    UpdateLoadStatus();
+}
+
+void TicketWindow::ShowSearchResults(const std::vector<Ticket> &tickets)
+{
+    searchRows.clear();
+    searchRows.reserve(tickets.size());
+    for (const auto &ticket : tickets)
+    {
+        searchRows.push_back(ToListRow(ticket));
     }
+    ticketList->ShowRows(static_cast<long>(searchRows.size()),
+                         [this](long item, long column)
+                         { return TicketCell(searchRows[static_cast<size_t>(item)], column); });
 }
 
 void TicketWindow::ShowTicketDetails(const Ticket &ticket)
@@ -284,11 +449,13 @@ void TicketWindow::AddTicketDialog()
     }
 
     // Step 7: Book the ticket
+    Tracing::Span span("TicketWindow.book_ticket", "ui");
     auto result = ticketService->bookTicket(
         passportResult.value(),
         flightNumberResult.value(),
         selectedSeat,
         priceResult.value());
+    span.end();
 
     if (!result)
     {
@@ -297,7 +464,6 @@ void TicketWindow::AddTicketDialog()
     }
 
     wxMessageBox("Tạo vé thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
-    RefreshTicketList();
 }
 
 void TicketWindow::EditTicketDialog(const Ticket &ticket)
@@ -342,13 +508,16 @@ void TicketWindow::EditTicketDialog(const Ticket &ticket)
         return;
     }
 
-    // Preserve the original ticket's ID and status but update the passenger
+    // Preserve the original ticket's ID, version and status but update the passenger
     updatedTicket = newTicket.value();
     updatedTicket.setId(ticket.getId());
+    updatedTicket.setVersion(ticket.getVersion());
     updatedTicket.setStatus(ticket.getStatus());
 
     // Update ticket
+    Tracing::Span span("TicketWindow.edit_ticket", "ui");
     auto result = ticketService->updateTicket(updatedTicket);
+    span.end();
     if (!result)
     {
         wxMessageBox("Lỗi khi cập nhật vé: " + result.error().message, "Lỗi", wxOK | wxICON_ERROR);
@@ -356,7 +525,6 @@ void TicketWindow::EditTicketDialog(const Ticket &ticket)
     }
 
     wxMessageBox("Cập nhật vé thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
-    RefreshTicketList();
 }
 void TicketWindow::DeleteTicketDialog(const Ticket &ticket)
 {
@@ -367,7 +535,9 @@ void TicketWindow::DeleteTicketDialog(const Ticket &ticket)
 
     if (answer == wxYES)
     {
+        Tracing::Span span("TicketWindow.delete_ticket", "ui");
         auto result = ticketService->deleteTicket(ticket.getTicketNumber());
+        span.end();
         if (!result)
         {
             wxMessageBox("Lỗi khi xóa vé: " + result.error().message, "Lỗi", wxOK | wxICON_ERROR);
@@ -375,7 +545,6 @@ void TicketWindow::DeleteTicketDialog(const Ticket &ticket)
         }
 
         wxMessageBox("Xóa vé thành công!", "Thông báo", wxOK | wxICON_INFORMATION);
-        RefreshTicketList();
     }
 }
 
@@ -387,7 +556,9 @@ void TicketWindow::SearchTicketDialog()
     if (choice == -1)
         return;
 
-    std::vector<Ticket> results;
+    // Tra cứu chạy trên worker; lookup là tìm theo số vé, lỗi nghĩa là không có vé đó
+    std::function<Result<std::vector<Ticket>>(TicketService &)> query;
+    bool lookup = false;
     switch (choice)
     {
     case 0:
@@ -403,13 +574,14 @@ void TicketWindow::SearchTicketDialog()
             return;
         }
 
-        auto result = ticketService->getTicket(ticketResult.value());
-        if (!result)
+        query = [ticketNumber = ticketResult.value()](TicketService &service) -> Result<std::vector<Ticket>>
         {
-            wxMessageBox("Không tìm thấy vé", "Thông báo", wxOK | wxICON_INFORMATION);
-            return;
-        }
-        results.push_back(result.value());
+            auto result = service.getTicket(ticketNumber);
+            if (!result)
+                return Failure<std::vector<Ticket>>(result.error());
+            return Success(std::vector<Ticket>{result.value()});
+        };
+        lookup = true;
         break;
     }
     case 1:
@@ -425,13 +597,8 @@ void TicketWindow::SearchTicketDialog()
             return;
         }
 
-        auto result = ticketService->searchByPassenger(passportResult.value());
-        if (!result)
-        {
-            wxMessageBox("Lỗi khi tìm kiếm", "Lỗi", wxOK | wxICON_ERROR);
-            return;
-        }
-        results = result.value();
+        query = [passport = passportResult.value()](TicketService &service)
+        { return service.searchByPassenger(passport); };
         break;
     }
     case 2:
@@ -447,13 +614,8 @@ void TicketWindow::SearchTicketDialog()
             return;
         }
 
-        auto result = ticketService->searchByFlight(flightResult.value());
-        if (!result)
-        {
-            wxMessageBox("Lỗi khi tìm kiếm", "Lỗi", wxOK | wxICON_ERROR);
-            return;
-        }
-        results = result.value();
+        query = [flightNumber = flightResult.value()](TicketService &service)
+        { return service.searchByFlight(flightNumber); };
         break;
     }
     case 3:
@@ -485,47 +647,38 @@ void TicketWindow::SearchTicketDialog()
             return;
         }
 
-        auto result = ticketService->searchByStatus(status);
-        if (!result)
-        {
-            wxMessageBox("Lỗi khi tìm kiếm", "Lỗi", wxOK | wxICON_ERROR);
-            return;
-        }
-        results = result.value();
+        query = [status](TicketService &service)
+        { return service.searchByStatus(status); };
         break;
     }
     }
 
-    // Display results
-    if (results.empty())
-    {
-        wxMessageBox("Không tìm thấy vé nào", "Thông báo", wxOK | wxICON_INFORMATION);
-        return;
-    }
-
-    ticketList->DeleteAllItems();
-    int index = 0;
-    for (const auto &ticket : results)
-    {
-        ticketList->InsertItem(index, ticket.getTicketNumber().toString());
-        ticketList->SetItem(index, 1, ticket.getPassenger()->getPassport().toString());
-        ticketList->SetItem(index, 2, ticket.getFlight()->getFlightNumber().toString());
-        ticketList->SetItem(index, 3, ticket.getSeatNumber().toString());
-
-        // Format price with thousand separators
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(0) << ticket.getPrice().getAmount();
-        std::string priceStr = ss.str();
-        // Add thousand separators
-        for (int i = priceStr.length() - 3; i > 0; i -= 3)
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), ticketService, &ApplicationContext::ticketService, context, query),
+        context.cancellation,
+        [this, lookup](Result<std::vector<Ticket>> result)
         {
-            priceStr.insert(i, ".");
-        }
-        ticketList->SetItem(index, 4, priceStr);
-
-        ticketList->SetItem(index, 5, ticket.getStatusVietnamese());
-        index++;
-    }
+            EndSearch();
+            if (!result)
+            {
+                if (lookup)
+                    wxMessageBox("Không tìm thấy vé", "Thông báo", wxOK | wxICON_INFORMATION);
+                else
+                    wxMessageBox("Lỗi khi tìm kiếm", "Lỗi", wxOK | wxICON_ERROR);
+                return;
+            }
+
+            // Display results
+            if (result.value().empty())
+            {
+                wxMessageBox("Không tìm thấy vé nào", "Thông báo", wxOK | wxICON_INFORMATION);
+                return;
+            }
+
+            ShowSearchResults(result.value());
+            UpdateLoadStatus();
+        });
 }
 
 void TicketWindow::OnAddTicket(wxCommandEvent &event)
@@ -636,4 +789,63 @@ void TicketWindow::OnBack(wxCommandEvent &event)
 void TicketWindow::OnRefresh(wxCommandEvent &event)
 {
     RefreshTicketList();
+}
+
+void TicketWindow::OnCancelLoad(wxCommandEvent &event)
+{
+    searchCancellation.cancel();
+    ticketSource.cancel();
+    EndSearch();
+}
+
+void TicketWindow::OnQuickSearchText(wxCommandEvent &event)
+{
+    // Mỗi lần gõ hẹn lại từ đầu nên chỉ lần gõ cuối trong một chuỗi gõ nhanh mới gây ra tìm kiếm
+    quickSearchTimer.StartOnce(QUICK_SEARCH_DELAY_MS);
+}
+
+void TicketWindow::OnQuickSearchTimer(wxTimerEvent &event)
+{
+    std::string text = quickSearchCtrl->GetValue().utf8_string();
+    if (text.find_first_not_of(" \t") == std::string::npos)
+    {
+        // Ô tìm trống: trở lại danh sách đầy đủ đang có trong bộ đệm
+        searchCancellation.cancel();
+        EndSearch();
+        ShowTicketList(ticketSource.size());
+        return;
+    }
+
+    auto context = BeginSearch();
+    DeliverOnUiThread(
+        Async::callService(asyncServices.get(), ticketService, &ApplicationContext::ticketService, context,
+                           [text](TicketService &service) -> Result<std::vector<TicketListRow>>
+                           {
+                               std::vector<TicketListRow> rows;
+                               auto found = service.suggestTickets(text, QUICK_SEARCH_LIMIT, rows);
+                               if (!found)
+                                   return Failure<std::vector<TicketListRow>>(found.error());
+                               return Success(std::move(rows));
+                           }),
+        context.cancellation,
+        [this](Result<std::vector<TicketListRow>> rowsResult)
+        {
+            EndSearch();
+            if (!rowsResult)
+            {
+                SetStatusText(wxString::Format("Lỗi tìm nhanh: %s", rowsResult.error().message.c_str()));
+                return;
+            }
+
+            searchRows = std::move(*rowsResult);
+            if (searchRows.empty())
+            {
+                ticketList->ClearRows();
+                SetStatusText("Không tìm thấy vé");
+                return;
+            }
+            ticketList->ShowRows(static_cast<long>(searchRows.size()), [this](long item, long column)
+                                 { return TicketCell(searchRows[static_cast<size_t>(item)], column); });
+            UpdateLoadStatus();
+        });
 }
\ No newline at end of file
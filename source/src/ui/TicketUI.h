@@ -3,8 +3,10 @@
 #include <wx/wx.h>
 #include <wx/listctrl.h>
 #include "MainUI.h"
+#include "VirtualListCtrl.h"
 #include "core/entities/Ticket.h"
 #include "services/TicketService.h"
+#include "async/AsyncRowSource.h"
 
 /**
  * @brief Cửa sổ quản lý vé máy bay
@@ -22,6 +24,11 @@ public:
      */
     TicketWindow(const wxString &title, std::shared_ptr<TicketService> ticketService);
 
+    /**
+     * @brief Destructor, hủy các lượt tải còn đang chạy
+     */
+    ~TicketWindow();
+
     /**
      * @brief Thiết lập các service cần thiết cho việc điều hướng
      * @param aircraft Service quản lý máy bay
@@ -53,8 +60,14 @@ private:
     wxButton *searchButton;
     /// Nút làm mới danh sách
     wxButton *refreshButton;
-    /// Danh sách hiển thị thông tin vé
-    wxListCtrl *ticketList;
+    /// Nút hủy lượt tải đang chạy
+    wxButton *cancelLoadButton;
+    /// Ô tìm nhanh theo số vé, tìm ngay khi đang gõ
+    wxTextCtrl *quickSearchCtrl;
+    /// Hẹn giờ một lần: chỉ tìm khi người dùng ngừng gõ một lúc
+    wxTimer quickSearchTimer;
+    /// Danh sách ảo hiển thị thông tin vé
+    VirtualListCtrl *ticketList;
     /// Label hiển thị thông tin bổ sung
     wxStaticText *infoLabel;
 
@@ -67,16 +80,57 @@ private:
     /// Service quản lý hành khách
     std::shared_ptr<PassengerService> passengerService;
 
+    /// Facade bất đồng bộ; null thì service được gọi đồng bộ trên luồng giao diện
+    std::shared_ptr<Async::AsyncServices> asyncServices;
+    /// Số vé và các trang hàng vé của danh sách đầy đủ, nạp trên worker theo vùng đang cuộn tới
+    Async::AsyncRowSource<TicketListRow> ticketSource;
+    /// Kết quả tìm kiếm đang hiển thị
+    std::vector<TicketListRow> searchRows;
+    /// Hủy lượt tìm kiếm đang chạy khi có lượt mới, khi bấm hủy hoặc khi đóng cửa sổ
+    Async::CancellationSource searchCancellation;
+    /// Có lượt tìm kiếm đang chạy
+    bool searching = false;
+    /// Thay đổi vé từ repository, áp dụng vào danh sách tại chỗ thay cho nạp lại toàn bộ
+    Changes::Subscription changeSubscription;
+
     /**
      * @brief Khởi tạo giao diện người dùng
      */
     void CreateUI();
 
     /**
-     * @brief Làm mới danh sách vé
+     * @brief Làm mới danh sách vé: đếm lại số vé trên worker, các trang được nạp dần khi cuộn tới
      */
     void RefreshTicketList();
 
+    /**
+     * @brief Hiển thị danh sách đầy đủ với số vé vừa đếm được
+     * @param count Tổng số vé
+     */
+    void ShowTicketList(size_t count);
+
+    /**
+     * @brief Cập nhật nút hủy và thanh trạng thái theo các lượt tải đang chạy
+     */
+    void UpdateLoadStatus();
+
+    /**
+     * @brief Bắt đầu một lượt tìm kiếm mới, hủy lượt trước nếu còn chạy
+     * @return Ngữ cảnh của lượt tìm kiếm
+     */
+    Async::CallContext BeginSearch();
+
+    /**
+     * @brief Kết thúc lượt tìm kiếm đang chạy khi kết quả đã về luồng giao diện
+     */
+    void EndSearch();
+
+    /**
+     * @brief Hiển thị kết quả tìm kiếm trong danh sách ảo
+     * @param tickets Các vé tìm được
+     */
+    void ShowSearchResults(const std::vector<Ticket> &tickets);
+
     /**
      * @brief Hiển thị chi tiết thông tin vé
      * @param ticket Vé cần hiển thị chi tiết
@@ -147,6 +201,24 @@ private:
      */
     void OnRefresh(wxCommandEvent &event);
 
+    /**
+     * @brief Xử lý sự kiện hủy lượt tải đang chạy
+     * @param event Sự kiện nút bấm
+     */
+    void OnCancelLoad(wxCommandEvent &event);
+
+    /**
+     * @brief Xử lý sự kiện gõ vào ô tìm nhanh: hẹn lại giờ tìm
+     * @param event Sự kiện thay đổi văn bản
+     */
+    void OnQuickSearchText(wxCommandEvent &event);
+
+    /**
+     * @brief Tìm các vé có số vé bắt đầu bằng văn bản đã gõ
+     * @param event Sự kiện hẹn giờ
+     */
+    void OnQuickSearchTimer(wxTimerEvent &event);
+
     /**
      * @brief Xử lý sự kiện chọn item trong danh sách
      * @param event Sự kiện chọn item
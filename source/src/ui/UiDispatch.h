@@ -0,0 +1,56 @@
+#pragma once
+
+#include <wx/wx.h>
+#include "async/Future.h"
+#include "utils/ChangeFeed.h"
+#include <functional>
+
+/**
+ * @brief Chuyển task về luồng giao diện (wxApp::CallAfter), gọi được từ worker
+ *
+ * Bỏ qua task nếu ứng dụng đã thoát (wxTheApp là null).
+ */
+inline void PostToUiThread(std::function<void()> task)
+{
+    if (wxTheApp)
+    {
+        wxTheApp->CallAfter(std::move(task));
+    }
+}
+
+/**
+ * @brief Chạy callback(Result<T>) trên luồng giao diện khi future có kết quả
+ *
+ * Callback bị bỏ qua nếu token đã bị hủy lúc kết quả tới luồng giao diện: cửa sổ đã đóng,
+ * người dùng đã bấm hủy hoặc đã có lượt tải mới hơn. Vì vậy callback được phép chạm vào cửa sổ
+ * miễn là cửa sổ hủy token trong destructor.
+ */
+template <typename T, typename F>
+void DeliverOnUiThread(Async::Future<T> future, Async::CancellationToken token, F callback)
+{
+    future.onReady([token, callback = std::move(callback)](Result<T> result) mutable
+                   { PostToUiThread([token, callback, result = std::move(result)]() mutable
+                                    {
+                                        if (!token.isCancelled())
+                                            callback(std::move(result));
+                                    }); });
+}
+
+/**
+ * @brief Đăng ký nhận thay đổi của một loại thực thể, chuyển về luồng giao diện qua owner->CallAfter
+ *
+ * Sự kiện được phát trên luồng thực hiện lệnh ghi (có thể là worker). Dùng CallAfter của chính
+ * cửa sổ nên sự kiện còn chờ bị bỏ khi cửa sổ bị hủy; cửa sổ vẫn phải reset() đăng ký ở đầu
+ * destructor để handler không chạy trong lúc các thành viên đang bị hủy.
+ */
+inline Changes::Subscription SubscribeOnUiThread(wxEvtHandler *owner, Changes::Entity entity,
+                                                 std::function<void(Changes::Kind kind, int id)> apply)
+{
+    return Changes::Feed::getInstance()->subscribe(
+        [owner, entity, apply = std::move(apply)](const Changes::Event &event)
+        {
+            if (event.entity == entity)
+                owner->CallAfter([apply, event]()
+                                 { apply(event.kind, event.id); });
+        });
+}
@@ -0,0 +1,57 @@
+#include "VirtualListCtrl.h"
+#include <algorithm>
+
+VirtualListCtrl::VirtualListCtrl(wxWindow *parent, wxWindowID id, const wxSize &size, long style)
+    : wxListCtrl(parent, id, wxDefaultPosition, size, style | wxLC_REPORT | wxLC_VIRTUAL)
+{
+    Bind(wxEVT_LIST_CACHE_HINT, &VirtualListCtrl::OnCacheHint, this);
+}
+
+void VirtualListCtrl::ShowRows(long count, CellProvider cells, CacheHint hint)
+{
+    this->cells = std::move(cells);
+    this->hint = std::move(hint);
+    // Bỏ vùng chọn cũ: chỉ số hàng không còn trỏ tới cùng bản ghi
+    SetItemState(-1, 0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    SetItemCount(count);
+    Refresh();
+}
+
+void VirtualListCtrl::ClearRows()
+{
+    ShowRows(0, nullptr);
+}
+
+void VirtualListCtrl::RefreshRows(long first, long last)
+{
+    last = std::min<long>(last, GetItemCount() - 1);
+    if (first <= last)
+    {
+        RefreshItems(first, last);
+    }
+}
+
+void VirtualListCtrl::ResizeRows(long count, long first)
+{
+    // Hàng được chọn từ first trở đi giờ là một bản ghi khác
+    long selected = GetNextItem(first - 1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+    if (selected != -1)
+    {
+        SetItemState(selected, 0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    }
+    SetItemCount(count);
+    RefreshRows(first, count - 1);
+}
+
+wxString VirtualListCtrl::OnGetItemText(long item, long column) const
+{
+    return cells ? cells(item, column) : wxString();
+}
+
+void VirtualListCtrl::OnCacheHint(wxListEvent &event)
+{
+    if (hint)
+    {
+        hint(event.GetCacheFrom(), event.GetCacheTo());
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <functional>
+
+/**
+ * @brief Danh sách ảo (wxLC_VIRTUAL) lấy nội dung ô theo yêu cầu
+ *
+ * Danh sách không giữ hàng nào: wxWidgets chỉ hỏi nội dung các hàng đang hiển thị
+ * qua OnGetItemText, và báo trước vùng sắp vẽ qua sự kiện cache hint để cửa sổ
+ * nạp trang tương ứng (xem PagedRowCache). Số hàng được đặt một lần bằng ShowRows.
+ */
+class VirtualListCtrl : public wxListCtrl
+{
+public:
+    /// Trả về nội dung ô (item, column)
+    using CellProvider = std::function<wxString(long item, long column)>;
+    /// Gợi ý các hàng [from, to] sắp được vẽ
+    using CacheHint = std::function<void(long from, long to)>;
+
+    /**
+     * @brief Constructor
+     * @param parent Cửa sổ cha
+     * @param id ID của control
+     * @param size Kích thước ban đầu
+     * @param style Kiểu bổ sung; wxLC_REPORT | wxLC_VIRTUAL luôn được bật
+     */
+    VirtualListCtrl(wxWindow *parent, wxWindowID id = wxID_ANY, const wxSize &size = wxDefaultSize,
+                    long style = wxLC_SINGLE_SEL);
+
+    /**
+     * @brief Hiển thị count hàng lấy nội dung từ cells
+     * @param count Số hàng
+     * @param cells Hàm lấy nội dung ô
+     * @param hint Hàm nạp trước vùng sắp vẽ (tùy chọn)
+     */
+    void ShowRows(long count, CellProvider cells, CacheHint hint = nullptr);
+
+    /**
+     * @brief Xóa danh sách, bỏ các hàm cung cấp nội dung
+     */
+    void ClearRows();
+
+    /**
+     * @brief Vẽ lại các hàng [first, last] khi dữ liệu của chúng vừa về (giới hạn trong số hàng hiện có)
+     */
+    void RefreshRows(long first, long last);
+
+    /**
+     * @brief Đổi số hàng sau khi thêm hoặc xóa một hàng mà không vẽ lại toàn bộ danh sách
+     * @param count Số hàng mới
+     * @param first Hàng đầu tiên đã dịch chuyển; vùng chọn từ hàng này trở đi bị bỏ
+     */
+    void ResizeRows(long count, long first);
+
+protected:
+    wxString OnGetItemText(long item, long column) const override;
+
+private:
+    /// Hàm lấy nội dung ô của nguồn hiện tại
+    CellProvider cells;
+    /// Hàm nạp trước của nguồn hiện tại
+    CacheHint hint;
+
+    /**
+     * @brief Xử lý sự kiện gợi ý vùng hàng sắp vẽ
+     * @param event Sự kiện danh sách
+     */
+    void OnCacheHint(wxListEvent &event);
+};
@@ -0,0 +1,94 @@
+#include "ChangeFeed.h"
+#include <algorithm>
+
+namespace Changes {
+
+std::shared_ptr<Feed> Feed::_instance;
+std::mutex Feed::_instanceMutex;
+
+std::string toString(Entity entity) {
+    switch (entity) {
+        case Entity::AIRCRAFT:  return "aircraft";
+        case Entity::FLIGHT:    return "flight";
+        case Entity::PASSENGER: return "passenger";
+        case Entity::TICKET:    return "ticket";
+    }
+    return "unknown";
+}
+
+std::string toString(Kind kind) {
+    switch (kind) {
+        case Kind::CREATED: return "created";
+        case Kind::UPDATED: return "updated";
+        case Kind::DELETED: return "deleted";
+    }
+    return "unknown";
+}
+
+Subscription& Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        _feed = std::move(other._feed);
+        _id = other._id;
+        other._id = 0;
+    }
+    return *this;
+}
+
+void Subscription::reset() {
+    if (_id == 0) return;
+    if (auto feed = _feed.lock()) feed->unsubscribe(_id);
+    _feed.reset();
+    _id = 0;
+}
+
+std::shared_ptr<Feed> Feed::getInstance() {
+    std::lock_guard<std::mutex> lock(_instanceMutex);
+    if (!_instance) {
+        _instance = std::make_shared<Feed>();
+    }
+    return _instance;
+}
+
+Subscription Feed::subscribe(Handler handler) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t id = _nextId++;
+    _entries.push_back({id, std::make_shared<const Handler>(std::move(handler))});
+    _subscribers.store(_entries.size(), std::memory_order_relaxed);
+    return Subscription(weak_from_this(), id);
+}
+
+void Feed::unsubscribe(uint64_t id) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+                                      [id](const Entry& entry) { return entry.id == id; }),
+                       _entries.end());
+        _subscribers.store(_entries.size(), std::memory_order_relaxed);
+    }
+    // Chờ các lượt publish() đã chụp danh sách cũ (có thể còn chứa handler này) chạy xong
+    std::unique_lock<std::shared_mutex> barrier(_dispatch);
+}
+
+void Feed::publish(const Event& event) {
+    if (_subscribers.load(std::memory_order_relaxed) == 0) return;
+
+    std::shared_lock<std::shared_mutex> dispatching(_dispatch);
+    std::vector<std::shared_ptr<const Handler>> handlers;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        handlers.reserve(_entries.size());
+        for (const auto& entry : _entries) handlers.push_back(entry.handler);
+    }
+    _published.fetch_add(1, std::memory_order_relaxed);
+
+    for (const auto& handler : handlers) {
+        try {
+            (*handler)(event);
+        } catch (...) {
+            // Lệnh ghi đã commit; một handler lỗi không được làm lệnh ghi trông như thất bại
+        }
+    }
+}
+
+} // namespace Changes
@@ -0,0 +1,147 @@
+/**
+ * @file ChangeFeed.h
+ * @brief Bus sự kiện thay đổi trong tiến trình: repository báo thêm, sửa, xóa theo id
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Sau mỗi thao tác ghi, các cửa sổ từng phải đếm lại và nạp lại toàn bộ danh sách. Giờ mỗi
+ * repository phát một Changes::Event (loại thực thể, loại thay đổi, id) sau khi lệnh ghi đã
+ * được commit, và danh sách đang hiển thị áp dụng thay đổi đó vào bộ đệm của mình: sửa một vé
+ * chỉ nạp lại đúng một hàng.
+ *
+ * Feed dùng chung cho mọi ApplicationContext trong tiến trình (kể cả các context AsyncServices
+ * dựng trên kết nối mượn), nên publish() có thể được gọi từ bất kỳ luồng nào. Handler chạy trên
+ * luồng phát sự kiện; handler của giao diện chỉ chuyển sự kiện về luồng giao diện.
+ *
+ * Khi không có ai đăng ký, publish() chỉ tốn một lần đọc atomic.
+ */
+
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace Changes {
+
+/**
+ * @brief Loại thực thể bị thay đổi
+ */
+enum class Entity {
+    AIRCRAFT,
+    FLIGHT,
+    PASSENGER,
+    TICKET
+};
+
+/**
+ * @brief Loại thay đổi
+ */
+enum class Kind {
+    CREATED,
+    UPDATED,
+    DELETED
+};
+
+/**
+ * @brief Một thay đổi đã được commit
+ */
+struct Event {
+    Entity entity = Entity::TICKET;
+    Kind kind = Kind::UPDATED;
+    int id = 0;              ///< Id của hàng bị thay đổi
+
+    bool operator==(const Event&) const = default;
+};
+
+std::string toString(Entity entity);
+std::string toString(Kind kind);
+
+class Feed;
+
+/**
+ * @brief Đăng ký nhận sự kiện theo RAII; hủy đối tượng là hủy đăng ký
+ *
+ * Hủy đăng ký chờ các lượt handler đang chạy trên luồng khác kết thúc, nên sau khi reset()
+ * trả về, handler chắc chắn không còn chạm vào đối tượng sở hữu nó. Không được hủy đăng ký
+ * từ bên trong chính handler.
+ */
+class Subscription {
+private:
+    std::weak_ptr<Feed> _feed;
+    uint64_t _id = 0;
+
+public:
+    Subscription() = default;
+    Subscription(std::weak_ptr<Feed> feed, uint64_t id) : _feed(std::move(feed)), _id(id) {}
+    ~Subscription() { reset(); }
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+    Subscription(Subscription&& other) noexcept : _feed(std::move(other._feed)), _id(other._id) { other._id = 0; }
+    Subscription& operator=(Subscription&& other) noexcept;
+
+    /// Hủy đăng ký; gọi nhiều lần không có tác dụng
+    void reset();
+    bool isActive() const { return _id != 0; }
+};
+
+class Feed : public std::enable_shared_from_this<Feed> {
+public:
+    using Handler = std::function<void(const Event& event)>;
+
+private:
+    struct Entry {
+        uint64_t id = 0;
+        std::shared_ptr<const Handler> handler;
+    };
+
+    static std::shared_ptr<Feed> _instance;
+    static std::mutex _instanceMutex;
+
+    mutable std::mutex _mutex;               ///< Bảo vệ _entries
+    std::shared_mutex _dispatch;             ///< publish() giữ chung khi gọi handler; hủy đăng ký giữ riêng để chờ
+    std::vector<Entry> _entries;
+    uint64_t _nextId = 1;
+    std::atomic<size_t> _subscribers{0};
+    std::atomic<uint64_t> _published{0};
+
+    friend class Subscription;
+    void unsubscribe(uint64_t id);
+
+public:
+    Feed() = default;
+    Feed(const Feed&) = delete;
+    Feed& operator=(const Feed&) = delete;
+
+    static std::shared_ptr<Feed> getInstance();
+
+    /**
+     * @brief Đăng ký handler nhận mọi sự kiện phát sau lời gọi này
+     * @return Đối tượng giữ đăng ký; handler bị gỡ khi nó bị hủy
+     */
+    [[nodiscard]] Subscription subscribe(Handler handler);
+
+    /**
+     * @brief Gọi lần lượt mọi handler đã đăng ký trên luồng hiện tại
+     * @note Handler không được ném ngoại lệ ra ngoài; ngoại lệ bị nuốt để không làm hỏng lệnh ghi
+     */
+    void publish(const Event& event);
+
+    void publish(Entity entity, Kind kind, int id) { publish(Event{entity, kind, id}); }
+
+    size_t subscriberCount() const { return _subscribers.load(std::memory_order_relaxed); }
+    /// Tổng số sự kiện đã phát khi có ít nhất một người đăng ký
+    uint64_t publishedCount() const { return _published.load(std::memory_order_relaxed); }
+};
+
+} // namespace Changes
+
+#endif // CHANGE_FEED_H
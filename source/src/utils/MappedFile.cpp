@@ -0,0 +1,67 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+MappedFile::~MappedFile() {
+    if (_base) ::UnmapViewOfFile(_base);
+    if (_mapping) ::CloseHandle(_mapping);
+    if (_file && _file != INVALID_HANDLE_VALUE) ::CloseHandle(_file);
+}
+
+Result<bool> MappedFile::open(const std::string& path, const std::string& errorCode) {
+    _file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) return Failure<bool>(CoreError("Cannot open " + path, errorCode));
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(_file, &size)) return Failure<bool>(CoreError("Cannot stat " + path, errorCode));
+    _size = static_cast<size_t>(size.QuadPart);
+    // CreateFileMapping không nhận tệp rỗng
+    if (_size == 0) return Success(true);
+
+    _mapping = ::CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping) {
+        _size = 0;
+        return Failure<bool>(CoreError("Cannot map " + path, errorCode));
+    }
+    _base = ::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!_base) {
+        _size = 0;
+        return Failure<bool>(CoreError("Cannot map " + path, errorCode));
+    }
+    return Success(true);
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+    if (_base) ::munmap(_base, _size);
+    if (_fd >= 0) ::close(_fd);
+}
+
+Result<bool> MappedFile::open(const std::string& path, const std::string& errorCode) {
+    _fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) return Failure<bool>(CoreError("Cannot open " + path, errorCode));
+    struct stat status{};
+    if (::fstat(_fd, &status) != 0) return Failure<bool>(CoreError("Cannot stat " + path, errorCode));
+    _size = static_cast<size_t>(status.st_size);
+    // mmap không nhận độ dài 0
+    if (_size == 0) return Success(true);
+
+    void* base = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (base == MAP_FAILED) {
+        _size = 0;
+        return Failure<bool>(CoreError("Cannot map " + path, errorCode));
+    }
+    _base = base;
+    ::madvise(_base, _size, MADV_SEQUENTIAL);
+    return Success(true);
+}
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file MappedFile.h
+ * @brief Ánh xạ chỉ đọc toàn bộ một tệp vào bộ nhớ
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Dùng cho các tệp được đọc một lượt từ đầu đến cuối (ảnh chụp dữ liệu tham chiếu, tệp CSV cần
+ * nhập): trang được nạp theo nhu cầu và đọc trước theo MADV_SEQUENTIAL, không chép qua bộ đệm
+ * của luồng vào/ra. Tệp rỗng được mở thành vùng rỗng thay vì lỗi.
+ *
+ * Trên Windows dùng CreateFileMapping/MapViewOfFile (không có gợi ý đọc tuần tự).
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "../core/exceptions/Result.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+class MappedFile {
+private:
+#if defined(_WIN32) || defined(_WIN64)
+    void* _file = nullptr;      ///< HANDLE của tệp; để void* cho header khỏi kéo theo windows.h
+    void* _mapping = nullptr;   ///< HANDLE của đối tượng ánh xạ
+#else
+    int _fd = -1;
+#endif
+    void* _base = nullptr;
+    size_t _size = 0;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /**
+     * @brief Mở và ánh xạ tệp
+     * @param errorCode Mã lỗi trả về khi không mở, không đọc được kích thước hoặc không ánh xạ được
+     */
+    Result<bool> open(const std::string& path, const std::string& errorCode);
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(_base); }
+    size_t size() const { return _size; }
+    std::string_view text() const { return {static_cast<const char*>(_base), _size}; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,241 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Metrics {
+
+namespace {
+    // Các luồng được gán shard lần lượt theo thứ tự lần ghi đầu tiên
+    std::atomic<size_t> nextShard{0};
+
+    std::string escapeLabelValue(const std::string& value) {
+        std::string out;
+        out.reserve(value.size());
+        for (char c : value) {
+            switch (c) {
+                case '\\': out += "\\\\"; break;
+                case '"':  out += "\\\""; break;
+                case '\n': out += "\\n";  break;
+                default:   out += c;      break;
+            }
+        }
+        return out;
+    }
+
+    std::string formatLabels(const Labels& labels) {
+        std::string out;
+        for (const auto& [name, value] : labels) {
+            if (!out.empty()) out += ',';
+            out += name + "=\"" + escapeLabelValue(value) + "\"";
+        }
+        return out;
+    }
+
+    // {labels} hoặc {labels,extra}; rỗng nếu không có nhãn nào
+    std::string braces(const std::string& labels, const std::string& extra = "") {
+        if (labels.empty() && extra.empty()) return "";
+        if (labels.empty()) return "{" + extra + "}";
+        if (extra.empty()) return "{" + labels + "}";
+        return "{" + labels + "," + extra + "}";
+    }
+
+    std::string formatDouble(double value) {
+        if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+        std::ostringstream out;
+        out.precision(12);
+        out << value;
+        return out.str();
+    }
+}
+
+// === Counter ===
+
+size_t Counter::shardIndex() {
+    thread_local size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : _shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// === Histogram ===
+
+const std::vector<double>& Histogram::defaultLatencyBounds() {
+    static const std::vector<double> bounds = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10
+    };
+    return bounds;
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : _bounds(std::move(bounds)), _buckets(new std::atomic<uint64_t>[_bounds.size() + 1]) {
+    std::sort(_bounds.begin(), _bounds.end());
+    for (size_t i = 0; i <= _bounds.size(); ++i) {
+        _buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    // Bucket đầu tiên có cận trên >= value (le của Prometheus là "nhỏ hơn hoặc bằng")
+    size_t index = static_cast<size_t>(std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin());
+    _buckets[index].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// === MetricsRegistry ===
+
+std::shared_ptr<MetricsRegistry> MetricsRegistry::_instance = nullptr;
+std::mutex MetricsRegistry::_instanceMutex;
+
+std::shared_ptr<MetricsRegistry> MetricsRegistry::getInstance() {
+    std::lock_guard<std::mutex> lock(_instanceMutex);
+    if (!_instance) {
+        _instance = std::make_shared<MetricsRegistry>();
+    }
+    return _instance;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Type type) {
+    auto it = _families.find(name);
+    if (it == _families.end()) {
+        it = _families.emplace(name, Family{type, help, {}, {}, {}}).first;
+    } else if (it->second.type != type) {
+        throw std::logic_error("Metric " + name + " is already registered with a different type");
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& slot = family(name, help, Type::COUNTER).counters[formatLabels(labels)];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const Labels& labels) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& slot = family(name, help, Type::GAUGE).gauges[formatLabels(labels)];
+    if (!slot) slot = std::make_unique<Gauge>();
+    return *slot;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const Labels& labels,
+                                      const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& slot = family(name, help, Type::HISTOGRAM).histograms[formatLabels(labels)];
+    if (!slot) slot = std::make_unique<Histogram>(bounds);
+    return *slot;
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& [name, family] : _families) {
+        out << "# HELP " << name << " " << family.help << "\n";
+        switch (family.type) {
+            case Type::COUNTER:
+                out << "# TYPE " << name << " counter\n";
+                for (const auto& [labels, counter] : family.counters) {
+                    out << name << braces(labels) << " " << counter->value() << "\n";
+                }
+                break;
+            case Type::GAUGE:
+                out << "# TYPE " << name << " gauge\n";
+                for (const auto& [labels, gauge] : family.gauges) {
+                    out << name << braces(labels) << " " << gauge->value() << "\n";
+                }
+                break;
+            case Type::HISTOGRAM:
+                out << "# TYPE " << name << " histogram\n";
+                for (const auto& [labels, histogram] : family.histograms) {
+                    uint64_t cumulative = 0;
+                    const auto& bounds = histogram->bounds();
+                    for (size_t i = 0; i <= bounds.size(); ++i) {
+                        cumulative += histogram->bucketCount(i);
+                        double bound = i < bounds.size() ? bounds[i] : INFINITY;
+                        out << name << "_bucket" << braces(labels, "le=\"" + formatDouble(bound) + "\"")
+                            << " " << cumulative << "\n";
+                    }
+                    out << name << "_sum" << braces(labels) << " " << formatDouble(histogram->sum()) << "\n";
+                    // _count lấy từ tổng bucket để luôn khớp với bucket +Inf trong cùng snapshot
+                    out << name << "_count" << braces(labels) << " " << cumulative << "\n";
+                }
+                break;
+        }
+    }
+}
+
+std::string MetricsRegistry::exportPrometheus() const {
+    std::ostringstream out;
+    writePrometheus(out);
+    return out.str();
+}
+
+VoidResult MetricsRegistry::writePrometheusFile(const std::string& path) const {
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            return Failure(CoreError("Failed to open metrics file: " + tempPath, "METRICS_IO"));
+        }
+        writePrometheus(file);
+        if (!file.good()) {
+            return Failure(CoreError("Failed to write metrics file: " + tempPath, "METRICS_IO"));
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return Failure(CoreError("Failed to replace metrics file: " + path, "METRICS_IO"));
+    }
+    return Success();
+}
+
+// === OperationMetrics / OperationTimer ===
+
+OperationMetrics::OperationMetrics(const std::string& layer, const std::string& component, const std::string& operation,
+                                   MetricsRegistry& registry)
+    : _succeeded(registry.counter("airlines_" + layer + "_operations_total", "Completed " + layer + " operations by outcome",
+                                  {{"component", component}, {"operation", operation}, {"result", "success"}})),
+      _failed(registry.counter("airlines_" + layer + "_operations_total", "Completed " + layer + " operations by outcome",
+                               {{"component", component}, {"operation", operation}, {"result", "failure"}})),
+      _latency(registry.histogram("airlines_" + layer + "_operation_duration_seconds", "Latency of " + layer + " operations",
+                                  {{"component", component}, {"operation", operation}})),
+      _inFlight(registry.gauge("airlines_" + layer + "_operations_in_flight", "Running " + layer + " operations",
+                               {{"component", component}, {"operation", operation}})),
+      _spanName(component + "." + operation),
+      _spanCategory(layer) {}
+
+OperationTimer::OperationTimer(const OperationMetrics& metrics)
+    : _metrics(metrics), _start(std::chrono::steady_clock::now()),
+      _span(metrics._spanName.c_str(), metrics._spanCategory.c_str()) {
+    _metrics._inFlight.inc();
+}
+
+OperationTimer::~OperationTimer() {
+    if (!_finished) {
+        finish(false);
+    }
+}
+
+void OperationTimer::finish(bool succeeded) {
+    if (_finished) return;
+    _finished = true;
+    _metrics._latency.observe(std::chrono::steady_clock::now() - _start);
+    (succeeded ? _metrics._succeeded : _metrics._failed).inc();
+    _metrics._inFlight.dec();
+    if (!succeeded) {
+        _span.setArg("result", "failure");
+    }
+    _span.end();
+}
+
+} // namespace Metrics
@@ -0,0 +1,225 @@
+/**
+ * @file Metrics.h
+ * @brief Registry số đo (counter, gauge, histogram) cho service và repository, xuất dạng Prometheus
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Đường ghi không dùng khóa: Counter chia thành nhiều shard atomic nằm trên các cache line
+ * riêng, mỗi luồng cộng vào shard của mình; Gauge và Histogram là các atomic đơn. Khóa của
+ * registry chỉ được dùng khi đăng ký số đo mới và khi xuất snapshot, nên nơi gọi nên giữ lại
+ * tham chiếu trả về (thường là biến static cục bộ) thay vì tra cứu ở mỗi lần ghi.
+ *
+ * Snapshot được xuất theo định dạng văn bản Prometheus (exposition format 0.0.4) ra stream
+ * bất kỳ (ví dụ std::cout) hoặc ra file để node_exporter textfile collector đọc.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "../core/exceptions/Result.h"
+#include "Tracing.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Metrics {
+
+/// Cặp (tên nhãn, giá trị nhãn)
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Bộ đếm chỉ tăng, chia shard để các luồng không tranh chấp cùng cache line
+ */
+class Counter {
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, SHARD_COUNT> _shards;
+
+    static size_t shardIndex();
+
+public:
+    void inc(uint64_t amount = 1) {
+        _shards[shardIndex()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// Tổng các shard; có thể lệch nhẹ nếu đang có luồng ghi đồng thời
+    uint64_t value() const;
+};
+
+/**
+ * @brief Giá trị có thể tăng giảm (số thao tác đang chạy, kích thước hàng đợi...)
+ */
+class Gauge {
+private:
+    std::atomic<int64_t> _value{0};
+
+public:
+    void set(int64_t value) { _value.store(value, std::memory_order_relaxed); }
+    void add(int64_t amount) { _value.fetch_add(amount, std::memory_order_relaxed); }
+    void inc() { add(1); }
+    void dec() { add(-1); }
+    int64_t value() const { return _value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Histogram với các cận trên cố định, mỗi bucket là một atomic
+ *
+ * Khác LatencyHistogram của QueryStats (độ phân giải cao, có khóa), histogram này dùng
+ * cùng bộ cận với Prometheus để xuất trực tiếp dưới dạng bucket tích lũy.
+ */
+class Histogram {
+private:
+    std::vector<double> _bounds;                          ///< Cận trên tăng dần, không gồm +Inf
+    std::unique_ptr<std::atomic<uint64_t>[]> _buckets;    ///< _bounds.size() + 1 bucket, bucket cuối là +Inf
+    std::atomic<uint64_t> _count{0};
+    std::atomic<double> _sum{0.0};
+
+public:
+    /// Cận mặc định cho độ trễ tính bằng giây, từ 100µs đến 10s
+    static const std::vector<double>& defaultLatencyBounds();
+
+    explicit Histogram(std::vector<double> bounds = defaultLatencyBounds());
+
+    void observe(double value);
+    void observe(std::chrono::nanoseconds duration) { observe(duration.count() / 1e9); }
+
+    const std::vector<double>& bounds() const { return _bounds; }
+    /// Số lần ghi vào bucket index (không tích lũy); index == bounds().size() là bucket +Inf
+    uint64_t bucketCount(size_t index) const { return _buckets[index].load(std::memory_order_relaxed); }
+    uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+    double sum() const { return _sum.load(std::memory_order_relaxed); }
+};
+
+class MetricsRegistry {
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::map<std::string, std::unique_ptr<Counter>> counters;      ///< Khóa là chuỗi nhãn đã định dạng
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    static std::shared_ptr<MetricsRegistry> _instance;
+    static std::mutex _instanceMutex;
+
+    std::map<std::string, Family> _families;
+    mutable std::mutex _mutex;
+
+    Family& family(const std::string& name, const std::string& help, Type type);
+
+public:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /// Registry dùng chung cho service và repository
+    static std::shared_ptr<MetricsRegistry> getInstance();
+
+    /**
+     * @brief Lấy (hoặc tạo) counter theo tên và nhãn
+     *
+     * Tham chiếu trả về có hiệu lực suốt vòng đời registry. Cùng tên nhưng khác loại số đo
+     * là lỗi lập trình và ném std::logic_error.
+     */
+    Counter& counter(const std::string& name, const std::string& help, const Labels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help, const Labels& labels = {},
+                         const std::vector<double>& bounds = Histogram::defaultLatencyBounds());
+
+    /// Ghi snapshot theo định dạng văn bản Prometheus
+    void writePrometheus(std::ostream& out) const;
+    std::string exportPrometheus() const;
+
+    /**
+     * @brief Ghi snapshot ra file
+     *
+     * Ghi vào file tạm rồi đổi tên để bên đọc không bao giờ thấy file ghi dở.
+     */
+    VoidResult writePrometheusFile(const std::string& path) const;
+};
+
+/**
+ * @brief Bộ số đo chuẩn cho một thao tác: số lần thành công/thất bại, độ trễ, số lượt đang chạy
+ *
+ * Tên số đo là airlines_<layer>_operations_total, airlines_<layer>_operation_duration_seconds
+ * và airlines_<layer>_operations_in_flight, gắn nhãn component và operation.
+ */
+class OperationMetrics {
+private:
+    Counter& _succeeded;
+    Counter& _failed;
+    Histogram& _latency;
+    Gauge& _inFlight;
+    std::string _spanName;      ///< "<component>.<operation>", tên span tracing của thao tác
+    std::string _spanCategory;  ///< layer
+
+    friend class OperationTimer;
+
+public:
+    /**
+     * @param layer "service" hoặc "repository"
+     * @param component Ví dụ "ticket", "flight"
+     * @param operation Ví dụ "book", "find_by_id"
+     */
+    OperationMetrics(const std::string& layer, const std::string& component, const std::string& operation,
+                     MetricsRegistry& registry = *MetricsRegistry::getInstance());
+};
+
+/**
+ * @brief Đo một lần gọi thao tác theo RAII
+ *
+ * Đồng thời mở một Tracing::Span, nên các span repository và SQL bên trong nằm dưới thao tác này.
+ * Mặc định ghi nhận thất bại khi ra khỏi phạm vi, để mọi nhánh return lỗi sớm đều được đếm;
+ * nhánh thành công trả kết quả qua complete().
+ *
+ * @code
+ * static const Metrics::OperationMetrics metrics("service", "ticket", "book");
+ * Metrics::OperationTimer timer(metrics);
+ * ...
+ * return timer.complete(_ticketRepository->create(ticket));
+ * @endcode
+ */
+class OperationTimer {
+private:
+    const OperationMetrics& _metrics;
+    std::chrono::steady_clock::time_point _start;
+    Tracing::Span _span;
+    bool _finished = false;
+
+    void finish(bool succeeded);
+
+public:
+    explicit OperationTimer(const OperationMetrics& metrics);
+    ~OperationTimer();
+
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+
+    /// Ghi nhận kết quả theo has_value() và trả nguyên kết quả
+    template <class T>
+    Result<T> complete(Result<T> result) {
+        finish(result.has_value());
+        return result;
+    }
+};
+
+} // namespace Metrics
+
+#endif // METRICS_H
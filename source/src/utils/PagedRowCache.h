@@ -0,0 +1,253 @@
+/**
+ * @file PagedRowCache.h
+ * @brief Bộ đệm trang hàng cho danh sách ảo (wxLC_VIRTUAL)
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Danh sách ảo chỉ hỏi nội dung của các hàng đang hiển thị. PagedRowCache nạp theo từng trang
+ * cố định (pageSize hàng) qua hàm nạp trang của service và giữ tối đa maxPages trang; trang ít
+ * được dùng nhất bị thay thế (LRU) và vector của nó được tái sử dụng. Bộ nhớ vì vậy bị chặn bởi
+ * pageSize * maxPages hàng bất kể bảng có bao nhiêu hàng.
+ *
+ * Khi hàm nạp trang lỗi, lỗi được giữ lại và không nạp thêm trang nào cho đến reset(), tránh
+ * việc mỗi lần vẽ lại danh sách lại gửi truy vấn hỏng xuống cơ sở dữ liệu.
+ *
+ * Các thay đổi đơn lẻ (từ Changes::Feed) được áp dụng tại chỗ thay vì reset(): replaceRow() thay
+ * một hàng, insertById()/removeById() dời số hàng và chỉ bỏ các trang bị dịch chuyển. Các hàm theo
+ * id yêu cầu Row có trường id và danh sách được sắp theo id tăng dần (như mọi truy vấn trang).
+ *
+ * @note Không an toàn luồng; chỉ dùng trên luồng giao diện.
+ */
+
+#ifndef PAGED_ROW_CACHE_H
+#define PAGED_ROW_CACHE_H
+
+#include "../core/exceptions/Result.h"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+template <typename Row>
+class PagedRowCache {
+public:
+    /// Nạp tối đa limit hàng bắt đầu từ offset vào rows (rows đã được xóa); có thể rỗng nếu
+    /// các trang chỉ được đặt qua insertPage (nạp ở nơi khác, ví dụ trên worker)
+    using PageLoader = std::function<Result<size_t>(size_t offset, size_t limit, std::vector<Row>& rows)>;
+
+private:
+    struct Page {
+        size_t index = 0;
+        std::vector<Row> rows;
+    };
+
+    PageLoader _loader;
+    size_t _pageSize;
+    size_t _maxPages;
+    size_t _rowCount = 0;
+    size_t _pageLoads = 0;
+    std::list<Page> _pages;   ///< Trang dùng gần nhất ở đầu
+    std::unordered_map<size_t, typename std::list<Page>::iterator> _byIndex;
+    std::optional<CoreError> _error;
+
+    /// Đưa một trang trống lên đầu, thay thế trang cũ nhất khi đã đủ maxPages
+    Page& acquirePage(size_t pageIndex) {
+        if (_pages.size() >= _maxPages) {
+            // Tái sử dụng trang cũ nhất cùng dung lượng vector của nó
+            _byIndex.erase(_pages.back().index);
+            _pages.splice(_pages.begin(), _pages, std::prev(_pages.end()));
+        } else {
+            _pages.emplace_front();
+        }
+        Page& target = _pages.front();
+        target.index = pageIndex;
+        target.rows.clear();
+        return target;
+    }
+
+    /// Trang chứa pageIndex, nạp nếu chưa có; nullptr nếu nạp lỗi
+    Page* page(size_t pageIndex) {
+        auto found = _byIndex.find(pageIndex);
+        if (found != _byIndex.end()) {
+            _pages.splice(_pages.begin(), _pages, found->second);
+            return &_pages.front();
+        }
+        if (_error || !_loader) return nullptr;
+
+        Page& target = acquirePage(pageIndex);
+        ++_pageLoads;
+        auto loaded = _loader(pageIndex * _pageSize, _pageSize, target.rows);
+        if (!loaded) {
+            _error = loaded.error();
+            _pages.pop_front();
+            return nullptr;
+        }
+        _byIndex[pageIndex] = _pages.begin();
+        return &target;
+    }
+
+    /// Bỏ các trang có hàng id lớn hơn hoặc bằng id và trang chứa hàng tail; trả về hàng đầu tiên bị ảnh hưởng
+    size_t dropShiftedPages(int id, size_t tail) {
+        size_t first = tail;
+        size_t tailPage = tail / _pageSize;
+        for (auto it = _pages.begin(); it != _pages.end();) {
+            bool shifted = it->index == tailPage || (!it->rows.empty() && it->rows.back().id >= id);
+            if (!shifted) {
+                ++it;
+                continue;
+            }
+            auto found = std::lower_bound(it->rows.begin(), it->rows.end(), id,
+                                          [](const Row& row, int value) { return row.id < value; });
+            first = std::min(first, it->index * _pageSize + static_cast<size_t>(found - it->rows.begin()));
+            _byIndex.erase(it->index);
+            it = _pages.erase(it);
+        }
+        return first;
+    }
+
+public:
+    /**
+     * @param loader Hàm nạp trang, thường gọi phương thức get...Page của service
+     * @param pageSize Số hàng mỗi trang
+     * @param maxPages Số trang tối đa giữ trong bộ đệm (ít nhất 1)
+     */
+    explicit PagedRowCache(PageLoader loader, size_t pageSize = 200, size_t maxPages = 8)
+        : _loader(std::move(loader)), _pageSize(std::max<size_t>(pageSize, 1)), _maxPages(std::max<size_t>(maxPages, 1)) {}
+
+    /**
+     * @brief Bỏ mọi trang đã nạp và lỗi đã ghi nhận, đặt lại số hàng
+     * @param rowCount Tổng số hàng của danh sách (thường từ COUNT(*))
+     */
+    void reset(size_t rowCount) {
+        _rowCount = rowCount;
+        _pages.clear();
+        _byIndex.clear();
+        _error.reset();
+    }
+
+    size_t size() const { return _rowCount; }
+    size_t pageSize() const { return _pageSize; }
+    size_t maxPages() const { return _maxPages; }
+    size_t cachedPages() const { return _pages.size(); }
+    size_t pageLoads() const { return _pageLoads; }
+    const std::optional<CoreError>& lastError() const { return _error; }
+
+    /**
+     * @brief Đặt sẵn một trang đã được nạp ở nơi khác (ví dụ trang đầu nạp trên worker)
+     * @param pageIndex Chỉ số trang (offset / pageSize)
+     * @param rows Các hàng của trang
+     */
+    void insertPage(size_t pageIndex, std::vector<Row> rows) {
+        auto found = _byIndex.find(pageIndex);
+        if (found != _byIndex.end()) {
+            _pages.erase(found->second);
+            _byIndex.erase(found);
+        }
+        Page& target = acquirePage(pageIndex);
+        target.rows = std::move(rows);
+        _byIndex[pageIndex] = _pages.begin();
+    }
+
+    /**
+     * @brief Hàng thứ index, nạp trang chứa nó nếu cần
+     * @return nullptr nếu index ngoài phạm vi, trang nạp lỗi, hoặc bảng đã ngắn lại sau lần đếm
+     */
+    const Row* row(size_t index) {
+        if (index >= _rowCount) return nullptr;
+        Page* target = page(index / _pageSize);
+        if (!target) return nullptr;
+        size_t offset = index % _pageSize;
+        return offset < target->rows.size() ? &target->rows[offset] : nullptr;
+    }
+
+    /**
+     * @brief Hàng thứ index nếu trang chứa nó đã có trong bộ đệm; không bao giờ gọi hàm nạp
+     */
+    const Row* cached(size_t index) {
+        if (index >= _rowCount) return nullptr;
+        auto found = _byIndex.find(index / _pageSize);
+        if (found == _byIndex.end()) return nullptr;
+        _pages.splice(_pages.begin(), _pages, found->second);
+        size_t offset = index % _pageSize;
+        return offset < _pages.front().rows.size() ? &_pages.front().rows[offset] : nullptr;
+    }
+
+    bool hasPage(size_t pageIndex) const { return _byIndex.count(pageIndex) > 0; }
+
+    /**
+     * @brief Bỏ một trang khỏi bộ đệm để lần đọc sau nạp lại
+     */
+    void dropPage(size_t pageIndex) {
+        auto found = _byIndex.find(pageIndex);
+        if (found == _byIndex.end()) return;
+        _pages.erase(found->second);
+        _byIndex.erase(found);
+    }
+
+    /**
+     * @brief Vị trí của hàng có id trong các trang đang giữ; không bao giờ gọi hàm nạp
+     */
+    std::optional<size_t> indexOf(int id) const {
+        for (const auto& page : _pages) {
+            auto found = std::lower_bound(page.rows.begin(), page.rows.end(), id,
+                                          [](const Row& row, int value) { return row.id < value; });
+            if (found != page.rows.end() && found->id == id) {
+                return page.index * _pageSize + static_cast<size_t>(found - page.rows.begin());
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Thay hàng thứ index nếu trang chứa nó đang được giữ
+     * @return false nếu trang không có trong bộ đệm
+     */
+    bool replaceRow(size_t index, Row row) {
+        auto found = _byIndex.find(index / _pageSize);
+        if (found == _byIndex.end()) return false;
+        auto& rows = found->second->rows;
+        size_t offset = index % _pageSize;
+        if (offset >= rows.size()) return false;
+        rows[offset] = std::move(row);
+        return true;
+    }
+
+    /**
+     * @brief Một hàng có id vừa được thêm: tăng số hàng, bỏ các trang mà hàng mới làm dịch chuyển
+     * @return Chỉ số hàng đầu tiên có nội dung thay đổi
+     * @note Id mới thường lớn nhất nên chỉ trang cuối (nếu đang giữ) bị bỏ
+     */
+    size_t insertById(int id) {
+        ++_rowCount;
+        return dropShiftedPages(id, _rowCount - 1);
+    }
+
+    /**
+     * @brief Hàng có id vừa bị xóa: giảm số hàng, bỏ trang chứa nó và các trang phía sau đang giữ
+     * @return Chỉ số hàng đầu tiên có nội dung thay đổi
+     */
+    size_t removeById(int id) {
+        if (_rowCount > 0) --_rowCount;
+        return dropShiftedPages(id, _rowCount);
+    }
+
+    /**
+     * @brief Nạp trước các trang phủ [first, last] (gợi ý từ wxEVT_LIST_CACHE_HINT)
+     *
+     * Chỉ nạp tối đa maxPages trang tính từ first để không đẩy chính các trang đang hiển thị ra.
+     */
+    void prefetch(size_t first, size_t last) {
+        if (_rowCount == 0 || first >= _rowCount) return;
+        last = std::min(last, _rowCount - 1);
+        size_t firstPage = first / _pageSize;
+        size_t lastPage = std::min(last / _pageSize, firstPage + _maxPages - 1);
+        for (size_t index = firstPage; index <= lastPage; ++index) {
+            if (!page(index)) return;
+        }
+    }
+};
+
+#endif // PAGED_ROW_CACHE_H
@@ -0,0 +1,239 @@
+#include "PrefixIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    /// Độ dài chuỗi byte UTF-8 bắt đầu bằng byte đầu c
+    size_t sequenceLength(unsigned char c) {
+        if (c >= 0xF0) return 4;
+        if (c >= 0xE0) return 3;
+        if (c >= 0xC0) return 2;
+        return 1;
+    }
+
+    char32_t decode(std::string_view text, size_t position, size_t length) {
+        auto lead = static_cast<unsigned char>(text[position]);
+        char32_t codePoint = length == 1 ? lead : length == 2 ? (lead & 0x1F) : length == 3 ? (lead & 0x0F) : (lead & 0x07);
+        for (size_t i = 1; i < length; ++i) {
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[position + i]) & 0x3F);
+        }
+        return codePoint;
+    }
+
+    /// Chữ có dấu tiếng Việt (cả hoa và thường) về chữ cái thường không dấu
+    const std::unordered_map<char32_t, char>& foldTable() {
+        static const std::unordered_map<char32_t, char> table = [] {
+            // Ký tự đầu của mỗi nhóm là chữ gốc, phần còn lại là các biến thể có dấu
+            const char* groups[] = {
+                "aàáảãạăằắẳẵặâầấẩẫậÀÁẢÃẠĂẰẮẲẴẶÂẦẤẨẪẬ",
+                "dđĐ",
+                "eèéẻẽẹêềếểễệÈÉẺẼẸÊỀẾỂỄỆ",
+                "iìíỉĩịÌÍỈĨỊ",
+                "oòóỏõọôồốổỗộơờớởỡợÒÓỎÕỌÔỒỐỔỖỘƠỜỚỞỠỢ",
+                "uùúủũụưừứửữựÙÚỦŨỤƯỪỨỬỮỰ",
+                "yỳýỷỹỵỲÝỶỸỴ",
+            };
+            std::unordered_map<char32_t, char> folded;
+            for (const char* group : groups) {
+                std::string_view variants(group);
+                for (size_t i = 1; i < variants.size();) {
+                    size_t length = sequenceLength(static_cast<unsigned char>(variants[i]));
+                    folded.emplace(decode(variants, i, length), variants[0]);
+                    i += length;
+                }
+            }
+            return folded;
+        }();
+        return table;
+    }
+}
+
+std::string PrefixIndex::normalize(std::string_view text) {
+    const auto& folded = foldTable();
+    std::string normalized;
+    normalized.reserve(text.size());
+    bool pendingSpace = false;
+
+    for (size_t i = 0; i < text.size();) {
+        auto lead = static_cast<unsigned char>(text[i]);
+        if (lead < 0x80 && std::isspace(lead)) {
+            pendingSpace = !normalized.empty();
+            ++i;
+            continue;
+        }
+        if (pendingSpace) {
+            normalized += ' ';
+            pendingSpace = false;
+        }
+        if (lead < 0x80) {
+            normalized += static_cast<char>(std::tolower(lead));
+            ++i;
+            continue;
+        }
+
+        size_t length = std::min(sequenceLength(lead), text.size() - i);
+        auto it = folded.find(decode(text, i, length));
+        if (it != folded.end()) {
+            normalized += it->second;
+        } else {
+            normalized.append(text.substr(i, length));
+        }
+        i += length;
+    }
+    return normalized;
+}
+
+bool PrefixIndex::less(const Entry& a, const Entry& b) const {
+    int order = keyOf(a).compare(keyOf(b));
+    return order < 0 || (order == 0 && a.id < b.id);
+}
+
+void PrefixIndex::appendKeys(int id, std::string_view text, std::vector<Entry>& entries) {
+    std::string normalized = normalize(text);
+    if (normalized.empty()) return;
+    if (_text.size() + normalized.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("PrefixIndex text exceeds 4 GiB");
+    }
+
+    auto offset = static_cast<uint32_t>(_text.size());
+    auto length = static_cast<uint32_t>(normalized.size());
+    _text += normalized;
+    entries.push_back({offset, length, id});
+    if (!_wordPrefixes) return;
+
+    // Mỗi từ sau từ đầu tiên là một khóa trỏ vào giữa cùng đoạn văn bản
+    for (uint32_t i = 1; i < length; ++i) {
+        if (normalized[i - 1] == ' ') entries.push_back({offset + i, length - i, id});
+    }
+}
+
+void PrefixIndex::clear() {
+    _text.clear();
+    _base.clear();
+    _delta.clear();
+    _staleIds.clear();
+    _sealed = true;
+    _compactedTextBytes = 0;
+}
+
+void PrefixIndex::append(int id, std::string_view text) {
+    appendKeys(id, text, _base);
+    _sealed = false;
+}
+
+void PrefixIndex::seal() {
+    if (_sealed) return;
+    std::sort(_base.begin(), _base.end(), [this](const Entry& a, const Entry& b) { return less(a, b); });
+    _sealed = true;
+    _compactedTextBytes = _text.size();
+}
+
+void PrefixIndex::set(int id, std::string_view text) {
+    remove(id);
+
+    std::vector<Entry> added;
+    appendKeys(id, text, added);
+    for (const auto& entry : added) {
+        auto position = std::lower_bound(_delta.begin(), _delta.end(), entry,
+                                         [this](const Entry& a, const Entry& b) { return less(a, b); });
+        _delta.insert(position, entry);
+    }
+
+    size_t textGrowth = _text.size() - _compactedTextBytes;
+    if (_delta.size() > std::max(MIN_DELTA_BEFORE_COMPACT, _base.size() / 16) ||
+        textGrowth > std::max(MIN_TEXT_GROWTH_BEFORE_COMPACT, _compactedTextBytes)) {
+        compact();
+    }
+}
+
+void PrefixIndex::remove(int id) {
+    _delta.erase(std::remove_if(_delta.begin(), _delta.end(), [id](const Entry& entry) { return entry.id == id; }),
+                 _delta.end());
+    _staleIds.insert(id);
+}
+
+void PrefixIndex::compact() {
+    seal();
+    std::vector<Entry> merged;
+    merged.reserve(_base.size() + _delta.size());
+
+    auto live = [this](const Entry& entry) { return !_staleIds.contains(entry.id); };
+    auto base = _base.begin();
+    auto delta = _delta.begin();
+    while (base != _base.end() || delta != _delta.end()) {
+        if (delta == _delta.end() || (base != _base.end() && less(*base, *delta))) {
+            if (live(*base)) merged.push_back(*base);
+            ++base;
+        } else {
+            merged.push_back(*delta++);
+        }
+    }
+
+    _base = std::move(merged);
+    _delta.clear();
+    _staleIds.clear();
+    compactText();
+}
+
+void PrefixIndex::compactText() {
+    // Các khóa theo từ của cùng một văn bản kết thúc tại cùng vị trí; khóa dài nhất là cả văn bản
+    std::unordered_map<uint32_t, uint32_t> startByEnd;
+    startByEnd.reserve(_base.size());
+    for (const auto& entry : _base) {
+        auto [it, inserted] = startByEnd.try_emplace(entry.offset + entry.length, entry.offset);
+        if (!inserted) it->second = std::min(it->second, entry.offset);
+    }
+
+    // Chép mỗi văn bản còn dùng một lần, nhớ vị trí kết thúc mới của nó
+    std::string text;
+    std::unordered_map<uint32_t, uint32_t> movedEnd;
+    movedEnd.reserve(startByEnd.size());
+    for (const auto& [end, start] : startByEnd) {
+        text.append(_text, start, end - start);
+        movedEnd.emplace(end, static_cast<uint32_t>(text.size()));
+    }
+    for (auto& entry : _base) {
+        entry.offset = movedEnd.at(entry.offset + entry.length) - entry.length;
+    }
+    _text = std::move(text);
+    _compactedTextBytes = _text.size();
+}
+
+size_t PrefixIndex::find(std::string_view prefix, size_t limit, std::vector<int>& ids) const {
+    std::string key = normalize(prefix);
+    if (key.empty() || !_sealed) return 0;
+
+    auto lower = [this, &key](const std::vector<Entry>& entries) {
+        return std::lower_bound(entries.begin(), entries.end(), key,
+                                [this](const Entry& entry, const std::string& value) { return keyOf(entry) < value; });
+    };
+    auto matches = [this, &key](std::vector<Entry>::const_iterator it, std::vector<Entry>::const_iterator end) {
+        return it != end && keyOf(*it).starts_with(key);
+    };
+
+    size_t added = 0;
+    auto base = lower(_base);
+    auto delta = lower(_delta);
+    while (ids.size() < limit) {
+        bool inBase = matches(base, _base.end());
+        bool inDelta = matches(delta, _delta.end());
+        if (!inBase && !inDelta) break;
+
+        // Trộn hai mảng để kết quả giữ thứ tự khóa
+        const Entry* entry;
+        if (inBase && (!inDelta || less(*base, *delta))) {
+            entry = &*base++;
+            if (!_staleIds.empty() && _staleIds.contains(entry->id)) continue;
+        } else {
+            entry = &*delta++;
+        }
+
+        if (std::find(ids.begin(), ids.end(), entry->id) != ids.end()) continue;
+        ids.push_back(entry->id);
+        ++added;
+    }
+    return added;
+}
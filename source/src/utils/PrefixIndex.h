@@ -0,0 +1,118 @@
+/**
+ * @file PrefixIndex.h
+ * @brief Chỉ mục tiền tố trên mảng đã sắp xếp cho tìm kiếm khi đang gõ
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Mỗi khóa là một đoạn văn bản đã chuẩn hóa (chữ thường, bỏ dấu tiếng Việt, gộp khoảng trắng)
+ * gắn với id của hàng. Tìm theo tiền tố là một lần lower_bound trên mảng khóa đã sắp xếp rồi
+ * quét tiến cho tới khi khóa không còn bắt đầu bằng tiền tố, nên chi phí chỉ phụ thuộc log(n)
+ * và số kết quả cần lấy.
+ *
+ * Văn bản được lưu liền nhau trong một vùng nhớ chỉ ghi thêm; mỗi khóa chỉ là (vị trí, độ dài, id)
+ * nên ở chế độ theo từ ("nguyen van an" được tìm thấy bằng "van" hoặc "an"), các khóa của một tên
+ * dùng chung một bản văn bản.
+ *
+ * Thay đổi sau khi nạp không chèn vào mảng chính mà vào một mảng phụ nhỏ đã sắp xếp; khóa cũ
+ * của id bị thay đổi được đánh dấu hết hiệu lực. Khi mảng phụ đủ lớn, hai mảng được trộn lại
+ * trong O(n) và vùng văn bản được chép lại chỉ với các khóa còn hiệu lực. Việc trộn cũng xảy ra khi
+ * văn bản ghi thêm từ lần trộn trước vượt quá phần đã có, nên sửa đi sửa lại cùng vài id (mảng phụ
+ * luôn nhỏ) cũng không làm văn bản tích lũy mãi.
+ *
+ * Lớp không tự đồng bộ; người dùng phải tự khóa khi đọc và ghi trên nhiều luồng.
+ */
+
+#ifndef PREFIX_INDEX_H
+#define PREFIX_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+class PrefixIndex {
+private:
+    struct Entry {
+        uint32_t offset = 0;    ///< Vị trí của khóa trong _text
+        uint32_t length = 0;    ///< Độ dài khóa
+        int id = 0;             ///< Id của hàng
+    };
+
+    bool _wordPrefixes;
+    std::string _text;                  ///< Văn bản đã chuẩn hóa của mọi khóa, chỉ ghi thêm giữa hai lần trộn
+    std::vector<Entry> _base;           ///< Khóa đã sắp xếp theo (khóa, id)
+    std::vector<Entry> _delta;          ///< Khóa thêm sau lần trộn gần nhất, đã sắp xếp
+    std::unordered_set<int> _staleIds;  ///< Id có khóa trong _base đã hết hiệu lực
+    bool _sealed = true;                ///< _base đã được sắp xếp
+    size_t _compactedTextBytes = 0;     ///< Độ dài _text sau lần trộn hoặc seal() gần nhất
+
+    std::string_view keyOf(const Entry& entry) const { return {_text.data() + entry.offset, entry.length}; }
+    bool less(const Entry& a, const Entry& b) const;
+
+    /// Ghi văn bản đã chuẩn hóa vào vùng nhớ và thêm các khóa của nó vào entries (không sắp xếp)
+    void appendKeys(int id, std::string_view text, std::vector<Entry>& entries);
+    /// Trộn _delta vào _base, bỏ các khóa đã hết hiệu lực
+    void compact();
+    /// Chép lại _text chỉ gồm văn bản của các khóa trong _base (gọi khi _delta rỗng)
+    void compactText();
+
+public:
+    /// Số khóa tối thiểu của mảng phụ trước khi trộn vào mảng chính
+    static constexpr size_t MIN_DELTA_BEFORE_COMPACT = 1024;
+    /// Số byte văn bản ghi thêm tối thiểu sau lần trộn trước để trộn lại dù mảng phụ còn nhỏ
+    static constexpr size_t MIN_TEXT_GROWTH_BEFORE_COMPACT = 64 * 1024;
+
+    /**
+     * @param wordPrefixes true để tìm được theo tiền tố của từng từ, không chỉ của cả chuỗi
+     */
+    explicit PrefixIndex(bool wordPrefixes = false) : _wordPrefixes(wordPrefixes) {}
+
+    /**
+     * @brief Chuẩn hóa văn bản để so khớp: chữ thường, bỏ dấu tiếng Việt, gộp và cắt khoảng trắng
+     * @note "Nguyễn  Văn An" và "nguyen van an" cho cùng một kết quả
+     */
+    static std::string normalize(std::string_view text);
+
+    /// Xóa toàn bộ khóa và văn bản
+    void clear();
+
+    /**
+     * @brief Thêm khóa khi nạp hàng loạt; chỉ mục chưa tìm được cho tới khi gọi seal()
+     * @param id Id của hàng, mỗi id chỉ được thêm một lần
+     * @param text Văn bản gốc, được chuẩn hóa trước khi lưu
+     */
+    void append(int id, std::string_view text);
+
+    /// Sắp xếp các khóa đã thêm bằng append()
+    void seal();
+
+    /**
+     * @brief Thay toàn bộ khóa của một id bằng khóa của văn bản mới
+     * @param id Id của hàng vừa được thêm hoặc sửa
+     * @param text Văn bản gốc mới
+     */
+    void set(int id, std::string_view text);
+
+    /// Gỡ mọi khóa của một id
+    void remove(int id);
+
+    /**
+     * @brief Tìm các id có khóa bắt đầu bằng tiền tố, theo thứ tự khóa
+     * @param prefix Tiền tố gốc, được chuẩn hóa như khóa
+     * @param limit Số id tối đa của ids sau khi thêm
+     * @param ids Vector đích; id đã có trong ids không được thêm lại
+     * @return Số id đã thêm
+     * @note Tiền tố rỗng sau khi chuẩn hóa không khớp gì
+     */
+    size_t find(std::string_view prefix, size_t limit, std::vector<int>& ids) const;
+
+    /// Số khóa đang lưu, kể cả khóa đã hết hiệu lực chưa được trộn bỏ
+    size_t keyCount() const { return _base.size() + _delta.size(); }
+    /// Số byte văn bản đang giữ, kể cả văn bản của khóa đã hết hiệu lực chưa được trộn bỏ
+    size_t textBytes() const { return _text.size(); }
+};
+
+#endif // PREFIX_INDEX_H
@@ -15,8 +15,89 @@
 #include <string>
 #include <sstream>
 #include <format>
+#include <vector>
 
 namespace Tables {
+    constexpr const char* VERSION_COLUMN = "version"; ///< Cột phiên bản cho kiểm soát đồng thời lạc quan
+
+    /// Hậu tố phân trang cho truy vấn danh sách đã ORDER BY; tham số theo thứ tự (limit, offset)
+    constexpr const char* PAGE_CLAUSE = " LIMIT ? OFFSET ?";
+
+    /**
+     * @brief Tạo câu lệnh UPDATE chỉ gồm các cột đã thay đổi
+     * @param table Tên bảng
+     * @param columns Tên các cột cần ghi, theo đúng thứ tự bind tham số
+     * @param keyColumn Cột khóa dùng trong mệnh đề WHERE
+     * @param versionColumn Cột phiên bản; nullptr nếu bảng không có
+     * @return Câu lệnh dạng "UPDATE t SET c1 = ?, c2 = ? WHERE key = ?", hoặc với cột phiên bản
+     *         "UPDATE t SET c1 = ?, version = version + 1 WHERE key = ? AND version = ?"
+     */
+    inline std::string buildPartialUpdateQuery(const char* table,
+                                               const std::vector<const char*>& columns,
+                                               const char* keyColumn = "id",
+                                               const char* versionColumn = nullptr) {
+        std::string query = std::string("UPDATE ") + table + " SET ";
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) query += ", ";
+            query += columns[i];
+            query += " = ?";
+        }
+        if (versionColumn) {
+            query += std::string(", ") + versionColumn + " = " + versionColumn + " + 1";
+        }
+        query += std::string(" WHERE ") + keyColumn + " = ?";
+        if (versionColumn) {
+            query += std::string(" AND ") + versionColumn + " = ?";
+        }
+        return query;
+    }
+
+    // Truy vấn dấu mực nước cao "SELECT COUNT(*), MAX(id), SUM(version) FROM bảng", giải mã theo chỉ số cột
+    enum HighWaterMarkColumn {
+        MARK_COUNT = 0,
+        MARK_MAX_ID,
+        MARK_VERSION_SUM
+    };
+
+    // Truy vấn phiên bản "SELECT id, version[, flight_id] FROM bảng WHERE id > ? ORDER BY id LIMIT ?"
+    enum RowVersionColumn {
+        ROW_VERSION_ID = 0,
+        ROW_VERSION_VALUE,
+        ROW_VERSION_FLIGHT_ID
+    };
+
+    /**
+     * @brief Tạo danh sách placeholder cho mệnh đề IN
+     * @param count Số placeholder
+     * @return Chuỗi dạng "?, ?, ?"
+     */
+    inline std::string buildPlaceholders(size_t count) {
+        std::string placeholders;
+        placeholders.reserve(count * 3);
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) placeholders += ", ";
+            placeholders += "?";
+        }
+        return placeholders;
+    }
+
+    /**
+     * @brief Tạo danh sách bộ giá trị cho câu lệnh INSERT nhiều hàng
+     * @param columnCount Số cột của mỗi hàng
+     * @param rowCount Số hàng
+     * @return Chuỗi dạng "(?, ?), (?, ?)"
+     */
+    inline std::string buildRowPlaceholders(size_t columnCount, size_t rowCount) {
+        const std::string row = "(" + buildPlaceholders(columnCount) + ")";
+        std::string rows;
+        rows.reserve(rowCount * (row.size() + 2));
+        for (size_t i = 0; i < rowCount; ++i) {
+            if (i > 0) rows += ", ";
+            rows += row;
+        }
+        return rows;
+    }
+
     namespace Aircraft {
         constexpr const char* NAME_TABLE = "aircraft";
 
@@ -48,6 +129,7 @@ namespace Tables {
                                             "FROM aircraft "
                                             "WHERE id = ?";
         const std::string FIND_ALL_QUERY = getOrderedSelectClause();
+        const std::string FIND_LIST_ROW_PAGE_QUERY = getOrderedSelectClause() + " ORDER BY " + ColumnName[ID] + PAGE_CLAUSE;
         const std::string EXISTS_QUERY = "SELECT COUNT(*) FROM " + std::string(NAME_TABLE) + " WHERE id = ?";
         const std::string COUNT_QUERY = "SELECT COUNT(*) FROM " + std::string(NAME_TABLE);
         const std::string INSERT_QUERY = "INSERT INTO " + std::string(NAME_TABLE) + " (" + 
@@ -94,7 +176,8 @@ namespace Tables {
             AIRCRAFT_ID,
             DEPARTURE_TIME,
             ARRIVAL_TIME,
-            STATUS
+            STATUS,
+            VERSION
         };
 
         constexpr const char* ColumnName[] {
@@ -107,7 +190,8 @@ namespace Tables {
             "aircraft_id",
             "departure_time",
             "arrival_time",
-            "status"
+            "status",
+            VERSION_COLUMN
         };
 
         inline std::string getOrderedSelectClause() {
@@ -141,8 +225,9 @@ namespace Tables {
             ColumnName[AIRCRAFT_ID] + " = ?, " + 
             ColumnName[DEPARTURE_TIME] + " = ?, " + 
             ColumnName[ARRIVAL_TIME] + " = ?, " + 
-            ColumnName[STATUS] + " = ? " + 
-            "WHERE " + ColumnName[ID] + " = ?";
+            ColumnName[STATUS] + " = ?, " + 
+            ColumnName[VERSION] + " = " + ColumnName[VERSION] + " + 1 " +
+            "WHERE " + ColumnName[ID] + " = ? AND " + ColumnName[VERSION] + " = ?";
         const std::string DELETE_QUERY = "DELETE FROM " + std::string(NAME_TABLE) + " WHERE " + ColumnName[ID] + " = ?";
         const std::string FIND_BY_NUMBER_QUERY = getOrderedSelectClause() + " WHERE f." + ColumnName[FLIGHT_NUMBER] + " = ?";
         const std::string EXISTS_FLIGHT_QUERY = std::format (
@@ -150,6 +235,94 @@ namespace Tables {
             NAME_TABLE, ColumnName[FLIGHT_NUMBER]
         );
         const std::string FIND_FLIGHT_BY_SERIAL = getOrderedSelectClause() + " WHERE a." + Aircraft::ColumnName[Aircraft::SERIAL] + " = ?";
+
+        // Chuyển trạng thái trực tiếp, không nạp toàn bộ chuyến bay
+        const std::string FIND_STATUS_BY_NUMBER_QUERY = std::format (
+            "SELECT {}, {}, {}, {} FROM {} WHERE {} = ?",
+            ColumnName[ID], ColumnName[STATUS], ColumnName[DEPARTURE_TIME], ColumnName[VERSION],
+            NAME_TABLE, ColumnName[FLIGHT_NUMBER]
+        );
+        const std::string UPDATE_STATUS_QUERY = std::format (
+            "UPDATE {} SET {} = ?, {} = {} + 1 WHERE {} = ? AND {} = ?",
+            NAME_TABLE, ColumnName[STATUS], ColumnName[VERSION], ColumnName[VERSION],
+            ColumnName[ID], ColumnName[VERSION]
+        );
+
+        // Projection cho màn hình danh sách, giải mã theo chỉ số cột
+        enum SummaryColumn {
+            SUMMARY_ID = 0,
+            SUMMARY_FLIGHT_NUMBER,
+            SUMMARY_DEPARTURE_CODE,
+            SUMMARY_DEPARTURE_NAME,
+            SUMMARY_ARRIVAL_CODE,
+            SUMMARY_ARRIVAL_NAME,
+            SUMMARY_DEPARTURE_TIME,
+            SUMMARY_ARRIVAL_TIME,
+            SUMMARY_STATUS,
+            SUMMARY_SERIAL,
+            SUMMARY_ECONOMY_SEATS,
+            SUMMARY_BUSINESS_SEATS,
+            SUMMARY_FIRST_SEATS
+        };
+
+        const std::string SUMMARY_SELECT = std::format (
+            "SELECT f.{}, f.{}, f.{}, f.{}, f.{}, f.{}, f.{}, f.{}, f.{}, "
+            "a.{}, a.{}, a.{}, a.{} "
+            "FROM {} f JOIN {} a ON f.{} = a.{}",
+            ColumnName[ID], ColumnName[FLIGHT_NUMBER], ColumnName[DEPARTURE_CODE], ColumnName[DEPARTURE_NAME],
+            ColumnName[ARRIVAL_CODE], ColumnName[ARRIVAL_NAME], ColumnName[DEPARTURE_TIME], ColumnName[ARRIVAL_TIME],
+            ColumnName[STATUS],
+            Aircraft::ColumnName[Aircraft::SERIAL], Aircraft::ColumnName[Aircraft::ECONOMY_SEATS],
+            Aircraft::ColumnName[Aircraft::BUSINESS_SEATS], Aircraft::ColumnName[Aircraft::FIRST_SEATS],
+            NAME_TABLE, Aircraft::NAME_TABLE, ColumnName[AIRCRAFT_ID], Aircraft::ColumnName[Aircraft::ID]
+        );
+        const std::string FIND_ALL_SUMMARY_QUERY = SUMMARY_SELECT + " ORDER BY f." + ColumnName[ID];
+        const std::string FIND_SUMMARY_PAGE_QUERY = FIND_ALL_SUMMARY_QUERY + PAGE_CLAUSE;
+        const std::string FIND_SUMMARIES_AFTER_QUERY = SUMMARY_SELECT + " WHERE f." + ColumnName[ID] +
+            " > ? ORDER BY f." + ColumnName[ID] + " LIMIT ?";
+
+        const std::string HIGH_WATER_MARK_QUERY = std::format (
+            "SELECT COUNT(*), MAX({}), SUM({}) FROM {}",
+            ColumnName[ID], ColumnName[VERSION], NAME_TABLE
+        );
+        const std::string FIND_VERSIONS_AFTER_QUERY = std::format (
+            "SELECT {}, {} FROM {} WHERE {} > ? ORDER BY {} LIMIT ?",
+            ColumnName[ID], ColumnName[VERSION], NAME_TABLE, ColumnName[ID], ColumnName[ID]
+        );
+
+        /**
+         * @brief Cùng projection tóm tắt, chỉ cho các id chuyến bay cho trước, theo thứ tự id
+         * @param count Số id cần tìm
+         */
+        inline std::string buildFindSummariesByIdsQuery(size_t count) {
+            return SUMMARY_SELECT + " WHERE f." + ColumnName[ID] + " IN (" + buildPlaceholders(count) +
+                   ") ORDER BY f." + ColumnName[ID];
+        }
+
+        constexpr size_t INSERT_COLUMN_COUNT = 9; ///< Số tham số của mỗi hàng trong INSERT_QUERY
+
+        /**
+         * @brief Câu lệnh INSERT nhiều hàng cùng danh sách cột với INSERT_QUERY
+         * @param rowCount Số chuyến bay cần chèn
+         */
+        inline std::string buildBatchInsertQuery(size_t rowCount) {
+            return INSERT_QUERY.substr(0, INSERT_QUERY.find(" VALUES")) +
+                   " VALUES " + buildRowPlaceholders(INSERT_COLUMN_COUNT, rowCount);
+        }
+
+        /**
+         * @brief Chèn nhiều ghế trống của chuyến bay mới, mỗi hàng hai tham số (flight_id, seat_number)
+         * @param rowCount Số ghế cần chèn
+         */
+        inline std::string buildSeatAvailabilityInsertQuery(size_t rowCount) {
+            std::string query = "INSERT INTO flight_seat_availability (flight_id, seat_number, is_available) VALUES ";
+            query.reserve(query.size() + rowCount * 16);
+            for (size_t i = 0; i < rowCount; ++i) {
+                if (i > 0) query += ", ";
+                query += "(?, ?, TRUE)";
+            }
+            return query;
+        }
     }
 
     namespace Passenger {
@@ -161,7 +334,8 @@ namespace Tables {
             NAME,
             EMAIL,
             PHONE,
-            ADDRESS
+            ADDRESS,
+            VERSION
         };
 
         constexpr const char* ColumnName[] {
@@ -170,7 +344,8 @@ namespace Tables {
             "name",
             "email",
             "phone",
-            "address"
+            "address",
+            VERSION_COLUMN
         };
 
         inline std::string getOrderedSelectClause() {
@@ -180,7 +355,8 @@ namespace Tables {
                    ColumnName[NAME] + ", " +
                    ColumnName[EMAIL] + ", " +
                    ColumnName[PHONE] + ", " +
-                   ColumnName[ADDRESS] + 
+                   ColumnName[ADDRESS] + ", " +
+                   ColumnName[VERSION] +
                    " FROM " + NAME_TABLE;
         }
 
@@ -201,8 +377,9 @@ namespace Tables {
             ColumnName[NAME] + " = ?, " + 
             ColumnName[EMAIL] + " = ?, " + 
             ColumnName[PHONE] + " = ?, " + 
-            ColumnName[ADDRESS] + " = ? " + 
-            "WHERE " + ColumnName[ID] + " = ?";
+            ColumnName[ADDRESS] + " = ?, " + 
+            ColumnName[VERSION] + " = " + ColumnName[VERSION] + " + 1 " +
+            "WHERE " + ColumnName[ID] + " = ? AND " + ColumnName[VERSION] + " = ?";
         const std::string DELETE_QUERY = "DELETE FROM " + std::string(NAME_TABLE) + " WHERE " + ColumnName[ID] + " = ?";
         const std::string FIND_BY_PASSPORT_QUERY = std::format (
             "SELECT * FROM {} WHERE {} = ?",
@@ -213,6 +390,41 @@ namespace Tables {
             NAME_TABLE, ColumnName[PASSPORT_NUMBER]
         );
         const std::string DELETE_BY_PASSPORT_QUERY = "DELETE FROM " + std::string(NAME_TABLE) + " WHERE " + ColumnName[PASSPORT_NUMBER] + " = ?";
+
+        /**
+         * @brief Truy vấn nhiều hành khách theo danh sách số hộ chiếu trong một lần
+         * @param count Số hộ chiếu cần tìm
+         */
+        inline std::string buildFindByPassportsQuery(size_t count) {
+            return getOrderedSelectClause() + " WHERE " + ColumnName[PASSPORT_NUMBER] +
+                   " IN (" + buildPlaceholders(count) + ")";
+        }
+
+        constexpr size_t INSERT_COLUMN_COUNT = 5; ///< Số tham số của mỗi hàng trong INSERT_QUERY
+
+        /**
+         * @brief Câu lệnh INSERT nhiều hàng cùng danh sách cột với INSERT_QUERY
+         * @param rowCount Số hành khách cần chèn
+         */
+        inline std::string buildBatchInsertQuery(size_t rowCount) {
+            return INSERT_QUERY.substr(0, INSERT_QUERY.find(" VALUES")) +
+                   " VALUES " + buildRowPlaceholders(INSERT_COLUMN_COUNT, rowCount);
+        }
+
+        // Projection cho màn hình danh sách, cột theo thứ tự ColumnNumber
+        const std::string FIND_ALL_LIST_ROW_QUERY = getOrderedSelectClause() + " ORDER BY " + ColumnName[ID];
+        const std::string FIND_LIST_ROW_PAGE_QUERY = FIND_ALL_LIST_ROW_QUERY + PAGE_CLAUSE;
+        const std::string FIND_LIST_ROWS_AFTER_QUERY = getOrderedSelectClause() + " WHERE " + ColumnName[ID] +
+            " > ? ORDER BY " + ColumnName[ID] + " LIMIT ?";
+
+        /**
+         * @brief Cùng projection danh sách, chỉ cho các id cho trước, theo thứ tự id
+         * @param count Số id cần tìm
+         */
+        inline std::string buildFindListRowsByIdsQuery(size_t count) {
+            return getOrderedSelectClause() + " WHERE " + ColumnName[ID] + " IN (" + buildPlaceholders(count) +
+                   ") ORDER BY " + ColumnName[ID];
+        }
     }
 
     namespace Ticket {
@@ -226,7 +438,8 @@ namespace Tables {
             SEAT_NUMBER,
             PRICE,
             CURRENCY,
-            STATUS
+            STATUS,
+            VERSION
         };
 
         constexpr const char* ColumnName[] {
@@ -237,7 +450,8 @@ namespace Tables {
             "seat_number",
             "price",
             "currency",
-            "status"
+            "status",
+            VERSION_COLUMN
         };
 
         inline std::string getOrderedSelectClause() {
@@ -271,8 +485,9 @@ namespace Tables {
             ColumnName[SEAT_NUMBER] + " = ?, " + 
             ColumnName[PRICE] + " = ?, " + 
             ColumnName[CURRENCY] + " = ?, " + 
-            ColumnName[STATUS] + " = ? " + 
-            "WHERE " + ColumnName[ID] + " = ?";
+            ColumnName[STATUS] + " = ?, " + 
+            ColumnName[VERSION] + " = " + ColumnName[VERSION] + " + 1 " +
+            "WHERE " + ColumnName[ID] + " = ? AND " + ColumnName[VERSION] + " = ?";
         const std::string DELETE_QUERY = "DELETE FROM " + std::string(NAME_TABLE) + " WHERE " + ColumnName[ID] + " = ?";
         const std::string FIND_BY_TICKET_NUMBER_QUERY = std::format (
             "SELECT * FROM {} WHERE {} = ?",
@@ -286,6 +501,32 @@ namespace Tables {
             "SELECT * FROM {} WHERE {} = ?",
             NAME_TABLE, ColumnName[PASSENGER_ID]
         );
+        constexpr size_t INSERT_COLUMN_COUNT = 7; ///< Số tham số của mỗi hàng trong INSERT_QUERY
+
+        /**
+         * @brief Câu lệnh INSERT nhiều hàng cùng danh sách cột với INSERT_QUERY
+         * @param rowCount Số vé cần chèn
+         */
+        inline std::string buildBatchInsertQuery(size_t rowCount) {
+            return INSERT_QUERY.substr(0, INSERT_QUERY.find(" VALUES")) +
+                   " VALUES " + buildRowPlaceholders(INSERT_COLUMN_COUNT, rowCount);
+        }
+
+        /**
+         * @brief Giữ nhiều ghế của một chuyến bay bằng một câu lệnh UPDATE
+         * @param seatCount Số ghế cần giữ
+         * @note Số hàng bị ảnh hưởng nhỏ hơn seatCount nghĩa là có ghế đã bị đặt trước
+         */
+        inline std::string buildReserveSeatsQuery(size_t seatCount) {
+            return "UPDATE flight_seat_availability SET is_available = FALSE "
+                   "WHERE flight_id = ? AND is_available = TRUE AND seat_number IN (" +
+                   buildPlaceholders(seatCount) + ")";
+        }
+
+        const std::string COUNT_BY_FLIGHT_ID_QUERY = std::format (
+            "SELECT COUNT(*) FROM {} WHERE {} = ?",
+            NAME_TABLE, ColumnName[FLIGHT_ID]
+        );
         const std::string FIND_BY_SERIAL_NUMBER_QUERY = std::format (
             "SELECT t.* FROM {} t "
             "JOIN {} f ON t.{} = f.{} "
@@ -295,6 +536,144 @@ namespace Tables {
             Aircraft::NAME_TABLE, Flight::ColumnName[Flight::AIRCRAFT_ID], Aircraft::ColumnName[Aircraft::ID],
             Aircraft::ColumnName[Aircraft::SERIAL]
         );
+
+        // Chuyển trạng thái trực tiếp, không nạp toàn bộ vé
+        const std::string FIND_STATUS_BY_TICKET_NUMBER_QUERY = std::format (
+            "SELECT t.{}, t.{}, t.{}, f.{}, t.{} FROM {} t "
+            "JOIN {} f ON t.{} = f.{} "
+            "WHERE t.{} = ?",
+            ColumnName[ID], ColumnName[FLIGHT_ID], ColumnName[STATUS], Flight::ColumnName[Flight::DEPARTURE_TIME],
+            ColumnName[VERSION],
+            NAME_TABLE, Flight::NAME_TABLE, ColumnName[FLIGHT_ID], Flight::ColumnName[Flight::ID],
+            ColumnName[TICKET_NUMBER]
+        );
+        const std::string UPDATE_STATUS_QUERY = std::format (
+            "UPDATE {} SET {} = ?, {} = {} + 1 WHERE {} = ? AND {} = ?",
+            NAME_TABLE, ColumnName[STATUS], ColumnName[VERSION], ColumnName[VERSION],
+            ColumnName[ID], ColumnName[VERSION]
+        );
+
+        // Projection cho màn hình danh sách, giải mã theo chỉ số cột
+        enum ListRowColumn {
+            LIST_ID = 0,
+            LIST_TICKET_NUMBER,
+            LIST_PASSENGER_ID,
+            LIST_PASSPORT_NUMBER,
+            LIST_FLIGHT_ID,
+            LIST_FLIGHT_NUMBER,
+            LIST_SEAT_NUMBER,
+            LIST_PRICE,
+            LIST_CURRENCY,
+            LIST_STATUS
+        };
+
+        const std::string LIST_ROW_SELECT = std::format (
+            "SELECT t.{}, t.{}, t.{}, p.{}, t.{}, f.{}, t.{}, t.{}, t.{}, t.{} "
+            "FROM {} t "
+            "JOIN {} p ON t.{} = p.{} "
+            "JOIN {} f ON t.{} = f.{}",
+            ColumnName[ID], ColumnName[TICKET_NUMBER], ColumnName[PASSENGER_ID],
+            Passenger::ColumnName[Passenger::PASSPORT_NUMBER], ColumnName[FLIGHT_ID],
+            Flight::ColumnName[Flight::FLIGHT_NUMBER], ColumnName[SEAT_NUMBER], ColumnName[PRICE],
+            ColumnName[CURRENCY], ColumnName[STATUS],
+            NAME_TABLE,
+            Passenger::NAME_TABLE, ColumnName[PASSENGER_ID], Passenger::ColumnName[Passenger::ID],
+            Flight::NAME_TABLE, ColumnName[FLIGHT_ID], Flight::ColumnName[Flight::ID]
+        );
+        const std::string FIND_ALL_LIST_ROW_QUERY = LIST_ROW_SELECT + " ORDER BY t." + ColumnName[ID];
+        const std::string FIND_LIST_ROW_PAGE_QUERY = FIND_ALL_LIST_ROW_QUERY + PAGE_CLAUSE;
+        const std::string FIND_LIST_ROWS_AFTER_QUERY = LIST_ROW_SELECT + " WHERE t." + ColumnName[ID] +
+            " > ? ORDER BY t." + ColumnName[ID] + " LIMIT ?";
+
+        /**
+         * @brief Cùng projection danh sách, chỉ cho các id vé cho trước, theo thứ tự id
+         * @param count Số id cần tìm
+         */
+        inline std::string buildFindListRowsByIdsQuery(size_t count) {
+            return LIST_ROW_SELECT + " WHERE t." + ColumnName[ID] + " IN (" + buildPlaceholders(count) +
+                   ") ORDER BY t." + ColumnName[ID];
+        }
+
+        // Projection cho báo cáo: chỉ các cột cần gộp, đọc thẳng bảng vé không join
+        enum FactColumn {
+            FACT_ID = 0,
+            FACT_PASSENGER_ID,
+            FACT_FLIGHT_ID,
+            FACT_SEAT_NUMBER,
+            FACT_PRICE,
+            FACT_CURRENCY,
+            FACT_STATUS
+        };
+
+        const std::string FACT_SELECT = std::format (
+            "SELECT {}, {}, {}, {}, {}, {}, {} FROM {}",
+            ColumnName[ID], ColumnName[PASSENGER_ID], ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER], ColumnName[PRICE],
+            ColumnName[CURRENCY], ColumnName[STATUS], NAME_TABLE
+        );
+        const std::string FIND_FACTS_AFTER_QUERY = FACT_SELECT + " WHERE " + ColumnName[ID] +
+            " > ? ORDER BY " + ColumnName[ID] + " LIMIT ?";
+
+        /**
+         * @brief Cùng projection báo cáo, chỉ cho các id vé cho trước, theo thứ tự id
+         * @param count Số id cần tìm
+         */
+        inline std::string buildFindFactsByIdsQuery(size_t count) {
+            return FACT_SELECT + " WHERE " + ColumnName[ID] + " IN (" + buildPlaceholders(count) +
+                   ") ORDER BY " + ColumnName[ID];
+        }
+
+        // Số ghế đã đặt theo chuyến bay và hạng ghế; vé nào cũng giữ ghế của nó
+        // (khóa duy nhất flight_id, seat_number), kể cả vé đã hủy
+        enum OccupancyColumn {
+            OCCUPANCY_FLIGHT_ID = 0,
+            OCCUPANCY_SEAT_CLASS,
+            OCCUPANCY_BOOKED
+        };
+
+        const std::string SEAT_OCCUPANCY_QUERY = std::format (
+            "SELECT {}, LEFT({}, 1), COUNT(*) FROM {} GROUP BY {}, LEFT({}, 1)",
+            ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER], NAME_TABLE,
+            ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER]
+        );
+        // Cùng phép gộp, giới hạn trong khoảng id chuyến bay của một trang danh sách
+        const std::string SEAT_OCCUPANCY_RANGE_QUERY = std::format (
+            "SELECT {}, LEFT({}, 1), COUNT(*) FROM {} WHERE {} >= ? AND {} <= ? GROUP BY {}, LEFT({}, 1)",
+            ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER], NAME_TABLE, ColumnName[FLIGHT_ID], ColumnName[FLIGHT_ID],
+            ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER]
+        );
+
+        /**
+         * @brief Cùng phép gộp số ghế đã đặt, chỉ cho các id chuyến bay cho trước
+         * @param count Số id chuyến bay
+         */
+        inline std::string buildSeatOccupancyByFlightIdsQuery(size_t count) {
+            return std::format (
+                "SELECT {}, LEFT({}, 1), COUNT(*) FROM {} WHERE {} IN ({}) GROUP BY {}, LEFT({}, 1)",
+                ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER], NAME_TABLE, ColumnName[FLIGHT_ID], buildPlaceholders(count),
+                ColumnName[FLIGHT_ID], ColumnName[SEAT_NUMBER]
+            );
+        }
+
+        const std::string HIGH_WATER_MARK_QUERY = std::format (
+            "SELECT COUNT(*), MAX({}), SUM({}) FROM {}",
+            ColumnName[ID], ColumnName[VERSION], NAME_TABLE
+        );
+        const std::string FIND_VERSIONS_AFTER_QUERY = std::format (
+            "SELECT {}, {}, {} FROM {} WHERE {} > ? ORDER BY {} LIMIT ?",
+            ColumnName[ID], ColumnName[VERSION], ColumnName[FLIGHT_ID], NAME_TABLE, ColumnName[ID], ColumnName[ID]
+        );
+
+        // Số hành khách có ít nhất một vé đang hoạt động (chưa hủy, chưa hoàn tiền) và tổng số vé đó,
+        // gộp ngay trên server thành một hàng
+        enum ActiveBookingColumn {
+            ACTIVE_BOOKING_PASSENGERS = 0,
+            ACTIVE_BOOKING_TICKETS
+        };
+
+        const std::string ACTIVE_BOOKINGS_BY_PASSENGER_QUERY = std::format (
+            "SELECT COUNT(DISTINCT {}), COUNT(*) FROM {} WHERE {} NOT IN ('CANCELLED', 'REFUNDED')",
+            ColumnName[PASSENGER_ID], NAME_TABLE, ColumnName[STATUS]
+        );
     }
 }
 
@@ -0,0 +1,235 @@
+#include "Tracing.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Tracing {
+
+namespace {
+    std::atomic<uint64_t> nextSpanId{1};
+    // Span đang mở trên luồng hiện tại, là cha của span tạo tiếp theo
+    thread_local uint64_t currentSpanId = 0;
+
+    // Singleton không bao giờ bị hủy nên giữ con trỏ thô, tránh khóa của getInstance() ở mỗi span
+    Tracer& globalTracer() {
+        static Tracer* tracer = Tracer::getInstance().get();
+        return *tracer;
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& value) {
+        out << '"';
+        for (char c : value) {
+            switch (c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n";  break;
+                case '\r': out << "\\r";  break;
+                case '\t': out << "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                            << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    // Chrome trace dùng micro giây
+    std::string micros(int64_t nanos) {
+        std::ostringstream out;
+        out << nanos / 1000 << '.' << std::setw(3) << std::setfill('0') << nanos % 1000;
+        return out.str();
+    }
+}
+
+// === Tracer ===
+
+std::shared_ptr<Tracer> Tracer::_instance = nullptr;
+std::mutex Tracer::_instanceMutex;
+
+std::shared_ptr<Tracer> Tracer::getInstance() {
+    std::lock_guard<std::mutex> lock(_instanceMutex);
+    if (!_instance) {
+        _instance = std::make_shared<Tracer>();
+    }
+    return _instance;
+}
+
+void Tracer::enable(size_t capacityPerThread) {
+    _capacity.store(std::max<size_t>(1, capacityPerThread), std::memory_order_relaxed);
+    clear();
+    _enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::disable() {
+    _enabled.store(false, std::memory_order_release);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (auto& buffer : _buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+        buffer->dropped = 0;
+    }
+}
+
+int64_t Tracer::nowNanos() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    // Buffer thuộc về Tracer nên vẫn còn sau khi luồng kết thúc
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    thread_local const Tracer* owner = nullptr;
+    if (!buffer || owner != this) {
+        buffer = std::make_shared<ThreadBuffer>();
+        owner = this;
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        buffer->threadId = static_cast<uint32_t>(_buffers.size() + 1);
+        _buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::record(SpanEvent&& event) {
+    auto& buffer = localBuffer();
+    size_t capacity = _capacity.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    event.threadId = buffer.threadId;
+    if (buffer.events.size() < capacity) {
+        buffer.events.push_back(std::move(event));
+        buffer.next = buffer.events.size() % capacity;
+        return;
+    }
+    buffer.events[buffer.next] = std::move(event);
+    buffer.next = (buffer.next + 1) % capacity;
+    ++buffer.dropped;
+}
+
+std::vector<SpanEvent> Tracer::snapshot() const {
+    std::vector<SpanEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (const auto& buffer : _buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const SpanEvent& a, const SpanEvent& b) {
+        return a.startNanos != b.startNanos ? a.startNanos < b.startNanos : a.id < b.id;
+    });
+    return events;
+}
+
+uint64_t Tracer::droppedEvents() const {
+    uint64_t dropped = 0;
+    std::lock_guard<std::mutex> lock(_buffersMutex);
+    for (const auto& buffer : _buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        dropped += buffer->dropped;
+    }
+    return dropped;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) const {
+    auto events = snapshot();
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << micros(event.startNanos)
+            << ",\"dur\":" << micros(event.durationNanos)
+            << ",\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"cat\":";
+        writeJsonString(out, event.category);
+        out << ",\"args\":{\"span_id\":" << event.id << ",\"parent_id\":" << event.parentId;
+        for (const auto& [key, value] : event.args) {
+            out << ",";
+            writeJsonString(out, key);
+            out << ":";
+            writeJsonString(out, value);
+        }
+        out << "}}";
+    }
+    out << "\n]}\n";
+}
+
+std::string Tracer::exportChromeTrace() const {
+    std::ostringstream out;
+    writeChromeTrace(out);
+    return out.str();
+}
+
+VoidResult Tracer::writeChromeTraceFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return Failure(CoreError("Failed to open trace file: " + path, "TRACE_IO"));
+    }
+    writeChromeTrace(file);
+    if (!file.good()) {
+        return Failure(CoreError("Failed to write trace file: " + path, "TRACE_IO"));
+    }
+    return Success();
+}
+
+// === Span ===
+
+Span::Span(const char* name, const char* category)
+    : _name(name), _category(category), _active(globalTracer().isEnabled()) {
+    if (!_active) return;
+    _id = nextSpanId.fetch_add(1, std::memory_order_relaxed);
+    _parentId = currentSpanId;
+    currentSpanId = _id;
+    _startNanos = globalTracer().nowNanos();
+}
+
+void Span::setArg(std::string key, std::string value) {
+    if (!_active) return;
+    _args.emplace_back(std::move(key), std::move(value));
+}
+
+void Span::end() {
+    if (!_active) return;
+    _active = false;
+
+    auto& tracer = globalTracer();
+    SpanEvent event;
+    event.name = _name;
+    event.category = _category;
+    event.id = _id;
+    event.parentId = _parentId;
+    event.startNanos = _startNanos;
+    event.durationNanos = tracer.nowNanos() - _startNanos;
+    event.args = std::move(_args);
+    tracer.record(std::move(event));
+
+    currentSpanId = _parentId;
+}
+
+// === ParentScope ===
+
+uint64_t currentSpan() {
+    return currentSpanId;
+}
+
+ParentScope::ParentScope(uint64_t parentId) : _previous(currentSpanId) {
+    currentSpanId = parentId;
+}
+
+ParentScope::~ParentScope() {
+    currentSpanId = _previous;
+}
+
+} // namespace Tracing
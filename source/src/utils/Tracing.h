@@ -0,0 +1,167 @@
+/**
+ * @file Tracing.h
+ * @brief Span theo dõi lồng nhau (UI -> service -> repository -> SQL), xuất dạng Chrome trace-event JSON
+ * @version 0.1
+ * @date 2025-06-01
+ *
+ * @details
+ * Span là đối tượng RAII: khi tạo, nó lấy span đang mở trên cùng luồng làm cha và trở thành
+ * span hiện tại; khi hủy (hoặc gọi end()), nó ghi một sự kiện vào ring buffer của luồng đó và
+ * trả quyền "hiện tại" cho span cha. Vì vậy không cần truyền context qua tham số: một thao tác
+ * UI gọi service, service gọi repository, repository gọi kết nối, và mỗi lượt SQL tự nằm dưới
+ * span của lớp gọi nó.
+ *
+ * Tác vụ chạy trên luồng khác (Async::Executor) không thấy span của luồng gửi; bên gửi lấy
+ * currentSpan() khi xếp tác vụ và worker mở ParentScope với giá trị đó, để span trong tác vụ vẫn
+ * nằm dưới thao tác đã gửi nó dù span đó có thể đã kết thúc.
+ *
+ * Khi tracing tắt (mặc định), tạo Span chỉ tốn một lần đọc atomic. Tệp xuất mở được bằng
+ * chrome://tracing hoặc https://ui.perfetto.dev.
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include "../core/exceptions/Result.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Tracing {
+
+/**
+ * @brief Một span đã kết thúc
+ */
+struct SpanEvent {
+    std::string name;
+    std::string category;
+    uint64_t id = 0;
+    uint64_t parentId = 0;       ///< 0 nếu là span gốc
+    uint32_t threadId = 0;       ///< Số thứ tự luồng trong Tracer (không phải id hệ điều hành)
+    int64_t startNanos = 0;      ///< Tính từ lúc Tracer được tạo
+    int64_t durationNanos = 0;
+    std::vector<std::pair<std::string, std::string>> args;
+};
+
+class Tracer {
+private:
+    /// Ring buffer của một luồng; mutex chỉ tranh chấp khi đang xuất snapshot
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<SpanEvent> events;
+        size_t next = 0;
+        uint64_t dropped = 0;    ///< Số sự kiện cũ đã bị ghi đè
+        uint32_t threadId = 0;
+    };
+
+    static std::shared_ptr<Tracer> _instance;
+    static std::mutex _instanceMutex;
+
+    std::atomic<bool> _enabled{false};
+    std::atomic<size_t> _capacity{DEFAULT_CAPACITY};
+    std::chrono::steady_clock::time_point _epoch = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    mutable std::mutex _buffersMutex;
+
+    ThreadBuffer& localBuffer();
+    void record(SpanEvent&& event);
+
+    friend class Span;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 16384;
+
+    Tracer() = default;
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    static std::shared_ptr<Tracer> getInstance();
+
+    /**
+     * @brief Bật tracing và xóa dữ liệu cũ
+     * @param capacityPerThread Số sự kiện tối đa giữ lại trên mỗi luồng; sự kiện cũ nhất bị ghi đè
+     */
+    void enable(size_t capacityPerThread = DEFAULT_CAPACITY);
+    void disable();
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    void clear();
+
+    int64_t nowNanos() const;
+
+    /// Mọi sự kiện còn trong các ring buffer, sắp theo thời điểm bắt đầu
+    std::vector<SpanEvent> snapshot() const;
+    /// Tổng số sự kiện đã bị ghi đè trên mọi luồng
+    uint64_t droppedEvents() const;
+
+    void writeChromeTrace(std::ostream& out) const;
+    std::string exportChromeTrace() const;
+    VoidResult writeChromeTraceFile(const std::string& path) const;
+};
+
+/**
+ * @brief Span RAII
+ *
+ * name và category phải sống lâu hơn span (chuỗi hằng hoặc chuỗi trong đối tượng static),
+ * vì chúng chỉ được sao chép khi span được ghi lại.
+ *
+ * @code
+ * Tracing::Span span("FlightWindow.refresh", "ui");
+ * auto result = flightService->getFlightSummaries(rows);
+ * span.end();   // kết thúc trước khi mở hộp thoại
+ * @endcode
+ */
+class Span {
+private:
+    const char* _name;
+    const char* _category;
+    bool _active;
+    uint64_t _id = 0;
+    uint64_t _parentId = 0;
+    int64_t _startNanos = 0;
+    std::vector<std::pair<std::string, std::string>> _args;
+
+public:
+    Span(const char* name, const char* category);
+    ~Span() { end(); }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /// Gắn thông tin (câu SQL, số hàng...) vào sự kiện; bỏ qua khi tracing tắt
+    void setArg(std::string key, std::string value);
+    /// Kết thúc sớm; gọi nhiều lần không có tác dụng
+    void end();
+
+    bool isActive() const { return _active; }
+    uint64_t id() const { return _id; }
+    uint64_t parentId() const { return _parentId; }
+};
+
+/// Span đang mở trên luồng gọi, 0 nếu không có (hoặc tracing tắt)
+uint64_t currentSpan();
+
+/**
+ * @brief Đặt cha cho các span mở trên luồng hiện tại trong phạm vi của đối tượng
+ * @note Dùng trên worker để nối span của tác vụ với span của luồng đã gửi tác vụ
+ */
+class ParentScope {
+private:
+    uint64_t _previous;
+
+public:
+    explicit ParentScope(uint64_t parentId);
+    ~ParentScope();
+
+    ParentScope(const ParentScope&) = delete;
+    ParentScope& operator=(const ParentScope&) = delete;
+};
+
+} // namespace Tracing
+
+#endif // TRACING_H